@@ -0,0 +1,603 @@
+// civ_bench: scaling benchmarks for kernel and module hot paths.
+//
+//   ./civ_bench --benchmark_filter=Beliefs                      # one family
+//   ./civ_bench --benchmark_out=run.json --benchmark_out_format=json
+//   compare.py benchmarks old.json new.json                    # from google/benchmark tools/
+//
+// Agent-scale benchmarks take (population, regions); region-scale ones take
+// (regions). Kernels are built outside the timed region and reused across
+// read-only benchmarks of the same shape.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "io/MetricsRecorder.h"
+#include "io/Snapshot.h"
+#include "kernel/Ensemble.h"
+#include "kernel/Kernel.h"
+#include "kernel/ShardedKernel.h"
+#include "modules/Culture.h"
+#include "modules/TradeNetwork.h"
+#include "utils/EventLog.h"
+#include "utils/Serialization.h"
+
+// Befriended by Kernel so single phases can be timed in isolation
+struct KernelBenchAccess {
+    static void updateBeliefs(Kernel& k) { k.updateBeliefs(); }
+    static void stepDemography(Kernel& k) {
+        ++k.generation_;
+        k.stepDemography();
+    }
+    static void stepMigration(Kernel& k) {
+        k.generation_ += 10;  // Migration runs on 10-tick boundaries
+        k.stepMigration();
+    }
+    static void updateEconomy(Kernel& k, std::uint64_t generation) {
+        std::vector<std::uint32_t> populations;
+        std::vector<std::array<double, 4>> centroids;
+        populations.resize(k.cfg_.regions);
+        centroids.resize(k.cfg_.regions);
+        k.regionalCentroids(populations, centroids);
+        k.economy_.update(populations, centroids, k.agents_, generation, &k.regionIndex_);
+    }
+    static void invalidateMetrics(Kernel& k) { ++k.state_version_; }
+};
+
+namespace {
+
+// Population x regions: the shapes exercised by agent-scale benchmarks
+const std::vector<std::vector<std::int64_t>> kAgentScales = {
+    {10000, 200}, {50000, 200}, {500000, 2000}, {2000000, 2000},
+};
+const std::vector<std::int64_t> kRegionScales = {200, 2000, 20000};
+
+void agentScales(benchmark::internal::Benchmark* b) {
+    for (const auto& args : kAgentScales) b->Args(args);
+    b->ArgNames({"agents", "regions"});
+    b->Unit(benchmark::kMillisecond);
+}
+
+KernelConfig benchConfig(const benchmark::State& state, bool meanField = true) {
+    KernelConfig cfg;
+    cfg.population = static_cast<std::uint32_t>(state.range(0));
+    cfg.regions = static_cast<std::uint32_t>(state.range(1));
+    cfg.useMeanField = meanField;
+    cfg.maxPopulation = std::max<std::uint32_t>(cfg.maxPopulation, cfg.population * 2);
+    cfg.seed = 42;
+    return cfg;
+}
+
+// One cached kernel at a time (a 2M-agent kernel is several hundred MB)
+Kernel& sharedKernel(const KernelConfig& cfg) {
+    static std::unique_ptr<Kernel> kernel;
+    static std::uint32_t population = 0, regions = 0;
+    static bool meanField = false;
+    if (!kernel || population != cfg.population || regions != cfg.regions ||
+        meanField != cfg.useMeanField) {
+        kernel.reset();
+        kernel = std::make_unique<Kernel>(cfg);
+        population = cfg.population;
+        regions = cfg.regions;
+        meanField = cfg.useMeanField;
+    }
+    return *kernel;
+}
+
+void reportAgents(benchmark::State& state, std::size_t agents) {
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(agents));
+    state.counters["agents"] = static_cast<double>(agents);
+}
+
+// ---------- Kernel phases ----------
+
+void BM_UpdateBeliefsMeanField(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state, true));
+    for (auto _ : state) {
+        KernelBenchAccess::updateBeliefs(kernel);
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_UpdateBeliefsMeanField)->Apply(agentScales);
+
+void BM_UpdateBeliefsNeighbors(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state, false));
+    for (auto _ : state) {
+        KernelBenchAccess::updateBeliefs(kernel);
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_UpdateBeliefsNeighbors)->Apply(agentScales);
+
+// Belief pass with the live culture index folded in (compare with MeanField)
+void BM_UpdateBeliefsLiveClusters(benchmark::State& state) {
+    KernelConfig cfg = benchConfig(state);
+    cfg.liveClusters = 8;
+    Kernel kernel(cfg);
+    for (auto _ : state) {
+        KernelBenchAccess::updateBeliefs(kernel);
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_UpdateBeliefsLiveClusters)->Apply(agentScales);
+
+// Demography and migration change the population, so each run starts fresh
+void BM_StepDemography(benchmark::State& state) {
+    Kernel kernel(benchConfig(state));
+    for (auto _ : state) {
+        KernelBenchAccess::stepDemography(kernel);
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_StepDemography)->Apply(agentScales);
+
+void BM_StepMigration(benchmark::State& state) {
+    Kernel kernel(benchConfig(state));
+    for (auto _ : state) {
+        KernelBenchAccess::stepMigration(kernel);
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_StepMigration)->Apply(agentScales);
+
+// ---------- Modules ----------
+
+void BM_EconomyUpdate(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    std::uint64_t generation = 1;  // Includes the evolution stage every 10th call
+    for (auto _ : state) {
+        KernelBenchAccess::updateEconomy(kernel, generation++);
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_EconomyUpdate)->Apply(agentScales);
+
+void BM_TradeComputeFlows(benchmark::State& state) {
+    const auto regions = static_cast<std::uint32_t>(state.range(0));
+    const auto side = static_cast<std::uint32_t>(std::ceil(std::sqrt(regions)));
+
+    // Grid topology: each region trades with its 4-neighbourhood
+    std::vector<std::vector<std::uint32_t>> partners(regions);
+    for (std::uint32_t i = 0; i < regions; ++i) {
+        const std::uint32_t row = i / side, col = i % side;
+        if (col > 0) partners[i].push_back(i - 1);
+        if (col + 1 < side && i + 1 < regions) partners[i].push_back(i + 1);
+        if (row > 0) partners[i].push_back(i - side);
+        if (i + side < regions) partners[i].push_back(i + side);
+    }
+
+    std::mt19937_64 rng(42);
+    std::uniform_real_distribution<double> amount(0.0, 100.0);
+    std::vector<std::array<double, kGoodTypes>> production(regions), demand(regions);
+    std::vector<std::uint32_t> population(regions, 500);
+    for (std::uint32_t i = 0; i < regions; ++i) {
+        for (int g = 0; g < kGoodTypes; ++g) {
+            production[i][g] = amount(rng);
+            demand[i][g] = amount(rng);
+        }
+    }
+
+    TradeNetwork network;
+    network.configure(regions);
+    network.buildTopology(partners);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(network.computeFlows(production, demand, population));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * regions);
+}
+BENCHMARK(BM_TradeComputeFlows)
+    ->ArgName("regions")
+    ->Apply([](benchmark::internal::Benchmark* b) {
+        for (auto r : kRegionScales) b->Arg(r);
+    })
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_KMeans(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    for (auto _ : state) {
+        KMeansClustering kmeans(8);
+        benchmark::DoNotOptimize(kmeans.run(kernel));
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_KMeans)->Apply(agentScales);
+
+// Periodic re-clustering: each run starts from the previous run's centroids
+void BM_KMeansWarmStart(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    KMeansClustering kmeans(8);
+    kmeans.run(kernel);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kmeans.run(kernel));
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_KMeansWarmStart)->Apply(agentScales);
+
+void BM_KMeansMiniBatch(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    for (auto _ : state) {
+        KMeansClustering kmeans(8);
+        kmeans.setMiniBatch(4096);
+        benchmark::DoNotOptimize(kmeans.run(kernel));
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_KMeansMiniBatch)->Apply(agentScales);
+
+void BM_DBSCAN(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    for (auto _ : state) {
+        DBSCANClustering dbscan(0.3, 50);
+        benchmark::DoNotOptimize(dbscan.run(kernel));
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_DBSCAN)->Apply(agentScales);
+
+// Uncached cost of one metrics poll (exact polarization up to 2048 regions)
+void BM_ComputeMetrics(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    for (auto _ : state) {
+        KernelBenchAccess::invalidateMetrics(kernel);
+        benchmark::DoNotOptimize(kernel.computeMetrics());
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_ComputeMetrics)->Apply(agentScales);
+
+void BM_GetStatistics(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    for (auto _ : state) {
+        KernelBenchAccess::invalidateMetrics(kernel);
+        benchmark::DoNotOptimize(kernel.getStatistics());
+    }
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_GetStatistics)->Apply(agentScales);
+
+// Ten years of cohort demography for the agents plus 50M background people
+// (kernel rebuilt untimed: fast-forwarding mutates it)
+void BM_FastForwardDecade(benchmark::State& state) {
+    KernelConfig cfg = benchConfig(state);
+    cfg.backgroundPopulation = 50000000;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Kernel kernel(cfg);
+        state.ResumeTiming();
+        kernel.fastForward(10);
+    }
+    reportAgents(state, cfg.population);
+}
+BENCHMARK(BM_FastForwardDecade)
+    ->Args({10000, 200})
+    ->Args({50000, 200})
+    ->ArgNames({"agents", "regions"})
+    ->Unit(benchmark::kMillisecond);
+
+// ---------- I/O ----------
+
+void BM_KernelToJson(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        const std::string json = kernelToJson(kernel);
+        bytes = json.size();
+        benchmark::DoNotOptimize(json.data());
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK(BM_KernelToJson)->Apply(agentScales);
+
+// Streaming export into a counting sink: nothing is held beyond one chunk
+void BM_ExportState(benchmark::State& state, ExportOptions::Format format) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    ExportOptions options;
+    options.format = format;
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        bytes = 0;
+        exportState(kernel, [&bytes](const char* data, std::size_t size) {
+            benchmark::DoNotOptimize(data);
+            bytes += size;
+        }, options);
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK_CAPTURE(BM_ExportState, json, ExportOptions::Format::Json)->Apply(agentScales);
+BENCHMARK_CAPTURE(BM_ExportState, columnar, ExportOptions::Format::Columnar)->Apply(agentScales);
+
+// Recorder cost per tick (metrics are memoized, so this is the capture,
+// downsampling and hand-off to the writer); default series, all regions.
+// Iterations are capped: every one keeps a full-resolution row
+void BM_MetricsRecord(benchmark::State& state, bool toFile) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    const std::string path = (std::filesystem::temp_directory_path() / "civ_bench_metrics.civm").string();
+    {
+        MetricsRecorder recorder({}, toFile ? path : std::string());
+        for (auto _ : state) recorder.record(kernel);
+    }
+    std::filesystem::remove(path);
+    reportAgents(state, kernel.agents().size());
+}
+BENCHMARK_CAPTURE(BM_MetricsRecord, memory, false)->Apply(agentScales)->Iterations(500)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_MetricsRecord, file, true)->Apply(agentScales)->Iterations(500)->Unit(benchmark::kMicrosecond);
+
+// Death events as demography logs them; threads share one log
+void BM_EventLogDeath(benchmark::State& state) {
+    static EventLog* log = nullptr;
+    if (state.thread_index() == 0) {
+        EventLog::Config cfg;
+        cfg.retainLimit = 1u << 16;
+        log = new EventLog(cfg);
+    }
+    std::uint32_t id = 0;
+    for (auto _ : state) {
+        log->logDeath(id / 1024, id, id % 200, 40);
+        ++id;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        delete log;
+        log = nullptr;
+    }
+}
+BENCHMARK(BM_EventLogDeath)->Threads(1)->Threads(4);
+
+// Count one type over a 100-tick window of a history with every type mixed in
+void BM_EventLogRangeCount(benchmark::State& state) {
+    EventLog::Config cfg;
+    cfg.retainLimit = static_cast<std::size_t>(state.range(0));
+    EventLog log(cfg);
+    for (std::int64_t i = 0; i < state.range(0); ++i) {
+        const auto type = static_cast<EventType>(i % static_cast<std::int64_t>(EventStore::kTypeCount));
+        log.logEvent(static_cast<std::uint64_t>(i / 64), type, static_cast<std::uint32_t>(i), 0, 1.0);
+    }
+    const std::uint64_t ticks = static_cast<std::uint64_t>(state.range(0)) / 64;
+    std::uint64_t start = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(log.count(EventType::DEATH, start, start + 99));
+        start = (start + 997) % ticks;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventLogRangeCount)->Arg(1 << 16)->Arg(1 << 20);
+
+struct QuietStdout {
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+    ~QuietStdout() { std::cout.rdbuf(saved); }
+};
+
+std::string checkpointPath() {
+    return (std::filesystem::temp_directory_path() / "civ_bench_checkpoint.bin").string();
+}
+
+serialization::CheckpointOptions checkpointOptions(bool compress) {
+    serialization::CheckpointOptions options;
+    options.compress = compress;
+    return options;
+}
+
+void BM_CheckpointSave(benchmark::State& state, bool compress) {
+    if (compress && !serialization::compressionAvailable()) {
+        state.SkipWithError("built without zlib");
+        return;
+    }
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    const std::string path = checkpointPath();
+    for (auto _ : state) {
+        QuietStdout quiet;
+        if (!serialization::saveCheckpoint(kernel, path, checkpointOptions(compress))) {
+            state.SkipWithError("saveCheckpoint failed");
+            break;
+        }
+    }
+    if (std::filesystem::exists(path)) {
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                                static_cast<std::int64_t>(std::filesystem::file_size(path)));
+    }
+    reportAgents(state, kernel.agents().size());
+    std::filesystem::remove(path);
+}
+BENCHMARK_CAPTURE(BM_CheckpointSave, raw, false)->Apply(agentScales);
+BENCHMARK_CAPTURE(BM_CheckpointSave, zlib, true)->Apply(agentScales);
+
+// Time the caller is held by a background save; the write itself is untimed
+void BM_CheckpointSaveAsync(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    const std::string path = checkpointPath();
+    serialization::AsyncCheckpointer writer;
+    for (auto _ : state) {
+        auto done = writer.save(kernel, path);
+        state.PauseTiming();
+        if (!done.get().ok) {
+            state.SkipWithError("async save failed");
+            break;
+        }
+        state.ResumeTiming();
+    }
+    reportAgents(state, kernel.agents().size());
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_CheckpointSaveAsync)->Apply(agentScales);
+
+// Deltas one step apart (the step is untimed); bytes are the delta files
+void BM_CheckpointSaveDelta(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    const std::string path = checkpointPath();
+    serialization::DeltaCheckpointer writer(std::numeric_limits<std::uint32_t>::max());
+    std::int64_t bytes = 0;
+    {
+        QuietStdout quiet;
+        if (!writer.save(kernel, path)) {
+            state.SkipWithError("base save failed");
+            return;
+        }
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        kernel.step();
+        state.ResumeTiming();
+        QuietStdout quiet;
+        if (!writer.save(kernel, path)) {
+            state.SkipWithError("delta save failed");
+            break;
+        }
+        bytes += static_cast<std::int64_t>(writer.lastBytesWritten());
+    }
+    state.SetBytesProcessed(bytes);
+    reportAgents(state, kernel.agents().size());
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_CheckpointSaveDelta)->Apply(agentScales);
+
+// Time the caller is held by a background delta one step after the last;
+// the diff and write run on the worker, untimed
+void BM_CheckpointSaveDeltaAsync(benchmark::State& state) {
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    const std::string path = checkpointPath();
+    serialization::DeltaCheckpointer chain(std::numeric_limits<std::uint32_t>::max());
+    serialization::AsyncCheckpointer writer;
+    if (!writer.save(kernel, path, chain).get().ok) {
+        state.SkipWithError("base save failed");
+        return;
+    }
+    for (auto _ : state) {
+        state.PauseTiming();
+        kernel.step();
+        state.ResumeTiming();
+        auto done = writer.save(kernel, path, chain);
+        state.PauseTiming();
+        if (!done.get().ok) {
+            state.SkipWithError("delta save failed");
+            break;
+        }
+        state.ResumeTiming();
+    }
+    reportAgents(state, kernel.agents().size());
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_CheckpointSaveDeltaAsync)->Apply(agentScales);
+
+// Loads replace the shared kernel with an identical copy of itself
+void BM_CheckpointLoad(benchmark::State& state, bool compress) {
+    if (compress && !serialization::compressionAvailable()) {
+        state.SkipWithError("built without zlib");
+        return;
+    }
+    Kernel& kernel = sharedKernel(benchConfig(state));
+    const std::string path = checkpointPath();
+    {
+        QuietStdout quiet;
+        if (!serialization::saveCheckpoint(kernel, path, checkpointOptions(compress))) {
+            state.SkipWithError("saveCheckpoint failed");
+            return;
+        }
+    }
+    for (auto _ : state) {
+        QuietStdout quiet;
+        if (!serialization::loadCheckpoint(kernel, path)) {
+            state.SkipWithError("loadCheckpoint failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                            static_cast<std::int64_t>(std::filesystem::file_size(path)));
+    reportAgents(state, kernel.agents().size());
+    std::filesystem::remove(path);
+}
+BENCHMARK_CAPTURE(BM_CheckpointLoad, raw, false)->Apply(agentScales);
+BENCHMARK_CAPTURE(BM_CheckpointLoad, zlib, true)->Apply(agentScales);
+
+// World construction: reset() from the config, or the same world mapped back
+// from its cached init image
+void BM_KernelInit(benchmark::State& state, bool cached) {
+    const KernelConfig cfg = benchConfig(state);
+    const std::string dir = checkpointPath() + ".init";
+    serialization::InitImageCache cache(dir);
+    if (cached) cache.make(cfg);
+    std::size_t agents = 0;
+    for (auto _ : state) {
+        auto kernel = cached ? cache.load(cfg) : std::make_unique<Kernel>(cfg);
+        if (!kernel) {
+            state.SkipWithError("init image missing");
+            break;
+        }
+        agents = kernel->agents().size();
+    }
+    reportAgents(state, agents);
+    std::filesystem::remove_all(dir);
+}
+BENCHMARK_CAPTURE(BM_KernelInit, build, false)->Apply(agentScales);
+BENCHMARK_CAPTURE(BM_KernelInit, image, true)->Apply(agentScales);
+
+// Eight seeds on one world (geographySeed set), built once or per run;
+// regions dominate init, so sharing shows at large R
+void BM_EnsembleSweep(benchmark::State& state, bool share) {
+    Ensemble::Options options;
+    options.shareGeography = share;
+    Ensemble ensemble(options);
+    for (std::uint64_t seed = 1; seed <= 8; ++seed) {
+        EnsembleRun run;
+        run.config.population = 4000;
+        run.config.regions = static_cast<std::uint32_t>(state.range(0));
+        run.config.seed = seed;
+        run.config.geographySeed = 1;
+        run.ticks = 5;
+        ensemble.add(run);
+    }
+    for (auto _ : state) {
+        const auto summary = ensemble.run(nullptr);
+        if (summary.failed > 0) {
+            state.SkipWithError("ensemble run failed");
+            break;
+        }
+    }
+    state.counters["runs/s"] = benchmark::Counter(static_cast<double>(state.iterations() * 8),
+                                                  benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_EnsembleSweep, private, false)->Arg(200)->Arg(2000)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_EnsembleSweep, shared, true)->Arg(200)->Arg(2000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// One 40k-agent world stepped as N threaded shards (halo, migrants and region
+// reductions included)
+void BM_ShardedStep(benchmark::State& state) {
+    const int shards = static_cast<int>(state.range(0));
+    KernelConfig cfg;
+    cfg.population = 40000;
+    cfg.regions = 120;
+    auto group = LocalCommunicator::group(shards);
+    std::vector<std::unique_ptr<ShardedKernel>> kernels(static_cast<std::size_t>(shards));
+    const auto onShards = [&](auto&& work) {
+        std::vector<std::thread> threads;
+        for (int r = 0; r < shards; ++r) threads.emplace_back([&, r] { work(r); });
+        for (auto& t : threads) t.join();
+    };
+    onShards([&](int r) { kernels[r] = std::make_unique<ShardedKernel>(cfg, *group[r]); });
+    for (auto _ : state) {
+        onShards([&](int r) { kernels[r]->stepN(10); });
+    }
+    state.counters["ticks/s"] = benchmark::Counter(static_cast<double>(state.iterations() * 10),
+                                                   benchmark::Counter::kIsRate);
+    state.counters["halo_edges"] = static_cast<double>(kernels[0]->traffic().haloEdges);
+}
+BENCHMARK(BM_ShardedStep)->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,310 @@
+#include "http_server.h"
+#include "modules/Economy.h"
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <csignal>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t kMaxRequestBytes = 16 * 1024;
+// Accepted connections waiting for a handler, per handler thread; beyond
+// that a connection gets a 503 and is closed
+constexpr std::size_t kPendingPerThread = 8;
+// Bounds on /reset, so one request cannot ask for a world the host cannot build
+constexpr std::uint32_t kMaxResetPopulation = 50'000'000;
+constexpr std::uint32_t kMaxResetRegions = 65'536;
+constexpr std::uint32_t kMaxResetConnections = 1'000;
+
+const char* reasonPhrase(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 202: return "Accepted";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 503: return "Service Unavailable";
+        default: return "Internal Server Error";
+    }
+}
+
+HttpServer::Response error(int status, const std::string& message) {
+    return {status, "{\"error\":\"" + message + "\"}"};
+}
+
+// Kernel messages and client-supplied names are plain text; keep them from
+// closing the JSON string or breaking it with control characters
+std::string jsonText(std::string text) {
+    for (auto& c : text) {
+        if (c == '"') {
+            c = '\'';
+        } else if (c == '\\') {
+            c = '/';
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            c = '?';
+        }
+    }
+    return text;
+}
+
+HttpServer::Response queued(bool accepted, const std::string& command) {
+    if (!accepted) return error(503, "command queue full");
+    return {202, "{\"queued\":\"" + command + "\"}"};
+}
+
+// The whole of `text` as a number: no sign, whitespace or trailing characters
+template <typename T>
+bool parseNumber(const std::string& text, T& value) {
+    if (text.empty() || text[0] == '-' || text[0] == '+') return false;
+    const char* end = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+// "a=1&b=2" (values are numbers and plain names, so no percent-decoding)
+std::map<std::string, std::string> parseQuery(const std::string& query) {
+    std::map<std::string, std::string> params;
+    std::size_t pos = 0;
+    while (pos < query.size()) {
+        std::size_t amp = query.find('&', pos);
+        if (amp == std::string::npos) amp = query.size();
+        const std::string item = query.substr(pos, amp - pos);
+        const auto eq = item.find('=');
+        if (!item.empty()) {
+            params[item.substr(0, eq)] = eq == std::string::npos ? "" : item.substr(eq + 1);
+        }
+        pos = amp + 1;
+    }
+    return params;
+}
+
+}  // namespace
+
+HttpServer::HttpServer(LiveSimulation& sim, std::uint16_t port, std::size_t threads, bool allInterfaces)
+    : sim_(sim), port_(port), threads_(std::max<std::size_t>(1, threads)),
+      all_interfaces_(allInterfaces) {}
+
+HttpServer::Response HttpServer::handle(const std::string& method, const std::string& target) {
+    const auto q = target.find('?');
+    const std::string path = target.substr(0, q);
+    const auto params = parseQuery(q == std::string::npos ? "" : target.substr(q + 1));
+
+    if (method == "GET") {
+        const auto snap = sim_.snapshot();
+        if (!snap) return error(503, "no snapshot yet");
+        if (path == "/status") {
+            const auto st = sim_.status();
+            return {200, "{\"generation\":" + std::to_string(st.generation) +
+                             ",\"epoch\":" + std::to_string(st.epoch) +
+                             ",\"running\":" + (st.running ? "true" : "false") +
+                             ",\"pendingSteps\":" + std::to_string(st.pendingSteps) +
+                             ",\"queued\":" + std::to_string(st.queued) +
+                             (st.lastError.empty() ? "" : ",\"error\":\"" + jsonText(st.lastError) + "\"") + "}"};
+        }
+        if (path == "/metrics") return {200, snap->metricsJson};
+        if (path == "/regions") return {200, snap->regionsJson};
+        if (path == "/cultures") return {200, snap->culturesJson};
+        if (path == "/movements") return {200, snap->movementsJson};
+        if (path.rfind("/regions/", 0) == 0) {
+            std::size_t id = 0;
+            if (parseNumber(path.substr(9), id) && id < snap->regionJson.size()) return {200, snap->regionJson[id]};
+            return error(404, "no such region");
+        }
+        return error(404, "not found");
+    }
+
+    if (method == "POST") {
+        try {
+            if (path == "/step") {
+                const auto it = params.find("n");
+                std::uint64_t n = 1;
+                if (it != params.end() && !parseNumber(it->second, n)) return error(400, "bad parameter");
+                return queued(sim_.step(n), "step");
+            }
+            if (path == "/run") return queued(sim_.run(), "run");
+            if (path == "/pause") return queued(sim_.pause(), "pause");
+            if (path == "/reset") {
+                // Unset fields keep the values of the run in progress
+                KernelConfig next = sim_.config();
+                const auto count = [](const std::string& value, std::uint32_t max) {
+                    std::uint64_t n = 0;
+                    if (!parseNumber(value, n)) throw std::invalid_argument(value);
+                    return static_cast<std::uint32_t>(std::min<std::uint64_t>(n, max + 1ull));
+                };
+                for (const auto& [key, value] : params) {
+                    if (key == "population") {
+                        next.population = count(value, kMaxResetPopulation);
+                    } else if (key == "regions") {
+                        next.regions = count(value, kMaxResetRegions);
+                    } else if (key == "k") {
+                        next.avgConnections = count(value, kMaxResetConnections);
+                    } else if (key == "p") {
+                        if (!parseNumber(value, next.rewireProb)) throw std::invalid_argument(value);
+                    } else if (key == "start") {
+                        next.startCondition = value;
+                    } else {
+                        return error(400, "unknown reset parameter " + jsonText(key));
+                    }
+                }
+                if (next.population < 1 || next.population > kMaxResetPopulation) {
+                    return error(400, "population must be 1.." + std::to_string(kMaxResetPopulation));
+                }
+                if (next.regions < 1 || next.regions > kMaxResetRegions) {
+                    return error(400, "regions must be 1.." + std::to_string(kMaxResetRegions));
+                }
+                if (next.avgConnections > kMaxResetConnections || next.avgConnections >= next.population) {
+                    return error(400, "k must be below population and at most " +
+                                          std::to_string(kMaxResetConnections));
+                }
+                if (!(next.rewireProb >= 0.0 && next.rewireProb <= 1.0)) {
+                    return error(400, "p must be in [0, 1]");
+                }
+                if (Economy::canonicalStartCondition(next.startCondition).empty()) {
+                    return error(400, "unknown start condition");
+                }
+                return queued(sim_.reset(next), "reset");
+            }
+        } catch (const std::exception&) {
+            return error(400, "bad parameter");
+        }
+        return error(404, "not found");
+    }
+    return error(405, "use GET or POST");
+}
+
+#ifdef _WIN32
+
+void HttpServer::serve() {
+    throw std::runtime_error("HTTP server mode needs POSIX sockets");
+}
+
+void HttpServer::handleConnection(int) {}
+
+#else
+
+namespace {
+
+void sendResponse(int fd, const HttpServer::Response& response, int flags) {
+    std::string out = "HTTP/1.1 " + std::to_string(response.status) + " " + reasonPhrase(response.status) +
+                      "\r\nContent-Type: application/json\r\nContent-Length: " +
+                      std::to_string(response.body.size()) +
+                      "\r\nAccess-Control-Allow-Origin: *\r\nConnection: close\r\n\r\n";
+    out += response.body;
+    for (std::size_t sent = 0; sent < out.size();) {
+        const ssize_t n = ::send(fd, out.data() + sent, out.size() - sent, flags);
+        if (n <= 0) return;
+        sent += static_cast<std::size_t>(n);
+    }
+}
+
+}  // namespace
+
+void HttpServer::handleConnection(int fd) {
+    timeval timeout{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[4096];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < kMaxRequestBytes) {
+        const ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return;
+        request.append(buffer, static_cast<std::size_t>(n));
+    }
+
+    Response response;
+    const auto lineEnd = request.find("\r\n");
+    const auto sp1 = request.find(' ');
+    const auto sp2 = sp1 == std::string::npos ? sp1 : request.find(' ', sp1 + 1);
+    if (lineEnd == std::string::npos || sp2 == std::string::npos || sp2 > lineEnd) {
+        response = error(400, "malformed request");
+    } else {
+        response = handle(request.substr(0, sp1), request.substr(sp1 + 1, sp2 - sp1 - 1));
+    }
+
+    sendResponse(fd, response, 0);
+}
+
+void HttpServer::serve() {
+    std::signal(SIGPIPE, SIG_IGN);  // A client hanging up mid-response is not fatal
+
+    const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) throw std::runtime_error("Failed to create socket");
+    const int one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(all_interfaces_ ? INADDR_ANY : INADDR_LOOPBACK);
+    addr.sin_port = htons(port_);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(listener, 64) != 0) {
+        ::close(listener);
+        throw std::runtime_error("Failed to listen on port " + std::to_string(port_));
+    }
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<int> pending;
+    bool done = false;
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < threads_; ++i) {
+        workers.emplace_back([&] {
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                ready.wait(lock, [&] { return done || !pending.empty(); });
+                if (pending.empty()) return;
+                const int fd = pending.front();
+                pending.pop_front();
+                lock.unlock();
+                handleConnection(fd);
+                ::close(fd);
+                lock.lock();
+            }
+        });
+    }
+
+    // Poll with a timeout so stop() is noticed without a connection
+    pollfd pfd{listener, POLLIN, 0};
+    while (!stop_.load()) {
+        if (::poll(&pfd, 1, 200) <= 0) continue;
+        const int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) continue;
+        bool accepted = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (pending.size() < threads_ * kPendingPerThread) {
+                pending.push_back(fd);
+                accepted = true;
+            }
+        }
+        if (!accepted) {
+            // Handlers are behind: refuse without reading, and never block the accept loop
+            sendResponse(fd, error(503, "server busy"), MSG_DONTWAIT);
+            ::close(fd);
+            continue;
+        }
+        ready.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    ready.notify_all();
+    for (auto& worker : workers) worker.join();
+    ::close(listener);
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef CLI_HTTP_SERVER_H
+#define CLI_HTTP_SERVER_H
+
+#include "io/LiveSimulation.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * HTTP/1.1 front end for a LiveSimulation (POSIX sockets, one request per
+ * connection, a fixed pool of handler threads). Connections beyond a short
+ * backlog per handler are answered 503 and closed.
+ *
+ *   GET  /status /metrics /regions /regions/{id} /cultures /movements
+ *   POST /step?n=N  /run  /pause  /reset?population=&regions=&k=&p=&start=
+ *
+ * GETs answer from the published snapshot and POSTs only queue a command
+ * (202), so no request waits on a tick. /reset rejects out-of-range sizes and
+ * unknown start conditions (400); a reset the kernel still refuses keeps the
+ * current run and shows up as "error" in /status. Parameters left out of a
+ * /reset keep the values of the run in progress (LiveSimulation::config()).
+ *
+ * There is no authentication, so the server listens on the loopback
+ * interface unless allInterfaces is set.
+ */
+class HttpServer {
+public:
+    struct Response {
+        int status = 200;
+        std::string body;
+    };
+
+    HttpServer(LiveSimulation& sim, std::uint16_t port, std::size_t threads = 4, bool allInterfaces = false);
+
+    // Accept connections until stop(); throws std::runtime_error when the
+    // port cannot be bound
+    void serve();
+    // Safe to call from a signal handler
+    void stop() { stop_.store(true); }
+
+    // Route one request (target is path plus optional query string)
+    Response handle(const std::string& method, const std::string& target);
+
+private:
+    void handleConnection(int fd);
+
+    LiveSimulation& sim_;
+    std::uint16_t port_;
+    std::size_t threads_;
+    bool all_interfaces_;
+    std::atomic<bool> stop_{false};
+};
+
+#endif
@@ -1,7 +1,11 @@
 #include "kernel/Kernel.h"
 #include "io/Snapshot.h"
+#include "io/LiveSimulation.h"
+#include "io/MetricsRecorder.h"
+#include "http_server.h"
 #include "modules/Culture.h"
 #include "modules/Economy.h"
+#include "utils/Profiler.h"
 #ifdef HAS_GAME_MODULES
 #include "modules/Movement.h"
 #endif
@@ -11,28 +15,112 @@
 #include <iomanip>
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <filesystem>
 #include <cstdlib>
+#include <stdexcept>
+#include <csignal>
 
 static void printHelp() {
     std::cerr << "Kernel Commands:\n"
               << "  step N             # advance N steps\n"
-              << "  state [traits]     # print JSON snapshot (optional: include traits)\n"
+              << "  state [opts]       # stream JSON snapshot; opts: traits alive fields=id,region,lang,\n"
+              << "                     #   beliefs,traits,age regions=R,.. stride=N sample=F[:SEED]\n"
+              << "  export FILE [opts] # write a snapshot to FILE (state opts plus format=json|columnar)\n"
+              << "  record FILE [opts] # record metric series every tick to FILE; opts: every=1,10,100\n"
+              << "                     #   regions=R,.. series=world|regions|all ('record stop' ends)\n"
+              << "  drift REF OTHER [L]# per-series drift of recording OTHER against REF at level L\n"
               << "  metrics            # print current metrics\n"
               << "  stats              # print detailed statistics (demographics, networks, beliefs)\n"
               << "  reset [N R k p]    # reset with optional: pop, regions, k, rewire_p\n"
               << "  run T log          # run T ticks, log metrics every 'log' steps\n"
-              << "  cluster kmeans K   # detect K cultures via K-means\n"
+              << "  cluster kmeans K [B] # detect K cultures via K-means (B = mini-batch size)\n"
               << "  cluster dbscan e m # detect cultures via DBSCAN (eps, minPts)\n"
-              << "  cultures           # print last detected cultures\n"
+              << "  live K [T]         # keep K live cultures current every tick (0 = off;\n"
+              << "                     #   exact reassignment every T ticks, default 100)\n"
+              << "  cultures           # print live cultures, else the last detected ones\n"
               << "  economy            # show economy summary\n"
               << "  region R           # show regional economy details\n"
               << "  classes            # show emergent economic classes\n"
-              << "  detect_movements   # detect movements from last clustering\n"
+              << "  detect_movements   # detect movements from live or last clustering\n"
               << "  movements          # list active movements with stats\n"
               << "  movement ID        # show detailed info for movement ID\n"
+              << "  fastforward Y      # advance Y years of demography at cohort cost\n"
+              << "  background [cmd]   # cohort background population; cmd: materialize R N\n"
+              << "                     #   | dematerialize R N (move N people in region R)\n"
+              << "  reorder [N] [region] # sort agent slots by graph locality now, or every N\n"
+              << "                     #   ticks (0 = off); region groups slots by region first\n"
+              << "  memory [cmd]       # bytes used, slack and peak per subsystem; cmd: budget MiB\n"
+              << "                     #   (0 = off) | trim (compact, spill events, shrink now)\n"
+              << "  offload [on|off]   # mean-field belief pass on the offload backend; no arg:\n"
+              << "                     #   backend and transfer totals\n"
+              << "  activity [N [T]]   # update quiescent agents (change < T per tick) only every N\n"
+              << "                     #   ticks (0 = exact); no arg: schedule and divergence stats\n"
+              << "  profile [cmd]      # per-phase timings; cmd: reset | on | off | trace on|off\n"
+              << "                     #   | csv FILE | trace FILE (Chrome trace JSON)\n"
               << "  quit               # exit\n"
-              << "\nOptions: use --start=<profile> or SIM_START_CONDITION env var to choose economic start\n";
+              << "\nOptions: use --start=<profile> or SIM_START_CONDITION env var to choose economic start;\n"
+              << "         --background=N adds N people simulated as cohorts only\n"
+              << "         --serve=PORT runs continuously behind an HTTP API instead of reading commands\n"
+              << "         (on 127.0.0.1; --public listens on every interface, unauthenticated)\n"
+              << "         (--publish=N ticks between published snapshots, default 10)\n"
+              << "\nAgent state is stored as " << precision::kName << " (ENABLE_FLOAT_PRECISION)\n";
+}
+
+static void printProfile(const Kernel& kernel) {
+    using profiler::Phase;
+    if (!profiler::Profiler::compiledIn()) {
+        std::cout << "Profiling not compiled in (rebuild with -DENABLE_PROFILING=ON)\n";
+        return;
+    }
+    const auto& prof = profiler::Profiler::instance();
+    std::cout << "\n=== Tick Profile (last " << profiler::Profiler::kWindow << " samples per phase"
+              << (prof.enabled() ? "" : ", paused") << ") ===\n";
+    std::cout << std::left << std::setw(22) << "phase" << std::right
+              << std::setw(8) << "calls" << std::setw(12) << "mean_us" << std::setw(12) << "p99_us"
+              << std::setw(12) << "max_us" << std::setw(12) << "agents/call"
+              << std::setw(10) << "allocs" << std::setw(10) << "events" << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (std::size_t p = 0; p < static_cast<std::size_t>(Phase::COUNT); ++p) {
+        const auto phase = static_cast<Phase>(p);
+        const auto st = prof.stats(phase);
+        if (st.calls == 0) continue;
+        std::cout << std::left << std::setw(22) << profiler::phaseName(phase) << std::right
+                  << std::setw(8) << st.calls << std::setw(12) << st.meanUs
+                  << std::setw(12) << st.p99Us << std::setw(12) << st.maxUs
+                  << std::setw(12) << (st.agentsTouched / st.calls)
+                  << std::setw(10) << st.allocations << std::setw(10) << st.eventsLogged << "\n";
+    }
+    const auto& locality = kernel.locality();
+    if (locality.passes > 0) {
+        std::cout << "Locality: " << locality.passes << " reorder passes; edges within "
+                  << Kernel::kLocalitySpan << " slots " << 100.0 * locality.localEdgesBefore << "% -> "
+                  << 100.0 * locality.localEdgesAfter << "% at tick " << locality.generation << "\n";
+    }
+    std::cout.flush();
+}
+
+static void printMemory(const Kernel& kernel) {
+    const auto usage = kernel.memoryUsage();
+    const auto mib = [](std::size_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+    std::cout << "\n=== Memory (MiB, generation " << kernel.generation() << ") ===\n";
+    std::cout << std::left << std::setw(12) << "subsystem" << std::right << std::setw(12) << "used"
+              << std::setw(12) << "slack" << std::setw(12) << "peak" << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& s : usage.subsystems) {
+        std::cout << std::left << std::setw(12) << s.name << std::right << std::setw(12) << mib(s.used)
+                  << std::setw(12) << mib(s.reserved - s.used) << std::setw(12) << mib(s.peak) << "\n";
+    }
+    std::cout << std::left << std::setw(12) << "total" << std::right << std::setw(12) << mib(usage.used)
+              << std::setw(12) << mib(usage.reserved - usage.used) << std::setw(12) << mib(usage.peak) << "\n";
+    const auto budget = kernel.config().memoryBudget;
+    if (budget > 0) {
+        const auto& stats = kernel.memoryBudgetStats();
+        std::cout << "Budget " << mib(budget) << " MiB: " << stats.compactions << " compactions, "
+                  << stats.spilledSegments << " event segments spilled, " << stats.shrinks << " shrinks, "
+                  << stats.overBudget << " ticks over\n";
+    }
+    std::cout.flush();
 }
 
 static void printClusters(const std::vector<Cluster>& clusters, const Kernel& kernel) {
@@ -97,11 +185,144 @@ static void printClusters(const std::vector<Cluster>& clusters, const Kernel& ke
 }
 
 static std::vector<Cluster> g_lastClusters;
+static std::unique_ptr<KMeansClustering> g_kmeans;
+static int g_kmeansK = 0;
+static std::unique_ptr<MetricsRecorder> g_recorder;  // `record` command; fed after every step
+
+static void stopRecorder() {
+    if (!g_recorder) return;
+    g_recorder->close();
+    std::cerr << "Recorded " << g_recorder->frames() << " ticks to " << g_recorder->path() << " ("
+              << g_recorder->bytesWritten() << " bytes" << (g_recorder->failed() ? ", write failed" : "") << ")\n";
+    g_recorder.reset();
+}
+
+// Live culture index read straight from the kernel: O(K) centroids plus one
+// membership pass, no re-clustering
+static bool refreshLiveClusters(const Kernel& kernel) {
+    const OnlineClustering* live = kernel.liveClusters();
+    if (!live) return false;
+    g_lastClusters = live->snapshot(kernel.agents(), kernel.generation());
+    enrichClusters(g_lastClusters, kernel);
+    return true;
+}
+
+// Comma-separated unsigned list, e.g. "3,7,12"
+static bool parseList(const std::string& text, std::vector<std::uint32_t>& out) {
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        try {
+            out.push_back(static_cast<std::uint32_t>(std::stoul(item)));
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Export options from the rest of a command line: `traits`, `alive`,
+// fields=a,b  regions=1,2  stride=N  sample=F[:SEED]  format=json|columnar  precision=N
+static bool parseExportOptions(std::istringstream& iss, ExportOptions& options) {
+    static const std::map<std::string, std::uint32_t> fieldNames = {
+        {"id", kExportId}, {"region", kExportRegion}, {"lang", kExportLang},
+        {"beliefs", kExportBeliefs}, {"traits", kExportTraits}, {"age", kExportAge}};
+    std::string token;
+    while (iss >> token) {
+        const auto eq = token.find('=');
+        const std::string key = token.substr(0, eq);
+        const std::string value = eq == std::string::npos ? "" : token.substr(eq + 1);
+        try {
+            if (token == "traits") {
+                options.fields |= kExportTraits;
+            } else if (token == "alive") {
+                options.aliveOnly = true;
+            } else if (key == "fields") {
+                options.fields = 0;
+                std::istringstream names(value);
+                std::string name;
+                while (std::getline(names, name, ',')) {
+                    const auto it = fieldNames.find(name);
+                    if (it == fieldNames.end()) return false;
+                    options.fields |= it->second;
+                }
+            } else if (key == "regions") {
+                if (!parseList(value, options.regions)) return false;
+            } else if (key == "stride") {
+                options.stride = static_cast<std::uint32_t>(std::stoul(value));
+            } else if (key == "sample") {
+                const auto colon = value.find(':');
+                options.sampleFraction = std::stod(value.substr(0, colon));
+                if (colon != std::string::npos) options.sampleSeed = std::stoull(value.substr(colon + 1));
+            } else if (key == "format" && (value == "json" || value == "columnar")) {
+                options.format = value == "json" ? ExportOptions::Format::Json : ExportOptions::Format::Columnar;
+            } else if (key == "precision") {
+                options.precision = std::stoi(value);
+            } else {
+                return false;
+            }
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return true;
+}
 
 #ifdef HAS_GAME_MODULES
 static MovementModule g_movements;
 #endif
 
+static HttpServer* g_server = nullptr;
+
+static void stopServer(int) {
+    if (g_server) g_server->stop();
+}
+
+// Server mode: the kernel steps on a worker thread from the start; HTTP
+// readers see the snapshot it publishes every `publishInterval` ticks
+static int runServer(const KernelConfig& cfg, std::uint16_t port, std::uint32_t publishInterval, bool allInterfaces) {
+    LiveSimulation::Options options;
+    options.publishInterval = publishInterval;
+    LiveSimulation sim(cfg, options);
+#ifdef HAS_GAME_MODULES
+    // Movements track the live cultures, so they update once per snapshot
+    sim.setPublishHook([](Kernel& kernel, const std::vector<Cluster>& clusters, SimSnapshot& snap) {
+        if (clusters.empty()) return;
+        g_movements.update(kernel, clusters, kernel.generation());
+        std::ostringstream json;
+        json << "[";
+        bool first = true;
+        for (const auto* mov : g_movements.movementsByPower()) {
+            json << (first ? "" : ",") << "{\"id\":" << mov->id << ",\"stage\":" << static_cast<int>(mov->stage)
+                 << ",\"size\":" << mov->members.size() << ",\"power\":" << mov->power
+                 << ",\"coherence\":" << mov->coherence << ",\"platform\":[" << mov->platform[0] << ","
+                 << mov->platform[1] << "," << mov->platform[2] << "," << mov->platform[3] << "]}";
+            first = false;
+        }
+        json << "]";
+        snap.movementsJson = json.str();
+    });
+#endif
+    sim.start();
+    sim.run();
+
+    HttpServer server(sim, port, 4, allInterfaces);
+    g_server = &server;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    std::cerr << "Serving on " << (allInterfaces ? "port " : "127.0.0.1:") << port << " (Ctrl-C to stop)\n";
+    try {
+        server.serve();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        g_server = nullptr;
+        return 1;
+    }
+    g_server = nullptr;
+    sim.stop();
+    return 0;
+}
+
 int main(int argc, char** argv) {
     KernelConfig cfg;
     cfg.population = 50000;
@@ -116,10 +337,21 @@ int main(int argc, char** argv) {
     }
 
     const char* scriptArg = nullptr;
+    int servePort = -1;
+    std::uint32_t publishInterval = 10;
+    bool servePublic = false;
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
         if (arg.rfind("--start=", 0) == 0) {
             cfg.startCondition = arg.substr(8);
+        } else if (arg.rfind("--background=", 0) == 0) {
+            cfg.backgroundPopulation = static_cast<std::uint32_t>(std::stoul(arg.substr(13)));
+        } else if (arg.rfind("--serve=", 0) == 0) {
+            servePort = std::stoi(arg.substr(8));
+        } else if (arg == "--public") {
+            servePublic = true;
+        } else if (arg.rfind("--publish=", 0) == 0) {
+            publishInterval = static_cast<std::uint32_t>(std::stoul(arg.substr(10)));
         } else if (arg == "--help" || arg == "-h") {
             printHelp();
             return 0;
@@ -131,6 +363,14 @@ int main(int argc, char** argv) {
             break;
         }
     }
+
+    if (servePort >= 0) {
+        if (servePort > 65535) {
+            std::cerr << "Invalid port: " << servePort << "\n";
+            return 1;
+        }
+        return runServer(cfg, static_cast<std::uint16_t>(servePort), publishInterval, servePublic);
+    }
     
     Kernel kernel(cfg);
     
@@ -173,13 +413,15 @@ int main(int argc, char** argv) {
             if (n < 1) n = 1;
             for (int i = 0; i < n; ++i) {
                 kernel.step();
+                if (g_recorder) g_recorder->record(kernel);
                 if ((i + 1) % 100 == 0 || i == n - 1) {
                     std::cerr << "Tick " << (i + 1) << "/" << n << "\r";
                     std::cerr.flush();
                 }
             }
             std::cerr << "\n";
-            std::cout << kernelToJson(kernel) << "\n";
+            exportState(kernel, std::cout);
+            std::cout << "\n";
             std::cout.flush();
             
                 } else if (cmd == "cluster") {
@@ -187,13 +429,21 @@ int main(int argc, char** argv) {
                     iss >> method;
                     if (method == "kmeans") {
                         int k = 5;
-                        iss >> k;
+                        std::size_t batch = 0;
+                        iss >> k >> batch;
                         k = std::clamp(k, 2, 20);
-                        std::cerr << "Running K-means with k=" << k << "...\n";
-                        KMeansClustering km(k);
-                        g_lastClusters = km.run(kernel);
-                        std::cerr << "Iterations: " << km.iterationsUsed()
-                                  << " (converged=" << (km.converged() ? "yes" : "no") << ")\n";
+                        // Re-clustering with the same K warm-starts from the last centroids
+                        if (!g_kmeans || g_kmeansK != k) {
+                            g_kmeans = std::make_unique<KMeansClustering>(k);
+                            g_kmeansK = k;
+                        }
+                        g_kmeans->setMiniBatch(batch);
+                        std::cerr << "Running K-means with k=" << k;
+                        if (batch > 0) std::cerr << " (mini-batch " << batch << ")";
+                        std::cerr << "...\n";
+                        g_lastClusters = g_kmeans->run(kernel);
+                        std::cerr << "Iterations: " << g_kmeans->iterationsUsed()
+                                  << " (converged=" << (g_kmeans->converged() ? "yes" : "no") << ")\n";
                         printClusters(g_lastClusters, kernel);
                     } else if (method == "dbscan") {
                         double eps = 0.3;
@@ -205,17 +455,124 @@ int main(int argc, char** argv) {
                         std::cerr << "Noise points: " << db.noisePoints() << "\n";
                         printClusters(g_lastClusters, kernel);
                     } else {
-                        std::cerr << "Usage: cluster kmeans K | cluster dbscan eps minPts\n";
+                        std::cerr << "Usage: cluster kmeans K [batch] | cluster dbscan eps minPts\n";
+                    }
+                } else if (cmd == "live") {
+                    int k = 0;
+                    std::uint32_t ticks = 100;
+                    iss >> k >> ticks;
+                    kernel.setLiveClustering(std::clamp(k, 0, 20), ticks);
+                    if (kernel.liveClusters()) {
+                        std::cerr << "Live culture index: k=" << std::clamp(k, 2, 20)
+                                  << ", exact reassignment every " << std::max<std::uint32_t>(1, ticks)
+                                  << " ticks\n";
+                    } else {
+                        std::cerr << "Live culture index off\n";
                     }
                 } else if (cmd == "cultures") {
+                    refreshLiveClusters(kernel);
                     printClusters(g_lastClusters, kernel);
         } else if (cmd == "state") {
-            std::string opt;
-            iss >> opt;
-            bool traits = (opt == "traits");
-            std::cout << kernelToJson(kernel, traits) << "\n";
+            ExportOptions options;
+            if (!parseExportOptions(iss, options) || options.format != ExportOptions::Format::Json) {
+                std::cerr << "Usage: state [traits] [alive] [fields=..] [regions=..] [stride=N] [sample=F[:SEED]]\n";
+            } else {
+                try {
+                    exportState(kernel, std::cout, options);
+                    std::cout << "\n";
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << "\n";
+                }
+            }
             std::cout.flush();
+
+        } else if (cmd == "export") {
+            std::string path;
+            iss >> path;
+            ExportOptions options;
+            if (path.empty() || !parseExportOptions(iss, options)) {
+                std::cerr << "Usage: export FILE [format=json|columnar] [state options]\n";
+            } else {
+                std::ofstream out(path, std::ios::binary);
+                try {
+                    if (!out) throw std::runtime_error("cannot open " + path);
+                    const std::size_t written = exportState(kernel, out, options);
+                    if (!out) throw std::runtime_error("write to " + path + " failed");
+                    std::cerr << "Exported " << written << " agents to " << path << "\n";
+                } catch (const std::exception& e) {
+                    std::cerr << "Error: " << e.what() << "\n";
+                }
+            }
             
+        } else if (cmd == "record") {
+            std::string path;
+            iss >> path;
+            if (path == "stop") {
+                if (!g_recorder) std::cerr << "Not recording\n";
+                stopRecorder();
+                continue;
+            }
+            RecorderOptions options;
+            bool ok = !path.empty();
+            std::string token;
+            while (ok && iss >> token) {
+                const auto eq = token.find('=');
+                const std::string key = token.substr(0, eq);
+                const std::string value = eq == std::string::npos ? "" : token.substr(eq + 1);
+                if (key == "every") {
+                    options.strides.clear();
+                    ok = parseList(value, options.strides);
+                } else if (key == "regions") {
+                    ok = parseList(value, options.regions);
+                } else if (key == "series") {
+                    if (value == "world") {
+                        options.series = kSeriesPopulation | kSeriesPolarization | kSeriesTraits | kSeriesEconomy;
+                    } else if (value == "regions") {
+                        options.series = kSeriesDefault & ~(kSeriesPopulation | kSeriesPolarization |
+                                                            kSeriesTraits | kSeriesEconomy);
+                    } else if (value == "all") {
+                        options.series = kSeriesDefault | kSeriesRegionBeliefs;
+                    } else if (value != "default") {
+                        ok = false;
+                    }
+                } else {
+                    ok = false;
+                }
+            }
+            if (!ok) {
+                std::cerr << "Usage: record FILE [every=1,10,100] [regions=R,..] [series=world|regions|all]"
+                             " | record stop\n";
+                continue;
+            }
+            try {
+                stopRecorder();
+                g_recorder = std::make_unique<MetricsRecorder>(options, path);
+                g_recorder->record(kernel);  // Current tick first; also checks the regions
+                std::cerr << "Recording to " << path << "\n";
+            } catch (const std::exception& e) {
+                g_recorder.reset();
+                std::cerr << "Error: " << e.what() << "\n";
+            }
+
+        } else if (cmd == "drift") {
+            std::string refPath, otherPath;
+            std::size_t level = 0;
+            if (!(iss >> refPath >> otherPath)) {
+                std::cerr << "Usage: drift REF.civm OTHER.civm [level]\n";
+                continue;
+            }
+            iss >> level;
+            try {
+                const auto drift = compareMetrics(readMetricsFile(refPath), readMetricsFile(otherPath), level);
+                std::cout << "series,samples,max_abs,mean_abs,max_rel\n";
+                for (const auto& d : drift) {
+                    std::cout << d.name << ',' << d.samples << ',' << d.maxAbs << ',' << d.meanAbs << ','
+                              << d.maxRel << "\n";
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << "\n";
+            }
+
         } else if (cmd == "metrics") {
             auto m = kernel.computeMetrics();
             std::cout << "Generation: " << kernel.generation() << "\n"
@@ -332,6 +689,7 @@ int main(int argc, char** argv) {
             newCfg.rewireProb = p;
             newCfg.startCondition = cfg.startCondition;
             
+            stopRecorder();  // The region layout may change
             kernel.reset(newCfg);
             g_lastClusters.clear();
             std::cout << "Reset: " << N << " agents, " << R << " regions (start="
@@ -350,6 +708,7 @@ int main(int argc, char** argv) {
             
             for (int t = 0; t < ticks; ++t) {
                 kernel.step();
+                if (g_recorder) g_recorder->record(kernel);
                 if ((t + 1) % 100 == 0 || t == ticks - 1) {
                     std::cerr << "Tick " << (t + 1) << "/" << ticks << "\r";
                     std::cerr.flush();
@@ -406,7 +765,7 @@ int main(int argc, char** argv) {
             for (std::uint32_t r = 0; r < kernel.regionIndex().size(); ++r) {
                 const auto& reg = econ.getRegion(r);
                 if (reg.population > 0) {
-                    systemCounts[reg.economic_system]++;
+                    systemCounts[economicSystemName(reg.economic_system)]++;
                 }
             }
             std::cout << "\nEconomic Systems:\n";
@@ -437,7 +796,7 @@ int main(int argc, char** argv) {
                 std::cout << " - " << quadrant << "\n\n";
                 
                 std::cout << "Population: " << region.population << "\n";
-                std::cout << "Economic System: " << region.economic_system << "\n";
+                std::cout << "Economic System: " << economicSystemName(region.economic_system) << "\n";
                 std::cout << "Development: " << region.development << "\n";
                 std::cout << "Efficiency: " << region.efficiency << "\n\n";
                 
@@ -506,8 +865,9 @@ int main(int argc, char** argv) {
             
         } else if (cmd == "detect_movements") {
 #ifdef HAS_GAME_MODULES
+            refreshLiveClusters(kernel);
             if (g_lastClusters.empty()) {
-                std::cerr << "No clusters detected. Run 'cluster kmeans K' or 'cluster dbscan' first.\n";
+                std::cerr << "No clusters detected. Run 'cluster kmeans K', 'cluster dbscan' or 'live K' first.\n";
                 continue;
             }
             
@@ -552,8 +912,7 @@ int main(int argc, char** argv) {
                 
                 if (!mov->regionalStrength.empty()) {
                     std::cout << "  Top regions: ";
-                    std::vector<std::pair<std::uint32_t, double>> sortedRegions(
-                        mov->regionalStrength.begin(), mov->regionalStrength.end());
+                    auto sortedRegions = mov->regionalStrength;
                     std::sort(sortedRegions.begin(), sortedRegions.end(),
                               [](const auto& a, const auto& b) { return a.second > b.second; });
                     int shown = 0;
@@ -603,17 +962,19 @@ int main(int argc, char** argv) {
             }
             std::cout << "]\n";
             
-            if (!mov->classComposition.empty()) {
+            if (std::any_of(mov->classComposition.begin(), mov->classComposition.end(),
+                            [](double share) { return share > 0.0; })) {
                 std::cout << "Class composition:\n";
-                for (const auto& [decile, proportion] : mov->classComposition) {
+                for (int decile = 0; decile < 10; ++decile) {
+                    const double proportion = mov->classComposition[decile];
+                    if (proportion <= 0.0) continue;
                     std::cout << "  Decile " << decile << ": " << std::setprecision(1) << (proportion * 100.0) << "%\n";
                 }
             }
             
             if (!mov->regionalStrength.empty()) {
                 std::cout << "Regional strength:\n";
-                std::vector<std::pair<std::uint32_t, double>> sortedRegions(
-                    mov->regionalStrength.begin(), mov->regionalStrength.end());
+                auto sortedRegions = mov->regionalStrength;
                 std::sort(sortedRegions.begin(), sortedRegions.end(),
                           [](const auto& a, const auto& b) { return a.second > b.second; });
                 for (const auto& [rid, strength] : sortedRegions) {
@@ -625,6 +986,153 @@ int main(int argc, char** argv) {
             std::cerr << "Movement module not available (built without HAS_GAME_MODULES)\n";
 #endif
             
+        } else if (cmd == "fastforward") {
+            std::uint32_t years = 0;
+            iss >> years;
+            if (years == 0) {
+                std::cerr << "Usage: fastforward YEARS\n";
+            } else {
+                kernel.fastForward(years);
+                std::cerr << "Fast-forwarded " << years << " years to generation " << kernel.generation()
+                          << " (" << kernel.representedPopulation() << " people)\n";
+                exportState(kernel, std::cout);
+                std::cout << "\n";
+                std::cout.flush();
+            }
+            
+        } else if (cmd == "background") {
+            std::string sub;
+            std::uint32_t region = 0;
+            std::uint32_t count = 0;
+            iss >> sub >> region >> count;
+            try {
+                if (sub == "materialize") {
+                    std::cerr << "Materialized " << kernel.materialize(region, count) << " agents\n";
+                } else if (sub == "dematerialize") {
+                    std::cerr << "Folded " << kernel.dematerialize(region, count) << " agents into cohorts\n";
+                } else if (!sub.empty()) {
+                    std::cerr << "Usage: background [materialize R N | dematerialize R N]\n";
+                }
+                std::cout << "Background population: " << kernel.background().getTotalPopulation()
+                          << " in " << kernel.background().cohorts().size() << " cohorts\n"
+                          << "Represented population: " << kernel.representedPopulation() << "\n";
+                std::cout.flush();
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << "\n";
+            }
+            
+        } else if (cmd == "reorder") {
+            std::uint32_t ticks = 0;
+            std::string grouping;
+            if (iss >> ticks) {
+                iss >> grouping;
+                kernel.setReorder(ticks, grouping == "region");
+                if (ticks > 0) {
+                    std::cerr << "Locality reordering every " << ticks << " ticks"
+                              << (grouping == "region" ? ", by region" : "") << "\n";
+                } else {
+                    std::cerr << "Locality reordering off\n";
+                }
+            } else {
+                kernel.reorderAgents();
+                const auto& locality = kernel.locality();
+                std::cout << "Edges within " << Kernel::kLocalitySpan << " slots: "
+                          << 100.0 * locality.localEdgesBefore << "% -> " << 100.0 * locality.localEdgesAfter
+                          << "%\n";
+            }
+            
+        } else if (cmd == "memory") {
+            std::string sub;
+            iss >> sub;
+            if (sub == "budget") {
+                double mib = 0.0;
+                if (!(iss >> mib) || mib < 0.0) {
+                    std::cerr << "Usage: memory budget MiB\n";
+                } else {
+                    kernel.setMemoryBudget(static_cast<std::uint64_t>(mib * 1024.0 * 1024.0));
+                    std::cerr << (mib > 0.0 ? "Memory budget set\n" : "Memory budget off\n");
+                }
+            } else if (sub == "trim") {
+                const auto released = kernel.trimMemory();
+                std::cerr << "Released " << static_cast<double>(released) / (1024.0 * 1024.0) << " MiB\n";
+            } else {
+                printMemory(kernel);
+            }
+            
+        } else if (cmd == "offload") {
+            std::string mode;
+            iss >> mode;
+            if (mode == "on" || mode == "off") {
+                kernel.setBeliefOffload(mode == "on");
+                std::cerr << "Belief offload " << mode << "\n";
+            } else if (const BeliefOffload* offload = kernel.beliefOffload()) {
+                const auto& stats = offload->stats();
+                const auto mib = [](std::uint64_t bytes) { return static_cast<double>(bytes) / (1024.0 * 1024.0); };
+                std::cout << "Belief offload (" << offload->backend() << "): " << stats.passes << " passes, "
+                          << stats.graphUploads << " graph uploads, " << stats.traitUploads << " trait uploads, " << mib(stats.bytesToDevice) << " MiB up, "
+                          << mib(stats.bytesFromDevice) << " MiB down, " << mib(stats.deviceBytes)
+                          << " MiB on device\n";
+            } else {
+                std::cout << "Belief offload off\n";
+            }
+            
+        } else if (cmd == "activity") {
+            long long interval = -1;
+            if (iss >> interval) {
+                double threshold = kernel.config().activityThreshold;
+                iss >> threshold;
+                if (interval < 0 || threshold < 0.0) {
+                    std::cerr << "Usage: activity [N [threshold]]\n";
+                } else {
+                    kernel.setActivity(static_cast<std::uint32_t>(interval), threshold);
+                    std::cerr << (interval > 0 ? "Activity scheduling every " + std::to_string(interval) + " ticks\n"
+                                               : std::string("Activity scheduling off\n"));
+                }
+            } else if (kernel.config().activityInterval == 0) {
+                std::cout << "Activity scheduling off (exact)\n";
+            } else {
+                const auto& stats = kernel.activity();
+                const double total = static_cast<double>(stats.updates + stats.skipped);
+                std::cout << "Activity scheduling every " << kernel.config().activityInterval << " ticks, threshold "
+                          << kernel.config().activityThreshold << ": " << stats.ticks << " ticks, "
+                          << (total > 0.0 ? 100.0 * static_cast<double>(stats.skipped) / total : 0.0)
+                          << "% of updates skipped, " << stats.catchUps << " catch-ups, active share "
+                          << stats.activeShare << "\n"
+                          << "  wakes: " << stats.neighborWakes << " neighbor, " << stats.shockWakes << " shock, "
+                          << stats.demographicWakes << " demographic\n"
+                          << "  skipped drift per tick: " << stats.skippedDrift << " (max " << stats.maxSkippedDrift
+                          << ")\n";
+            }
+            
+        } else if (cmd == "profile") {
+            auto& prof = profiler::Profiler::instance();
+            std::string sub, arg;
+            iss >> sub >> arg;
+            try {
+                if (sub.empty()) {
+                    printProfile(kernel);
+                } else if (sub == "reset") {
+                    prof.reset();
+                    std::cerr << "Profile counters reset\n";
+                } else if (sub == "on" || sub == "off") {
+                    prof.setEnabled(sub == "on");
+                    std::cerr << "Profiling " << (prof.enabled() ? "enabled" : "paused") << "\n";
+                } else if (sub == "trace" && (arg == "on" || arg == "off")) {
+                    prof.setTracing(arg == "on");
+                    std::cerr << "Trace recording " << (prof.tracing() ? "started" : "stopped") << "\n";
+                } else if (sub == "trace" && !arg.empty()) {
+                    prof.writeChromeTrace(arg);
+                    std::cerr << "Wrote " << prof.traceEvents() << " trace events to " << arg << "\n";
+                } else if (sub == "csv" && !arg.empty()) {
+                    prof.writeCsv(arg);
+                    std::cerr << "Wrote profile to " << arg << "\n";
+                } else {
+                    std::cerr << "Usage: profile [reset | on | off | trace on|off | csv FILE | trace FILE]\n";
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Error: " << e.what() << "\n";
+            }
+            
         } else if (cmd == "quit") {
             break;
             
@@ -637,6 +1145,7 @@ int main(int argc, char** argv) {
         }
     }
     
+    stopRecorder();
     return 0;
 }
 
@@ -0,0 +1,167 @@
+#include "kernel/ShardedKernel.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#ifdef CIV_USE_MPI
+#include <mpi.h>
+#endif
+
+static void printHelp() {
+    std::cerr << "Usage: ShardSim [options]\n"
+              << "Runs one world split by region across shards and prints a CSV of world\n"
+              << "metrics and exchange traffic from rank 0.\n\n"
+              << "  --shards=N         # shards as threads of this process (default: MPI ranks\n"
+              << "                     # in an ENABLE_MPI build, else 2)\n"
+              << "  --threads=N        # OpenMP threads per shard (default cores / shards)\n"
+              << "  --population=N     # world agents (default 50000)\n"
+              << "  --regions=N        # world regions (default 200)\n"
+              << "  --ticks=N          # ticks to run (default 100)\n"
+              << "  --every=N          # ticks between samples (default 10)\n"
+              << "  --seed=S           # world seed (default 42)\n"
+              << "  --geo-seed=S       # geography seed (default 0: drawn from --seed)\n";
+}
+
+static void appendNumber(std::string& out, double v) {
+    char text[32];
+    const auto end = std::to_chars(text, text + sizeof(text), v).ptr;
+    out.append(text, end);
+}
+
+// One shard's run; every shard calls the same collectives, rank 0 prints
+static void runShard(const KernelConfig& cfg, Communicator& comm, std::uint64_t ticks, std::uint32_t every) {
+    ShardedKernel shard(cfg, comm);
+    const bool print = comm.rank() == 0;
+    if (print) {
+        std::cout << "gen,alive,welfare,inequality,hardship,polarization_mean,polarization_std,openness,"
+                     "conformity,halo_edges,halo_agents,emigrants,immigrants,bytes_sent\n";
+    }
+    const auto start = std::chrono::steady_clock::now();
+    std::string line;
+    for (std::uint64_t t = 1; t <= ticks; ++t) {
+        shard.step();
+        if (t % every != 0 && t != ticks) continue;
+        const auto alive = shard.population();
+        const auto m = shard.computeMetrics();
+        const auto& traffic = shard.traffic();
+        std::vector<double> totals{static_cast<double>(traffic.haloEdges), static_cast<double>(traffic.haloAgents),
+                                   static_cast<double>(traffic.emigrants), static_cast<double>(traffic.immigrants),
+                                   static_cast<double>(traffic.bytesSent)};
+        comm.allreduceSum(totals);
+        if (!print) continue;
+        line = std::to_string(shard.generation()) + ',' + std::to_string(alive);
+        for (const double v : {m.globalWelfare, m.globalInequality, m.globalHardship, m.polarizationMean,
+                               m.polarizationStd, m.avgOpenness, m.avgConformity}) {
+            line += ',';
+            appendNumber(line, v);
+        }
+        for (const double v : totals) line += ',' + std::to_string(static_cast<std::uint64_t>(v));
+        line += '\n';
+        std::cout << line << std::flush;
+    }
+    if (print) {
+        const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+        std::cerr << ticks << " ticks on " << comm.size() << " shards in " << seconds.count() << " s\n";
+    }
+}
+
+int main(int argc, char** argv) {
+#ifdef CIV_USE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+    KernelConfig cfg;
+    std::uint64_t ticks = 100;
+    std::uint32_t every = 10;
+    int shards = 0;
+    int threads = 0;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            const auto eq = arg.find('=');
+            const std::string key = arg.substr(0, eq);
+            const std::string value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+            if (key == "--shards") {
+                shards = std::stoi(value);
+            } else if (key == "--threads") {
+                threads = std::stoi(value);
+            } else if (key == "--population") {
+                cfg.population = static_cast<std::uint32_t>(std::stoul(value));
+            } else if (key == "--regions") {
+                cfg.regions = static_cast<std::uint32_t>(std::stoul(value));
+            } else if (key == "--ticks") {
+                ticks = std::stoull(value);
+            } else if (key == "--every") {
+                every = static_cast<std::uint32_t>(std::stoul(value));
+            } else if (key == "--seed") {
+                cfg.seed = std::stoull(value);
+            } else if (key == "--geo-seed") {
+                cfg.geographySeed = std::stoull(value);
+            } else if (key == "--help" || key == "-h") {
+                printHelp();
+#ifdef CIV_USE_MPI
+                MPI_Finalize();
+#endif
+                return 0;
+            } else {
+                std::cerr << "Unknown option: " << arg << "\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: bad option value (" << e.what() << ")\n";
+        return 1;
+    }
+    if (every == 0) every = 1;
+
+#ifdef CIV_USE_MPI
+    if (shards == 0) {
+        try {
+            MpiCommunicator comm;
+#ifdef _OPENMP
+            if (threads > 0) omp_set_num_threads(threads);
+#endif
+            runShard(cfg, comm, ticks, every);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            MPI_Abort(MPI_COMM_WORLD, 2);
+        }
+        MPI_Finalize();
+        return 0;
+    }
+#endif
+    if (shards <= 0) shards = 2;
+    if (threads <= 0) threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()) / shards);
+
+    // A failing shard would leave the others blocked in a collective, so the
+    // first error ends the process
+    auto group = LocalCommunicator::group(shards);
+    std::vector<std::thread> workers;
+    for (int r = 0; r < shards; ++r) {
+        workers.emplace_back([&, r] {
+#ifdef _OPENMP
+            omp_set_num_threads(threads);
+#endif
+            try {
+                runShard(cfg, *group[r], ticks, every);
+            } catch (const std::exception& e) {
+                std::cerr << "Shard " << r << " failed: " << e.what() << "\n";
+                std::_Exit(2);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+#ifdef CIV_USE_MPI
+    MPI_Finalize();
+#endif
+    return 0;
+}
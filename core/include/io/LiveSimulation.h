@@ -0,0 +1,121 @@
+#ifndef KERNEL_LIVE_SIMULATION_H
+#define KERNEL_LIVE_SIMULATION_H
+
+#include "kernel/Kernel.h"
+#include "modules/Culture.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Read-only state published by LiveSimulation. Bodies are rendered JSON, so
+// a reader holds the snapshot for as long as it likes without copying.
+struct SimSnapshot {
+    std::uint64_t epoch = 0;  // Increments with every publish
+    std::uint64_t generation = 0;
+    std::uint32_t alive = 0;
+    Kernel::Metrics metrics;
+    std::string metricsJson;
+    std::string regionsJson;              // Summary array, one object per region
+    std::vector<std::string> regionJson;  // Detail per region ID
+    std::string culturesJson;             // Live culture index ("[]" when off)
+    std::string movementsJson = "[]";     // Filled by the publish hook
+};
+
+/**
+ * A kernel stepping on its own worker thread.
+ *
+ * Control calls only queue a command and return; the worker applies queued
+ * commands in order between ticks. After every `publishInterval` ticks, and
+ * whenever it goes idle, the worker renders a SimSnapshot and swaps it in
+ * atomically. Readers take the current snapshot without waiting on the
+ * tick loop, and a snapshot stays valid while any reader still holds it.
+ */
+class LiveSimulation {
+public:
+    struct Options {
+        std::uint32_t publishInterval = 10;  // Ticks between snapshots while stepping
+        std::size_t queueLimit = 1024;       // Control calls beyond this are refused
+    };
+
+    struct Status {
+        std::uint64_t generation = 0;  // Of the latest snapshot
+        std::uint64_t epoch = 0;
+        std::uint64_t pendingSteps = 0;
+        std::size_t queued = 0;
+        bool running = false;
+        std::string lastError;  // Of the last reset ("" if it succeeded)
+    };
+
+    // Runs on the worker (which owns the kernel) after the built-in fields
+    // are rendered; clusters are the live cultures at publish time, empty
+    // when the index is off
+    using PublishHook = std::function<void(Kernel&, const std::vector<Cluster>&, SimSnapshot&)>;
+
+    explicit LiveSimulation(const KernelConfig& config);
+    LiveSimulation(const KernelConfig& config, const Options& options);
+    ~LiveSimulation();
+    LiveSimulation(const LiveSimulation&) = delete;
+    LiveSimulation& operator=(const LiveSimulation&) = delete;
+
+    // Set before start()
+    void setPublishHook(PublishHook hook) { hook_ = std::move(hook); }
+
+    // Publish the initial state and launch the worker; stop() joins it
+    void start();
+    void stop();
+
+    // Queue control; false when the queue is full or the worker is stopped
+    bool step(std::uint64_t ticks);
+    bool run();    // Step until paused
+    bool pause();  // Also drops steps not yet taken
+    bool reset(const KernelConfig& config);
+
+    std::shared_ptr<const SimSnapshot> snapshot() const;
+    Status status() const;
+    // Config of the run in progress: the last reset that took effect (a
+    // queued or failed one leaves it as it was)
+    KernelConfig config() const;
+
+    // Block until the queue is empty and no steps remain, then return the
+    // snapshot published on going idle. Never returns while running.
+    std::shared_ptr<const SimSnapshot> waitIdle() const;
+
+private:
+    struct Command {
+        enum class Kind { Step, Run, Pause, Reset } kind;
+        std::uint64_t ticks = 0;
+        KernelConfig config;
+    };
+
+    bool enqueue(Command command);
+    void workerLoop();
+    void publish();
+
+    std::unique_ptr<Kernel> kernel_;  // Touched only by the worker once started; a reset replaces it
+    Options options_;
+    PublishHook hook_;
+
+    mutable std::mutex mutex_;  // Guards the fields below
+    std::condition_variable wake_;
+    mutable std::condition_variable idle_;
+    std::deque<Command> queue_;
+    std::uint64_t pending_ = 0;
+    bool running_ = false;
+    bool busy_ = false;
+    bool stop_ = false;
+    std::string last_error_;
+    KernelConfig config_;  // kernel_'s config, readable while the worker steps
+    std::thread worker_;
+
+    std::shared_ptr<const SimSnapshot> snapshot_;  // Swapped with std::atomic_store
+    std::uint64_t epoch_ = 0;
+};
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef KERNEL_METRICS_RECORDER_H
+#define KERNEL_METRICS_RECORDER_H
+
+#include "kernel/Kernel.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Series groups a recorder can capture; each adds the columns listed
+enum MetricSeries : std::uint32_t {
+    // World: one value per row
+    kSeriesPopulation = 1u << 0,    // population (live agents)
+    kSeriesPolarization = 1u << 1,  // polarization_mean, polarization_std
+    kSeriesTraits = 1u << 2,        // openness, conformity
+    kSeriesEconomy = 1u << 3,       // welfare, inequality, hardship
+    kSeriesMemory = 1u << 4,        // memory_used, memory_reserved, memory_peak, memory_<subsystem> (reserved)
+    // Per region: one value per recorded region per row
+    kSeriesRegionPopulation = 1u << 8,  // region_population
+    kSeriesRegionEconomy = 1u << 9,     // region_welfare, region_inequality, region_hardship, region_development
+    kSeriesRegionSystem = 1u << 10,     // region_system (EconomicSystem code)
+    kSeriesRegionLanguage = 1u << 11,   // region_language_diversity
+    kSeriesRegionBeliefs = 1u << 12,    // region_belief_0 .. region_belief_3 (mean per axis)
+    kSeriesDefault = kSeriesPopulation | kSeriesPolarization | kSeriesTraits | kSeriesEconomy |
+                     kSeriesRegionPopulation | kSeriesRegionEconomy | kSeriesRegionSystem | kSeriesRegionLanguage,
+};
+
+struct RecorderOptions {
+    std::uint32_t series = kSeriesDefault;
+    std::vector<std::uint32_t> strides = {1, 10, 100};  // One resolution level per stride, in ticks
+    std::vector<std::uint32_t> regions;                 // Regions of per-region series (empty: all)
+    std::uint32_t chunkRows = 256;                      // Rows a level buffers before they are written
+};
+
+struct MetricsColumn {
+    std::string name;
+    bool regional = false;  // One value per recorded region
+    bool last = false;      // Coarse levels keep the window's last value, not its mean
+};
+
+struct MetricsLevel {
+    std::uint32_t stride = 1;
+    std::vector<std::uint64_t> generations;   // Last tick of each row's window
+    std::vector<std::vector<double>> values;  // Per column; regional ones are rows x regions, row-major
+};
+
+struct MetricsHistory {
+    std::vector<std::uint32_t> regions;  // Region IDs of the per-region columns, in order
+    std::vector<MetricsColumn> columns;
+    std::vector<MetricsLevel> levels;    // In RecorderOptions::strides order
+
+    std::size_t column(const std::string& name) const;  // Throws std::invalid_argument if absent
+};
+
+/**
+ * Per-tick metric time series in columnar buffers at several resolutions.
+ *
+ * record() after each step captures the selected world and per-region
+ * series as one frame. Every level folds frames into windows of `stride`
+ * ticks aligned on the generation (a window closes when generation %
+ * stride == 0) and emits one row per window: the mean of its frames, or
+ * the last frame for categorical columns. Rows collect in per-level
+ * columnar chunks of `chunkRows`; full chunks are appended to the file by
+ * a background thread, so the tick loop only pays for the capture (O(R)
+ * per tick, plus computeMetrics() when world series are on and
+ * memoryUsage() for the memory series). close() emits
+ * partial windows, so the last row of a coarse level may cover fewer ticks.
+ *
+ * Without a path every row stays in memory and history() returns it all;
+ * with one, history() holds only rows not yet handed to the writer, and
+ * readMetricsFile() loads the file after close().
+ *
+ * File ("CIVM", little-endian): a 32-byte header (magic, u32 version 1,
+ * u32 levels, u32 columns, u32 regions, 12 reserved bytes), u32 strides,
+ * u32 region IDs, then per column u8 regional, u8 last, u16 name length and
+ * the name, padded to 8 bytes. Blocks follow in write order: u32 level,
+ * u32 rows, u64 generations, then each column as f64 (rows, or rows x
+ * regions).
+ */
+class MetricsRecorder {
+public:
+    // Throws std::invalid_argument on bad options, std::runtime_error if the file cannot be created
+    explicit MetricsRecorder(const RecorderOptions& options = {}, const std::string& path = {});
+    ~MetricsRecorder();  // close()
+    MetricsRecorder(const MetricsRecorder&) = delete;
+    MetricsRecorder& operator=(const MetricsRecorder&) = delete;
+
+    // Capture one frame; the layout (region count) is fixed by the first call
+    void record(const Kernel& kernel);
+    // Emit partial windows and wait until everything is written; later record() calls throw
+    void close();
+
+    MetricsHistory history() const;
+    const std::string& path() const { return path_; }
+    std::uint64_t frames() const { return frames_; }
+    std::uint64_t bytesWritten() const;
+    bool failed() const;  // A write failed (logged); later rows are dropped
+
+private:
+    struct Block {
+        std::uint32_t level = 0;
+        std::vector<std::uint64_t> generations;
+        std::vector<std::vector<double>> values;
+    };
+    struct Level {
+        std::uint32_t stride = 1;
+        std::vector<double> window;  // Frame-wide accumulator
+        std::uint32_t count = 0;     // Frames in the open window
+        std::uint64_t generation = 0;
+        Block pending;
+    };
+
+    void layout(const Kernel& kernel);
+    void capture(const Kernel& kernel);  // Fills frame_
+    Block freshBlock(std::uint32_t level) const;  // Empty, with room for a chunk
+    void emit(Level& level);
+    void submit(Block&& block);
+    void writeLoop();
+
+    RecorderOptions options_;
+    std::string path_;
+    MetricsHistory shape_;                // Regions and columns; levels carry only their strides
+    std::vector<std::size_t> offsets_;    // Column -> first frame slot
+    std::vector<double> frame_;
+    std::vector<Level> levels_;
+    std::vector<Block> kept_;             // Memory mode
+    std::uint64_t frames_ = 0;
+    bool laidOut_ = false;
+    bool closed_ = false;
+
+    // Writer (file mode)
+    std::ofstream out_;
+    std::thread writer_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Block> queue_;
+    bool stopping_ = false;
+    bool failed_ = false;
+    std::uint64_t bytes_ = 0;
+};
+
+// Load a recorder file; throws std::runtime_error if it is not a valid CIVM file
+MetricsHistory readMetricsFile(const std::string& path);
+
+// Difference of one column between two histories over their common rows
+struct MetricDrift {
+    std::string name;
+    std::size_t samples = 0;  // Values compared (rows, or rows x regions)
+    double maxAbs = 0.0;
+    double meanAbs = 0.0;
+    double maxRel = 0.0;      // |a - b| / max(|a|, |b|); 0 where both are 0
+};
+
+// Per-column drift of `candidate` against `reference` at one level, e.g. a
+// float-precision run against a double run of the same seed. Columns match by
+// name and rows by generation; columns or rows only one side has are skipped.
+// Throws std::invalid_argument if the level is missing or the per-region
+// columns cover different regions.
+std::vector<MetricDrift> compareMetrics(const MetricsHistory& reference, const MetricsHistory& candidate,
+                                        std::size_t level = 0);
+
+#endif
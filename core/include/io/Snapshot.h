@@ -2,10 +2,50 @@
 #define KERNEL_SNAPSHOT_H
 
 #include "kernel/Kernel.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <iosfwd>
+#include <vector>
 
-// JSON export for kernel state
+// Per-agent fields an export can carry
+enum ExportField : std::uint32_t {
+    kExportId = 1u << 0,
+    kExportRegion = 1u << 1,
+    kExportLang = 1u << 2,
+    kExportBeliefs = 1u << 3,
+    kExportTraits = 1u << 4,  // openness, conformity, assertiveness, sociality
+    kExportAge = 1u << 5,
+    kExportDefaultFields = kExportId | kExportRegion | kExportLang | kExportBeliefs,
+};
+
+struct ExportOptions {
+    enum class Format {
+        Json,      // Same layout as kernelToJson()
+        Columnar,  // Binary "CIVX" columns, see docs/API.md
+    };
+    Format format = Format::Json;
+    std::uint32_t fields = kExportDefaultFields;
+    std::vector<std::uint32_t> regions;  // Only agents in these regions (empty: all)
+    bool aliveOnly = false;
+    std::uint32_t stride = 1;            // Keep every stride-th selected agent
+    double sampleFraction = 1.0;         // Keep this share of agents, chosen by ID hash
+    std::uint64_t sampleSeed = 0;        // The same seed keeps the same agents across ticks
+    int precision = 4;                   // JSON decimals
+};
+
+// Receives the export in order, in chunks of up to kExportChunkBytes
+using ExportSink = std::function<void(const char* data, std::size_t size)>;
+constexpr std::size_t kExportChunkBytes = 64 * 1024;
+
+// Stream kernel state to a sink without building it in memory; returns the
+// number of agents written. Throws std::invalid_argument on a bad option.
+std::size_t exportState(const Kernel& kernel, const ExportSink& sink, const ExportOptions& options = {});
+std::size_t exportState(const Kernel& kernel, std::ostream& out, const ExportOptions& options = {});
+
+// JSON export for kernel state (whole population as one string; prefer
+// exportState() for large runs)
 std::string kernelToJson(const Kernel& kernel, bool includeTraits = false);
 
 // CSV metrics logging
@@ -0,0 +1,150 @@
+#ifndef ACTIVITY_SET_H
+#define ACTIVITY_SET_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "utils/MemoryFootprint.h"
+
+class SocialGraph;
+
+/**
+ * Activity-driven update schedule (KernelConfig::activityInterval).
+ *
+ * Each update records how fast the agent is still moving: the drift of its
+ * smoothed social target (the belief pass; beliefs themselves jitter with
+ * innovation noise forever) or its belief pull (pairwise pass), and the
+ * per-tick change of its health, stress and mental health. After kSettleUpdates updates in a row below the
+ * threshold, an agent is quiescent. The belief pass and the health and
+ * psychology stages then visit it only every `interval` ticks, integrating
+ * the skipped ticks in one step. A change above the threshold wakes the
+ * agent's graph neighbors, and the kernel also wakes regions hit by an
+ * economic shock and agents touched by births, deaths and migration. A woken
+ * agent is due on the next tick and catches up from its last update.
+ *
+ * plan() fixes one tick's schedule, so every stage sees the same due set;
+ * commit() closes it. Slots follow compaction and reordering like the other
+ * per-slot tables (compact(), reorder()), and slots added mid-tick are due.
+ * Between ticks the schedule is only each slot's SlotState, which is what
+ * checkpoints carry.
+ *
+ * Divergence from exact mode is measured, not bounded. Every tick a rotating
+ * 1/kSampleStride of the skipped agents is evaluated without being applied,
+ * and Stats reports their belief drift measured as above. A catch-up holds
+ * the agent's inputs at their current values, so that drift is the error it
+ * absorbs per skipped tick. For the whole-run effect, record the same seed
+ * with and without the schedule and compare (MetricsRecorder, compareMetrics).
+ */
+class ActivitySet {
+public:
+    static constexpr std::uint8_t kSettleUpdates = 3;
+    static constexpr std::uint32_t kSampleStride = 64;
+    // Weight of each tick's social target in its moving average: the target
+    // jitters with the neighbors' innovation noise, the average only drifts
+    // when the neighborhood does
+    static constexpr double kTargetSmoothing = 1.0 / 16.0;
+
+    // What a slot carries from one tick to the next
+    struct SlotState {
+        std::uint64_t last = 0;            // Tick of the last update
+        std::array<float, 4> target{};     // Smoothed social target (NaN first: none yet)
+        std::uint8_t quiet = 0;            // Updates in a row below the threshold
+    };
+
+    struct Stats {
+        std::uint64_t ticks = 0;
+        std::uint64_t updates = 0;          // Agent updates run (beliefs, health and psychology share them)
+        std::uint64_t skipped = 0;          // Agent updates deferred
+        std::uint64_t catchUps = 0;         // Updates that integrated more than one tick
+        std::uint64_t neighborWakes = 0;    // Quiescent agents woken by a changing neighbor
+        std::uint64_t shockWakes = 0;       // ... by an economic shock to their region
+        std::uint64_t demographicWakes = 0; // ... by a birth, death or migration next to them
+        double activeShare = 1.0;           // Last tick: share of live agents not quiescent
+        double skippedDrift = 0.0;          // Last tick: mean belief drift per tick of sampled skipped agents
+        double maxSkippedDrift = 0.0;       // Largest skippedDrift so far
+    };
+
+    void configure(std::uint32_t interval, double threshold);
+    bool enabled() const { return interval_ > 0; }
+    std::uint32_t interval() const { return interval_; }
+    double threshold() const { return threshold_; }
+    void clear();  // Every agent active, statistics zeroed
+    std::size_t size() const { return last_.size(); }
+    SlotState slotState(std::uint32_t slot) const { return {last_[slot], target_[slot], quiet_[slot]}; }
+    // Replace the schedule with saved slots (statistics stay as they are)
+    void restore(const std::vector<SlotState>& slots);
+
+    // Schedule tick `tick` over slots [0, n)
+    void plan(std::size_t n, std::uint64_t tick, const std::uint8_t* alive);
+    // Grow to n slots mid-tick; new slots are due this tick
+    void resize(std::size_t n);
+
+    bool due(std::uint32_t slot) const { return due_[slot] != 0; }
+    std::uint32_t elapsed(std::uint32_t slot) const { return elapsed_[slot]; }  // Ticks a due update integrates
+    // Skipped agents evaluated for the drift estimate this tick (by stable ID)
+    bool sampled(std::uint32_t id) const { return (id + tick_) % kSampleStride == 0; }
+
+    // Per-tick rate of change of a due agent; stages keep the largest.
+    // Concurrent calls must use distinct slots.
+    void noteChange(std::uint32_t slot, double perTick) {
+        change_[slot] = std::max(change_[slot], static_cast<float>(perTick));
+    }
+    // Per-tick move of the smoothed social target (belief pass) since the
+    // agent's last update, largest over the axes; `keep` folds `target` in
+    double targetShift(std::uint32_t slot, const std::array<double, 4>& target, bool keep);
+    // Drift estimate of sampled skipped agents: sum and count over the tick
+    void noteSkippedDrift(double sum, std::uint64_t count);
+
+    // Settle or keep active every due agent, then wake the neighbors of the
+    // agents that changed
+    void commit(const SocialGraph& graph);
+
+    // Make a quiescent agent active (due next tick); returns whether it was quiescent
+    bool wake(std::uint32_t slot);
+    // Wake every neighbor of `slot` (and the slot itself); returns agents woken
+    std::uint32_t wakeNeighbors(const SocialGraph& graph, std::uint32_t slot);
+    void countWakes(std::uint64_t neighbor, std::uint64_t shock, std::uint64_t demographic);
+
+    // Renumber slots after kernel compaction (AgentStore::kNoSlot = removed)
+    void compact(const std::vector<std::uint32_t>& remap);
+    // Lay slots out as `order` lists their old slots (kernel reordering)
+    void reorder(const std::vector<std::uint32_t>& order);
+
+    const Stats& stats() const { return stats_; }
+    MemoryFootprint memoryUsage() const;
+    void shrinkToFit(std::size_t spare = 0);
+
+    // x after k steps of x -> a x + b (closed form; catch-up of the affine
+    // per-tick rules in the health and psychology stages)
+    static double affine(double x, double a, double b, std::uint32_t k) {
+        if (k == 1) return a * x + b;
+        if (std::abs(1.0 - a) < 1e-12) return x + b * k;
+        const double fixed = b / (1.0 - a);
+        return fixed + (x - fixed) * std::pow(a, static_cast<double>(k));
+    }
+
+private:
+    template <typename Fn>
+    void forEachColumn(Fn&& fn);
+
+    std::uint32_t interval_ = 0;
+    double threshold_ = 0.0;
+    std::uint64_t tick_ = 0;
+
+    // Per slot
+    std::vector<std::uint64_t> last_;    // Tick of the last update
+    std::vector<std::uint8_t> quiet_;    // Updates in a row below the threshold (saturates)
+    std::vector<std::uint8_t> due_;      // This tick's schedule
+    std::vector<std::uint32_t> elapsed_;
+    std::vector<float> change_;          // Largest per-tick change noted this tick
+    std::vector<std::array<float, 4>> target_;  // Moving average of the social target (NaN: none yet)
+
+    double driftSum_ = 0.0;
+    std::uint64_t driftCount_ = 0;
+    Stats stats_;
+};
+
+#endif // ACTIVITY_SET_H
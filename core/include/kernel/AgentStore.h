@@ -0,0 +1,341 @@
+#ifndef AGENT_STORE_H
+#define AGENT_STORE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+#include "kernel/Precision.h"
+#include "kernel/SocialGraph.h"
+#include "modules/Psychology.h"
+#include "modules/Health.h"
+
+// ---------- Agent Record ----------
+// Value type used to construct, copy and serialize a single agent.
+// Live simulation state is held column-wise in AgentStore; this record is
+// only materialized at the edges (initialization, births, checkpoints, tests).
+struct Agent {
+    // Identity: stable ID, never reused; distinct from the agent's storage slot
+    std::uint32_t id = 0;
+    std::uint32_t region = 0;
+    bool alive = true;
+
+    // Demography
+    int age = 0;                        // in years (tick-based)
+    bool female = false;
+
+    // Lineage (Phase 2 integration point)
+    std::int32_t parent_a = -1;
+    std::int32_t parent_b = -1;
+    std::uint32_t lineage_id = 0;
+
+    // Language: family (0-3) + dialect (0-255 for regional variation)
+    // Language families represent major language groups
+    // Dialects encode regional variation within a family
+    std::uint8_t primaryLang = 0;    // language family (0-3)
+    std::uint8_t dialect = 0;         // regional dialect within family
+    double fluency = 1.0;             // 0..1
+
+    // Personality traits (0..1, mean ~0.5)
+    double openness = 0.5;
+    double conformity = 0.5;
+    double assertiveness = 0.5;
+    double sociality = 0.5;
+
+    // Belief state: internal x (unbounded), observable B = tanh(x)
+    std::array<double, 4> x{0, 0, 0, 0};  // internal state
+    std::array<double, 4> B{0, 0, 0, 0};  // beliefs [-1,1]
+    double B_norm_sq = 0.0; // cached squared norm of B
+
+    // Module multipliers (written by tech/media/economy modules)
+    double m_comm = 1.0;        // communication reach/speed
+    double m_susceptibility = 1.0;  // influence susceptibility
+    double m_mobility = 1.0;    // migration/relocation ease
+
+    PsychologicalState psych;
+    HealthState health;
+
+    // Network (sparse adjacency)
+    std::vector<std::uint32_t> neighbors;
+};
+
+// ---------- Neighbor List ----------
+// View of one agent's row in the store's SocialGraph. It holds the graph and
+// row index rather than a pointer, so it stays valid across inserts into
+// other rows; element pointers from begin()/data() do not.
+template <bool Const>
+class BasicNeighborList {
+public:
+    using Graph = std::conditional_t<Const, const SocialGraph, SocialGraph>;
+
+    BasicNeighborList(Graph& graph, std::uint32_t row) : graph_(&graph), row_(row) {}
+
+    std::size_t size() const { return graph_->degree(row_); }
+    bool empty() const { return graph_->degree(row_) == 0; }
+    std::uint32_t operator[](std::size_t i) const { return graph_->data(row_)[i]; }
+    const std::uint32_t* begin() const { return graph_->data(row_); }
+    const std::uint32_t* end() const { return graph_->data(row_) + graph_->degree(row_); }
+
+    template <bool C = Const, typename = std::enable_if_t<!C>>
+    void push_back(std::uint32_t v) const { graph_->push(row_, v); }
+    template <bool C = Const, typename = std::enable_if_t<!C>>
+    void clear() const { graph_->clearRow(row_); }
+
+    operator BasicNeighborList<true>() const { return BasicNeighborList<true>(*graph_, row_); }
+    std::vector<std::uint32_t> toVector() const { return std::vector<std::uint32_t>(begin(), end()); }
+
+private:
+    Graph* graph_;
+    std::uint32_t row_;
+};
+
+using NeighborList = BasicNeighborList<false>;
+using ConstNeighborList = BasicNeighborList<true>;
+
+// ---------- Agent Reference ----------
+// Lightweight proxy returned by AgentStore::operator[]. Every member is a
+// reference into the owning column, so `store[i].B[k]` and
+// `store[i].psych.stress_level` read and write the store directly, and code
+// written against the old AoS layout keeps compiling. Because the proxy is a
+// bundle of references, mutate through a by-value copy:
+//     for (auto agent : store) { agent.age++; }
+// Hot loops should index the columns directly instead; the proxy exists for
+// convenience and for modules that touch an agent's fields in mixed order.
+// A proxy is invalidated by anything that grows the store (push_back/resize).
+template <bool Const>
+struct BasicAgentRef {
+    template <typename T>
+    using Field = std::conditional_t<Const, const T&, T&>;
+
+    // Hot
+    Field<precision::BeliefVec> x;
+    Field<precision::BeliefVec> B;
+    Field<precision::belief_t> B_norm_sq;
+    Field<std::uint32_t> region;
+    Field<std::uint8_t> alive;
+    Field<std::uint8_t> primaryLang;
+    Field<double> fluency;
+    Field<int> age;
+    Field<precision::trait_t> openness;
+    Field<precision::trait_t> conformity;
+    Field<double> assertiveness;
+    Field<double> m_comm;
+    Field<double> m_susceptibility;
+
+    // Cold
+    Field<std::uint32_t> id;
+    Field<std::uint8_t> female;
+    Field<std::int32_t> parent_a;
+    Field<std::int32_t> parent_b;
+    Field<std::uint32_t> lineage_id;
+    Field<std::uint8_t> dialect;
+    Field<precision::trait_t> sociality;
+    Field<double> m_mobility;
+    Field<PsychologicalState> psych;
+    Field<HealthState> health;
+    BasicNeighborList<Const> neighbors;
+
+    // A mutable reference can be passed wherever a read-only one is expected
+    template <bool C = Const, typename = std::enable_if_t<!C>>
+    operator BasicAgentRef<true>() const {
+        return BasicAgentRef<true>{x, B, B_norm_sq, region, alive, primaryLang, fluency, age,
+                                   openness, conformity, assertiveness, m_comm, m_susceptibility,
+                                   id, female, parent_a, parent_b, lineage_id, dialect,
+                                   sociality, m_mobility, psych, health, neighbors};
+    }
+
+    // Materialize a standalone copy of this agent
+    Agent record() const {
+        Agent a;
+        a.id = id;
+        a.region = region;
+        a.alive = alive != 0;
+        a.age = age;
+        a.female = female != 0;
+        a.parent_a = parent_a;
+        a.parent_b = parent_b;
+        a.lineage_id = lineage_id;
+        a.primaryLang = primaryLang;
+        a.dialect = dialect;
+        a.fluency = fluency;
+        a.openness = openness;
+        a.conformity = conformity;
+        a.assertiveness = assertiveness;
+        a.sociality = sociality;
+        a.x = x;
+        a.B = B;
+        a.B_norm_sq = B_norm_sq;
+        a.m_comm = m_comm;
+        a.m_susceptibility = m_susceptibility;
+        a.m_mobility = m_mobility;
+        a.psych = psych;
+        a.health = health;
+        a.neighbors = neighbors.toVector();
+        return a;
+    }
+};
+
+using AgentRef = BasicAgentRef<false>;
+using ConstAgentRef = BasicAgentRef<true>;
+
+// ---------- Agent Store ----------
+/**
+ * Structure-of-arrays agent storage.
+ *
+ * Each agent field lives in its own contiguous column, indexed by slot.
+ * Hot columns are the ones read by the belief update and neighbor scans
+ * (beliefs, region, liveness, language, the traits that drive adaptation);
+ * cold columns hold lineage, psychology and health, which are touched at
+ * most once per tick. Adjacency lives in a CSR SocialGraph (`graph`) with
+ * one row per slot. A neighbor lookup in the belief kernel
+ * therefore pulls a 32-byte belief row instead of a whole ~300-byte record.
+ *
+ * All columns always have the same length; grow the store only through
+ * push_back()/resize() so they stay in lockstep.
+ *
+ * Slots vs IDs: a slot is an index into the columns and changes when
+ * compact() squeezes out dead agents. `id[slot]` is the agent's stable ID,
+ * which never changes and is what event logs, lineage and long-lived
+ * external references (e.g. movement rosters) should hold. IDs are issued
+ * in increasing order and compaction preserves slot order, so the `id`
+ * column stays sorted and slotOf() is a binary search. reorder() moves
+ * agents freely; from then on slotOf() binary-searches a by-ID slot index
+ * instead, which appends and compaction keep current.
+ */
+class AgentStore {
+public:
+    AgentStore() = default;
+    explicit AgentStore(const std::vector<Agent>& records);
+
+    // ---- Hot columns (belief update, neighbor scans) ----
+    // Belief and birth-only trait columns use the build's storage precision
+    // (kernel/Precision.h); the Agent record is always double
+    std::vector<precision::BeliefVec> x;
+    std::vector<precision::BeliefVec> B;
+    std::vector<precision::belief_t> B_norm_sq;
+    std::vector<std::uint32_t> region;
+    std::vector<std::uint8_t> alive;
+    std::vector<std::uint8_t> primaryLang;
+    std::vector<double> fluency;
+    std::vector<int> age;
+    std::vector<precision::trait_t> openness;
+    std::vector<precision::trait_t> conformity;
+    std::vector<double> assertiveness;
+    std::vector<double> m_comm;
+    std::vector<double> m_susceptibility;
+
+    // ---- Cold columns ----
+    std::vector<std::uint32_t> id;
+    std::vector<std::uint8_t> female;
+    std::vector<std::int32_t> parent_a;
+    std::vector<std::int32_t> parent_b;
+    std::vector<std::uint32_t> lineage_id;
+    std::vector<std::uint8_t> dialect;
+    std::vector<precision::trait_t> sociality;
+    std::vector<double> m_mobility;
+    std::vector<PsychologicalState> psych;
+    std::vector<HealthState> health;
+
+    // ---- Adjacency (row per slot) ----
+    SocialGraph graph;
+
+    // Capacity
+    std::size_t size() const { return id.size(); }
+    bool empty() const { return id.empty(); }
+    void clear();
+    void reserve(std::size_t n);
+    void resize(std::size_t n);
+    // Column and by-ID index bytes (the graph reports its own)
+    MemoryFootprint memoryUsage() const;
+    void shrinkToFit(std::size_t spare = 0);  // Column capacity down to size() + spare (not the graph's)
+
+    static constexpr std::uint32_t kNoSlot = SocialGraph::kDropped;
+
+    // Append a record, returning its slot index. agent.id must exceed every ID
+    // already stored (keeps the id column sorted for slotOf()).
+    std::uint32_t push_back(const Agent& agent);
+    // Bulk push_back; grows every column at most once. Returns the first new slot.
+    std::uint32_t append(const std::vector<Agent>& agents);
+
+    // Stable ID -> current slot, or kNoSlot if the agent has been compacted away
+    std::uint32_t slotOf(std::uint32_t agent_id) const;
+
+    // Drop every slot with alive == 0, preserving order. Returns old slot ->
+    // new slot (kNoSlot for removed slots) so callers can remap slot indices.
+    std::vector<std::uint32_t> compact();
+    // Lay slots out as `order` lists them (old slots, each at most once; slots
+    // not listed are dropped). Returns old slot -> new slot like compact().
+    std::vector<std::uint32_t> reorder(const std::vector<std::uint32_t>& order);
+    // Rebuild the by-ID index after writing the id column directly (restore)
+    void reindex();
+
+    // Bumped by every member function that changes columns (all but reserve()
+    // and shrinkToFit()), so a mirror of the columns that change only at birth
+    // or by such calls (traits, id, primaryLang; e.g. on an offload device)
+    // knows when to copy them again. Direct column writes are not seen; follow
+    // them with touch().
+    std::uint64_t version() const { return version_; }
+    void touch() { ++version_; }
+
+    // Materialize / overwrite a single slot
+    Agent record(std::size_t i) const { return (*this)[i].record(); }
+    void assign(std::size_t i, const Agent& agent);
+
+    // Field-style access
+    AgentRef operator[](std::size_t i) {
+        return AgentRef{x[i], B[i], B_norm_sq[i], region[i], alive[i], primaryLang[i],
+                        fluency[i], age[i], openness[i], conformity[i], assertiveness[i],
+                        m_comm[i], m_susceptibility[i],
+                        id[i], female[i], parent_a[i], parent_b[i], lineage_id[i],
+                        dialect[i], sociality[i], m_mobility[i], psych[i], health[i],
+                        NeighborList(graph, static_cast<std::uint32_t>(i))};
+    }
+    ConstAgentRef operator[](std::size_t i) const {
+        return ConstAgentRef{x[i], B[i], B_norm_sq[i], region[i], alive[i], primaryLang[i],
+                             fluency[i], age[i], openness[i], conformity[i], assertiveness[i],
+                             m_comm[i], m_susceptibility[i],
+                             id[i], female[i], parent_a[i], parent_b[i], lineage_id[i],
+                             dialect[i], sociality[i], m_mobility[i], psych[i], health[i],
+                             ConstNeighborList(graph, static_cast<std::uint32_t>(i))};
+    }
+
+    // Range-for support: iterators yield AgentRef/ConstAgentRef by value
+    template <bool Const>
+    class Iterator {
+    public:
+        using Store = std::conditional_t<Const, const AgentStore, AgentStore>;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = BasicAgentRef<Const>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = BasicAgentRef<Const>;
+
+        Iterator(Store* store, std::size_t index) : store_(store), index_(index) {}
+        reference operator*() const { return (*store_)[index_]; }
+        Iterator& operator++() { ++index_; return *this; }
+        Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+        bool operator==(const Iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const Iterator& other) const { return index_ != other.index_; }
+        std::size_t index() const { return index_; }
+
+    private:
+        Store* store_;
+        std::size_t index_;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+private:
+    std::vector<std::uint32_t> by_id_;  // Slots in ID order; empty while the id column is sorted
+    std::uint64_t version_ = 0;
+};
+
+#endif // AGENT_STORE_H
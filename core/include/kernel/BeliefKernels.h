@@ -0,0 +1,123 @@
+#ifndef BELIEF_KERNELS_H
+#define BELIEF_KERNELS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "kernel/Precision.h"
+#include "modules/MeanField.h"
+
+/**
+ * Per-row neighbor influence kernels for Kernel::updateBeliefs().
+ *
+ * Each kernel consumes one agent's CSR neighbor row and accumulates that
+ * agent's influence. Vector variants gather a batch of neighbor belief
+ * columns (4 edges for AVX2, 8 for AVX-512), evaluate similarity and a
+ * polynomial exp in registers, and mask dead/out-of-range neighbors and
+ * the ragged end of the row, so results match the scalar kernel up to
+ * floating-point summation order (~1e-12 relative).
+ *
+ * The implementation is chosen once at runtime from CPUID instead of at
+ * compile time, so one binary runs on every x86-64 host. Set
+ * CIV_BELIEF_KERNEL=scalar|avx2|avx512 to force a variant (unsupported
+ * requests fall back to the best available). Non-x86 targets use the
+ * scalar kernel, which the compiler vectorizes for the baseline ISA.
+ */
+namespace belief_kernels {
+
+enum class Isa { Scalar, AVX2, AVX512 };
+
+// Read-only view of the hot columns a row kernel needs
+struct Columns {
+    const precision::BeliefVec* B = nullptr;
+    const precision::belief_t* B_norm_sq = nullptr;
+    const std::uint8_t* alive = nullptr;
+    const std::uint8_t* lang = nullptr;
+    const double* fluency = nullptr;
+    const double* m_comm = nullptr;
+    std::size_t n = 0;
+};
+
+// Hybrid (mean-field) branch: exponential homophily weights
+struct HybridParams {
+    double homophilyExponent = 2.5;
+    double minWeight = 0.1;
+    double maxWeight = 10.0;
+    double languageBonus = 1.5;
+};
+
+// Pairwise branch: similarity gate x language quality x communication
+struct PairwiseParams {
+    double stepSize = 0.15;
+    double simFloor = 0.05;
+};
+
+using HybridRowFn = void (*)(const Columns& cols, std::uint32_t self,
+                             const std::uint32_t* nbrs, std::uint32_t deg,
+                             const HybridParams& params, NeighborInfluence& out);
+
+using PairwiseRowFn = void (*)(const Columns& cols, std::uint32_t self,
+                               double self_susceptibility,
+                               const std::uint32_t* nbrs, std::uint32_t deg,
+                               const PairwiseParams& params, std::array<double, 4>& acc);
+
+struct Dispatch {
+    Isa isa = Isa::Scalar;
+    const char* name = "scalar";
+    HybridRowFn hybrid = nullptr;
+    PairwiseRowFn pairwise = nullptr;
+};
+
+// Best kernel set for this CPU (resolved on first call, then cached)
+const Dispatch& active();
+
+// Specific kernel set; falls back to the best supported one below `isa`
+const Dispatch& forIsa(Isa isa);
+
+bool supported(Isa isa);
+
+// Padé tanh, identical to Kernel::fastTanh()
+inline double fastTanh(double x) {
+    double x2 = x * x;
+    return x * (27.0 + x2) / (27.0 + 9.0 * x2);
+}
+
+// Scalar reference kernels
+void hybridRowScalar(const Columns& cols, std::uint32_t self,
+                     const std::uint32_t* nbrs, std::uint32_t deg,
+                     const HybridParams& params, NeighborInfluence& out);
+void pairwiseRowScalar(const Columns& cols, std::uint32_t self, double self_susceptibility,
+                       const std::uint32_t* nbrs, std::uint32_t deg,
+                       const PairwiseParams& params, std::array<double, 4>& acc);
+
+// Remote edges of a sharded run: `nbrs` index `halo` (copies of other
+// shards' agents) while `self` stays in `cols`. Scalar only; halo rows are
+// a small share of all edges.
+void hybridHalo(const Columns& cols, std::uint32_t self, const Columns& halo,
+                const std::uint32_t* nbrs, std::uint32_t deg,
+                const HybridParams& params, NeighborInfluence& out);
+void pairwiseHalo(const Columns& cols, std::uint32_t self, double self_susceptibility,
+                  const Columns& halo, const std::uint32_t* nbrs, std::uint32_t deg,
+                  const PairwiseParams& params, std::array<double, 4>& acc);
+
+#if defined(CIV_BELIEF_KERNEL_AVX2)
+void hybridRowAVX2(const Columns& cols, std::uint32_t self,
+                   const std::uint32_t* nbrs, std::uint32_t deg,
+                   const HybridParams& params, NeighborInfluence& out);
+void pairwiseRowAVX2(const Columns& cols, std::uint32_t self, double self_susceptibility,
+                     const std::uint32_t* nbrs, std::uint32_t deg,
+                     const PairwiseParams& params, std::array<double, 4>& acc);
+#endif
+
+#if defined(CIV_BELIEF_KERNEL_AVX512)
+void hybridRowAVX512(const Columns& cols, std::uint32_t self,
+                     const std::uint32_t* nbrs, std::uint32_t deg,
+                     const HybridParams& params, NeighborInfluence& out);
+void pairwiseRowAVX512(const Columns& cols, std::uint32_t self, double self_susceptibility,
+                       const std::uint32_t* nbrs, std::uint32_t deg,
+                       const PairwiseParams& params, std::array<double, 4>& acc);
+#endif
+
+}  // namespace belief_kernels
+
+#endif // BELIEF_KERNELS_H
@@ -0,0 +1,118 @@
+#ifndef BELIEF_OFFLOAD_H
+#define BELIEF_OFFLOAD_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "kernel/BeliefKernels.h"
+
+class AgentStore;
+class MeanFieldApproximation;
+
+/**
+ * Hybrid (mean-field) belief pass on an OpenMP target device.
+ *
+ * Keeps device mirrors of the agent columns the pass reads, the CSR social
+ * graph and the regional fields, and runs the neighbor-influence and apply
+ * kernels there. The graph is copied only when SocialGraph::version()
+ * changes, and the columns fixed at birth (traits, id, primaryLang) only when
+ * AgentStore::version() does. The rest make a round trip every pass: births,
+ * migration, economic feedback and the culture passes read and write
+ * individual beliefs on the host between passes, and the psychology and
+ * feedback stages rewrite m_comm and m_susceptibility every tick. Besides x,
+ * B and B_norm_sq, the host gets back one belief delta per region: the device
+ * sums agents over the CPU pass's slot blocks and then each region's blocks
+ * in block order, so the kernel folds O(regions) values into its incremental
+ * aggregates, as the CPU pass folds its touched rows.
+ *
+ * With ENABLE_GPU_OFFLOAD (CIV_GPU_OFFLOAD) the kernels are OpenMP target
+ * regions on omp_get_default_device(), or on the host when no device is
+ * present. Without it the same kernels run as host parallel loops over host
+ * mirrors, so the backend can be tested on any build.
+ *
+ * Results are not bit-identical to the CPU pass. Innovation noise comes from
+ * Box-Muller on the same Philox stream, because std::normal_distribution is
+ * not available in device code. A run is still reproducible for a given seed
+ * whatever the device or thread count; use compareMetrics() to measure how
+ * far it drifts from the CPU pass.
+ */
+class BeliefOffload {
+public:
+    // Per-agent update rule of the apply kernel (Kernel fills it from TuningConstants)
+    struct ApplyParams {
+        double stepSize = 0.15;
+        double innovationNoise = 0.03;
+        double neighborWeightMin = 0.5;
+        double neighborWeightMax = 0.85;
+        double anchoringMaxAge = 50.0;
+        double anchoringBase = 0.3;
+        double anchoringAgeWeight = 0.4;
+        double anchoringAssertWeight = 0.2;
+    };
+
+    struct Stats {
+        std::uint64_t passes = 0;
+        std::uint64_t graphUploads = 0;     // Passes that had to copy the CSR graph
+        std::uint64_t traitUploads = 0;     // Passes that had to copy the birth-only columns
+        std::uint64_t bytesToDevice = 0;
+        std::uint64_t bytesFromDevice = 0;
+        std::size_t deviceBytes = 0;        // Currently allocated on the device
+    };
+
+    BeliefOffload();
+    ~BeliefOffload();
+    BeliefOffload(const BeliefOffload&) = delete;
+    BeliefOffload& operator=(const BeliefOffload&) = delete;
+
+    // One belief pass over `agents`: updates x, B and B_norm_sq and fills
+    // `regionDeltas` with each region's belief change, summed over `blocks`
+    // slot blocks in block order
+    void run(AgentStore& agents, const MeanFieldApproximation& field,
+             const belief_kernels::HybridParams& hybrid, const ApplyParams& apply,
+             std::uint64_t seed, std::uint64_t generation,
+             std::vector<std::array<double, 4>>& regionDeltas, std::size_t blocks);
+
+    // Forget the mirrored graph and columns (the store was replaced wholesale)
+    void invalidate() {
+        graphVersion_ = kNoGraph;
+        storeVersion_ = kNoGraph;
+    }
+    // Free device memory; the next run() allocates and uploads again
+    void release();
+
+    bool accelerated() const { return device_ != host_; }  // Kernels run off the host
+    const char* backend() const;  // "omp-target", "omp-target (host fallback)" or "host"
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Buffer {
+        void* ptr = nullptr;
+        std::size_t bytes = 0;
+    };
+    static constexpr std::uint64_t kNoGraph = ~std::uint64_t{0};
+
+    template <typename T>
+    T* reserve(Buffer& buf, std::size_t count);  // Grows geometrically; contents are not kept
+    template <typename T>
+    T* upload(Buffer& buf, const T* host, std::size_t count);
+    template <typename T>
+    void download(T* host, const Buffer& buf, std::size_t count);
+    void free(Buffer& buf);
+
+    int device_ = 0;
+    int host_ = 0;
+    std::uint64_t graphVersion_ = kNoGraph;
+    std::uint64_t storeVersion_ = kNoGraph;  // AgentStore::version() of the trait mirrors
+    Stats stats_;
+
+    // Graph
+    Buffer offsets_, degrees_, targets_;
+    // Agent columns
+    Buffer x_, b_, normSq_, alive_, lang_, region_, age_, openness_, conformity_,
+        assertiveness_, comm_, susceptibility_, id_;
+    // Regional fields, per-agent scratch, per-block and per-region deltas
+    Buffer fields_, strengths_, influence_, change_, deltas_, regionDeltas_;
+};
+
+#endif // BELIEF_OFFLOAD_H
@@ -0,0 +1,86 @@
+#ifndef KERNEL_COMMUNICATOR_H
+#define KERNEL_COMMUNICATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Collective transport between the shards of a ShardedKernel.
+ *
+ * Every call is collective: all ranks make the same calls in the same order.
+ * Reductions gather every rank's contribution and sum them in rank order on
+ * each rank, so all ranks get bitwise-identical results whatever the
+ * transport (replicated state on the shards never drifts apart).
+ */
+class Communicator {
+public:
+    using Bytes = std::vector<std::uint8_t>;
+
+    virtual ~Communicator() = default;
+
+    virtual int rank() const = 0;
+    virtual int size() const = 0;
+
+    // Concatenation of every rank's `count` values, in rank order
+    virtual std::vector<double> allgather(const double* data, std::size_t count) = 0;
+
+    // send[p] goes to rank p (size() entries); returns what each rank sent
+    // here, indexed by sender
+    virtual std::vector<Bytes> exchange(std::vector<Bytes> send) = 0;
+
+    // Element-wise sum over ranks, in place
+    void allreduceSum(double* data, std::size_t count);
+    void allreduceSum(std::vector<double>& data) { allreduceSum(data.data(), data.size()); }
+};
+
+/**
+ * Shards as threads of one process: group(n) returns n communicators that
+ * talk through shared memory, one per thread. Used by tests and for
+ * single-node runs without MPI.
+ */
+class LocalCommunicator : public Communicator {
+public:
+    static std::vector<std::unique_ptr<Communicator>> group(int size);
+
+    int rank() const override { return rank_; }
+    int size() const override;
+    std::vector<double> allgather(const double* data, std::size_t count) override;
+    std::vector<Bytes> exchange(std::vector<Bytes> send) override;
+
+private:
+    struct Shared;
+    LocalCommunicator(std::shared_ptr<Shared> shared, int rank) : shared_(std::move(shared)), rank_(rank) {}
+
+    std::shared_ptr<Shared> shared_;
+    int rank_;
+};
+
+#ifdef CIV_USE_MPI
+/**
+ * MPI transport (cmake -DENABLE_MPI=ON). The caller owns MPI_Init/Finalize;
+ * the communicator duplicates MPI_COMM_WORLD so kernel traffic never mixes
+ * with the application's.
+ */
+class MpiCommunicator : public Communicator {
+public:
+    MpiCommunicator();
+    ~MpiCommunicator() override;
+    MpiCommunicator(const MpiCommunicator&) = delete;
+    MpiCommunicator& operator=(const MpiCommunicator&) = delete;
+
+    int rank() const override { return rank_; }
+    int size() const override { return size_; }
+    std::vector<double> allgather(const double* data, std::size_t count) override;
+    std::vector<Bytes> exchange(std::vector<Bytes> send) override;
+
+private:
+    struct Handle;  // MPI_Comm, kept out of this header so it does not need mpi.h
+    std::unique_ptr<Handle> handle_;
+    int rank_ = 0;
+    int size_ = 1;
+};
+#endif
+
+#endif
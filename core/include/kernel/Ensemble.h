@@ -0,0 +1,88 @@
+#ifndef KERNEL_ENSEMBLE_H
+#define KERNEL_ENSEMBLE_H
+
+#include "kernel/Kernel.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// One kernel of an ensemble, stepped `ticks` times from reset
+struct EnsembleRun {
+    KernelConfig config;
+    std::uint64_t ticks = 100;
+    std::uint32_t sampleInterval = 0;  // Ticks between metric samples (0 = final sample only)
+    int threads = 1;                   // OpenMP threads inside this kernel
+};
+
+struct EnsembleSample {
+    std::size_t run = 0;  // Position in Ensemble::runs()
+    std::uint64_t generation = 0;
+    std::uint32_t alive = 0;
+    Kernel::Metrics metrics;
+};
+
+struct EnsembleOutcome {
+    bool ok = false;
+    std::string error;  // what() of the exception that ended the run
+    std::uint64_t generation = 0;
+    double seconds = 0.0;
+    std::size_t worker = 0;
+};
+
+/**
+ * Runs many independent kernels over a work-stealing pool of threads.
+ *
+ * Runs are dealt to per-worker queues, costliest first; a worker takes from
+ * the front of its own queue and, once empty, steals from the back of the
+ * others. Each worker sets its OpenMP team to the run's `threads`, so a
+ * pool can hold a few wide kernels or many serial ones (workers x threads
+ * should not exceed the cores).
+ *
+ * Runs whose configs share a KernelGeography (same regions, start condition
+ * and geography stream; see KernelConfig::geographySeed) start from one
+ * instance built once, released after the last of them starts. Results are
+ * identical to building each Kernel on its own.
+ *
+ * With Options::initImageDir set, each run starts from its cached init image
+ * (serialization::InitImageCache) when one exists, and the first run of a
+ * config writes it, so repeated jobs skip world construction entirely.
+ */
+class Ensemble {
+public:
+    struct Options {
+        std::size_t workers = 0;  // 0: hardware threads / widest run
+        bool shareGeography = true;
+        std::string initImageDir;  // Empty: always build the initial world
+    };
+
+    struct Summary {
+        std::vector<EnsembleOutcome> runs;  // Indexed like runs()
+        std::size_t failed = 0;
+        std::size_t geographies = 0;  // Worlds built
+        std::size_t initImageHits = 0;  // Runs started from a cached init image
+        std::size_t steals = 0;
+        std::size_t workers = 0;
+        double seconds = 0.0;
+    };
+
+    // Receives samples in completion order, one call at a time
+    using Sink = std::function<void(const EnsembleSample&)>;
+
+    Ensemble();
+    explicit Ensemble(const Options& options);
+
+    std::size_t add(const EnsembleRun& run);  // Returns the run's index
+    const std::vector<EnsembleRun>& runs() const { return runs_; }
+
+    // Block until every run has finished; a run that throws is recorded in
+    // its outcome and does not stop the others
+    Summary run(const Sink& sink);
+
+private:
+    Options options_;
+    std::vector<EnsembleRun> runs_;
+};
+
+#endif
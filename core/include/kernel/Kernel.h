@@ -6,12 +6,23 @@
 #include <cstdint>
 #include <string>
 #include <random>
+#include <optional>
+#include <memory>
+#include "kernel/AgentStore.h"
+#include "kernel/ActivitySet.h"
+#include "kernel/BeliefOffload.h"
+#include "kernel/TickScheduler.h"
 #include "modules/Economy.h"
 #include "modules/Psychology.h"
 #include "modules/Health.h"
 #include "modules/MeanField.h"
+#include "modules/CohortDemographics.h"
+#include "modules/OnlineClustering.h"
 #include "utils/EventLog.h"
 
+namespace serialization { struct CheckpointAccess; }
+class ShardedKernel;
+
 // ---------- Tuning Constants ----------
 // These constants control emergent behavior dynamics and have been empirically tuned.
 // Changing these affects simulation outcomes - document rationale for any changes.
@@ -39,6 +50,8 @@ namespace TuningConstants {
     constexpr double kAgeShiftBase = 0.6;           // Base age shift for belief inheritance
     constexpr double kAgeShiftMaxBonus = 0.4;       // Max bonus from age
     constexpr double kAgeShiftNormalizer = 25.0;    // Age normalization factor
+    constexpr double kCompactionDeadFraction = 0.1; // Dead-slot share that triggers slot reclamation
+    constexpr std::size_t kDemographyChunkSize = 4096; // Slots per parallel demography work unit
     
     // Migration
     constexpr double kHardshipPushWeight = 2.0;     // Hardship contribution to push factor
@@ -60,6 +73,10 @@ struct KernelConfig {
     double simFloor = 0.05;             // minimum similarity gate
     bool useMeanField = true;           // Use mean field approximation (faster)
     std::uint64_t seed = 42;
+    // Regions, endowments and trade partners come from their own stream when
+    // set, so runs differing only in `seed` share one world (0 = drawn from
+    // `seed`, ahead of the agents)
+    std::uint64_t geographySeed = 0;
     std::string startCondition = "baseline"; // economic starting profile
     
     // Demography
@@ -68,58 +85,70 @@ struct KernelConfig {
     double regionCapacity = 500.0;      // target population per region
     bool demographyEnabled = true;      // enable births/deaths
     std::uint32_t maxPopulation = 2000000; // hard cap on total population (safety limit)
+    
+    // Live culture index: K online clusters kept current by the belief pass (0 = off)
+    int liveClusters = 0;
+    std::uint32_t liveClusterReassignTicks = 100;  // exact reassignment period (drift correction)
+    
+    // Metrics: above this many occupied regions, polarization mean/std are
+    // estimated from O(R) sampled region pairs instead of all R^2/2 (0 = always exact)
+    std::uint32_t polarizationSampleRegions = 2048;
+    
+    // Cohort background: people simulated only as region x age-group x sex
+    // cohorts next to the agents, seeded from the initial agent mix (0 = off)
+    std::uint32_t backgroundPopulation = 0;
+    
+    // Locality: every N ticks, drop dead slots and move each agent next to the
+    // median slot of its graph neighbors (0 = off). With reorderByRegion the
+    // slots are grouped by region first, so each regionIndex list becomes one
+    // contiguous range. Changes slot order, so runs differ from unordered ones
+    // (still deterministic).
+    std::uint32_t reorderTicks = 0;
+    bool reorderByRegion = false;
+    
+    // Memory budget: reserved bytes (Kernel::memoryUsage()) above which step()
+    // reclaims dead slots, spills event history and releases spare capacity
+    // (0 = off). Forced reclamation renumbers slots, so runs that hit the
+    // budget differ from runs that do not.
+    std::uint64_t memoryBudget = 0;
+    
+    // Run the mean-field belief pass through BeliefOffload (OpenMP target
+    // device with ENABLE_GPU_OFFLOAD, else host loops). Innovation noise is
+    // drawn differently, so runs differ from CPU ones (still deterministic).
+    // The pairwise pass and sharded runs stay on the CPU.
+    bool offloadBeliefs = false;
+    
+    // Activity scheduling: agents whose belief drift, health and stress change
+    // by less than activityThreshold per tick for a few updates in a row are
+    // updated only every activityInterval ticks, integrating the skipped ticks
+    // on catch-up (0 = exact, every agent every tick). Changing neighbors,
+    // economic shocks and demographic events wake them early. Approximate:
+    // runs differ from exact ones (still deterministic), see ActivitySet.
+    // The offloaded belief pass ignores it.
+    std::uint32_t activityInterval = 0;
+    double activityThreshold = 0.004;
 };
 
-// ---------- Agent Structure ----------
-struct Agent {
-    // Identity
-    std::uint32_t id = 0;
-    std::uint32_t region = 0;
-    bool alive = true;
+// Immutable world reset() starts from. Build once and pass to any number of
+// kernels whose configs it matches(); each copies what it mutates.
+struct KernelGeography {
+    std::uint64_t seed = 0;       // Stream drawn from: geographySeed, else seed
+    bool ownStream = false;       // geographySeed was set
+    std::uint32_t regions = 0;
+    EconomyGeography economy;
+    std::mt19937_64 rngAfter;     // Kernel stream state after drawing (when !ownStream)
     
-    // Demography
-    int age = 0;                        // in years (tick-based)
-    bool female = false;
-    
-    // Lineage (Phase 2 integration point)
-    std::int32_t parent_a = -1;
-    std::int32_t parent_b = -1;
-    std::uint32_t lineage_id = 0;
-    
-    // Language: family (0-3) + dialect (0-255 for regional variation)
-    // Language families represent major language groups
-    // Dialects encode regional variation within a family
-    std::uint8_t primaryLang = 0;    // language family (0-3)
-    std::uint8_t dialect = 0;         // regional dialect within family
-    double fluency = 1.0;             // 0..1
-    
-    // Personality traits (0..1, mean ~0.5)
-    double openness = 0.5;
-    double conformity = 0.5;
-    double assertiveness = 0.5;
-    double sociality = 0.5;
-    
-    // Belief state: internal x (unbounded), observable B = tanh(x)
-    std::array<double, 4> x{0, 0, 0, 0};  // internal state
-    std::array<double, 4> B{0, 0, 0, 0};  // beliefs [-1,1]
-    double B_norm_sq = 0.0; // cached squared norm of B
-    
-    // Module multipliers (written by tech/media/economy modules)
-    double m_comm = 1.0;        // communication reach/speed
-    double m_susceptibility = 1.0;  // influence susceptibility
-    double m_mobility = 1.0;    // migration/relocation ease
-    
-    PsychologicalState psych;
-    HealthState health;
-
-    // Network (sparse adjacency)
-    std::vector<std::uint32_t> neighbors;
+    static std::shared_ptr<const KernelGeography> build(const KernelConfig& cfg);
+    bool matches(const KernelConfig& cfg) const;
 };
 
 // ---------- Kernel Engine ----------
 class Kernel {
 public:
     explicit Kernel(const KernelConfig& cfg);
+    // Start from a shared geography (rebuilt privately on a mismatch); the
+    // result is identical to Kernel(cfg)
+    Kernel(const KernelConfig& cfg, std::shared_ptr<const KernelGeography> geography);
     
     // Lifecycle
     void reset(const KernelConfig& cfg);
@@ -127,20 +156,114 @@ public:
     void stepN(int n);
     
     // Access
-    const std::vector<Agent>& agents() const { return agents_; }
-    std::vector<Agent>& agentsMut() { return agents_; }
+    // agents() is a column store; agents()[i] yields a field-style proxy.
+    // Indices are slots, which shift when dead agents are compacted away;
+    // hold agents().id[slot] (stable ID) across ticks and resolve with slotOf().
+    const AgentStore& agents() const { return agents_; }
+    AgentStore& agentsMut() { ++state_version_; return agents_; }
     const std::vector<std::vector<std::uint32_t>>& regionIndex() const { return regionIndex_; }
     std::uint64_t generation() const { return generation_; }
+    const KernelConfig& config() const { return cfg_; }
     
     // Economy access
     const Economy& economy() const { return economy_; }
-    Economy& economyMut() { return economy_; }
+    Economy& economyMut() { ++state_version_; demography_rates_stale_ = true; return economy_; }
+    
+    // Live culture index (nullptr unless KernelConfig::liveClusters > 0)
+    const OnlineClustering* liveClusters() const { return live_clusters_ ? &*live_clusters_ : nullptr; }
+    // Enable (k > 0) or disable (k = 0) the index on a running kernel
+    void setLiveClustering(int k, std::uint32_t reassignTicks = 100);
+    
+    // Locality reordering (KernelConfig::reorderTicks). reorderAgents() runs a
+    // pass now; slots change as in compaction. Each pass measures the share of
+    // graph edges whose endpoints lie within kLocalitySpan slots of each other.
+    struct LocalityStats {
+        std::uint64_t passes = 0;
+        std::uint64_t generation = 0;   // Of the last pass
+        double localEdgesBefore = 0.0;  // Last pass, before reordering
+        double localEdgesAfter = 0.0;
+    };
+    static constexpr std::uint32_t kLocalitySpan = 128;  // 4 KiB of double belief rows
+    void reorderAgents();
+    void setReorder(std::uint32_t ticks, bool byRegion = false) {
+        cfg_.reorderTicks = ticks;
+        cfg_.reorderByRegion = byRegion;
+    }
+    const LocalityStats& locality() const { return locality_; }
+    
+    // Belief offload (KernelConfig::offloadBeliefs); nullptr while off
+    void setBeliefOffload(bool on);
+    const BeliefOffload* beliefOffload() const { return offload_.get(); }
+    
+    // Activity scheduling (KernelConfig::activityInterval); interval 0 returns
+    // to exact updates. Stats cover the ticks since it was last switched on.
+    void setActivity(std::uint32_t interval, double threshold);
+    void setActivity(std::uint32_t interval) { setActivity(interval, cfg_.activityThreshold); }
+    const ActivitySet::Stats& activity() const { return activity_.stats(); }
+    
+    // Memory accounting. memoryUsage() sums container sizes and capacities
+    // per subsystem (no per-agent walk beyond the graph's degree sum); each
+    // peak is the largest reserved size seen by a memoryUsage() call, which
+    // step() makes every tick under a memory budget and every 64th tick
+    // without one (so a short-lived spike between samples can be missed).
+    struct MemoryUsage {
+        struct Subsystem {
+            const char* name = "";
+            std::size_t used = 0;      // Bytes holding live data
+            std::size_t reserved = 0;  // Bytes allocated; reserved - used is capacity slack
+            std::size_t peak = 0;      // High-water mark of reserved
+        };
+        std::vector<Subsystem> subsystems;  // In kMemorySubsystems order
+        std::size_t used = 0;
+        std::size_t reserved = 0;
+        std::size_t peak = 0;  // Of the reserved total
+    };
+    static constexpr std::size_t kMemorySubsystemCount = 9;
+    // agents (columns), graph, regions (index, aggregates, rate tables, mean
+    // field), economy, trade, events, clusters, background (cohorts) and
+    // scratch (the tick arena, counted as slack)
+    static const std::array<const char*, kMemorySubsystemCount> kMemorySubsystems;
+    MemoryUsage memoryUsage() const;
+    
+    // Budget enforcement (KernelConfig::memoryBudget). Over budget at the end
+    // of a tick, step() works through reclaiming every dead slot, spilling
+    // full event segments (only if the event log has a spill directory) and
+    // shrinking agent-sized containers to fit, stopping once under budget.
+    // Shrinking leaves 1/16 headroom so the next births do not double every
+    // column. If all of it is not enough, it retries only after used bytes
+    // grow by another eighth.
+    struct MemoryBudgetStats {
+        std::uint64_t compactions = 0;   // Forced dead-slot reclamations
+        std::uint64_t spilledSegments = 0;
+        std::uint64_t shrinks = 0;       // Shrink-to-fit passes
+        std::uint64_t overBudget = 0;    // Ticks that ended over budget after all of it
+    };
+    void setMemoryBudget(std::uint64_t bytes) { cfg_.memoryBudget = bytes; }
+    const MemoryBudgetStats& memoryBudgetStats() const { return memory_budget_stats_; }
+    // Run every budget action now, whatever the budget; returns reserved bytes released
+    std::size_t trimMemory();
+    
+    // Cohort demography. Background people age, die and reproduce as cohorts
+    // each tick at O(cohorts) cost; materialize() turns some of a region's
+    // background people into agents (where detail matters) and dematerialize()
+    // folds agents back into it. Both return how many people moved.
+    const CohortDemographics& background() const { return background_; }
+    std::uint64_t representedPopulation() const;  // Live agents + background people
+    std::uint32_t materialize(std::uint32_t region, std::uint32_t count);
+    std::uint32_t dematerialize(std::uint32_t region, std::uint32_t count);
+    // Advance demography by `years` at cohort cost: agents are folded into
+    // cohorts, stepped, and synced back (surplus agents die, missing ones are
+    // materialized from regional donors). Beliefs, networks and the economy
+    // do not advance; use it for burn-in or to skip quiet centuries.
+    void fastForward(std::uint32_t years);
     
     // Event log access
     EventLog& eventLog() { return event_log_; }
     const EventLog& eventLog() const { return event_log_; }
     
-    // Metrics (lightweight for logging)
+    // Metrics (lightweight for logging). computeMetrics() and getStatistics()
+    // are memoized until the next step(), reset() or agentsMut()/economyMut()
+    // call; like other kernel reads they are not safe to call concurrently
     struct Metrics {
         double polarizationMean = 0.0;
         double polarizationStd = 0.0;
@@ -201,23 +324,68 @@ public:
     };
     Statistics getStatistics() const;
     
+    // Per-region live population and mean belief from the incremental aggregates (O(R))
+    void regionalCentroids(std::vector<std::uint32_t>& populations,
+                           std::vector<std::array<double, 4>>& centroids) const;
+    
 private:
+    friend struct KernelBenchAccess;  // civ_bench (bench/) times individual phases
+    friend struct serialization::CheckpointAccess;  // Checkpoint save/restore (utils/Serialization)
+    friend class ShardedKernel;  // Runs this kernel as one shard of a larger world
+    
+    // One shard's kernel: agents only in the shard's regions, hooks into `shard`
+    Kernel(const KernelConfig& cfg, ShardedKernel& shard);
+    // Validated config but no world yet; a checkpoint restore fills it in
+    struct Unbuilt {};
+    Kernel(const KernelConfig& cfg, Unbuilt);
+    
+    void configureModules();  // Size and seed the modules for cfg_ (reset and checkpoint restore)
     void initAgents();
     void buildSmallWorld();
-    void updateBeliefs();
+    void updateBeliefs();  // Picks the instantiation for the current modes
+    template <bool kMeanField, bool kLive, bool kActive>
+    void updateBeliefsIn();
+    void applyEconomicFeedback(std::uint32_t slot, double* acc);  // Per-agent stage of the fused sweep
     
     // Demography
     void stepDemography();
     void stepMigration();  // Migration decisions
-    void createChild(std::uint32_t motherId);
-    void compactDeadAgents();
+    struct MigrationMove {
+        std::uint32_t slot;
+        std::uint32_t origin;
+        std::uint32_t destination;
+    };
+    void commitMigrations(const std::vector<MigrationMove>& moves);
+    void retainTiesAfterMove(std::uint32_t slot, std::uint32_t origin, std::uint32_t destination);
+    void spawnChildren(const std::vector<std::uint32_t>& motherSlots);  // Bulk births, slot order
+    Agent makeChild(std::uint32_t motherSlot, std::uint32_t childId, std::uint32_t childSlot) const;
+    void appendAgents(const std::vector<Agent>& newcomers);  // Columns, reciprocal links, index, economy
+    struct Materialization {
+        CohortKey key;
+        Cohort cohort;  // Health source for the new agents
+        std::uint32_t count;
+    };
+    // Caller keeps the batch within maxPopulation; returns 0 if there is no live donor
+    std::uint32_t materializeAgents(const std::vector<Materialization>& batch);
+    Agent makeMaterialized(const std::vector<std::uint32_t>& donors, const Materialization& from,
+                           std::uint32_t id, std::uint32_t slot) const;
+    void compactDeadAgents(bool force = false);  // force: reclaim any dead slot, not just past the threshold
+    void enforceMemoryBudget(std::size_t used);
+    enum class MemoryAction { Compact, Spill, Shrink };
+    bool runMemoryAction(MemoryAction action);  // Whether it did anything
+    double localEdgeShare() const;  // Edges within kLocalitySpan slots / live edges
     double mortalityRate(int age) const;
     double mortalityPerTick(int age) const;
     double mortalityPerTick(int age, std::uint32_t region_id) const;  // Region-specific mortality
     double fertilityRateAnnual(int age) const;
     double fertilityPerTick(int age) const;
-    double fertilityPerTick(int age, std::uint32_t region_id, const Agent& agent,
-                           const std::array<double, 4>& region_beliefs) const;  // Region and agent-specific fertility
+    double regionalFertilityAnnual(int age, std::uint32_t region_id,
+                                   const std::array<double, 4>& region_beliefs) const;  // Before the per-agent wealth factor
+    double fertilityBaseAnnual(int age, std::uint32_t region_id) const;  // Before the tradition and wealth factors
+    void rebuildDemographyRates();
+    // Feed the agent model's regional rates to a cohort set, with carrying-capacity
+    // pressure against regionCapacity * capacityScale people per region
+    void calibrateCohorts(CohortDemographics& cohorts, double capacityScale) const;
     
     // Language assignment based on region geography
     void assignLanguagesByGeography();
@@ -230,22 +398,43 @@ private:
     void formLocalConnections(std::size_t agent_idx, int max_new_connections = 3);
     
     // Incremental regional aggregates (avoids O(N) recomputation)
-    void updateRegionalAggregates();
-    void onAgentBorn(std::uint32_t agent_id);
-    void onAgentDied(std::uint32_t agent_id);
-    void onAgentMigrated(std::uint32_t agent_id, std::uint32_t from_region, std::uint32_t to_region);
+    void updateRegionalAggregates(const BlockPartials& blockDeltas);  // Fold belief-pass deltas
+    void updateRegionalAggregates(const std::vector<std::array<double, 4>>& regionDeltas);  // ... one row per region
+    void onAgentsBorn(std::uint32_t firstSlot, std::uint32_t count);
+    void onAgentsDied(const std::vector<std::uint32_t>& slots);
+    void onAgentsMigrated(const std::vector<MigrationMove>& moves);
+    // Activity scheduling: wake every agent of the regions whose economy
+    // update swung hardship or changed the economic system
+    void wakeShockedRegions(const std::vector<double>& hardshipBefore,
+                            const std::vector<EconomicSystem>& systemBefore);
     void rebuildRegionalAggregates();  // Full rebuild (used at init and periodically for correction)
+    
+    // Polarization mean/std over occupied regions' centroids (exact or sampled, see KernelConfig)
+    static void measurePolarization(const std::vector<std::uint32_t>& populations,
+                                    const std::vector<std::array<double, 4>>& centroids,
+                                    const KernelConfig& cfg, std::uint64_t generation, Metrics& m);
 
     KernelConfig cfg_;
-    std::vector<Agent> agents_;
-    std::vector<std::vector<std::uint32_t>> regionIndex_;  // region -> agent IDs
+    AgentStore agents_;  // SoA agent columns, indexed by slot
+    std::vector<std::vector<std::uint32_t>> regionIndex_;  // region -> agent slots
+    std::uint32_t nextAgentId_ = 0;  // Next stable ID to issue (IDs are never reused)
     std::uint64_t generation_ = 0;
-    std::mt19937_64 rng_;
+    std::mt19937_64 rng_;  // Serial phases only; per-agent draws use rng::CounterRng
     Economy economy_;  // Economic module
+    std::shared_ptr<const KernelGeography> geography_;  // Shared world for reset(), if given
+    ShardedKernel* shard_ = nullptr;  // Set when this kernel is one shard (see ShardedKernel)
     PsychologyModule psychology_;
     HealthModule health_;
     MeanFieldApproximation mean_field_;  // Mean field approximation
+    std::optional<OnlineClustering> live_clusters_;  // Live culture index (see KernelConfig)
+    std::unique_ptr<BeliefOffload> offload_;  // Device belief pass (see KernelConfig::offloadBeliefs)
+    ActivitySet activity_;  // Quiescent-agent schedule (see KernelConfig::activityInterval)
+    CohortDemographics background_;  // Cohort-only population (see KernelConfig::backgroundPopulation)
+    double background_scale_ = 1.0;  // Background people per initial agent (scales carrying capacity)
     EventLog event_log_;  // Event tracking system
+    TickScheduler scheduler_;  // Fused per-agent stages, rebuilt each tick
+    TickArena arena_;          // Per-tick scratch buffers, reset at the start of step()
+    BlockPartials belief_deltas_;  // Belief pass: per-block regional belief deltas
     
     // Incrementally maintained regional aggregates
     struct RegionalAggregates {
@@ -256,6 +445,32 @@ private:
     std::vector<RegionalAggregates> regional_aggregates_;
     bool aggregates_initialized_ = false;
     
+    // Memoized metrics, valid while their version matches state_version_
+    std::uint64_t state_version_ = 0;
+    mutable std::uint64_t metrics_version_ = ~std::uint64_t{0};
+    mutable std::uint64_t statistics_version_ = ~std::uint64_t{0};
+    mutable Metrics metrics_cache_;
+    mutable Statistics statistics_cache_;
+    
+    // Region x age demographic rates that depend only on the regional economy,
+    // so stepDemography() applies just the per-tick and per-agent terms.
+    // Rebuilt lazily after the economy changes (update, restore, economyMut()).
+    struct DemographyRates {
+        int ages = 0;                        // Row length; older agents use the last row entry
+        std::vector<double> mortality;       // mortalityPerTick(age, region), regions x ages
+        std::vector<double> fertility;       // fertilityBaseAnnual(age, region), regions x ages
+        std::vector<double> hardship;        // Birth multiplier 0.7 + 0.3 (1 - hardship), per region
+        std::vector<double> wealthBaseline;  // Wealth-factor baseline per region; 0 before the transition
+    };
+    DemographyRates demography_rates_;
+    bool demography_rates_stale_ = true;
+    LocalityStats locality_;
+    
+    mutable std::array<std::size_t, kMemorySubsystemCount> memory_peaks_{};
+    mutable std::size_t memory_peak_ = 0;
+    std::size_t memory_retry_above_ = 0;  // Used bytes that re-arm budget enforcement
+    MemoryBudgetStats memory_budget_stats_;
+
     // Pre-computed migration attractiveness (updated periodically, not per-migrant)
     std::vector<double> region_attractiveness_;
     std::vector<std::uint32_t> sorted_attractive_regions_;  // Indices sorted by attractiveness (desc)
@@ -269,12 +484,14 @@ private:
         return x * (27.0 + x2) / (27.0 + 9.0 * x2);
     }
 
-    inline double similarityGate(const Agent& a, const Agent& b) const {
+    inline double similarityGate(std::size_t a, std::size_t b) const {
         // Cosine similarity: (a . b) / (||a|| * ||b||)
         // We use cached squared norms to avoid sqrt.
-        double dot = a.B[0] * b.B[0] + a.B[1] * b.B[1] + a.B[2] * b.B[2] + a.B[3] * b.B[3];
+        const std::array<double, 4> Ba = agents_.B[a];  // Widened from storage precision
+        const std::array<double, 4> Bb = agents_.B[b];
+        double dot = Ba[0] * Bb[0] + Ba[1] * Bb[1] + Ba[2] * Bb[2] + Ba[3] * Bb[3];
         
-        double norm_prod_sq = a.B_norm_sq * b.B_norm_sq;
+        double norm_prod_sq = static_cast<double>(agents_.B_norm_sq[a]) * agents_.B_norm_sq[b];
         
         if (norm_prod_sq < 1e-9) {
             return 1.0; // Both vectors are near-zero, consider them similar
@@ -287,9 +504,9 @@ private:
         return std::max(0.0, (sim - cfg_.simFloor) / (1.0 - cfg_.simFloor));
     }
 
-    inline double languageQuality(const Agent& a, const Agent& b) const {
-        if (a.primaryLang == b.primaryLang) {
-            return 0.5 * (a.fluency + b.fluency);
+    inline double languageQuality(std::size_t a, std::size_t b) const {
+        if (agents_.primaryLang[a] == agents_.primaryLang[b]) {
+            return 0.5 * (agents_.fluency[a] + agents_.fluency[b]);
         }
         return 0.1; // Low quality for different languages
     }
@@ -0,0 +1,96 @@
+#ifndef KERNEL_PRECISION_H
+#define KERNEL_PRECISION_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * Storage precision of agent state, fixed at build time.
+ *
+ * The default build stores every agent column as double. With
+ * ENABLE_FLOAT_PRECISION (CIV_FLOAT_PRECISION) the belief state that the
+ * per-tick passes stream through (x, B, B_norm_sq) is stored as float and the
+ * birth-only traits (openness, conformity, sociality) as 16-bit fixed point,
+ * which halves the belief rows read per neighbor edge (32 -> 16 bytes).
+ * Arithmetic still runs in double: values widen on load and round on store,
+ * so only storage rounding separates the two builds. Checkpoints record the
+ * policy and load only into a build with the same one.
+ */
+namespace precision {
+
+// Unit-interval value in an unsigned fixed-point integer (1 / max(Raw) steps).
+// Converts to and from double implicitly, so it reads like the double field
+// it replaces; out-of-range values clamp to [0, 1].
+template <typename Raw>
+class UnitFixed {
+    static_assert(std::is_unsigned_v<Raw>, "UnitFixed needs an unsigned raw type");
+
+public:
+    static constexpr double kScale = static_cast<double>(std::numeric_limits<Raw>::max());
+    static constexpr double kStep = 1.0 / kScale;
+
+    UnitFixed() = default;
+    UnitFixed(double v) : raw_(encode(v)) {}
+    operator double() const { return raw_ * kStep; }
+    Raw raw() const { return raw_; }
+
+private:
+    static Raw encode(double v) { return static_cast<Raw>(std::lround(std::clamp(v, 0.0, 1.0) * kScale)); }
+    Raw raw_ = 0;
+};
+
+// Four stored beliefs with the interface of std::array<T, 4>; converts to and
+// from std::array<double, 4> so records and centroids stay double
+template <typename T>
+struct BeliefRow {
+    std::array<T, 4> v{};
+
+    BeliefRow() = default;
+    BeliefRow(const std::array<double, 4>& d)
+        : v{static_cast<T>(d[0]), static_cast<T>(d[1]), static_cast<T>(d[2]), static_cast<T>(d[3])} {}
+    operator std::array<double, 4>() const { return {v[0], v[1], v[2], v[3]}; }
+
+    T& operator[](std::size_t i) { return v[i]; }
+    const T& operator[](std::size_t i) const { return v[i]; }
+    T* data() { return v.data(); }
+    const T* data() const { return v.data(); }
+    T* begin() { return v.data(); }
+    T* end() { return v.data() + 4; }
+    const T* begin() const { return v.data(); }
+    const T* end() const { return v.data() + 4; }
+    static constexpr std::size_t size() { return 4; }
+
+    bool operator==(const BeliefRow& other) const { return v == other.v; }
+    bool operator!=(const BeliefRow& other) const { return v != other.v; }
+};
+
+#if defined(CIV_FLOAT_PRECISION)
+using belief_t = float;
+using BeliefVec = BeliefRow<float>;
+using trait_t = UnitFixed<std::uint16_t>;
+inline constexpr const char* kName = "float";
+#else
+using belief_t = double;
+using BeliefVec = std::array<double, 4>;
+using trait_t = double;
+inline constexpr const char* kName = "double";
+#endif
+
+static_assert(sizeof(BeliefVec) == 4 * sizeof(belief_t), "belief rows are packed");
+
+// Squared norm of a stored row, computed in double (same order as the
+// double build's hand-written sums, so that build's results are unchanged)
+template <typename Row>
+inline double normSq(const Row& b) {
+    const double b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+    return b0 * b0 + b1 * b1 + b2 * b2 + b3 * b3;
+}
+
+}  // namespace precision
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef KERNEL_SHARDED_KERNEL_H
+#define KERNEL_SHARDED_KERNEL_H
+
+#include "kernel/BeliefKernels.h"
+#include "kernel/Communicator.h"
+#include "kernel/Kernel.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * One shard of a world whose regions are partitioned across ranks.
+ *
+ * Each rank owns a contiguous block of regions (bands of the region grid)
+ * and runs an ordinary Kernel holding only the agents living there, with
+ * their own regionIndex_ rows and economy records. Agent IDs are unique
+ * per shard; (rank, id) names an agent globally.
+ *
+ * Per tick, across ranks:
+ *  - Halo: beliefs of remote neighbours are mirrored once at the start of
+ *    the tick, so remote edges see exactly what local edges see (the state
+ *    before the belief pass). Remote edges come from small-world rewiring
+ *    that lands on another shard and from ties kept across a migration.
+ *  - Migration: agents that move into another shard's region are handed
+ *    over with their economy record; ties they kept (retainTiesAfterMove)
+ *    become remote edges both ways, and the new shard issues a fresh ID.
+ *  - Economy (every economy tick): regional population and belief totals
+ *    are reduced globally before Economy::update, so production, trade
+ *    flows and prices see the whole world. Region-level state is small and
+ *    replicated; after the update each shard broadcasts the regions it owns
+ *    (systems, inequality, hardship, prices, ...) over everyone's copy.
+ *
+ * All members except the accessors are collective: every rank calls them
+ * in the same order. Reductions sum in rank order, so replicated state is
+ * bitwise identical on all ranks. A one-shard run with geographySeed set
+ * reproduces Kernel(cfg) exactly; with more shards the outcome depends on
+ * the shard count (seeds and rewiring differ) but not on thread counts.
+ * The live culture index and cohort background are not supported.
+ */
+class ShardedKernel {
+public:
+    struct RegionRange {
+        std::uint32_t begin = 0;
+        std::uint32_t end = 0;  // Exclusive
+        bool contains(std::uint32_t region) const { return region >= begin && region < end; }
+        std::uint32_t size() const { return end - begin; }
+    };
+
+    // Regions [begin, end) owned by `rank` of `ranks`: even contiguous blocks
+    static RegionRange regionRange(std::uint32_t regions, int rank, int ranks);
+    static int ownerOf(std::uint32_t region, std::uint32_t regions, int ranks);
+
+    // Communication counters for the last tick (halo) and since construction
+    struct Traffic {
+        std::uint64_t haloEdges = 0;   // Remote edges of local agents
+        std::uint64_t haloAgents = 0;  // Remote agents mirrored here
+        std::uint64_t served = 0;      // Local agents mirrored on other shards
+        std::uint64_t emigrants = 0;
+        std::uint64_t immigrants = 0;
+        std::uint64_t bytesSent = 0;
+    };
+
+    // Every rank passes the same config; population and maxPopulation are
+    // world totals, split between shards by their share of the regions
+    ShardedKernel(const KernelConfig& cfg, Communicator& comm);
+    ~ShardedKernel();
+    ShardedKernel(const ShardedKernel&) = delete;
+    ShardedKernel& operator=(const ShardedKernel&) = delete;
+
+    void step();
+    void stepN(int n);
+
+    // This shard (read only)
+    const Kernel& local() const { return *kernel_; }
+    const KernelConfig& config() const { return cfg_; }  // World config
+    RegionRange regions() const { return range_; }
+    int rank() const { return comm_.rank(); }
+    int shards() const { return comm_.size(); }
+    std::uint64_t generation() const { return kernel_->generation(); }
+    const Traffic& traffic() const { return traffic_; }
+
+    // World totals (collective)
+    std::uint64_t population();
+    Kernel::Metrics computeMetrics();
+
+private:
+    friend class Kernel;  // Calls the hooks below from inside Kernel::step()
+
+    static constexpr std::uint32_t kNoHalo = 0xFFFFFFFFu;
+
+    // A local agent pulled on by an agent of another shard
+    struct RemoteEdge {
+        std::uint32_t local;   // Local ID
+        std::uint32_t peer;    // Rank holding the remote agent
+        std::uint32_t remote;  // ID on that rank
+        std::uint32_t halo = kNoHalo;  // Row in the halo columns (set by rebuildPlan)
+    };
+
+    // Halo rows of one local agent: halo_targets_[first, first + count)
+    struct HaloRow {
+        std::uint32_t slot;
+        std::uint32_t first;
+        std::uint32_t count;
+    };
+
+    // Hooks (Kernel::step order)
+    void exchangeHalo();
+    void addHaloInfluence(const belief_kernels::Columns& cols, const belief_kernels::HybridParams& params,
+                          std::vector<NeighborInfluence>& out) const;
+    void addHaloInfluence(const belief_kernels::Columns& cols, const belief_kernels::PairwiseParams& params,
+                          const std::vector<double>& susceptibility,
+                          std::vector<std::array<double, 4>>& dx) const;
+    void exchangeMigrants();
+    void reduceRegions();
+    void syncRegionEconomy();
+
+    void linkShards(double remoteRewire);  // Cross-shard small-world rewiring
+    void rebuildPlan();                    // Prune edges, agree on who mirrors whom
+    void sortEdges();
+    // Every region's `width` values, each block from its owner (owned block in)
+    std::vector<double> gatherOwned(const std::vector<double>& block, std::size_t width);
+    std::uint64_t outgoing(const std::vector<Communicator::Bytes>& buffers) const;  // Bytes for other ranks
+
+    KernelConfig cfg_;  // World config
+    Communicator& comm_;
+    RegionRange range_;
+    std::vector<std::uint32_t> shard_populations_;  // Initial agents per rank (IDs 0..n-1 each)
+    std::unique_ptr<Kernel> kernel_;
+
+    std::vector<RemoteEdge> edges_;  // Sorted by (local, peer, remote)
+    bool plan_dirty_ = true;         // Edges changed since the last rebuildPlan()
+    std::vector<std::vector<std::uint32_t>> need_;   // Per peer: remote IDs mirrored here (sorted)
+    std::vector<std::vector<std::uint32_t>> serve_;  // Per peer: local IDs it mirrors
+    std::vector<std::uint32_t> need_offset_;         // First halo row of each peer
+
+    // Halo columns, refreshed by exchangeHalo() (belief_kernels::Columns view)
+    std::vector<precision::BeliefVec> halo_B_;
+    std::vector<precision::belief_t> halo_norm_sq_;
+    std::vector<std::uint8_t> halo_alive_;
+    std::vector<std::uint8_t> halo_lang_;
+    std::vector<double> halo_fluency_;
+    std::vector<double> halo_comm_;
+    std::vector<std::uint32_t> halo_targets_;  // Halo row of each edge, in edge order
+    std::vector<HaloRow> halo_rows_;           // Live local agents with remote edges
+
+    Traffic traffic_;
+};
+
+#endif
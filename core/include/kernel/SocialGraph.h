@@ -0,0 +1,137 @@
+#ifndef SOCIAL_GRAPH_H
+#define SOCIAL_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "utils/MemoryFootprint.h"
+
+/**
+ * Compressed-sparse-row social graph with per-row slack.
+ *
+ * Row u occupies targets_[offset_[u], offset_[u] + capacity_[u]); the first
+ * degree_[u] entries are live neighbor IDs. Appending to a row with spare
+ * capacity is O(1) and allocation-free. A full row is relocated to the tail
+ * of targets_ with doubled capacity, leaving a hole behind; holes and dead
+ * targets are reclaimed in one batched pass by compact()/repack().
+ *
+ * Rows are directed: callers maintain reciprocity (see connect()).
+ * Raw pointers and Spans are invalidated by any insert that relocates a row
+ * (which may reallocate targets_) and by compact()/repack(); hold row
+ * indices, not pointers, across mutations.
+ */
+class SocialGraph {
+public:
+    static constexpr std::uint32_t kDefaultSlack = 4;  // Spare entries reserved per row on (re)pack
+    static constexpr std::uint32_t kDropped = 0xFFFFFFFFu;  // Remap sentinel: row/target removed
+
+    // Read-only view of one row
+    struct Span {
+        const std::uint32_t* first = nullptr;
+        std::uint32_t count = 0;
+
+        const std::uint32_t* begin() const { return first; }
+        const std::uint32_t* end() const { return first + count; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+        std::uint32_t operator[](std::size_t i) const { return first[i]; }
+    };
+
+    // Structure
+    void clear();
+    void reserve(std::size_t rows, std::size_t entries);
+    std::size_t numRows() const { return degree_.size(); }
+    std::uint32_t addRow(std::uint32_t reserve = kDefaultSlack);
+    void resizeRows(std::size_t rows);
+    // Replace the whole graph with packed rows: row u holds the next degrees[u]
+    // entries of targets, followed by `slack` spare entries
+    void build(const std::uint32_t* degrees, std::size_t rows, const std::uint32_t* targets,
+               std::uint32_t slack = kDefaultSlack);
+
+    // Row access
+    std::uint32_t degree(std::uint32_t u) const { return degree_[u]; }
+    const std::uint32_t* data(std::uint32_t u) const { return targets_.data() + offset_[u]; }
+    std::uint32_t* data(std::uint32_t u) { return targets_.data() + offset_[u]; }
+    Span row(std::uint32_t u) const { return Span{data(u), degree_[u]}; }
+
+    // Mutation
+    void push(std::uint32_t u, std::uint32_t v);          // Append v to row u (may relocate row u)
+    void connect(std::uint32_t u, std::uint32_t v) { push(u, v); push(v, u); }
+    std::uint32_t erase(std::uint32_t u, std::uint32_t v); // Remove every v from row u, order preserved
+    void truncate(std::uint32_t u, std::uint32_t n);       // Keep the first n entries of row u
+    // Replace row u with [first, first + n); the source may be any row's entries
+    void assign(std::uint32_t u, const std::uint32_t* first, std::size_t n);
+    void clearRow(std::uint32_t u) {
+        degree_[u] = 0;
+        ++version_;
+    }
+
+    // Batched maintenance
+    // Drop every target for which dropTarget(t) is true, empty every row for which
+    // dropRow(u) is true, and repack all rows contiguously with fresh slack.
+    template <typename DropRow, typename DropTarget>
+    void compact(DropRow dropRow, DropTarget dropTarget, std::uint32_t slack = kDefaultSlack);
+    void repack(std::uint32_t slack = kDefaultSlack);
+    // Renumber rows and targets through remap (old -> new index, kDropped to remove).
+    // Surviving rows must map onto [0, rows) one-to-one, in any order; rows are
+    // repacked in new-index order.
+    void remap(const std::vector<std::uint32_t>& remap, std::size_t rows,
+               std::uint32_t slack = kDefaultSlack);
+
+    // Size accounting
+    std::size_t edgeCount() const;                         // Live directed entries
+    std::size_t capacityEntries() const { return targets_.size(); }
+    std::size_t holeEntries() const { return holes_; }
+    std::size_t memoryBytes() const;
+    MemoryFootprint memoryUsage() const;  // Used: row arrays and live entries
+    void shrinkToFit(std::uint32_t slack = kDefaultSlack);  // repack() and release spare capacity
+
+    // Bumped by every mutation above, so a mirror of the graph (e.g. on an
+    // offload device) knows when to copy it again. Writes through data(u)
+    // are not seen; follow them with a mutation (callers use truncate()).
+    std::uint64_t version() const { return version_; }
+    // Whole arrays for bulk copies: row u is targets()[offsets()[u] ..
+    // offsets()[u] + degrees()[u]), over capacityEntries() entries
+    const std::size_t* offsets() const { return offset_.data(); }
+    const std::uint32_t* degrees() const { return degree_.data(); }
+    const std::uint32_t* targets() const { return targets_.data(); }
+
+private:
+    std::vector<std::size_t> offset_;
+    std::vector<std::uint32_t> degree_;
+    std::vector<std::uint32_t> capacity_;
+    std::vector<std::uint32_t> targets_;
+    std::size_t holes_ = 0;  // Entries orphaned by relocated rows
+    std::uint64_t version_ = 0;
+
+    void relocate(std::uint32_t u, std::uint32_t min_capacity);
+};
+
+template <typename DropRow, typename DropTarget>
+void SocialGraph::compact(DropRow dropRow, DropTarget dropTarget, std::uint32_t slack) {
+    const std::size_t rows = degree_.size();
+    std::vector<std::uint32_t> packed;
+    packed.reserve(edgeCount() + rows * static_cast<std::size_t>(slack));
+
+    for (std::size_t u = 0; u < rows; ++u) {
+        const std::size_t start = packed.size();
+        if (!dropRow(static_cast<std::uint32_t>(u))) {
+            const std::uint32_t* src = targets_.data() + offset_[u];
+            for (std::uint32_t k = 0; k < degree_[u]; ++k) {
+                if (!dropTarget(src[k])) {
+                    packed.push_back(src[k]);
+                }
+            }
+        }
+        offset_[u] = start;
+        degree_[u] = static_cast<std::uint32_t>(packed.size() - start);
+        capacity_[u] = degree_[u] + slack;
+        packed.resize(packed.size() + slack);
+    }
+
+    targets_ = std::move(packed);
+    holes_ = 0;
+    ++version_;
+}
+
+#endif // SOCIAL_GRAPH_H
@@ -0,0 +1,215 @@
+#ifndef TICK_SCHEDULER_H
+#define TICK_SCHEDULER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/Profiler.h"
+
+/**
+ * Reusable per-tick scratch storage.
+ *
+ * acquire<T>(n) hands out a value-initialized std::vector<T> of size n from a
+ * per-type pool; reset() returns every buffer to its pool without freeing, so
+ * after warm-up a tick allocates nothing. References stay valid until reset().
+ * Not thread-safe: acquire from the stepping thread, then share the buffer.
+ */
+class TickArena {
+public:
+    template <typename T>
+    std::vector<T>& acquire(std::size_t n);
+
+    void reset();
+    void release();  // reset() and free every buffer (they regrow on demand)
+
+    std::size_t growths() const { return growths_; }  // Buffer reallocations since construction
+    std::size_t bytesReserved() const;
+
+private:
+    struct PoolBase {
+        virtual ~PoolBase() = default;
+        virtual void reset() = 0;
+        virtual std::size_t bytes() const = 0;
+    };
+
+    template <typename T>
+    struct Pool : PoolBase {
+        std::vector<std::unique_ptr<std::vector<T>>> buffers;
+        std::size_t used = 0;
+
+        void reset() override { used = 0; }
+        std::size_t bytes() const override {
+            std::size_t total = 0;
+            for (const auto& b : buffers) total += b->capacity() * sizeof(T);
+            return total;
+        }
+    };
+
+    static std::size_t nextTypeIndex();
+    template <typename T>
+    static std::size_t typeIndex() {
+        static const std::size_t index = nextTypeIndex();
+        return index;
+    }
+
+    std::vector<std::unique_ptr<PoolBase>> pools_;
+    std::size_t growths_ = 0;
+};
+
+template <typename T>
+std::vector<T>& TickArena::acquire(std::size_t n) {
+    const std::size_t index = typeIndex<T>();
+    if (index >= pools_.size()) {
+        pools_.resize(index + 1);
+    }
+    if (!pools_[index]) {
+        pools_[index] = std::make_unique<Pool<T>>();
+    }
+    auto& pool = static_cast<Pool<T>&>(*pools_[index]);
+    if (pool.used == pool.buffers.size()) {
+        pool.buffers.push_back(std::make_unique<std::vector<T>>());
+    }
+    auto& buffer = *pool.buffers[pool.used++];
+    if (n > buffer.capacity()) {
+        ++growths_;
+        profiler::Profiler::noteAllocation();
+    }
+    buffer.assign(n, T{});
+    return buffer;
+}
+
+/**
+ * Per-block regional partial sums of a fixed-block reduction.
+ *
+ * A block's row for a region (`width` doubles) is zeroed the first time the
+ * block touches the region, and fold() visits only touched rows, blocks in
+ * order. A pass therefore costs O(slots + touched rows) instead of zeroing
+ * and folding blocks x regions rows; blocks are slot ranges, so each touches
+ * only the regions its agents live in. Each region's total still adds its
+ * blocks in block order, so results do not depend on the thread count.
+ * Storage is kept between passes.
+ */
+class BlockPartials {
+public:
+    void prepare(std::size_t blocks, std::size_t regions, std::size_t width);
+
+    // Row of `region` in `block`; a block must be filled by one thread at a time
+    double* row(std::size_t block, std::uint32_t region) {
+        const std::size_t cell = block * regions_ + region;
+        double* values = values_.data() + cell * width_;
+        if (!touched_[cell]) {
+            touched_[cell] = 1;
+            order_[block * regions_ + count_[block]++] = region;
+            std::fill(values, values + width_, 0.0);
+        }
+        return values;
+    }
+
+    // fn(region, row) for every touched row, blocks in order
+    template <typename Fn>
+    void fold(Fn&& fn) const {
+        for (std::size_t b = 0; b < blocks_; ++b) {
+            const std::uint32_t* regions = order_.data() + b * regions_;
+            for (std::uint32_t k = 0; k < count_[b]; ++k) {
+                fn(regions[k], values_.data() + (b * regions_ + regions[k]) * width_);
+            }
+        }
+    }
+
+    void release();  // Free the storage (it regrows on demand)
+    std::size_t bytesReserved() const;
+
+private:
+    std::size_t blocks_ = 0;
+    std::size_t regions_ = 0;
+    std::size_t width_ = 0;
+    std::vector<double> values_;         // blocks x regions rows of width
+    std::vector<std::uint8_t> touched_;  // Per (block, region); clear between passes
+    std::vector<std::uint32_t> order_;   // Per block: touched regions in first-touch order
+    std::vector<std::uint32_t> count_;   // Per block: touched regions
+};
+
+/**
+ * Fused per-tick stage runner.
+ *
+ * Modules register stages in execution order:
+ *  - region stages run once per tick on the stepping thread (e.g. derive
+ *    regional inputs from the economy);
+ *  - agent stages run once per slot. Consecutive agent stages are fused into
+ *    a single parallel sweep, so each agent's columns stream through cache
+ *    once; for every slot they run in registration order.
+ * Stages are grouped up to the next `barrier` stage. Within a group, every
+ * region stage runs first (in order), then one sweep runs all agent stages.
+ * Mark a stage `barrier` when it needs the per-agent results of earlier
+ * stages (e.g. a region stage that aggregates agents updated just before).
+ *
+ * An agent stage may only touch its own slot plus read-only shared state.
+ * Regional reductions go through `acc`: `reduceWidth` doubles for the agent's
+ * region, private to the current reduction block. Blocks are fixed slot
+ * ranges (their count depends only on the population, not on the thread
+ * count) and are summed in order, so reductions are reproducible; only the
+ * regions a block touched are zeroed and folded (BlockPartials). After the
+ * sweep, `finalize` sees the per-region totals.
+ */
+class TickScheduler {
+public:
+    // Per-region totals of one agent stage's reduction
+    struct RegionSums {
+        const double* data = nullptr;
+        std::size_t stride = 0;
+        std::size_t offset = 0;
+
+        double operator()(std::size_t region, std::size_t k) const {
+            return data[region * stride + offset + k];
+        }
+    };
+
+    using RegionFn = std::function<void()>;
+    using AgentFn = std::function<void(std::uint32_t slot, double* acc)>;
+    using FinalizeFn = std::function<void(const RegionSums& sums)>;
+
+    struct AgentStage {
+        std::string name;
+        AgentFn update;
+        std::size_t reduceWidth = 0;  // Doubles per region accumulated by this stage
+        FinalizeFn finalize;          // Optional; called once after the sweep
+        bool barrier = false;         // Start a new sweep (needs every earlier stage done)
+    };
+
+    void clear() { stages_.clear(); }
+    void addRegionStage(std::string name, RegionFn fn, bool barrier = false);
+    void addAgentStage(AgentStage stage);
+
+    // Run all stages over slots [0, regionOfSlot.size())
+    void run(const std::vector<std::uint32_t>& regionOfSlot, std::size_t regions, TickArena& arena);
+
+    std::size_t stageCount() const { return stages_.size(); }
+    std::size_t lastSweepCount() const { return lastSweeps_; }
+    const BlockPartials& partials() const { return partials_; }  // Memory accounting
+    void releaseScratch() { partials_.release(); }
+
+    static constexpr std::size_t kMaxReductionBlocks = 64;
+    static constexpr std::size_t kMinBlockSlots = 1024;
+
+private:
+    struct Stage {
+        std::string name;
+        RegionFn region;   // Set for region stages
+        AgentStage agent;  // Used when region is empty
+        bool barrier = false;
+    };
+
+    void sweep(const std::vector<const AgentStage*>& group,
+               const std::vector<std::uint32_t>& regionOfSlot, std::size_t regions, TickArena& arena);
+
+    std::vector<Stage> stages_;
+    std::size_t lastSweeps_ = 0;
+    BlockPartials partials_;
+};
+
+#endif // TICK_SCHEDULER_H
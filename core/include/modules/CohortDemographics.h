@@ -5,8 +5,10 @@
 #include <vector>
 #include <cstdint>
 #include <unordered_map>
+#include <utility>
+#include "utils/MemoryFootprint.h"
 
-struct Agent;
+class AgentStore;
 
 // Cohort key: [Region, AgeGroup, Gender]
 struct CohortKey {
@@ -53,8 +55,8 @@ class CohortDemographics {
 public:
     void configure(std::uint32_t num_regions, std::uint64_t seed);
     
-    // Convert agents to cohorts
-    void buildCohortsFromAgents(const std::vector<Agent>& agents);
+    // Convert agents to cohorts; each live agent stands for `weight` people
+    void buildCohortsFromAgents(const AgentStore& agents, double weight = 1.0);
     
     // Update cohort demographics (births, deaths, aging)
     void updateDemographics(std::uint64_t tick, int ticks_per_year);
@@ -65,12 +67,35 @@ public:
                       const std::vector<double>& regional_infection_pressure);
     
     // Apply cohort changes back to agent population
-    void syncToAgents(std::vector<Agent>& agents, std::uint64_t tick);
+    void syncToAgents(AgentStore& agents, std::uint64_t tick);
+    
+    // Per-tick death and birth probabilities by age group for one region,
+    // supplied by the caller (e.g. from the agent model's curves). Once set,
+    // updateDemographics() uses them as-is in place of the built-in curves and
+    // health/nutrition modifiers. Cleared by configure().
+    using RateTable = std::array<double, 18>;
+    void setRegionRates(std::uint32_t region, const RateTable& mortality, const RateTable& fertility);
+    
+    // Move people between cohorts and individually simulated agents
+    std::uint32_t withdraw(const CohortKey& key, std::uint32_t n);  // Removes up to n, returns removed
+    void deposit(const CohortKey& key, std::uint32_t n, double health, double nutrition);
     
     // Query
-    std::uint32_t getTotalPopulation() const;
+    std::uint64_t getTotalPopulation() const;
+    // Cohort table (estimated: one node per cohort plus the bucket array) and rate tables
+    MemoryFootprint memoryUsage() const;
     std::uint32_t getRegionPopulation(std::uint32_t region) const;
     double getRegionAvgHealth(std::uint32_t region) const;
+    std::vector<std::uint64_t> regionPopulations() const;  // Indexed by region, one pass
+    // Non-empty cohorts of one region, ordered by (age group, sex)
+    std::vector<std::pair<CohortKey, Cohort>> regionCohorts(std::uint32_t region) const;
+    
+    static std::uint8_t ageToGroup(int age);
+    
+    // Checkpoint state: the LCG position, and a wholesale replacement of the
+    // cohort table (after configure(); rates must be set again)
+    std::uint64_t rngState() const { return rng_state_; }
+    void restore(const std::vector<std::pair<CohortKey, Cohort>>& cohorts, std::uint64_t rng_state);
     
     const std::unordered_map<CohortKey, Cohort, CohortKeyHash>& cohorts() const { 
         return cohorts_; 
@@ -80,9 +105,13 @@ private:
     std::unordered_map<CohortKey, Cohort, CohortKeyHash> cohorts_;
     std::uint32_t num_regions_ = 0;
     std::uint64_t rng_state_;  // Simple LCG for deterministic randomness
+    std::vector<RateTable> mortality_;  // Caller-supplied rates by region (empty = built-in curves)
+    std::vector<RateTable> fertility_;
     
     // Helper functions
-    std::uint8_t ageToGroup(int age) const;
+    void absorb(const CohortKey& key, const Cohort& incoming);  // Merge with count-weighted averages
+    double builtinMortality(const CohortKey& key, const Cohort& cohort) const;  // Per tick, health-modified
+    double builtinFertility(const CohortKey& key, const Cohort& cohort) const;
     double computeMortalityRate(std::uint8_t age_group) const;
     double computeFertilityRate(std::uint8_t age_group) const;
     std::uint32_t randomBinomial(std::uint32_t n, double p);
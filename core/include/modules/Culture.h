@@ -8,12 +8,13 @@
 
 // Forward declarations
 class Kernel;
-struct Agent;
+class AgentStore;
+class BeliefGrid;
 
 struct Cluster {
     std::uint32_t id = 0;
     std::array<double, 4> centroid{0, 0, 0, 0};
-    std::vector<std::uint32_t> members;
+    std::vector<std::uint32_t> members;  // Agent slots at clustering time (not stable IDs)
     double coherence = 0.0;
     std::array<double, 4> languageShare{0, 0, 0, 0};  // share per language family
     std::uint8_t dominantLang = 0;                     // most common language family
@@ -24,6 +25,10 @@ struct Cluster {
     std::uint64_t deathTick = 0;
 };
 
+// Lloyd's k-means with Hamerly bounds: each agent keeps an upper bound to its
+// own centroid and a lower bound to the rest, so most agents skip the
+// distance scan once clusters settle. Sweeps run under OpenMP; centroid sums
+// use fixed blocks so results do not depend on the thread count.
 class KMeansClustering {
 public:
     KMeansClustering(int k, int maxIter = 50, double tolerance = 1e-4);
@@ -32,22 +37,49 @@ public:
     int iterationsUsed() const { return iterationsUsed_; }
     bool converged() const { return converged_; }
 
+    // run() keeps its final centroids and, by default, the next run() on the
+    // same object starts from them instead of k-means++ seeding
+    void setWarmStart(bool enabled) { warmStart_ = enabled; }
+    bool warmStart() const { return warmStart_; }
+    void setInitialCentroids(std::vector<std::array<double, 4>> centroids);
+    const std::vector<std::array<double, 4>>& centroids() const { return centroids_; }
+
+    // Mini-batch mode (0 = off): iterations update centroids from batchSize
+    // sampled agents, followed by one full assignment for the members
+    void setMiniBatch(std::size_t batchSize) { miniBatch_ = batchSize; }
+    std::size_t miniBatch() const { return miniBatch_; }
+
 private:
     int k_;
     int maxIter_;
     double tolerance_;
     int iterationsUsed_ = 0;
     bool converged_ = false;
+    bool warmStart_ = true;
+    std::size_t miniBatch_ = 0;
+    std::uint64_t runs_ = 0;  // Varies mini-batch sampling between runs
+    std::vector<std::array<double, 4>> centroids_;
 
     static double distance(const std::array<double, 4>& a, const std::array<double, 4>& b);
-    void initialize(const std::vector<Agent>& agents, std::vector<std::array<double, 4>>& centroids);
-    void assign(const std::vector<Agent>& agents,
+    void initialize(const AgentStore& agents, std::vector<std::array<double, 4>>& centroids);
+    // Nearest centroid per agent, with Hamerly upper / lower bounds
+    void assign(const AgentStore& agents,
                 const std::vector<std::array<double, 4>>& centroids,
-                std::vector<int>& assignment);
-    void update(const std::vector<Agent>& agents,
-                const std::vector<int>& assignment,
-                std::vector<std::array<double, 4>>& centroids);
-    double inertia(const std::vector<Agent>& agents,
+                std::vector<int>& assignment,
+                std::vector<double>& upper,
+                std::vector<double>& lower);
+    // Centroid means of the assignment; returns how far each centroid moved
+    std::vector<double> update(const AgentStore& agents,
+                               const std::vector<int>& assignment,
+                               std::vector<std::array<double, 4>>& centroids);
+    void runFull(const AgentStore& agents,
+                 std::vector<std::array<double, 4>>& centroids,
+                 std::vector<int>& assignment);
+    void runMiniBatch(const AgentStore& agents,
+                      std::vector<std::array<double, 4>>& centroids,
+                      std::vector<int>& assignment,
+                      bool warm);
+    double inertia(const AgentStore& agents,
                    const std::vector<std::array<double, 4>>& centroids,
                    const std::vector<int>& assignment) const;
 };
@@ -65,11 +97,13 @@ private:
     int noisePoints_ = 0;
 
     static double distance(const std::array<double, 4>& a, const std::array<double, 4>& b);
-    std::vector<std::uint32_t> regionQuery(const std::vector<Agent>& agents,
-                                           std::uint32_t idx) const;
-    void expandCluster(const std::vector<Agent>& agents,
+    // Slots within eps of slot idx (including idx), via the belief-space grid
+    void regionQuery(const BeliefGrid& grid,
+                     std::uint32_t idx,
+                     std::vector<std::uint32_t>& neighbors) const;
+    void expandCluster(BeliefGrid& grid,
+                       const std::vector<std::uint8_t>& core,
                        std::uint32_t idx,
-                       std::vector<std::uint32_t>& neighbors,
                        std::vector<int>& labels,
                        int clusterId);
 };
@@ -6,6 +6,7 @@
 
 #include "modules/EconomyTypes.h"
 #include "modules/TradeNetwork.h"
+#include "modules/WealthDistribution.h"
 #include <cstdint>
 #include <string>
 #include <random>
@@ -78,11 +79,11 @@ struct RegionalEconomy {
     double wealth_bottom_50 = 0.0;  // share held by poorest 50%
     
     // Economic system (emerges from agent beliefs + conditions)
-    std::string economic_system = "mixed";  // "market", "planned", "mixed", "feudal", "cooperative"
+    EconomicSystem economic_system = EconomicSystem::Mixed;
     double system_stability = 1.0;  // how well system fits population beliefs
     
     // Hysteresis for system transitions (prevents thrashing)
-    std::string pending_system = "";      // System we're transitioning toward (if any)
+    EconomicSystem pending_system = EconomicSystem::None;  // System we're transitioning toward (if any)
     int transition_pressure_ticks = 0;    // How many ticks sustained pressure for change
     // Number of ticks representing ~5 years of sustained pressure.
     // Assumes TICKS_PER_YEAR is the simulation tick rate (default: 10).
@@ -108,8 +109,17 @@ struct RegionalEconomy {
     std::vector<std::uint32_t> trade_partners;
 };
 
-// Forward declaration
+// Everything init() draws before the agents: positions, development,
+// endowments and trade partners. Immutable once built, so one instance can
+// seed any number of economies.
+struct EconomyGeography {
+    std::string start_condition;
+    std::vector<RegionalEconomy> regions;
+};
+
+// Forward declarations
 struct Agent;
+class AgentStore;
 
 class Economy {
 public:
@@ -118,11 +128,23 @@ public:
               std::uint32_t num_agents,
               std::mt19937_64& rng,
               const std::string& start_condition);
+    // Same as init(), split so the geography can be drawn once and shared:
+    // init(geo, n, rng) after buildGeography(r, rng, start) leaves the two
+    // exactly as init(r, n, rng, start) would
+    static EconomyGeography buildGeography(std::uint32_t num_regions, std::mt19937_64& rng,
+                                           const std::string& start_condition);
+    void init(const EconomyGeography& geography, std::uint32_t num_agents, std::mt19937_64& rng);
     void update(const std::vector<std::uint32_t>& region_populations,
                 const std::vector<std::array<double, 4>>& region_belief_centroids,
-                const std::vector<Agent>& agents,
+                const AgentStore& agents,
                 std::uint64_t generation,
                 const std::vector<std::vector<std::uint32_t>>* region_index = nullptr);  // Optional region index for O(R*pop/R) instead of O(N)
+    // Convenience overload for standalone use with agent records (tests, tools)
+    void update(const std::vector<std::uint32_t>& region_populations,
+                const std::vector<std::array<double, 4>>& region_belief_centroids,
+                const std::vector<Agent>& agents,
+                std::uint64_t generation,
+                const std::vector<std::vector<std::uint32_t>>* region_index = nullptr);
     
     // Accessors
     const RegionalEconomy& getRegion(std::uint32_t region_id) const;
@@ -132,35 +154,71 @@ public:
     const AgentEconomy& getAgentEconomy(std::uint32_t agent_id) const;
     const std::vector<AgentEconomy>& agents() const { return agents_; }
     
+    // Checkpoint restore: adopt saved regional state (trade partners included),
+    // agent rows and policy levers, and rebuild the trade topology from them
+    void restore(const std::string& start_condition, std::vector<RegionalEconomy> regions,
+                 std::vector<AgentEconomy> agents, EconomicSystem forced_model, double war_allocation);
+    
     // Add a new agent to the economy (for births)
     void addAgent(std::uint32_t agent_id, std::uint32_t region_id, std::mt19937_64& rng);
+    // Bulk form: agents first_id .. first_id + regions.size() - 1
+    void addAgents(std::uint32_t first_id, const std::vector<std::uint32_t>& regions,
+                   std::mt19937_64& rng);
+    
+    // Renumber agent slots after kernel compaction (old slot -> new slot,
+    // AgentStore::kNoSlot for removed agents)
+    void compactAgents(const std::vector<std::uint32_t>& remap);
+    // Lay agent records out as `order` lists their old slots (kernel reordering)
+    void reorderAgents(const std::vector<std::uint32_t>& order);
+    
+    // Regional, trade-link, agent and wealth-sketch tables; the trade network
+    // reports separately. shrinkAgents() trims the agent table to size + spare.
+    MemoryFootprint memoryUsage() const;
+    MemoryFootprint tradeMemoryUsage() const;
+    void shrinkAgents(std::size_t spare = 0) { fitCapacity(agents_, spare); }
     
     // Update agent's economic sector when they migrate between regions
     void migrateAgent(std::uint32_t agent_id, std::uint32_t from_region, std::uint32_t to_region);
     
-    // Global metrics
+    // Global metrics (population-weighted; fixed-block reduction, so results
+    // do not depend on the thread count)
     double globalWelfare() const;
     double globalInequality() const;
     double globalHardship() const;
     double globalDevelopment() const;
+    // Wealth of all indexed agents as of the last update (ranks, deciles, shares)
+    const WealthDistribution& wealthDistribution() const { return wealth_global_; }
     
     // Trade analysis
     const std::vector<TradeLink>& getTradeLinks() const { return trade_links_; }
     double getTotalTrade() const;
     
+    // Region-parallel execution of the per-region stages (OpenMP, on by
+    // default). Work is split into fixed region blocks merged in order, so
+    // serial and parallel runs produce identical results.
+    void setRegionParallel(bool enabled) { region_parallel_ = enabled; }
+    bool regionParallel() const { return region_parallel_; }
+    
     // Policy levers (for Phase 3+)
     void setEconomicModel(const std::string& model); // force a model globally
     
     // Resource allocation (for war module, Phase 2.8)
     void reallocateToWar(double fraction);
     
+    EconomicSystem forcedModel() const { return forced_model_; }
+    double warAllocation() const { return war_allocation_; }
+    const std::string& startCondition() const { return start_condition_name_; }
+    // Canonical profile name of a start condition (case and punctuation are
+    // ignored, aliases resolve, "" is baseline), or "" if it is unknown
+    static std::string canonicalStartCondition(const std::string& name);
+    
 private:
     struct StartConditionProfile {
         std::string name;
         double baseDevelopment = 0.1;
         double developmentJitter = 0.05;
         std::array<double, kGoodTypes> endowmentMultipliers = {1.0, 1.0, 1.0, 1.0, 1.0};
-        std::string defaultSystem = "mixed";
+        EconomicSystem defaultSystem = EconomicSystem::Mixed;
         double wealthLogMean = 0.0;
         double wealthLogStd = 0.7;
         double productivityMean = 1.0;
@@ -170,7 +228,7 @@ private:
     std::vector<RegionalEconomy> regions_;
     std::vector<TradeLink> trade_links_;
     std::vector<AgentEconomy> agents_;
-    std::string forced_model_ = "";  // if set, overrides emergent systems
+    EconomicSystem forced_model_ = EconomicSystem::None;  // if set, overrides emergent systems
     double war_allocation_ = 0.0;
     std::string start_condition_name_ = "baseline";
     StartConditionProfile start_profile_{};
@@ -178,6 +236,14 @@ private:
     // Matrix-based trade diffusion network
     std::unique_ptr<TradeNetwork> trade_network_;
     
+    bool region_parallel_ = true;
+    
+    // Wealth sketches: per-block region scratch and block totals (reused),
+    // and the merged global view
+    std::vector<WealthDistribution> wealth_scratch_;
+    std::vector<WealthDistribution> wealth_blocks_;
+    WealthDistribution wealth_global_;
+    
     void initializeEndowments(std::mt19937_64& rng);
     void initializeTradeNetwork();
     void initializeAgents(std::uint32_t num_agents, std::mt19937_64& rng);
@@ -187,15 +253,15 @@ private:
     void computeTrade();
     void computeConsumption();
     void updatePrices();
-    void distributeIncome(const std::vector<Agent>& agents, 
+    void distributeIncome(const AgentStore& agents, 
                           const std::vector<std::vector<std::uint32_t>>* region_index = nullptr);
     void computeWelfare();
-    void computeInequality(const std::vector<Agent>& agents,
+    void computeInequality(const AgentStore& agents,
                            const std::vector<std::vector<std::uint32_t>>* region_index = nullptr);
     void computeHardship();
     void evolveDevelopment();
     // New overload using dominant pole analysis
-    void evolveEconomicSystems(const std::vector<Agent>& agents,
+    void evolveEconomicSystems(const AgentStore& agents,
                                const std::vector<std::vector<std::uint32_t>>& region_index);
     // Legacy overload using mean-based analysis
     void evolveEconomicSystems(const std::vector<std::array<double, 4>>& region_belief_centroids);
@@ -205,22 +271,25 @@ private:
     // Regional belief analysis (for economic system determination)
     RegionalBeliefProfile analyzeRegionalBeliefs(
         std::uint32_t region_id,
-        const std::vector<Agent>& agents,
+        const AgentStore& agents,
         const std::vector<std::vector<std::uint32_t>>& region_index) const;
     
     // Economic system emergence - NEW: uses dominant pole, not mean
-    std::string determineEconomicSystem(const RegionalBeliefProfile& profile, 
-                                       double development,
-                                       double hardship,
-                                       double inequality) const;
+    EconomicSystem determineEconomicSystem(const RegionalBeliefProfile& profile,
+                                           double development,
+                                           double hardship,
+                                           double inequality) const;
     // Legacy: uses mean-based analysis
-    std::string determineEconomicSystem(const std::array<double, 4>& beliefs, 
-                                       double development,
-                                       double hardship,
-                                       double inequality) const;
+    EconomicSystem determineEconomicSystem(const std::array<double, 4>& beliefs,
+                                           double development,
+                                           double hardship,
+                                           double inequality) const;
+    
+    // Population-weighted mean of a regional field (empty_value if no population)
+    double populationWeightedMean(double RegionalEconomy::*field, double empty_value) const;
     
     // Wealth distribution
-    double computeRegionGini(std::uint32_t region_id, const std::vector<Agent>& agents) const;
+    double computeRegionGini(std::uint32_t region_id, const AgentStore& agents) const;
 };
 
 #endif
@@ -1,6 +1,9 @@
 #ifndef ECONOMY_TYPES_H
 #define ECONOMY_TYPES_H
 
+#include <cstdint>
+#include <string>
+
 // Shared economic type definitions
 constexpr int kGoodTypes = 5;
 
@@ -12,4 +15,40 @@ enum GoodType {
     SERVICES = 4
 };
 
+// Economic systems are compared and assigned every evolution tick, so they
+// travel as a byte; names only appear at the I/O boundary (CLI, checkpoints).
+// None marks "no pending transition" / "no forced model".
+enum class EconomicSystem : std::uint8_t {
+    Mixed,
+    Market,
+    Planned,
+    Feudal,
+    Cooperative,
+    None
+};
+
+inline const char* economicSystemName(EconomicSystem system) {
+    switch (system) {
+        case EconomicSystem::Mixed: return "mixed";
+        case EconomicSystem::Market: return "market";
+        case EconomicSystem::Planned: return "planned";
+        case EconomicSystem::Feudal: return "feudal";
+        case EconomicSystem::Cooperative: return "cooperative";
+        case EconomicSystem::None: break;
+    }
+    return "";
+}
+
+// Parses a system name ("" parses as None); returns false if unrecognized
+inline bool parseEconomicSystem(const std::string& name, EconomicSystem& out) {
+    for (auto system : {EconomicSystem::Mixed, EconomicSystem::Market, EconomicSystem::Planned,
+                        EconomicSystem::Feudal, EconomicSystem::Cooperative, EconomicSystem::None}) {
+        if (name == economicSystemName(system)) {
+            out = system;
+            return true;
+        }
+    }
+    return false;
+}
+
 #endif
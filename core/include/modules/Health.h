@@ -5,8 +5,10 @@
 #include <random>
 #include <vector>
 
-struct Agent;
+class ActivitySet;
+class AgentStore;
 class Economy;
+class TickScheduler;
 
 struct Disease {
     double infectivity = 0.25;
@@ -34,16 +36,24 @@ struct RegionalHealthSnapshot {
 class HealthModule {
 public:
     void configure(std::uint32_t regionCount, std::uint64_t seed);
-    void initializeAgents(std::vector<Agent>& agents);
-    void updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t tick);
+    void initializeAgents(AgentStore& agents);
+    void updateAgents(AgentStore& agents, const Economy& economy, std::uint64_t tick);
+    // Queue this tick's regional snapshot and per-agent update on a fused sweep.
+    // With an activity schedule only due agents update, catching up on the
+    // ticks they skipped; the others count in the averages as they are.
+    void registerStages(TickScheduler& scheduler, AgentStore& agents, const Economy& economy,
+                        std::uint64_t tick, ActivitySet* activity = nullptr);
 
     const std::vector<RegionalHealthSnapshot>& regionalSnapshots() const { return regional_snapshots_; }
+    // The disease HealthState::current_disease points at while infected
+    const Disease* baselineDisease() const { return &baseline_disease_; }
 
 private:
     std::vector<RegionalHealthSnapshot> regional_snapshots_;
-    std::mt19937_64 rng_{};
+    std::uint64_t seed_ = 0;  // Keys rng::CounterRng: Founding at initialization, Health per tick
     Disease baseline_disease_{};
 
+    void updateRegionalSnapshots(const Economy& economy);
     double computeAgeDecay(double ageFactor) const;
     double clamp01(double value) const;
 };
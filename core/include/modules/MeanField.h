@@ -4,8 +4,9 @@
 #include <array>
 #include <vector>
 #include <cstdint>
+#include "utils/MemoryFootprint.h"
 
-struct Agent;
+class AgentStore;
 
 /**
  * Neighbor influence accumulator for hybrid belief updates
@@ -41,9 +42,14 @@ public:
     void configure(std::uint32_t num_regions);
     
     // Compute regional fields from agent population
-    void computeFields(const std::vector<Agent>& agents,
+    void computeFields(const AgentStore& agents,
                        const std::vector<std::vector<std::uint32_t>>& region_index);
     
+    // Set fields from per-region populations and mean beliefs kept up to date
+    // elsewhere (the kernel's incremental aggregates): O(R), no agent scan
+    void setFields(const std::vector<std::uint32_t>& populations,
+                   const std::vector<std::array<double, 4>>& means);
+    
     // Get field value for a region
     const std::array<double, 4>& getRegionalField(std::uint32_t region) const;
     
@@ -61,8 +67,12 @@ public:
     // Query
     const std::vector<std::array<double, 4>>& fields() const { return regional_fields_; }
     const std::vector<double>& strengths() const { return field_strengths_; }
+    MemoryFootprint memoryUsage() const;
 
 private:
+    // Field strengths from region_populations_ (and zero fields for empty regions)
+    void finalizeStrengths();
+    
     std::uint32_t num_regions_ = 0;
     
     // Regional mean belief fields
@@ -2,10 +2,14 @@
 #define ONLINE_CLUSTERING_H
 
 #include <array>
+#include <cstddef>
 #include <vector>
 #include <cstdint>
 
-struct Agent;
+#include "modules/Culture.h"
+#include "utils/MemoryFootprint.h"
+
+class AgentStore;
 
 /**
  * Online (Sequential) K-Means Clustering
@@ -24,29 +28,54 @@ struct Agent;
  *   - No computational spikes (O(1) per update)
  *   - Always-current cluster state
  *   - Spreads cost evenly across simulation
+ *
+ * Kernel use (KernelConfig::liveClusters): the belief pass calls assignSlot()
+ * for every agent it updates, then commit() folds the tick's assignments into
+ * cluster sizes and centroids over fixed slot blocks (thread-count
+ * independent). fullReassignment() re-derives exact centroids periodically.
  */
 class OnlineClustering {
 public:
     OnlineClustering(int k, double learning_rate = 0.01);
     
     // Initialize centroids from agent population
-    void initialize(const std::vector<Agent>& agents);
+    void initialize(const AgentStore& agents);
     
     // Update a single agent's cluster assignment and centroid
     void updateAgent(std::uint32_t agent_id, const std::array<double, 4>& new_beliefs);
     
     // Periodic full reassignment (every N ticks to handle drift)
-    void fullReassignment(const std::vector<Agent>& agents);
+    void fullReassignment(const AgentStore& agents);
+    
+    // Batched updates: prepare() sizes the table for n slots (new slots start
+    // unassigned); assignSlot() may then run concurrently for distinct slots
+    void prepare(std::size_t n);
+    void assignSlot(std::uint32_t slot, const std::array<double, 4>& beliefs) {
+        assignments_[slot] = findNearestCentroid(beliefs);
+    }
+    // Fold assignments into sizes and move each centroid towards its members'
+    // mean as far as the per-agent rule would over the same members
+    void commit(const AgentStore& agents);
+    
+    // Renumber slots after kernel compaction (AgentStore::kNoSlot = removed)
+    void compact(const std::vector<std::uint32_t>& remap);
+    // Lay assignments out as `order` lists their old slots (kernel reordering)
+    void reorder(const std::vector<std::uint32_t>& order);
+    MemoryFootprint memoryUsage() const;
+    void shrinkToFit(std::size_t spare = 0) { fitCapacity(assignments_, spare); }
     
     // Query
     const std::vector<std::array<double, 4>>& centroids() const { return centroids_; }
     int getCluster(std::uint32_t agent_id) const;
     std::vector<std::uint32_t> getClusterMembers(int cluster_id) const;
-    double getClusterCoherence(int cluster_id, const std::vector<Agent>& agents) const;
+    double getClusterCoherence(int cluster_id, const AgentStore& agents) const;
+    
+    // Current clusters as Cluster records (members are live slots); one O(N) pass
+    std::vector<Cluster> snapshot(const AgentStore& agents, std::uint64_t generation) const;
     
     // Statistics
     std::vector<std::uint32_t> getClusterSizes() const;
-    double getTotalInertia(const std::vector<Agent>& agents) const;
+    double getTotalInertia(const AgentStore& agents) const;
 
 private:
     int k_;
@@ -61,6 +90,11 @@ private:
     int findNearestCentroid(const std::array<double, 4>& beliefs) const;
     double squaredDistance(const std::array<double, 4>& a, const std::array<double, 4>& b) const;
     void updateCentroid(int cluster_id, const std::array<double, 4>& agent_beliefs);
+    double adaptiveRate(int cluster_id) const;
+    // Per-cluster belief sums and counts of live assigned slots (dead slots are unassigned)
+    void fold(const AgentStore& agents,
+              std::vector<std::array<double, 4>>& sums,
+              std::vector<std::uint32_t>& counts);
 };
 
 #endif
@@ -7,8 +7,10 @@
 #include <random>
 #include <vector>
 
-struct Agent;
+class ActivitySet;
+class AgentStore;
 class Economy;
+class TickScheduler;
 
 enum class StressSource : std::uint8_t {
     EconomicHardship = 0,
@@ -46,16 +48,21 @@ struct RegionalPsychologyMetrics {
 class PsychologyModule {
 public:
     void configure(std::uint32_t regionCount, std::uint64_t seed);
-    void initializeAgents(std::vector<Agent>& agents);
-    void updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t tick);
+    void initializeAgents(AgentStore& agents);
+    void updateAgents(AgentStore& agents, const Economy& economy, std::uint64_t tick);
+    // Queue this tick's regional profiles and per-agent update on a fused sweep
+    // (activity schedule as in HealthModule::registerStages)
+    void registerStages(TickScheduler& scheduler, AgentStore& agents, const Economy& economy,
+                        std::uint64_t tick, ActivitySet* activity = nullptr);
 
     const std::vector<RegionalPsychologyMetrics>& regionalMetrics() const { return regional_metrics_; }
 
 private:
     std::vector<RegionalStressProfile> regional_profiles_;
     std::vector<RegionalPsychologyMetrics> regional_metrics_;
-    std::mt19937_64 rng_{};
+    std::uint64_t seed_ = 0;  // Keys the per-agent Founding streams
 
+    void updateRegionalProfiles(const Economy& economy);
     double clamp01(double value) const;
     static std::size_t toIndex(StressSource src) { return static_cast<std::size_t>(src); }
 };
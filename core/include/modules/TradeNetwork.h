@@ -2,10 +2,12 @@
 #define TRADE_NETWORK_H
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 #include <array>
 
 #include "modules/EconomyTypes.h"
+#include "utils/MemoryFootprint.h"
 
 /**
  * Matrix-based trade network using flow diffusion
@@ -21,6 +23,10 @@
  * 
  * This treats trade like heat/fluid flow through a network,
  * naturally balancing supply and demand through gradient descent.
+ *
+ * L is stored in CSR form (trade graphs have degree ~6, so a dense R x R
+ * matrix wastes O(R^2) memory and flops). computeFlows() applies L to all
+ * kGoodTypes surpluses in one fused pass over the rows.
  */
 class TradeNetwork {
 public:
@@ -39,22 +45,29 @@ public:
     );
     
     // Query
-    const std::vector<std::vector<double>>& laplacian() const { return laplacian_; }
+    // Dense copy of L built on demand (debugging/tests only: O(R^2) memory)
+    std::vector<std::vector<double>> laplacian() const;
+    std::size_t nonZeros() const { return lap_values_.size(); }
     std::uint32_t numRegions() const { return num_regions_; }
+    MemoryFootprint memoryUsage() const;  // Laplacian and adjacency
 
 private:
     std::uint32_t num_regions_ = 0;
     
-    // Laplacian matrix: L[i][j] = degree(i) if i==j, -1 if edge(i,j), else 0
-    std::vector<std::vector<double>> laplacian_;
+    // Laplacian in CSR: row i holds L[i][j] for j in ascending order, diagonal included.
+    // L[i][i] = degree(i), L[i][j] = -1 for each partner j
+    std::vector<std::uint32_t> lap_row_offsets_;  // num_regions_ + 1 entries
+    std::vector<std::uint32_t> lap_cols_;
+    std::vector<double> lap_values_;
     
     // Adjacency for transport costs
     std::vector<std::vector<std::uint32_t>> adjacency_;
     
     // Helpers
     void computeLaplacian();
-    void matrixVectorMultiply(const std::vector<double>& vec, 
-                               std::vector<double>& result) const;
+    // result[i][g] = sum_j L[i][j] * vec[j][g] for every good at once
+    void multiplyBlock(const std::vector<std::array<double, kGoodTypes>>& vec,
+                       std::vector<std::array<double, kGoodTypes>>& result) const;
 };
 
 #endif
@@ -0,0 +1,81 @@
+#ifndef WEALTH_DISTRIBUTION_H
+#define WEALTH_DISTRIBUTION_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "utils/MemoryFootprint.h"
+
+/**
+ * Sort-free wealth distribution sketch.
+ *
+ * Values land in log-spaced buckets taken straight from the IEEE-754 bits
+ * (exponent plus the top `precisionBits` of the mantissa), so each bucket
+ * spans a relative width of 2^-precisionBits. Buckets keep an exact count
+ * and sum; rank-based statistics (Gini, top/bottom shares, quantiles) treat
+ * the members of a bucket as equal, which bounds their error by that width.
+ *
+ * Building is one O(n) pass with no allocation after the first use and no
+ * sort; an occupancy bitmap keeps queries, merges and clear() proportional to
+ * the buckets actually used. Sketches with the same precision merge by
+ * adding buckets, so regional sketches fold into a global one.
+ */
+class WealthDistribution {
+public:
+    static constexpr int kDefaultPrecisionBits = 7;  // ~0.8% relative bucket width
+
+    explicit WealthDistribution(int precisionBits = kDefaultPrecisionBits);
+
+    void clear();
+    void add(double wealth);
+    void merge(const WealthDistribution& other);  // Throws std::invalid_argument on precision mismatch
+
+    std::uint64_t count() const { return count_; }
+    double total() const { return total_; }
+    bool empty() const { return count_ == 0; }
+    double relativeError() const;
+    MemoryFootprint memoryUsage() const;
+
+    struct Summary {
+        double gini = 0.0;
+        double topShare = 0.0;
+        double bottomShare = 0.0;
+    };
+    // Gini and both shares from a single walk over the buckets
+    Summary summary(double topFraction = 0.1, double bottomFraction = 0.5) const;
+
+    // Gini coefficient over the holders (0 = equal, 1 = one holder has all)
+    double gini() const;
+    // Share of total wealth held by the richest / poorest `fraction` of holders
+    double topShare(double fraction) const;
+    double bottomShare(double fraction) const;
+    // Approximate wealth at quantile q in [0, 1]
+    double quantile(double q) const;
+    // Fraction of holders with less wealth than `wealth` (bucket resolution)
+    double rankOf(double wealth) const;
+    // Wealth decile 0..9 of `wealth` within this distribution
+    int decile(double wealth) const;
+    // Lowest wealth placed in deciles 1..9 (+inf if never reached): decile(w)
+    // equals the number of floors <= w, so callers can bin many values by
+    // comparison after one O(buckets) walk
+    std::array<double, 9> decileFloors() const;
+
+private:
+    std::size_t bucketOf(double wealth) const;
+    double bucketFloor(std::size_t bucket) const;  // Smallest wealth mapped to `bucket` (bucket >= 1)
+    // Visit occupied buckets in ascending order: fn(bucket) returns false to stop
+    template <typename Fn>
+    void forEachBucket(Fn&& fn) const;
+
+    int bits_;
+    std::vector<std::uint32_t> counts_;
+    std::vector<double> sums_;
+    std::vector<std::uint64_t> occupied_;  // One bit per bucket
+    std::size_t loWord_;                   // Occupied word range [loWord_, hiWord_)
+    std::size_t hiWord_ = 0;
+    std::uint64_t count_ = 0;
+    double total_ = 0.0;
+};
+
+#endif // WEALTH_DISTRIBUTION_H
@@ -0,0 +1,100 @@
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Counter-based random numbers (Philox4x32-10).
+ *
+ * A draw is a pure function of (seed, generation, agent id, stream, draw
+ * index), so agent-level randomness does not depend on thread count, OpenMP
+ * scheduling or the order agents are visited. Construct a fresh CounterRng
+ * per agent per phase; it satisfies UniformRandomBitGenerator and works
+ * with the <random> distributions.
+ *
+ * Key agents on their stable ID (Agent::id), not their slot, so compaction
+ * does not change anyone's random sequence.
+ */
+namespace rng {
+
+// Independent random streams; add new ones at the end to keep old sequences
+enum class Stream : std::uint32_t {
+    Innovation = 1,  // Belief innovation noise
+    Mortality,       // Death roll
+    Fertility,       // Birth roll
+    Birth,           // Child construction (sex, father, traits)
+    Migration,       // Migration roll and destination sampling
+    Network,         // Tie formation and rewiring
+    Economy,         // Per-agent economic shocks
+    Health,          // Infection and recovery rolls
+    Metrics,         // Sampled metric estimators (keyed on block, not agent)
+    Cohort,          // Materializing cohort members as agents
+    Founding,        // World construction: initial agents, their economy, psychology and health
+    Wiring,          // World construction: small-world rewiring
+    Speech           // World construction: minority languages and dialects
+};
+
+// One Philox4x32 block with 10 rounds (Salmon et al., SC'11)
+inline std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> ctr,
+                                               std::array<std::uint32_t, 2> key) {
+    constexpr std::uint32_t kMul0 = 0xD2511F53u;
+    constexpr std::uint32_t kMul1 = 0xCD9E8D57u;
+    constexpr std::uint32_t kWeyl0 = 0x9E3779B9u;
+    constexpr std::uint32_t kWeyl1 = 0xBB67AE85u;
+
+    for (int round = 0; round < 10; ++round) {
+        const std::uint64_t p0 = static_cast<std::uint64_t>(kMul0) * ctr[0];
+        const std::uint64_t p1 = static_cast<std::uint64_t>(kMul1) * ctr[2];
+        ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+               static_cast<std::uint32_t>(p1),
+               static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+               static_cast<std::uint32_t>(p0)};
+        key[0] += kWeyl0;
+        key[1] += kWeyl1;
+    }
+    return ctr;
+}
+
+class CounterRng {
+public:
+    using result_type = std::uint64_t;
+
+    CounterRng(std::uint64_t seed, std::uint64_t generation, std::uint32_t agentId, Stream stream)
+        : key_{static_cast<std::uint32_t>(seed),
+               static_cast<std::uint32_t>(seed >> 32) ^ static_cast<std::uint32_t>(generation >> 32)},
+          agent_(agentId),
+          generationLo_(static_cast<std::uint32_t>(generation)),
+          stream_(static_cast<std::uint32_t>(stream)) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        if (lane_ == 2) {
+            block_ = philox4x32({block_index_++, agent_, generationLo_, stream_}, key_);
+            lane_ = 0;
+        }
+        const std::uint32_t hi = block_[2 * lane_];
+        const std::uint32_t lo = block_[2 * lane_ + 1];
+        ++lane_;
+        return (static_cast<std::uint64_t>(hi) << 32) | lo;
+    }
+
+    // Uniform double in [0, 1) from the top 53 bits
+    double uniform() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+private:
+    std::array<std::uint32_t, 2> key_;
+    std::uint32_t agent_;
+    std::uint32_t generationLo_;
+    std::uint32_t stream_;
+    std::uint32_t block_index_ = 0;
+    std::array<std::uint32_t, 4> block_{};
+    int lane_ = 2;  // Exhausted: first call computes block 0
+};
+
+}  // namespace rng
+
+#endif // COUNTER_RNG_H
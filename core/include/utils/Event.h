@@ -0,0 +1,49 @@
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <cstdint>
+#include <string>
+
+// Event types for tracking simulation dynamics
+enum class EventType : std::uint8_t {
+    BIRTH,
+    DEATH,
+    TRADE,
+    MOVEMENT_FORMED,
+    MOVEMENT_DISBANDED,
+    IDEOLOGY_SHIFT,
+    ECONOMIC_CRISIS,
+    SYSTEM_CHANGE,
+    MIGRATION,              // Agent moved between regions
+    CULTURAL_CLUSTER_SPLIT, // Cultural divergence event
+    HARDSHIP_CRISIS,        // Region entered hardship crisis
+    DEVELOPMENT_MILESTONE   // Region hit development threshold
+};
+
+// Individual event record: fixed-size and trivially copyable, with a typed
+// payload per event type instead of a formatted string
+struct Event {
+    std::uint64_t tick = 0;
+    double magnitude = 0.0;      // Event intensity/size
+    std::uint32_t agent_id = 0;  // Primary agent involved (0 for region-level events)
+    std::uint32_t region_id = 0; // Region where event occurred
+    EventType type = EventType::BIRTH;
+    std::uint8_t reserved[7] = {};
+
+    union Payload {
+        unsigned char raw[32];  // Zeroed by default, so records are fully defined bytes
+        struct { std::uint32_t parent_id; } birth;
+        struct { std::int32_t age; } death;
+        struct { std::uint32_t to_region; std::int32_t good; double volume; double price; } trade;
+        struct { std::uint32_t movement_id; std::uint32_t reserved; std::uint64_t members; } movement;
+        struct { char from[16]; char to[16]; } system;  // NUL-padded, truncated to 15 chars
+        struct { std::uint32_t from_region; std::uint32_t to_region; } migration;
+        struct { double level; } region;                // Hardship or development level
+    } payload{};
+
+    // The payload as the "key=value;..." text of the CSV details column
+    std::string details() const;
+};
+static_assert(sizeof(Event) == 64, "events are written as fixed 64-byte records");
+
+#endif // EVENT_H
@@ -1,94 +1,157 @@
 #ifndef EVENTLOG_H
 #define EVENTLOG_H
 
+#include "utils/Event.h"
+#include "utils/EventStore.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <string>
 #include <vector>
 #include <cstdint>
 #include <fstream>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <utility>
 
-// Event types for tracking simulation dynamics
-enum class EventType {
-    BIRTH,
-    DEATH,
-    TRADE,
-    MOVEMENT_FORMED,
-    MOVEMENT_DISBANDED,
-    IDEOLOGY_SHIFT,
-    ECONOMIC_CRISIS,
-    SYSTEM_CHANGE,
-    MIGRATION,              // Agent moved between regions
-    CULTURAL_CLUSTER_SPLIT, // Cultural divergence event
-    HARDSHIP_CRISIS,        // Region entered hardship crisis
-    DEVELOPMENT_MILESTONE   // Region hit development threshold
-};
-
-// Individual event record
-struct Event {
-    std::uint64_t tick;
-    EventType type;
-    std::uint32_t agent_id;      // Primary agent involved (0 for region-level events)
-    std::uint32_t region_id;     // Region where event occurred
-    std::string details;         // JSON or CSV formatted details
-    double magnitude;            // Event intensity/size
-    
-    Event(std::uint64_t t, EventType et, std::uint32_t aid, std::uint32_t rid, 
-          const std::string& det, double mag)
-        : tick(t), type(et), agent_id(aid), region_id(rid), details(det), magnitude(mag) {}
-};
-
-// Event logging system for simulation analysis
+/**
+ * Event logging system for simulation analysis.
+ *
+ * Logging never locks or allocates: each thread appends fixed-size records
+ * to its own single-producer ring, registered on its first event. Rings are
+ * drained in batches (by the background writer once init() opened a file,
+ * by queries and flush(), or by a producer that finds its ring full) into a
+ * bounded history and the output file. Events from one thread keep their
+ * order; each drained batch is ordered by tick. The history is an
+ * EventStore indexed by type and tick, so range queries cost the size of
+ * their result rather than of the history.
+ */
 class EventLog {
 public:
-    EventLog() = default;
-    
-    // Initialize with output file path
-    void init(const std::string& filepath);
-    
-    // Log an event (thread-safe)
-    void logEvent(std::uint64_t tick, EventType type, std::uint32_t agent_id, 
-                  std::uint32_t region_id, const std::string& details, double magnitude);
-    
+    enum class Format { CSV, Binary };
+    // What a producer does when its ring is full
+    enum class Overflow {
+        Drain,  // Drain the rings itself (no loss; takes the drain lock)
+        Drop,   // Drop the event and count it
+    };
+    // Which events the history keeps once it holds `retainLimit`
+    enum class Retention { KeepLatest, KeepEarliest };
+
+    struct Config {
+        std::size_t ringCapacity = 8192;          // Records per thread (rounded up to a power of two)
+        std::size_t retainLimit = 1u << 20;       // Events kept for queries (0: none)
+        Retention retention = Retention::KeepLatest;
+        Overflow overflow = Overflow::Drain;
+        std::chrono::milliseconds flushInterval{50};  // Background writer period
+        std::string spillDirectory;               // Map older history from files here (empty: memory only)
+        std::size_t residentSegments = 16;        // In-memory segments per type when spilling
+    };
+
+    EventLog();
+    explicit EventLog(const Config& config);
+    ~EventLog();
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    // Replace the configuration; pending events are drained first. Not safe
+    // to call while other threads are logging.
+    void configure(const Config& config);
+    const Config& config() const { return config_; }
+
+    // Initialize with output file path and start the background writer.
+    // Binary files hold a 16-byte header ("CIVE", u32 version, u32 record
+    // size, u32 reserved) followed by raw Event records.
+    void init(const std::string& filepath, Format format = Format::CSV);
+
+    // Log an event (thread-safe, lock-free unless the ring overflows)
+    void logEvent(const Event& event);
+    void logEvent(std::uint64_t tick, EventType type, std::uint32_t agent_id,
+                  std::uint32_t region_id, double magnitude);
+
     // Convenience methods for common events
-    void logBirth(std::uint64_t tick, std::uint32_t agent_id, std::uint32_t region_id, 
+    void logBirth(std::uint64_t tick, std::uint32_t agent_id, std::uint32_t region_id,
                   std::uint32_t parent_id);
     void logDeath(std::uint64_t tick, std::uint32_t agent_id, std::uint32_t region_id, int age);
-    void logTrade(std::uint64_t tick, std::uint32_t from_region, std::uint32_t to_region, 
+    void logTrade(std::uint64_t tick, std::uint32_t from_region, std::uint32_t to_region,
                   int good_type, double volume, double price);
-    void logMovementFormed(std::uint64_t tick, std::uint32_t movement_id, 
+    void logMovementFormed(std::uint64_t tick, std::uint32_t movement_id,
                           std::uint32_t region_id, std::size_t member_count);
-    void logSystemChange(std::uint64_t tick, std::uint32_t region_id, 
+    void logSystemChange(std::uint64_t tick, std::uint32_t region_id,
                         const std::string& old_system, const std::string& new_system);
-    void logMigration(std::uint64_t tick, std::uint32_t agent_id, 
+    void logMigration(std::uint64_t tick, std::uint32_t agent_id,
                      std::uint32_t from_region, std::uint32_t to_region);
     void logHardshipCrisis(std::uint64_t tick, std::uint32_t region_id, double hardship_level);
     void logDevelopmentMilestone(std::uint64_t tick, std::uint32_t region_id, double development_level);
-    
-    // Export to CSV file
+
+    // Export retained events to CSV file
     void exportCSV(const std::string& filepath) const;
-    
-    // Flush pending writes
+
+    // Drain pending events and flush the output file
     void flush();
-    
-    // Clear event buffer
+
+    // Drop pending and retained events
     void clear();
-    
-    // Get event count
-    std::size_t size() const { return events_.size(); }
-    
-    // Get events by type
+
+    // Retained event count (after draining pending ones)
+    std::size_t size() const;
+    // Events lost to ring overflow (Overflow::Drop) or the retain limit
+    std::uint64_t dropped() const;
+
+    // Ring, drain and history bytes as they stand (pending events are not
+    // drained, so this never writes); the rings count as slack
+    MemoryFootprint memoryUsage() const;
+    // Move every full history segment to the spill directory now (see
+    // EventStore::spillResident); returns segments spilled, 0 without one
+    std::size_t spill();
+
+    // Get retained events by type, in tick order
     std::vector<Event> getEventsByType(EventType type) const;
-    
-    // Get events in tick range
+
+    // Get retained events in tick range [start_tick, end_tick], in tick order
     std::vector<Event> getEventsByTickRange(std::uint64_t start_tick, std::uint64_t end_tick) const;
-    
+
+    // Retained events of `type` in [start_tick, end_tick] without copying
+    std::size_t count(EventType type, std::uint64_t start_tick, std::uint64_t end_tick) const;
+    // fn(EventSpan) over them in tick order, under the drain lock: spans are
+    // only valid inside fn, and fn must not call back into the log
+    template <typename Fn>
+    void forEachSpan(EventType type, std::uint64_t start_tick, std::uint64_t end_tick, Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+        drainLocked();
+        store_.visit(type, start_tick, end_tick, std::forward<Fn>(fn));
+    }
+
+    static const char* eventTypeToString(EventType type);
+
 private:
-    std::vector<Event> events_;
-    std::ofstream log_file_;
-    mutable std::mutex mutex_;  // Thread-safe logging (mutable allows locking in const methods)
+    struct Ring;
+
+    Ring& ringForThread() const;
+    // All of the following run under drain_mutex_
+    void drainLocked() const;
+    void retainLocked(const Event& event) const;
+    void writeLocked(const std::vector<Event>& batch) const;
+    void reconfigureLocked(const Config& config);
+    void startWriter();
+    void stopWriter();
+
+    Config config_;
+    const std::uint64_t serial_;  // Distinguishes logs in the per-thread ring cache
+
+    mutable std::mutex drain_mutex_;  // Consumers and ring registration
+    mutable std::vector<std::unique_ptr<Ring>> rings_;
+    mutable std::vector<Event> batch_;     // Drain scratch
+    mutable EventStore store_;
+    mutable std::atomic<std::uint64_t> dropped_{0};
+
+    mutable std::ofstream log_file_;
+    Format format_ = Format::CSV;
     bool file_initialized_ = false;
-    
-    std::string eventTypeToString(EventType type) const;
+
+    std::thread writer_;
+    std::condition_variable writer_wake_;
+    bool writer_stop_ = false;
 };
 
 #endif // EVENTLOG_H
@@ -0,0 +1,146 @@
+#ifndef EVENTSTORE_H
+#define EVENTSTORE_H
+
+#include "utils/Event.h"
+#include "utils/MemoryFootprint.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Contiguous run of events, valid until the store next changes
+struct EventSpan {
+    const Event* first = nullptr;
+    const Event* last = nullptr;
+
+    const Event* begin() const { return first; }
+    const Event* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+/**
+ * Indexed event history behind EventLog.
+ *
+ * One column per EventType, appended in arrival order into segments of
+ * kSegmentEvents records. A segment is sorted by tick when it fills (the
+ * open one lazily, before a query) and never moves afterwards. Each segment
+ * keeps its ticks in a separate array, and running tick bounds over the
+ * segments form the index, so a (type, tick range) query is a few binary
+ * searches and yields whole spans without copying. Segments only overlap
+ * in ticks where events arrived more than a segment late. When a spill
+ * directory is set, full
+ * segments beyond `residentSegments` per type are written to a file and
+ * memory-mapped read-only (POSIX; kept in memory elsewhere). The file is
+ * unlinked once mapped, so nothing outlives the process, and the tick
+ * arrays stay resident so lookups never touch the disk.
+ *
+ * Not thread-safe: EventLog serializes access under its drain lock.
+ */
+class EventStore {
+public:
+    static constexpr std::size_t kSegmentEvents = 4096;
+    static constexpr std::size_t kTypeCount = static_cast<std::size_t>(EventType::DEVELOPMENT_MILESTONE) + 1;
+
+    EventStore();
+    ~EventStore();
+    EventStore(const EventStore&) = delete;
+    EventStore& operator=(const EventStore&) = delete;
+
+    // Spill full segments beyond `residentSegments` per type into `directory`
+    // (empty: keep everything in memory). Applies to later appends.
+    void setSpill(const std::string& directory, std::size_t residentSegments);
+
+    void append(const Event& event);
+    // Drop the event at the front (back) of the history: the smallest
+    // (largest) tick when events arrive in order
+    void popOldest();
+    void popNewest();
+    void clear();
+
+    std::size_t size() const { return size_; }
+    std::size_t size(EventType type) const { return columns_[index(type)].size; }
+    std::size_t spilledSegments() const;
+    // Spill every full resident segment now (not just those beyond
+    // `residentSegments`) and free the spare one; returns segments spilled
+    // (0 without a spill directory)
+    std::size_t spillResident();
+    // Resident segments and tick arrays (spilled records are file-backed)
+    MemoryFootprint memoryUsage() const;
+
+    // fn(EventSpan) for the events of `type` with tick in [start, end]. Each
+    // span is in tick order; spans follow the segments, so they interleave in
+    // tick only where segments overlap.
+    template <typename Fn>
+    void visit(EventType type, std::uint64_t start, std::uint64_t end, Fn&& fn) const;
+    // Events of every type with tick in [start, end], merged into tick order
+    // (ties in type order)
+    void forEachInTickOrder(std::uint64_t start, std::uint64_t end,
+                            const std::function<void(const Event&)>& fn) const;
+
+private:
+    struct Segment {
+        std::vector<std::uint64_t> ticks;  // Tick column, resident even when spilled
+        std::unique_ptr<Event[]> owned;    // Null once spilled
+        const Event* events = nullptr;     // owned.get() or the file mapping
+        std::size_t begin = 0;             // First live record (older ones dropped)
+        std::uint64_t reach = 0;           // Largest tick in this or any earlier segment
+        std::uint64_t floor = 0;           // Smallest tick in this or any later segment
+        bool sorted = true;
+        void* mapping = nullptr;
+        std::size_t mapping_bytes = 0;
+
+        ~Segment();
+        std::size_t live() const { return ticks.size() - begin; }
+    };
+
+    struct Column {
+        std::deque<std::unique_ptr<Segment>> segments;
+        std::size_t size = 0;
+        std::size_t spilled = 0;  // segments[0, spilled) are file mappings
+    };
+
+    static std::size_t index(EventType type) { return static_cast<std::size_t>(type); }
+    static void sort(Segment& segment);
+    void settle(const Column& column) const;
+    std::unique_ptr<Segment> newSegment();
+    void recycle(std::unique_ptr<Segment> segment);
+    void spill(Column& column);
+    void unspill(Segment& segment);
+    void dropFront(Column& column);
+
+    std::array<Column, kTypeCount> columns_;
+    std::size_t size_ = 0;
+    std::string spill_dir_;
+    std::size_t resident_segments_ = 0;
+    std::uint64_t spill_serial_;
+    std::uint64_t spill_count_ = 0;
+    std::unique_ptr<Segment> spare_;  // Last freed segment, reused by the next
+};
+
+template <typename Fn>
+void EventStore::visit(EventType type, std::uint64_t start, std::uint64_t end, Fn&& fn) const {
+    if (start > end) return;
+    const Column& column = columns_[index(type)];
+    settle(column);
+    const auto& segments = column.segments;
+    // Skip segments whose ticks (and all before them) end before `start`
+    auto it = std::partition_point(segments.begin(), segments.end(),
+                                   [&](const std::unique_ptr<Segment>& s) { return s->reach < start; });
+    for (; it != segments.end() && (*it)->floor <= end; ++it) {
+        const Segment& s = **it;
+        const auto first = s.ticks.begin() + static_cast<std::ptrdiff_t>(s.begin);
+        const auto lo = std::lower_bound(first, s.ticks.end(), start);
+        const auto hi = std::upper_bound(lo, s.ticks.end(), end);
+        if (lo != hi) {
+            fn(EventSpan{s.events + (lo - s.ticks.begin()), s.events + (hi - s.ticks.begin())});
+        }
+    }
+}
+
+#endif // EVENTSTORE_H
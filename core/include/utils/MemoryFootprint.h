@@ -0,0 +1,39 @@
+#ifndef MEMORY_FOOTPRINT_H
+#define MEMORY_FOOTPRINT_H
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Heap bytes held by a container-owning object: `used` by live elements and
+// `reserved` in total, so reserved - used is capacity slack. Counts container
+// storage only (not allocator overhead or the objects' own sizeof).
+struct MemoryFootprint {
+    std::size_t used = 0;
+    std::size_t reserved = 0;
+
+    std::size_t slack() const { return reserved - used; }
+
+    template <typename T>
+    void add(const std::vector<T>& v) {
+        used += v.size() * sizeof(T);
+        reserved += v.capacity() * sizeof(T);
+    }
+    void add(const MemoryFootprint& other) {
+        used += other.used;
+        reserved += other.reserved;
+    }
+};
+
+// Reallocate `v` to hold size() + spare elements if it holds more; unlike
+// shrink_to_fit() the spare room lets it grow a little without doubling
+template <typename T>
+void fitCapacity(std::vector<T>& v, std::size_t spare = 0) {
+    if (v.capacity() <= v.size() + spare) return;
+    std::vector<T> fitted;
+    fitted.reserve(v.size() + spare);
+    fitted.insert(fitted.end(), std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+    v.swap(fitted);
+}
+
+#endif // MEMORY_FOOTPRINT_H
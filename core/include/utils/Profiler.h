@@ -0,0 +1,170 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Per-phase tick profiler.
+ *
+ * CIV_PROFILE_SCOPE(phase) times the enclosing block and attributes to it the
+ * number of events logged and scratch buffers allocated while it was open
+ * (inclusive of nested scopes). CIV_PROFILE_TOUCH(n) adds agents touched to
+ * the scope opened in the same block. Scopes go around whole phases, never
+ * per agent, so closing one takes a lock: kernels stepping on several threads
+ * at once (Ensemble workers, in-process shards, the LiveSimulation worker)
+ * all record into the one profiler, and each thread gets its own track in
+ * the Chrome trace. The event and allocation counters are process-wide, so
+ * with concurrent kernels a scope also counts what the others did meanwhile.
+ *
+ * With CIV_ENABLE_PROFILING undefined (cmake -DENABLE_PROFILING=OFF) the
+ * macros expand to nothing, so instrumented code carries no timers at all;
+ * the Profiler class still links and simply reports no samples.
+ */
+namespace profiler {
+
+enum class Phase : std::uint8_t {
+    Tick,
+    Beliefs,
+    Demography,
+    Migration,
+    Reconnect,
+    Language,
+    Compaction,
+    EconomyUpdate,
+    EconomyEvolution,
+    EconomyProduction,
+    EconomyTrade,
+    EconomyConsumption,
+    EconomyPrices,
+    EconomyIncome,
+    EconomyWelfare,
+    EconomyInequality,
+    EconomyHardship,
+    AgentSweep,   // Fused economic feedback + health + psychology pass
+    Cultures,     // Live culture index reassignment
+    Shards,       // ShardedKernel halo, migrant and region exchanges
+    Reorder,      // Locality reordering of agent slots
+    COUNT
+};
+
+const char* phaseName(Phase phase);
+
+struct PhaseStats {
+    std::uint64_t calls = 0;
+    std::uint64_t totalNs = 0;
+    std::uint64_t agentsTouched = 0;
+    std::uint64_t allocations = 0;
+    std::uint64_t eventsLogged = 0;
+    double meanUs = 0.0;  // Over the rolling window
+    double p99Us = 0.0;   // Over the rolling window
+    double maxUs = 0.0;   // Over the rolling window
+};
+
+class Profiler {
+public:
+    static constexpr std::size_t kWindow = 256;  // Samples kept per phase for mean/p99
+
+    static Profiler& instance();
+
+    static constexpr bool compiledIn() {
+#ifdef CIV_ENABLE_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Runtime switch (cheap check at scope entry); on by default when compiled in
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void reset();
+    PhaseStats stats(Phase phase) const;
+
+    // Chrome trace (chrome://tracing / Perfetto) recording
+    void setTracing(bool tracing);
+    bool tracing() const { return tracing_.load(std::memory_order_relaxed); }
+    std::size_t traceEvents() const;
+
+    // Exports; throw std::runtime_error if the file cannot be written
+    void writeCsv(const std::string& path) const;
+    void writeChromeTrace(const std::string& path) const;
+
+    // Global counters sampled by open scopes
+    static void noteEvent() {
+#ifdef CIV_ENABLE_PROFILING
+        events_.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+    static void noteAllocation() {
+#ifdef CIV_ENABLE_PROFILING
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    class Scope {
+    public:
+        explicit Scope(Phase phase);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        void touch(std::uint64_t agents) { agents_ += agents; }
+
+    private:
+        Phase phase_;
+        bool active_;
+        std::chrono::steady_clock::time_point start_;
+        std::uint64_t events0_ = 0;
+        std::uint64_t allocations0_ = 0;
+        std::uint64_t agents_ = 0;
+    };
+
+private:
+    struct Series {
+        PhaseStats totals;
+        std::array<std::uint32_t, kWindow> windowNs{};  // Ring buffer of recent samples
+        std::size_t count = 0;                          // Samples in the ring (<= kWindow)
+        std::size_t next = 0;
+    };
+
+    struct TraceEvent {
+        Phase phase;
+        std::uint64_t startUs;
+        std::uint64_t durUs;
+        std::uint32_t thread;
+    };
+
+    Profiler();
+    void record(Phase phase, std::chrono::steady_clock::time_point start, std::uint64_t ns,
+                std::uint64_t agents, std::uint64_t allocations, std::uint64_t events);
+
+    mutable std::mutex mutex_;  // Guards series_, trace_ and epoch_
+    std::array<Series, static_cast<std::size_t>(Phase::COUNT)> series_{};
+    std::vector<TraceEvent> trace_;
+    std::chrono::steady_clock::time_point epoch_;
+    std::atomic<bool> enabled_{true};
+    std::atomic<bool> tracing_{false};
+
+    static std::atomic<std::uint64_t> events_;
+    static std::atomic<std::uint64_t> allocations_;
+};
+
+}  // namespace profiler
+
+#ifdef CIV_ENABLE_PROFILING
+#define CIV_PROFILE_SCOPE(phase) ::profiler::Profiler::Scope civ_profile_scope_(phase)
+#define CIV_PROFILE_TOUCH(n) civ_profile_scope_.touch(static_cast<std::uint64_t>(n))
+#else
+#define CIV_PROFILE_SCOPE(phase) ((void)0)
+#define CIV_PROFILE_TOUCH(n) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -3,20 +3,50 @@
 
 #include <string>
 #include <fstream>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <array>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
 
 // Forward declarations
 struct Agent;
 struct KernelConfig;
+struct KernelGeography;
 class Kernel;
 
 namespace serialization {
 
 // Magic number and version for checkpoint files
 constexpr std::uint32_t CHECKPOINT_MAGIC = 0x45435356;  // "VCSE" in hex
-constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+constexpr std::uint32_t CHECKPOINT_VERSION = 2;
+
+/**
+ * Checkpoint format v2 (columnar).
+ *
+ * File = CheckpointHeader, then section_count SectionEntry records, then the
+ * section payloads, each starting on a kSectionAlignment boundary. A section
+ * is one contiguous column (an AgentStore field, the CSR graph, economy
+ * rows, ...) written straight from kernel storage, optionally deflated.
+ * Every payload carries a checksum of its stored bytes.
+ *
+ * Loading maps the file (mmap on POSIX) and copies or inflates each section
+ * directly into the resized kernel column, sections in parallel; there is no
+ * per-agent parsing. v1 files (per-agent records) are rejected.
+ */
+constexpr std::size_t kSectionAlignment = 64;
+
+// fourcc section tag, e.g. sectionTag("AGEX")
+constexpr std::uint32_t sectionTag(const char (&name)[5]) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(name[0])) |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(name[1])) << 8 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(name[2])) << 16 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(name[3])) << 24;
+}
 
 // Checkpoint header
 struct CheckpointHeader {
@@ -27,14 +57,218 @@ struct CheckpointHeader {
     std::uint32_t num_regions = 0;
     std::uint64_t seed = 0;
     std::uint64_t timestamp = 0;  // Unix timestamp when saved
+    std::uint32_t section_count = 0;
+    std::uint32_t flags = 0;      // kDeltaCheckpoint, or 0 for a full checkpoint
+};
+
+constexpr std::uint32_t kDeltaCheckpoint = 1;  // Sections are patches against the previous save
+
+enum class SectionCodec : std::uint32_t {
+    Raw = 0,
+    Zlib = 1,
+};
+
+// Section table entry
+struct SectionEntry {
+    std::uint32_t tag = 0;
+    SectionCodec codec = SectionCodec::Raw;
+    std::uint32_t elem_size = 0;    // Bytes per element (1 for text/byte blobs)
+    std::uint32_t reserved = 0;
+    std::uint64_t offset = 0;       // From start of file
+    std::uint64_t stored_size = 0;  // Bytes in the file
+    std::uint64_t raw_size = 0;     // Bytes after decoding
+    std::uint64_t checksum = 0;     // checksum() of the stored bytes
+};
+
+struct CheckpointOptions {
+    bool compress = false;  // Deflate sections that shrink (needs compressionAvailable())
+    int level = 1;          // zlib level 1 (fast) .. 9 (small)
 };
 
+// True if this build can write and read compressed sections
+bool compressionAvailable();
+
+// 64-bit checksum used for section payloads (not cryptographic)
+std::uint64_t checksum(const void* data, std::size_t bytes);
+
 // Save simulation state to file
-bool saveCheckpoint(const Kernel& kernel, const std::string& filepath);
+bool saveCheckpoint(const Kernel& kernel, const std::string& filepath,
+                    const CheckpointOptions& options = {});
 
-// Load simulation state from file
+// Load simulation state from file, replacing the kernel's state and config.
+// The restored kernel steps exactly like the saved one, except that cohort
+// order (backgroundPopulation) and the live culture index are rebuilt. The
+// activity schedule is saved with it; only its statistics restart.
 bool loadCheckpoint(Kernel& kernel, const std::string& filepath);
 
+/**
+ * Incremental checkpoints for periodic saving.
+ *
+ * save() writes a full base every `baseInterval` saves and, in between,
+ * deltas holding only what changed since the previous save. Per-agent
+ * sections are matched by agent ID, so births, deaths and compaction do not
+ * dirty agents that merely moved slots: a delta carries a changed-agent
+ * bitmap and the changed values per column, the graph rows of agents whose
+ * neighbours changed, and regional sections the same way per region. Other
+ * sections are written whole when they differ and left out otherwise.
+ * Changes are found by comparing against the previous save, so no
+ * simulation code has to mark anything dirty. The price is O(state) memory:
+ * the checkpointer keeps a raw copy of the previous save, plus a second one
+ * for the save being captured (about two base files' raw size in all). Each
+ * file records the save it extends, and loadCheckpointChain() rejects a
+ * missing or reordered link.
+ *
+ * save() copies, diffs and writes on the calling thread, which holds the
+ * tick longer than a full save would. To keep only the copy on the tick,
+ * hand the checkpointer to AsyncCheckpointer::save(), which diffs and
+ * writes on its worker.
+ */
+class DeltaCheckpointer {
+public:
+    explicit DeltaCheckpointer(std::uint32_t baseInterval = 10, const CheckpointOptions& options = {});
+    ~DeltaCheckpointer();
+
+    // Write the next base or delta; returns false (and logs) on failure, in
+    // which case the next save still extends the last successful one
+    bool save(const Kernel& kernel, const std::string& filepath);
+    // Make the next save a base (e.g. after rotating files)
+    void requestBase() { parent_id_ = 0; }
+
+    bool lastWasBase() const { return last_was_base_; }
+    std::uint64_t lastBytesWritten() const { return last_bytes_; }
+
+private:
+    friend class AsyncCheckpointer;
+    struct History;  // Section bytes of one save
+    struct Capture;  // A save copied out of the kernel, not yet written
+
+    // save() in three steps: only capture() needs the kernel, and commit()
+    // makes the capture the parent of the next save once its file is written
+    std::unique_ptr<Capture> capture(const Kernel& kernel);
+    std::uint64_t write(const Capture& capture, const std::string& filepath, bool parallel) const;
+    void commit(std::unique_ptr<Capture> capture, std::uint64_t bytes);
+
+    std::uint32_t base_interval_;
+    CheckpointOptions options_;
+    std::uint32_t since_base_ = 0;  // Deltas written since the last base
+    std::uint32_t regions_ = 0;
+    std::uint64_t parent_id_ = 0;   // Last save's chain ID (0: next save is a base)
+    std::unique_ptr<History> history_;
+    std::unique_ptr<History> spare_;  // Buffers of the save before last, reused by the next capture
+    bool last_was_base_ = false;
+    std::uint64_t last_bytes_ = 0;
+};
+
+// Restore a base followed by its deltas in save order
+bool loadCheckpointChain(Kernel& kernel, const std::vector<std::string>& filepaths);
+
+// Outcome of a background save
+struct CheckpointResult {
+    bool ok = false;
+    std::string path;
+    std::string error;            // Set when !ok
+    std::uint64_t generation = 0;
+    std::uint64_t bytes = 0;
+    double captureMs = 0.0;       // Time the caller was held
+    double writeMs = 0.0;         // Encode, write and fsync on the worker
+};
+
+/**
+ * Checkpoints written off the tick loop.
+ *
+ * save() copies the kernel's sections into a private buffer on the calling
+ * thread (a memcpy of the state, between steps, so it is consistent), then
+ * a worker thread encodes, checksums and writes "<path>.tmp", fsyncs it and
+ * renames it over `path` while the kernel keeps stepping. Files are the
+ * regular full format. Encoding on the worker is serial so it does not
+ * compete with the tick's OpenMP team. One save is in flight at a time; a
+ * save() issued before the previous one finished waits for it first. The
+ * copy's buffers are kept for the next save, so repeated captures do not
+ * fault in fresh memory (about one raw checkpoint's size stays allocated).
+ *
+ * The DeltaCheckpointer overload copies into the chain's buffers instead
+ * and diffs against its previous save on the worker, so a delta holds the
+ * caller no longer than a full save. The chain advances only when the file
+ * is in place; leave it alone until the result is in.
+ */
+class AsyncCheckpointer {
+public:
+    // Runs on the worker thread once the save finished or failed
+    using Callback = std::function<void(const CheckpointResult&)>;
+
+    explicit AsyncCheckpointer(const CheckpointOptions& options = {});
+    ~AsyncCheckpointer();  // Waits for the save in flight
+    AsyncCheckpointer(const AsyncCheckpointer&) = delete;
+    AsyncCheckpointer& operator=(const AsyncCheckpointer&) = delete;
+
+    std::future<CheckpointResult> save(const Kernel& kernel, const std::string& filepath, Callback onDone = {});
+    // Write the chain's next base or delta
+    std::future<CheckpointResult> save(const Kernel& kernel, const std::string& filepath,
+                                       DeltaCheckpointer& chain, Callback onDone = {});
+    void wait();
+    bool busy() const { return in_flight_.load(); }
+
+private:
+    struct Job;
+
+    // Run write(temp) -> bytes on the worker, publish the file, then finish(result)
+    template <typename Write, typename Finish>
+    std::future<CheckpointResult> launch(CheckpointResult result, Write write, Finish finish, Callback onDone);
+
+    CheckpointOptions options_;
+    std::unique_ptr<Job> spare_;  // Buffers of the last save, reused by the next
+    std::thread worker_;
+    std::atomic<bool> in_flight_{false};
+};
+
+// Bump when reset() draws a different world from the same config, so stale
+// init images stop matching
+constexpr std::uint32_t kInitImageVersion = 1;
+
+// Hash of every KernelConfig field (seed, geographySeed, startCondition,
+// sizes, rates, ...) plus the checkpoint and init image versions and the
+// storage precision
+std::uint64_t initImageKey(const KernelConfig& cfg);
+
+/**
+ * Cache of initial worlds, for jobs that restart from the same config often.
+ *
+ * An init image is a full checkpoint taken right after reset(cfg), stored as
+ * "<directory>/init-<initImageKey>.ckpt". load() maps an image back through
+ * the regular checkpoint loader, so no agents, network or economy are
+ * generated; store() writes one. Images are written to a unique temporary
+ * file and renamed into place, so runs (threads or processes) that miss the
+ * same key at once never read a partial file. All members are thread-safe.
+ *
+ * A kernel loaded from an image steps exactly like Kernel(cfg), except that
+ * cohort order (backgroundPopulation) and the live culture index are
+ * rebuilt, as with loadCheckpoint(); the activity schedule comes back as
+ * saved. An unreadable image counts as a miss
+ * and is replaced by the next store().
+ */
+class InitImageCache {
+public:
+    explicit InitImageCache(std::string directory);
+
+    std::string pathFor(const KernelConfig& cfg) const;
+    const std::string& directory() const { return directory_; }
+
+    // Kernel at generation 0 for cfg, or nullptr if there is no usable image
+    std::unique_ptr<Kernel> load(const KernelConfig& cfg);
+    // Write the image of a kernel fresh from reset(); returns false (and logs) on failure
+    bool store(const Kernel& kernel);
+    // load(), else build Kernel(cfg, geography) and store() it
+    std::unique_ptr<Kernel> make(const KernelConfig& cfg, std::shared_ptr<const KernelGeography> geography = nullptr);
+
+    std::uint64_t hits() const { return hits_.load(); }
+    std::uint64_t misses() const { return misses_.load(); }
+
+private:
+    std::string directory_;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+};
+
 // Helper functions for binary I/O
 template<typename T>
 void writeBinary(std::ofstream& out, const T& value) {
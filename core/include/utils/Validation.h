@@ -52,7 +52,8 @@ inline void checkIndex(std::uint32_t index, std::size_t size, const char* name)
 }
 
 // Validate a belief array for NaN/Inf
-inline void checkBeliefs(const double* beliefs, std::size_t count, const char* context) {
+template <typename T>  // double, or float under ENABLE_FLOAT_PRECISION
+inline void checkBeliefs(const T* beliefs, std::size_t count, const char* context) {
 #if VALIDATE_ENABLED
     for (std::size_t i = 0; i < count; ++i) {
         if (!std::isfinite(beliefs[i])) {
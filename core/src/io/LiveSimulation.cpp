@@ -0,0 +1,318 @@
+#include "io/LiveSimulation.h"
+#include "modules/OnlineClustering.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+
+namespace {
+
+void appendNumber(std::string& out, double v) {
+    if (!std::isfinite(v)) {
+        out += "null";
+        return;
+    }
+    char text[32];
+    const auto end = std::to_chars(text, text + sizeof(text), v).ptr;
+    out.append(text, end);
+}
+
+void appendInteger(std::string& out, std::uint64_t v) {
+    char text[24];
+    const auto end = std::to_chars(text, text + sizeof(text), v).ptr;
+    out.append(text, end);
+}
+
+void appendKey(std::string& out, const char* key) {
+    out += '"';
+    out += key;
+    out += "\":";
+}
+
+template <typename Array>
+void appendArray(std::string& out, const Array& values) {
+    out += '[';
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) out += ',';
+        appendNumber(out, values[i]);
+    }
+    out += ']';
+}
+
+void appendRegionSummary(std::string& out, std::uint32_t id, const RegionalEconomy& region) {
+    out += "{\"id\":";
+    appendInteger(out, id);
+    out += ",\"population\":";
+    appendInteger(out, region.population);
+    out += ",\"system\":\"";
+    out += economicSystemName(region.economic_system);
+    out += "\",\"development\":";
+    appendNumber(out, region.development);
+    out += ",\"welfare\":";
+    appendNumber(out, region.welfare);
+    out += ",\"inequality\":";
+    appendNumber(out, region.inequality);
+    out += ",\"hardship\":";
+    appendNumber(out, region.hardship);
+}
+
+}  // namespace
+
+LiveSimulation::LiveSimulation(const KernelConfig& config) : LiveSimulation(config, Options{}) {}
+
+LiveSimulation::LiveSimulation(const KernelConfig& config, const Options& options)
+    : kernel_(std::make_unique<Kernel>(config)), options_(options), config_(kernel_->config()) {
+    options_.publishInterval = std::max<std::uint32_t>(1, options_.publishInterval);
+}
+
+LiveSimulation::~LiveSimulation() {
+    stop();
+}
+
+void LiveSimulation::start() {
+    if (worker_.joinable()) return;
+    publish();
+    worker_ = std::thread([this] { workerLoop(); });
+}
+
+void LiveSimulation::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+bool LiveSimulation::enqueue(Command command) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_ || queue_.size() >= options_.queueLimit) return false;
+        queue_.push_back(std::move(command));
+        busy_ = true;
+    }
+    wake_.notify_one();
+    return true;
+}
+
+bool LiveSimulation::step(std::uint64_t ticks) {
+    return enqueue(Command{Command::Kind::Step, ticks, {}});
+}
+
+bool LiveSimulation::run() {
+    return enqueue(Command{Command::Kind::Run, 0, {}});
+}
+
+bool LiveSimulation::pause() {
+    return enqueue(Command{Command::Kind::Pause, 0, {}});
+}
+
+bool LiveSimulation::reset(const KernelConfig& config) {
+    return enqueue(Command{Command::Kind::Reset, 0, config});
+}
+
+std::shared_ptr<const SimSnapshot> LiveSimulation::snapshot() const {
+    return std::atomic_load(&snapshot_);
+}
+
+LiveSimulation::Status LiveSimulation::status() const {
+    Status st;
+    if (const auto snap = snapshot()) {
+        st.generation = snap->generation;
+        st.epoch = snap->epoch;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    st.pendingSteps = pending_;
+    st.queued = queue_.size();
+    st.running = running_;
+    st.lastError = last_error_;
+    return st;
+}
+
+KernelConfig LiveSimulation::config() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+std::shared_ptr<const SimSnapshot> LiveSimulation::waitIdle() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto idle = [this] { return !busy_ && (queue_.empty() || stop_); };
+    while (!idle_.wait_for(lock, std::chrono::milliseconds(100), idle)) {
+    }
+    return snapshot();
+}
+
+void LiveSimulation::workerLoop() {
+    std::uint32_t sincePublish = 0;
+    bool dirty = false;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        if (!queue_.empty()) {
+            Command command = std::move(queue_.front());
+            queue_.pop_front();
+            switch (command.kind) {
+                case Command::Kind::Step:
+                    pending_ += command.ticks;
+                    break;
+                case Command::Kind::Run:
+                    running_ = true;
+                    break;
+                case Command::Kind::Pause:
+                    running_ = false;
+                    pending_ = 0;
+                    break;
+                case Command::Kind::Reset: {
+                    // Build the new world beside the old one, so a config the
+                    // kernel rejects (or cannot allocate) leaves the run as it was
+                    lock.unlock();
+                    std::unique_ptr<Kernel> next;
+                    std::string failure;
+                    try {
+                        next = std::make_unique<Kernel>(command.config);
+                    } catch (const std::exception& e) {
+                        failure = e.what();
+                    }
+                    lock.lock();
+                    if (next) {
+                        config_ = next->config();
+                        kernel_ = std::move(next);
+                        dirty = true;
+                    }
+                    last_error_ = failure.empty() ? std::string() : "reset failed: " + failure;
+                    break;
+                }
+            }
+            continue;
+        }
+        if (running_ || pending_ > 0) {
+            if (pending_ > 0) --pending_;
+            lock.unlock();
+            kernel_->step();
+            dirty = true;
+            if (++sincePublish >= options_.publishInterval) {
+                publish();
+                sincePublish = 0;
+                dirty = false;
+            }
+            lock.lock();
+            continue;
+        }
+        if (dirty) {
+            lock.unlock();
+            publish();
+            lock.lock();
+            sincePublish = 0;
+            dirty = false;
+            continue;  // Commands may have arrived meanwhile
+        }
+        busy_ = false;
+        idle_.notify_all();
+        wake_.wait_for(lock, std::chrono::milliseconds(100), [this] { return stop_ || !queue_.empty(); });
+    }
+    busy_ = false;
+    idle_.notify_all();
+}
+
+void LiveSimulation::publish() {
+    auto snap = std::make_shared<SimSnapshot>();
+    snap->epoch = ++epoch_;
+    snap->generation = kernel_->generation();
+    snap->metrics = kernel_->computeMetrics();
+    const auto& agents = kernel_->agents();
+    for (std::size_t i = 0; i < agents.size(); ++i) snap->alive += agents.alive[i] ? 1u : 0u;
+
+    const auto& m = snap->metrics;
+    std::string& metrics = snap->metricsJson;
+    metrics += "{\"epoch\":";
+    appendInteger(metrics, snap->epoch);
+    metrics += ",\"generation\":";
+    appendInteger(metrics, snap->generation);
+    metrics += ",\"alive\":";
+    appendInteger(metrics, snap->alive);
+    const std::pair<const char*, double> values[] = {
+        {"polarizationMean", m.polarizationMean}, {"polarizationStd", m.polarizationStd},
+        {"avgOpenness", m.avgOpenness}, {"avgConformity", m.avgConformity},
+        {"globalWelfare", m.globalWelfare}, {"globalInequality", m.globalInequality},
+        {"globalHardship", m.globalHardship}};
+    for (const auto& [key, v] : values) {
+        metrics += ',';
+        appendKey(metrics, key);
+        appendNumber(metrics, v);
+    }
+    metrics += '}';
+
+    const auto& economy = kernel_->economy();
+    const auto regionCount = static_cast<std::uint32_t>(kernel_->regionIndex().size());
+    snap->regionsJson = "[";
+    snap->regionJson.resize(regionCount);
+    for (std::uint32_t r = 0; r < regionCount; ++r) {
+        const auto& region = economy.getRegion(r);
+        if (r > 0) snap->regionsJson += ',';
+        appendRegionSummary(snap->regionsJson, r, region);
+        snap->regionsJson += '}';
+
+        std::string& detail = snap->regionJson[r];
+        appendRegionSummary(detail, r, region);
+        detail += ",\"x\":";
+        appendNumber(detail, region.x);
+        detail += ",\"y\":";
+        appendNumber(detail, region.y);
+        detail += ",\"efficiency\":";
+        appendNumber(detail, region.efficiency);
+        detail += ",\"systemStability\":";
+        appendNumber(detail, region.system_stability);
+        detail += ",\"production\":";
+        appendArray(detail, region.production);
+        detail += ",\"consumption\":";
+        appendArray(detail, region.consumption);
+        detail += ",\"prices\":";
+        appendArray(detail, region.prices);
+        detail += ",\"wealthTop10\":";
+        appendNumber(detail, region.wealth_top_10);
+        detail += ",\"wealthBottom50\":";
+        appendNumber(detail, region.wealth_bottom_50);
+        detail += ",\"dominantLanguage\":";
+        appendInteger(detail, region.dominant_language);
+        detail += '}';
+    }
+    snap->regionsJson += ']';
+
+    std::vector<Cluster> clusters;
+    if (const OnlineClustering* live = kernel_->liveClusters()) {
+        clusters = live->snapshot(agents, kernel_->generation());
+        enrichClusters(clusters, *kernel_);
+    }
+    std::string& cultures = snap->culturesJson;
+    cultures = "[";
+    for (std::size_t c = 0; c < clusters.size(); ++c) {
+        const auto& cluster = clusters[c];
+        if (c > 0) cultures += ',';
+        cultures += "{\"id\":";
+        appendInteger(cultures, cluster.id);
+        cultures += ",\"size\":";
+        appendInteger(cultures, cluster.members.size());
+        cultures += ",\"coherence\":";
+        appendNumber(cultures, cluster.coherence);
+        cultures += ",\"centroid\":";
+        appendArray(cultures, cluster.centroid);
+        cultures += ",\"dominantLang\":";
+        appendInteger(cultures, cluster.dominantLang);
+        cultures += ",\"homogeneity\":";
+        appendNumber(cultures, cluster.linguisticHomogeneity);
+        cultures += ",\"topRegions\":[";
+        for (std::size_t i = 0; i < cluster.topRegions.size(); ++i) {
+            if (i > 0) cultures += ',';
+            cultures += '[';
+            appendInteger(cultures, cluster.topRegions[i].first);
+            cultures += ',';
+            appendNumber(cultures, cluster.topRegions[i].second);
+            cultures += ']';
+        }
+        cultures += "]}";
+    }
+    cultures += ']';
+
+    if (hook_) hook_(*kernel_, clusters, *snap);
+    std::atomic_store(&snapshot_, std::shared_ptr<const SimSnapshot>(std::move(snap)));
+}
@@ -0,0 +1,523 @@
+#include "io/MetricsRecorder.h"
+#include "modules/Economy.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+struct RecorderHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t levels;
+    std::uint32_t columns;
+    std::uint32_t regions;
+    std::uint32_t reserved[3];
+};
+static_assert(sizeof(RecorderHeader) == 32, "recorder header layout is fixed");
+
+constexpr std::uint32_t kRecorderVersion = 1;
+
+void pad(std::string& out) {
+    while (out.size() % 8 != 0) out.push_back('\0');
+}
+
+template <typename T>
+void append(std::string& out, const T& v) {
+    out.append(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+template <typename T>
+void appendAll(std::string& out, const std::vector<T>& v) {
+    out.append(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+// Reads a file region by region; any short read is a corrupt file
+class Reader {
+public:
+    explicit Reader(std::istream& in) : in_(in) {}
+
+    bool atEnd() { return in_.peek() == std::char_traits<char>::eof(); }
+
+    void bytes(void* data, std::size_t size) {
+        if (!in_.read(static_cast<char*>(data), static_cast<std::streamsize>(size))) {
+            throw std::runtime_error("metrics file is truncated");
+        }
+        read_ += size;
+    }
+
+    template <typename T>
+    T value() {
+        T v;
+        bytes(&v, sizeof(v));
+        return v;
+    }
+
+    template <typename T>
+    void values(std::vector<T>& out, std::size_t count) {
+        const auto first = out.size();
+        out.resize(first + count);
+        bytes(out.data() + first, count * sizeof(T));
+    }
+
+    void pad() {
+        char zero[8];
+        bytes(zero, (8 - read_ % 8) % 8);
+    }
+
+private:
+    std::istream& in_;
+    std::size_t read_ = 0;
+};
+
+}  // namespace
+
+std::size_t MetricsHistory::column(const std::string& name) const {
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        if (columns[c].name == name) return c;
+    }
+    throw std::invalid_argument("no metrics column '" + name + "'");
+}
+
+MetricsRecorder::MetricsRecorder(const RecorderOptions& options, const std::string& path)
+    : options_(options), path_(path) {
+    if (options_.strides.empty()) throw std::invalid_argument("recorder needs at least one stride");
+    for (const auto stride : options_.strides) {
+        if (stride == 0) throw std::invalid_argument("recorder strides must be positive");
+    }
+    if (options_.chunkRows == 0) throw std::invalid_argument("recorder chunkRows must be positive");
+    if (options_.series == 0) throw std::invalid_argument("recorder has no series selected");
+
+    const auto add = [&](std::uint32_t series, std::initializer_list<const char*> names, bool regional,
+                         bool last = false) {
+        if (!(options_.series & series)) return;
+        for (const char* name : names) shape_.columns.push_back({name, regional, last});
+    };
+    add(kSeriesPopulation, {"population"}, false);
+    add(kSeriesPolarization, {"polarization_mean", "polarization_std"}, false);
+    add(kSeriesTraits, {"openness", "conformity"}, false);
+    add(kSeriesEconomy, {"welfare", "inequality", "hardship"}, false);
+    add(kSeriesMemory, {"memory_used", "memory_reserved"}, false);
+    add(kSeriesMemory, {"memory_peak"}, false, true);
+    if (options_.series & kSeriesMemory) {
+        for (const char* name : Kernel::kMemorySubsystems) {
+            shape_.columns.push_back({std::string("memory_") + name, false, false});
+        }
+    }
+    add(kSeriesRegionPopulation, {"region_population"}, true);
+    add(kSeriesRegionEconomy, {"region_welfare", "region_inequality", "region_hardship", "region_development"},
+        true);
+    add(kSeriesRegionSystem, {"region_system"}, true, true);
+    add(kSeriesRegionLanguage, {"region_language_diversity"}, true);
+    add(kSeriesRegionBeliefs, {"region_belief_0", "region_belief_1", "region_belief_2", "region_belief_3"},
+        true);
+    if (shape_.columns.empty()) throw std::invalid_argument("recorder series mask selects no columns");
+
+    for (const auto stride : options_.strides) {
+        MetricsLevel level;
+        level.stride = stride;
+        shape_.levels.push_back(std::move(level));
+    }
+
+    if (!path_.empty()) {
+        out_.open(path_, std::ios::binary | std::ios::trunc);
+        if (!out_) throw std::runtime_error("cannot create metrics file " + path_);
+    }
+}
+
+MetricsRecorder::~MetricsRecorder() {
+    close();
+}
+
+void MetricsRecorder::layout(const Kernel& kernel) {
+    const auto regions = kernel.config().regions;
+    shape_.regions = options_.regions;
+    if (shape_.regions.empty()) {
+        shape_.regions.resize(regions);
+        for (std::uint32_t r = 0; r < regions; ++r) shape_.regions[r] = r;
+    }
+    for (const auto r : shape_.regions) {
+        if (r >= regions) {
+            throw std::invalid_argument("recorder region " + std::to_string(r) + " out of range");
+        }
+    }
+
+    std::size_t slots = 0;
+    for (const auto& column : shape_.columns) {
+        offsets_.push_back(slots);
+        slots += column.regional ? shape_.regions.size() : 1;
+    }
+    frame_.assign(slots, 0.0);
+
+    for (std::uint32_t l = 0; l < options_.strides.size(); ++l) {
+        Level level;
+        level.stride = options_.strides[l];
+        level.window.assign(slots, 0.0);
+        level.pending = freshBlock(l);
+        levels_.push_back(std::move(level));
+    }
+
+    if (out_.is_open()) {
+        std::string head;
+        RecorderHeader header{{'C', 'I', 'V', 'M'}, kRecorderVersion,
+                              static_cast<std::uint32_t>(levels_.size()),
+                              static_cast<std::uint32_t>(shape_.columns.size()),
+                              static_cast<std::uint32_t>(shape_.regions.size()), {0, 0, 0}};
+        append(head, header);
+        appendAll(head, options_.strides);
+        appendAll(head, shape_.regions);
+        for (const auto& column : shape_.columns) {
+            append(head, static_cast<std::uint8_t>(column.regional));
+            append(head, static_cast<std::uint8_t>(column.last));
+            append(head, static_cast<std::uint16_t>(column.name.size()));
+            head += column.name;
+        }
+        pad(head);
+        out_.write(head.data(), static_cast<std::streamsize>(head.size()));
+        if (!out_) {
+            std::cerr << "Error: cannot write metrics file " << path_ << "\n";
+            failed_ = true;
+        }
+        bytes_ = head.size();
+        writer_ = std::thread([this] { writeLoop(); });
+    }
+    laidOut_ = true;
+}
+
+void MetricsRecorder::capture(const Kernel& kernel) {
+    const auto series = options_.series;
+    std::vector<std::uint32_t> populations;
+    std::vector<std::array<double, 4>> centroids;
+    if (series & (kSeriesPopulation | kSeriesRegionPopulation | kSeriesRegionBeliefs)) {
+        kernel.regionalCentroids(populations, centroids);
+    }
+
+    std::size_t c = 0;
+    const auto global = [&](double v) { frame_[offsets_[c++]] = v; };
+    // Next `count` regional columns; economy fields are read one region at a time
+    const auto regional = [&](std::size_t count, auto&& fill) {
+        std::array<double*, 4> out;
+        for (std::size_t k = 0; k < count; ++k) out[k] = frame_.data() + offsets_[c++];
+        for (std::size_t i = 0; i < shape_.regions.size(); ++i) fill(shape_.regions[i], out, i);
+    };
+
+    if (series & kSeriesPopulation) {
+        std::uint64_t alive = 0;
+        for (const auto p : populations) alive += p;
+        global(static_cast<double>(alive));
+    }
+    if (series & (kSeriesPolarization | kSeriesTraits | kSeriesEconomy)) {
+        const auto m = kernel.computeMetrics();
+        if (series & kSeriesPolarization) {
+            global(m.polarizationMean);
+            global(m.polarizationStd);
+        }
+        if (series & kSeriesTraits) {
+            global(m.avgOpenness);
+            global(m.avgConformity);
+        }
+        if (series & kSeriesEconomy) {
+            global(m.globalWelfare);
+            global(m.globalInequality);
+            global(m.globalHardship);
+        }
+    }
+
+    if (series & kSeriesMemory) {
+        const auto usage = kernel.memoryUsage();
+        global(static_cast<double>(usage.used));
+        global(static_cast<double>(usage.reserved));
+        global(static_cast<double>(usage.peak));
+        for (const auto& subsystem : usage.subsystems) global(static_cast<double>(subsystem.reserved));
+    }
+
+    const auto& economy = kernel.economy();
+    if (series & kSeriesRegionPopulation) {
+        regional(1, [&](std::uint32_t r, auto& out, std::size_t i) { out[0][i] = populations[r]; });
+    }
+    if (series & kSeriesRegionEconomy) {
+        regional(4, [&](std::uint32_t r, auto& out, std::size_t i) {
+            const auto& region = economy.getRegion(r);
+            out[0][i] = region.welfare;
+            out[1][i] = region.inequality;
+            out[2][i] = region.hardship;
+            out[3][i] = region.development;
+        });
+    }
+    if (series & kSeriesRegionSystem) {
+        regional(1, [&](std::uint32_t r, auto& out, std::size_t i) {
+            out[0][i] = static_cast<double>(economy.getRegion(r).economic_system);
+        });
+    }
+    if (series & kSeriesRegionLanguage) {
+        regional(1, [&](std::uint32_t r, auto& out, std::size_t i) {
+            out[0][i] = economy.getRegion(r).linguistic_diversity;
+        });
+    }
+    if (series & kSeriesRegionBeliefs) {
+        regional(4, [&](std::uint32_t r, auto& out, std::size_t i) {
+            for (std::size_t d = 0; d < 4; ++d) out[d][i] = centroids[r][d];
+        });
+    }
+}
+
+void MetricsRecorder::record(const Kernel& kernel) {
+    if (closed_) throw std::logic_error("MetricsRecorder::record after close()");
+    if (!laidOut_) layout(kernel);
+    capture(kernel);
+    ++frames_;
+
+    const auto generation = kernel.generation();
+    for (auto& level : levels_) {
+        if (level.stride == 1) {
+            level.window = frame_;
+            level.count = 1;
+        } else {
+            for (std::size_t c = 0; c < shape_.columns.size(); ++c) {
+                const auto begin = offsets_[c];
+                const auto end = begin + (shape_.columns[c].regional ? shape_.regions.size() : 1);
+                if (shape_.columns[c].last) {
+                    std::copy(frame_.begin() + begin, frame_.begin() + end, level.window.begin() + begin);
+                } else {
+                    for (auto s = begin; s < end; ++s) level.window[s] += frame_[s];
+                }
+            }
+            ++level.count;
+        }
+        level.generation = generation;
+        if (generation % level.stride == 0) emit(level);
+    }
+}
+
+MetricsRecorder::Block MetricsRecorder::freshBlock(std::uint32_t level) const {
+    Block block;
+    block.level = level;
+    block.generations.reserve(options_.chunkRows);
+    block.values.resize(shape_.columns.size());
+    for (std::size_t c = 0; c < shape_.columns.size(); ++c) {
+        block.values[c].reserve(options_.chunkRows * (shape_.columns[c].regional ? shape_.regions.size() : 1));
+    }
+    return block;
+}
+
+void MetricsRecorder::emit(Level& level) {
+    if (level.count == 0) return;
+    auto& block = level.pending;
+    block.generations.push_back(level.generation);
+    const double scale = 1.0 / static_cast<double>(level.count);
+    for (std::size_t c = 0; c < shape_.columns.size(); ++c) {
+        const auto begin = level.window.begin() + static_cast<std::ptrdiff_t>(offsets_[c]);
+        const auto end = begin + static_cast<std::ptrdiff_t>(shape_.columns[c].regional ? shape_.regions.size() : 1);
+        auto& out = block.values[c];
+        const auto first = out.size();
+        out.insert(out.end(), begin, end);
+        if (!shape_.columns[c].last && level.count > 1) {
+            for (auto i = first; i < out.size(); ++i) out[i] *= scale;
+        }
+    }
+    std::fill(level.window.begin(), level.window.end(), 0.0);
+    level.count = 0;
+
+    if (block.generations.size() >= options_.chunkRows) {
+        Block full = freshBlock(block.level);
+        std::swap(full, block);
+        submit(std::move(full));
+    }
+}
+
+void MetricsRecorder::submit(Block&& block) {
+    if (block.generations.empty()) return;
+    if (!out_.is_open()) {
+        kept_.push_back(std::move(block));
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(block));
+    }
+    wake_.notify_one();
+}
+
+void MetricsRecorder::writeLoop() {
+    std::string buffer;
+    for (;;) {
+        Block block;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;
+            block = std::move(queue_.front());
+            queue_.pop_front();
+            if (failed_) continue;
+        }
+        buffer.clear();
+        append(buffer, block.level);
+        append(buffer, static_cast<std::uint32_t>(block.generations.size()));
+        appendAll(buffer, block.generations);
+        for (const auto& column : block.values) appendAll(buffer, column);
+        out_.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out_.flush();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!out_) {
+            std::cerr << "Error: write to metrics file " << path_ << " failed; recording stopped\n";
+            failed_ = true;
+        } else {
+            bytes_ += buffer.size();
+        }
+    }
+}
+
+void MetricsRecorder::close() {
+    if (closed_) return;
+    closed_ = true;
+    if (!laidOut_) {
+        // Nothing recorded: without a layout there is no valid file to leave
+        if (!out_.is_open()) return;
+        out_.close();
+        std::remove(path_.c_str());
+        return;
+    }
+    for (auto& level : levels_) {
+        emit(level);
+        submit(std::move(level.pending));
+        level.pending = freshBlock(level.pending.level);
+    }
+    if (writer_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        writer_.join();
+        out_.close();
+    }
+}
+
+MetricsHistory MetricsRecorder::history() const {
+    MetricsHistory history = shape_;
+    for (auto& level : history.levels) level.values.resize(shape_.columns.size());
+    const auto add = [&](const Block& block) {
+        auto& level = history.levels[block.level];
+        level.generations.insert(level.generations.end(), block.generations.begin(), block.generations.end());
+        for (std::size_t c = 0; c < block.values.size(); ++c) {
+            level.values[c].insert(level.values[c].end(), block.values[c].begin(), block.values[c].end());
+        }
+    };
+    for (const auto& block : kept_) add(block);
+    for (const auto& level : levels_) add(level.pending);
+    return history;
+}
+
+std::uint64_t MetricsRecorder::bytesWritten() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+}
+
+bool MetricsRecorder::failed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+MetricsHistory readMetricsFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open metrics file " + path);
+    Reader reader(in);
+
+    const auto header = reader.value<RecorderHeader>();
+    if (std::memcmp(header.magic, "CIVM", 4) != 0) throw std::runtime_error(path + " is not a metrics file");
+    if (header.version != kRecorderVersion) {
+        throw std::runtime_error("unsupported metrics file version " + std::to_string(header.version));
+    }
+
+    MetricsHistory history;
+    std::vector<std::uint32_t> strides;
+    reader.values(strides, header.levels);
+    reader.values(history.regions, header.regions);
+    for (std::uint32_t c = 0; c < header.columns; ++c) {
+        MetricsColumn column;
+        column.regional = reader.value<std::uint8_t>() != 0;
+        column.last = reader.value<std::uint8_t>() != 0;
+        column.name.resize(reader.value<std::uint16_t>());
+        reader.bytes(&column.name[0], column.name.size());
+        history.columns.push_back(std::move(column));
+    }
+    reader.pad();
+    for (const auto stride : strides) {
+        MetricsLevel level;
+        level.stride = stride;
+        level.values.resize(history.columns.size());
+        history.levels.push_back(std::move(level));
+    }
+
+    while (!reader.atEnd()) {
+        const auto l = reader.value<std::uint32_t>();
+        const auto rows = reader.value<std::uint32_t>();
+        if (l >= history.levels.size()) throw std::runtime_error("metrics file block names a missing level");
+        auto& level = history.levels[l];
+        reader.values(level.generations, rows);
+        for (std::size_t c = 0; c < history.columns.size(); ++c) {
+            const std::size_t width = history.columns[c].regional ? history.regions.size() : 1;
+            reader.values(level.values[c], rows * width);
+        }
+    }
+    return history;
+}
+
+std::vector<MetricDrift> compareMetrics(const MetricsHistory& reference, const MetricsHistory& candidate,
+                                        std::size_t level) {
+    if (level >= reference.levels.size() || level >= candidate.levels.size()) {
+        throw std::invalid_argument("both histories need level " + std::to_string(level));
+    }
+    const auto& a = reference.levels[level];
+    const auto& b = candidate.levels[level];
+
+    // Common rows: generations ascend on both sides
+    std::vector<std::pair<std::size_t, std::size_t>> rows;
+    for (std::size_t i = 0, j = 0; i < a.generations.size() && j < b.generations.size();) {
+        if (a.generations[i] < b.generations[j]) {
+            ++i;
+        } else if (b.generations[j] < a.generations[i]) {
+            ++j;
+        } else {
+            rows.emplace_back(i++, j++);
+        }
+    }
+
+    std::vector<MetricDrift> drift;
+    for (std::size_t c = 0; c < reference.columns.size(); ++c) {
+        const auto& column = reference.columns[c];
+        const auto match = std::find_if(candidate.columns.begin(), candidate.columns.end(),
+                                        [&](const MetricsColumn& other) { return other.name == column.name; });
+        if (match == candidate.columns.end()) continue;
+        if (column.regional && reference.regions != candidate.regions) {
+            throw std::invalid_argument("per-region column " + column.name + " covers different regions");
+        }
+        const std::size_t width = column.regional ? reference.regions.size() : 1;
+        const auto& va = a.values[c];
+        const auto& vb = b.values[static_cast<std::size_t>(match - candidate.columns.begin())];
+
+        MetricDrift d;
+        d.name = column.name;
+        double sum = 0.0;
+        for (const auto& [i, j] : rows) {
+            for (std::size_t k = 0; k < width; ++k) {
+                const double x = va[i * width + k];
+                const double y = vb[j * width + k];
+                const double diff = std::fabs(x - y);
+                const double scale = std::max(std::fabs(x), std::fabs(y));
+                d.maxAbs = std::max(d.maxAbs, diff);
+                if (scale > 0.0) d.maxRel = std::max(d.maxRel, diff / scale);
+                sum += diff;
+                ++d.samples;
+            }
+        }
+        if (d.samples) d.meanAbs = sum / static_cast<double>(d.samples);
+        drift.push_back(std::move(d));
+    }
+    return drift;
+}
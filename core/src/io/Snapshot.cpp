@@ -1,49 +1,257 @@
 #include "io/Snapshot.h"
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
 
-std::string kernelToJson(const Kernel& kernel, bool includeTraits) {
-    std::ostringstream os;
-    os << std::fixed << std::setprecision(4);
-    
-    auto m = kernel.computeMetrics();
-    
-    os << "{";
-    os << "\"generation\":" << kernel.generation() << ",";
-    os << "\"metrics\":{";
-    os << "\"polarizationMean\":" << m.polarizationMean << ",";
-    os << "\"polarizationStd\":" << m.polarizationStd << ",";
-    os << "\"avgOpenness\":" << m.avgOpenness << ",";
-    os << "\"avgConformity\":" << m.avgConformity;
-    os << "},";
-    
-    os << "\"agents\":[";
+namespace {
+
+// Fixed-size buffer in front of the sink: the export never holds more than
+// one chunk, however large the population
+class ChunkWriter {
+public:
+    explicit ChunkWriter(const ExportSink& sink) : sink_(sink) {}
+
+    void put(std::string_view text) { bytes(text.data(), text.size()); }
+
+    void put(char c) {
+        if (used_ == sizeof(buffer_)) flush();
+        buffer_[used_++] = c;
+    }
+
+    void bytes(const void* data, std::size_t size) {
+        const char* src = static_cast<const char*>(data);
+        while (size > 0) {
+            if (used_ == sizeof(buffer_)) flush();
+            const std::size_t n = std::min(size, sizeof(buffer_) - used_);
+            std::memcpy(buffer_ + used_, src, n);
+            used_ += n;
+            src += n;
+            size -= n;
+        }
+    }
+
+    template <typename T>
+    void value(const T& v) { bytes(&v, sizeof(v)); }
+
+    template <typename T>
+    void integer(T v) {
+        char text[24];
+        const auto end = std::to_chars(text, text + sizeof(text), v).ptr;
+        bytes(text, static_cast<std::size_t>(end - text));
+    }
+
+    // Matches `os << std::fixed << std::setprecision(precision) << v`
+    void decimal(double v, int precision) {
+        char text[384];  // Widest fixed double: 309 digits plus sign, point and decimals
+        const auto result = std::to_chars(text, text + sizeof(text), v, std::chars_format::fixed, precision);
+        bytes(text, static_cast<std::size_t>(result.ptr - text));
+    }
+
+    // Zero bytes up to the next multiple of `alignment` since the start
+    void pad(std::size_t alignment) {
+        while ((written_ + used_) % alignment != 0) put('\0');
+    }
+
+    void flush() {
+        if (used_ == 0) return;
+        sink_(buffer_, used_);
+        written_ += used_;
+        used_ = 0;
+    }
+
+private:
+    const ExportSink& sink_;
+    char buffer_[kExportChunkBytes];
+    std::size_t used_ = 0;
+    std::size_t written_ = 0;
+};
+
+// splitmix64 finalizer: a stable per-agent coin flip for sampling
+std::uint64_t mixId(std::uint64_t id, std::uint64_t seed) {
+    std::uint64_t z = id + seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Slots to export, in slot order
+std::vector<std::uint32_t> selectAgents(const Kernel& kernel, const ExportOptions& options) {
     const auto& agents = kernel.agents();
+    std::vector<char> regionWanted;
+    if (!options.regions.empty()) {
+        regionWanted.assign(kernel.config().regions, 0);
+        for (auto r : options.regions) {
+            if (r < regionWanted.size()) regionWanted[r] = 1;
+        }
+    }
+    const bool sampled = options.sampleFraction < 1.0;
+
+    std::vector<std::uint32_t> slots;
+    std::uint64_t seen = 0;
     for (std::size_t i = 0; i < agents.size(); ++i) {
-        const auto& a = agents[i];
-        os << "{";
-        os << "\"id\":" << a.id << ",";
-        os << "\"region\":" << a.region << ",";
-        os << "\"lang\":" << static_cast<int>(a.primaryLang) << ",";
-        os << "\"beliefs\":[" << a.B[0] << "," << a.B[1] << "," 
-           << a.B[2] << "," << a.B[3] << "]";
-        
-        if (includeTraits) {
-            os << ",\"traits\":{";
-            os << "\"openness\":" << a.openness << ",";
-            os << "\"conformity\":" << a.conformity << ",";
-            os << "\"assertiveness\":" << a.assertiveness << ",";
-            os << "\"sociality\":" << a.sociality;
-            os << "}";
-        }
-        
-        os << "}";
-        if (i + 1 < agents.size()) os << ",";
-    }
-    os << "]";
-    os << "}";
-    
-    return os.str();
+        if (options.aliveOnly && !agents.alive[i]) continue;
+        if (!regionWanted.empty() && (agents.region[i] >= regionWanted.size() || !regionWanted[agents.region[i]])) {
+            continue;
+        }
+        // Top 53 hash bits as a uniform draw in [0, 1)
+        if (sampled && (mixId(agents.id[i], options.sampleSeed) >> 11) * 0x1.0p-53 >= options.sampleFraction) {
+            continue;
+        }
+        if (seen++ % options.stride != 0) continue;
+        slots.push_back(static_cast<std::uint32_t>(i));
+    }
+    return slots;
+}
+
+void writeJson(const Kernel& kernel, const std::vector<std::uint32_t>& slots, const ExportOptions& options,
+               ChunkWriter& w) {
+    const int p = options.precision;
+    const std::uint32_t fields = options.fields;
+    const auto m = kernel.computeMetrics();
+    const auto& agents = kernel.agents();
+
+    w.put("{\"generation\":");
+    w.integer(kernel.generation());
+    w.put(",\"metrics\":{\"polarizationMean\":");
+    w.decimal(m.polarizationMean, p);
+    w.put(",\"polarizationStd\":");
+    w.decimal(m.polarizationStd, p);
+    w.put(",\"avgOpenness\":");
+    w.decimal(m.avgOpenness, p);
+    w.put(",\"avgConformity\":");
+    w.decimal(m.avgConformity, p);
+    w.put("},\"agents\":[");
+
+    for (std::size_t k = 0; k < slots.size(); ++k) {
+        const std::uint32_t i = slots[k];
+        if (k > 0) w.put(',');
+        w.put('{');
+        bool first = true;
+        const auto key = [&](std::string_view name) {
+            if (!first) w.put(',');
+            first = false;
+            w.put('"');
+            w.put(name);
+            w.put("\":");
+        };
+        if (fields & kExportId) {
+            key("id");
+            w.integer(agents.id[i]);
+        }
+        if (fields & kExportRegion) {
+            key("region");
+            w.integer(agents.region[i]);
+        }
+        if (fields & kExportLang) {
+            key("lang");
+            w.integer(agents.primaryLang[i]);
+        }
+        if (fields & kExportAge) {
+            key("age");
+            w.integer(agents.age[i]);
+        }
+        if (fields & kExportBeliefs) {
+            key("beliefs");
+            const auto& b = agents.B[i];
+            w.put('[');
+            for (int d = 0; d < 4; ++d) {
+                if (d > 0) w.put(',');
+                w.decimal(b[d], p);
+            }
+            w.put(']');
+        }
+        if (fields & kExportTraits) {
+            key("traits");
+            w.put("{\"openness\":");
+            w.decimal(agents.openness[i], p);
+            w.put(",\"conformity\":");
+            w.decimal(agents.conformity[i], p);
+            w.put(",\"assertiveness\":");
+            w.decimal(agents.assertiveness[i], p);
+            w.put(",\"sociality\":");
+            w.decimal(agents.sociality[i], p);
+            w.put('}');
+        }
+        w.put('}');
+    }
+    w.put("]}");
+}
+
+// Columnar layout: 32-byte header, then one column per requested field in
+// ExportField bit order, each padded to 8 bytes, native little-endian
+struct ColumnarHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t generation;
+    std::uint32_t count;
+    std::uint32_t fields;
+    std::uint32_t regions;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(ColumnarHeader) == 32, "columnar header layout is fixed");
+
+void writeColumnar(const Kernel& kernel, const std::vector<std::uint32_t>& slots, const ExportOptions& options,
+                   ChunkWriter& w) {
+    const auto& agents = kernel.agents();
+    ColumnarHeader header{{'C', 'I', 'V', 'X'}, 1, kernel.generation(),
+                          static_cast<std::uint32_t>(slots.size()), options.fields, kernel.config().regions, 0};
+    w.value(header);
+
+    const auto column = [&](std::uint32_t field, auto&& emit) {
+        if (!(options.fields & field)) return;
+        for (auto i : slots) emit(i);
+        w.pad(8);
+    };
+    column(kExportId, [&](std::uint32_t i) { w.value(agents.id[i]); });
+    column(kExportRegion, [&](std::uint32_t i) { w.value(agents.region[i]); });
+    column(kExportLang, [&](std::uint32_t i) { w.value(agents.primaryLang[i]); });
+    column(kExportBeliefs, [&](std::uint32_t i) {
+        for (double b : agents.B[i]) w.value(static_cast<float>(b));
+    });
+    column(kExportTraits, [&](std::uint32_t i) {
+        w.value(static_cast<float>(agents.openness[i]));
+        w.value(static_cast<float>(agents.conformity[i]));
+        w.value(static_cast<float>(agents.assertiveness[i]));
+        w.value(static_cast<float>(agents.sociality[i]));
+    });
+    column(kExportAge, [&](std::uint32_t i) { w.value(static_cast<std::int32_t>(agents.age[i])); });
+}
+
+}  // namespace
+
+std::size_t exportState(const Kernel& kernel, const ExportSink& sink, const ExportOptions& options) {
+    if (options.stride == 0) {
+        throw std::invalid_argument("export stride must be at least 1");
+    }
+    if (options.precision < 0 || options.precision > 17) {
+        throw std::invalid_argument("export precision must be in [0, 17]");
+    }
+    const auto slots = selectAgents(kernel, options);
+    ChunkWriter w(sink);
+    if (options.format == ExportOptions::Format::Columnar) {
+        writeColumnar(kernel, slots, options, w);
+    } else {
+        writeJson(kernel, slots, options, w);
+    }
+    w.flush();
+    return slots.size();
+}
+
+std::size_t exportState(const Kernel& kernel, std::ostream& out, const ExportOptions& options) {
+    return exportState(kernel, [&out](const char* data, std::size_t size) {
+        out.write(data, static_cast<std::streamsize>(size));
+    }, options);
+}
+
+std::string kernelToJson(const Kernel& kernel, bool includeTraits) {
+    ExportOptions options;
+    if (includeTraits) options.fields |= kExportTraits;
+    std::string json;
+    exportState(kernel, [&json](const char* data, std::size_t size) { json.append(data, size); }, options);
+    return json;
 }
 
 void logMetrics(const Kernel& kernel, std::ostream& out) {
@@ -0,0 +1,215 @@
+#include "kernel/ActivitySet.h"
+#include "kernel/AgentStore.h"
+#include "kernel/SocialGraph.h"
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace {
+constexpr std::array<float, 4> kNoTarget = {std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f, 0.0f};
+}
+
+template <typename Fn>
+void ActivitySet::forEachColumn(Fn&& fn) {
+    fn(last_);
+    fn(quiet_);
+    fn(due_);
+    fn(elapsed_);
+    fn(change_);
+    fn(target_);
+}
+
+void ActivitySet::configure(std::uint32_t interval, double threshold) {
+    interval_ = interval;
+    threshold_ = threshold;
+    if (interval_ == 0) clear();
+}
+
+void ActivitySet::clear() {
+    forEachColumn([](auto& column) { column.clear(); });
+    driftSum_ = 0.0;
+    driftCount_ = 0;
+    stats_ = Stats{};
+}
+
+void ActivitySet::restore(const std::vector<SlotState>& slots) {
+    const std::size_t n = slots.size();
+    forEachColumn([n](auto& column) { column.resize(n); });
+    for (std::size_t i = 0; i < n; ++i) {
+        last_[i] = slots[i].last;
+        target_[i] = slots[i].target;
+        quiet_[i] = slots[i].quiet;
+        due_[i] = 0;
+        elapsed_[i] = 1;
+        change_[i] = 0.0f;
+    }
+}
+
+void ActivitySet::plan(std::size_t n, std::uint64_t tick, const std::uint8_t* alive) {
+    tick_ = tick;
+    driftSum_ = 0.0;
+    driftCount_ = 0;
+    const std::size_t old = last_.size();
+    forEachColumn([n](auto& column) { column.resize(n); });
+    for (std::size_t i = old; i < n; ++i) {
+        last_[i] = tick > 0 ? tick - 1 : 0;
+        target_[i] = kNoTarget;
+    }
+
+    std::uint64_t due = 0, skipped = 0, catchUps = 0, active = 0;
+    const std::uint64_t interval = interval_;
+    for (std::size_t i = 0; i < n; ++i) {
+        change_[i] = 0.0f;
+        if (!alive[i]) {
+            due_[i] = 0;
+            continue;
+        }
+        const std::uint64_t since = tick > last_[i] ? tick - last_[i] : 1;
+        const bool quiescent = quiet_[i] >= kSettleUpdates;
+        due_[i] = !quiescent || since >= interval;
+        // Bounded by the interval, so a shortened interval cannot ask for one huge step
+        elapsed_[i] = static_cast<std::uint32_t>(std::min(since, std::max<std::uint64_t>(interval, 1)));
+        if (due_[i]) {
+            ++due;
+            if (elapsed_[i] > 1) ++catchUps;
+        } else {
+            ++skipped;
+        }
+        if (!quiescent) ++active;
+    }
+    ++stats_.ticks;
+    stats_.updates += due;
+    stats_.skipped += skipped;
+    stats_.catchUps += catchUps;
+    const std::uint64_t live = due + skipped;
+    stats_.activeShare = live > 0 ? static_cast<double>(active) / static_cast<double>(live) : 1.0;
+}
+
+void ActivitySet::resize(std::size_t n) {
+    const std::size_t old = last_.size();
+    if (n <= old) return;
+    forEachColumn([n](auto& column) { column.resize(n); });
+    for (std::size_t i = old; i < n; ++i) {
+        last_[i] = tick_;
+        due_[i] = 1;
+        elapsed_[i] = 1;
+        target_[i] = kNoTarget;
+    }
+    stats_.updates += n - old;
+}
+
+double ActivitySet::targetShift(std::uint32_t slot, const std::array<double, 4>& target, bool keep) {
+    auto& average = target_[slot];
+    if (std::isnan(average[0])) {  // First sight: nothing to compare against yet
+        if (keep) {
+            for (int b = 0; b < 4; ++b) average[b] = static_cast<float>(target[b]);
+        }
+        return 0.0;
+    }
+    // The average's weight on the current target after every tick since the
+    // last update, as if the target had held still
+    const std::uint64_t ticks = std::max<std::uint64_t>(1, tick_ - std::min(tick_, last_[slot]));
+    const double weight = 1.0 - std::pow(1.0 - kTargetSmoothing, static_cast<double>(ticks));
+    double shift = 0.0;
+    for (int b = 0; b < 4; ++b) {
+        const double step = weight * (target[b] - static_cast<double>(average[b]));
+        shift = std::max(shift, std::abs(step));
+        if (keep) average[b] = static_cast<float>(average[b] + step);
+    }
+    return shift / static_cast<double>(ticks);
+}
+
+void ActivitySet::noteSkippedDrift(double sum, std::uint64_t count) {
+    driftSum_ += sum;
+    driftCount_ += count;
+}
+
+void ActivitySet::commit(const SocialGraph& graph) {
+    const std::size_t n = last_.size();
+    const float threshold = static_cast<float>(threshold_);
+    std::uint64_t woken = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!due_[i]) continue;
+        last_[i] = tick_;
+        if (change_[i] > threshold) {
+            quiet_[i] = 0;
+            if (i < graph.numRows()) {
+                for (const auto v : graph.row(static_cast<std::uint32_t>(i))) {
+                    if (v < n && wake(v)) ++woken;
+                }
+            }
+        } else if (quiet_[i] < kSettleUpdates) {
+            ++quiet_[i];
+        }
+    }
+    stats_.neighborWakes += woken;
+    stats_.skippedDrift = driftCount_ > 0 ? driftSum_ / static_cast<double>(driftCount_) : 0.0;
+    stats_.maxSkippedDrift = std::max(stats_.maxSkippedDrift, stats_.skippedDrift);
+}
+
+bool ActivitySet::wake(std::uint32_t slot) {
+    if (slot >= quiet_.size()) return false;
+    const bool quiescent = quiet_[slot] >= kSettleUpdates;
+    quiet_[slot] = 0;
+    return quiescent;
+}
+
+std::uint32_t ActivitySet::wakeNeighbors(const SocialGraph& graph, std::uint32_t slot) {
+    std::uint32_t woken = wake(slot) ? 1 : 0;
+    if (slot >= graph.numRows()) return woken;
+    for (const auto v : graph.row(slot)) {
+        if (wake(v)) ++woken;
+    }
+    return woken;
+}
+
+void ActivitySet::countWakes(std::uint64_t neighbor, std::uint64_t shock, std::uint64_t demographic) {
+    stats_.neighborWakes += neighbor;
+    stats_.shockWakes += shock;
+    stats_.demographicWakes += demographic;
+}
+
+void ActivitySet::compact(const std::vector<std::uint32_t>& remap) {
+    std::size_t kept = 0;
+    const std::size_t n = std::min(last_.size(), remap.size());
+    for (std::size_t slot = 0; slot < n; ++slot) {
+        const auto to = remap[slot];
+        if (to == AgentStore::kNoSlot) continue;
+        // remap is monotone: to <= slot
+        last_[to] = last_[slot];
+        quiet_[to] = quiet_[slot];
+        due_[to] = due_[slot];
+        elapsed_[to] = elapsed_[slot];
+        change_[to] = change_[slot];
+        target_[to] = target_[slot];
+        ++kept;
+    }
+    forEachColumn([kept](auto& column) { column.resize(kept); });
+}
+
+void ActivitySet::reorder(const std::vector<std::uint32_t>& order) {
+    const std::size_t n = last_.size();
+    forEachColumn([&order, n](auto& column) {
+        using Column = std::decay_t<decltype(column)>;
+        Column next(order.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            if (order[i] < n) next[i] = column[order[i]];
+        }
+        column = std::move(next);
+    });
+}
+
+MemoryFootprint ActivitySet::memoryUsage() const {
+    MemoryFootprint m;
+    m.add(last_);
+    m.add(quiet_);
+    m.add(due_);
+    m.add(elapsed_);
+    m.add(change_);
+    m.add(target_);
+    return m;
+}
+
+void ActivitySet::shrinkToFit(std::size_t spare) {
+    forEachColumn([spare](auto& column) { fitCapacity(column, spare); });
+}
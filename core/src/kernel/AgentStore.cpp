@@ -0,0 +1,248 @@
+#include "kernel/AgentStore.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+    // Move kept elements of a column forward in place (remap is monotonic)
+    template <typename T>
+    void compactColumn(std::vector<T>& column, const std::vector<std::uint32_t>& remap,
+                       std::size_t kept) {
+        for (std::size_t i = 0; i < remap.size(); ++i) {
+            if (remap[i] != AgentStore::kNoSlot && remap[i] != i) {
+                column[remap[i]] = std::move(column[i]);
+            }
+        }
+        column.resize(kept);
+    }
+
+    // Gather a column into a new slot order
+    template <typename T>
+    void reorderColumn(std::vector<T>& column, const std::vector<std::uint32_t>& order) {
+        std::vector<T> next;
+        next.reserve(order.size());
+        for (const auto slot : order) next.push_back(std::move(column[slot]));
+        column = std::move(next);
+    }
+
+    // fn(column, ...) for every column, in declaration order (not the graph);
+    // with several stores, fn gets the same column of each
+    template <typename Fn, typename... Stores>
+    void forEachColumn(Fn&& fn, Stores&... s) {
+        fn(s.x...);
+        fn(s.B...);
+        fn(s.B_norm_sq...);
+        fn(s.region...);
+        fn(s.alive...);
+        fn(s.primaryLang...);
+        fn(s.fluency...);
+        fn(s.age...);
+        fn(s.openness...);
+        fn(s.conformity...);
+        fn(s.assertiveness...);
+        fn(s.m_comm...);
+        fn(s.m_susceptibility...);
+        fn(s.id...);
+        fn(s.female...);
+        fn(s.parent_a...);
+        fn(s.parent_b...);
+        fn(s.lineage_id...);
+        fn(s.dialect...);
+        fn(s.sociality...);
+        fn(s.m_mobility...);
+        fn(s.psych...);
+        fn(s.health...);
+    }
+
+    // Map a by-ID slot list through remap; empty (IDs sorted) if it comes out in slot order
+    void remapIndex(std::vector<std::uint32_t>& byId, const std::vector<std::uint32_t>& remap) {
+        std::size_t kept = 0;
+        bool identity = true;
+        for (const auto slot : byId) {
+            if (remap[slot] == AgentStore::kNoSlot) continue;
+            identity = identity && remap[slot] == kept;
+            byId[kept++] = remap[slot];
+        }
+        byId.resize(kept);
+        if (identity) byId.clear();
+    }
+}
+
+AgentStore::AgentStore(const std::vector<Agent>& records) {
+    reserve(records.size());
+    for (const auto& agent : records) {
+        push_back(agent);
+    }
+}
+
+void AgentStore::clear() {
+    forEachColumn([](auto& column) { column.clear(); }, *this);
+    graph.clear();
+    by_id_.clear();
+    ++version_;
+}
+
+void AgentStore::reserve(std::size_t n) {
+    forEachColumn([n](auto& column) { column.reserve(n); }, *this);
+    graph.reserve(n, n * SocialGraph::kDefaultSlack);
+}
+
+void AgentStore::resize(std::size_t n) {
+    by_id_.clear();  // Callers that write ids call reindex()
+    ++version_;
+    if (n <= size()) {
+        forEachColumn([n](auto& column) { column.resize(n); }, *this);
+        graph.resizeRows(n);
+        return;
+    }
+
+    // Grow every column in one step; new slots copy an Agent{} record
+    AgentStore defaults;
+    defaults.push_back(Agent{});
+    forEachColumn([n](auto& column, const auto& fill) { column.resize(n, fill.front()); }, *this, defaults);
+    graph.resizeRows(n);
+}
+
+MemoryFootprint AgentStore::memoryUsage() const {
+    MemoryFootprint m;
+    forEachColumn([&m](const auto& column) { m.add(column); }, *this);
+    m.add(by_id_);
+    return m;
+}
+
+void AgentStore::shrinkToFit(std::size_t spare) {
+    forEachColumn([spare](auto& column) { fitCapacity(column, spare); }, *this);
+    fitCapacity(by_id_, by_id_.empty() ? 0 : spare);
+}
+
+std::uint32_t AgentStore::push_back(const Agent& agent) {
+    const auto slot = static_cast<std::uint32_t>(size());
+
+    x.push_back(agent.x);
+    B.push_back(agent.B);
+    B_norm_sq.push_back(agent.B_norm_sq);
+    region.push_back(agent.region);
+    alive.push_back(agent.alive ? 1 : 0);
+    primaryLang.push_back(agent.primaryLang);
+    fluency.push_back(agent.fluency);
+    age.push_back(agent.age);
+    openness.push_back(agent.openness);
+    conformity.push_back(agent.conformity);
+    assertiveness.push_back(agent.assertiveness);
+    m_comm.push_back(agent.m_comm);
+    m_susceptibility.push_back(agent.m_susceptibility);
+
+    id.push_back(agent.id);
+    female.push_back(agent.female ? 1 : 0);
+    parent_a.push_back(agent.parent_a);
+    parent_b.push_back(agent.parent_b);
+    lineage_id.push_back(agent.lineage_id);
+    dialect.push_back(agent.dialect);
+    sociality.push_back(agent.sociality);
+    m_mobility.push_back(agent.m_mobility);
+    psych.push_back(agent.psych);
+    health.push_back(agent.health);
+    const auto row = graph.addRow(static_cast<std::uint32_t>(agent.neighbors.size()) +
+                                  SocialGraph::kDefaultSlack);
+    graph.assign(row, agent.neighbors.data(), agent.neighbors.size());
+    if (!by_id_.empty()) by_id_.push_back(slot);  // Newest ID sorts last
+    ++version_;
+
+    return slot;
+}
+
+std::uint32_t AgentStore::append(const std::vector<Agent>& agents) {
+    const auto first = static_cast<std::uint32_t>(size());
+    const std::size_t needed = size() + agents.size();
+    if (needed > id.capacity()) {
+        reserve(std::max(needed, id.capacity() * 2));  // Keep growth geometric
+    }
+    for (const auto& agent : agents) {
+        push_back(agent);
+    }
+    return first;
+}
+
+void AgentStore::assign(std::size_t i, const Agent& agent) {
+    x[i] = agent.x;
+    B[i] = agent.B;
+    B_norm_sq[i] = agent.B_norm_sq;
+    region[i] = agent.region;
+    alive[i] = agent.alive ? 1 : 0;
+    primaryLang[i] = agent.primaryLang;
+    fluency[i] = agent.fluency;
+    age[i] = agent.age;
+    openness[i] = agent.openness;
+    conformity[i] = agent.conformity;
+    assertiveness[i] = agent.assertiveness;
+    m_comm[i] = agent.m_comm;
+    m_susceptibility[i] = agent.m_susceptibility;
+
+    id[i] = agent.id;
+    female[i] = agent.female ? 1 : 0;
+    parent_a[i] = agent.parent_a;
+    parent_b[i] = agent.parent_b;
+    lineage_id[i] = agent.lineage_id;
+    dialect[i] = agent.dialect;
+    sociality[i] = agent.sociality;
+    m_mobility[i] = agent.m_mobility;
+    psych[i] = agent.psych;
+    health[i] = agent.health;
+    graph.assign(static_cast<std::uint32_t>(i), agent.neighbors.data(), agent.neighbors.size());
+    ++version_;
+}
+
+std::uint32_t AgentStore::slotOf(std::uint32_t agent_id) const {
+    if (!by_id_.empty()) {
+        auto it = std::lower_bound(by_id_.begin(), by_id_.end(), agent_id,
+                                   [this](std::uint32_t slot, std::uint32_t v) { return id[slot] < v; });
+        if (it == by_id_.end() || id[*it] != agent_id) return kNoSlot;
+        return *it;
+    }
+    auto it = std::lower_bound(id.begin(), id.end(), agent_id);
+    if (it == id.end() || *it != agent_id) return kNoSlot;
+    return static_cast<std::uint32_t>(it - id.begin());
+}
+
+void AgentStore::reindex() {
+    by_id_.clear();
+    ++version_;
+    if (std::is_sorted(id.begin(), id.end())) return;
+    by_id_.resize(size());
+    std::iota(by_id_.begin(), by_id_.end(), 0u);
+    std::sort(by_id_.begin(), by_id_.end(), [this](std::uint32_t a, std::uint32_t b) { return id[a] < id[b]; });
+}
+
+std::vector<std::uint32_t> AgentStore::compact() {
+    const std::size_t n = size();
+    std::vector<std::uint32_t> remap(n, kNoSlot);
+    std::uint32_t kept = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (alive[i]) remap[i] = kept++;
+    }
+    if (kept == n) return remap;
+
+    forEachColumn([&remap, kept](auto& column) { compactColumn(column, remap, kept); }, *this);
+    graph.remap(remap, kept);
+    if (!by_id_.empty()) remapIndex(by_id_, remap);
+    ++version_;
+    return remap;
+}
+
+std::vector<std::uint32_t> AgentStore::reorder(const std::vector<std::uint32_t>& order) {
+    const std::size_t n = size();
+    std::vector<std::uint32_t> remap(n, kNoSlot);
+    for (std::size_t k = 0; k < order.size(); ++k) remap[order[k]] = static_cast<std::uint32_t>(k);
+
+    // Slots in ID order before the move: the index, or every slot while ids are sorted
+    if (by_id_.empty()) {
+        by_id_.resize(n);
+        std::iota(by_id_.begin(), by_id_.end(), 0u);
+    }
+    remapIndex(by_id_, remap);
+
+    forEachColumn([&order](auto& column) { reorderColumn(column, order); }, *this);
+    graph.remap(remap, order.size());
+    ++version_;
+    return remap;
+}
@@ -0,0 +1,177 @@
+#include "kernel/BeliefKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace belief_kernels {
+
+namespace {
+    // Neighbor rows ahead of the current one to prefetch in scalar scans
+    constexpr std::uint32_t kPrefetchDistance = 4;
+
+    inline void prefetchAhead(const Columns& cols, const std::uint32_t* nbrs,
+                              std::uint32_t k, std::uint32_t deg) {
+#if defined(__GNUC__)
+        if (k + kPrefetchDistance < deg && nbrs[k + kPrefetchDistance] < cols.n) {
+            __builtin_prefetch(&cols.B[nbrs[k + kPrefetchDistance]]);
+        }
+#else
+        (void)cols; (void)nbrs; (void)k; (void)deg;
+#endif
+    }
+
+// Row bodies: `own` holds the updated agent, `cols` the rows its edges index
+// (the same columns locally, a shard's halo copies for remote edges)
+inline void hybridRow(const Columns& own, std::uint32_t self, const Columns& cols,
+                      const std::uint32_t* nbrs, std::uint32_t deg,
+                      const HybridParams& params, NeighborInfluence& out) {
+    const std::array<double, 4> Bi = own.B[self];  // Widened from storage precision
+    const double norm_a = Bi[0] * Bi[0] + Bi[1] * Bi[1] + Bi[2] * Bi[2] + Bi[3] * Bi[3];
+    const std::uint8_t lang_i = own.lang[self];
+
+    for (std::uint32_t k = 0; k < deg; ++k) {
+        const std::uint32_t j = nbrs[k];
+        prefetchAhead(cols, nbrs, k, deg);
+        if (j >= cols.n || !cols.alive[j]) continue;
+        const std::array<double, 4> Bn = cols.B[j];
+
+        double dot = 0.0, norm_n = 0.0;
+        for (int b = 0; b < 4; ++b) {
+            dot += Bi[b] * Bn[b];
+            norm_n += Bn[b] * Bn[b];
+        }
+        double similarity = (norm_a > 1e-9 && norm_n > 1e-9) ?
+            dot / (std::sqrt(norm_a) * std::sqrt(norm_n)) : 0.0;
+
+        double weight = std::exp(similarity * params.homophilyExponent);
+        weight = std::clamp(weight, params.minWeight, params.maxWeight);
+        if (cols.lang[j] == lang_i) {
+            weight *= params.languageBonus;
+        }
+
+        for (int b = 0; b < 4; ++b) {
+            out.belief_sum[b] += Bn[b] * weight;
+        }
+        out.total_weight += weight;
+        out.neighbor_count++;
+    }
+}
+
+inline void pairwiseRow(const Columns& own, std::uint32_t self, double self_susceptibility,
+                        const Columns& cols, const std::uint32_t* nbrs, std::uint32_t deg,
+                        const PairwiseParams& params, std::array<double, 4>& acc) {
+    const std::array<double, 4> Bi = own.B[self];
+    const double norm_i = own.B_norm_sq[self];
+    const std::uint8_t lang_i = own.lang[self];
+    const double gate_scale = 1.0 / (1.0 - params.simFloor);
+
+    for (std::uint32_t k = 0; k < deg; ++k) {
+        const std::uint32_t j = nbrs[k];
+        prefetchAhead(cols, nbrs, k, deg);
+        if (j >= cols.n || !cols.alive[j]) continue;
+        const std::array<double, 4> Bj = cols.B[j];
+
+        // Similarity gate on cached squared norms (see Kernel::similarityGate)
+        double s = 1.0;
+        const double norm_prod_sq = norm_i * cols.B_norm_sq[j];
+        if (norm_prod_sq >= 1e-9) {
+            const double dot = Bi[0] * Bj[0] + Bi[1] * Bj[1] + Bi[2] * Bj[2] + Bi[3] * Bj[3];
+            s = std::max(0.0, (dot / std::sqrt(norm_prod_sq) - params.simFloor) * gate_scale);
+        }
+        const double lq = (cols.lang[j] == lang_i) ? 0.5 * (own.fluency[self] + cols.fluency[j]) : 0.1;
+        const double comm = 0.5 * (own.m_comm[self] + cols.m_comm[j]);
+        const double weight = params.stepSize * s * lq * comm * self_susceptibility;
+
+        acc[0] += weight * fastTanh(Bj[0] - Bi[0]);
+        acc[1] += weight * fastTanh(Bj[1] - Bi[1]);
+        acc[2] += weight * fastTanh(Bj[2] - Bi[2]);
+        acc[3] += weight * fastTanh(Bj[3] - Bi[3]);
+    }
+}
+
+}  // namespace
+
+void hybridRowScalar(const Columns& cols, std::uint32_t self,
+                     const std::uint32_t* nbrs, std::uint32_t deg,
+                     const HybridParams& params, NeighborInfluence& out) {
+    hybridRow(cols, self, cols, nbrs, deg, params, out);
+}
+
+void pairwiseRowScalar(const Columns& cols, std::uint32_t self, double self_susceptibility,
+                       const std::uint32_t* nbrs, std::uint32_t deg,
+                       const PairwiseParams& params, std::array<double, 4>& acc) {
+    pairwiseRow(cols, self, self_susceptibility, cols, nbrs, deg, params, acc);
+}
+
+void hybridHalo(const Columns& cols, std::uint32_t self, const Columns& halo,
+                const std::uint32_t* nbrs, std::uint32_t deg,
+                const HybridParams& params, NeighborInfluence& out) {
+    hybridRow(cols, self, halo, nbrs, deg, params, out);
+}
+
+void pairwiseHalo(const Columns& cols, std::uint32_t self, double self_susceptibility,
+                  const Columns& halo, const std::uint32_t* nbrs, std::uint32_t deg,
+                  const PairwiseParams& params, std::array<double, 4>& acc) {
+    pairwiseRow(cols, self, self_susceptibility, halo, nbrs, deg, params, acc);
+}
+
+namespace {
+
+constexpr Dispatch kScalar{Isa::Scalar, "scalar", &hybridRowScalar, &pairwiseRowScalar};
+#if defined(CIV_BELIEF_KERNEL_AVX2)
+constexpr Dispatch kAVX2{Isa::AVX2, "avx2", &hybridRowAVX2, &pairwiseRowAVX2};
+#endif
+#if defined(CIV_BELIEF_KERNEL_AVX512)
+constexpr Dispatch kAVX512{Isa::AVX512, "avx512", &hybridRowAVX512, &pairwiseRowAVX512};
+#endif
+
+const Dispatch& resolveActive() {
+    Isa want = Isa::AVX512;
+    if (const char* env = std::getenv("CIV_BELIEF_KERNEL")) {
+        if (std::strcmp(env, "scalar") == 0) want = Isa::Scalar;
+        else if (std::strcmp(env, "avx2") == 0) want = Isa::AVX2;
+    }
+    return forIsa(want);
+}
+
+}  // namespace
+
+bool supported(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar:
+            return true;
+        case Isa::AVX2:
+#if defined(CIV_BELIEF_KERNEL_AVX2)
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+            return false;
+#endif
+        case Isa::AVX512:
+#if defined(CIV_BELIEF_KERNEL_AVX512)
+            return __builtin_cpu_supports("avx512f");
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+const Dispatch& forIsa(Isa isa) {
+#if defined(CIV_BELIEF_KERNEL_AVX512)
+    if (isa == Isa::AVX512 && supported(Isa::AVX512)) return kAVX512;
+#endif
+#if defined(CIV_BELIEF_KERNEL_AVX2)
+    if (isa != Isa::Scalar && supported(Isa::AVX2)) return kAVX2;
+#endif
+    (void)isa;
+    return kScalar;
+}
+
+const Dispatch& active() {
+    static const Dispatch& dispatch = resolveActive();
+    return dispatch;
+}
+
+}  // namespace belief_kernels
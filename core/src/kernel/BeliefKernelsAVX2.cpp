@@ -0,0 +1,238 @@
+// AVX2 + FMA belief kernels. This translation unit is the only one compiled
+// with -mavx2 -mfma; it is reached solely through belief_kernels::active()
+// after a CPUID check, so the rest of the binary stays baseline x86-64.
+#include "kernel/BeliefKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <immintrin.h>
+
+namespace belief_kernels {
+namespace {
+
+constexpr std::uint32_t kLanes = 4;
+
+// exp(x) = 2^k * e^r with |r| <= ln2/2; degree-11 Taylor on r (~1e-14 rel. error)
+inline __m256d exp_pd(__m256d x) {
+    x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-700.0)), _mm256_set1_pd(700.0));
+    const __m256d k = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(1.4426950408889634)),
+                                      _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(6.93145751953125e-1), x);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(1.42860682030941723212e-6), r);
+
+    __m256d p = _mm256_set1_pd(1.0 / 39916800.0);
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 3628800.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 362880.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 40320.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 5040.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 720.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 120.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 24.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0 / 6.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(0.5));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+    p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(1.0));
+
+    // 2^k: k lands in the low mantissa bits after adding 1.5 * 2^52
+    __m256i ki = _mm256_castpd_si256(_mm256_add_pd(k, _mm256_set1_pd(6755399441055744.0)));
+    ki = _mm256_slli_epi64(_mm256_add_epi64(ki, _mm256_set1_epi64x(1023)), 52);
+    return _mm256_mul_pd(p, _mm256_castsi256_pd(ki));
+}
+
+inline __m256d fastTanh_pd(__m256d x) {
+    const __m256d x2 = _mm256_mul_pd(x, x);
+    const __m256d num = _mm256_mul_pd(x, _mm256_add_pd(_mm256_set1_pd(27.0), x2));
+    const __m256d den = _mm256_fmadd_pd(_mm256_set1_pd(9.0), x2, _mm256_set1_pd(27.0));
+    return _mm256_div_pd(num, den);
+}
+
+// Gather of stored belief values (kernel/Precision.h) widened to double lanes.
+// The float form reuses the double lane mask: narrowing keeps each lane's
+// sign bit, which is all the gather reads.
+inline __m256d gatherStored(const double* base, __m128i index, __m256d lanes) {
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, index, lanes, 8);
+}
+
+inline __m256d gatherStored(const float* base, __m128i index, __m256d lanes) {
+    return _mm256_cvtps_pd(_mm_mask_i32gather_ps(_mm_setzero_ps(), base, index, _mm256_cvtpd_ps(lanes), 4));
+}
+
+inline double hsum(__m256d v) {
+    const __m128d lo = _mm256_castpd256_pd128(v);
+    const __m128d hi = _mm256_extractf128_pd(v, 1);
+    const __m128d s = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+// Per-batch lane setup shared by both kernels: dead or out-of-range
+// neighbors, and lanes past the end of the row, are masked out of the
+// gathers and get a zero weight, so short rows need no scalar tail.
+struct Batch {
+    alignas(16) std::int32_t row[kLanes];   // j * 4 (offset into flat B)
+    alignas(16) std::int32_t slot[kLanes];  // j
+    alignas(32) double valid[kLanes];
+    alignas(32) double sameLang[kLanes];
+    int count = 0;
+};
+
+inline void prepareBatch(const Columns& cols, const std::uint32_t* nbrs, std::uint32_t lanes,
+                         std::uint8_t lang_i, Batch& batch) {
+    batch.count = 0;
+    for (std::uint32_t l = 0; l < kLanes; ++l) {
+        const std::uint32_t j = l < lanes ? nbrs[l] : 0xFFFFFFFFu;
+        const bool ok = j < cols.n && cols.alive[j];
+        batch.slot[l] = ok ? static_cast<std::int32_t>(j) : 0;
+        batch.row[l] = batch.slot[l] * 4;
+        batch.valid[l] = ok ? 1.0 : 0.0;
+        batch.sameLang[l] = (ok && cols.lang[j] == lang_i) ? 1.0 : 0.0;
+        batch.count += ok ? 1 : 0;
+    }
+}
+
+}  // namespace
+
+void hybridRowAVX2(const Columns& cols, std::uint32_t self,
+                   const std::uint32_t* nbrs, std::uint32_t deg,
+                   const HybridParams& params, NeighborInfluence& out) {
+    const std::array<double, 4> Bi = cols.B[self];
+    const double norm_a = Bi[0] * Bi[0] + Bi[1] * Bi[1] + Bi[2] * Bi[2] + Bi[3] * Bi[3];
+    const double inv_norm_a = norm_a > 1e-9 ? 1.0 / std::sqrt(norm_a) : 0.0;
+    const precision::belief_t* flat = cols.B[0].data();
+
+    const __m256d bi0 = _mm256_set1_pd(Bi[0]), bi1 = _mm256_set1_pd(Bi[1]);
+    const __m256d bi2 = _mm256_set1_pd(Bi[2]), bi3 = _mm256_set1_pd(Bi[3]);
+    const __m256d invA = _mm256_set1_pd(inv_norm_a);
+    const __m256d eps = _mm256_set1_pd(1e-9);
+    const __m256d expo = _mm256_set1_pd(params.homophilyExponent);
+    const __m256d wMin = _mm256_set1_pd(params.minWeight);
+    const __m256d wMax = _mm256_set1_pd(params.maxWeight);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d bonusDelta = _mm256_set1_pd(params.languageBonus - 1.0);
+
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    __m256d wsum = _mm256_setzero_pd();
+    int count = 0;
+
+    Batch batch;
+    for (std::uint32_t k = 0; k < deg; k += kLanes) {
+        prepareBatch(cols, nbrs + k, std::min(kLanes, deg - k), cols.lang[self], batch);
+        if (batch.count == 0) continue;
+        count += batch.count;
+
+        const __m256d valid = _mm256_load_pd(batch.valid);
+        const __m256d lanes = _mm256_cmp_pd(valid, zero, _CMP_GT_OQ);
+        const __m128i vrow = _mm_load_si128(reinterpret_cast<const __m128i*>(batch.row));
+        const __m256d n0 = gatherStored(flat + 0, vrow, lanes);
+        const __m256d n1 = gatherStored(flat + 1, vrow, lanes);
+        const __m256d n2 = gatherStored(flat + 2, vrow, lanes);
+        const __m256d n3 = gatherStored(flat + 3, vrow, lanes);
+
+        __m256d dot = _mm256_mul_pd(bi0, n0);
+        dot = _mm256_fmadd_pd(bi1, n1, dot);
+        dot = _mm256_fmadd_pd(bi2, n2, dot);
+        dot = _mm256_fmadd_pd(bi3, n3, dot);
+        __m256d nn = _mm256_mul_pd(n0, n0);
+        nn = _mm256_fmadd_pd(n1, n1, nn);
+        nn = _mm256_fmadd_pd(n2, n2, nn);
+        nn = _mm256_fmadd_pd(n3, n3, nn);
+
+        // Zero similarity when either norm is degenerate (matches scalar branch)
+        const __m256d normOk = _mm256_cmp_pd(nn, eps, _CMP_GT_OQ);
+        __m256d sim = _mm256_div_pd(_mm256_mul_pd(dot, invA), _mm256_sqrt_pd(nn));
+        sim = _mm256_and_pd(normOk, sim);
+
+        __m256d w = exp_pd(_mm256_mul_pd(sim, expo));
+        w = _mm256_min_pd(_mm256_max_pd(w, wMin), wMax);
+        w = _mm256_mul_pd(w, _mm256_fmadd_pd(_mm256_load_pd(batch.sameLang), bonusDelta, one));
+        w = _mm256_mul_pd(w, valid);
+
+        s0 = _mm256_fmadd_pd(n0, w, s0);
+        s1 = _mm256_fmadd_pd(n1, w, s1);
+        s2 = _mm256_fmadd_pd(n2, w, s2);
+        s3 = _mm256_fmadd_pd(n3, w, s3);
+        wsum = _mm256_add_pd(wsum, w);
+    }
+
+    out.belief_sum[0] += hsum(s0);
+    out.belief_sum[1] += hsum(s1);
+    out.belief_sum[2] += hsum(s2);
+    out.belief_sum[3] += hsum(s3);
+    out.total_weight += hsum(wsum);
+    out.neighbor_count += count;
+}
+
+void pairwiseRowAVX2(const Columns& cols, std::uint32_t self, double self_susceptibility,
+                     const std::uint32_t* nbrs, std::uint32_t deg,
+                     const PairwiseParams& params, std::array<double, 4>& acc) {
+    const std::array<double, 4> Bi = cols.B[self];
+    const precision::belief_t* flat = cols.B[0].data();
+
+    const __m256d bi0 = _mm256_set1_pd(Bi[0]), bi1 = _mm256_set1_pd(Bi[1]);
+    const __m256d bi2 = _mm256_set1_pd(Bi[2]), bi3 = _mm256_set1_pd(Bi[3]);
+    const __m256d normI = _mm256_set1_pd(cols.B_norm_sq[self]);
+    const __m256d eps = _mm256_set1_pd(1e-9);
+    const __m256d floor = _mm256_set1_pd(params.simFloor);
+    const __m256d gateScale = _mm256_set1_pd(1.0 / (1.0 - params.simFloor));
+    const __m256d flI = _mm256_set1_pd(cols.fluency[self]);
+    const __m256d commI = _mm256_set1_pd(cols.m_comm[self]);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d otherLang = _mm256_set1_pd(0.1);
+    const __m256d scale = _mm256_set1_pd(params.stepSize * self_susceptibility);
+    const __m256d zero = _mm256_setzero_pd();
+
+    __m256d a0 = _mm256_setzero_pd(), a1 = _mm256_setzero_pd();
+    __m256d a2 = _mm256_setzero_pd(), a3 = _mm256_setzero_pd();
+
+    Batch batch;
+    for (std::uint32_t k = 0; k < deg; k += kLanes) {
+        prepareBatch(cols, nbrs + k, std::min(kLanes, deg - k), cols.lang[self], batch);
+        if (batch.count == 0) continue;
+
+        const __m256d valid = _mm256_load_pd(batch.valid);
+        const __m256d lanes = _mm256_cmp_pd(valid, zero, _CMP_GT_OQ);
+        const __m128i vrow = _mm_load_si128(reinterpret_cast<const __m128i*>(batch.row));
+        const __m128i vslot = _mm_load_si128(reinterpret_cast<const __m128i*>(batch.slot));
+        const __m256d n0 = gatherStored(flat + 0, vrow, lanes);
+        const __m256d n1 = gatherStored(flat + 1, vrow, lanes);
+        const __m256d n2 = gatherStored(flat + 2, vrow, lanes);
+        const __m256d n3 = gatherStored(flat + 3, vrow, lanes);
+        const __m256d nsq = gatherStored(cols.B_norm_sq, vslot, lanes);
+        const __m256d fl = _mm256_mask_i32gather_pd(zero, cols.fluency, vslot, lanes, 8);
+        const __m256d mc = _mm256_mask_i32gather_pd(zero, cols.m_comm, vslot, lanes, 8);
+
+        // Similarity gate: 1 for near-zero norms, else max(0, (cos - floor) / (1 - floor))
+        __m256d dot = _mm256_mul_pd(bi0, n0);
+        dot = _mm256_fmadd_pd(bi1, n1, dot);
+        dot = _mm256_fmadd_pd(bi2, n2, dot);
+        dot = _mm256_fmadd_pd(bi3, n3, dot);
+        const __m256d prod = _mm256_mul_pd(normI, nsq);
+        const __m256d normOk = _mm256_cmp_pd(prod, eps, _CMP_GE_OQ);
+        __m256d s = _mm256_mul_pd(_mm256_sub_pd(_mm256_div_pd(dot, _mm256_sqrt_pd(prod)), floor), gateScale);
+        s = _mm256_max_pd(s, zero);
+        s = _mm256_blendv_pd(one, s, normOk);
+
+        // Language quality and communication
+        const __m256d same = _mm256_load_pd(batch.sameLang);
+        const __m256d lqSame = _mm256_mul_pd(half, _mm256_add_pd(flI, fl));
+        const __m256d lq = _mm256_fmadd_pd(same, _mm256_sub_pd(lqSame, otherLang), otherLang);
+        const __m256d comm = _mm256_mul_pd(half, _mm256_add_pd(commI, mc));
+
+        __m256d w = _mm256_mul_pd(_mm256_mul_pd(scale, s), _mm256_mul_pd(lq, comm));
+        w = _mm256_mul_pd(w, valid);
+
+        a0 = _mm256_fmadd_pd(w, fastTanh_pd(_mm256_sub_pd(n0, bi0)), a0);
+        a1 = _mm256_fmadd_pd(w, fastTanh_pd(_mm256_sub_pd(n1, bi1)), a1);
+        a2 = _mm256_fmadd_pd(w, fastTanh_pd(_mm256_sub_pd(n2, bi2)), a2);
+        a3 = _mm256_fmadd_pd(w, fastTanh_pd(_mm256_sub_pd(n3, bi3)), a3);
+    }
+
+    acc[0] += hsum(a0);
+    acc[1] += hsum(a1);
+    acc[2] += hsum(a2);
+    acc[3] += hsum(a3);
+}
+
+}  // namespace belief_kernels
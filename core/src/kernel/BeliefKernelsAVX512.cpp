@@ -0,0 +1,232 @@
+// AVX-512F belief kernels. Only this translation unit is compiled with
+// -mavx512f; it is reached solely through belief_kernels::active() after a
+// CPUID check.
+#include "kernel/BeliefKernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+// GCC 12's AVX-512 headers seed the pass-through operand of unmasked
+// intrinsics (sqrt, min/max, scalef, roundscale, the 256-bit extract behind
+// _mm512_reduce_add_pd) with a self-initialized _mm512_undefined_pd(), which
+// -Wuninitialized flags at every call once inlined. The value is never read;
+// the warnings point into the header, so the suppression has to cover it.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+
+namespace belief_kernels {
+namespace {
+
+constexpr std::uint32_t kLanes = 8;
+
+// exp(x) = 2^k * e^r with |r| <= ln2/2; degree-11 Taylor on r, scalef for 2^k
+inline __m512d exp_pd(__m512d x) {
+    x = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(-700.0)), _mm512_set1_pd(700.0));
+    const __m512d k = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(1.4426950408889634)),
+                                           _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(6.93145751953125e-1), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(1.42860682030941723212e-6), r);
+
+    __m512d p = _mm512_set1_pd(1.0 / 39916800.0);
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 3628800.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 362880.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 40320.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 5040.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 720.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 120.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 24.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0 / 6.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(0.5));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+    p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+    return _mm512_scalef_pd(p, k);
+}
+
+inline __m512d fastTanh_pd(__m512d x) {
+    const __m512d x2 = _mm512_mul_pd(x, x);
+    const __m512d num = _mm512_mul_pd(x, _mm512_add_pd(_mm512_set1_pd(27.0), x2));
+    const __m512d den = _mm512_fmadd_pd(_mm512_set1_pd(9.0), x2, _mm512_set1_pd(27.0));
+    return _mm512_div_pd(num, den);
+}
+
+// Gather of stored belief values (kernel/Precision.h) widened to double lanes;
+// floats go through the low half of a 16-lane gather (AVX-512F only)
+inline __m512d gatherStored(const double* base, __m256i index, __mmask8 valid) {
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), valid, index, base, 8);
+}
+
+inline __m512d gatherStored(const float* base, __m256i index, __mmask8 valid) {
+    const __m512 wide = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), static_cast<__mmask16>(valid),
+                                                 _mm512_castsi256_si512(index), base, 4);
+    return _mm512_cvtps_pd(_mm512_castps512_ps256(wide));
+}
+
+// Per-batch lane setup: dead/out-of-range neighbors and lanes past the end
+// of the row are masked off, so short rows need no scalar tail
+struct Batch {
+    alignas(32) std::int32_t slot[kLanes];
+    __mmask8 valid = 0;
+    __mmask8 sameLang = 0;
+};
+
+inline void prepareBatch(const Columns& cols, const std::uint32_t* nbrs, std::uint32_t lanes,
+                         std::uint8_t lang_i, Batch& batch) {
+    batch.valid = 0;
+    batch.sameLang = 0;
+    for (std::uint32_t l = 0; l < kLanes; ++l) {
+        const std::uint32_t j = l < lanes ? nbrs[l] : 0xFFFFFFFFu;
+        const bool ok = j < cols.n && cols.alive[j];
+        batch.slot[l] = ok ? static_cast<std::int32_t>(j) : 0;
+        if (ok) {
+            batch.valid |= static_cast<__mmask8>(1u << l);
+            if (cols.lang[j] == lang_i) batch.sameLang |= static_cast<__mmask8>(1u << l);
+        }
+    }
+}
+
+}  // namespace
+
+void hybridRowAVX512(const Columns& cols, std::uint32_t self,
+                     const std::uint32_t* nbrs, std::uint32_t deg,
+                     const HybridParams& params, NeighborInfluence& out) {
+    const std::array<double, 4> Bi = cols.B[self];
+    const double norm_a = Bi[0] * Bi[0] + Bi[1] * Bi[1] + Bi[2] * Bi[2] + Bi[3] * Bi[3];
+    const double inv_norm_a = norm_a > 1e-9 ? 1.0 / std::sqrt(norm_a) : 0.0;
+    const precision::belief_t* flat = cols.B[0].data();
+
+    const __m512d bi0 = _mm512_set1_pd(Bi[0]), bi1 = _mm512_set1_pd(Bi[1]);
+    const __m512d bi2 = _mm512_set1_pd(Bi[2]), bi3 = _mm512_set1_pd(Bi[3]);
+    const __m512d invA = _mm512_set1_pd(inv_norm_a);
+    const __m512d eps = _mm512_set1_pd(1e-9);
+    const __m512d expo = _mm512_set1_pd(params.homophilyExponent);
+    const __m512d wMin = _mm512_set1_pd(params.minWeight);
+    const __m512d wMax = _mm512_set1_pd(params.maxWeight);
+    const __m512d bonus = _mm512_set1_pd(params.languageBonus);
+    const __m512d zero = _mm512_setzero_pd();
+
+    __m512d s0 = zero, s1 = zero, s2 = zero, s3 = zero, wsum = zero;
+    int count = 0;
+
+    Batch batch;
+    for (std::uint32_t k = 0; k < deg; k += kLanes) {
+        prepareBatch(cols, nbrs + k, std::min(kLanes, deg - k), cols.lang[self], batch);
+        if (batch.valid == 0) continue;
+        count += __builtin_popcount(batch.valid);
+
+        const __m256i vrow = _mm256_slli_epi32(
+            _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.slot)), 2);
+        const __m512d n0 = gatherStored(flat + 0, vrow, batch.valid);
+        const __m512d n1 = gatherStored(flat + 1, vrow, batch.valid);
+        const __m512d n2 = gatherStored(flat + 2, vrow, batch.valid);
+        const __m512d n3 = gatherStored(flat + 3, vrow, batch.valid);
+
+        __m512d dot = _mm512_mul_pd(bi0, n0);
+        dot = _mm512_fmadd_pd(bi1, n1, dot);
+        dot = _mm512_fmadd_pd(bi2, n2, dot);
+        dot = _mm512_fmadd_pd(bi3, n3, dot);
+        __m512d nn = _mm512_mul_pd(n0, n0);
+        nn = _mm512_fmadd_pd(n1, n1, nn);
+        nn = _mm512_fmadd_pd(n2, n2, nn);
+        nn = _mm512_fmadd_pd(n3, n3, nn);
+
+        // Zero similarity when either norm is degenerate (matches scalar branch)
+        const __mmask8 normOk = _mm512_cmp_pd_mask(nn, eps, _CMP_GT_OQ);
+        const __m512d sim = _mm512_maskz_div_pd(normOk, _mm512_mul_pd(dot, invA), _mm512_sqrt_pd(nn));
+
+        __m512d w = exp_pd(_mm512_mul_pd(sim, expo));
+        w = _mm512_min_pd(_mm512_max_pd(w, wMin), wMax);
+        w = _mm512_mask_mul_pd(w, batch.sameLang, w, bonus);
+        w = _mm512_maskz_mov_pd(batch.valid, w);
+
+        s0 = _mm512_fmadd_pd(n0, w, s0);
+        s1 = _mm512_fmadd_pd(n1, w, s1);
+        s2 = _mm512_fmadd_pd(n2, w, s2);
+        s3 = _mm512_fmadd_pd(n3, w, s3);
+        wsum = _mm512_add_pd(wsum, w);
+    }
+
+    out.belief_sum[0] += _mm512_reduce_add_pd(s0);
+    out.belief_sum[1] += _mm512_reduce_add_pd(s1);
+    out.belief_sum[2] += _mm512_reduce_add_pd(s2);
+    out.belief_sum[3] += _mm512_reduce_add_pd(s3);
+    out.total_weight += _mm512_reduce_add_pd(wsum);
+    out.neighbor_count += count;
+}
+
+void pairwiseRowAVX512(const Columns& cols, std::uint32_t self, double self_susceptibility,
+                       const std::uint32_t* nbrs, std::uint32_t deg,
+                       const PairwiseParams& params, std::array<double, 4>& acc) {
+    const std::array<double, 4> Bi = cols.B[self];
+    const precision::belief_t* flat = cols.B[0].data();
+
+    const __m512d bi0 = _mm512_set1_pd(Bi[0]), bi1 = _mm512_set1_pd(Bi[1]);
+    const __m512d bi2 = _mm512_set1_pd(Bi[2]), bi3 = _mm512_set1_pd(Bi[3]);
+    const __m512d normI = _mm512_set1_pd(cols.B_norm_sq[self]);
+    const __m512d eps = _mm512_set1_pd(1e-9);
+    const __m512d floor = _mm512_set1_pd(params.simFloor);
+    const __m512d gateScale = _mm512_set1_pd(1.0 / (1.0 - params.simFloor));
+    const __m512d flI = _mm512_set1_pd(cols.fluency[self]);
+    const __m512d commI = _mm512_set1_pd(cols.m_comm[self]);
+    const __m512d half = _mm512_set1_pd(0.5);
+    const __m512d one = _mm512_set1_pd(1.0);
+    const __m512d otherLang = _mm512_set1_pd(0.1);
+    const __m512d scale = _mm512_set1_pd(params.stepSize * self_susceptibility);
+    const __m512d zero = _mm512_setzero_pd();
+
+    __m512d a0 = zero, a1 = zero, a2 = zero, a3 = zero;
+
+    Batch batch;
+    for (std::uint32_t k = 0; k < deg; k += kLanes) {
+        prepareBatch(cols, nbrs + k, std::min(kLanes, deg - k), cols.lang[self], batch);
+        if (batch.valid == 0) continue;
+
+        const __m256i vslot = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.slot));
+        const __m256i vrow = _mm256_slli_epi32(vslot, 2);
+        const __m512d n0 = gatherStored(flat + 0, vrow, batch.valid);
+        const __m512d n1 = gatherStored(flat + 1, vrow, batch.valid);
+        const __m512d n2 = gatherStored(flat + 2, vrow, batch.valid);
+        const __m512d n3 = gatherStored(flat + 3, vrow, batch.valid);
+        const __m512d nsq = gatherStored(cols.B_norm_sq, vslot, batch.valid);
+        const __m512d fl = _mm512_mask_i32gather_pd(zero, batch.valid, vslot, cols.fluency, 8);
+        const __m512d mc = _mm512_mask_i32gather_pd(zero, batch.valid, vslot, cols.m_comm, 8);
+
+        // Similarity gate: 1 for near-zero norms, else max(0, (cos - floor) / (1 - floor))
+        __m512d dot = _mm512_mul_pd(bi0, n0);
+        dot = _mm512_fmadd_pd(bi1, n1, dot);
+        dot = _mm512_fmadd_pd(bi2, n2, dot);
+        dot = _mm512_fmadd_pd(bi3, n3, dot);
+        const __m512d prod = _mm512_mul_pd(normI, nsq);
+        const __mmask8 normOk = _mm512_cmp_pd_mask(prod, eps, _CMP_GE_OQ);
+        __m512d s = _mm512_maskz_div_pd(normOk, dot, _mm512_sqrt_pd(prod));
+        s = _mm512_max_pd(_mm512_mul_pd(_mm512_sub_pd(s, floor), gateScale), zero);
+        s = _mm512_mask_blend_pd(normOk, one, s);
+
+        // Language quality and communication
+        const __m512d lqSame = _mm512_mul_pd(half, _mm512_add_pd(flI, fl));
+        const __m512d lq = _mm512_mask_blend_pd(batch.sameLang, otherLang, lqSame);
+        const __m512d comm = _mm512_mul_pd(half, _mm512_add_pd(commI, mc));
+
+        __m512d w = _mm512_mul_pd(_mm512_mul_pd(scale, s), _mm512_mul_pd(lq, comm));
+        w = _mm512_maskz_mov_pd(batch.valid, w);
+
+        a0 = _mm512_fmadd_pd(w, fastTanh_pd(_mm512_sub_pd(n0, bi0)), a0);
+        a1 = _mm512_fmadd_pd(w, fastTanh_pd(_mm512_sub_pd(n1, bi1)), a1);
+        a2 = _mm512_fmadd_pd(w, fastTanh_pd(_mm512_sub_pd(n2, bi2)), a2);
+        a3 = _mm512_fmadd_pd(w, fastTanh_pd(_mm512_sub_pd(n3, bi3)), a3);
+    }
+
+    acc[0] += _mm512_reduce_add_pd(a0);
+    acc[1] += _mm512_reduce_add_pd(a1);
+    acc[2] += _mm512_reduce_add_pd(a2);
+    acc[3] += _mm512_reduce_add_pd(a3);
+}
+
+}  // namespace belief_kernels
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,315 @@
+#include "kernel/BeliefOffload.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "kernel/AgentStore.h"
+#include "modules/MeanField.h"
+#include "utils/CounterRng.h"
+#if defined(CIV_GPU_OFFLOAD)
+#include <omp.h>
+#endif
+
+namespace {
+
+// Neighbor scan of one row, as belief_kernels::hybridRowScalar (no prefetch)
+template <typename Row>
+inline void hybridInfluence(std::size_t i, const Row* B, const std::uint8_t* alive,
+                            const std::uint8_t* lang, const std::size_t* offsets,
+                            const std::uint32_t* degrees, const std::uint32_t* targets, std::size_t n,
+                            const belief_kernels::HybridParams& params, NeighborInfluence& out) {
+    const double b0 = B[i][0], b1 = B[i][1], b2 = B[i][2], b3 = B[i][3];
+    const double norm_a = b0 * b0 + b1 * b1 + b2 * b2 + b3 * b3;
+    const std::uint32_t* nbrs = targets + offsets[i];
+    out = NeighborInfluence{};
+    for (std::uint32_t k = 0; k < degrees[i]; ++k) {
+        const std::uint32_t j = nbrs[k];
+        if (j >= n || !alive[j]) continue;
+        const double n0 = B[j][0], n1 = B[j][1], n2 = B[j][2], n3 = B[j][3];
+        const double dot = b0 * n0 + b1 * n1 + b2 * n2 + b3 * n3;
+        const double norm_n = n0 * n0 + n1 * n1 + n2 * n2 + n3 * n3;
+        const double similarity = (norm_a > 1e-9 && norm_n > 1e-9) ?
+            dot / (std::sqrt(norm_a) * std::sqrt(norm_n)) : 0.0;
+
+        double weight = std::exp(similarity * params.homophilyExponent);
+        weight = std::clamp(weight, params.minWeight, params.maxWeight);
+        if (lang[j] == lang[i]) {
+            weight *= params.languageBonus;
+        }
+        out.belief_sum[0] += n0 * weight;
+        out.belief_sum[1] += n1 * weight;
+        out.belief_sum[2] += n2 * weight;
+        out.belief_sum[3] += n3 * weight;
+        out.total_weight += weight;
+        out.neighbor_count++;
+    }
+}
+
+// Four N(0, 1) draws by Box-Muller (std::normal_distribution has no device build)
+inline void normals(rng::CounterRng& rng, double* z) {
+    constexpr double kTwoPi = 6.283185307179586;
+    for (int p = 0; p < 4; p += 2) {
+        const double u1 = 1.0 - rng.uniform();  // (0, 1]: log stays finite
+        const double u2 = rng.uniform();
+        const double r = std::sqrt(-2.0 * std::log(u1));
+        z[p] = r * std::cos(kTwoPi * u2);
+        z[p + 1] = r * std::sin(kTwoPi * u2);
+    }
+}
+
+inline double fastTanh(double x) {
+    const double x2 = x * x;
+    return x * (27.0 + x2) / (27.0 + 9.0 * x2);
+}
+
+}  // namespace
+
+BeliefOffload::BeliefOffload() {
+#if defined(CIV_GPU_OFFLOAD)
+    host_ = omp_get_initial_device();
+    device_ = omp_get_num_devices() > 0 ? omp_get_default_device() : host_;
+#endif
+}
+
+BeliefOffload::~BeliefOffload() {
+    release();
+}
+
+const char* BeliefOffload::backend() const {
+#if defined(CIV_GPU_OFFLOAD)
+    return accelerated() ? "omp-target" : "omp-target (host fallback)";
+#else
+    return "host";
+#endif
+}
+
+template <typename T>
+T* BeliefOffload::reserve(Buffer& buf, std::size_t count) {
+    const std::size_t bytes = std::max<std::size_t>(count, 1) * sizeof(T);
+    if (buf.bytes < bytes) {
+        const std::size_t grown = std::max(bytes, buf.bytes + buf.bytes / 2);
+        free(buf);
+#if defined(CIV_GPU_OFFLOAD)
+        buf.ptr = omp_target_alloc(grown, device_);
+#else
+        buf.ptr = std::malloc(grown);
+#endif
+        if (!buf.ptr) throw std::bad_alloc();
+        buf.bytes = grown;
+        stats_.deviceBytes += grown;
+    }
+    return static_cast<T*>(buf.ptr);
+}
+
+template <typename T>
+T* BeliefOffload::upload(Buffer& buf, const T* host, std::size_t count) {
+    T* dst = reserve<T>(buf, count);
+    const std::size_t bytes = count * sizeof(T);
+    if (bytes > 0) {
+#if defined(CIV_GPU_OFFLOAD)
+        omp_target_memcpy(dst, host, bytes, 0, 0, device_, host_);
+#else
+        std::memcpy(dst, host, bytes);
+#endif
+    }
+    stats_.bytesToDevice += bytes;
+    return dst;
+}
+
+template <typename T>
+void BeliefOffload::download(T* host, const Buffer& buf, std::size_t count) {
+    const std::size_t bytes = count * sizeof(T);
+    if (bytes == 0) return;
+#if defined(CIV_GPU_OFFLOAD)
+    omp_target_memcpy(host, buf.ptr, bytes, 0, 0, host_, device_);
+#else
+    std::memcpy(host, buf.ptr, bytes);
+#endif
+    stats_.bytesFromDevice += bytes;
+}
+
+void BeliefOffload::free(Buffer& buf) {
+    if (!buf.ptr) return;
+#if defined(CIV_GPU_OFFLOAD)
+    omp_target_free(buf.ptr, device_);
+#else
+    std::free(buf.ptr);
+#endif
+    stats_.deviceBytes -= buf.bytes;
+    buf = Buffer{};
+}
+
+void BeliefOffload::release() {
+    for (Buffer* buf : {&offsets_, &degrees_, &targets_, &x_, &b_, &normSq_, &alive_, &lang_, &region_,
+                        &age_, &openness_, &conformity_, &assertiveness_, &comm_, &susceptibility_, &id_,
+                        &fields_, &strengths_, &influence_, &change_, &deltas_, &regionDeltas_}) {
+        free(*buf);
+    }
+    invalidate();
+}
+
+void BeliefOffload::run(AgentStore& agents, const MeanFieldApproximation& field,
+                        const belief_kernels::HybridParams& hybrid, const ApplyParams& apply,
+                        std::uint64_t seed, std::uint64_t generation,
+                        std::vector<std::array<double, 4>>& regionDeltas, std::size_t blocks) {
+    using precision::BeliefVec;
+    const std::size_t n = agents.size();
+    const std::size_t regions = field.fields().size();
+    const std::size_t blockSlots = (n + blocks - 1) / blocks;
+    ++stats_.passes;
+
+    // Topology: only when it changed since the last copy
+    const SocialGraph& graph = agents.graph;
+    if (graph.version() != graphVersion_) {
+        upload(offsets_, graph.offsets(), graph.numRows());
+        upload(degrees_, graph.degrees(), graph.numRows());
+        upload(targets_, graph.targets(), graph.capacityEntries());
+        graphVersion_ = graph.version();
+        ++stats_.graphUploads;
+    }
+    const auto* offsets = static_cast<const std::size_t*>(offsets_.ptr);
+    const auto* degrees = static_cast<const std::uint32_t*>(degrees_.ptr);
+    const auto* targets = static_cast<const std::uint32_t*>(targets_.ptr);
+
+    // Birth-only columns: only when the store changed shape or a writer touched it
+    if (agents.version() != storeVersion_) {
+        upload(lang_, agents.primaryLang.data(), n);
+        upload(openness_, agents.openness.data(), n);
+        upload(conformity_, agents.conformity.data(), n);
+        upload(assertiveness_, agents.assertiveness.data(), n);
+        upload(id_, agents.id.data(), n);
+        storeVersion_ = agents.version();
+        ++stats_.traitUploads;
+    }
+    const auto* lang = static_cast<const std::uint8_t*>(lang_.ptr);
+    const auto* openness = static_cast<const precision::trait_t*>(openness_.ptr);
+    const auto* conformity = static_cast<const precision::trait_t*>(conformity_.ptr);
+    const auto* assertiveness = static_cast<const double*>(assertiveness_.ptr);
+    const auto* id = static_cast<const std::uint32_t*>(id_.ptr);
+
+    // Host-written state since the last pass, then this tick's fields
+    BeliefVec* X = upload(x_, agents.x.data(), n);
+    BeliefVec* B = upload(b_, agents.B.data(), n);
+    precision::belief_t* normSq = upload(normSq_, agents.B_norm_sq.data(), n);
+    const std::uint8_t* alive = upload(alive_, agents.alive.data(), n);
+    const std::uint32_t* region = upload(region_, agents.region.data(), n);
+    const int* age = upload(age_, agents.age.data(), n);
+    const double* comm = upload(comm_, agents.m_comm.data(), n);
+    const double* susceptibility = upload(susceptibility_, agents.m_susceptibility.data(), n);
+    const auto* fields = upload(fields_, field.fields().data(), regions);
+    const double* strengths = upload(strengths_, field.strengths().data(), regions);
+    auto* influence = reserve<NeighborInfluence>(influence_, n);
+    auto* change = reserve<std::array<double, 4>>(change_, n);
+    auto* blockDeltas = reserve<std::array<double, 4>>(deltas_, blocks * regions);
+    auto* totals = reserve<std::array<double, 4>>(regionDeltas_, regions);
+#if defined(CIV_GPU_OFFLOAD)
+    const int dev = device_;
+#endif
+    const belief_kernels::HybridParams hp = hybrid;
+    const ApplyParams ap = apply;
+
+    // Neighbor influence: one row per agent
+#if defined(CIV_GPU_OFFLOAD)
+    #pragma omp target teams distribute parallel for device(dev) map(to: hp) \
+        is_device_ptr(B, alive, lang, offsets, degrees, targets, influence)
+#else
+    #pragma omp parallel for schedule(static)
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        hybridInfluence(i, B, alive, lang, offsets, degrees, targets, n, hp, influence[i]);
+    }
+
+    // Apply: the update rule of Kernel::updateBeliefsIn<true, *>
+#if defined(CIV_GPU_OFFLOAD)
+    #pragma omp target teams distribute parallel for device(dev) map(to: ap) \
+        is_device_ptr(X, B, normSq, alive, region, age, openness, conformity, assertiveness, comm, \
+                      susceptibility, id, fields, strengths, influence, change)
+#else
+    #pragma omp parallel for schedule(static)
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        rng::CounterRng rng(seed, generation, id[i], rng::Stream::Innovation);
+        double z[4];
+        normals(rng, z);
+
+        double neighbor_weight = ap.neighborWeightMax
+                               - conformity[i] * (ap.neighborWeightMax - ap.neighborWeightMin);
+        if (influence[i].neighbor_count < 2) {
+            neighbor_weight = 0.4;
+        }
+        neighbor_weight = std::clamp(neighbor_weight, 0.4, 0.9);
+
+        // MeanFieldApproximation::getBlendedInfluence
+        const std::uint32_t r = region[i];
+        const double strength = r < regions ? strengths[r] * 0.6 : 0.0;
+        double social[4];
+        for (int b = 0; b < 4; ++b) {
+            const double f = r < regions ? fields[r][b] : 0.0;
+            social[b] = (influence[i].neighbor_count > 0 && influence[i].total_weight > 0.0)
+                ? neighbor_weight * (influence[i].belief_sum[b] / influence[i].total_weight)
+                      + (1.0 - neighbor_weight) * f * strength
+                : f * strength * 0.3;
+        }
+
+        const double age_factor = std::min(1.0, age[i] / ap.anchoringMaxAge);
+        const double anchoring = ap.anchoringBase + age_factor * ap.anchoringAgeWeight
+                               + assertiveness[i] * ap.anchoringAssertWeight;
+        double adapt_rate = ap.stepSize * comm[i] * susceptibility[i];
+        adapt_rate *= (0.7 + openness[i] * 0.6);
+        adapt_rate *= (1.0 - anchoring * 0.5);
+
+        auto& Bi = B[i];
+        auto& Xi = X[i];
+        for (int b = 0; b < 4; ++b) {
+            const double before = Bi[b];
+            const double delta = adapt_rate * fastTanh(social[b] - before);
+            const double innovation = z[b] * ap.innovationNoise * (1.5 - age_factor) * (0.5 + openness[i]);
+            Xi[b] += delta + innovation;
+            Bi[b] = fastTanh(Xi[b]);
+            change[i][b] = Bi[b] - before;
+        }
+        normSq[i] = precision::normSq(Bi);
+    }
+
+    // Regional deltas over the CPU pass's fixed slot blocks, in slot order
+#if defined(CIV_GPU_OFFLOAD)
+    #pragma omp target teams distribute parallel for device(dev) \
+        is_device_ptr(alive, region, change, blockDeltas)
+#else
+    #pragma omp parallel for schedule(static)
+#endif
+    for (std::size_t blk = 0; blk < blocks; ++blk) {
+        std::array<double, 4>* d = blockDeltas + blk * regions;
+        for (std::size_t r = 0; r < regions; ++r) d[r] = {0.0, 0.0, 0.0, 0.0};
+        const std::size_t end = std::min(n, (blk + 1) * blockSlots);
+        for (std::size_t i = blk * blockSlots; i < end; ++i) {
+            if (!alive[i]) continue;
+            for (int b = 0; b < 4; ++b) d[region[i]][b] += change[i][b];
+        }
+    }
+
+    // One row per region: its blocks added in block order, so the host folds
+    // O(regions) values and the sum does not depend on the device's schedule
+#if defined(CIV_GPU_OFFLOAD)
+    #pragma omp target teams distribute parallel for device(dev) is_device_ptr(blockDeltas, totals)
+#else
+    #pragma omp parallel for schedule(static)
+#endif
+    for (std::size_t r = 0; r < regions; ++r) {
+        double sum[4] = {0.0, 0.0, 0.0, 0.0};
+        for (std::size_t blk = 0; blk < blocks; ++blk) {
+            for (int b = 0; b < 4; ++b) sum[b] += blockDeltas[blk * regions + r][b];
+        }
+        totals[r] = {sum[0], sum[1], sum[2], sum[3]};
+    }
+
+    download(agents.x.data(), x_, n);
+    download(agents.B.data(), b_, n);
+    download(agents.B_norm_sq.data(), normSq_, n);
+    regionDeltas.resize(regions);
+    download(regionDeltas.data(), regionDeltas_, regions);
+}
@@ -0,0 +1,85 @@
+#include "kernel/Communicator.h"
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+void Communicator::allreduceSum(double* data, std::size_t count) {
+    const auto gathered = allgather(data, count);
+    const auto ranks = static_cast<std::size_t>(size());
+    for (std::size_t i = 0; i < count; ++i) {
+        double sum = 0.0;
+        for (std::size_t r = 0; r < ranks; ++r) sum += gathered[r * count + i];
+        data[i] = sum;
+    }
+}
+
+// Mailboxes plus a reusable barrier. A collective posts, waits for everyone,
+// reads, and waits again so no rank posts the next round over unread mail.
+struct LocalCommunicator::Shared {
+    explicit Shared(int n)
+        : size(n), mail(static_cast<std::size_t>(n) * static_cast<std::size_t>(n)),
+          values(static_cast<std::size_t>(n)) {}
+
+    void barrier() {
+        std::unique_lock<std::mutex> lock(mutex);
+        const std::uint64_t round = rounds;
+        if (++arrived == size) {
+            arrived = 0;
+            ++rounds;
+            released.notify_all();
+            return;
+        }
+        released.wait(lock, [&] { return rounds != round; });
+    }
+
+    int size;
+    std::vector<Bytes> mail;                 // [to * size + from]
+    std::vector<std::vector<double>> values; // allgather, per sender
+    std::mutex mutex;
+    std::condition_variable released;
+    int arrived = 0;
+    std::uint64_t rounds = 0;
+};
+
+std::vector<std::unique_ptr<Communicator>> LocalCommunicator::group(int size) {
+    if (size < 1) throw std::invalid_argument("LocalCommunicator::group needs at least one rank");
+    auto shared = std::make_shared<Shared>(size);
+    std::vector<std::unique_ptr<Communicator>> ranks;
+    ranks.reserve(static_cast<std::size_t>(size));
+    for (int r = 0; r < size; ++r) {
+        ranks.emplace_back(new LocalCommunicator(shared, r));
+    }
+    return ranks;
+}
+
+int LocalCommunicator::size() const {
+    return shared_->size;
+}
+
+std::vector<double> LocalCommunicator::allgather(const double* data, std::size_t count) {
+    shared_->values[static_cast<std::size_t>(rank_)].assign(data, data + count);
+    shared_->barrier();
+    std::vector<double> out;
+    out.reserve(count * static_cast<std::size_t>(shared_->size));
+    for (const auto& v : shared_->values) {
+        if (v.size() != count) throw std::logic_error("allgather: ranks disagree on the count");
+        out.insert(out.end(), v.begin(), v.end());
+    }
+    shared_->barrier();
+    return out;
+}
+
+std::vector<Communicator::Bytes> LocalCommunicator::exchange(std::vector<Bytes> send) {
+    const auto n = static_cast<std::size_t>(shared_->size);
+    if (send.size() != n) {
+        throw std::invalid_argument("exchange: expected " + std::to_string(n) + " buffers");
+    }
+    const auto self = static_cast<std::size_t>(rank_);
+    for (std::size_t to = 0; to < n; ++to) shared_->mail[to * n + self] = std::move(send[to]);
+    shared_->barrier();
+    std::vector<Bytes> received(n);
+    for (std::size_t from = 0; from < n; ++from) received[from] = std::move(shared_->mail[self * n + from]);
+    shared_->barrier();
+    return received;
+}
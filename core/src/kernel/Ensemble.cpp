@@ -0,0 +1,212 @@
+#include "kernel/Ensemble.h"
+#include "utils/Serialization.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <tuple>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+using GeographyKey = std::tuple<std::uint64_t, bool, std::uint32_t, std::string>;
+
+GeographyKey geographyKey(const KernelConfig& cfg) {
+    const bool own = cfg.geographySeed != 0;
+    return {own ? cfg.geographySeed : cfg.seed, own, cfg.regions, cfg.startCondition};
+}
+
+// Shared worlds, built on first use and dropped once no pending run needs one
+class GeographyCache {
+public:
+    explicit GeographyCache(const std::vector<EnsembleRun>& runs) {
+        for (const auto& run : runs) ++entries_[geographyKey(run.config)].pending;
+    }
+
+    std::shared_ptr<const KernelGeography> acquire(const KernelConfig& cfg) {
+        Entry* entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entry = &entries_.at(geographyKey(cfg));
+        }
+        std::lock_guard<std::mutex> lock(entry->mutex);  // Later takers wait for the first build
+        auto geography = entry->geography;
+        if (!geography) {
+            geography = KernelGeography::build(cfg);
+            built_.fetch_add(1, std::memory_order_relaxed);
+        }
+        entry->geography = --entry->pending > 0 ? geography : nullptr;
+        return geography;
+    }
+
+    // A run that will not build (its world came from elsewhere)
+    void release(const KernelConfig& cfg) {
+        Entry* entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entry = &entries_.at(geographyKey(cfg));
+        }
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        if (--entry->pending == 0) entry->geography = nullptr;
+    }
+
+    std::size_t built() const { return built_.load(); }
+
+private:
+    struct Entry {
+        std::mutex mutex;
+        std::size_t pending = 0;
+        std::shared_ptr<const KernelGeography> geography;
+    };
+
+    std::mutex mutex_;  // Guards the map; entries never move
+    std::map<GeographyKey, Entry> entries_;
+    std::atomic<std::size_t> built_{0};
+};
+
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<std::size_t> runs;
+};
+
+}  // namespace
+
+Ensemble::Ensemble() : Ensemble(Options{}) {}
+
+Ensemble::Ensemble(const Options& options) : options_(options) {}
+
+std::size_t Ensemble::add(const EnsembleRun& run) {
+    runs_.push_back(run);
+    return runs_.size() - 1;
+}
+
+Ensemble::Summary Ensemble::run(const Sink& sink) {
+    const auto start = std::chrono::steady_clock::now();
+    Summary summary;
+    summary.runs.resize(runs_.size());
+    if (runs_.empty()) return summary;
+
+    int widest = 1;
+    for (const auto& run : runs_) widest = std::max(widest, run.threads);
+    std::size_t workers = options_.workers;
+    if (workers == 0) {
+        workers = std::max<std::size_t>(1, std::thread::hardware_concurrency() / static_cast<unsigned>(widest));
+    }
+    workers = std::min(workers, runs_.size());
+    summary.workers = workers;
+
+    // Deal costliest first, round-robin, so every queue starts balanced
+    std::vector<std::size_t> order(runs_.size());
+    std::iota(order.begin(), order.end(), 0);
+    const auto cost = [&](std::size_t i) {
+        const auto& run = runs_[i];
+        return static_cast<double>(run.config.population) * static_cast<double>(run.ticks + 1);
+    };
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return cost(a) > cost(b); });
+    std::vector<WorkQueue> queues(workers);
+    for (std::size_t i = 0; i < order.size(); ++i) queues[i % workers].runs.push_back(order[i]);
+
+    std::unique_ptr<GeographyCache> cache;
+    if (options_.shareGeography) cache = std::make_unique<GeographyCache>(runs_);
+    std::unique_ptr<serialization::InitImageCache> images;
+    if (!options_.initImageDir.empty()) {
+        images = std::make_unique<serialization::InitImageCache>(options_.initImageDir);
+    }
+    std::mutex sink_mutex;
+    std::atomic<std::size_t> steals{0};
+
+    const auto take = [&](std::size_t self, std::size_t& index) {
+        {
+            std::lock_guard<std::mutex> lock(queues[self].mutex);
+            if (!queues[self].runs.empty()) {
+                index = queues[self].runs.front();
+                queues[self].runs.pop_front();
+                return true;
+            }
+        }
+        for (std::size_t offset = 1; offset < workers; ++offset) {
+            WorkQueue& victim = queues[(self + offset) % workers];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.runs.empty()) {
+                index = victim.runs.back();
+                victim.runs.pop_back();
+                steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;  // Queues only shrink, so nothing is left anywhere
+    };
+
+    const auto emit = [&](std::size_t index, const Kernel& kernel) {
+        EnsembleSample sample;
+        sample.run = index;
+        sample.generation = kernel.generation();
+        sample.metrics = kernel.computeMetrics();
+        const auto& agents = kernel.agents();
+        for (std::size_t i = 0; i < agents.size(); ++i) sample.alive += agents.alive[i] ? 1u : 0u;
+        if (!sink) return;
+        std::lock_guard<std::mutex> lock(sink_mutex);
+        sink(sample);
+    };
+
+    const auto work = [&](std::size_t self) {
+        std::size_t index = 0;
+        while (take(self, index)) {
+            const EnsembleRun& run = runs_[index];
+            EnsembleOutcome& outcome = summary.runs[index];
+            outcome.worker = self;
+            const auto began = std::chrono::steady_clock::now();
+#ifdef _OPENMP
+            omp_set_num_threads(std::max(1, run.threads));
+#endif
+            try {
+                auto kernel = images ? images->load(run.config) : nullptr;
+                if (kernel) {
+                    if (cache) cache->release(run.config);
+                } else {
+                    auto geography = cache ? cache->acquire(run.config) : nullptr;
+                    kernel = std::make_unique<Kernel>(run.config, std::move(geography));
+                    if (images) images->store(*kernel);
+                }
+                for (std::uint64_t t = 1; t <= run.ticks; ++t) {
+                    kernel->step();
+                    if (run.sampleInterval > 0 && t % run.sampleInterval == 0 && t != run.ticks) {
+                        emit(index, *kernel);
+                    }
+                }
+                emit(index, *kernel);
+                outcome.generation = kernel->generation();
+                outcome.ok = true;
+            } catch (const std::exception& e) {
+                outcome.error = e.what();
+            }
+            outcome.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - began).count();
+        }
+    };
+
+    // The caller is worker 0; its OpenMP team size is put back afterwards
+#ifdef _OPENMP
+    const int callerThreads = omp_get_max_threads();
+#endif
+    std::vector<std::thread> pool;
+    for (std::size_t w = 1; w < workers; ++w) pool.emplace_back(work, w);
+    work(0);
+    for (auto& thread : pool) thread.join();
+#ifdef _OPENMP
+    omp_set_num_threads(callerThreads);
+#endif
+
+    for (const auto& outcome : summary.runs) summary.failed += outcome.ok ? 0 : 1;
+    summary.initImageHits = images ? static_cast<std::size_t>(images->hits()) : 0;
+    summary.geographies = cache ? cache->built() : summary.runs.size() - summary.initImageHits;
+    summary.steals = steals.load();
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return summary;
+}
@@ -1,37 +1,154 @@
 #include "kernel/Kernel.h"
+#include "kernel/BeliefKernels.h"
+#include "kernel/ShardedKernel.h"
+#include "kernel/TickScheduler.h"
 #include "modules/Culture.h"
 #include "utils/Validation.h"
+#include "utils/CounterRng.h"
+#include "utils/Profiler.h"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
+#include <limits>
+#include <random>
+#include <unordered_map>
 #include <unordered_set>
 #include <functional>
-#include <thread>
-#include <atomic>
 #include <omp.h>
 
-// Thread-local RNG for parallel operations (prevents race conditions)
-// Uses a combination of random_device + thread ID + global counter for unique seeding
 namespace {
-    std::atomic<uint64_t> global_seed_counter{0};
-    
-    uint64_t generateThreadSeed() {
-        std::random_device rd;
-        uint64_t base = rd();
-        uint64_t thread_component = static_cast<uint64_t>(
-            std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        uint64_t counter = global_seed_counter.fetch_add(1, std::memory_order_relaxed);
-        return base ^ (thread_component * 0x9e3779b97f4a7c15ULL) ^ (counter * 0xbf58476d1ce4e5b9ULL);
+// CohortKey stores the region in 16 bits
+constexpr std::uint32_t kMaxCohortRegions = 65536;
+// Hardship swing over one economy update that counts as a regional shock
+constexpr double kActivityShockHardship = 0.05;
+// Ticks between memory high-water samples when no budget asks for every tick
+constexpr std::uint64_t kMemorySampleTicks = 64;
+// Fixed reduction blocks over slots, sized like TickScheduler sweeps
+std::size_t reductionBlocks(std::size_t n) {
+    return std::clamp<std::size_t>((n + TickScheduler::kMinBlockSlots - 1) / TickScheduler::kMinBlockSlots,
+                                   1, TickScheduler::kMaxReductionBlocks);
+}
+
+inline void addBeliefDelta(double* d, const std::array<double, 4>& before, const std::array<double, 4>& after) {
+    d[0] += after[0] - before[0];
+    d[1] += after[1] - before[1];
+    d[2] += after[2] - before[2];
+    d[3] += after[3] - before[3];
+}
+
+// Deterministic parallel reduction: visit(slot, partial) over fixed slot
+// blocks, then partials merged in block order
+template <typename Partial, typename Visit>
+Partial reduceSlots(std::size_t n, Visit&& visit) {
+    const std::size_t blocks = reductionBlocks(n);
+    const std::size_t blockSlots = (n + blocks - 1) / blocks;
+    std::vector<Partial> partials(blocks);
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(blocks); ++b) {
+        const std::size_t end = std::min(n, (static_cast<std::size_t>(b) + 1) * blockSlots);
+        for (std::size_t i = static_cast<std::size_t>(b) * blockSlots; i < end; ++i) {
+            visit(i, partials[b]);
+        }
     }
-    
-    thread_local std::mt19937_64 tl_rng{generateThreadSeed()};
-    
-    std::mt19937_64& getThreadLocalRNG() {
-        return tl_rng;
+    Partial total;
+    for (const auto& p : partials) total.merge(p);
+    return total;
+}
+
+// Count, sum and sum of squares of a sample (single-pass mean/std)
+struct Moments {
+    double count = 0.0;
+    double sum = 0.0;
+    double sumSq = 0.0;
+    void add(double v) {
+        count += 1.0;
+        sum += v;
+        sumSq += v * v;
+    }
+    void merge(const Moments& o) {
+        count += o.count;
+        sum += o.sum;
+        sumSq += o.sumSq;
+    }
+    double mean() const { return count > 0.0 ? sum / count : 0.0; }
+    double stddev() const {
+        if (count <= 0.0) return 0.0;
+        const double m = mean();
+        return std::sqrt(std::max(0.0, sumSq / count - m * m));
     }
+};
+
+inline double centroidDistance(const std::array<double, 4>& a, const std::array<double, 4>& b) {
+    const double d0 = a[0] - b[0];
+    const double d1 = a[1] - b[1];
+    const double d2 = a[2] - b[2];
+    const double d3 = a[3] - b[3];
+    return std::sqrt(d0 * d0 + d1 * d1 + d2 * d2 + d3 * d3);
 }
 
-Kernel::Kernel(const KernelConfig& cfg) : cfg_(cfg), rng_(cfg.seed) {
+constexpr std::size_t kPairBlocks = 64;                   // Fixed blocks for pairwise reductions
+constexpr std::size_t kPolarizationSamplesPerRegion = 64;  // Sampled pairs per occupied region
+
+// All R(R-1)/2 centroid distances; rows interleave across blocks to balance the triangle
+Moments exactPairDistances(const std::vector<std::array<double, 4>>& c) {
+    std::array<Moments, kPairBlocks> partials{};
+    #pragma omp parallel for schedule(dynamic)
+    for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(kPairBlocks); ++b) {
+        for (std::size_t i = static_cast<std::size_t>(b); i < c.size(); i += kPairBlocks) {
+            for (std::size_t j = i + 1; j < c.size(); ++j) {
+                partials[b].add(centroidDistance(c[i], c[j]));
+            }
+        }
+    }
+    Moments total;
+    for (const auto& p : partials) total.merge(p);
+    return total;
+}
+
+// Uniformly sampled distinct pairs: O(R) work, reproducible for (seed, generation)
+Moments sampledPairDistances(const std::vector<std::array<double, 4>>& c,
+                             std::uint64_t seed, std::uint64_t generation) {
+    const std::size_t perBlock = (kPolarizationSamplesPerRegion * c.size() + kPairBlocks - 1) / kPairBlocks;
+    std::array<Moments, kPairBlocks> partials{};
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(kPairBlocks); ++b) {
+        rng::CounterRng rng(seed, generation, static_cast<std::uint32_t>(b), rng::Stream::Metrics);
+        std::uniform_int_distribution<std::size_t> first(0, c.size() - 1);
+        std::uniform_int_distribution<std::size_t> other(0, c.size() - 2);
+        for (std::size_t k = 0; k < perBlock; ++k) {
+            const std::size_t i = first(rng);
+            std::size_t j = other(rng);
+            if (j >= i) ++j;  // Uniform over j != i
+            partials[b].add(centroidDistance(c[i], c[j]));
+        }
+    }
+    Moments total;
+    for (const auto& p : partials) total.merge(p);
+    return total;
+}
+}
+
+std::shared_ptr<const KernelGeography> KernelGeography::build(const KernelConfig& cfg) {
+    auto geography = std::make_shared<KernelGeography>();
+    geography->ownStream = cfg.geographySeed != 0;
+    geography->seed = geography->ownStream ? cfg.geographySeed : cfg.seed;
+    geography->regions = cfg.regions;
+    geography->rngAfter.seed(geography->seed);
+    geography->economy = Economy::buildGeography(cfg.regions, geography->rngAfter, cfg.startCondition);
+    return geography;
+}
+
+bool KernelGeography::matches(const KernelConfig& cfg) const {
+    return regions == cfg.regions && economy.start_condition == cfg.startCondition &&
+           ownStream == (cfg.geographySeed != 0) && seed == (ownStream ? cfg.geographySeed : cfg.seed);
+}
+
+namespace {
+
+void validateConfig(const KernelConfig& cfg) {
+    if (cfg.regions == 0) {
+        throw std::invalid_argument("regions must be > 0");
+    }
     // Validate demographic parameters
     if (cfg.demographyEnabled) {
         if (cfg.ticksPerYear <= 0) {
@@ -50,20 +167,57 @@ Kernel::Kernel(const KernelConfig& cfg) : cfg_(cfg), rng_(cfg.seed) {
         // Validate mortality/fertility curve ranges would be checked at runtime
         // (curves are computed algorithmically, so bounds are implicit)
     }
-    
+    if (cfg.backgroundPopulation > 0 && cfg.regions > kMaxCohortRegions) {
+        throw std::invalid_argument("backgroundPopulation needs regions <= " +
+                                    std::to_string(kMaxCohortRegions) + " (got " +
+                                    std::to_string(cfg.regions) + ")");
+    }
+    if (!(cfg.activityThreshold >= 0.0)) {
+        throw std::invalid_argument("activityThreshold must be >= 0 (got " +
+                                    std::to_string(cfg.activityThreshold) + ")");
+    }
+}
+
+}  // namespace
+
+Kernel::Kernel(const KernelConfig& cfg) : cfg_(cfg), rng_(cfg.seed) {
+    validateConfig(cfg);
+    reset(cfg);
+}
+
+Kernel::Kernel(const KernelConfig& cfg, std::shared_ptr<const KernelGeography> geography)
+    : cfg_(cfg), rng_(cfg.seed), geography_(std::move(geography)) {
+    validateConfig(cfg);
+    reset(cfg);
+}
+
+Kernel::Kernel(const KernelConfig& cfg, ShardedKernel& shard) : cfg_(cfg), rng_(cfg.seed), shard_(&shard) {
+    validateConfig(cfg);
     reset(cfg);
 }
 
+Kernel::Kernel(const KernelConfig& cfg, Unbuilt) : cfg_(cfg), rng_(cfg.seed) {
+    validateConfig(cfg);
+}
+
 void Kernel::reset(const KernelConfig& cfg) {
     cfg_ = cfg;
     generation_ = 0;
+    ++state_version_;
+    locality_ = {};
+    memory_peaks_ = {};
+    memory_peak_ = 0;
+    memory_retry_above_ = 0;
+    memory_budget_stats_ = {};
     rng_.seed(cfg.seed);
-    psychology_.configure(cfg_.regions, cfg_.seed ^ 0x9E3779B97F4A7C15ULL);
-    health_.configure(cfg_.regions, cfg_.seed ^ 0xBF58476D1CE4E5B9ULL);
-    mean_field_.configure(cfg_.regions);
+    configureModules();
     
-    // Initialize economy FIRST so we have region coordinates
-    economy_.init(cfg_.regions, cfg_.population, rng_, cfg_.startCondition);
+    // Initialize economy FIRST so we have region coordinates. A geography
+    // drawn from this run's seed also advances rng_ past the draws.
+    if (geography_ && !geography_->matches(cfg_)) geography_.reset();
+    const auto geography = geography_ ? geography_ : KernelGeography::build(cfg_);
+    if (!geography->ownStream) rng_ = geography->rngAfter;
+    economy_.init(geography->economy, cfg_.population, rng_);
     
     initAgents();
     buildSmallWorld();
@@ -80,54 +234,78 @@ void Kernel::reset(const KernelConfig& cfg) {
     sorted_attractive_regions_.resize(cfg_.regions);
     rebuildRegionalAggregates();
     aggregates_initialized_ = true;
+    
+    // Background cohorts mirror the initial region/age/sex mix, scaled up
+    background_scale_ = 1.0;
+    if (cfg_.backgroundPopulation > 0 && !agents_.empty()) {
+        background_scale_ = static_cast<double>(cfg_.backgroundPopulation) / static_cast<double>(agents_.size());
+        background_.buildCohortsFromAgents(agents_, background_scale_);
+        calibrateCohorts(background_, background_scale_);
+    }
+    
+    setLiveClustering(cfg_.liveClusters, cfg_.liveClusterReassignTicks);
+    setBeliefOffload(cfg_.offloadBeliefs);
+    setActivity(cfg_.activityInterval, cfg_.activityThreshold);
+}
+
+void Kernel::configureModules() {
+    psychology_.configure(cfg_.regions, cfg_.seed ^ 0x9E3779B97F4A7C15ULL);
+    health_.configure(cfg_.regions, cfg_.seed ^ 0xBF58476D1CE4E5B9ULL);
+    mean_field_.configure(cfg_.regions);
+    background_.configure(cfg_.regions, cfg_.seed ^ 0x94D049BB133111EBULL);
+    demography_rates_stale_ = true;  // The economy is (re)built after this
+}
+
+void Kernel::setLiveClustering(int k, std::uint32_t reassignTicks) {
+    cfg_.liveClusters = std::max(0, k);
+    cfg_.liveClusterReassignTicks = std::max<std::uint32_t>(1, reassignTicks);
+    if (cfg_.liveClusters == 0) {
+        live_clusters_.reset();
+        return;
+    }
+    live_clusters_.emplace(cfg_.liveClusters);
+    live_clusters_->initialize(agents_);
+    live_clusters_->fullReassignment(agents_);
+}
+
+void Kernel::setBeliefOffload(bool on) {
+    cfg_.offloadBeliefs = on;
+    if (!on) {
+        offload_.reset();
+    } else if (!offload_) {
+        offload_ = std::make_unique<BeliefOffload>();
+    } else {
+        offload_->invalidate();  // reset() and restore() replace the graph
+    }
+}
+
+void Kernel::setActivity(std::uint32_t interval, double threshold) {
+    if (!(threshold >= 0.0)) {
+        throw std::invalid_argument("activity threshold must be >= 0 (got " + std::to_string(threshold) + ")");
+    }
+    cfg_.activityInterval = interval;
+    cfg_.activityThreshold = threshold;
+    // Every agent starts active, so the first updates after a switch are exact
+    activity_.clear();
+    activity_.configure(interval, threshold);
 }
 
 void Kernel::initAgents() {
+    const std::uint32_t N = cfg_.population;
     agents_.clear();
-    agents_.reserve(cfg_.population);
+    agents_.resize(N);
     regionIndex_.assign(cfg_.regions, {});
+    nextAgentId_ = N;
     
-    std::normal_distribution<double> beliefNoise(0.0, 0.4);  // Reduced noise for geographic clustering
-    std::normal_distribution<double> traitDist(0.5, 0.15);
-    std::uniform_real_distribution<double> uniDist(0.0, 1.0);
-    std::uniform_int_distribution<std::uint32_t> regionDist(0, cfg_.regions - 1);
+    // A shard seeds only its own block of regions
+    const auto owned = shard_ ? shard_->regions() : ShardedKernel::RegionRange{0, cfg_.regions};
     
-    // Realistic age distribution - approximates demographic pyramid
-    // Age brackets: [0-15), [15-30), [30-50), [50-70), [70-90]
-    std::vector<double> age_boundaries = {0.0, 15.0, 30.0, 50.0, 70.0, 90.0};
-    std::vector<double> age_weights = {0.20, 0.28, 0.26, 0.18, 0.08};
-    std::piecewise_constant_distribution<double> ageDist(
-        age_boundaries.begin(), age_boundaries.end(),
-        age_weights.begin()
-    );
-    std::bernoulli_distribution sexDist(0.5);  // 50/50 male/female
-    
-    for (std::uint32_t i = 0; i < cfg_.population; ++i) {
-        Agent a;
-        a.id = i;
-        a.region = regionDist(rng_);
-        a.alive = true;
-        
-        // Demography: realistic age distribution
-        a.age = static_cast<int>(ageDist(rng_));
-        a.female = sexDist(rng_);
-        
-        // Language will be assigned after economy init (in assignLanguagesByGeography)
-        a.primaryLang = 0;
-        a.dialect = 0;
-        a.fluency = 0.7 + 0.3 * (uniDist(rng_) - 0.5);
-        
-        // Personality traits - all drawn from same distribution
-        // Leadership emerges from network position + traits, not predetermined
-        a.openness = std::clamp(traitDist(rng_), 0.0, 1.0);
-        a.conformity = std::clamp(traitDist(rng_), 0.0, 1.0);
-        a.assertiveness = std::clamp(traitDist(rng_), 0.0, 1.0);
-        a.sociality = std::clamp(traitDist(rng_), 0.0, 1.0);
-        
-        // GEOGRAPHIC BELIEF SEEDING: Create distinct regional cultures
-        // Instead of uniform N(0, σ), seed beliefs based on region location
-        // This creates 4 cultural zones that can diverge further or converge over time
-        const auto& region = economy_.getRegion(a.region);
+    // GEOGRAPHIC BELIEF SEEDING: Create distinct regional cultures
+    // Instead of uniform N(0, σ), seed beliefs based on region location
+    // This creates 4 cultural zones that can diverge further or converge over time
+    std::vector<std::array<double, 4>> regional_bias(cfg_.regions);
+    for (std::uint32_t r = owned.begin; r < owned.end; ++r) {
+        const auto& region = economy_.getRegion(r);
         double x = region.x;  // 0-1 coordinate
         double y = region.y;  // 0-1 coordinate
         
@@ -152,27 +330,74 @@ void Kernel::initAgents() {
         // [1] Tradition-Progress: NW/NE positive (tradition), SW/SE negative (progress)
         // [2] Hierarchy-Equality: varies by wealth/development tendency
         // [3] Isolation-Unity: varies by coastal/central position
-        std::array<double, 4> regional_bias = {
+        regional_bias[r] = {
             (nw_pull + sw_pull) * 0.6 - (ne_pull + se_pull) * 0.6,  // Authority axis
             (nw_pull + ne_pull) * 0.5 - (sw_pull + se_pull) * 0.5,  // Tradition axis
             (nw_pull + se_pull) * 0.4 - (ne_pull + sw_pull) * 0.4,  // Hierarchy axis
             (sw_pull + se_pull) * 0.3 - (nw_pull + ne_pull) * 0.3   // Unity axis
         };
+    }
+    
+    // Realistic age distribution - approximates demographic pyramid
+    // Age brackets: [0-15), [15-30), [30-50), [50-70), [70-90]
+    constexpr std::array<double, 6> age_boundaries = {0.0, 15.0, 30.0, 50.0, 70.0, 90.0};
+    constexpr std::array<double, 5> age_weights = {0.20, 0.28, 0.26, 0.18, 0.08};
+    
+    // Every draw comes from the agent's own Founding stream, so the world
+    // does not depend on thread count or visiting order
+    auto& A = agents_;
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t s = 0; s < static_cast<std::int64_t>(N); ++s) {
+        const auto i = static_cast<std::uint32_t>(s);
+        rng::CounterRng rng(cfg_.seed, 0, i, rng::Stream::Founding);
+        std::normal_distribution<double> beliefNoise(0.0, 0.4);  // Reduced noise for geographic clustering
+        std::normal_distribution<double> traitDist(0.5, 0.15);
+        std::uniform_int_distribution<std::uint32_t> regionDist(owned.begin, owned.end - 1);
+        
+        A.id[i] = i;
+        A.region[i] = regionDist(rng);
+        A.alive[i] = 1;
+        
+        // Demography: bracket by weight, then uniform within the bracket
+        double u = rng.uniform();
+        std::size_t bracket = 0;
+        while (bracket + 1 < age_weights.size() && u >= age_weights[bracket]) {
+            u -= age_weights[bracket++];
+        }
+        A.age[i] = static_cast<int>(age_boundaries[bracket] +
+                                    (age_boundaries[bracket + 1] - age_boundaries[bracket]) * rng.uniform());
+        A.female[i] = rng.uniform() < 0.5 ? 1 : 0;  // 50/50 male/female
+        
+        // Language will be assigned after economy init (in assignLanguagesByGeography)
+        A.primaryLang[i] = 0;
+        A.dialect[i] = 0;
+        A.fluency[i] = 0.7 + 0.3 * (rng.uniform() - 0.5);
+        
+        // Personality traits - all drawn from same distribution
+        // Leadership emerges from network position + traits, not predetermined
+        A.openness[i] = std::clamp(traitDist(rng), 0.0, 1.0);
+        A.conformity[i] = std::clamp(traitDist(rng), 0.0, 1.0);
+        A.assertiveness[i] = std::clamp(traitDist(rng), 0.0, 1.0);
+        A.sociality[i] = std::clamp(traitDist(rng), 0.0, 1.0);
         
         // Initialize beliefs with geographic bias + individual noise
+        const auto& bias = regional_bias[A.region[i]];
+        auto& x = A.x[i];
+        auto& B = A.B[i];
         for (int k = 0; k < 4; ++k) {
-            a.x[k] = regional_bias[k] + beliefNoise(rng_);
-            a.B[k] = fastTanh(a.x[k]);
+            x[k] = bias[k] + beliefNoise(rng);
+            B[k] = fastTanh(x[k]);
         }
-        a.B_norm_sq = a.B[0]*a.B[0] + a.B[1]*a.B[1] + a.B[2]*a.B[2] + a.B[3]*a.B[3];
+        A.B_norm_sq[i] = precision::normSq(B);
         
         // Module multipliers (initialized; modules will update)
-        a.m_comm = 1.0;
-        a.m_susceptibility = 0.7 + 0.6 * (a.openness - 0.5);
-        a.m_mobility = 0.8 + 0.4 * a.sociality;
-        
-        regionIndex_[a.region].push_back(i);
-        agents_.push_back(std::move(a));
+        A.m_comm[i] = 1.0;
+        A.m_susceptibility[i] = 0.7 + 0.6 * (A.openness[i] - 0.5);
+        A.m_mobility[i] = 0.8 + 0.4 * A.sociality[i];
+    }
+    
+    for (std::uint32_t i = 0; i < N; ++i) {
+        regionIndex_[A.region[i]].push_back(i);
     }
 }
 
@@ -182,79 +407,89 @@ void Kernel::buildSmallWorld() {
     if (K % 2) ++K;  // ensure even
     const std::uint32_t halfK = K / 2;
     
-    std::uniform_real_distribution<double> uniDist(0.0, 1.0);
-    std::uniform_int_distribution<std::uint32_t> nodeDist(0, N - 1);
-    
-    // Reserve space to avoid reallocations
-    for (auto& agent : agents_) {
-        agent.neighbors.reserve(K);
-    }
-    
-    // Ring lattice - build only forward edges, avoid duplicates
-    for (std::uint32_t i = 0; i < N; ++i) {
+    // Watts-Strogatz: every agent owns its halfK forward ring edges (i, i+d)
+    // and rewires each with probability p to a node it is not yet tied to.
+    // Draws come from the agent's Wiring stream, so agents rewire in parallel
+    // and the network does not depend on thread count. Backward ring ties are
+    // treated as present even if their owner rewired them away.
+    std::vector<std::uint32_t> forward(static_cast<std::size_t>(N) * halfK);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t s = 0; s < static_cast<std::int64_t>(N); ++s) {
+        const auto i = static_cast<std::uint32_t>(s);
+        std::uint32_t* out = forward.data() + static_cast<std::size_t>(i) * halfK;
         for (std::uint32_t d = 1; d <= halfK; ++d) {
-            std::uint32_t j = (i + d) % N;
-            agents_[i].neighbors.push_back(j);
-            agents_[j].neighbors.push_back(i);
+            out[d - 1] = (i + d) % N;
         }
-    }
-    
-    // Rewiring - optimize to avoid repeated set construction
-    for (std::uint32_t i = 0; i < N; ++i) {
-        // Build set once per agent
-        std::unordered_set<std::uint32_t> current(agents_[i].neighbors.begin(), 
-                                                    agents_[i].neighbors.end());
         
+        rng::CounterRng rng(cfg_.seed, 0, i, rng::Stream::Wiring);
+        std::uniform_int_distribution<std::uint32_t> nodeDist(0, N - 1);
+        const auto tied = [&](std::uint32_t j) {
+            const std::uint32_t back = (i + N - j) % N;
+            return (back >= 1 && back <= halfK) || std::find(out, out + halfK, j) != out + halfK;
+        };
         for (std::uint32_t d = 1; d <= halfK; ++d) {
-            if (uniDist(rng_) < cfg_.rewireProb) {
-                std::uint32_t oldJ = (i + d) % N;
-                
-                // Only rewire if edge still exists
-                if (current.count(oldJ) == 0) continue;
-                
-                // Find new target (with iteration limit to avoid infinite loop)
-                std::uint32_t newJ;
-                int attempts = 0;
-                const int maxAttempts = N * 2;
-                do {
-                    newJ = nodeDist(rng_);
-                    if (++attempts > maxAttempts) break;
-                } while (newJ == i || current.count(newJ));
-                
-                if (attempts > maxAttempts) {
-                    // NOTE: This triggers when network is too dense for random rewiring.
-                    // Creates slight bias toward existing topology. Acceptable for small-world
-                    // properties but may affect long-run dynamics in very dense networks.
-                    continue;
+            if (rng.uniform() >= cfg_.rewireProb) continue;
+            
+            // Find new target (with iteration limit to avoid infinite loop).
+            // Running out keeps the ring edge: a slight bias toward the lattice
+            // in networks too dense for random rewiring.
+            const std::uint64_t maxAttempts = static_cast<std::uint64_t>(N) * 2;
+            for (std::uint64_t attempt = 0; attempt < maxAttempts; ++attempt) {
+                const std::uint32_t newJ = nodeDist(rng);
+                if (newJ != i && !tied(newJ)) {
+                    out[d - 1] = newJ;
+                    break;
                 }
-                
-                // Remove old edge from both sides
-                auto& niNbrs = agents_[i].neighbors;
-                auto& njNbrs = agents_[oldJ].neighbors;
-                niNbrs.erase(std::remove(niNbrs.begin(), niNbrs.end(), oldJ), niNbrs.end());
-                njNbrs.erase(std::remove(njNbrs.begin(), njNbrs.end(), i), njNbrs.end());
-                current.erase(oldJ);
-                
-                // Add new edge
-                agents_[i].neighbors.push_back(newJ);
-                agents_[newJ].neighbors.push_back(i);
-                current.insert(newJ);
             }
         }
     }
     
-    // Deduplicate and remove self-loops (final cleanup)
-    for (auto& agent : agents_) {
-        std::unordered_set<std::uint32_t> unique;
-        std::vector<std::uint32_t> cleaned;
-        cleaned.reserve(agent.neighbors.size());
-        for (auto nid : agent.neighbors) {
-            if (nid != agent.id && unique.insert(nid).second) {
-                cleaned.push_back(nid);
+    // Both directions of every edge: row u holds u's own targets, then the
+    // agents that chose u in agent order
+    std::vector<std::uint32_t> degree(N, halfK);
+    for (const std::uint32_t j : forward) {
+        ++degree[j];
+    }
+    std::vector<std::size_t> first(static_cast<std::size_t>(N) + 1, 0);
+    for (std::uint32_t u = 0; u < N; ++u) {
+        first[u + 1] = first[u] + degree[u];
+    }
+    std::vector<std::uint32_t> targets(first[N]);
+    std::vector<std::size_t> cursor(N);
+    for (std::uint32_t u = 0; u < N; ++u) {
+        std::copy_n(forward.data() + static_cast<std::size_t>(u) * halfK, halfK, targets.data() + first[u]);
+        cursor[u] = first[u] + halfK;
+    }
+    for (std::uint32_t i = 0; i < N; ++i) {
+        for (std::uint32_t d = 0; d < halfK; ++d) {
+            const std::uint32_t j = forward[static_cast<std::size_t>(i) * halfK + d];
+            targets[cursor[j]++] = i;
+        }
+    }
+    
+    // Deduplicate (mutual choices) and remove self-loops in place, row by row
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t s = 0; s < static_cast<std::int64_t>(N); ++s) {
+        const auto u = static_cast<std::uint32_t>(s);
+        std::uint32_t* nbrs = targets.data() + first[u];
+        std::uint32_t kept = 0;
+        for (std::uint32_t k = 0; k < degree[u]; ++k) {
+            const std::uint32_t nid = nbrs[k];
+            if (nid != u && std::find(nbrs, nbrs + kept, nid) == nbrs + kept) {
+                nbrs[kept++] = nid;
             }
         }
-        agent.neighbors = std::move(cleaned);
+        degree[u] = kept;
+    }
+    
+    // Close the gaps and lay rows out in agent order, so the belief update
+    // walks targets sequentially
+    std::size_t packed = 0;
+    for (std::uint32_t u = 0; u < N; ++u) {
+        std::copy_n(targets.data() + first[u], degree[u], targets.data() + packed);
+        packed += degree[u];
     }
+    agents_.graph.build(degree.data(), N, targets.data());
 }
 
 void Kernel::assignLanguagesByGeography() {
@@ -262,8 +497,6 @@ void Kernel::assignLanguagesByGeography() {
     // Language families have "cores" but influence fades with distance
     // Border regions have mixed languages; isolated areas may develop differently
     
-    std::uniform_real_distribution<double> uniDist(0.0, 1.0);
-    std::uniform_int_distribution<std::uint8_t> langDist(0, 3);
     std::normal_distribution<double> noiseDist(0.0, 0.15);  // boundary noise
     
     // Language family centers (not hard quadrant boundaries)
@@ -316,347 +549,583 @@ void Kernel::assignLanguagesByGeography() {
         regionDialect[r] = static_cast<std::uint8_t>(std::min(9.0, std::max(0.0, dialectPos * 10.0)));
     }
     
-    // Assign languages to agents based on their region
-    for (auto& agent : agents_) {
-        if (!agent.alive) continue;
-        
-        std::uint8_t baseLang = regionLang[agent.region];
-        std::uint8_t baseDialect = regionDialect[agent.region];
-        double langStrength = regionLangStrength[agent.region];
+    // Assign languages to agents based on their region, each from its own
+    // Speech stream so agents are independent
+    auto& A = agents_;
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t s = 0; s < static_cast<std::int64_t>(A.size()); ++s) {
+        const auto i = static_cast<std::size_t>(s);
+        if (!A.alive[i]) continue;
+        rng::CounterRng rng(cfg_.seed, 0, A.id[i], rng::Stream::Speech);
+        std::uniform_int_distribution<std::uint8_t> langDist(0, 3);
+        
+        const std::uint32_t region = A.region[i];
+        std::uint8_t baseLang = regionLang[region];
+        std::uint8_t baseDialect = regionDialect[region];
+        double langStrength = regionLangStrength[region];
         
         // EMERGENT LANGUAGE ASSIGNMENT: Minority language probability varies by region strength
         // Border regions (low strength) have more language diversity
         double minority_chance = (1.0 - langStrength) * 0.3;  // 0-21% chance based on distance from core
         
         // Agent's mobility and openness increase chance of speaking non-regional language
-        minority_chance += agent.m_mobility * 0.05 + agent.openness * 0.05;
+        minority_chance += A.m_mobility[i] * 0.05 + A.openness[i] * 0.05;
         minority_chance = std::min(0.4, minority_chance);  // cap at 40%
         
-        if (uniDist(rng_) < minority_chance) {
+        if (rng.uniform() < minority_chance) {
             // More likely to speak neighboring language than distant one
             // Weight by inverse distance to other language centers
-            agent.primaryLang = langDist(rng_);  // simplified: random for now
-            agent.dialect = static_cast<std::uint8_t>(uniDist(rng_) * 10);
+            A.primaryLang[i] = langDist(rng);  // simplified: random for now
+            A.dialect[i] = static_cast<std::uint8_t>(rng.uniform() * 10);
         } else {
-            agent.primaryLang = baseLang;
+            A.primaryLang[i] = baseLang;
             // Dialect variation: stronger language regions have less variation
             int maxVariation = static_cast<int>(3 * (1.0 - langStrength * 0.5));  // 1-3
-            int dialectVariation = static_cast<int>(uniDist(rng_) * (maxVariation * 2 + 1)) - maxVariation;
-            agent.dialect = static_cast<std::uint8_t>(std::clamp(
+            int dialectVariation = static_cast<int>(rng.uniform() * (maxVariation * 2 + 1)) - maxVariation;
+            A.dialect[i] = static_cast<std::uint8_t>(std::clamp(
                 static_cast<int>(baseDialect) + dialectVariation, 0, 9));
         }
     }
 }
 
 void Kernel::updateBeliefs() {
+    // Modes are fixed for the whole pass, so each combination gets its own
+    // instantiation and the per-agent loops carry no mode checks. Validation
+    // is already compiled in or out (VALIDATE_ENABLED).
+    const bool live = live_clusters_.has_value();
+    const bool active = activity_.enabled();
     if (cfg_.useMeanField) {
+        if (active) {
+            live ? updateBeliefsIn<true, true, true>() : updateBeliefsIn<true, false, true>();
+        } else {
+            live ? updateBeliefsIn<true, true, false>() : updateBeliefsIn<true, false, false>();
+        }
+    } else {
+        if (active) {
+            live ? updateBeliefsIn<false, true, true>() : updateBeliefsIn<false, false, true>();
+        } else {
+            live ? updateBeliefsIn<false, true, false>() : updateBeliefsIn<false, false, false>();
+        }
+    }
+}
+
+template <bool kMeanField, bool kLive, bool kActive>
+void Kernel::updateBeliefsIn() {
+    // Hot loops index the SoA columns directly: a neighbor visit touches only
+    // B / B_norm_sq / alive / primaryLang rows, never the cold psych/health data.
+    auto& B = agents_.B;
+    auto& X = agents_.x;
+    auto& B_norm_sq = agents_.B_norm_sq;
+    const auto& alive = agents_.alive;
+    const auto& lang = agents_.primaryLang;
+    const SocialGraph& graph = agents_.graph;
+    const std::size_t n = agents_.size();
+    const double stepSize = cfg_.stepSize;
+    
+    // Neighbor scans run through the per-row kernels (scalar/AVX2/AVX-512)
+    const auto& kernels = belief_kernels::active();
+    belief_kernels::Columns cols;
+    cols.B = B.data();
+    cols.B_norm_sq = B_norm_sq.data();
+    cols.alive = alive.data();
+    cols.lang = lang.data();
+    cols.fluency = agents_.fluency.data();
+    cols.m_comm = agents_.m_comm.data();
+    cols.n = n;
+    
+    // Live culture index: each updated agent picks its nearest centroid in the
+    // apply loop (one slot per iteration, so no races); commit() folds after
+    OnlineClustering* live = kLive ? &*live_clusters_ : nullptr;
+    if constexpr (kLive) live->prepare(n);
+    
+    // Regional belief sums follow each update through per-block deltas over
+    // fixed slot ranges, folded in order, so the aggregates stay current (and
+    // thread-count independent) without a separate O(N) scan; a block only
+    // zeroes and folds the regions it touched
+    const std::size_t blocks = reductionBlocks(n);
+    const std::size_t blockSlots = (n + blocks - 1) / blocks;
+    belief_deltas_.prepare(blocks, cfg_.regions, 4);
+    
+    // Activity scheduling: only due agents update, integrating the ticks
+    // they skipped; sampled skipped agents are evaluated but not applied, and
+    // how far their social targets moved meanwhile (sum, count per block) is
+    // the divergence estimate
+    const ActivitySet& activity = activity_;
+    auto& skipped_drift = arena_.acquire<std::array<double, 2>>(kActive ? blocks : 0);
+    const auto evaluated = [&](std::size_t i) {
+        return activity.due(static_cast<std::uint32_t>(i)) || activity.sampled(agents_.id[i]);
+    };
+
+    if constexpr (kMeanField) {
         // **HYBRID BELIEF INFLUENCE**: Blends neighbor influence with regional field
         // This enables polarization and echo chambers while maintaining O(N) complexity
         
-        // Compute regional fields once
-        mean_field_.computeFields(agents_, regionIndex_);
+        // Regional fields straight from the incremental aggregates: O(R)
+        auto& region_populations = arena_.acquire<std::uint32_t>(cfg_.regions);
+        auto& region_means = arena_.acquire<std::array<double, 4>>(cfg_.regions);
+        regionalCentroids(region_populations, region_means);
+        mean_field_.setFields(region_populations, region_means);
+        
+        belief_kernels::HybridParams hybridParams;
+        hybridParams.homophilyExponent = TuningConstants::kHomophilyExponent;
+        hybridParams.minWeight = TuningConstants::kHomophilyMinWeight;
+        hybridParams.maxWeight = TuningConstants::kHomophilyMaxWeight;
+        hybridParams.languageBonus = TuningConstants::kLanguageBonusMultiplier;
+        
+        // Offloaded pass: the same rule on the device, which reduces the
+        // regional deltas over this pass's blocks. Shards keep their halo on the CPU.
+        if (offload_ && !shard_) {  // Updates every agent, whatever the activity schedule
+            BeliefOffload::ApplyParams applyParams;
+            applyParams.stepSize = stepSize;
+            applyParams.innovationNoise = TuningConstants::kInnovationNoise;
+            applyParams.neighborWeightMin = TuningConstants::kNeighborWeightMin;
+            applyParams.neighborWeightMax = TuningConstants::kNeighborWeightMax;
+            applyParams.anchoringMaxAge = TuningConstants::kAnchoringMaxAge;
+            applyParams.anchoringBase = TuningConstants::kAnchoringBase;
+            applyParams.anchoringAgeWeight = TuningConstants::kAnchoringAgeWeight;
+            applyParams.anchoringAssertWeight = TuningConstants::kAnchoringAssertWeight;
+            auto& region_deltas = arena_.acquire<std::array<double, 4>>(cfg_.regions);
+            offload_->run(agents_, mean_field_, hybridParams, applyParams, cfg_.seed, generation_,
+                          region_deltas, blocks);
+            if constexpr (kLive) {
+                #pragma omp parallel for schedule(static)
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (alive[i]) live->assignSlot(static_cast<std::uint32_t>(i), B[i]);
+                }
+            }
+            updateRegionalAggregates(region_deltas);
+            if constexpr (kLive) live->commit(agents_);
+            return;
+        }
         
-        // Pre-compute neighbor influences in parallel
-        std::vector<NeighborInfluence> neighbor_influences(agents_.size());
-        const std::size_t n = agents_.size();
+        // Pre-compute neighbor influences in parallel (SIMD row kernel chosen at runtime)
+        auto& neighbor_influences = arena_.acquire<NeighborInfluence>(n);
         
         #pragma omp parallel for schedule(static)
         for (std::size_t i = 0; i < n; ++i) {
-            const Agent& agent = agents_[i];
-            if (!agent.alive) continue;
-            
-            auto& influence = neighbor_influences[i];
+            if (!alive[i]) continue;
+            if constexpr (kActive) {
+                if (!evaluated(i)) continue;
+            }
             
-            for (std::uint32_t n_idx : agent.neighbors) {
-                if (n_idx >= agents_.size()) continue;
-                const Agent& neighbor = agents_[n_idx];
-                if (!neighbor.alive) continue;
-                
-                // EXPONENTIAL HOMOPHILY: Creates strong echo chamber effect
-                // Similar agents influence each other MUCH more than dissimilar ones
-                double dot = 0.0, norm_a = 0.0, norm_n = 0.0;
-                for (int b = 0; b < 4; ++b) {
-                    dot += agent.B[b] * neighbor.B[b];
-                    norm_a += agent.B[b] * agent.B[b];
-                    norm_n += neighbor.B[b] * neighbor.B[b];
+            kernels.hybrid(cols, static_cast<std::uint32_t>(i),
+                           graph.data(static_cast<std::uint32_t>(i)),
+                           graph.degree(static_cast<std::uint32_t>(i)),
+                           hybridParams, neighbor_influences[i]);
+        }
+        // Edges to other shards' agents read the halo copies taken this tick
+        if (shard_) shard_->addHaloInfluence(cols, hybridParams, neighbor_influences);
+        
+        // Apply blended influence with belief innovation
+        const auto& region = agents_.region;
+        const auto& age = agents_.age;
+        const auto& openness = agents_.openness;
+        const auto& conformity = agents_.conformity;
+        const auto& assertiveness = agents_.assertiveness;
+        const auto& m_comm = agents_.m_comm;
+        const auto& m_susceptibility = agents_.m_susceptibility;
+        
+        #pragma omp parallel for schedule(dynamic)
+        for (std::ptrdiff_t blk = 0; blk < static_cast<std::ptrdiff_t>(blocks); ++blk) {
+            const std::size_t end = std::min(n, (static_cast<std::size_t>(blk) + 1) * blockSlots);
+            for (std::size_t i = static_cast<std::size_t>(blk) * blockSlots; i < end; ++i) {
+                if (!alive[i]) continue;
+                std::uint32_t ticks = 1;
+                if constexpr (kActive) {
+                    if (!evaluated(i)) continue;
+                    ticks = activity.elapsed(static_cast<std::uint32_t>(i));
                 }
-                double similarity = (norm_a > 1e-9 && norm_n > 1e-9) ?
-                    dot / (std::sqrt(norm_a) * std::sqrt(norm_n)) : 0.0;
                 
-                // EXPONENTIAL weighting: e^(similarity * kHomophilyExponent)
-                // This creates STRONG echo chambers - similar agents dominate influence
-                double weight = std::exp(similarity * TuningConstants::kHomophilyExponent);
-                weight = std::clamp(weight, TuningConstants::kHomophilyMinWeight, 
-                                   TuningConstants::kHomophilyMaxWeight);
+                // Counter-based RNG: noise depends on (seed, tick, id), not on the thread
+                rng::CounterRng rng(cfg_.seed, generation_, agents_.id[i], rng::Stream::Innovation);
+                std::normal_distribution<double> noise_dist(0.0, TuningConstants::kInnovationNoise);
                 
-                // Language bonus: shared language strengthens influence
-                if (neighbor.primaryLang == agent.primaryLang) {
-                    weight *= TuningConstants::kLanguageBonusMultiplier;
+                // Calculate neighbor weight based on conformity and network size
+                // HIGH neighbor weight = rely on close network (echo chambers)
+                // LOW neighbor weight = follow regional mainstream
+                // Non-conformists form subcultures; conformists follow the crowd
+                double neighbor_weight = TuningConstants::kNeighborWeightMax 
+                                       - conformity[i] * (TuningConstants::kNeighborWeightMax - TuningConstants::kNeighborWeightMin);
+                
+                // Isolated agents (few neighbors) must rely more on regional field
+                if (neighbor_influences[i].neighbor_count < 2) {
+                    neighbor_weight = 0.4;  // Still significant regional influence
                 }
+                neighbor_weight = std::clamp(neighbor_weight, 0.4, 0.9);
+                
+                // Get blended social influence
+                auto social_influence = mean_field_.getBlendedInfluence(
+                    neighbor_influences[i], region[i], neighbor_weight
+                );
+                
+                // BELIEF ANCHORING: Agents resist changing core beliefs
+                // Based on age (older = more set in ways) and assertiveness (confident = resistant)
+                double age_factor = std::min(1.0, age[i] / TuningConstants::kAnchoringMaxAge);
+                double anchoring = TuningConstants::kAnchoringBase 
+                                 + age_factor * TuningConstants::kAnchoringAgeWeight 
+                                 + assertiveness[i] * TuningConstants::kAnchoringAssertWeight;
                 
-                // Accumulate weighted beliefs
+                // Update beliefs toward social influence (with resistance)
+                double adapt_rate = stepSize * m_comm[i] * m_susceptibility[i];
+                adapt_rate *= (0.7 + openness[i] * 0.6);
+                adapt_rate *= (1.0 - anchoring * 0.5);  // Anchoring reduces adaptation
+                
+                auto& Bi = B[i];
+                auto& Xi = X[i];
+                // Catch-up over `ticks`: the pull relaxes the gap to the
+                // (held) social target like x -> x + r (s - x), so it moves
+                // (1 - (1 - r)^k) / r single pulls, and the innovation keeps the
+                // variance of k draws decaying at the same rate
+                double pull_ticks = 1.0;
+                double noise_ticks = 1.0;
+                if constexpr (kActive) {
+                    const auto slot = static_cast<std::uint32_t>(i);
+                    const bool due = activity.due(slot);
+                    // The pull itself is mostly innovation noise reverting; a
+                    // settled agent is one whose target stands still
+                    const double shift = activity_.targetShift(slot, social_influence, due);
+                    if (!due) {
+                        skipped_drift[blk][0] += shift;
+                        skipped_drift[blk][1] += 1.0;
+                        continue;
+                    }
+                    activity_.noteChange(slot, shift);
+                    if (ticks > 1) {
+                        const double keep = 1.0 - std::clamp(adapt_rate, 1e-9, 1.0);
+                        pull_ticks = (1.0 - std::pow(keep, ticks)) / (1.0 - keep);
+                        noise_ticks = std::sqrt((1.0 - std::pow(keep, 2.0 * ticks)) / (1.0 - keep * keep));
+                    }
+                }
+                const std::array<double, 4> before = Bi;
                 for (int b = 0; b < 4; ++b) {
-                    influence.belief_sum[b] += neighbor.B[b] * weight;
+                    // Social influence pull (reduced)
+                    double delta = adapt_rate * fastTanh(social_influence[b] - Bi[b]);
+                
+                    // BELIEF INNOVATION: Random drift creates variation
+                    // Young and open agents innovate more
+                    double innovation = noise_dist(rng) * (1.5 - age_factor) * (0.5 + openness[i]);
+                
+                    if constexpr (kActive) {
+                        Xi[b] += delta * pull_ticks + innovation * noise_ticks;
+                    } else {
+                        Xi[b] += delta + innovation;
+                    }
+                    Bi[b] = fastTanh(Xi[b]);
                 }
-                influence.total_weight += weight;
-                influence.neighbor_count++;
-            }
-        }
-        
-        // Apply blended influence with belief innovation
-        const double stepSize = cfg_.stepSize;
-        
-        #pragma omp parallel for schedule(dynamic)
-        for (std::size_t i = 0; i < n; ++i) {
-            auto& agent = agents_[i];
-            if (!agent.alive) continue;
-            
-            // Thread-local RNG for innovation noise
-            auto& rng = getThreadLocalRNG();
-            std::normal_distribution<double> noise_dist(0.0, TuningConstants::kInnovationNoise);
-            
-            // Calculate neighbor weight based on conformity and network size
-            // HIGH neighbor weight = rely on close network (echo chambers)
-            // LOW neighbor weight = follow regional mainstream
-            // Non-conformists form subcultures; conformists follow the crowd
-            double neighbor_weight = TuningConstants::kNeighborWeightMax 
-                                   - agent.conformity * (TuningConstants::kNeighborWeightMax - TuningConstants::kNeighborWeightMin);
-            
-            // Isolated agents (few neighbors) must rely more on regional field
-            if (neighbor_influences[i].neighbor_count < 2) {
-                neighbor_weight = 0.4;  // Still significant regional influence
-            }
-            neighbor_weight = std::clamp(neighbor_weight, 0.4, 0.9);
-            
-            // Get blended social influence
-            auto social_influence = mean_field_.getBlendedInfluence(
-                neighbor_influences[i], agent.region, neighbor_weight
-            );
-            
-            // BELIEF ANCHORING: Agents resist changing core beliefs
-            // Based on age (older = more set in ways) and assertiveness (confident = resistant)
-            double age_factor = std::min(1.0, agent.age / TuningConstants::kAnchoringMaxAge);
-            double anchoring = TuningConstants::kAnchoringBase 
-                             + age_factor * TuningConstants::kAnchoringAgeWeight 
-                             + agent.assertiveness * TuningConstants::kAnchoringAssertWeight;
-            
-            // Update beliefs toward social influence (with resistance)
-            double adapt_rate = stepSize * agent.m_comm * agent.m_susceptibility;
-            adapt_rate *= (0.7 + agent.openness * 0.6);
-            adapt_rate *= (1.0 - anchoring * 0.5);  // Anchoring reduces adaptation
-            
-            for (int b = 0; b < 4; ++b) {
-                // Social influence pull (reduced)
-                double delta = adapt_rate * fastTanh(social_influence[b] - agent.B[b]);
                 
-                // BELIEF INNOVATION: Random drift creates variation
-                // Young and open agents innovate more
-                double innovation = noise_dist(rng) * (1.5 - age_factor) * (0.5 + agent.openness);
+                // Update cached norm
+                B_norm_sq[i] = precision::normSq(Bi);
+                if constexpr (kLive) live->assignSlot(static_cast<std::uint32_t>(i), Bi);
+                addBeliefDelta(belief_deltas_.row(static_cast<std::size_t>(blk), region[i]), before, Bi);
                 
-                agent.x[b] += delta + innovation;
-                agent.B[b] = fastTanh(agent.x[b]);
+                // Validate beliefs (debug builds only)
+                validation::checkBeliefs(Bi.data(), 4, "updateBeliefs (hybrid)");
+                validation::checkNonNegative(B_norm_sq[i], "B_norm_sq");
             }
-            
-            // Update cached norm
-            agent.B_norm_sq = agent.B[0] * agent.B[0] +
-                             agent.B[1] * agent.B[1] +
-                             agent.B[2] * agent.B[2] +
-                             agent.B[3] * agent.B[3];
-            
-            // Validate beliefs (debug builds only)
-            validation::checkBeliefs(agent.B.data(), 4, "updateBeliefs (hybrid)");
-            validation::checkNonNegative(agent.B_norm_sq, "B_norm_sq");
         }
+        updateRegionalAggregates(belief_deltas_);
     } else {
         // **ORIGINAL PAIRWISE UPDATES**: O(N·k) complexity
         // Compute deltas in parallel-friendly way
-        std::vector<std::array<double, 4>> dx(agents_.size());
-        
-        const std::size_t n = agents_.size();
-        const double stepSize = cfg_.stepSize;
+        auto& dx = arena_.acquire<std::array<double, 4>>(n);
+        const auto& m_susceptibility = agents_.m_susceptibility;
+        belief_kernels::PairwiseParams pairwiseParams;
+        pairwiseParams.stepSize = stepSize;
+        pairwiseParams.simFloor = cfg_.simFloor;
         
         #pragma omp parallel for schedule(dynamic)
         for (std::size_t i = 0; i < n; ++i) {
-            const auto& ai = agents_[i];
-            if (!ai.alive) continue;  // Skip dead agents
+            if (!alive[i]) continue;  // Skip dead agents
+            if constexpr (kActive) {
+                if (!evaluated(i)) continue;
+            }
             
             std::array<double, 4> acc{0, 0, 0, 0};
-            
-            // Cache agent properties used in inner loop
-            const double ai_susceptibility = ai.m_susceptibility;
-            const double ai_comm = ai.m_comm;
-            
-            for (auto jid : ai.neighbors) {
-                if (jid >= agents_.size()) continue;  // Safety check
-                const auto& aj = agents_[jid];
-                if (!aj.alive) continue;  // Skip dead neighbors
-                
-                double s = similarityGate(ai, aj);
-                double lq = languageQuality(ai, aj);
-                double comm = 0.5 * (ai_comm + aj.m_comm);
-                double weight = stepSize * s * lq * comm * ai_susceptibility;
+            kernels.pairwise(cols, static_cast<std::uint32_t>(i), m_susceptibility[i],
+                             graph.data(static_cast<std::uint32_t>(i)),
+                             graph.degree(static_cast<std::uint32_t>(i)),
+                             pairwiseParams, acc);
                 
-                // Unroll belief dimension loop for better performance
-                acc[0] += weight * fastTanh(aj.B[0] - ai.B[0]);
-                acc[1] += weight * fastTanh(aj.B[1] - ai.B[1]);
-                acc[2] += weight * fastTanh(aj.B[2] - ai.B[2]);
-                acc[3] += weight * fastTanh(aj.B[3] - ai.B[3]);
-            }
-            
             dx[i] = acc;
         }
+        if (shard_) shard_->addHaloInfluence(cols, pairwiseParams, m_susceptibility, dx);
         
         // Apply updates
-        #pragma omp parallel for
-        for (std::size_t i = 0; i < n; ++i) {
-            if (!agents_[i].alive) continue;  // Skip dead agents
-            
-            agents_[i].x[0] += dx[i][0];
-            agents_[i].x[1] += dx[i][1];
-            agents_[i].x[2] += dx[i][2];
-            agents_[i].x[3] += dx[i][3];
-            
-            agents_[i].B[0] = fastTanh(agents_[i].x[0]);
-            agents_[i].B[1] = fastTanh(agents_[i].x[1]);
-            agents_[i].B[2] = fastTanh(agents_[i].x[2]);
-            agents_[i].B[3] = fastTanh(agents_[i].x[3]);
-
-            // Update cached norm
-            agents_[i].B_norm_sq = agents_[i].B[0] * agents_[i].B[0] +
-                                   agents_[i].B[1] * agents_[i].B[1] +
-                                   agents_[i].B[2] * agents_[i].B[2] +
-                                   agents_[i].B[3] * agents_[i].B[3];
-            
-            // Validate beliefs (debug builds only)
-            validation::checkBeliefs(agents_[i].B.data(), 4, "updateBeliefs (pairwise)");
-            validation::checkNonNegative(agents_[i].B_norm_sq, "B_norm_sq");
+        #pragma omp parallel for schedule(static)
+        for (std::ptrdiff_t blk = 0; blk < static_cast<std::ptrdiff_t>(blocks); ++blk) {
+            const std::size_t end = std::min(n, (static_cast<std::size_t>(blk) + 1) * blockSlots);
+            for (std::size_t i = static_cast<std::size_t>(blk) * blockSlots; i < end; ++i) {
+                if (!alive[i]) continue;  // Skip dead agents
+                
+                if constexpr (kActive) {
+                    if (!evaluated(i)) continue;
+                    const double drift = std::max(std::max(std::abs(dx[i][0]), std::abs(dx[i][1])),
+                                                  std::max(std::abs(dx[i][2]), std::abs(dx[i][3])));
+                    if (!activity.due(static_cast<std::uint32_t>(i))) {
+                        skipped_drift[blk][0] += drift;
+                        skipped_drift[blk][1] += 1.0;
+                        continue;
+                    }
+                    activity_.noteChange(static_cast<std::uint32_t>(i), drift);
+                    const double ticks = activity.elapsed(static_cast<std::uint32_t>(i));
+                    for (auto& d : dx[i]) d *= ticks;  // Catch-up: this tick's pull for every skipped tick
+                }
+                
+                auto& Bi = B[i];
+                auto& Xi = X[i];
+                const std::array<double, 4> before = Bi;
+                Xi[0] += dx[i][0];
+                Xi[1] += dx[i][1];
+                Xi[2] += dx[i][2];
+                Xi[3] += dx[i][3];
+                
+                Bi[0] = fastTanh(Xi[0]);
+                Bi[1] = fastTanh(Xi[1]);
+                Bi[2] = fastTanh(Xi[2]);
+                Bi[3] = fastTanh(Xi[3]);
+
+                // Update cached norm
+                B_norm_sq[i] = precision::normSq(Bi);
+                if constexpr (kLive) live->assignSlot(static_cast<std::uint32_t>(i), Bi);
+                addBeliefDelta(belief_deltas_.row(static_cast<std::size_t>(blk), agents_.region[i]), before, Bi);
+                
+                // Validate beliefs (debug builds only)
+                validation::checkBeliefs(Bi.data(), 4, "updateBeliefs (pairwise)");
+                validation::checkNonNegative(B_norm_sq[i], "B_norm_sq");
+            }
+        }
+        updateRegionalAggregates(belief_deltas_);
+    }
+    
+    if constexpr (kActive) {
+        for (const auto& block : skipped_drift) {
+            activity_.noteSkippedDrift(block[0], static_cast<std::uint64_t>(block[1]));
         }
     }
+    if constexpr (kLive) live->commit(agents_);
 }
 
 void Kernel::step() {
-    updateBeliefs();
+    CIV_PROFILE_SCOPE(profiler::Phase::Tick);
+    CIV_PROFILE_TOUCH(agents_.size());
+    arena_.reset();  // Per-tick scratch buffers are reused, not reallocated
+    ++state_version_;  // Invalidates memoized metrics
+    
+    // Sharded: mirror remote neighbours' beliefs before anyone reads them
+    if (shard_) shard_->exchangeHalo();
+    
+    // Activity scheduling: one due set for the belief pass and the agent stages
+    if (activity_.enabled()) activity_.plan(agents_.size(), generation_, agents_.alive.data());
+    
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::Beliefs);
+        CIV_PROFILE_TOUCH(agents_.size());
+        updateBeliefs();
+    }
     ++generation_;
     
+    // Amortized drift correction for the live culture index
+    if (live_clusters_ && generation_ % cfg_.liveClusterReassignTicks == 0) {
+        CIV_PROFILE_SCOPE(profiler::Phase::Cultures);
+        CIV_PROFILE_TOUCH(agents_.size());
+        live_clusters_->fullReassignment(agents_);
+    }
+    
     // Demographic step (if enabled)
     if (cfg_.demographyEnabled) {
-        stepDemography();
+        {
+            CIV_PROFILE_SCOPE(profiler::Phase::Demography);
+            CIV_PROFILE_TOUCH(agents_.size());
+            stepDemography();
+            if (!background_.cohorts().empty()) {
+                if (generation_ % cfg_.ticksPerYear == 0) {
+                    calibrateCohorts(background_, background_scale_);
+                }
+                background_.updateDemographics(generation_, cfg_.ticksPerYear);
+            }
+        }
         
         // Migration step (every 10 ticks to reduce overhead)
         if (generation_ % 10 == 0) {
-            stepMigration();
+            {
+                CIV_PROFILE_SCOPE(profiler::Phase::Migration);
+                CIV_PROFILE_TOUCH(agents_.size());
+                stepMigration();
+            }
+            if (shard_) shard_->exchangeMigrants();  // Hand movers to their regions' shards
             reconnectIsolatedAgents();  // Rebuild networks for migrants
         }
     }
     
     // Language dynamics (generational timescale - every 50 ticks)
     if (generation_ % 50 == 0) {
+        CIV_PROFILE_SCOPE(profiler::Phase::Language);
+        CIV_PROFILE_TOUCH(agents_.size());
         updateLanguageDynamics();
     }
     
+    // FUSED PER-AGENT PASS: economic feedback (economy ticks only), health and
+    // psychology each touch only their own agent, so they share one parallel sweep
+    scheduler_.clear();
+    
     // Update economy every 10 ticks (reduce overhead)
     if (generation_ % 10 == 0) {
-        // Use incrementally maintained aggregates instead of full O(N) scan
-        // Periodically rebuild to correct any drift (every 100 ticks)
-        if (generation_ % 100 == 0) {
-            rebuildRegionalAggregates();
-        }
-        
-        // Build population counts and belief centroids from cached aggregates
-        std::vector<std::uint32_t> region_populations(cfg_.regions);
-        std::vector<std::array<double, 4>> region_belief_centroids(cfg_.regions);
-        
-        for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
-            region_populations[r] = regional_aggregates_[r].population;
-            if (regional_aggregates_[r].population > 0) {
-                const double inv_pop = 1.0 / regional_aggregates_[r].population;
-                region_belief_centroids[r][0] = regional_aggregates_[r].belief_sum[0] * inv_pop;
-                region_belief_centroids[r][1] = regional_aggregates_[r].belief_sum[1] * inv_pop;
-                region_belief_centroids[r][2] = regional_aggregates_[r].belief_sum[2] * inv_pop;
-                region_belief_centroids[r][3] = regional_aggregates_[r].belief_sum[3] * inv_pop;
-            } else {
-                region_belief_centroids[r] = {0.0, 0.0, 0.0, 0.0};
-            }
-        }
-        
-        economy_.update(region_populations, region_belief_centroids, agents_, generation_, &regionIndex_);
-        
-        // Apply economic feedback to agent beliefs and susceptibility
-        for (auto& agent : agents_) {
-            if (!agent.alive) continue;  // Skip dead agents
-            
-            // Validate region index
-            validation::checkIndex(agent.region, cfg_.regions, "agent.region in step()");
-            
-            const auto& regional_econ = economy_.getRegion(agent.region);
-            const auto& agent_econ = economy_.getAgentEconomy(agent.id);
-            
-            // Hardship increases susceptibility to radical beliefs
-            agent.m_susceptibility = 0.7 + 0.6 * (agent.openness - 0.5);
-            agent.m_susceptibility *= (1.0 + regional_econ.hardship);
-            agent.m_susceptibility = std::clamp(agent.m_susceptibility, 0.4, 2.0);
-            
-            // EMERGENT BELIEF EVOLUTION: Economic experience MAY influence beliefs
-            // but the direction depends on personality, not predetermined mappings
-            
-            // Base pressure is very small - beliefs change slowly
-            double base_pressure = TuningConstants::kBasePressureMultiplier * 0.01;  // ~0.0005
-            
-            // Openness determines how much economic experience affects beliefs
-            double experience_weight = agent.openness * base_pressure;
-            
-            // Personal hardship creates pressure for SOME change, direction varies by personality
-            if (agent_econ.hardship > TuningConstants::kHardshipThreshold) {
-                double hardship_pressure = experience_weight * agent_econ.hardship;
-                
-                // High conformity → blame self/accept system, low conformity → blame system
-                if (agent.conformity < 0.4) {
-                    // Non-conformist: hardship → question authority/hierarchy
-                    agent.B[0] -= hardship_pressure * (0.5 - agent.conformity);
-                    agent.B[2] -= hardship_pressure * (0.5 - agent.conformity);
-                } else if (agent.conformity > 0.6) {
-                    // Conformist: hardship → support stronger authority for stability
-                    agent.B[0] += hardship_pressure * (agent.conformity - 0.5);
-                }
-                // Middle conformity: no systematic shift
+        scheduler_.addRegionStage("economy.update", [this] {
+            CIV_PROFILE_SCOPE(profiler::Phase::EconomyUpdate);
+            CIV_PROFILE_TOUCH(agents_.size());
+            // Aggregates track births, deaths, migration and every belief change;
+            // the 100-tick rebuild only absorbs round-off and edits made through agentsMut()
+            if (generation_ % 100 == 0) {
+                rebuildRegionalAggregates();
             }
+            // Sharded: other shards' regions take their owners' current totals
+            if (shard_) shard_->reduceRegions();
             
-            // Wealth influences beliefs ONLY through lived experience, modulated by traits
-            double relative_wealth = agent_econ.wealth / std::max(0.5, regional_econ.welfare);
-            if (relative_wealth > 2.0 && agent.openness < 0.5) {
-                // Wealthy + low openness → rationalize current system (slight hierarchy support)
-                agent.B[2] += experience_weight * 0.3;
-            } else if (relative_wealth < 0.5 && agent.assertiveness > 0.6) {
-                // Poor + assertive → demand change (slight equality push)
-                agent.B[2] -= experience_weight * 0.3;
-            }
-            // NOTE: Most agents (moderate traits) have no systematic wealth→belief pressure
+            // Build population counts and belief centroids from cached aggregates
+            auto& region_populations = arena_.acquire<std::uint32_t>(cfg_.regions);
+            auto& region_belief_centroids = arena_.acquire<std::array<double, 4>>(cfg_.regions);
+            regionalCentroids(region_populations, region_belief_centroids);
             
-            // Regional conditions create shared experiences, but response varies
-            if (regional_econ.welfare < TuningConstants::kWelfareThreshold && agent.openness > 0.6) {
-                // Low welfare + high openness → open to change (progress over tradition)
-                agent.B[1] -= experience_weight * (TuningConstants::kWelfareThreshold - regional_econ.welfare);
+            auto& hardship_before = arena_.acquire<double>(activity_.enabled() ? cfg_.regions : 0);
+            auto& system_before = arena_.acquire<EconomicSystem>(hardship_before.size());
+            for (std::size_t r = 0; r < hardship_before.size(); ++r) {
+                hardship_before[r] = economy_.getRegion(static_cast<std::uint32_t>(r)).hardship;
+                system_before[r] = economy_.getRegion(static_cast<std::uint32_t>(r)).economic_system;
             }
-            
-            // NOTE ON BELIEF FORCING:
-            // Economic EXPERIENCES (hardship, relative wealth, welfare) DO influence beliefs above,
-            // but the influence is PERSONALITY-MODULATED, not deterministic:
-            // - Conformity determines direction of hardship response (accept vs. reject authority)
-            // - Openness determines magnitude of all experience effects
-            // - Assertiveness determines wealth-inequality response
-            // The economic SYSTEM LABEL (market/planned/etc.) does NOT force beliefs.
-            // Systems emerge FROM beliefs; beliefs shift from lived experiences + social influence.
-            
-            // Keep beliefs in [-1, 1] range
-            for (int d = 0; d < 4; ++d) {
-                agent.B[d] = std::clamp(agent.B[d], -1.0, 1.0);
+            economy_.update(region_populations, region_belief_centroids, agents_, generation_, &regionIndex_);
+            if (shard_) shard_->syncRegionEconomy();  // Owners' regional results replace local guesses
+            demography_rates_stale_ = true;
+            if (activity_.enabled()) wakeShockedRegions(hardship_before, system_before);
+        });
+        
+        // Apply economic feedback to agent beliefs and susceptibility
+        TickScheduler::AgentStage feedback;
+        feedback.name = "economy.feedback";
+        feedback.update = [this](std::uint32_t slot, double* acc) { applyEconomicFeedback(slot, acc); };
+        feedback.reduceWidth = 4;  // Belief deltas per region
+        feedback.finalize = [this](const TickScheduler::RegionSums& sums) {
+            for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+                for (int d = 0; d < 4; ++d) {
+                    regional_aggregates_[r].belief_sum[d] += sums(r, d);
+                }
             }
+        };
+        scheduler_.addAgentStage(std::move(feedback));
+    }
+    
+    // Update health and psychology every tick using latest economic signals
+    // (quiescent agents only on their catch-up ticks)
+    ActivitySet* activity = activity_.enabled() ? &activity_ : nullptr;
+    if (activity) activity->resize(agents_.size());  // Agents that arrived this tick are due
+    health_.registerStages(scheduler_, agents_, economy_, generation_, activity);
+    psychology_.registerStages(scheduler_, agents_, economy_, generation_, activity);
+    scheduler_.run(agents_.region, cfg_.regions, arena_);
+    if (activity) activity->commit(agents_.graph);
+    
+    // Amortized locality pass: re-gather slots scattered by births and migration
+    if (cfg_.reorderTicks > 0 && generation_ % cfg_.reorderTicks == 0) {
+        reorderAgents();
+    }
+    
+    // Hold the budget; without one, only sample the high-water marks now and then
+    if (cfg_.memoryBudget > 0) {
+        const auto usage = memoryUsage();
+        if (usage.reserved > cfg_.memoryBudget) enforceMemoryBudget(usage.used);
+    } else if (generation_ % kMemorySampleTicks == 0) {
+        memoryUsage();
+    }
+}
+
+void Kernel::applyEconomicFeedback(std::uint32_t slot, double* acc) {
+    auto agent = agents_[slot];
+    if (!agent.alive) return;  // Skip dead agents
+    const std::array<double, 4> before = agent.B;
+    
+    // Validate region index
+    validation::checkIndex(agent.region, cfg_.regions, "agent.region in economic feedback");
+    
+    const auto& regional_econ = economy_.getRegion(agent.region);
+    const auto& agent_econ = economy_.getAgentEconomy(slot);
+    
+    // Hardship increases susceptibility to radical beliefs
+    agent.m_susceptibility = 0.7 + 0.6 * (agent.openness - 0.5);
+    agent.m_susceptibility *= (1.0 + regional_econ.hardship);
+    agent.m_susceptibility = std::clamp(agent.m_susceptibility, 0.4, 2.0);
+    
+    // EMERGENT BELIEF EVOLUTION: Economic experience MAY influence beliefs
+    // but the direction depends on personality, not predetermined mappings
+    
+    // Base pressure is very small - beliefs change slowly
+    double base_pressure = TuningConstants::kBasePressureMultiplier * 0.01;  // ~0.0005
+    
+    // Openness determines how much economic experience affects beliefs
+    double experience_weight = agent.openness * base_pressure;
+    
+    // Personal hardship creates pressure for SOME change, direction varies by personality
+    if (agent_econ.hardship > TuningConstants::kHardshipThreshold) {
+        double hardship_pressure = experience_weight * agent_econ.hardship;
+        
+        // High conformity → blame self/accept system, low conformity → blame system
+        if (agent.conformity < 0.4) {
+            // Non-conformist: hardship → question authority/hierarchy
+            agent.B[0] -= hardship_pressure * (0.5 - agent.conformity);
+            agent.B[2] -= hardship_pressure * (0.5 - agent.conformity);
+        } else if (agent.conformity > 0.6) {
+            // Conformist: hardship → support stronger authority for stability
+            agent.B[0] += hardship_pressure * (agent.conformity - 0.5);
         }
+        // Middle conformity: no systematic shift
+    }
+    
+    // Wealth influences beliefs ONLY through lived experience, modulated by traits
+    double relative_wealth = agent_econ.wealth / std::max(0.5, regional_econ.welfare);
+    if (relative_wealth > 2.0 && agent.openness < 0.5) {
+        // Wealthy + low openness → rationalize current system (slight hierarchy support)
+        agent.B[2] += experience_weight * 0.3;
+    } else if (relative_wealth < 0.5 && agent.assertiveness > 0.6) {
+        // Poor + assertive → demand change (slight equality push)
+        agent.B[2] -= experience_weight * 0.3;
+    }
+    // NOTE: Most agents (moderate traits) have no systematic wealth→belief pressure
+    
+    // Regional conditions create shared experiences, but response varies
+    if (regional_econ.welfare < TuningConstants::kWelfareThreshold && agent.openness > 0.6) {
+        // Low welfare + high openness → open to change (progress over tradition)
+        agent.B[1] -= experience_weight * (TuningConstants::kWelfareThreshold - regional_econ.welfare);
+    }
+    
+    // NOTE ON BELIEF FORCING:
+    // Economic EXPERIENCES (hardship, relative wealth, welfare) DO influence beliefs above,
+    // but the influence is PERSONALITY-MODULATED, not deterministic:
+    // - Conformity determines direction of hardship response (accept vs. reject authority)
+    // - Openness determines magnitude of all experience effects
+    // - Assertiveness determines wealth-inequality response
+    // The economic SYSTEM LABEL (market/planned/etc.) does NOT force beliefs.
+    // Systems emerge FROM beliefs; beliefs shift from lived experiences + social influence.
+    
+    // Keep beliefs in [-1, 1] range
+    for (int d = 0; d < 4; ++d) {
+        agent.B[d] = std::clamp<double>(agent.B[d], -1.0, 1.0);
+        acc[d] += agent.B[d] - before[d];
     }
+}
 
-    // Update health and psychology every tick using latest economic signals
-    health_.updateAgents(agents_, economy_, generation_);
-    psychology_.updateAgents(agents_, economy_, generation_);
+void Kernel::regionalCentroids(std::vector<std::uint32_t>& populations,
+                               std::vector<std::array<double, 4>>& centroids) const {
+    populations.resize(cfg_.regions);
+    centroids.resize(cfg_.regions);
+    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+        populations[r] = regional_aggregates_[r].population;
+        if (regional_aggregates_[r].population > 0) {
+            const double inv_pop = 1.0 / regional_aggregates_[r].population;
+            centroids[r][0] = regional_aggregates_[r].belief_sum[0] * inv_pop;
+            centroids[r][1] = regional_aggregates_[r].belief_sum[1] * inv_pop;
+            centroids[r][2] = regional_aggregates_[r].belief_sum[2] * inv_pop;
+            centroids[r][3] = regional_aggregates_[r].belief_sum[3] * inv_pop;
+        } else {
+            centroids[r] = {0.0, 0.0, 0.0, 0.0};
+        }
+    }
 }
 
 void Kernel::stepN(int n) {
@@ -666,75 +1135,43 @@ void Kernel::stepN(int n) {
 }
 
 Kernel::Metrics Kernel::computeMetrics() const {
+    // Memoized: repeated polls between ticks cost nothing
+    if (metrics_version_ == state_version_) return metrics_cache_;
     Metrics m;
     
-    // Compute region centroids
-    std::vector<std::array<double, 4>> centroids(cfg_.regions);
-    std::vector<int> counts(cfg_.regions, 0);
-    
-    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
-        std::array<double, 4> c{0, 0, 0, 0};
-        for (auto id : regionIndex_[r]) {
-            const auto& B = agents_[id].B;
-            c[0] += B[0];
-            c[1] += B[1];
-            c[2] += B[2];
-            c[3] += B[3];
-        }
-        int n = static_cast<int>(regionIndex_[r].size());
-        if (n > 0) {
-            const double inv_n = 1.0 / n;
-            c[0] *= inv_n;
-            c[1] *= inv_n;
-            c[2] *= inv_n;
-            c[3] *= inv_n;
-        }
-        centroids[r] = c;
-        counts[r] = n;
-    }
-    
-    // Pairwise distances between centroids
-    std::vector<double> dists;
-    dists.reserve((cfg_.regions * (cfg_.regions - 1)) / 2);  // Upper bound
-    for (std::uint32_t i = 0; i < cfg_.regions; ++i) {
-        if (counts[i] == 0) continue;
-        for (std::uint32_t j = i + 1; j < cfg_.regions; ++j) {
-            if (counts[j] == 0) continue;
-            // Unroll 4D distance calculation
-            const double d0 = centroids[i][0] - centroids[j][0];
-            const double d1 = centroids[i][1] - centroids[j][1];
-            const double d2 = centroids[i][2] - centroids[j][2];
-            const double d3 = centroids[i][3] - centroids[j][3];
-            dists.push_back(std::sqrt(d0*d0 + d1*d1 + d2*d2 + d3*d3));
-        }
-    }
-    
-    if (!dists.empty()) {
-        const double n = static_cast<double>(dists.size());
-        m.polarizationMean = std::accumulate(dists.begin(), dists.end(), 0.0) / n;
-        double sq = 0.0;
-        for (double v : dists) {
-            const double diff = v - m.polarizationMean;
-            sq += diff * diff;
-        }
-        m.polarizationStd = std::sqrt(sq / n);
-    }
-    
-    // Average traits
-    m.avgOpenness = 0.0;
-    m.avgConformity = 0.0;
-    for (const auto& a : agents_) {
-        m.avgOpenness += a.openness;
-        m.avgConformity += a.conformity;
-    }
-    m.avgOpenness /= agents_.size();
-    m.avgConformity /= agents_.size();
+    // Region centroids straight from the incremental aggregates (O(R))
+    std::vector<std::uint32_t> populations;
+    std::vector<std::array<double, 4>> centroids;
+    regionalCentroids(populations, centroids);
+    measurePolarization(populations, centroids, cfg_, generation_, m);
+    
+    // Average traits over living agents, one parallel pass
+    struct TraitSums {
+        double alive = 0.0, openness = 0.0, conformity = 0.0;
+        void merge(const TraitSums& o) {
+            alive += o.alive;
+            openness += o.openness;
+            conformity += o.conformity;
+        }
+    };
+    const auto traits = reduceSlots<TraitSums>(agents_.size(), [this](std::size_t i, TraitSums& t) {
+        if (!agents_.alive[i]) return;
+        t.alive += 1.0;
+        t.openness += agents_.openness[i];
+        t.conformity += agents_.conformity[i];
+    });
+    if (traits.alive > 0.0) {
+        m.avgOpenness = traits.openness / traits.alive;
+        m.avgConformity = traits.conformity / traits.alive;
+    }
     
     // Economy metrics
     m.globalWelfare = economy_.globalWelfare();
     m.globalInequality = economy_.globalInequality();
     m.globalHardship = economy_.globalHardship();
     
+    metrics_cache_ = m;
+    metrics_version_ = state_version_;
     return m;
 }
 
@@ -794,10 +1231,9 @@ double Kernel::fertilityPerTick(int age) const {
     return 1.0 - std::pow(1.0 - annual, 1.0 / cfg_.ticksPerYear);
 }
 
-// Region and agent-specific fertility rate (modulated by culture, development, and wealth)
-double Kernel::fertilityPerTick(int age, std::uint32_t region_id, const Agent& agent,
-                                const std::array<double, 4>& region_beliefs) const {
-    double base_annual = fertilityRateAnnual(age);
+double Kernel::regionalFertilityAnnual(int age, std::uint32_t region_id,
+                                       const std::array<double, 4>& region_beliefs) const {
+    double base_annual = fertilityBaseAnnual(age, region_id);
     if (base_annual == 0.0) return 0.0;
     
     // Cultural modulation based on regional beliefs
@@ -806,22 +1242,19 @@ double Kernel::fertilityPerTick(int age, std::uint32_t region_id, const Agent& a
     // Clamp tradition effect to prevent extreme multipliers
     double tradition_factor = 1.0 + std::clamp(tradition, -1.0, 1.0) * 0.2;  // ±20% (reduced from ±30%)
     
+    return base_annual * tradition_factor;
+}
+
+// Economy-dependent part of regional fertility (cached in demography_rates_)
+double Kernel::fertilityBaseAnnual(int age, std::uint32_t region_id) const {
+    double base_annual = fertilityRateAnnual(age);
+    if (base_annual == 0.0) return 0.0;
+    
     // Regional development → demographic transition (lower fertility with higher development)
     const auto& regional_econ = economy_.getRegion(region_id);
     // Use smoother transition curve
     double development_factor = 1.0 / (1.0 + regional_econ.development * 0.2);  // Higher development → lower fertility
     
-    // Socioeconomic status: wealthier agents have fewer children (quality-quantity tradeoff)
-    const auto& agent_econ = economy_.getAgentEconomy(agent.id);
-    double wealth_factor = 1.0;
-    if (regional_econ.development > 0.5) {  // Demographic transition only in developed regions
-        // Normalize wealth relative to regional average
-        double avg_wealth = std::max(0.5, regional_econ.welfare);  // Use regional welfare as baseline
-        double relative_wealth = std::clamp(agent_econ.wealth / avg_wealth, 0.3, 3.0);
-        // Smoother wealth effect: sqrt reduces extreme values
-        wealth_factor = std::sqrt(1.5 / relative_wealth);  // Richer → fewer children (but dampened)
-    }
-    
     // Delayed childbearing in high-development regions (shift peak age)
     double age_shift_factor = 1.0;
     if (regional_econ.development > 1.0 && age < 25) {
@@ -829,18 +1262,65 @@ double Kernel::fertilityPerTick(int age, std::uint32_t region_id, const Agent& a
         age_shift_factor = 0.6 + 0.4 * (age / 25.0);  // Less aggressive reduction
     }
     
-    double adjusted_annual = base_annual * tradition_factor * development_factor * 
-                            wealth_factor * age_shift_factor;
-    
-    // BIOLOGICALLY REALISTIC CAP:
-    // Human gestation is ~9 months, so maximum births/year is ~1.1 (twins rare)
-    // But we're modeling probability of conception, not births
-    // Realistic max conception probability for fertile women is ~25% per month during fertile window
-    // Annualized, that's ~0.15-0.20 for peak fertility ages, accounting for infertility, miscarriage, etc.
-    // Cap at 15% annual (0.15) - this is the upper bound of realistic human fertility
-    adjusted_annual = std::clamp(adjusted_annual, 0.0, 0.15);
+    return base_annual * development_factor * age_shift_factor;
+}
+
+void Kernel::rebuildDemographyRates() {
+    // Every age past 85 shares the last mortality band and has no fertility,
+    // so rows stop at max(maxAgeYears, 85) and older ages read the last entry
+    auto& rates = demography_rates_;
+    rates.ages = std::max(cfg_.maxAgeYears, 85) + 1;
+    const std::size_t ages = static_cast<std::size_t>(rates.ages);
+    rates.mortality.resize(cfg_.regions * ages);
+    rates.fertility.resize(cfg_.regions * ages);
+    rates.hardship.resize(cfg_.regions);
+    rates.wealthBaseline.resize(cfg_.regions);
+    
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t r = 0; r < static_cast<std::ptrdiff_t>(cfg_.regions); ++r) {
+        const auto region = static_cast<std::uint32_t>(r);
+        const auto& regional_econ = economy_.getRegion(region);
+        for (int age = 0; age < rates.ages; ++age) {
+            rates.mortality[region * ages + age] = mortalityPerTick(age, region);
+            rates.fertility[region * ages + age] = fertilityBaseAnnual(age, region);
+        }
+        rates.hardship[region] = 0.7 + 0.3 * (1.0 - regional_econ.hardship);
+        rates.wealthBaseline[region] = regional_econ.development > 0.5 ? std::max(0.5, regional_econ.welfare) : 0.0;
+    }
+    demography_rates_stale_ = false;
+}
+
+void Kernel::calibrateCohorts(CohortDemographics& cohorts, double capacityScale) const {
+    // Group means of the per-agent curves, so cohorts and agents share one
+    // demography; only the per-agent wealth factor on fertility is dropped
+    std::vector<std::uint32_t> agentPopulations;
+    std::vector<std::array<double, 4>> centroids;
+    regionalCentroids(agentPopulations, centroids);
+    const auto populations = cohorts.regionPopulations();
+    const double capacity = cfg_.regionCapacity * capacityScale;
     
-    return 1.0 - std::pow(1.0 - adjusted_annual, 1.0 / cfg_.ticksPerYear);
+    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+        const auto& regional_econ = economy_.getRegion(r);
+        double modifier = 0.7 + 0.3 * (1.0 - regional_econ.hardship);
+        const double pressure = static_cast<double>(populations[r]) / capacity;
+        if (pressure > 1.0) modifier /= pressure;
+        
+        CohortDemographics::RateTable mortality{};
+        CohortDemographics::RateTable fertility{};
+        for (int g = 0; g < 18; ++g) {
+            const int youngest = 5 * g;
+            const int oldest = g == 17 ? std::max(youngest, cfg_.maxAgeYears) : youngest + 4;
+            for (int age = youngest; age <= oldest; ++age) {
+                mortality[g] += mortalityPerTick(age, r);
+                const double annual = std::clamp(regionalFertilityAnnual(age, r, centroids[r]), 0.0, 0.15);
+                fertility[g] += 1.0 - std::pow(1.0 - annual, 1.0 / cfg_.ticksPerYear);
+            }
+            const double span = static_cast<double>(oldest - youngest + 1);
+            mortality[g] /= span;
+            fertility[g] = fertility[g] / span * modifier;
+        }
+        cohorts.setRegionRates(r, mortality, fertility);
+    }
 }
 
 void Kernel::stepDemography() {
@@ -848,142 +1328,217 @@ void Kernel::stepDemography() {
     bool ageIncrement = (generation_ % cfg_.ticksPerYear == 0);
     
     // Use cached regional aggregates for belief centroids
-    std::vector<std::array<double, 4>> region_belief_centroids(cfg_.regions);
-    std::vector<std::uint32_t> region_populations(cfg_.regions);
+    auto& region_belief_centroids = arena_.acquire<std::array<double, 4>>(cfg_.regions);
+    auto& region_populations = arena_.acquire<std::uint32_t>(cfg_.regions);
+    regionalCentroids(region_populations, region_belief_centroids);
+    
+    // PARALLEL DEMOGRAPHY:
+    // Phase 1 walks fixed-size slot chunks in parallel; each chunk records its own
+    // deaths and births. Chunks are merged in slot order and every draw comes from
+    // the agent's counter-based stream, so the outcome is independent of threads.
+    // Phase 2 applies deaths in one batch; phase 3 builds all children in parallel
+    // and appends them in bulk.
+    struct ChunkOutcome {
+        std::vector<std::uint32_t> deaths;  // Slots
+        std::vector<std::uint32_t> births;  // Mother slots
+    };
     
+    const std::size_t n = agents_.size();
+    const std::size_t chunkSize = TuningConstants::kDemographyChunkSize;
+    const std::size_t numChunks = (n + chunkSize - 1) / chunkSize;
+    std::vector<ChunkOutcome> chunks(numChunks);
+    
+    auto& alive = agents_.alive;
+    auto& age = agents_.age;
+    const auto& region = agents_.region;
+    const auto& female = agents_.female;
+    const auto& id = agents_.id;
+    
+    // Region x age bases from the last economy update; what changes every tick
+    // (tradition from the live centroids, crowding) is folded per region here,
+    // so the agent loop only adds the wealth factor
+    if (demography_rates_stale_) rebuildDemographyRates();
+    const auto& rates = demography_rates_;
+    auto& tradition = arena_.acquire<double>(cfg_.regions);
+    auto& crowding = arena_.acquire<double>(cfg_.regions);
     for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
-        region_populations[r] = regional_aggregates_[r].population;
-        if (regional_aggregates_[r].population > 0) {
-            const double inv_pop = 1.0 / regional_aggregates_[r].population;
-            region_belief_centroids[r][0] = regional_aggregates_[r].belief_sum[0] * inv_pop;
-            region_belief_centroids[r][1] = regional_aggregates_[r].belief_sum[1] * inv_pop;
-            region_belief_centroids[r][2] = regional_aggregates_[r].belief_sum[2] * inv_pop;
-            region_belief_centroids[r][3] = regional_aggregates_[r].belief_sum[3] * inv_pop;
-        } else {
-            region_belief_centroids[r] = {0.0, 0.0, 0.0, 0.0};
-        }
+        tradition[r] = 1.0 + std::clamp(region_belief_centroids[r][1], -1.0, 1.0) * 0.2;
+        const double regionPop = static_cast<double>(region_populations[r]);
+        crowding[r] = regionPop > cfg_.regionCapacity ? regionPop / cfg_.regionCapacity : 1.0;
     }
+    const double perTick = 1.0 / cfg_.ticksPerYear;
     
-    std::vector<std::uint32_t> newBirths;
-    std::vector<std::uint32_t> deaths;  // Track deaths for incremental aggregate updates
-    std::uniform_real_distribution<double> uniform_01(0.0, 1.0);
-    int death_count = 0;
-    int birth_count = 0;
-    
-    // Process deaths and births
-    for (auto& agent : agents_) {
-        if (!agent.alive) continue;
-        
-        // Age increment
-        if (ageIncrement) {
-            agent.age++;
-            // Hard cap on age
-            if (agent.age > cfg_.maxAgeYears) {
-                deaths.push_back(agent.id);
-                agent.alive = false;
-                event_log_.logDeath(generation_, agent.id, agent.region, agent.age);
-                death_count++;
-                continue;
-            }
-        }
-        
-        // Mortality (region-specific) - use uniform distribution for reliability
-        double pDeath = mortalityPerTick(agent.age, agent.region);
-        if (uniform_01(rng_) < pDeath) {
-            deaths.push_back(agent.id);
-            agent.alive = false;
-            event_log_.logDeath(generation_, agent.id, agent.region, agent.age);
-            death_count++;
-            continue;
-        }
+    #pragma omp parallel for schedule(dynamic)
+    for (std::ptrdiff_t c = 0; c < static_cast<std::ptrdiff_t>(numChunks); ++c) {
+        auto& out = chunks[c];
+        const std::size_t begin = static_cast<std::size_t>(c) * chunkSize;
+        const std::size_t end = std::min(n, begin + chunkSize);
         
-        // Fertility (only for alive females)
-        if (agent.female && agent.alive) {
-            // Use region and agent-specific fertility rate (includes cultural, development, and wealth factors)
-            double pBirth = fertilityPerTick(agent.age, agent.region, agent, 
-                                            region_belief_centroids[agent.region]);
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!alive[i]) continue;
+            const auto slot = static_cast<std::uint32_t>(i);
             
-            // Additional modulation by hardship and carrying capacity
-            const auto& regional_econ = economy_.getRegion(agent.region);
-            double hardship = regional_econ.hardship;
+            // Age increment
+            if (ageIncrement) {
+                age[i]++;
+                // Hard cap on age
+                if (age[i] > cfg_.maxAgeYears) {
+                    alive[i] = 0;
+                    out.deaths.push_back(slot);
+                    continue;
+                }
+            }
+            
+            // Mortality (region-specific) - use uniform distribution for reliability
+            const std::uint32_t r = region[i];
+            const std::size_t row = static_cast<std::size_t>(r) * static_cast<std::size_t>(rates.ages) +
+                                    static_cast<std::size_t>(std::clamp(age[i], 0, rates.ages - 1));
+            double pDeath = rates.mortality[row];
+            rng::CounterRng deathRng(cfg_.seed, generation_, id[i], rng::Stream::Mortality);
+            if (deathRng.uniform() < pDeath) {
+                alive[i] = 0;
+                out.deaths.push_back(slot);
+                continue;
+            }
             
-            // Reduce fertility under extreme hardship
-            pBirth *= (0.7 + 0.3 * (1.0 - hardship));
+            // Fertility (only for alive females of fertile age)
+            if (!female[i] || rates.fertility[row] == 0.0) continue;
             
-            // Carrying capacity pressure
-            double regionPop = static_cast<double>(region_populations[agent.region]);
-            double capacity = cfg_.regionCapacity;
-            if (regionPop > capacity) {
-                double pressure = regionPop / capacity;
-                pBirth /= pressure;  // Reduce fertility in overpopulated regions
+            // Regional fertility (culture, development), then socioeconomic status:
+            // wealthier agents have fewer children (quality-quantity tradeoff), but
+            // only in regions past the demographic transition
+            double annual = rates.fertility[row] * tradition[r];
+            if (rates.wealthBaseline[r] > 0.0) {
+                const double relative_wealth =
+                    std::clamp(economy_.getAgentEconomy(slot).wealth / rates.wealthBaseline[r], 0.3, 3.0);
+                annual *= std::sqrt(1.5 / relative_wealth);  // Richer → fewer children (but dampened)
             }
+            // Cap at 15% annual conception probability, the upper bound of realistic
+            // human fertility (gestation, infertility and miscarriage included)
+            double pBirth = 1.0 - std::pow(1.0 - std::clamp(annual, 0.0, 0.15), perTick);
             
-            if (uniform_01(rng_) < pBirth) {
-                newBirths.push_back(agent.id);
-                birth_count++;
+            // Reduce fertility under extreme hardship, then in overpopulated regions
+            pBirth *= rates.hardship[r];
+            pBirth /= crowding[r];
+            
+            rng::CounterRng birthRng(cfg_.seed, generation_, id[i], rng::Stream::Fertility);
+            if (birthRng.uniform() < pBirth) {
+                out.births.push_back(slot);
             }
         }
     }
     
-    // Update regional aggregates for deaths
-    for (auto agent_id : deaths) {
-        onAgentDied(agent_id);
+    // Deterministic merge (chunk order == slot order)
+    std::size_t totalDeaths = 0;
+    std::size_t totalBirths = 0;
+    for (const auto& chunk : chunks) {
+        totalDeaths += chunk.deaths.size();
+        totalBirths += chunk.births.size();
     }
-    
-    // Create children (onAgentBorn called inside createChild)
-    for (auto motherId : newBirths) {
-        createChild(motherId);
+    std::vector<std::uint32_t> deaths;
+    std::vector<std::uint32_t> newBirths;
+    deaths.reserve(totalDeaths);
+    newBirths.reserve(totalBirths);
+    for (const auto& chunk : chunks) {
+        deaths.insert(deaths.end(), chunk.deaths.begin(), chunk.deaths.end());
+        newBirths.insert(newBirths.end(), chunk.births.begin(), chunk.births.end());
     }
     
-    // Debug output for demographic tracking (optional - can be removed in production)
-    if (death_count > 0 || birth_count > 0) {
-        // Output is visible when running with verbose logging
-        // fprintf(stderr, "[Demo] Gen %llu: %d births, %d deaths (pop: %zu)\n", 
-        //         generation_, birth_count, death_count, agents_.size());
+    // Deaths: events log stable IDs; aggregates updated in one pass
+    for (auto slot : deaths) {
+        event_log_.logDeath(generation_, id[slot], region[slot], age[slot]);
     }
+    onAgentsDied(deaths);
+    
+    // Births
+    spawnChildren(newBirths);
     
     // Aggressive dead agent compaction (every 5 ticks)
-    // Reduces cache pollution and wasted iteration over zombie agents
-    // Trade-off: more frequent compaction vs. less iteration overhead
+    // Prunes dead references every pass; reclaims slots once enough have died
     if (generation_ % 5 == 0) {
         compactDeadAgents();
     }
 }
 
-void Kernel::createChild(std::uint32_t motherId) {
-    if (motherId >= agents_.size()) return;
+void Kernel::spawnChildren(const std::vector<std::uint32_t>& motherSlots) {
+    // Safety check: enforce max population limit (earliest mothers by slot win)
+    const std::size_t room = agents_.size() < cfg_.maxPopulation
+        ? cfg_.maxPopulation - agents_.size() : 0;
+    const std::size_t count = std::min(motherSlots.size(), room);
+    if (count == 0) return;
+    
+    const auto firstSlot = static_cast<std::uint32_t>(agents_.size());
+    const std::uint32_t firstId = nextAgentId_;
+    nextAgentId_ += static_cast<std::uint32_t>(count);
+    
+    // Children only read parent state, so they can be built concurrently
+    std::vector<Agent> children(count);
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(count); ++k) {
+        children[k] = makeChild(motherSlots[k], firstId + static_cast<std::uint32_t>(k),
+                                firstSlot + static_cast<std::uint32_t>(k));
+    }
     
-    // Safety check: enforce max population limit
-    if (agents_.size() >= cfg_.maxPopulation) return;
+    for (const auto& child : children) {
+        event_log_.logBirth(generation_, child.id, child.region,
+                            static_cast<std::uint32_t>(child.parent_a));
+    }
+    appendAgents(children);
+}
+
+void Kernel::appendAgents(const std::vector<Agent>& newcomers) {
+    // Bulk allocation: one pass over columns, graph rows and economy slots
+    const auto firstSlot = static_cast<std::uint32_t>(agents_.size());
+    const std::size_t count = newcomers.size();
+    agents_.append(newcomers);
+    
+    std::vector<std::uint32_t> regions(count);
+    for (std::size_t k = 0; k < count; ++k) {
+        const auto slot = firstSlot + static_cast<std::uint32_t>(k);
+        // Reciprocal links: the agent's initial neighbors point back at it
+        for (auto v : newcomers[k].neighbors) {
+            agents_.graph.push(v, slot);
+        }
+        regionIndex_[newcomers[k].region].push_back(slot);
+        regions[k] = newcomers[k].region;
+    }
     
-    Agent& mother = agents_[motherId];
-    if (!mother.alive) return;
+    onAgentsBorn(firstSlot, static_cast<std::uint32_t>(count));
+    economy_.addAgents(firstSlot, regions, rng_);
+}
+
+Agent Kernel::makeChild(std::uint32_t motherSlot, std::uint32_t childId,
+                        std::uint32_t childSlot) const {
+    const auto mother = agents_[motherSlot];
+    
+    // Keyed on the mother: at most one birth per mother per tick
+    rng::CounterRng birthRng(cfg_.seed, generation_, mother.id, rng::Stream::Birth);
     
     Agent child;
-    child.id = static_cast<std::uint32_t>(agents_.size());
+    child.id = childId;
     child.alive = true;
     child.age = 0;
     
     // Sex (50/50)
     std::bernoulli_distribution sexDist(0.5);
-    child.female = sexDist(rng_);
+    child.female = sexDist(birthRng);
     
-    // Parents
-    child.parent_a = static_cast<std::int32_t>(motherId);
+    // Parents (lineage records stable IDs; fatherId below is a slot)
+    child.parent_a = static_cast<std::int32_t>(mother.id);
     
     // Select father from mother's neighbors or region
     std::int32_t fatherId = -1;
     if (!mother.neighbors.empty()) {
         std::uniform_int_distribution<std::size_t> neighborDist(0, mother.neighbors.size() - 1);
-        fatherId = static_cast<std::int32_t>(mother.neighbors[neighborDist(rng_)]);
+        fatherId = static_cast<std::int32_t>(mother.neighbors[neighborDist(birthRng)]);
         // Verify father is alive and male
         if (fatherId >= 0 && fatherId < static_cast<std::int32_t>(agents_.size())) {
-            if (!agents_[fatherId].alive || agents_[fatherId].female) {
+            if (!agents_.alive[fatherId] || agents_.female[fatherId]) {
                 fatherId = -1;  // Invalid father
             }
         }
     }
-    child.parent_b = fatherId;
+    child.parent_b = fatherId >= 0 ? static_cast<std::int32_t>(agents_.id[fatherId]) : -1;
     
     // Lineage: inherit from mother (matrilineal) or could use patrilineal/mixed
     child.lineage_id = mother.lineage_id;
@@ -1004,33 +1559,33 @@ void Kernel::createChild(std::uint32_t motherId) {
     double dialectPos = (qx + qy) / 2.0;
     std::uint8_t regionDialect = static_cast<std::uint8_t>(std::min(9.0, dialectPos * 20.0));
     std::bernoulli_distribution dialectDrift(0.2);
-    child.dialect = dialectDrift(rng_) ? regionDialect : mother.dialect;
+    child.dialect = dialectDrift(birthRng) ? regionDialect : mother.dialect;
     child.fluency = 0.5;  // will grow with age/exposure
     
     // Traits: genetic inheritance with mutation
-    Agent* father = (fatherId >= 0 && fatherId < static_cast<std::int32_t>(agents_.size())) 
-                    ? &agents_[fatherId] : nullptr;
+    const bool hasFather = fatherId >= 0 && fatherId < static_cast<std::int32_t>(agents_.size());
+    const std::size_t father = hasFather ? static_cast<std::size_t>(fatherId) : 0;
     
     std::normal_distribution<double> mutationNoise(0.0, 0.05);
     auto inherit = [&](double mTrait, double fTrait) -> double {
-        double base = father ? 0.5 * (mTrait + fTrait) : mTrait;
-        double trait = base + mutationNoise(rng_);
+        double base = hasFather ? 0.5 * (mTrait + fTrait) : mTrait;
+        double trait = base + mutationNoise(birthRng);
         return std::clamp(trait, 0.0, 1.0);
     };
     
-    child.openness = inherit(mother.openness, father ? father->openness : mother.openness);
-    child.conformity = inherit(mother.conformity, father ? father->conformity : mother.conformity);
-    child.assertiveness = inherit(mother.assertiveness, father ? father->assertiveness : mother.assertiveness);
-    child.sociality = inherit(mother.sociality, father ? father->sociality : mother.sociality);
+    child.openness = inherit(mother.openness, hasFather ? agents_.openness[father] : mother.openness);
+    child.conformity = inherit(mother.conformity, hasFather ? agents_.conformity[father] : mother.conformity);
+    child.assertiveness = inherit(mother.assertiveness, hasFather ? agents_.assertiveness[father] : mother.assertiveness);
+    child.sociality = inherit(mother.sociality, hasFather ? agents_.sociality[father] : mother.sociality);
     
     // Beliefs: cultural transmission from parents with noise
     std::normal_distribution<double> beliefNoise(0.0, 0.2);
     for (int k = 0; k < 4; ++k) {
         double baseB = mother.B[k];
-        if (father) {
-            baseB = 0.5 * (mother.B[k] + father->B[k]);
+        if (hasFather) {
+            baseB = 0.5 * (mother.B[k] + agents_.B[father][k]);
         }
-        child.B[k] = std::clamp(baseB + beliefNoise(rng_), -1.0, 1.0);
+        child.B[k] = std::clamp(baseB + beliefNoise(birthRng), -1.0, 1.0);
         // Convert B to internal state x = atanh(B)
         double B_clamped = std::clamp(child.B[k], -0.99, 0.99);
         child.x[k] = std::atanh(B_clamped);
@@ -1043,67 +1598,566 @@ void Kernel::createChild(std::uint32_t motherId) {
     child.m_susceptibility = 0.7 + 0.6 * (child.openness - 0.5);
     child.m_mobility = 0.8 + 0.4 * child.sociality;
     
-    // Network: connect to mother and some of her neighbors
-    child.neighbors.clear();
-    child.neighbors.push_back(motherId);
-    mother.neighbors.push_back(child.id);  // Reciprocal link
+    // Network: connect to mother and some of her neighbors (graph rows are slots).
+    // Reciprocal links are added by spawnChildren() once the child has a row.
+    child.neighbors.push_back(motherSlot);
     
     // Inherit some neighbors from mother (family network)
-    std::uniform_int_distribution<std::size_t> neighborSelectDist(0, mother.neighbors.size() - 1);
-    int neighborCount = std::min(3, static_cast<int>(mother.neighbors.size()));
-    for (int i = 0; i < neighborCount; ++i) {
-        std::uint32_t neighborId = mother.neighbors[neighborSelectDist(rng_)];
-        if (neighborId != child.id && neighborId < agents_.size()) {
-            child.neighbors.push_back(neighborId);
-            agents_[neighborId].neighbors.push_back(child.id);
+    const std::size_t motherDegree = mother.neighbors.size();
+    if (motherDegree > 0) {
+        std::uniform_int_distribution<std::size_t> neighborSelectDist(0, motherDegree - 1);
+        int neighborCount = std::min(3, static_cast<int>(motherDegree));
+        for (int i = 0; i < neighborCount; ++i) {
+            std::uint32_t neighborId = mother.neighbors[neighborSelectDist(birthRng)];
+            if (neighborId != childSlot && neighborId < agents_.size()) {
+                child.neighbors.push_back(neighborId);
+            }
+        }
+    }
+    
+    return child;
+}
+
+std::uint64_t Kernel::representedPopulation() const {
+    std::uint64_t live = 0;
+    for (const auto& agg : regional_aggregates_) {
+        live += agg.population;
+    }
+    return live + background_.getTotalPopulation();
+}
+
+std::uint32_t Kernel::materialize(std::uint32_t region, std::uint32_t count) {
+    if (region >= cfg_.regions) {
+        throw std::out_of_range("materialize: region " + std::to_string(region) + " out of range");
+    }
+    const std::size_t room = agents_.size() < cfg_.maxPopulation
+        ? cfg_.maxPopulation - agents_.size() : 0;
+    const auto cohorts = background_.regionCohorts(region);
+    std::uint64_t available = 0;
+    for (const auto& entry : cohorts) {
+        available += entry.second.count;
+    }
+    const auto wanted = static_cast<std::uint32_t>(
+        std::min<std::uint64_t>({count, available, static_cast<std::uint64_t>(room)}));
+    if (wanted == 0) return 0;
+    
+    // Draw from each cohort in proportion to its size (largest remainder)
+    std::vector<Materialization> batch;
+    std::vector<std::pair<double, std::size_t>> remainders;
+    std::uint32_t assigned = 0;
+    for (std::size_t c = 0; c < cohorts.size(); ++c) {
+        const double share = static_cast<double>(wanted) * cohorts[c].second.count / static_cast<double>(available);
+        const auto whole = static_cast<std::uint32_t>(share);
+        batch.push_back({cohorts[c].first, cohorts[c].second, whole});
+        remainders.emplace_back(share - whole, c);
+        assigned += whole;
+    }
+    std::stable_sort(remainders.begin(), remainders.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (std::size_t r = 0; r < remainders.size() && assigned < wanted; ++r) {
+        auto& entry = batch[remainders[r].second];
+        if (entry.count < cohorts[remainders[r].second].second.count) {
+            entry.count++;
+            assigned++;
+        }
+    }
+    
+    const std::uint32_t created = materializeAgents(batch);
+    if (created == 0) return 0;
+    for (const auto& entry : batch) {
+        background_.withdraw(entry.key, entry.count);
+    }
+    ++state_version_;
+    return created;
+}
+
+std::uint32_t Kernel::dematerialize(std::uint32_t region, std::uint32_t count) {
+    if (region >= cfg_.regions) {
+        throw std::out_of_range("dematerialize: region " + std::to_string(region) + " out of range");
+    }
+    // Most recently indexed agents are folded back first
+    std::vector<std::uint32_t> retired;
+    const auto& members = regionIndex_[region];
+    for (auto it = members.rbegin(); it != members.rend() && retired.size() < count; ++it) {
+        const auto slot = *it;
+        if (!agents_.alive[slot] || agents_.region[slot] != region) continue;
+        agents_.alive[slot] = 0;
+        retired.push_back(slot);
+        const auto& health = agents_.health[slot];
+        background_.deposit(CohortKey{static_cast<std::uint16_t>(region),
+                                      CohortDemographics::ageToGroup(agents_.age[slot]),
+                                      static_cast<std::uint8_t>(agents_.female[slot])},
+                            1, health.physical_health, health.nutrition_level);
+    }
+    if (retired.empty()) return 0;
+    
+    // Leaves the aggregates like a death, but is not logged as one
+    onAgentsDied(retired);
+    ++state_version_;
+    return static_cast<std::uint32_t>(retired.size());
+}
+
+void Kernel::fastForward(std::uint32_t years) {
+    if (years == 0) return;
+    if (cfg_.regions > kMaxCohortRegions) {
+        throw std::invalid_argument("fastForward needs regions <= " + std::to_string(kMaxCohortRegions) +
+                                    " (got " + std::to_string(cfg_.regions) + ")");
+    }
+    CIV_PROFILE_SCOPE(profiler::Phase::Demography);
+    CIV_PROFILE_TOUCH(agents_.size());
+    ++state_version_;
+    
+    // Agents become cohort members; they and the background advance together,
+    // recalibrated yearly so capacity pressure follows the cohort populations
+    CohortDemographics detail;
+    detail.configure(cfg_.regions, cfg_.seed ^ (generation_ * 0x9E3779B97F4A7C15ULL));
+    detail.buildCohortsFromAgents(agents_);
+    const bool hasBackground = !background_.cohorts().empty();
+    const std::uint64_t ticks = static_cast<std::uint64_t>(years) * static_cast<std::uint64_t>(cfg_.ticksPerYear);
+    for (std::uint64_t t = 0; t < ticks; ++t) {
+        if (t % cfg_.ticksPerYear == 0) {
+            calibrateCohorts(detail, 1.0);
+            if (hasBackground) calibrateCohorts(background_, background_scale_);
+        }
+        detail.updateDemographics(generation_ + t + 1, cfg_.ticksPerYear);
+        if (hasBackground) {
+            background_.updateDemographics(generation_ + t + 1, cfg_.ticksPerYear);
         }
     }
+    generation_ += ticks;
     
-    // Add to containers
-    agents_.push_back(child);
-    regionIndex_[child.region].push_back(child.id);
+    // Flat (region, age group, sex) index so the sync runs in a fixed order
+    constexpr std::size_t kKeysPerRegion = 18 * 2;
+    auto keyIndex = [](const CohortKey& key) {
+        return (static_cast<std::size_t>(key.region) * 18 + key.age_group) * 2 + key.female;
+    };
+    std::vector<std::uint32_t> target(static_cast<std::size_t>(cfg_.regions) * kKeysPerRegion, 0);
+    std::vector<const Cohort*> source(target.size(), nullptr);
+    for (const auto& [key, cohort] : detail.cohorts()) {
+        target[keyIndex(key)] = cohort.count;
+        source[keyIndex(key)] = &cohort;
+    }
     
-    // Update regional aggregates incrementally
-    onAgentBorn(child.id);
+    // Agents age by the skipped years; anyone past the lifespan cap dies
+    std::vector<std::vector<std::uint32_t>> members(target.size());
+    std::vector<std::uint32_t> deaths;
+    for (std::size_t i = 0; i < agents_.size(); ++i) {
+        if (!agents_.alive[i]) continue;
+        agents_.age[i] += static_cast<int>(years);
+        const auto slot = static_cast<std::uint32_t>(i);
+        if (agents_.age[i] > cfg_.maxAgeYears) {
+            deaths.push_back(slot);
+            continue;
+        }
+        members[keyIndex(CohortKey{static_cast<std::uint16_t>(agents_.region[i]),
+                                   CohortDemographics::ageToGroup(agents_.age[i]),
+                                   static_cast<std::uint8_t>(agents_.female[i])})].push_back(slot);
+    }
     
-    // Register with economy module
-    economy_.addAgent(child.id, child.region, rng_);
+    // Each key keeps as many agents as its cohort: surplus agents die (lowest
+    // mortality draw first), shortfalls are materialized up to maxPopulation
+    std::size_t room = agents_.size() < cfg_.maxPopulation ? cfg_.maxPopulation - agents_.size() : 0;
+    std::vector<Materialization> batch;
+    for (std::size_t k = 0; k < target.size(); ++k) {
+        const auto& slots = members[k];
+        if (slots.size() > target[k]) {
+            std::vector<std::pair<double, std::uint32_t>> draws;
+            draws.reserve(slots.size());
+            for (auto slot : slots) {
+                rng::CounterRng rng(cfg_.seed, generation_, agents_.id[slot], rng::Stream::Mortality);
+                draws.emplace_back(rng.uniform(), slot);
+            }
+            std::sort(draws.begin(), draws.end());
+            for (std::size_t d = 0; d < slots.size() - target[k]; ++d) {
+                deaths.push_back(draws[d].second);
+            }
+        } else if (slots.size() < target[k] && room > 0) {
+            const auto missing = static_cast<std::uint32_t>(
+                std::min<std::size_t>(target[k] - slots.size(), room));
+            room -= missing;
+            const auto region = static_cast<std::uint16_t>(k / kKeysPerRegion);
+            const auto group = static_cast<std::uint8_t>((k % kKeysPerRegion) / 2);
+            batch.push_back({CohortKey{region, group, static_cast<std::uint8_t>(k % 2)}, *source[k], missing});
+        }
+    }
+    
+    // Newcomers take their culture from the pre-sync population (the dead
+    // included), so a region keeps its character even if few of its agents survive
+    materializeAgents(batch);
+    std::sort(deaths.begin(), deaths.end());
+    for (auto slot : deaths) {
+        agents_.alive[slot] = 0;
+        event_log_.logDeath(generation_, agents_.id[slot], agents_.region[slot], agents_.age[slot]);
+    }
+    onAgentsDied(deaths);
+    compactDeadAgents();
+    if (live_clusters_) {
+        live_clusters_->fullReassignment(agents_);
+    }
+}
+
+std::uint32_t Kernel::materializeAgents(const std::vector<Materialization>& batch) {
+    // One entry per new agent, in batch order
+    std::vector<std::uint32_t> entryOf;
+    for (std::size_t b = 0; b < batch.size(); ++b) {
+        entryOf.insert(entryOf.end(), batch[b].count, static_cast<std::uint32_t>(b));
+    }
+    const std::size_t count = entryOf.size();
+    if (count == 0) return 0;
+    
+    // Donors lend their community's culture: live agents of the same region,
+    // or of any region where none are left
+    std::vector<std::uint32_t> anywhere;
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> regional;
+    std::vector<const std::vector<std::uint32_t>*> donors(batch.size(), nullptr);
+    for (std::size_t b = 0; b < batch.size(); ++b) {
+        if (batch[b].count == 0) continue;
+        const std::uint32_t region = batch[b].key.region;
+        auto [it, inserted] = regional.try_emplace(region);
+        if (inserted) {
+            for (auto slot : regionIndex_[region]) {
+                if (agents_.alive[slot] && agents_.region[slot] == region) it->second.push_back(slot);
+            }
+        }
+        if (!it->second.empty()) {
+            donors[b] = &it->second;
+            continue;
+        }
+        if (anywhere.empty()) {
+            for (std::size_t i = 0; i < agents_.size(); ++i) {
+                if (agents_.alive[i]) anywhere.push_back(static_cast<std::uint32_t>(i));
+            }
+            if (anywhere.empty()) return 0;
+        }
+        donors[b] = &anywhere;
+    }
     
-    // Log birth event
-    event_log_.logBirth(generation_, child.id, child.region, motherId);
+    const auto firstSlot = static_cast<std::uint32_t>(agents_.size());
+    const std::uint32_t firstId = nextAgentId_;
+    nextAgentId_ += static_cast<std::uint32_t>(count);
+    
+    // Newcomers only read existing agents, so they can be built concurrently
+    std::vector<Agent> newcomers(count);
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(count); ++k) {
+        const auto& from = batch[entryOf[k]];
+        newcomers[k] = makeMaterialized(*donors[entryOf[k]], from, firstId + static_cast<std::uint32_t>(k),
+                                        firstSlot + static_cast<std::uint32_t>(k));
+    }
+    appendAgents(newcomers);
+    return static_cast<std::uint32_t>(count);
 }
 
-void Kernel::compactDeadAgents() {
-    // AGENT ID STABILITY CONSTRAINT:
-    // This function marks dead agents as inactive but does NOT remove them from agents_ vector.
-    // Agent IDs are indices into agents_, and neighbor lists store these IDs directly.
-    // If we ever actually erase agents from the vector, all IDs would become invalid.
-    // Current approach: agents_ is append-only, dead slots are skipped but preserved.
-    // This wastes memory but preserves ID stability across the simulation.
-    // TODO: If memory becomes an issue, implement ID remapping for neighbor lists.
+Agent Kernel::makeMaterialized(const std::vector<std::uint32_t>& donors, const Materialization& from,
+                               std::uint32_t id, std::uint32_t slot) const {
+    rng::CounterRng rng(cfg_.seed, generation_, id, rng::Stream::Cohort);
+    std::uniform_int_distribution<std::size_t> donorDist(0, donors.size() - 1);
+    const std::uint32_t donorSlot = donors[donorDist(rng)];
+    const auto donor = agents_[donorSlot];
+    
+    Agent agent;
+    agent.id = id;
+    agent.alive = true;
+    agent.region = from.key.region;
+    agent.female = from.key.female != 0;
+    
+    // Uniform age within the 5-year group; the last group runs to the lifespan cap
+    const int youngest = std::min(5 * static_cast<int>(from.key.age_group), cfg_.maxAgeYears);
+    const int oldest = from.key.age_group >= 17 ? cfg_.maxAgeYears : std::min(youngest + 4, cfg_.maxAgeYears);
+    agent.age = std::uniform_int_distribution<int>(youngest, std::max(youngest, oldest))(rng);
+    
+    // No simulated parents: each materialized agent founds its own lineage
+    agent.lineage_id = id;
+    
+    // Language as spoken by the donor's community
+    agent.primaryLang = donor.primaryLang;
+    agent.dialect = donor.dialect;
+    agent.fluency = donor.fluency;
+    
+    // Traits and beliefs: the donor's, perturbed like an inheritance
+    std::normal_distribution<double> traitNoise(0.0, 0.05);
+    auto perturb = [&](double trait) { return std::clamp(trait + traitNoise(rng), 0.0, 1.0); };
+    agent.openness = perturb(donor.openness);
+    agent.conformity = perturb(donor.conformity);
+    agent.assertiveness = perturb(donor.assertiveness);
+    agent.sociality = perturb(donor.sociality);
+    
+    std::normal_distribution<double> beliefNoise(0.0, 0.2);
+    for (int k = 0; k < 4; ++k) {
+        agent.B[k] = std::clamp(donor.B[k] + beliefNoise(rng), -1.0, 1.0);
+        agent.x[k] = std::atanh(std::clamp(agent.B[k], -0.99, 0.99));
+    }
+    agent.B_norm_sq = agent.B[0]*agent.B[0] + agent.B[1]*agent.B[1] +
+                      agent.B[2]*agent.B[2] + agent.B[3]*agent.B[3];
+    
+    agent.m_comm = 1.0;
+    agent.m_susceptibility = 0.7 + 0.6 * (agent.openness - 0.5);
+    agent.m_mobility = 0.8 + 0.4 * agent.sociality;
+    
+    // Health carried over from the cohort the agent leaves
+    agent.health.physical_health = from.cohort.avg_health;
+    agent.health.nutrition_level = from.cohort.avg_nutrition;
+    agent.health.immunity = from.cohort.immunity_share > 0.5 ? 0.5 : 0.2;
+    
+    // Network: the donor and some of its neighbors (reciprocal links added by appendAgents())
+    agent.neighbors.push_back(donorSlot);
+    const std::size_t donorDegree = donor.neighbors.size();
+    if (donorDegree > 0) {
+        std::uniform_int_distribution<std::size_t> neighborDist(0, donorDegree - 1);
+        const int neighborCount = std::min(3, static_cast<int>(donorDegree));
+        for (int i = 0; i < neighborCount; ++i) {
+            const std::uint32_t neighbor = donor.neighbors[neighborDist(rng)];
+            if (neighbor != slot && neighbor < agents_.size()) {
+                agent.neighbors.push_back(neighbor);
+            }
+        }
+    }
     
-    // Remove dead agents from regionIndex (these are just ID references)
+    return agent;
+}
+
+const std::array<const char*, Kernel::kMemorySubsystemCount> Kernel::kMemorySubsystems = {
+    "agents", "graph", "regions", "economy", "trade", "events", "clusters", "background", "scratch"};
+
+Kernel::MemoryUsage Kernel::memoryUsage() const {
+    std::array<MemoryFootprint, kMemorySubsystemCount> parts;
+    parts[0] = agents_.memoryUsage();
+    parts[0].add(activity_.memoryUsage());
+    parts[1] = agents_.graph.memoryUsage();
+    auto& regions = parts[2];
+    regions.add(regionIndex_);
+    for (const auto& slots : regionIndex_) regions.add(slots);
+    regions.add(regional_aggregates_);
+    regions.add(demography_rates_.mortality);
+    regions.add(demography_rates_.fertility);
+    regions.add(demography_rates_.hardship);
+    regions.add(demography_rates_.wealthBaseline);
+    regions.add(region_attractiveness_);
+    regions.add(sorted_attractive_regions_);
+    regions.add(mean_field_.memoryUsage());
+    parts[3] = economy_.memoryUsage();
+    parts[4] = economy_.tradeMemoryUsage();
+    parts[5] = event_log_.memoryUsage();
+    if (live_clusters_) parts[6] = live_clusters_->memoryUsage();
+    parts[7] = background_.memoryUsage();
+    parts[8].reserved = arena_.bytesReserved() + scheduler_.partials().bytesReserved() +
+                        belief_deltas_.bytesReserved();  // Dead between ticks
+    
+    MemoryUsage usage;
+    usage.subsystems.resize(kMemorySubsystemCount);
+    for (std::size_t i = 0; i < kMemorySubsystemCount; ++i) {
+        memory_peaks_[i] = std::max(memory_peaks_[i], parts[i].reserved);
+        usage.subsystems[i] = {kMemorySubsystems[i], parts[i].used, parts[i].reserved, memory_peaks_[i]};
+        usage.used += parts[i].used;
+        usage.reserved += parts[i].reserved;
+    }
+    memory_peak_ = std::max(memory_peak_, usage.reserved);
+    usage.peak = memory_peak_;
+    return usage;
+}
+
+bool Kernel::runMemoryAction(MemoryAction action) {
+    switch (action) {
+    case MemoryAction::Compact: {
+        const auto& alive = agents_.alive;
+        if (std::find(alive.begin(), alive.end(), 0) == alive.end()) return false;
+        compactDeadAgents(true);
+        ++memory_budget_stats_.compactions;
+        return true;
+    }
+    case MemoryAction::Spill: {
+        const std::size_t spilled = event_log_.spill();
+        memory_budget_stats_.spilledSegments += spilled;
+        return spilled > 0;
+    }
+    case MemoryAction::Shrink: {
+        const std::size_t spare = agents_.size() / 16;
+        agents_.shrinkToFit(spare);
+        agents_.graph.shrinkToFit();
+        economy_.shrinkAgents(spare);
+        if (live_clusters_) live_clusters_->shrinkToFit(spare);
+        activity_.shrinkToFit(spare);
+        for (auto& slots : regionIndex_) fitCapacity(slots, slots.size() / 16);
+        arena_.release();
+        scheduler_.releaseScratch();
+        belief_deltas_.release();
+        ++memory_budget_stats_.shrinks;
+        return true;
+    }
+    }
+    return false;
+}
+
+void Kernel::enforceMemoryBudget(std::size_t used) {
+    // Compaction drops dead rows so the shrink can release them; spilling
+    // costs I/O but loses nothing. Without a win, wait for live data to grow
+    // an eighth before paying again.
+    if (used > memory_retry_above_) {
+        for (const auto action : {MemoryAction::Compact, MemoryAction::Spill, MemoryAction::Shrink}) {
+            if (!runMemoryAction(action)) continue;
+            const auto usage = memoryUsage();
+            if (usage.reserved <= cfg_.memoryBudget) {
+                memory_retry_above_ = 0;
+                return;
+            }
+            used = usage.used;
+        }
+        memory_retry_above_ = used + used / 8;
+    }
+    ++memory_budget_stats_.overBudget;
+}
+
+std::size_t Kernel::trimMemory() {
+    const std::size_t before = memoryUsage().reserved;
+    for (const auto action : {MemoryAction::Compact, MemoryAction::Spill, MemoryAction::Shrink}) {
+        runMemoryAction(action);
+    }
+    const std::size_t after = memoryUsage().reserved;
+    return before > after ? before - after : 0;
+}
+
+void Kernel::compactDeadAgents(bool force) {
+    // SLOTS VS IDS:
+    // Slots index agents_, the graph rows, regionIndex_ and the economy's agent table.
+    // Stable IDs (agents_.id) are what events, lineage and external rosters hold.
+    // Every pass prunes dead slots from regionIndex_ and the graph; once enough
+    // slots are dead, they are squeezed out and every slot reference is remapped.
+    CIV_PROFILE_SCOPE(profiler::Phase::Compaction);
+    const auto& alive = agents_.alive;
+    const std::size_t n = agents_.size();
+    CIV_PROFILE_TOUCH(n);
+    const auto dead = static_cast<std::size_t>(std::count(alive.begin(), alive.end(), 0));
+    
+    if (dead > 0 && (force || dead >= static_cast<std::size_t>(n * TuningConstants::kCompactionDeadFraction))) {
+        const auto remap = agents_.compact();  // Also renumbers the social graph
+        
+        for (auto& region : regionIndex_) {
+            std::size_t kept = 0;
+            for (auto slot : region) {
+                if (slot < remap.size() && remap[slot] != AgentStore::kNoSlot) {
+                    region[kept++] = remap[slot];
+                }
+            }
+            region.resize(kept);
+        }
+        economy_.compactAgents(remap);
+        if (live_clusters_) live_clusters_->compact(remap);
+        activity_.compact(remap);
+        return;
+    }
+    
+    // Remove dead agents from regionIndex (these are just slot references)
     for (auto& region : regionIndex_) {
         region.erase(
             std::remove_if(region.begin(), region.end(), 
-                [this](std::uint32_t id) { 
-                    return id >= agents_.size() || !agents_[id].alive;
+                [this](std::uint32_t slot) { 
+                    return slot >= agents_.size() || !agents_.alive[slot];
                 }),
             region.end()
         );
     }
     
-    // Remove dead agents from neighbor lists
-    for (auto& agent : agents_) {
-        if (!agent.alive) continue;
-        agent.neighbors.erase(
-            std::remove_if(agent.neighbors.begin(), agent.neighbors.end(),
-                [this](std::uint32_t id) {
-                    return id >= agents_.size() || !agents_[id].alive;
-                }),
-            agent.neighbors.end()
-        );
+    // Remove dead agents from neighbor lists and repack the CSR graph in one
+    // batched pass (also reclaims rows relocated by births/migration/reconnects)
+    agents_.graph.compact(
+        [&alive](std::uint32_t u) { return !alive[u]; },
+        [&alive, n](std::uint32_t slot) { return slot >= n || !alive[slot]; });
+}
+
+void Kernel::reorderAgents() {
+    // LOCALITY REORDERING:
+    // Births append at the end and deaths leave holes, so over time a
+    // neighbor row's targets scatter across the columns. This pass drops dead
+    // slots (like compaction) and sorts the living by the median slot of
+    // themselves and their neighbors: agents whose neighbors are already
+    // nearby keep their place, newcomers move next to the ones they are tied
+    // to. (Reverse Cuthill-McKee did worse here: the rewired shortcuts of the
+    // small world make its BFS levels huge.) Grouping by region first is
+    // optional; the initial ring ignores regions, so it costs graph locality
+    // until births and local ties make the graph regional.
+    // Every slot reference is remapped as in compaction; stable IDs stay put.
+    CIV_PROFILE_SCOPE(profiler::Phase::Reorder);
+    const std::size_t n = agents_.size();
+    CIV_PROFILE_TOUCH(n);
+    const auto& alive = agents_.alive;
+    const auto& region = agents_.region;
+    const SocialGraph& graph = agents_.graph;
+    const double before = localEdgeShare();
+    
+    std::vector<std::uint32_t> key(n, 0);
+    #pragma omp parallel
+    {
+        std::vector<std::uint32_t> around;
+        #pragma omp for schedule(static)
+        for (std::ptrdiff_t u = 0; u < static_cast<std::ptrdiff_t>(n); ++u) {
+            const auto slot = static_cast<std::uint32_t>(u);
+            if (!alive[slot]) continue;
+            around.assign(1, slot);
+            const std::uint32_t* row = graph.data(slot);
+            for (std::uint32_t k = 0; k < graph.degree(slot); ++k) {
+                if (row[k] < n && alive[row[k]]) around.push_back(row[k]);
+            }
+            const auto mid = around.begin() + static_cast<std::ptrdiff_t>(around.size() / 2);
+            std::nth_element(around.begin(), mid, around.end());
+            key[slot] = *mid;
+        }
+    }
+    
+    // Living agents, bucketed by region (one bucket unless reorderByRegion)
+    const std::uint32_t buckets = cfg_.reorderByRegion ? cfg_.regions : 1;
+    std::vector<std::size_t> start(buckets + 1, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (alive[i]) ++start[(cfg_.reorderByRegion ? region[i] : 0) + 1];
     }
+    for (std::uint32_t b = 0; b < buckets; ++b) start[b + 1] += start[b];
+    std::vector<std::uint32_t> order(start[buckets]);
+    {
+        auto fill = start;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (alive[i]) order[fill[cfg_.reorderByRegion ? region[i] : 0]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+    #pragma omp parallel for schedule(dynamic)
+    for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(buckets); ++b) {
+        std::stable_sort(order.begin() + static_cast<std::ptrdiff_t>(start[b]),
+                         order.begin() + static_cast<std::ptrdiff_t>(start[b + 1]),
+                         [&key](std::uint32_t a, std::uint32_t c) { return key[a] < key[c]; });
+    }
+    
+    agents_.reorder(order);  // Also renumbers the social graph and the by-ID index
+    economy_.reorderAgents(order);
+    if (live_clusters_) live_clusters_->reorder(order);
+    activity_.reorder(order);
+    for (auto& slots : regionIndex_) slots.clear();
+    for (std::size_t i = 0; i < agents_.size(); ++i) {
+        // Ascending slots; one contiguous range per region with reorderByRegion
+        regionIndex_[agents_.region[i]].push_back(static_cast<std::uint32_t>(i));
+    }
+    ++state_version_;
+    
+    ++locality_.passes;
+    locality_.generation = generation_;
+    locality_.localEdgesBefore = before;
+    locality_.localEdgesAfter = localEdgeShare();
+}
+
+double Kernel::localEdgeShare() const {
+    const auto& alive = agents_.alive;
+    const SocialGraph& graph = agents_.graph;
+    std::uint64_t edges = 0;
+    std::uint64_t local = 0;
+    #pragma omp parallel for schedule(static) reduction(+ : edges, local)
+    for (std::ptrdiff_t u = 0; u < static_cast<std::ptrdiff_t>(agents_.size()); ++u) {
+        if (!alive[u]) continue;
+        const auto slot = static_cast<std::uint32_t>(u);
+        const std::uint32_t* row = graph.data(slot);
+        for (std::uint32_t k = 0; k < graph.degree(slot); ++k) {
+            const auto gap = row[k] > slot ? row[k] - slot : slot - row[k];
+            ++edges;
+            if (gap < kLocalitySpan) ++local;
+        }
+    }
+    return edges ? static_cast<double>(local) / static_cast<double>(edges) : 0.0;
 }
 
 void Kernel::stepMigration() {
@@ -1141,254 +2195,325 @@ void Kernel::stepMigration() {
             });
     }
     
-    // EMERGENT MIGRATION CANDIDATES: Anyone can migrate, but propensity varies by circumstance
-    // Age, family status, skills, and economic situation all affect likelihood
-    std::vector<std::uint32_t> migration_candidates;
-    for (std::size_t i = 0; i < agents_.size(); ++i) {
-        const auto& agent = agents_[i];
-        if (!agent.alive) continue;
-        
-        // Base mobility affected by age (young and old migrate less frequently, but CAN migrate)
-        double age_mobility = 1.0;
-        if (agent.age < 18) age_mobility = 0.1 + agent.age * 0.05; // children rarely migrate alone
-        else if (agent.age > 60) age_mobility = std::max(0.1, 1.0 - (agent.age - 60) * 0.02); // elderly migrate less
-        
-        // Network ties reduce mobility (people with many connections are "rooted")
-        double network_mobility = 1.0 - std::min(0.5, agent.neighbors.size() * 0.02);
-        
-        // Effective mobility combines traits with situational factors
-        double effective_mobility = agent.m_mobility * age_mobility * network_mobility;
-        
-        // Everyone with any mobility can be a candidate (threshold varies)
-        if (effective_mobility > 0.3) {
-            migration_candidates.push_back(i);
+    // STAGED MIGRATION PIPELINE:
+    //   1. Candidate scoring   (parallel, per-chunk lists merged in slot order)
+    //   2. Destination choice  (parallel, one counter-based stream per agent)
+    //   3. Commit              (serial, batched regionIndex_/aggregate updates)
+    //   4. Per-migrant repair  (parallel: economy and network retention touch
+    //                           only the migrant's own economy record and row)
+    // Decisions read only pre-commit state, so the outcome is thread-count independent.
+    const std::size_t n = agents_.size();
+    const std::size_t chunkSize = TuningConstants::kDemographyChunkSize;
+    const std::size_t numChunks = (n + chunkSize - 1) / chunkSize;
+    
+    // Stage 1: EMERGENT MIGRATION CANDIDATES - anyone can migrate, but propensity
+    // varies by circumstance (age, network ties, mobility)
+    std::vector<std::vector<std::uint32_t>> chunkCandidates(numChunks);
+    #pragma omp parallel for schedule(dynamic)
+    for (std::ptrdiff_t c = 0; c < static_cast<std::ptrdiff_t>(numChunks); ++c) {
+        const std::size_t begin = static_cast<std::size_t>(c) * chunkSize;
+        const std::size_t end = std::min(n, begin + chunkSize);
+        for (std::size_t i = begin; i < end; ++i) {
+            if (!agents_.alive[i]) continue;
+            const int age = agents_.age[i];
+            
+            // Base mobility affected by age (young and old migrate less frequently, but CAN migrate)
+            double age_mobility = 1.0;
+            if (age < 18) age_mobility = 0.1 + age * 0.05; // children rarely migrate alone
+            else if (age > 60) age_mobility = std::max(0.1, 1.0 - (age - 60) * 0.02); // elderly migrate less
+            
+            // Network ties reduce mobility (people with many connections are "rooted")
+            const double degree = agents_.graph.degree(static_cast<std::uint32_t>(i));
+            double network_mobility = 1.0 - std::min(0.5, degree * 0.02);
+            
+            // Effective mobility combines traits with situational factors
+            double effective_mobility = agents_.m_mobility[i] * age_mobility * network_mobility;
+            
+            // Everyone with any mobility can be a candidate (threshold varies)
+            if (effective_mobility > 0.3) {
+                chunkCandidates[c].push_back(static_cast<std::uint32_t>(i));
+            }
         }
     }
+    std::vector<std::uint32_t> migration_candidates;
+    for (const auto& chunk : chunkCandidates) {
+        migration_candidates.insert(migration_candidates.end(), chunk.begin(), chunk.end());
+    }
     
-    // Process migration decisions (stochastic, only a fraction migrate each tick)
-    std::uniform_real_distribution<double> prob_dist(0.0, 1.0);
-    
+    // Stage 2: stochastic decisions (only a fraction migrate each tick).
     // For destination selection, use pre-sorted top regions instead of random sampling
     const std::size_t top_n = std::min(static_cast<std::size_t>(10), static_cast<std::size_t>(cfg_.regions));
-    std::uniform_int_distribution<std::size_t> top_dist(0, top_n - 1);
+    std::vector<std::uint32_t> destinations(migration_candidates.size());
     
-    for (auto agent_id : migration_candidates) {
-        auto& agent = agents_[agent_id];
-        std::uint32_t origin = agent.region;
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(migration_candidates.size()); ++k) {
+        const std::uint32_t slot = migration_candidates[k];
+        const std::uint32_t origin = agents_.region[slot];
+        destinations[k] = origin;
         
         // Migration propensity based on origin hardship and agent mobility
-        const auto& origin_econ = economy_.getAgentEconomy(agent_id);
-        double push_factor = origin_econ.hardship * agent.m_mobility;
+        const auto& origin_econ = economy_.getAgentEconomy(slot);
+        double push_factor = origin_econ.hardship * agents_.m_mobility[slot];
         
         // Base migration rate: 1% per tick for high-hardship, high-mobility agents
         double migration_prob = push_factor * 0.01;
         
-        if (prob_dist(rng_) < migration_prob) {
-            // Find attractive destination from pre-sorted top regions
-            std::uint32_t destination = origin;
-            double best_gain = 0.0;
+        rng::CounterRng migRng(cfg_.seed, generation_, agents_.id[slot], rng::Stream::Migration);
+        if (migRng.uniform() >= migration_prob) continue;
+        
+        // Find attractive destination from pre-sorted top regions
+        std::uniform_int_distribution<std::size_t> top_dist(0, top_n - 1);
+        std::uint32_t destination = origin;
+        double best_gain = 0.0;
+        
+        // Sample from top N attractive regions (already sorted)
+        for (std::size_t attempt = 0; attempt < 3; ++attempt) {
+            std::size_t idx = top_dist(migRng);
+            std::uint32_t candidate = sorted_attractive_regions_[idx];
+            if (candidate == origin) continue;
             
-            // Sample from top N attractive regions (already sorted)
-            for (std::size_t attempt = 0; attempt < 3; ++attempt) {
-                std::size_t idx = top_dist(rng_);
-                std::uint32_t candidate = sorted_attractive_regions_[idx];
-                if (candidate == origin) continue;
-                
-                double gain = region_attractiveness_[candidate] - region_attractiveness_[origin];
-                if (gain > best_gain) {
-                    best_gain = gain;
-                    destination = candidate;
-                }
+            double gain = region_attractiveness_[candidate] - region_attractiveness_[origin];
+            if (gain > best_gain) {
+                best_gain = gain;
+                destination = candidate;
             }
+        }
+        
+        // EMERGENT MIGRATION THRESHOLD: Decision varies by personality and circumstances
+        // Risk-tolerant agents migrate for smaller gains; risk-averse need bigger incentive
+        double personal_threshold = 0.1 + (1.0 - agents_.openness[slot]) * 0.3 + agents_.conformity[slot] * 0.2;
+        // Desperate agents (high hardship) lower their threshold
+        personal_threshold *= (1.0 - origin_econ.hardship * 0.5);
+        
+        if (destination != origin && best_gain > personal_threshold) {
+            destinations[k] = destination;
+        }
+    }
+    
+    std::vector<MigrationMove> moves;
+    for (std::size_t k = 0; k < migration_candidates.size(); ++k) {
+        const std::uint32_t slot = migration_candidates[k];
+        if (destinations[k] != agents_.region[slot]) {
+            moves.push_back({slot, agents_.region[slot], destinations[k]});
+        }
+    }
+    if (moves.empty()) return;
+    
+    // Stage 3: batched commit
+    commitMigrations(moves);
+    
+    // Stage 4: per-migrant updates
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(moves.size()); ++k) {
+        const auto& move = moves[k];
+        // Update economic sector for migrant (productivity hit, potential sector shift)
+        economy_.migrateAgent(move.slot, move.origin, move.destination);
+        retainTiesAfterMove(move.slot, move.origin, move.destination);
+    }
+}
+
+void Kernel::commitMigrations(const std::vector<MigrationMove>& moves) {
+    // One filtering pass per origin region instead of one linear erase per migrant
+    std::vector<std::uint8_t> leaving(agents_.size(), 0);
+    std::vector<std::uint8_t> touched(cfg_.regions, 0);
+    for (const auto& move : moves) {
+        leaving[move.slot] = 1;
+        touched[move.origin] = 1;
+    }
+    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+        if (!touched[r]) continue;
+        auto& index = regionIndex_[r];
+        index.erase(std::remove_if(index.begin(), index.end(),
+                                   [&](std::uint32_t s) { return leaving[s] != 0; }),
+                    index.end());
+    }
+    
+    for (const auto& move : moves) {
+        agents_.region[move.slot] = move.destination;
+        regionIndex_[move.destination].push_back(move.slot);
+        
+        // Log migration event (events carry stable IDs)
+        event_log_.logMigration(generation_, agents_.id[move.slot], move.origin, move.destination);
+    }
+    
+    onAgentsMigrated(moves);
+}
+
+void Kernel::retainTiesAfterMove(std::uint32_t slot, std::uint32_t origin, std::uint32_t destination) {
+    auto agent = agents_[slot];
+    
+    // EMERGENT NETWORK RETENTION: Preserve high-value connections instead of random
+    // Strong ties (high belief similarity) survive distance; weak ties break
+    if (agent.neighbors.size() > 2) {
+        // Calculate connection value for each neighbor
+        std::vector<std::pair<double, std::uint32_t>> scored_neighbors;
+        scored_neighbors.reserve(agent.neighbors.size());
+        
+        for (std::uint32_t neighbor_id : agent.neighbors) {
+            if (neighbor_id >= agents_.size()) continue;
+            const auto neighbor = agents_[neighbor_id];
+            if (!neighbor.alive) continue;
             
-            // EMERGENT MIGRATION THRESHOLD: Decision varies by personality and circumstances
-            // Risk-tolerant agents migrate for smaller gains; risk-averse need bigger incentive
-            double personal_threshold = 0.1 + (1.0 - agent.openness) * 0.3 + agent.conformity * 0.2;
-            // Desperate agents (high hardship) lower their threshold
-            personal_threshold *= (1.0 - origin_econ.hardship * 0.5);
-            
-            if (destination != origin && best_gain > personal_threshold) {
-                // Remove from old region
-                auto& old_region_index = regionIndex_[origin];
-                old_region_index.erase(
-                    std::remove(old_region_index.begin(), old_region_index.end(), agent_id),
-                    old_region_index.end()
-                );
-                
-                // Add to new region
-                agent.region = destination;
-                regionIndex_[destination].push_back(agent_id);
-                
-                // Update regional aggregates incrementally
-                onAgentMigrated(agent_id, origin, destination);
-                
-                // Update economic sector for migrant (productivity hit, potential sector shift)
-                economy_.migrateAgent(agent_id, origin, destination);
-                
-                // Log migration event
-                event_log_.logMigration(generation_, agent_id, origin, destination);
-                
-                // EMERGENT NETWORK RETENTION: Preserve high-value connections instead of random
-                // Strong ties (high belief similarity) survive distance; weak ties break
-                if (agent.neighbors.size() > 2) {
-                    // Calculate connection value for each neighbor
-                    std::vector<std::pair<double, std::uint32_t>> scored_neighbors;
-                    scored_neighbors.reserve(agent.neighbors.size());
-                    
-                    for (std::uint32_t neighbor_id : agent.neighbors) {
-                        if (neighbor_id >= agents_.size()) continue;
-                        const auto& neighbor = agents_[neighbor_id];
-                        if (!neighbor.alive) continue;
-                        
-                        // Connection value: combination of belief similarity and social factors
-                        double belief_similarity = 0.0;
-                        for (int d = 0; d < 4; ++d) {
-                            double diff = agent.B[d] - neighbor.B[d];
-                            belief_similarity += diff * diff;
-                        }
-                        belief_similarity = 1.0 - std::sqrt(belief_similarity) / 4.0;  // normalize to [0,1]
-                        
-                        // Language bonus: shared language strengthens ties
-                        double lang_bonus = (agent.primaryLang == neighbor.primaryLang) ? 0.2 : 0.0;
-                        
-                        // Destination region bonus: connections in new region are valuable
-                        double region_bonus = (neighbor.region == destination) ? 0.3 : 0.0;
-                        
-                        // Origin region penalty: connections left behind decay faster
-                        double origin_penalty = (neighbor.region == origin) ? -0.1 : 0.0;
-                        
-                        double value = belief_similarity * 0.5 + lang_bonus + region_bonus + origin_penalty;
-                        
-                        // Sociable agents maintain more connections across distance
-                        value += agent.sociality * 0.2;
-                        
-                        scored_neighbors.emplace_back(value, neighbor_id);
-                    }
-                    
-                    // Sort by value descending
-                    std::sort(scored_neighbors.begin(), scored_neighbors.end(),
-                              [](const auto& a, const auto& b) { return a.first > b.first; });
-                    
-                    // Keep top connections based on sociality
-                    double retention_rate = 0.3 + agent.sociality * 0.4; // 30%-70% based on sociality
-                    
-                    // Long-distance moves lose more connections overall
-                    double distance_factor = std::abs(static_cast<int>(destination) - static_cast<int>(origin)) 
-                                            / static_cast<double>(cfg_.regions);
-                    retention_rate *= (1.0 - distance_factor * 0.2);
-                    
-                    retention_rate = std::clamp(retention_rate, 0.15, 0.85);
-                    std::size_t keep_count = static_cast<std::size_t>(scored_neighbors.size() * retention_rate);
-                    if (keep_count < 1) keep_count = 1;
-                    
-                    // Rebuild neighbors list with top valued connections
-                    agent.neighbors.clear();
-                    for (std::size_t i = 0; i < keep_count && i < scored_neighbors.size(); ++i) {
-                        agent.neighbors.push_back(scored_neighbors[i].second);
-                    }
-                }
+            // Connection value: combination of belief similarity and social factors
+            double belief_similarity = 0.0;
+            for (int d = 0; d < 4; ++d) {
+                double diff = static_cast<double>(agent.B[d]) - neighbor.B[d];
+                belief_similarity += diff * diff;
             }
+            belief_similarity = 1.0 - std::sqrt(belief_similarity) / 4.0;  // normalize to [0,1]
+            
+            // Language bonus: shared language strengthens ties
+            double lang_bonus = (agent.primaryLang == neighbor.primaryLang) ? 0.2 : 0.0;
+            
+            // Destination region bonus: connections in new region are valuable
+            double region_bonus = (neighbor.region == destination) ? 0.3 : 0.0;
+            
+            // Origin region penalty: connections left behind decay faster
+            double origin_penalty = (neighbor.region == origin) ? -0.1 : 0.0;
+            
+            double value = belief_similarity * 0.5 + lang_bonus + region_bonus + origin_penalty;
+            
+            // Sociable agents maintain more connections across distance
+            value += agent.sociality * 0.2;
+            
+            scored_neighbors.emplace_back(value, neighbor_id);
         }
+        
+        // Sort by value descending
+        std::sort(scored_neighbors.begin(), scored_neighbors.end(),
+                  [](const auto& a, const auto& b) { return a.first > b.first; });
+        
+        // Keep top connections based on sociality
+        double retention_rate = 0.3 + agent.sociality * 0.4; // 30%-70% based on sociality
+        
+        // Long-distance moves lose more connections overall
+        double distance_factor = std::abs(static_cast<int>(destination) - static_cast<int>(origin)) 
+                                / static_cast<double>(cfg_.regions);
+        retention_rate *= (1.0 - distance_factor * 0.2);
+        
+        retention_rate = std::clamp(retention_rate, 0.15, 0.85);
+        std::size_t keep_count = static_cast<std::size_t>(scored_neighbors.size() * retention_rate);
+        if (keep_count < 1) keep_count = 1;
+        
+        // Rebuild neighbors list with top valued connections
+        // (shrinks the CSR row in place; kept <= degree, so no relocation)
+        keep_count = std::min(keep_count, scored_neighbors.size());
+        std::uint32_t* row = agents_.graph.data(slot);
+        for (std::size_t i = 0; i < keep_count; ++i) {
+            row[i] = scored_neighbors[i].second;
+        }
+        agents_.graph.truncate(slot, static_cast<std::uint32_t>(keep_count));
     }
 }
 
 Kernel::Statistics Kernel::getStatistics() const {
+    if (statistics_version_ == state_version_) return statistics_cache_;
     Statistics stats;
-    
-    // Initialize
     stats.totalAgents = static_cast<std::uint32_t>(agents_.size());
-    stats.minAge = cfg_.maxAgeYears;
-    stats.maxAge = 0;
-    
-    // Age sum for average
-    std::uint64_t ageSum = 0;
-    std::uint64_t connectionSum = 0;
     
-    // Belief accumulators
-    std::array<double, 4> beliefSum = {0, 0, 0, 0};
-    std::vector<double> polarizations;
-    polarizations.reserve(agents_.size());
-    
-    // Regional population counts
-    std::vector<std::uint32_t> regionPops(cfg_.regions, 0);
-    
-    // Process each agent
-    for (const auto& agent : agents_) {
-        if (!agent.alive) continue;
-        
-        stats.aliveAgents++;
+    // One parallel pass over the columns; per-block partials merge in order
+    struct Partial {
+        std::uint32_t alive = 0;
+        std::uint32_t children = 0, youngAdults = 0, middleAge = 0, mature = 0, elderly = 0;
+        std::uint32_t males = 0, females = 0;
+        std::uint64_t ageSum = 0;
+        int minAge = std::numeric_limits<int>::max();
+        int maxAge = 0;
+        std::uint64_t connectionSum = 0;
+        std::uint32_t isolated = 0;
+        std::array<double, 4> beliefSum = {0, 0, 0, 0};
+        Moments polarization;
+        double incomeSum = 0.0;
+        std::array<std::uint32_t, 256> langCounts = {0};
+        
+        void merge(const Partial& o) {
+            alive += o.alive;
+            children += o.children;
+            youngAdults += o.youngAdults;
+            middleAge += o.middleAge;
+            mature += o.mature;
+            elderly += o.elderly;
+            males += o.males;
+            females += o.females;
+            ageSum += o.ageSum;
+            minAge = std::min(minAge, o.minAge);
+            maxAge = std::max(maxAge, o.maxAge);
+            connectionSum += o.connectionSum;
+            isolated += o.isolated;
+            for (int d = 0; d < 4; ++d) beliefSum[d] += o.beliefSum[d];
+            polarization.merge(o.polarization);
+            incomeSum += o.incomeSum;
+            for (int l = 0; l < 256; ++l) langCounts[l] += o.langCounts[l];
+        }
+    };
+    const auto p = reduceSlots<Partial>(agents_.size(), [this](std::size_t i, Partial& acc) {
+        if (!agents_.alive[i]) return;
+        acc.alive++;
         
         // Age demographics
-        ageSum += agent.age;
-        if (agent.age < stats.minAge) stats.minAge = agent.age;
-        if (agent.age > stats.maxAge) stats.maxAge = agent.age;
-        
-        // Age groups
-        if (agent.age < 15) stats.children++;
-        else if (agent.age < 30) stats.youngAdults++;
-        else if (agent.age < 50) stats.middleAge++;
-        else if (agent.age < 70) stats.mature++;
-        else stats.elderly++;
+        const int age = agents_.age[i];
+        acc.ageSum += age;
+        acc.minAge = std::min(acc.minAge, age);
+        acc.maxAge = std::max(acc.maxAge, age);
+        if (age < 15) acc.children++;
+        else if (age < 30) acc.youngAdults++;
+        else if (age < 50) acc.middleAge++;
+        else if (age < 70) acc.mature++;
+        else acc.elderly++;
         
         // Gender
-        if (agent.female) stats.females++;
-        else stats.males++;
+        if (agents_.female[i]) acc.females++;
+        else acc.males++;
         
         // Network
-        connectionSum += agent.neighbors.size();
-        if (agent.neighbors.empty()) stats.isolatedAgents++;
+        const auto degree = agents_.graph.degree(static_cast<std::uint32_t>(i));
+        acc.connectionSum += degree;
+        if (degree == 0) acc.isolated++;
         
         // Beliefs
-        for (int i = 0; i < 4; ++i) {
-            beliefSum[i] += agent.B[i];
-        }
-        double polarization = std::sqrt(agent.B_norm_sq);
-        polarizations.push_back(polarization);
-        
-        // Region
-        regionPops[agent.region]++;
-        
-        // Language
-        stats.langCounts[agent.primaryLang]++;
-    }
+        for (int d = 0; d < 4; ++d) acc.beliefSum[d] += agents_.B[i][d];
+        acc.polarization.add(std::sqrt(agents_.B_norm_sq[i]));
+        
+        acc.incomeSum += economy_.getAgentEconomy(i).income;
+        acc.langCounts[agents_.primaryLang[i]]++;
+    });
+    
+    stats.aliveAgents = p.alive;
+    stats.children = p.children;
+    stats.youngAdults = p.youngAdults;
+    stats.middleAge = p.middleAge;
+    stats.mature = p.mature;
+    stats.elderly = p.elderly;
+    stats.males = p.males;
+    stats.females = p.females;
+    stats.isolatedAgents = p.isolated;
+    stats.langCounts = p.langCounts;
+    stats.minAge = p.alive > 0 ? p.minAge : cfg_.maxAgeYears;
+    stats.maxAge = p.maxAge;
     
     // Compute averages
     if (stats.aliveAgents > 0) {
-        stats.avgAge = static_cast<double>(ageSum) / stats.aliveAgents;
-        stats.avgConnections = static_cast<double>(connectionSum) / stats.aliveAgents;
-        
+        stats.avgAge = static_cast<double>(p.ageSum) / stats.aliveAgents;
+        stats.avgConnections = static_cast<double>(p.connectionSum) / stats.aliveAgents;
         for (int i = 0; i < 4; ++i) {
-            stats.avgBeliefs[i] = beliefSum[i] / stats.aliveAgents;
+            stats.avgBeliefs[i] = p.beliefSum[i] / stats.aliveAgents;
         }
-        
-        // Polarization statistics
-        double polSum = 0.0;
-        for (double p : polarizations) {
-            polSum += p;
-        }
-        stats.polarizationMean = polSum / polarizations.size();
-        
-        double polVarSum = 0.0;
-        for (double p : polarizations) {
-            double diff = p - stats.polarizationMean;
-            polVarSum += diff * diff;
-        }
-        stats.polarizationStd = std::sqrt(polVarSum / polarizations.size());
+        stats.polarizationMean = p.polarization.mean();
+        stats.polarizationStd = p.polarization.stddev();
+        stats.avgIncome = p.incomeSum / stats.aliveAgents;
     }
     
-    // Regional statistics
+    // Regional statistics from the aggregates (O(R))
     std::uint32_t nonEmptyRegions = 0;
-    std::uint32_t minPop = cfg_.population;
+    std::uint32_t minPop = std::numeric_limits<std::uint32_t>::max();
     std::uint32_t maxPop = 0;
-    
-    for (auto pop : regionPops) {
-        if (pop > 0) {
+    for (const auto& agg : regional_aggregates_) {
+        if (agg.population > 0) {
             nonEmptyRegions++;
-            if (pop < minPop) minPop = pop;
-            if (pop > maxPop) maxPop = pop;
+            minPop = std::min(minPop, agg.population);
+            maxPop = std::max(maxPop, agg.population);
         }
     }
-    
     stats.occupiedRegions = nonEmptyRegions;
     if (nonEmptyRegions > 0) {
         stats.avgPopPerRegion = static_cast<double>(stats.aliveAgents) / nonEmptyRegions;
@@ -1403,23 +2528,35 @@ Kernel::Statistics Kernel::getStatistics() const {
         }
     }
     
-    // Economy metrics (from existing system)
-    auto metrics = computeMetrics();
+    // Economy metrics (memoized alongside)
+    const auto metrics = computeMetrics();
     stats.globalWelfare = metrics.globalWelfare;
     stats.globalInequality = metrics.globalInequality;
     
-    // Average income
-    double incomeSum = 0.0;
-    for (std::size_t i = 0; i < agents_.size(); ++i) {
-        if (agents_[i].alive) {
-            incomeSum += economy_.getAgentEconomy(i).income;
-        }
-    }
-    if (stats.aliveAgents > 0) {
-        stats.avgIncome = incomeSum / stats.aliveAgents;
+    statistics_cache_ = stats;
+    statistics_version_ = state_version_;
+    return stats;
+}
+
+void Kernel::measurePolarization(const std::vector<std::uint32_t>& populations,
+                                 const std::vector<std::array<double, 4>>& centroids,
+                                 const KernelConfig& cfg, std::uint64_t generation, Metrics& m) {
+    std::vector<std::array<double, 4>> occupied;
+    occupied.reserve(centroids.size());
+    for (std::size_t r = 0; r < centroids.size(); ++r) {
+        if (populations[r] > 0) occupied.push_back(centroids[r]);
     }
     
-    return stats;
+    // Pairwise distances between centroids: exact up to polarizationSampleRegions,
+    // sampled beyond (standard error ~ std / sqrt(64 R))
+    if (occupied.size() >= 2) {
+        const bool exact = cfg.polarizationSampleRegions == 0 ||
+                           occupied.size() <= cfg.polarizationSampleRegions;
+        const Moments dists = exact ? exactPairDistances(occupied)
+                                    : sampledPairDistances(occupied, cfg.seed, generation);
+        m.polarizationMean = dists.mean();
+        m.polarizationStd = dists.stddev();
+    }
 }
 
 // ============================================================================
@@ -1434,81 +2571,136 @@ void Kernel::rebuildRegionalAggregates() {
         agg.dirty = false;
     }
     
-    for (const auto& agent : agents_) {
-        if (!agent.alive) continue;
+    for (std::size_t i = 0; i < agents_.size(); ++i) {
+        if (!agents_.alive[i]) continue;
         
         // Validate region
-        if (agent.region >= cfg_.regions) {
+        if (agents_.region[i] >= cfg_.regions) {
             continue;  // Skip invalid (will be caught by validation)
         }
         
-        auto& agg = regional_aggregates_[agent.region];
+        auto& agg = regional_aggregates_[agents_.region[i]];
+        const auto& b = agents_.B[i];
         agg.population++;
-        agg.belief_sum[0] += agent.B[0];
-        agg.belief_sum[1] += agent.B[1];
-        agg.belief_sum[2] += agent.B[2];
-        agg.belief_sum[3] += agent.B[3];
+        agg.belief_sum[0] += b[0];
+        agg.belief_sum[1] += b[1];
+        agg.belief_sum[2] += b[2];
+        agg.belief_sum[3] += b[3];
     }
 }
 
-void Kernel::onAgentBorn(std::uint32_t agent_id) {
-    if (agent_id >= agents_.size()) return;
-    const auto& agent = agents_[agent_id];
-    if (!agent.alive || agent.region >= cfg_.regions) return;
-    
-    auto& agg = regional_aggregates_[agent.region];
-    agg.population++;
-    agg.belief_sum[0] += agent.B[0];
-    agg.belief_sum[1] += agent.B[1];
-    agg.belief_sum[2] += agent.B[2];
-    agg.belief_sum[3] += agent.B[3];
+void Kernel::onAgentsBorn(std::uint32_t firstSlot, std::uint32_t count) {
+    const std::size_t end = std::min(agents_.size(), static_cast<std::size_t>(firstSlot) + count);
+    if (activity_.enabled()) {
+        // Newcomers update from their first tick; the agents they tie into wake
+        activity_.resize(agents_.size());
+        std::uint64_t woken = 0;
+        for (std::size_t i = firstSlot; i < end; ++i) {
+            woken += activity_.wakeNeighbors(agents_.graph, static_cast<std::uint32_t>(i));
+        }
+        activity_.countWakes(0, 0, woken);
+    }
+    for (std::size_t i = firstSlot; i < end; ++i) {
+        if (!agents_.alive[i] || agents_.region[i] >= cfg_.regions) continue;
+        
+        auto& agg = regional_aggregates_[agents_.region[i]];
+        const auto& b = agents_.B[i];
+        agg.population++;
+        agg.belief_sum[0] += b[0];
+        agg.belief_sum[1] += b[1];
+        agg.belief_sum[2] += b[2];
+        agg.belief_sum[3] += b[3];
+    }
 }
 
-void Kernel::onAgentDied(std::uint32_t agent_id) {
-    if (agent_id >= agents_.size()) return;
-    const auto& agent = agents_[agent_id];
-    // Note: agent.alive may already be false when this is called
-    if (agent.region >= cfg_.regions) return;
-    
-    auto& agg = regional_aggregates_[agent.region];
-    if (agg.population > 0) {
+void Kernel::onAgentsDied(const std::vector<std::uint32_t>& slots) {
+    // Note: agents are already marked dead when this is called
+    if (activity_.enabled()) {
+        std::uint64_t woken = 0;
+        for (auto slot : slots) {
+            if (slot < agents_.size()) woken += activity_.wakeNeighbors(agents_.graph, slot);
+        }
+        activity_.countWakes(0, 0, woken);
+    }
+    for (auto slot : slots) {
+        if (slot >= agents_.size() || agents_.region[slot] >= cfg_.regions) continue;
+        
+        auto& agg = regional_aggregates_[agents_.region[slot]];
+        if (agg.population == 0) continue;
+        const auto& b = agents_.B[slot];
         agg.population--;
-        agg.belief_sum[0] -= agent.B[0];
-        agg.belief_sum[1] -= agent.B[1];
-        agg.belief_sum[2] -= agent.B[2];
-        agg.belief_sum[3] -= agent.B[3];
+        agg.belief_sum[0] -= b[0];
+        agg.belief_sum[1] -= b[1];
+        agg.belief_sum[2] -= b[2];
+        agg.belief_sum[3] -= b[3];
     }
 }
 
-void Kernel::onAgentMigrated(std::uint32_t agent_id, std::uint32_t from_region, std::uint32_t to_region) {
-    if (agent_id >= agents_.size()) return;
-    const auto& agent = agents_[agent_id];
-    if (!agent.alive) return;
-    if (from_region >= cfg_.regions || to_region >= cfg_.regions) return;
-    
-    // Remove from old region
-    auto& from_agg = regional_aggregates_[from_region];
-    if (from_agg.population > 0) {
-        from_agg.population--;
-        from_agg.belief_sum[0] -= agent.B[0];
-        from_agg.belief_sum[1] -= agent.B[1];
-        from_agg.belief_sum[2] -= agent.B[2];
-        from_agg.belief_sum[3] -= agent.B[3];
+void Kernel::onAgentsMigrated(const std::vector<MigrationMove>& moves) {
+    if (activity_.enabled()) {
+        std::uint64_t woken = 0;
+        for (const auto& move : moves) {
+            if (move.slot < agents_.size()) woken += activity_.wakeNeighbors(agents_.graph, move.slot);
+        }
+        activity_.countWakes(0, 0, woken);
     }
-    
-    // Add to new region
-    auto& to_agg = regional_aggregates_[to_region];
-    to_agg.population++;
-    to_agg.belief_sum[0] += agent.B[0];
-    to_agg.belief_sum[1] += agent.B[1];
-    to_agg.belief_sum[2] += agent.B[2];
-    to_agg.belief_sum[3] += agent.B[3];
+    for (const auto& move : moves) {
+        if (move.slot >= agents_.size() || !agents_.alive[move.slot]) continue;
+        if (move.origin >= cfg_.regions || move.destination >= cfg_.regions) continue;
+        const auto& b = agents_.B[move.slot];
+        
+        // Remove from old region
+        auto& from_agg = regional_aggregates_[move.origin];
+        if (from_agg.population > 0) {
+            from_agg.population--;
+            from_agg.belief_sum[0] -= b[0];
+            from_agg.belief_sum[1] -= b[1];
+            from_agg.belief_sum[2] -= b[2];
+            from_agg.belief_sum[3] -= b[3];
+        }
+        
+        // Add to new region
+        auto& to_agg = regional_aggregates_[move.destination];
+        to_agg.population++;
+        to_agg.belief_sum[0] += b[0];
+        to_agg.belief_sum[1] += b[1];
+        to_agg.belief_sum[2] += b[2];
+        to_agg.belief_sum[3] += b[3];
+    }
+}
+
+void Kernel::wakeShockedRegions(const std::vector<double>& hardshipBefore,
+                                const std::vector<EconomicSystem>& systemBefore) {
+    std::uint64_t woken = 0;
+    for (std::uint32_t r = 0; r < hardshipBefore.size() && r < regionIndex_.size(); ++r) {
+        const auto& region = economy_.getRegion(r);
+        if (std::abs(region.hardship - hardshipBefore[r]) < kActivityShockHardship &&
+            region.economic_system == systemBefore[r]) {
+            continue;
+        }
+        for (const auto slot : regionIndex_[r]) {
+            if (activity_.wake(slot)) ++woken;
+        }
+    }
+    activity_.countWakes(0, woken, 0);
+}
+
+void Kernel::updateRegionalAggregates(const BlockPartials& blockDeltas) {
+    // Touched rows only, blocks in order (same totals for any thread count)
+    blockDeltas.fold([this](std::uint32_t r, const double* d) {
+        for (int k = 0; k < 4; ++k) {
+            regional_aggregates_[r].belief_sum[k] += d[k];
+        }
+    });
 }
 
-void Kernel::updateRegionalAggregates() {
-    // Update belief sums based on current agent beliefs
-    // This is called when beliefs change but population doesn't
-    // For now, we use periodic full rebuild instead (cheaper than tracking all belief changes)
+void Kernel::updateRegionalAggregates(const std::vector<std::array<double, 4>>& regionDeltas) {
+    // Already reduced over blocks in block order (BeliefOffload::run)
+    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+        for (int d = 0; d < 4; ++d) {
+            regional_aggregates_[r].belief_sum[d] += regionDeltas[r][d];
+        }
+    }
 }
 
 // ============================================================================
@@ -1520,36 +2712,38 @@ void Kernel::reconnectIsolatedAgents() {
     // NOTE: This function is intentionally NOT parallelized because formLocalConnections
     // modifies shared state (neighbor lists). Sequential execution ensures thread safety.
     if (generation_ % TuningConstants::kReconnectInterval != 0) return;
+    CIV_PROFILE_SCOPE(profiler::Phase::Reconnect);
     
     std::size_t reconnected = 0;
     const std::size_t max_reconnections = static_cast<std::size_t>(
         agents_.size() * TuningConstants::kReconnectCapFraction);
     
     for (std::size_t i = 0; i < agents_.size() && reconnected < max_reconnections; ++i) {
-        Agent& agent = agents_[i];
-        if (!agent.alive) continue;
+        if (!agents_.alive[i]) continue;
+        const std::uint32_t region = agents_.region[i];
         
         // Count active local neighbors (in same region and alive)
         int active_neighbors = 0;
-        for (std::uint32_t n_idx : agent.neighbors) {
-            if (n_idx < agents_.size() && agents_[n_idx].alive && 
-                agents_[n_idx].region == agent.region) {
+        for (std::uint32_t n_idx : agents_.graph.row(static_cast<std::uint32_t>(i))) {
+            if (n_idx < agents_.size() && agents_.alive[n_idx] && 
+                agents_.region[n_idx] == region) {
                 active_neighbors++;
             }
         }
         
         // Desired connections based on sociality: sociable agents need more connections
-        int desired_min = static_cast<int>(2 + agent.sociality * 4); // 2-6
+        int desired_min = static_cast<int>(2 + agents_.sociality[i] * 4); // 2-6
         
         if (active_neighbors < desired_min) {
             formLocalConnections(i, desired_min - active_neighbors);
             reconnected++;
         }
     }
+    CIV_PROFILE_TOUCH(reconnected);
 }
 
 void Kernel::formLocalConnections(std::size_t agent_idx, int max_new_connections) {
-    Agent& agent = agents_[agent_idx];
+    auto agent = agents_[agent_idx];
     if (!agent.alive || agent.region >= regionIndex_.size()) return;
     
     const auto& local_agents = regionIndex_[agent.region];
@@ -1582,18 +2776,19 @@ void Kernel::formLocalConnections(std::size_t agent_idx, int max_new_connections
     }
     
     for (std::uint32_t c_idx : sampled_agents) {
-        if (c_idx == agent_idx || !agents_[c_idx].alive) continue;
+        if (c_idx == agent_idx || !agents_.alive[c_idx]) continue;
         if (existing.count(c_idx)) continue;
         
-        const Agent& candidate = agents_[c_idx];
+        const auto candidate = agents_[c_idx];
         
         // Score by compatibility
         // 1. Belief similarity (40% weight)
         double dot = 0.0, norm_a = 0.0, norm_c = 0.0;
         for (int b = 0; b < 4; ++b) {
-            dot += agent.B[b] * candidate.B[b];
-            norm_a += agent.B[b] * agent.B[b];
-            norm_c += candidate.B[b] * candidate.B[b];
+            const double ba = agent.B[b], bc = candidate.B[b];
+            dot += ba * bc;
+            norm_a += ba * ba;
+            norm_c += bc * bc;
         }
         double belief_sim = (norm_a > 1e-9 && norm_c > 1e-9) ?
             dot / (std::sqrt(norm_a) * std::sqrt(norm_c)) : 0.0;
@@ -1633,8 +2828,7 @@ void Kernel::formLocalConnections(std::size_t agent_idx, int max_new_connections
         
         if (prob_dist(rng_) < connect_prob) {
             // Add bidirectional connection
-            agent.neighbors.push_back(c_idx);
-            agents_[c_idx].neighbors.push_back(static_cast<std::uint32_t>(agent_idx));
+            agents_.graph.connect(static_cast<std::uint32_t>(agent_idx), c_idx);
             formed++;
         }
     }
@@ -1656,10 +2850,11 @@ void Kernel::updateLanguageDynamics() {
     std::vector<LangStats> stats(cfg_.regions);
     
     // Gather language statistics
-    for (const auto& agent : agents_) {
+    for (std::uint32_t slot = 0; slot < agents_.size(); ++slot) {
+        const auto agent = agents_[slot];
         if (!agent.alive || agent.primaryLang >= 4 || agent.region >= cfg_.regions) continue;
         stats[agent.region].speakers[agent.primaryLang]++;
-        stats[agent.region].total_wealth[agent.primaryLang] += economy_.getAgentEconomy(agent.id).wealth;
+        stats[agent.region].total_wealth[agent.primaryLang] += economy_.getAgentEconomy(slot).wealth;
     }
     
     // Update regional language prestige
@@ -1709,7 +2904,7 @@ void Kernel::updateLanguageDynamics() {
     // Language shift for young agents
     std::uniform_real_distribution<double> prob_dist(0.0, 1.0);
     
-    for (auto& agent : agents_) {
+    for (auto agent : agents_) {
         if (!agent.alive || agent.age > 25 || agent.primaryLang >= 4) continue;
         
         const auto& region = economy_.getRegion(agent.region);
@@ -1736,6 +2931,7 @@ void Kernel::updateLanguageDynamics() {
         
         if (prob_dist(rng_) < shift_prob) {
             agent.primaryLang = region.dominant_language;
+            agents_.touch();
             // Partial dialect blending
             agent.dialect = static_cast<std::uint8_t>(
                 agent.dialect * 0.7 + (region.dominant_language * 25) * 0.3
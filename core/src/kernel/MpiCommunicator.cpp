@@ -0,0 +1,80 @@
+#include "kernel/Communicator.h"
+#include <mpi.h>
+#include <limits>
+#include <string>
+#include <stdexcept>
+
+struct MpiCommunicator::Handle {
+    MPI_Comm comm = MPI_COMM_NULL;
+};
+
+namespace {
+
+void check(int status, const char* what) {
+    if (status != MPI_SUCCESS) throw std::runtime_error(std::string("MPI error in ") + what);
+}
+
+int toInt(std::size_t n, const char* what) {
+    if (n > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        throw std::length_error(std::string(what) + ": message exceeds 2 GiB");
+    }
+    return static_cast<int>(n);
+}
+
+}  // namespace
+
+MpiCommunicator::MpiCommunicator() : handle_(std::make_unique<Handle>()) {
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (!initialized) throw std::logic_error("MpiCommunicator: MPI_Init has not been called");
+    check(MPI_Comm_dup(MPI_COMM_WORLD, &handle_->comm), "MPI_Comm_dup");
+    MPI_Comm_rank(handle_->comm, &rank_);
+    MPI_Comm_size(handle_->comm, &size_);
+}
+
+MpiCommunicator::~MpiCommunicator() {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized && handle_->comm != MPI_COMM_NULL) MPI_Comm_free(&handle_->comm);
+}
+
+std::vector<double> MpiCommunicator::allgather(const double* data, std::size_t count) {
+    std::vector<double> out(count * static_cast<std::size_t>(size_));
+    check(MPI_Allgather(data, toInt(count, "allgather"), MPI_DOUBLE, out.data(), toInt(count, "allgather"),
+                        MPI_DOUBLE, handle_->comm),
+          "MPI_Allgather");
+    return out;
+}
+
+std::vector<Communicator::Bytes> MpiCommunicator::exchange(std::vector<Bytes> send) {
+    const auto n = static_cast<std::size_t>(size_);
+    if (send.size() != n) throw std::invalid_argument("exchange: expected one buffer per rank");
+
+    // Sizes first, then one all-to-all of the packed payloads
+    std::vector<int> sendCounts(n), recvCounts(n), sendOffsets(n), recvOffsets(n);
+    for (std::size_t p = 0; p < n; ++p) sendCounts[p] = toInt(send[p].size(), "exchange");
+    check(MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, handle_->comm),
+          "MPI_Alltoall");
+
+    std::size_t sendTotal = 0, recvTotal = 0;
+    for (std::size_t p = 0; p < n; ++p) {
+        sendOffsets[p] = toInt(sendTotal, "exchange");
+        recvOffsets[p] = toInt(recvTotal, "exchange");
+        sendTotal += static_cast<std::size_t>(sendCounts[p]);
+        recvTotal += static_cast<std::size_t>(recvCounts[p]);
+    }
+    Bytes packed;
+    packed.reserve(sendTotal);
+    for (const auto& buffer : send) packed.insert(packed.end(), buffer.begin(), buffer.end());
+    Bytes incoming(recvTotal);
+    check(MPI_Alltoallv(packed.data(), sendCounts.data(), sendOffsets.data(), MPI_BYTE, incoming.data(),
+                        recvCounts.data(), recvOffsets.data(), MPI_BYTE, handle_->comm),
+          "MPI_Alltoallv");
+
+    std::vector<Bytes> received(n);
+    for (std::size_t p = 0; p < n; ++p) {
+        const auto first = incoming.begin() + recvOffsets[p];
+        received[p].assign(first, first + recvCounts[p]);
+    }
+    return received;
+}
@@ -0,0 +1,757 @@
+#include "kernel/ShardedKernel.h"
+#include "utils/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+namespace {
+
+using Bytes = Communicator::Bytes;
+
+// ---- Wire helpers: trivially copyable values, native byte order ----
+
+template <typename T>
+void put(Bytes& out, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "wire values must be trivially copyable");
+    const auto* p = reinterpret_cast<const std::uint8_t*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+template <typename T>
+void putAll(Bytes& out, const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable<T>::value, "wire values must be trivially copyable");
+    const auto* p = reinterpret_cast<const std::uint8_t*>(values.data());
+    out.insert(out.end(), p, p + values.size() * sizeof(T));
+}
+
+class Reader {
+public:
+    explicit Reader(const Bytes& in) : in_(in) {}
+
+    template <typename T>
+    T take() {
+        static_assert(std::is_trivially_copyable<T>::value, "wire values must be trivially copyable");
+        if (at_ + sizeof(T) > in_.size()) throw std::runtime_error("ShardedKernel: truncated message");
+        T value;
+        std::memcpy(&value, in_.data() + at_, sizeof(T));
+        at_ += sizeof(T);
+        return value;
+    }
+
+    bool done() const { return at_ == in_.size(); }
+
+private:
+    const Bytes& in_;
+    std::size_t at_ = 0;
+};
+
+template <typename T>
+std::vector<T> takeAll(const Bytes& in) {
+    if (in.size() % sizeof(T) != 0) throw std::runtime_error("ShardedKernel: malformed message");
+    std::vector<T> values(in.size() / sizeof(T));
+    if (!values.empty()) std::memcpy(values.data(), in.data(), in.size());
+    return values;
+}
+
+// One mirrored agent: what a remote edge reads in the belief kernels
+struct HaloRecord {
+    std::array<double, 4> B;
+    double fluency;
+    double m_comm;
+    std::uint8_t alive;
+    std::uint8_t lang;
+};
+
+// A migrant in transit; followed on the wire by `ties` local IDs kept on the
+// origin shard and `remotes` (rank, ID) pairs of its remote edges
+struct MigrantRecord {
+    std::uint32_t region;
+    std::int32_t age;
+    std::uint32_t lineage_id;
+    std::uint8_t female;
+    std::uint8_t primaryLang;
+    std::uint8_t dialect;
+    std::uint8_t has_disease;  // HealthState::current_disease is remapped on arrival
+    double fluency;
+    double openness;
+    double conformity;
+    double assertiveness;
+    double sociality;
+    std::array<double, 4> x;
+    std::array<double, 4> B;
+    double B_norm_sq;
+    double m_comm;
+    double m_susceptibility;
+    double m_mobility;
+    PsychologicalState psych;
+    HealthState health;
+    AgentEconomy economy;
+    std::uint32_t ties;
+    std::uint32_t remotes;
+};
+
+std::uint64_t mixSeed(std::uint64_t seed, int rank) {
+    // splitmix64 finalizer over (seed, rank)
+    std::uint64_t z = seed + 0x9E3779B97F4A7C15ULL * (static_cast<std::uint64_t>(rank) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Split a world total between ranks by their share of the regions
+std::uint32_t shareOf(std::uint32_t total, ShardedKernel::RegionRange range, std::uint32_t regions) {
+    const auto upTo = [&](std::uint32_t r) {
+        return static_cast<std::uint64_t>(total) * r / regions;
+    };
+    return static_cast<std::uint32_t>(upTo(range.end) - upTo(range.begin));
+}
+
+// Region fields each shard computes for the regions it owns (agent-derived
+// or evolved from them); everything else in RegionalEconomy is either fixed
+// geography or recomputed identically everywhere from replicated inputs
+template <typename Region, typename Visit>
+void forEachOwnedField(Region& r, Visit&& visit) {
+    for (auto& v : r.specialization) visit(v);
+    for (auto& v : r.production) visit(v);
+    for (auto& v : r.consumption) visit(v);
+    for (auto& v : r.prices) visit(v);
+    for (auto& v : r.trade_balance) visit(v);
+    for (auto& v : r.tech_multipliers) visit(v);
+    visit(r.welfare);
+    visit(r.inequality);
+    visit(r.hardship);
+    visit(r.development);
+    visit(r.wealth_top_10);
+    visit(r.wealth_bottom_50);
+    visit(r.economic_system);
+    visit(r.system_stability);
+    visit(r.pending_system);
+    visit(r.transition_pressure_ticks);
+    visit(r.institutional_inertia);
+    visit(r.years_in_current_system);
+    for (auto& v : r.language_prestige) visit(v);
+    visit(r.dominant_language);
+    visit(r.linguistic_diversity);
+    visit(r.efficiency);
+}
+
+template <typename T>
+double toWire(T value) {
+    if constexpr (std::is_enum<T>::value) {
+        return static_cast<double>(static_cast<std::underlying_type_t<T>>(value));
+    } else {
+        return static_cast<double>(value);
+    }
+}
+
+template <typename T>
+void fromWire(double wire, T& value) {
+    if constexpr (std::is_enum<T>::value) {
+        value = static_cast<T>(static_cast<std::underlying_type_t<T>>(wire));
+    } else {
+        value = static_cast<T>(wire);
+    }
+}
+
+std::size_t ownedFieldCount() {
+    RegionalEconomy probe;
+    std::size_t count = 0;
+    forEachOwnedField(probe, [&](auto&) { ++count; });
+    return count;
+}
+
+}  // namespace
+
+// ============================================================================
+// PARTITION
+// ============================================================================
+
+ShardedKernel::RegionRange ShardedKernel::regionRange(std::uint32_t regions, int rank, int ranks) {
+    const auto bound = [&](int r) {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(regions) * static_cast<std::uint64_t>(r) /
+                                          static_cast<std::uint64_t>(ranks));
+    };
+    return RegionRange{bound(rank), bound(rank + 1)};
+}
+
+int ShardedKernel::ownerOf(std::uint32_t region, std::uint32_t regions, int ranks) {
+    int rank = static_cast<int>(static_cast<std::uint64_t>(region) * static_cast<std::uint64_t>(ranks) / regions);
+    while (rank > 0 && regionRange(regions, rank, ranks).begin > region) --rank;
+    while (rank + 1 < ranks && regionRange(regions, rank, ranks).end <= region) ++rank;
+    return rank;
+}
+
+ShardedKernel::ShardedKernel(const KernelConfig& cfg, Communicator& comm) : cfg_(cfg), comm_(comm) {
+    const int ranks = comm_.size();
+    if (cfg_.regions < static_cast<std::uint32_t>(ranks)) {
+        throw std::invalid_argument("ShardedKernel needs at least one region per shard (regions " +
+                                    std::to_string(cfg_.regions) + ", shards " + std::to_string(ranks) + ")");
+    }
+    if (cfg_.liveClusters > 0) throw std::invalid_argument("ShardedKernel does not support liveClusters");
+    if (cfg_.backgroundPopulation > 0) {
+        throw std::invalid_argument("ShardedKernel does not support backgroundPopulation");
+    }
+    range_ = regionRange(cfg_.regions, rank(), ranks);
+
+    std::uint64_t world = 0;
+    shard_populations_.resize(static_cast<std::size_t>(ranks));
+    for (int r = 0; r < ranks; ++r) {
+        shard_populations_[r] = shareOf(cfg_.population, regionRange(cfg_.regions, r, ranks), cfg_.regions);
+        world += shard_populations_[r];
+    }
+    const std::uint32_t own = shard_populations_[static_cast<std::size_t>(rank())];
+    const double localShare = world > 0 ? static_cast<double>(own) / static_cast<double>(world) : 1.0;
+
+    // Every shard draws the same geography; agents come from per-rank streams
+    KernelConfig local = cfg_;
+    local.population = own;
+    local.maxPopulation = std::max(own, shareOf(cfg_.maxPopulation, range_, cfg_.regions));
+    local.geographySeed = cfg_.geographySeed != 0 ? cfg_.geographySeed : cfg_.seed;
+    if (rank() != 0) local.seed = mixSeed(cfg_.seed, rank());
+    // Rewired edges land on a shard in proportion to its agents
+    local.rewireProb = cfg_.rewireProb * localShare;
+
+    need_.assign(static_cast<std::size_t>(ranks), {});
+    serve_.assign(static_cast<std::size_t>(ranks), {});
+    need_offset_.assign(static_cast<std::size_t>(ranks) + 1, 0);
+
+    kernel_.reset(new Kernel(local, *this));
+    linkShards(cfg_.rewireProb * (1.0 - localShare));
+    reduceRegions();  // Migration looks at every region's population from the first tick
+}
+
+ShardedKernel::~ShardedKernel() = default;
+
+void ShardedKernel::step() {
+    kernel_->step();
+}
+
+void ShardedKernel::stepN(int n) {
+    for (int i = 0; i < n; ++i) {
+        step();
+    }
+}
+
+// ============================================================================
+// CROSS-SHARD EDGES
+// ============================================================================
+
+void ShardedKernel::linkShards(double remoteRewire) {
+    const int ranks = comm_.size();
+    if (ranks == 1) return;
+    const auto self = static_cast<std::size_t>(rank());
+    const std::uint64_t others = [&] {
+        std::uint64_t total = 0;
+        for (std::size_t p = 0; p < shard_populations_.size(); ++p) {
+            if (p != self) total += shard_populations_[p];
+        }
+        return total;
+    }();
+
+    // Second rewiring pass over the ring lattice: each edge moves to a
+    // uniformly chosen agent of another shard with probability remoteRewire
+    auto& graph = kernel_->agents_.graph;
+    const std::uint32_t n = shard_populations_[self];
+    std::uint32_t K = cfg_.avgConnections;
+    if (K % 2) ++K;
+    std::mt19937_64 rng(kernel_->cfg_.seed ^ 0xD1B54A32D192ED03ULL);
+    std::uniform_real_distribution<double> uniDist(0.0, 1.0);
+    std::vector<Bytes> send(static_cast<std::size_t>(ranks));
+    if (others > 0 && n > 1) {
+        std::uniform_int_distribution<std::uint64_t> targetDist(0, others - 1);
+        for (std::uint32_t i = 0; i < n; ++i) {
+            for (std::uint32_t d = 1; d <= K / 2; ++d) {
+                if (uniDist(rng) >= remoteRewire) continue;
+                const std::uint32_t j = (i + d) % n;
+                if (j == i || graph.erase(i, j) == 0) continue;
+                graph.erase(j, i);
+
+                std::uint64_t pick = targetDist(rng);
+                std::uint32_t peer = 0;
+                for (; peer < shard_populations_.size(); ++peer) {
+                    if (peer == self) continue;
+                    if (pick < shard_populations_[peer]) break;
+                    pick -= shard_populations_[peer];
+                }
+                const auto remote = static_cast<std::uint32_t>(pick);
+                edges_.push_back({i, peer, remote});
+                put(send[peer], remote);
+                put(send[peer], i);
+            }
+        }
+        graph.repack();
+    }
+
+    // The other end of each edge points back here
+    const auto received = comm_.exchange(std::move(send));
+    for (std::size_t p = 0; p < received.size(); ++p) {
+        Reader in(received[p]);
+        while (!in.done()) {
+            const auto local = in.take<std::uint32_t>();
+            const auto remote = in.take<std::uint32_t>();
+            edges_.push_back({local, static_cast<std::uint32_t>(p), remote});
+        }
+    }
+    sortEdges();
+    plan_dirty_ = true;
+}
+
+void ShardedKernel::sortEdges() {
+    const auto key = [](const RemoteEdge& e) { return std::make_tuple(e.local, e.peer, e.remote); };
+    std::sort(edges_.begin(), edges_.end(), [&](const RemoteEdge& a, const RemoteEdge& b) {
+        return std::make_tuple(a.local, a.peer, a.remote, a.halo) < std::make_tuple(b.local, b.peer, b.remote, b.halo);
+    });
+    edges_.erase(std::unique(edges_.begin(), edges_.end(),
+                             [&](const RemoteEdge& a, const RemoteEdge& b) { return key(a) == key(b); }),
+                 edges_.end());
+}
+
+void ShardedKernel::rebuildPlan() {
+    const auto& agents = kernel_->agents_;
+    const auto ranks = static_cast<std::size_t>(comm_.size());
+
+    // Drop edges whose local end is gone or whose remote end was last seen dead
+    edges_.erase(std::remove_if(edges_.begin(), edges_.end(),
+                                [&](const RemoteEdge& e) {
+                                    const auto slot = agents.slotOf(e.local);
+                                    if (slot == AgentStore::kNoSlot || !agents.alive[slot]) return true;
+                                    return e.halo != kNoHalo && e.halo < halo_alive_.size() &&
+                                           !halo_alive_[e.halo];
+                                }),
+                 edges_.end());
+
+    // Mirror each remote agent once, however many local edges reach it
+    for (auto& ids : need_) ids.clear();
+    for (const auto& e : edges_) need_[e.peer].push_back(e.remote);
+    std::vector<Bytes> requests(ranks);
+    for (std::size_t p = 0; p < ranks; ++p) {
+        auto& ids = need_[p];
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        putAll(requests[p], ids);
+        need_offset_[p + 1] = need_offset_[p] + static_cast<std::uint32_t>(ids.size());
+    }
+    const auto asked = comm_.exchange(std::move(requests));
+    for (std::size_t p = 0; p < ranks; ++p) serve_[p] = takeAll<std::uint32_t>(asked[p]);
+
+    halo_targets_.resize(edges_.size());
+    for (std::size_t k = 0; k < edges_.size(); ++k) {
+        auto& e = edges_[k];
+        const auto& ids = need_[e.peer];
+        e.halo = need_offset_[e.peer] +
+                 static_cast<std::uint32_t>(std::lower_bound(ids.begin(), ids.end(), e.remote) - ids.begin());
+        halo_targets_[k] = e.halo;
+    }
+
+    const std::size_t rows = need_offset_[ranks];
+    halo_B_.resize(rows);
+    halo_norm_sq_.resize(rows);
+    halo_alive_.assign(rows, 0);
+    halo_lang_.resize(rows);
+    halo_fluency_.resize(rows);
+    halo_comm_.resize(rows);
+    plan_dirty_ = false;
+}
+
+std::vector<double> ShardedKernel::gatherOwned(const std::vector<double>& block, std::size_t width) {
+    const int ranks = comm_.size();
+    Bytes payload;
+    putAll(payload, block);
+    std::vector<Bytes> send(static_cast<std::size_t>(ranks));
+    for (int p = 0; p < ranks; ++p) {
+        if (p != rank()) send[p] = payload;
+    }
+    traffic_.bytesSent += outgoing(send);
+    const auto received = comm_.exchange(std::move(send));
+
+    std::vector<double> all(static_cast<std::size_t>(cfg_.regions) * width);
+    for (int p = 0; p < ranks; ++p) {
+        const auto owned = regionRange(cfg_.regions, p, ranks);
+        const auto values = p == rank() ? block : takeAll<double>(received[p]);
+        if (values.size() != owned.size() * width) throw std::runtime_error("ShardedKernel: region block mismatch");
+        std::copy(values.begin(), values.end(), all.begin() + static_cast<std::ptrdiff_t>(owned.begin * width));
+    }
+    return all;
+}
+
+std::uint64_t ShardedKernel::outgoing(const std::vector<Communicator::Bytes>& buffers) const {
+    std::uint64_t bytes = 0;
+    for (std::size_t p = 0; p < buffers.size(); ++p) {
+        if (static_cast<int>(p) != rank()) bytes += buffers[p].size();
+    }
+    return bytes;
+}
+
+// ============================================================================
+// KERNEL HOOKS
+// ============================================================================
+
+void ShardedKernel::exchangeHalo() {
+    CIV_PROFILE_SCOPE(profiler::Phase::Shards);
+    // Any shard may have seen a death or a new edge; the plan is agreed together
+    double dirty = plan_dirty_ ? 1.0 : 0.0;
+    comm_.allreduceSum(&dirty, 1);
+    if (dirty > 0.0) rebuildPlan();
+
+    const auto& agents = kernel_->agents_;
+    const auto ranks = static_cast<std::size_t>(comm_.size());
+    std::vector<Bytes> send(ranks);
+    std::uint64_t served = 0;
+    for (std::size_t p = 0; p < ranks; ++p) {
+        send[p].reserve(serve_[p].size() * sizeof(HaloRecord));
+        for (auto id : serve_[p]) {
+            HaloRecord rec{};
+            const auto slot = agents.slotOf(id);
+            if (slot != AgentStore::kNoSlot && agents.alive[slot]) {
+                rec.B = agents.B[slot];
+                rec.fluency = agents.fluency[slot];
+                rec.m_comm = agents.m_comm[slot];
+                rec.lang = agents.primaryLang[slot];
+                rec.alive = 1;
+            }
+            put(send[p], rec);
+        }
+        served += serve_[p].size();
+    }
+    traffic_.bytesSent += outgoing(send);
+    const auto received = comm_.exchange(std::move(send));
+
+    for (std::size_t p = 0; p < ranks; ++p) {
+        const auto records = takeAll<HaloRecord>(received[p]);
+        if (records.size() != need_[p].size()) throw std::runtime_error("ShardedKernel: halo size mismatch");
+        for (std::size_t k = 0; k < records.size(); ++k) {
+            const auto row = need_offset_[p] + k;
+            const auto& rec = records[k];
+            halo_B_[row] = rec.B;
+            halo_norm_sq_[row] = rec.B[0] * rec.B[0] + rec.B[1] * rec.B[1] + rec.B[2] * rec.B[2] + rec.B[3] * rec.B[3];
+            halo_alive_[row] = rec.alive;
+            halo_lang_[row] = rec.lang;
+            halo_fluency_[row] = rec.fluency;
+            halo_comm_[row] = rec.m_comm;
+            if (!rec.alive) plan_dirty_ = true;
+        }
+    }
+
+    // Group edges by local agent; slots are resolved fresh (compaction moves them)
+    halo_rows_.clear();
+    for (std::size_t k = 0; k < edges_.size();) {
+        std::size_t end = k + 1;
+        while (end < edges_.size() && edges_[end].local == edges_[k].local) ++end;
+        const auto slot = agents.slotOf(edges_[k].local);
+        if (slot != AgentStore::kNoSlot && agents.alive[slot]) {
+            halo_rows_.push_back({slot, static_cast<std::uint32_t>(k), static_cast<std::uint32_t>(end - k)});
+        } else {
+            plan_dirty_ = true;
+        }
+        k = end;
+    }
+
+    traffic_.haloEdges = edges_.size();
+    traffic_.haloAgents = need_offset_[ranks];
+    traffic_.served = served;
+}
+
+void ShardedKernel::addHaloInfluence(const belief_kernels::Columns& cols,
+                                     const belief_kernels::HybridParams& params,
+                                     std::vector<NeighborInfluence>& out) const {
+    belief_kernels::Columns halo;
+    halo.B = halo_B_.data();
+    halo.B_norm_sq = halo_norm_sq_.data();
+    halo.alive = halo_alive_.data();
+    halo.lang = halo_lang_.data();
+    halo.fluency = halo_fluency_.data();
+    halo.m_comm = halo_comm_.data();
+    halo.n = halo_B_.size();
+
+    // One row per local agent, so rows never share an output slot
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(halo_rows_.size()); ++k) {
+        const auto& row = halo_rows_[k];
+        belief_kernels::hybridHalo(cols, row.slot, halo, halo_targets_.data() + row.first, row.count, params,
+                                   out[row.slot]);
+    }
+}
+
+void ShardedKernel::addHaloInfluence(const belief_kernels::Columns& cols,
+                                     const belief_kernels::PairwiseParams& params,
+                                     const std::vector<double>& susceptibility,
+                                     std::vector<std::array<double, 4>>& dx) const {
+    belief_kernels::Columns halo;
+    halo.B = halo_B_.data();
+    halo.B_norm_sq = halo_norm_sq_.data();
+    halo.alive = halo_alive_.data();
+    halo.lang = halo_lang_.data();
+    halo.fluency = halo_fluency_.data();
+    halo.m_comm = halo_comm_.data();
+    halo.n = halo_B_.size();
+
+    #pragma omp parallel for schedule(static)
+    for (std::ptrdiff_t k = 0; k < static_cast<std::ptrdiff_t>(halo_rows_.size()); ++k) {
+        const auto& row = halo_rows_[k];
+        belief_kernels::pairwiseHalo(cols, row.slot, susceptibility[row.slot], halo,
+                                     halo_targets_.data() + row.first, row.count, params, dx[row.slot]);
+    }
+}
+
+void ShardedKernel::exchangeMigrants() {
+    CIV_PROFILE_SCOPE(profiler::Phase::Shards);
+    Kernel& k = *kernel_;
+    auto& agents = k.agents_;
+    const int ranks = comm_.size();
+    if (ranks == 1) return;
+    const auto self = static_cast<std::uint32_t>(rank());
+
+    // Movers sit in the index rows of regions this shard does not own
+    std::vector<Bytes> send(static_cast<std::size_t>(ranks));
+    std::vector<std::vector<std::vector<std::uint32_t>>> kept(static_cast<std::size_t>(ranks));
+    std::vector<std::uint32_t> leaving;
+    std::vector<std::uint32_t> leavingIds;
+    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+        if (range_.contains(r)) continue;
+        const auto peer = static_cast<std::size_t>(ownerOf(r, cfg_.regions, ranks));
+        for (auto slot : k.regionIndex_[r]) {
+            if (!agents.alive[slot]) continue;
+            const auto id = agents.id[slot];
+
+            // Ties to agents staying here become remote edges; its remote
+            // edges travel with it
+            std::vector<std::uint32_t> ties;
+            for (auto v : agents.graph.row(slot)) {
+                if (v < agents.size() && agents.alive[v] && range_.contains(agents.region[v])) {
+                    ties.push_back(agents.id[v]);
+                }
+            }
+            const auto first = std::lower_bound(edges_.begin(), edges_.end(), id,
+                                                [](const RemoteEdge& e, std::uint32_t v) { return e.local < v; });
+            auto last = first;
+            while (last != edges_.end() && last->local == id) ++last;
+
+            MigrantRecord rec{};
+            rec.region = r;
+            rec.age = agents.age[slot];
+            rec.lineage_id = agents.lineage_id[slot];
+            rec.female = agents.female[slot];
+            rec.primaryLang = agents.primaryLang[slot];
+            rec.dialect = agents.dialect[slot];
+            rec.fluency = agents.fluency[slot];
+            rec.openness = agents.openness[slot];
+            rec.conformity = agents.conformity[slot];
+            rec.assertiveness = agents.assertiveness[slot];
+            rec.sociality = agents.sociality[slot];
+            rec.x = agents.x[slot];
+            rec.B = agents.B[slot];
+            rec.B_norm_sq = agents.B_norm_sq[slot];
+            rec.m_comm = agents.m_comm[slot];
+            rec.m_susceptibility = agents.m_susceptibility[slot];
+            rec.m_mobility = agents.m_mobility[slot];
+            rec.psych = agents.psych[slot];
+            rec.health = agents.health[slot];
+            rec.has_disease = rec.health.current_disease != nullptr;
+            rec.health.current_disease = nullptr;
+            rec.economy = k.economy_.getAgentEconomy(slot);
+            rec.ties = static_cast<std::uint32_t>(ties.size());
+            rec.remotes = static_cast<std::uint32_t>(last - first);
+
+            auto& out = send[peer];
+            put(out, rec);
+            putAll(out, ties);
+            for (auto e = first; e != last; ++e) {
+                put(out, e->peer);
+                put(out, e->remote);
+            }
+            kept[peer].push_back(std::move(ties));
+            leaving.push_back(slot);
+            leavingIds.push_back(id);
+        }
+        k.regionIndex_[r].clear();
+    }
+
+    // Gone from here: dead to this shard's passes, compacted later
+    for (auto slot : leaving) agents.alive[slot] = 0;
+    k.onAgentsDied(leaving);
+    std::sort(leavingIds.begin(), leavingIds.end());
+    edges_.erase(std::remove_if(edges_.begin(), edges_.end(),
+                                [&](const RemoteEdge& e) {
+                                    return std::binary_search(leavingIds.begin(), leavingIds.end(), e.local);
+                                }),
+                 edges_.end());
+    traffic_.emigrants += leaving.size();
+    traffic_.bytesSent += outgoing(send);
+    const auto arriving = comm_.exchange(std::move(send));
+
+    // Arrivals get fresh IDs here; the reply tells each origin which
+    std::vector<Agent> newcomers;
+    std::vector<AgentEconomy> economies;
+    std::vector<Bytes> reply(static_cast<std::size_t>(ranks));
+    for (std::size_t p = 0; p < arriving.size(); ++p) {
+        Reader in(arriving[p]);
+        while (!in.done()) {
+            const auto rec = in.take<MigrantRecord>();
+            if (!range_.contains(rec.region)) throw std::runtime_error("ShardedKernel: migrant sent to the wrong shard");
+            Agent a;
+            a.id = k.nextAgentId_++;
+            a.region = rec.region;
+            a.alive = true;
+            a.age = rec.age;
+            a.female = rec.female != 0;
+            a.lineage_id = rec.lineage_id;  // Parents stay behind on the origin shard
+            a.primaryLang = rec.primaryLang;
+            a.dialect = rec.dialect;
+            a.fluency = rec.fluency;
+            a.openness = rec.openness;
+            a.conformity = rec.conformity;
+            a.assertiveness = rec.assertiveness;
+            a.sociality = rec.sociality;
+            a.x = rec.x;
+            a.B = rec.B;
+            a.B_norm_sq = rec.B_norm_sq;
+            a.m_comm = rec.m_comm;
+            a.m_susceptibility = rec.m_susceptibility;
+            a.m_mobility = rec.m_mobility;
+            a.psych = rec.psych;
+            a.health = rec.health;
+            a.health.current_disease = rec.has_disease ? k.health_.baselineDisease() : nullptr;
+
+            for (std::uint32_t t = 0; t < rec.ties; ++t) {
+                edges_.push_back({a.id, static_cast<std::uint32_t>(p), in.take<std::uint32_t>()});
+            }
+            for (std::uint32_t t = 0; t < rec.remotes; ++t) {
+                const auto peer = in.take<std::uint32_t>();
+                const auto remote = in.take<std::uint32_t>();
+                if (peer != self) {
+                    edges_.push_back({a.id, peer, remote});
+                    continue;
+                }
+                // A remote tie into this shard is now a local one
+                const auto slot = agents.slotOf(remote);
+                if (slot != AgentStore::kNoSlot && agents.alive[slot]) a.neighbors.push_back(slot);
+            }
+            put(reply[p], a.id);
+            newcomers.push_back(std::move(a));
+            economies.push_back(rec.economy);
+        }
+    }
+    if (!newcomers.empty()) {
+        const auto firstSlot = static_cast<std::uint32_t>(agents.size());
+        k.appendAgents(newcomers);
+        for (std::size_t i = 0; i < economies.size(); ++i) {
+            k.economy_.getAgentEconomy(firstSlot + static_cast<std::uint32_t>(i)) = economies[i];
+        }
+    }
+    traffic_.immigrants += newcomers.size();
+    traffic_.bytesSent += outgoing(reply);
+
+    // Agents that kept a tie to a migrant now reach it on its new shard
+    const auto issued = comm_.exchange(std::move(reply));
+    for (std::size_t p = 0; p < issued.size(); ++p) {
+        const auto ids = takeAll<std::uint32_t>(issued[p]);
+        if (ids.size() != kept[p].size()) throw std::runtime_error("ShardedKernel: migrant reply mismatch");
+        for (std::size_t m = 0; m < ids.size(); ++m) {
+            for (auto local : kept[p][m]) edges_.push_back({local, static_cast<std::uint32_t>(p), ids[m]});
+        }
+    }
+    sortEdges();
+    plan_dirty_ = true;
+}
+
+void ShardedKernel::reduceRegions() {
+    CIV_PROFILE_SCOPE(profiler::Phase::Shards);
+    if (comm_.size() == 1) return;
+    auto& aggregates = kernel_->regional_aggregates_;
+    constexpr std::size_t kWidth = 5;  // Population, belief sums
+
+    std::vector<double> block;
+    block.reserve(range_.size() * kWidth);
+    for (std::uint32_t r = range_.begin; r < range_.end; ++r) {
+        block.push_back(static_cast<double>(aggregates[r].population));
+        block.insert(block.end(), aggregates[r].belief_sum.begin(), aggregates[r].belief_sum.end());
+    }
+    const auto all = gatherOwned(block, kWidth);
+    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+        if (range_.contains(r)) continue;
+        const double* v = all.data() + static_cast<std::size_t>(r) * kWidth;
+        aggregates[r].population = static_cast<std::uint32_t>(v[0]);
+        aggregates[r].belief_sum = {v[1], v[2], v[3], v[4]};
+    }
+}
+
+void ShardedKernel::syncRegionEconomy() {
+    CIV_PROFILE_SCOPE(profiler::Phase::Shards);
+    if (comm_.size() == 1) return;
+    auto& economy = kernel_->economy_;
+    static const std::size_t width = ownedFieldCount();
+
+    std::vector<double> block;
+    block.reserve(range_.size() * width);
+    for (std::uint32_t r = range_.begin; r < range_.end; ++r) {
+        forEachOwnedField(economy.getRegion(r), [&](const auto& field) { block.push_back(toWire(field)); });
+    }
+    const auto all = gatherOwned(block, width);
+    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+        if (range_.contains(r)) continue;
+        const double* v = all.data() + static_cast<std::size_t>(r) * width;
+        forEachOwnedField(economy.getRegionMut(r), [&](auto& field) { fromWire(*v++, field); });
+    }
+}
+
+// ============================================================================
+// WORLD TOTALS
+// ============================================================================
+
+std::uint64_t ShardedKernel::population() {
+    const auto& alive = kernel_->agents().alive;
+    double count = static_cast<double>(std::count(alive.begin(), alive.end(), std::uint8_t{1}));
+    comm_.allreduceSum(&count, 1);
+    return static_cast<std::uint64_t>(count);
+}
+
+Kernel::Metrics ShardedKernel::computeMetrics() {
+    Kernel::Metrics m;
+    const Kernel& k = *kernel_;
+
+    // Every region's centroid from its owner's aggregates
+    constexpr std::size_t kWidth = 5;
+    std::vector<double> block;
+    block.reserve(range_.size() * kWidth);
+    for (std::uint32_t r = range_.begin; r < range_.end; ++r) {
+        const auto& agg = k.regional_aggregates_[r];
+        block.push_back(static_cast<double>(agg.population));
+        block.insert(block.end(), agg.belief_sum.begin(), agg.belief_sum.end());
+    }
+    const auto all = comm_.size() == 1 ? block : gatherOwned(block, kWidth);
+    std::vector<std::uint32_t> populations(cfg_.regions);
+    std::vector<std::array<double, 4>> centroids(cfg_.regions);
+    for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+        const double* v = all.data() + static_cast<std::size_t>(r) * kWidth;
+        populations[r] = static_cast<std::uint32_t>(v[0]);
+        if (populations[r] > 0) {
+            const double inv_pop = 1.0 / populations[r];
+            centroids[r] = {v[1] * inv_pop, v[2] * inv_pop, v[3] * inv_pop, v[4] * inv_pop};
+        }
+    }
+    Kernel::measurePolarization(populations, centroids, cfg_, k.generation(), m);
+
+    const auto& agents = k.agents();
+    std::array<double, 3> traits{};  // Alive, openness, conformity
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        if (!agents.alive[i]) continue;
+        traits[0] += 1.0;
+        traits[1] += agents.openness[i];
+        traits[2] += agents.conformity[i];
+    }
+    comm_.allreduceSum(traits.data(), traits.size());
+    if (traits[0] > 0.0) {
+        m.avgOpenness = traits[1] / traits[0];
+        m.avgConformity = traits[2] / traits[0];
+    }
+
+    // Region-level economy state is replicated, so any shard's totals are global
+    m.globalWelfare = k.economy().globalWelfare();
+    m.globalInequality = k.economy().globalInequality();
+    m.globalHardship = k.economy().globalHardship();
+    return m;
+}
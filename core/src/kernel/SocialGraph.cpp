@@ -0,0 +1,213 @@
+#include "kernel/SocialGraph.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+void SocialGraph::clear() {
+    offset_.clear();
+    degree_.clear();
+    capacity_.clear();
+    targets_.clear();
+    holes_ = 0;
+    ++version_;
+}
+
+void SocialGraph::reserve(std::size_t rows, std::size_t entries) {
+    offset_.reserve(rows);
+    degree_.reserve(rows);
+    capacity_.reserve(rows);
+    targets_.reserve(entries);
+}
+
+std::uint32_t SocialGraph::addRow(std::uint32_t reserve) {
+    const auto u = static_cast<std::uint32_t>(degree_.size());
+    offset_.push_back(targets_.size());
+    degree_.push_back(0);
+    capacity_.push_back(reserve);
+    targets_.resize(targets_.size() + reserve);
+    ++version_;
+    return u;
+}
+
+void SocialGraph::resizeRows(std::size_t rows) {
+    if (rows <= degree_.size()) {
+        // Trailing rows are abandoned in place; the next repack reclaims them
+        for (std::size_t u = rows; u < degree_.size(); ++u) {
+            holes_ += capacity_[u];
+        }
+        offset_.resize(rows);
+        degree_.resize(rows);
+        capacity_.resize(rows);
+        ++version_;
+        return;
+    }
+    while (degree_.size() < rows) {
+        addRow();
+    }
+}
+
+void SocialGraph::build(const std::uint32_t* degrees, std::size_t rows, const std::uint32_t* targets,
+                        std::uint32_t slack) {
+    offset_.resize(rows);
+    degree_.assign(degrees, degrees + rows);
+    capacity_.resize(rows);
+    std::size_t entries = 0;
+    for (std::size_t u = 0; u < rows; ++u) {
+        entries += degree_[u];
+    }
+    targets_.assign(entries + rows * static_cast<std::size_t>(slack), 0);
+
+    std::size_t src = 0;
+    std::size_t dst = 0;
+    for (std::size_t u = 0; u < rows; ++u) {
+        offset_[u] = dst;
+        capacity_[u] = degree_[u] + slack;
+        std::copy_n(targets + src, degree_[u], targets_.begin() + static_cast<std::ptrdiff_t>(dst));
+        src += degree_[u];
+        dst += capacity_[u];
+    }
+    holes_ = 0;
+    ++version_;
+}
+
+void SocialGraph::relocate(std::uint32_t u, std::uint32_t min_capacity) {
+    const std::uint32_t new_capacity = std::max({min_capacity, capacity_[u] * 2, kDefaultSlack});
+    const std::size_t new_offset = targets_.size();
+    targets_.resize(new_offset + new_capacity);
+    std::copy_n(targets_.begin() + static_cast<std::ptrdiff_t>(offset_[u]), degree_[u],
+                targets_.begin() + static_cast<std::ptrdiff_t>(new_offset));
+    holes_ += capacity_[u];
+    offset_[u] = new_offset;
+    capacity_[u] = new_capacity;
+
+    // Keep abandoned space bounded: once holes dominate, repack everything
+    if (holes_ > targets_.size() / 2) {
+        repack();
+    }
+}
+
+void SocialGraph::push(std::uint32_t u, std::uint32_t v) {
+    if (degree_[u] == capacity_[u]) {
+        relocate(u, degree_[u] + 1);
+    }
+    targets_[offset_[u] + degree_[u]] = v;
+    ++degree_[u];
+    ++version_;
+}
+
+std::uint32_t SocialGraph::erase(std::uint32_t u, std::uint32_t v) {
+    std::uint32_t* first = data(u);
+    std::uint32_t* last = first + degree_[u];
+    const auto removed = static_cast<std::uint32_t>(last - std::remove(first, last, v));
+    degree_[u] -= removed;
+    ++version_;
+    return removed;
+}
+
+void SocialGraph::truncate(std::uint32_t u, std::uint32_t n) {
+    degree_[u] = std::min(degree_[u], n);
+    ++version_;
+}
+
+void SocialGraph::assign(std::uint32_t u, const std::uint32_t* first, std::size_t n) {
+    // The source may point into targets_ (this row or another one)
+    const std::less<const std::uint32_t*> before;
+    const bool aliased = !targets_.empty() && !before(first, targets_.data()) &&
+                         before(first, targets_.data() + targets_.size());
+    if (n > capacity_[u]) {
+        // Growing relocates the row and may reallocate targets_: copy out first
+        std::vector<std::uint32_t> source;
+        if (aliased) {
+            source.assign(first, first + n);
+            first = source.data();
+        }
+        degree_[u] = 0;
+        relocate(u, static_cast<std::uint32_t>(n));
+        std::copy(first, first + n, data(u));
+    } else {
+        // In place: rows never overlap, but the source may be row u itself
+        std::uint32_t* dst = data(u);
+        if (before(dst, first)) {
+            std::copy(first, first + n, dst);
+        } else if (before(first, dst)) {
+            std::copy_backward(first, first + n, dst + n);
+        }
+    }
+    degree_[u] = static_cast<std::uint32_t>(n);
+    ++version_;
+}
+
+void SocialGraph::repack(std::uint32_t slack) {
+    compact([](std::uint32_t) { return false; }, [](std::uint32_t) { return false; }, slack);
+}
+
+void SocialGraph::remap(const std::vector<std::uint32_t>& remap, std::size_t rows,
+                        std::uint32_t slack) {
+    std::vector<std::size_t> offset(rows, 0);
+    std::vector<std::uint32_t> degree(rows, 0);
+    std::vector<std::uint32_t> capacity(rows, 0);
+    std::vector<std::uint32_t> packed;
+    packed.reserve(edgeCount() + rows * static_cast<std::size_t>(slack));
+
+    // New index -> old row, so targets are laid out in the new row order
+    std::vector<std::uint32_t> source(rows, kDropped);
+    for (std::size_t u = 0; u < degree_.size() && u < remap.size(); ++u) {
+        if (remap[u] != kDropped) source[remap[u]] = static_cast<std::uint32_t>(u);
+    }
+
+    for (std::size_t nu = 0; nu < rows; ++nu) {
+        const std::uint32_t u = source[nu];
+        if (u == kDropped) continue;
+
+        const std::size_t start = packed.size();
+        const std::uint32_t* src = targets_.data() + offset_[u];
+        for (std::uint32_t k = 0; k < degree_[u]; ++k) {
+            const std::uint32_t t = src[k];
+            const std::uint32_t nt = t < remap.size() ? remap[t] : kDropped;
+            if (nt != kDropped) {
+                packed.push_back(nt);
+            }
+        }
+        offset[nu] = start;
+        degree[nu] = static_cast<std::uint32_t>(packed.size() - start);
+        capacity[nu] = degree[nu] + slack;
+        packed.resize(packed.size() + slack);
+    }
+
+    offset_ = std::move(offset);
+    degree_ = std::move(degree);
+    capacity_ = std::move(capacity);
+    targets_ = std::move(packed);
+    holes_ = 0;
+    ++version_;
+}
+
+std::size_t SocialGraph::edgeCount() const {
+    return std::accumulate(degree_.begin(), degree_.end(), std::size_t{0});
+}
+
+MemoryFootprint SocialGraph::memoryUsage() const {
+    MemoryFootprint m;
+    m.add(offset_);
+    m.add(degree_);
+    m.add(capacity_);
+    m.reserved += targets_.capacity() * sizeof(std::uint32_t);
+    m.used += edgeCount() * sizeof(std::uint32_t);
+    return m;
+}
+
+void SocialGraph::shrinkToFit(std::uint32_t slack) {
+    repack(slack);
+    offset_.shrink_to_fit();
+    degree_.shrink_to_fit();
+    capacity_.shrink_to_fit();
+    targets_.shrink_to_fit();
+}
+
+std::size_t SocialGraph::memoryBytes() const {
+    return offset_.capacity() * sizeof(std::size_t) +
+           degree_.capacity() * sizeof(std::uint32_t) +
+           capacity_.capacity() * sizeof(std::uint32_t) +
+           targets_.capacity() * sizeof(std::uint32_t);
+}
@@ -0,0 +1,154 @@
+#include "kernel/TickScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+
+std::size_t TickArena::nextTypeIndex() {
+    static std::atomic<std::size_t> counter{0};
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TickArena::reset() {
+    for (auto& pool : pools_) {
+        if (pool) pool->reset();
+    }
+}
+
+void TickArena::release() {
+    pools_.clear();
+}
+
+std::size_t TickArena::bytesReserved() const {
+    std::size_t total = 0;
+    for (const auto& pool : pools_) {
+        if (pool) total += pool->bytes();
+    }
+    return total;
+}
+
+void BlockPartials::prepare(std::size_t blocks, std::size_t regions, std::size_t width) {
+    // Unmark the last pass's rows (O(touched)), then size for this one
+    for (std::size_t b = 0; b < blocks_; ++b) {
+        for (std::uint32_t k = 0; k < count_[b]; ++k) {
+            touched_[b * regions_ + order_[b * regions_ + k]] = 0;
+        }
+    }
+    blocks_ = blocks;
+    regions_ = regions;
+    width_ = width;
+    const std::size_t cells = blocks * regions;
+    if (cells > touched_.size() || cells * width > values_.size()) {
+        profiler::Profiler::noteAllocation();
+        touched_.resize(std::max(touched_.size(), cells), 0);
+        order_.resize(touched_.size());
+        values_.resize(std::max(values_.size(), cells * width));
+    }
+    count_.assign(blocks, 0);
+}
+
+void BlockPartials::release() {
+    blocks_ = regions_ = width_ = 0;
+    std::vector<double>().swap(values_);
+    std::vector<std::uint8_t>().swap(touched_);
+    std::vector<std::uint32_t>().swap(order_);
+    std::vector<std::uint32_t>().swap(count_);
+}
+
+std::size_t BlockPartials::bytesReserved() const {
+    return values_.capacity() * sizeof(double) + touched_.capacity() + order_.capacity() * sizeof(std::uint32_t) +
+           count_.capacity() * sizeof(std::uint32_t);
+}
+
+void TickScheduler::addRegionStage(std::string name, RegionFn fn, bool barrier) {
+    Stage stage;
+    stage.name = std::move(name);
+    stage.region = std::move(fn);
+    stage.barrier = barrier;
+    stages_.push_back(std::move(stage));
+}
+
+void TickScheduler::addAgentStage(AgentStage stage) {
+    Stage s;
+    s.name = stage.name;
+    s.barrier = stage.barrier;
+    s.agent = std::move(stage);
+    stages_.push_back(std::move(s));
+}
+
+void TickScheduler::run(const std::vector<std::uint32_t>& regionOfSlot, std::size_t regions,
+                        TickArena& arena) {
+    lastSweeps_ = 0;
+    std::vector<const AgentStage*> group;
+    std::size_t i = 0;
+    while (i < stages_.size()) {
+        // A group extends to (but excludes) the next barrier stage
+        std::size_t j = i + 1;
+        while (j < stages_.size() && !stages_[j].barrier) {
+            ++j;
+        }
+
+        group.clear();
+        for (std::size_t k = i; k < j; ++k) {
+            if (stages_[k].region) {
+                stages_[k].region();
+            } else {
+                group.push_back(&stages_[k].agent);
+            }
+        }
+        if (!group.empty()) {
+            sweep(group, regionOfSlot, regions, arena);
+            ++lastSweeps_;
+        }
+        i = j;
+    }
+}
+
+void TickScheduler::sweep(const std::vector<const AgentStage*>& group,
+                          const std::vector<std::uint32_t>& regionOfSlot, std::size_t regions,
+                          TickArena& arena) {
+    CIV_PROFILE_SCOPE(profiler::Phase::AgentSweep);
+    const std::size_t n = regionOfSlot.size();
+    const std::size_t stages = group.size();
+    CIV_PROFILE_TOUCH(n * stages);
+
+    // Column offset of each stage's reduction within a region's accumulator row
+    std::vector<std::size_t> offsets(stages, 0);
+    std::size_t width = 0;
+    for (std::size_t s = 0; s < stages; ++s) {
+        offsets[s] = width;
+        width += group[s]->reduceWidth;
+    }
+
+    const std::size_t blocks = std::clamp<std::size_t>((n + kMinBlockSlots - 1) / kMinBlockSlots,
+                                                       1, kMaxReductionBlocks);
+    const std::size_t blockSlots = (n + blocks - 1) / blocks;
+    const std::size_t rowWidth = std::max<std::size_t>(width, 1);
+    if (width > 0) partials_.prepare(blocks, regions, width);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(blocks); ++b) {
+        const std::size_t begin = static_cast<std::size_t>(b) * blockSlots;
+        const std::size_t end = std::min(n, begin + blockSlots);
+        for (std::size_t i = begin; i < end; ++i) {
+            const auto slot = static_cast<std::uint32_t>(i);
+            double* regionAcc = width > 0 ? partials_.row(static_cast<std::size_t>(b), regionOfSlot[i]) : nullptr;
+            for (std::size_t s = 0; s < stages; ++s) {
+                group[s]->update(slot, regionAcc ? regionAcc + offsets[s] : nullptr);
+            }
+        }
+    }
+
+    // Fold touched rows, blocks in order (independent of thread count), then finalize
+    auto& totals = arena.acquire<double>(regions * rowWidth);
+    if (width > 0) {
+        partials_.fold([&](std::uint32_t region, const double* src) {
+            double* dst = totals.data() + region * rowWidth;
+            for (std::size_t k = 0; k < width; ++k) dst[k] += src[k];
+        });
+    }
+    for (std::size_t s = 0; s < stages; ++s) {
+        if (group[s]->finalize) {
+            group[s]->finalize(RegionSums{totals.data(), rowWidth, offsets[s]});
+        }
+    }
+}
@@ -8,9 +8,31 @@ void CohortDemographics::configure(std::uint32_t num_regions, std::uint64_t seed
     rng_state_ = seed;
     cohorts_.clear();
     cohorts_.reserve(num_regions * 18 * 2);  // regions × age_groups × genders
+    mortality_.clear();
+    fertility_.clear();
 }
 
-std::uint8_t CohortDemographics::ageToGroup(int age) const {
+void CohortDemographics::restore(const std::vector<std::pair<CohortKey, Cohort>>& cohorts,
+                                 std::uint64_t rng_state) {
+    cohorts_.clear();
+    for (const auto& [key, cohort] : cohorts) {
+        cohorts_[key] = cohort;
+    }
+    rng_state_ = rng_state;
+}
+
+void CohortDemographics::setRegionRates(std::uint32_t region, const RateTable& mortality,
+                                        const RateTable& fertility) {
+    if (region >= num_regions_) return;
+    if (mortality_.empty()) {
+        mortality_.assign(num_regions_, RateTable{});
+        fertility_.assign(num_regions_, RateTable{});
+    }
+    mortality_[region] = mortality;
+    fertility_[region] = fertility;
+}
+
+std::uint8_t CohortDemographics::ageToGroup(int age) {
     // 5-year buckets: [0-4], [5-9], ..., [80-84], [85+]
     // Group 17 (index 17) is the catch-all for ages 85 and above
     // This gives 18 groups total (0-17)
@@ -18,7 +40,7 @@ std::uint8_t CohortDemographics::ageToGroup(int age) const {
     return static_cast<std::uint8_t>(age / 5);
 }
 
-void CohortDemographics::buildCohortsFromAgents(const std::vector<Agent>& agents) {
+void CohortDemographics::buildCohortsFromAgents(const AgentStore& agents, double weight) {
     cohorts_.clear();
     
     // Aggregate agents into cohorts
@@ -31,7 +53,13 @@ void CohortDemographics::buildCohortsFromAgents(const std::vector<Agent>& agents
             static_cast<std::uint8_t>(agent.female)
         };
         
-        auto& cohort = cohorts_[key];
+        auto [it, inserted] = cohorts_.try_emplace(key);
+        auto& cohort = it->second;
+        if (inserted) {
+            // Accumulators start empty, not at the per-cohort defaults
+            cohort.avg_health = 0.0;
+            cohort.avg_nutrition = 0.0;
+        }
         cohort.count++;
         cohort.avg_health += agent.health.physical_health;
         cohort.avg_nutrition += agent.health.nutrition_level;
@@ -47,6 +75,9 @@ void CohortDemographics::buildCohortsFromAgents(const std::vector<Agent>& agents
             cohort.avg_nutrition *= inv;
             cohort.immunity_share *= inv;
             cohort.infected_share *= inv;
+            if (weight != 1.0) {
+                cohort.count = static_cast<std::uint32_t>(std::llround(cohort.count * weight));
+            }
         }
         
         // Compute demographic rates
@@ -113,7 +144,7 @@ std::uint32_t CohortDemographics::randomBinomial(std::uint32_t n, double p) {
         double u2 = (rng_state_ >> 11) * (1.0 / 9007199254740992.0);
         
         double z = std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * 3.14159265358979323846 * u2);
-        double result = mean + stddev * z;
+        double result = std::round(mean + stddev * z);  // Round, not truncate: keeps the mean unbiased
         return static_cast<std::uint32_t>(std::max(0.0, std::min(static_cast<double>(n), result)));
     }
     
@@ -127,27 +158,65 @@ std::uint32_t CohortDemographics::randomBinomial(std::uint32_t n, double p) {
     return count;
 }
 
+double CohortDemographics::builtinMortality(const CohortKey& key, const Cohort& cohort) const {
+    // EMERGENT MORTALITY: Base rate modified by multiple regional factors
+    double health_factor = 0.5 + 0.5 * cohort.avg_health;  // [0.5, 1.0]
+    double effective_mortality = cohort.mortality_rate / health_factor;
+    
+    // Regional development reduces mortality (better healthcare, sanitation)
+    // Infant mortality (age_group 0) is most affected by development
+    double development_modifier = 1.0 - (cohort.avg_nutrition * 0.3);  // nutrition proxy for development
+    if (key.age_group == 0) {
+        development_modifier = 1.0 - (cohort.avg_nutrition * 0.6);  // infants benefit most
+    }
+    effective_mortality *= std::max(0.3, development_modifier);
+    
+    // Infection increases mortality
+    if (cohort.infected_share > 0.0) {
+        effective_mortality *= (1.0 + 0.3 * cohort.infected_share);
+    }
+    return effective_mortality;
+}
+
+double CohortDemographics::builtinFertility(const CohortKey& key, const Cohort& cohort) const {
+    if (cohort.fertility_rate <= 0.0) return 0.0;
+    
+    // EMERGENT FERTILITY: Multiple factors affect birth rates
+    double nutrition_factor = 0.5 + 0.5 * cohort.avg_nutrition;
+    
+    // Demographic transition: higher development = lower fertility
+    // Well-nourished populations with high health have fewer children (quality over quantity)
+    double demographic_transition = 1.0 - (cohort.avg_health * 0.3);  // health proxy for development
+    
+    // Economic stress affects fertility (hardship reduces family planning)
+    // But extreme hardship also reduces fertility (survival mode)
+    double stress_factor = 1.0;
+    // (Note: would need access to regional hardship here for full implementation)
+    
+    double effective_fertility = cohort.fertility_rate * nutrition_factor * demographic_transition * stress_factor;
+    
+    // Age-group specific modifiers for peak shift
+    // In developed regions, fertility peaks later; in traditional regions, peaks earlier
+    // This is approximated by health/nutrition levels
+    if (key.age_group == 3 && cohort.avg_health > 0.7) {
+        effective_fertility *= 0.6;  // developed: delay early fertility
+    }
+    if (key.age_group == 6 && cohort.avg_health > 0.7) {
+        effective_fertility *= 1.2;  // developed: more late fertility
+    }
+    return effective_fertility;
+}
+
 void CohortDemographics::updateDemographics(std::uint64_t tick, int ticks_per_year) {
+    const bool calibrated = !mortality_.empty();
+    
     // Process deaths
     for (auto& [key, cohort] : cohorts_) {
         if (cohort.count == 0) continue;
         
-        // EMERGENT MORTALITY: Base rate modified by multiple regional factors
-        double health_factor = 0.5 + 0.5 * cohort.avg_health;  // [0.5, 1.0]
-        double effective_mortality = cohort.mortality_rate / health_factor;
-        
-        // Regional development reduces mortality (better healthcare, sanitation)
-        // Infant mortality (age_group 0) is most affected by development
-        double development_modifier = 1.0 - (cohort.avg_nutrition * 0.3);  // nutrition proxy for development
-        if (key.age_group == 0) {
-            development_modifier = 1.0 - (cohort.avg_nutrition * 0.6);  // infants benefit most
-        }
-        effective_mortality *= std::max(0.3, development_modifier);
-        
-        // Infection increases mortality
-        if (cohort.infected_share > 0.0) {
-            effective_mortality *= (1.0 + 0.3 * cohort.infected_share);
-        }
+        const double effective_mortality = calibrated
+            ? (key.region < num_regions_ ? mortality_[key.region][key.age_group] : 0.0)
+            : builtinMortality(key, cohort);
         
         std::uint32_t deaths = randomBinomial(cohort.count, effective_mortality);
         cohort.count = (deaths < cohort.count) ? (cohort.count - deaths) : 0;
@@ -157,37 +226,19 @@ void CohortDemographics::updateDemographics(std::uint64_t tick, int ticks_per_ye
     std::vector<std::pair<CohortKey, std::uint32_t>> births;
     
     for (const auto& [key, cohort] : cohorts_) {
-        if (cohort.count == 0 || cohort.fertility_rate <= 0.0) continue;
+        if (cohort.count == 0 || key.female == 0) continue;
         
-        // EMERGENT FERTILITY: Multiple factors affect birth rates
-        double nutrition_factor = 0.5 + 0.5 * cohort.avg_nutrition;
-        
-        // Demographic transition: higher development = lower fertility
-        // Well-nourished populations with high health have fewer children (quality over quantity)
-        double demographic_transition = 1.0 - (cohort.avg_health * 0.3);  // health proxy for development
-        
-        // Economic stress affects fertility (hardship reduces family planning)
-        // But extreme hardship also reduces fertility (survival mode)
-        double stress_factor = 1.0;
-        // (Note: would need access to regional hardship here for full implementation)
-        
-        double effective_fertility = cohort.fertility_rate * nutrition_factor * demographic_transition * stress_factor;
-        
-        // Age-group specific modifiers for peak shift
-        // In developed regions, fertility peaks later; in traditional regions, peaks earlier
-        // This is approximated by health/nutrition levels
-        if (key.age_group == 3 && cohort.avg_health > 0.7) {
-            effective_fertility *= 0.6;  // developed: delay early fertility
-        }
-        if (key.age_group == 6 && cohort.avg_health > 0.7) {
-            effective_fertility *= 1.2;  // developed: more late fertility
-        }
+        const double effective_fertility = calibrated
+            ? (key.region < num_regions_ ? fertility_[key.region][key.age_group] : 0.0)
+            : builtinFertility(key, cohort);
+        if (effective_fertility <= 0.0) continue;
         
         std::uint32_t num_births = randomBinomial(cohort.count, effective_fertility);
         
         if (num_births > 0) {
-            // Create newborn cohorts (age group 0, 50/50 gender split)
-            std::uint32_t male_births = num_births / 2;
+            // Create newborn cohorts (age group 0, 50/50 gender odds; an even
+            // split would make every lone birth female)
+            std::uint32_t male_births = randomBinomial(num_births, 0.5);
             std::uint32_t female_births = num_births - male_births;
             
             if (male_births > 0) {
@@ -199,49 +250,72 @@ void CohortDemographics::updateDemographics(std::uint64_t tick, int ticks_per_ye
         }
     }
     
-    // Add births to cohorts
+    // Add births to cohorts (newborns start with baseline health)
     for (const auto& [birth_key, count] : births) {
-        auto& cohort = cohorts_[birth_key];
-        cohort.count += count;
-        // Newborns start with baseline health
-        cohort.avg_health = 0.9;
-        cohort.avg_nutrition = 0.8;
-        cohort.mortality_rate = computeMortalityRate(birth_key.age_group);
-        cohort.fertility_rate = computeFertilityRate(birth_key.age_group);
+        Cohort newborns;
+        newborns.count = count;
+        newborns.avg_health = 0.9;
+        newborns.avg_nutrition = 0.8;
+        absorb(birth_key, newborns);
     }
     
-    // Process aging (every year)
+    // Process aging (every year): a fifth of each 5-year group moves up, so
+    // members stay five years in a group on average; group 17 is open-ended
     if (tick % ticks_per_year == 0) {
-        std::unordered_map<CohortKey, Cohort, CohortKeyHash> aged_cohorts;
-        aged_cohorts.reserve(cohorts_.size());
+        std::vector<std::pair<CohortKey, Cohort>> aging;
+        aging.reserve(cohorts_.size());
         
         for (auto& [key, cohort] : cohorts_) {
-            if (cohort.count == 0) continue;
+            if (cohort.count == 0 || key.age_group >= 17) continue;
+            const std::uint32_t moving = randomBinomial(cohort.count, 0.2);
+            if (moving == 0) continue;
             
-            // Age cohort up
-            CohortKey new_key = key;
-            new_key.age_group = std::min(static_cast<std::uint8_t>(key.age_group + 1), 
-                                          static_cast<std::uint8_t>(17));  // Max age group
-            
-            // Move to new age group
-            auto& target = aged_cohorts[new_key];
-            if (target.count == 0) {
-                target = cohort;
-                target.mortality_rate = computeMortalityRate(new_key.age_group);
-                target.fertility_rate = computeFertilityRate(new_key.age_group);
-            } else {
-                // Merge cohorts (weighted average)
-                double total = target.count + cohort.count;
-                target.avg_health = (target.avg_health * target.count + cohort.avg_health * cohort.count) / total;
-                target.avg_nutrition = (target.avg_nutrition * target.count + cohort.avg_nutrition * cohort.count) / total;
-                target.immunity_share = (target.immunity_share * target.count + cohort.immunity_share * cohort.count) / total;
-                target.infected_share = (target.infected_share * target.count + cohort.infected_share * cohort.count) / total;
-                target.count += cohort.count;
-            }
+            Cohort moved = cohort;
+            moved.count = moving;
+            cohort.count -= moving;
+            aging.emplace_back(CohortKey{key.region, static_cast<std::uint8_t>(key.age_group + 1), key.female},
+                               moved);
         }
         
-        cohorts_ = std::move(aged_cohorts);
+        for (const auto& [key, moved] : aging) {
+            absorb(key, moved);
+        }
+    }
+}
+
+void CohortDemographics::absorb(const CohortKey& key, const Cohort& incoming) {
+    if (incoming.count == 0) return;
+    auto& target = cohorts_[key];
+    if (target.count == 0) {
+        target = incoming;
+    } else {
+        const double total = static_cast<double>(target.count) + incoming.count;
+        const double wt = target.count / total;
+        const double wi = incoming.count / total;
+        target.avg_health = target.avg_health * wt + incoming.avg_health * wi;
+        target.avg_nutrition = target.avg_nutrition * wt + incoming.avg_nutrition * wi;
+        target.immunity_share = target.immunity_share * wt + incoming.immunity_share * wi;
+        target.infected_share = target.infected_share * wt + incoming.infected_share * wi;
+        target.count += incoming.count;
     }
+    target.mortality_rate = computeMortalityRate(key.age_group);
+    target.fertility_rate = (key.female == 1) ? computeFertilityRate(key.age_group) : 0.0;
+}
+
+std::uint32_t CohortDemographics::withdraw(const CohortKey& key, std::uint32_t n) {
+    auto it = cohorts_.find(key);
+    if (it == cohorts_.end()) return 0;
+    const std::uint32_t taken = std::min(n, it->second.count);
+    it->second.count -= taken;
+    return taken;
+}
+
+void CohortDemographics::deposit(const CohortKey& key, std::uint32_t n, double health, double nutrition) {
+    Cohort incoming;
+    incoming.count = n;
+    incoming.avg_health = health;
+    incoming.avg_nutrition = nutrition;
+    absorb(key, incoming);
 }
 
 void CohortDemographics::updateHealth(const std::vector<double>& regional_nutrition,
@@ -278,11 +352,12 @@ void CohortDemographics::updateHealth(const std::vector<double>& regional_nutrit
     }
 }
 
-void CohortDemographics::syncToAgents(std::vector<Agent>& agents, std::uint64_t tick) {
+void CohortDemographics::syncToAgents(AgentStore& agents, std::uint64_t tick) {
     // Build agent-to-cohort mapping
     std::unordered_map<CohortKey, std::vector<std::uint32_t>, CohortKeyHash> agent_lists;
     
-    for (auto& agent : agents) {
+    for (std::uint32_t slot = 0; slot < agents.size(); ++slot) {
+        const auto agent = agents[slot];
         if (!agent.alive) continue;
         
         CohortKey key{
@@ -291,7 +366,7 @@ void CohortDemographics::syncToAgents(std::vector<Agent>& agents, std::uint64_t
             static_cast<std::uint8_t>(agent.female)
         };
         
-        agent_lists[key].push_back(agent.id);
+        agent_lists[key].push_back(slot);
     }
     
     // Sync cohort data to agents
@@ -313,7 +388,7 @@ void CohortDemographics::syncToAgents(std::vector<Agent>& agents, std::uint64_t
         
         // Sync health data to surviving agents
         for (std::uint32_t i = 0; i < std::min(cohort_size, agent_list_size); ++i) {
-            auto& agent = agents[agent_ids[i]];
+            auto agent = agents[agent_ids[i]];
             agent.health.physical_health = cohort.avg_health;
             agent.health.nutrition_level = cohort.avg_nutrition;
             agent.health.infected = (i < static_cast<std::uint32_t>(cohort.infected_share * cohort_size));
@@ -325,8 +400,18 @@ void CohortDemographics::syncToAgents(std::vector<Agent>& agents, std::uint64_t
     // This sync only updates existing agents with cohort statistics
 }
 
-std::uint32_t CohortDemographics::getTotalPopulation() const {
-    std::uint32_t total = 0;
+MemoryFootprint CohortDemographics::memoryUsage() const {
+    MemoryFootprint m;
+    using Node = std::pair<const CohortKey, Cohort>;
+    m.used += cohorts_.size() * sizeof(Node);
+    m.reserved += cohorts_.size() * (sizeof(Node) + sizeof(void*)) + cohorts_.bucket_count() * sizeof(void*);
+    m.add(mortality_);
+    m.add(fertility_);
+    return m;
+}
+
+std::uint64_t CohortDemographics::getTotalPopulation() const {
+    std::uint64_t total = 0;
     for (const auto& [key, cohort] : cohorts_) {
         total += cohort.count;
     }
@@ -357,6 +442,30 @@ double CohortDemographics::getRegionAvgHealth(std::uint32_t region) const {
     return (total_count > 0) ? (total_health / total_count) : 0.8;
 }
 
+std::vector<std::pair<CohortKey, Cohort>> CohortDemographics::regionCohorts(std::uint32_t region) const {
+    std::vector<std::pair<CohortKey, Cohort>> out;
+    for (const auto& [key, cohort] : cohorts_) {
+        if (key.region == region && cohort.count > 0) {
+            out.emplace_back(key, cohort);
+        }
+    }
+    std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
+        return a.first.age_group != b.first.age_group ? a.first.age_group < b.first.age_group
+                                                       : a.first.female < b.first.female;
+    });
+    return out;
+}
+
+std::vector<std::uint64_t> CohortDemographics::regionPopulations() const {
+    std::vector<std::uint64_t> totals(num_regions_, 0);
+    for (const auto& [key, cohort] : cohorts_) {
+        if (key.region < num_regions_) {
+            totals[key.region] += cohort.count;
+        }
+    }
+    return totals;
+}
+
 double CohortDemographics::clamp01(double value) const {
     return std::max(0.0, std::min(1.0, value));
 }
@@ -6,6 +6,8 @@
 #include <limits>
 #include <numeric>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 
 namespace {
@@ -19,13 +21,48 @@ double distance4d(const std::array<double, 4>& a, const std::array<double, 4>& b
     return std::sqrt(sum);
 }
 
+// Nearest and second-nearest centroid (squared distances); ties keep the lower index
+inline void nearestTwo(const std::array<double, 4>& point,
+                       const std::vector<std::array<double, 4>>& centroids,
+                       int& bestCluster, double& bestSq, double& secondSq) {
+    bestSq = std::numeric_limits<double>::max();
+    secondSq = std::numeric_limits<double>::max();
+    bestCluster = 0;
+    for (int k = 0; k < static_cast<int>(centroids.size()); ++k) {
+        double d2 = 0.0;
+        for (int dim = 0; dim < 4; ++dim) {
+            double diff = point[dim] - centroids[k][dim];
+            d2 += diff * diff;
+        }
+        if (d2 < bestSq) {
+            secondSq = bestSq;
+            bestSq = d2;
+            bestCluster = k;
+        } else if (d2 < secondSq) {
+            secondSq = d2;
+        }
+    }
+}
+
+// Agents per partial-sum block: blocks are fixed so sums fold in the same order for any thread count
+constexpr std::size_t kSumBlockSize = 4096;
+
 }
 
 // ---------------- KMeans -----------------
 KMeansClustering::KMeansClustering(int k, int maxIter, double tolerance)
     : k_(std::max(2, k)), maxIter_(std::max(1, maxIter)), tolerance_(std::max(1e-6, tolerance)) {}
 
-void KMeansClustering::initialize(const std::vector<Agent>& agents,
+void KMeansClustering::setInitialCentroids(std::vector<std::array<double, 4>> centroids) {
+    if (static_cast<int>(centroids.size()) != k_) {
+        throw std::invalid_argument("KMeansClustering: expected " + std::to_string(k_) +
+                                    " initial centroids, got " + std::to_string(centroids.size()));
+    }
+    centroids_ = std::move(centroids);
+    warmStart_ = true;
+}
+
+void KMeansClustering::initialize(const AgentStore& agents,
                                   std::vector<std::array<double, 4>>& centroids) {
     centroids.clear();
     centroids.reserve(k_);
@@ -33,111 +70,280 @@ void KMeansClustering::initialize(const std::vector<Agent>& agents,
     std::mt19937_64 rng(agents.size());
     std::uniform_int_distribution<std::size_t> pick(0, agents.size() - 1);
 
-    centroids.push_back(agents[pick(rng)].B);
+    centroids.push_back(agents.B[pick(rng)]);
 
+    // k-means++: distances to the nearest chosen centroid, refreshed against
+    // the newest one only
+    std::vector<double> minDists(agents.size(), std::numeric_limits<double>::max());
     while (static_cast<int>(centroids.size()) < k_) {
-        std::vector<double> minDists(agents.size(), std::numeric_limits<double>::max());
+        const auto c = centroids.back();
+        #pragma omp parallel for schedule(static)
         for (std::size_t i = 0; i < agents.size(); ++i) {
-            for (const auto& c : centroids) {
-                // Use squared distance to avoid sqrt
-                double d2 = 0.0;
-                for (int dim = 0; dim < 4; ++dim) {
-                    double diff = agents[i].B[dim] - c[dim];
-                    d2 += diff * diff;
-                }
-                if (d2 < minDists[i]) minDists[i] = d2;
+            // Use squared distance to avoid sqrt
+            double d2 = 0.0;
+            for (int dim = 0; dim < 4; ++dim) {
+                double diff = agents.B[i][dim] - c[dim];
+                d2 += diff * diff;
             }
+            if (d2 < minDists[i]) minDists[i] = d2;
         }
         std::discrete_distribution<std::size_t> dist(minDists.begin(), minDists.end());
-        centroids.push_back(agents[dist(rng)].B);
+        centroids.push_back(agents.B[dist(rng)]);
     }
 }
 
-void KMeansClustering::assign(const std::vector<Agent>& agents,
+void KMeansClustering::assign(const AgentStore& agents,
                               const std::vector<std::array<double, 4>>& centroids,
-                              std::vector<int>& assignment) {
-    assignment.resize(agents.size());
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        double bestSq = std::numeric_limits<double>::max();
-        int bestCluster = 0;
-        // Compare squared distances to avoid sqrt
-        for (int k = 0; k < k_; ++k) {
-            double d2 = 0.0;
-            for (int dim = 0; dim < 4; ++dim) {
-                double diff = agents[i].B[dim] - centroids[k][dim];
-                d2 += diff * diff;
-            }
-            if (d2 < bestSq) {
-                bestSq = d2;
-                bestCluster = k;
-            }
-        }
+                              std::vector<int>& assignment,
+                              std::vector<double>& upper,
+                              std::vector<double>& lower) {
+    const std::size_t n = agents.size();
+    assignment.resize(n);
+    upper.resize(n);
+    lower.resize(n);
+    #pragma omp parallel for schedule(static)
+    for (std::size_t i = 0; i < n; ++i) {
+        int bestCluster;
+        double bestSq, secondSq;
+        nearestTwo(agents.B[i], centroids, bestCluster, bestSq, secondSq);
         assignment[i] = bestCluster;
+        upper[i] = std::sqrt(bestSq);
+        lower[i] = std::sqrt(secondSq);
     }
 }
 
-void KMeansClustering::update(const std::vector<Agent>& agents,
-                              const std::vector<int>& assignment,
-                              std::vector<std::array<double, 4>>& centroids) {
+std::vector<double> KMeansClustering::update(const AgentStore& agents,
+                                             const std::vector<int>& assignment,
+                                             std::vector<std::array<double, 4>>& centroids) {
+    const std::size_t n = agents.size();
+    const std::size_t blocks = (n + kSumBlockSize - 1) / kSumBlockSize;
+    std::vector<std::array<double, 4>> blockSums(blocks * k_, {0, 0, 0, 0});
+    std::vector<int> blockCounts(blocks * k_, 0);
+
+    #pragma omp parallel for schedule(static)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        auto* sums = &blockSums[b * k_];
+        auto* counts = &blockCounts[b * k_];
+        for (std::size_t i = b * kSumBlockSize; i < std::min(n, (b + 1) * kSumBlockSize); ++i) {
+            int cluster = assignment[i];
+            for (int d = 0; d < 4; ++d) {
+                sums[cluster][d] += agents.B[i][d];
+            }
+            counts[cluster]++;
+        }
+    }
+
     std::vector<std::array<double, 4>> newC(k_, {0, 0, 0, 0});
     std::vector<int> counts(k_, 0);
-
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        int cluster = assignment[i];
-        for (int d = 0; d < 4; ++d) {
-            newC[cluster][d] += agents[i].B[d];
+    for (std::size_t b = 0; b < blocks; ++b) {
+        for (int k = 0; k < k_; ++k) {
+            for (int d = 0; d < 4; ++d) {
+                newC[k][d] += blockSums[b * k_ + k][d];
+            }
+            counts[k] += blockCounts[b * k_ + k];
         }
-        counts[cluster]++;
     }
 
     std::mt19937_64 rng(agents.size() * 7919);
     std::uniform_int_distribution<std::size_t> pick(0, agents.size() - 1);
 
+    std::vector<double> shifts(k_);
     for (int k = 0; k < k_; ++k) {
         if (counts[k] == 0) {
-            newC[k] = agents[pick(rng)].B;
+            newC[k] = agents.B[pick(rng)];
         } else {
             for (int d = 0; d < 4; ++d) {
                 newC[k][d] /= counts[k];
             }
         }
+        shifts[k] = distance4d(centroids[k], newC[k]);
     }
 
     centroids = std::move(newC);
+    return shifts;
 }
 
-double KMeansClustering::inertia(const std::vector<Agent>& agents,
+double KMeansClustering::inertia(const AgentStore& agents,
                                  const std::vector<std::array<double, 4>>& centroids,
                                  const std::vector<int>& assignment) const {
-    double total = 0.0;
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        double d = distance4d(agents[i].B, centroids[assignment[i]]);
-        total += d * d;
+    const std::size_t n = agents.size();
+    const std::size_t blocks = (n + kSumBlockSize - 1) / kSumBlockSize;
+    std::vector<double> partial(blocks, 0.0);
+    #pragma omp parallel for schedule(static)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        for (std::size_t i = b * kSumBlockSize; i < std::min(n, (b + 1) * kSumBlockSize); ++i) {
+            double d = distance4d(agents.B[i], centroids[assignment[i]]);
+            partial[b] += d * d;
+        }
     }
-    return total;
+    return std::accumulate(partial.begin(), partial.end(), 0.0);
 }
 
-std::vector<Cluster> KMeansClustering::run(const Kernel& kernel) {
-    const auto& agents = kernel.agents();
-    std::vector<std::array<double, 4>> centroids;
-    std::vector<int> assignment;
-
-    initialize(agents, centroids);
+void KMeansClustering::runFull(const AgentStore& agents,
+                               std::vector<std::array<double, 4>>& centroids,
+                               std::vector<int>& assignment) {
+    const std::size_t n = agents.size();
+    std::vector<double> upper, lower;
+    std::vector<double> half(k_);
+    assign(agents, centroids, assignment, upper, lower);
+
+    // Hamerly pruning: an agent keeps its centroid while its upper bound is
+    // within half the distance to that centroid's nearest rival, or within its
+    // lower bound to every other centroid. Returns how many agents moved.
+    auto reassign = [&]() {
+        for (int k = 0; k < k_; ++k) {
+            half[k] = std::numeric_limits<double>::max();
+            for (int j = 0; j < k_; ++j) {
+                if (j != k) half[k] = std::min(half[k], 0.5 * distance4d(centroids[k], centroids[j]));
+            }
+        }
+        std::size_t changed = 0;
+        #pragma omp parallel for schedule(static) reduction(+:changed)
+        for (std::size_t i = 0; i < n; ++i) {
+            const int a = assignment[i];
+            const double bound = std::max(half[a], lower[i]);
+            if (upper[i] <= bound) continue;
+            upper[i] = distance4d(agents.B[i], centroids[a]);
+            if (upper[i] <= bound) continue;
+            int bestCluster;
+            double bestSq, secondSq;
+            nearestTwo(agents.B[i], centroids, bestCluster, bestSq, secondSq);
+            if (bestCluster != a) ++changed;
+            assignment[i] = bestCluster;
+            upper[i] = std::sqrt(bestSq);
+            lower[i] = std::sqrt(secondSq);
+        }
+        return changed;
+    };
 
     double prevInertia = std::numeric_limits<double>::max();
-    converged_ = false;
-
     for (iterationsUsed_ = 0; iterationsUsed_ < maxIter_; ++iterationsUsed_) {
-        assign(agents, centroids, assignment);
-        update(agents, assignment, centroids);
+        if (iterationsUsed_ > 0 && reassign() == 0) {
+            converged_ = true;  // Fixed point: the update would not move anything
+            return;
+        }
+
+        const auto shifts = update(agents, assignment, centroids);
+
+        // Keep the bounds valid for the moved centroids
+        int far = 0;
+        for (int k = 1; k < k_; ++k) {
+            if (shifts[k] > shifts[far]) far = k;
+        }
+        double secondFar = 0.0;
+        for (int k = 0; k < k_; ++k) {
+            if (k != far) secondFar = std::max(secondFar, shifts[k]);
+        }
+        #pragma omp parallel for schedule(static)
+        for (std::size_t i = 0; i < n; ++i) {
+            upper[i] += shifts[assignment[i]];
+            lower[i] -= (assignment[i] == far) ? secondFar : shifts[far];
+        }
+
+        // Converged once inertia changes by less than the tolerance, relative to
+        // itself (an absolute threshold on a sum over all agents never trips at scale)
         double current = inertia(agents, centroids, assignment);
-        if (std::abs(prevInertia - current) < tolerance_) {
+        if (std::abs(prevInertia - current) <= tolerance_ * current) {
             converged_ = true;
             break;
         }
         prevInertia = current;
     }
 
+    // Report members against the final centroids
+    reassign();
+}
+
+void KMeansClustering::runMiniBatch(const AgentStore& agents,
+                                    std::vector<std::array<double, 4>>& centroids,
+                                    std::vector<int>& assignment,
+                                    bool warm) {
+    // Sculley-style mini-batch: each sampled agent pulls its centroid towards it
+    // with a per-centroid rate of 1 / (agents seen so far). Warm centroids
+    // start with one batch worth of weight so the first samples do not replace them.
+    const std::size_t n = agents.size();
+    const std::size_t batch = std::min(miniBatch_, n);
+    std::vector<std::size_t> sample(batch);
+    std::vector<int> nearest(batch);
+    std::vector<std::uint64_t> seen(k_, warm ? batch / k_ : 0);
+    double threshold = -1.0;  // Squared-shift tolerance, scaled by the belief variance
+
+    std::mt19937_64 rng(n * 104729 + runs_);
+    std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+
+    for (iterationsUsed_ = 0; iterationsUsed_ < maxIter_; ++iterationsUsed_) {
+        for (auto& idx : sample) idx = pick(rng);
+        if (threshold < 0.0) {
+            std::array<double, 4> mean{0, 0, 0, 0}, sq{0, 0, 0, 0};
+            for (auto idx : sample) {
+                for (int d = 0; d < 4; ++d) {
+                    const double b = agents.B[idx][d];
+                    mean[d] += b;
+                    sq[d] += b * b;
+                }
+            }
+            double variance = 0.0;
+            for (int d = 0; d < 4; ++d) {
+                mean[d] /= batch;
+                variance += std::max(0.0, sq[d] / batch - mean[d] * mean[d]);
+            }
+            threshold = tolerance_ * variance / 4.0;
+        }
+
+        #pragma omp parallel for schedule(static)
+        for (std::size_t j = 0; j < batch; ++j) {
+            double bestSq, secondSq;
+            nearestTwo(agents.B[sample[j]], centroids, nearest[j], bestSq, secondSq);
+        }
+
+        const auto previous = centroids;
+        for (std::size_t j = 0; j < batch; ++j) {
+            auto& c = centroids[nearest[j]];
+            const double eta = 1.0 / static_cast<double>(++seen[nearest[j]]);
+            for (int d = 0; d < 4; ++d) {
+                c[d] += eta * (agents.B[sample[j]][d] - c[d]);
+            }
+        }
+
+        double shiftSq = 0.0;
+        for (int k = 0; k < k_; ++k) {
+            const double shift = distance4d(previous[k], centroids[k]);
+            shiftSq += shift * shift;
+        }
+        if (shiftSq <= threshold) {
+            converged_ = true;
+            break;
+        }
+    }
+
+    std::vector<double> upper, lower;
+    assign(agents, centroids, assignment, upper, lower);
+}
+
+std::vector<Cluster> KMeansClustering::run(const Kernel& kernel) {
+    const auto& agents = kernel.agents();
+    iterationsUsed_ = 0;
+    converged_ = false;
+    ++runs_;
+    if (agents.size() == 0) return {};
+
+    std::vector<std::array<double, 4>> centroids;
+    std::vector<int> assignment;
+
+    const bool warm = warmStart_ && static_cast<int>(centroids_.size()) == k_;
+    if (warm) {
+        centroids = centroids_;
+    } else {
+        initialize(agents, centroids);
+    }
+
+    if (miniBatch_ > 0 && miniBatch_ < agents.size()) {
+        runMiniBatch(agents, centroids, assignment, warm);
+    } else {
+        runFull(agents, centroids, assignment);
+    }
+    centroids_ = centroids;
+
     std::vector<Cluster> clusters(k_);
     for (int k = 0; k < k_; ++k) {
         clusters[k].id = static_cast<std::uint32_t>(k);
@@ -146,7 +352,7 @@ std::vector<Cluster> KMeansClustering::run(const Kernel& kernel) {
     }
 
     for (std::size_t i = 0; i < agents.size(); ++i) {
-        clusters[assignment[i]].members.push_back(agents[i].id);
+        clusters[assignment[i]].members.push_back(static_cast<std::uint32_t>(i));
     }
 
     enrichClusters(clusters, kernel);
@@ -154,68 +360,192 @@ std::vector<Cluster> KMeansClustering::run(const Kernel& kernel) {
 }
 
 // --------------- DBSCAN -----------------
-DBSCANClustering::DBSCANClustering(double eps, int minPts)
-    : eps_(std::max(1e-3, eps)), minPts_(std::max(2, minPts)) {}
 
-std::vector<std::uint32_t> DBSCANClustering::regionQuery(const std::vector<Agent>& agents,
-                                                         std::uint32_t idx) const {
-    std::vector<std::uint32_t> neighbors;
-    neighbors.reserve(minPts_ * 2);  // Reserve reasonable space
-    const auto& point = agents[idx].B;
-    const double eps2 = eps_ * eps_;  // Compare squared distances to avoid sqrt
-    
-    for (std::uint32_t i = 0; i < agents.size(); ++i) {
-        // Compute squared distance
-        double d2 = 0.0;
-        for (int k = 0; k < 4; ++k) {
-            double diff = point[k] - agents[i].B[k];
-            d2 += diff * diff;
+// Uniform 4-D grid over belief space with cells at least eps wide, so every
+// eps-neighbour of a point lies in its own cell or one of the 80 adjacent ones.
+// Points are stored cell-major (CSR) for contiguous scans. Each cell also
+// counts its points not yet in a cluster, so expansion skips exhausted cells.
+class BeliefGrid {
+public:
+    BeliefGrid(const std::vector<precision::BeliefVec>& points, double eps) : points_(points) {
+        // Bound the cell count by the population: cells stay >= eps, just wider.
+        // The small pad keeps rounding from pushing an exact-eps pair two cells apart.
+        const auto n = static_cast<std::uint64_t>(points.size());
+        const double maxCellsPerDim = std::max(1.0, std::floor(std::pow(4.0 * n + 1.0, 0.25)));
+        std::array<double, 4> hi{};
+        for (int d = 0; d < 4; ++d) {
+            lo_[d] = std::numeric_limits<double>::max();
+            hi[d] = std::numeric_limits<double>::lowest();
+        }
+        for (const auto& p : points) {
+            for (int d = 0; d < 4; ++d) {
+                lo_[d] = std::min<double>(lo_[d], p[d]);
+                hi[d] = std::max<double>(hi[d], p[d]);
+            }
+        }
+        std::size_t cells = 1;
+        for (int d = 0; d < 4; ++d) {
+            const double range = points.empty() ? 0.0 : hi[d] - lo_[d];
+            cellSize_[d] = std::max(eps * (1.0 + 1e-9), range / maxCellsPerDim);
+            dims_[d] = static_cast<int>(range / cellSize_[d]) + 1;
+            stride_[d] = cells;
+            cells *= static_cast<std::size_t>(dims_[d]);
         }
-        if (d2 <= eps2) {
-            neighbors.push_back(i);
+
+        cellOf_.resize(points.size());
+        offsets_.assign(cells + 1, 0);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            cellOf_[i] = static_cast<std::uint32_t>(cellIndex(points[i]));
+            offsets_[cellOf_[i] + 1]++;
+        }
+        unclustered_.resize(cells);
+        for (std::size_t c = 0; c < cells; ++c) {
+            unclustered_[c] = offsets_[c + 1];
+            offsets_[c + 1] += offsets_[c];
+        }
+        slots_.resize(points.size());
+        sorted_.resize(points.size());
+        std::vector<std::uint32_t> cursor(offsets_.begin(), offsets_.end() - 1);
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            const std::uint32_t at = cursor[cellOf_[i]]++;
+            slots_[at] = static_cast<std::uint32_t>(i);
+            sorted_[at] = points[i];
+        }
+    }
+
+    const precision::BeliefVec& point(std::uint32_t slot) const { return points_[slot]; }
+    // Record that a slot joined a cluster
+    void markClustered(std::uint32_t slot) { --unclustered_[cellOf_[slot]]; }
+
+    // Calls fn(slot, squaredDistance) for every point in the 3^4 cells around p,
+    // p's own cell first so early-exit counts stop after a few dozen points;
+    // fn returns false to stop. With skipClustered, cells whose points are all
+    // in clusters already are passed over.
+    template <typename Fn>
+    void forEachCandidate(const std::array<double, 4>& p, Fn&& fn, bool skipClustered = false) const {
+        auto scan = [&](std::size_t cell) {
+            if (skipClustered && unclustered_[cell] == 0) return true;
+            for (std::uint32_t k = offsets_[cell]; k < offsets_[cell + 1]; ++k) {
+                // Same arithmetic as the brute-force scan, so boundary cases agree
+                double d2 = 0.0;
+                for (int d = 0; d < 4; ++d) {
+                    const double diff = p[d] - sorted_[k][d];
+                    d2 += diff * diff;
+                }
+                if (!fn(slots_[k], d2)) return false;
+            }
+            return true;
+        };
+
+        std::array<int, 4> c{};
+        for (int d = 0; d < 4; ++d) c[d] = coord(p, d);
+        const std::size_t home = c[0] * stride_[0] + c[1] * stride_[1] + c[2] * stride_[2] + c[3] * stride_[3];
+        if (!scan(home)) return;
+        for (int a = std::max(0, c[0] - 1); a <= std::min(dims_[0] - 1, c[0] + 1); ++a)
+        for (int b = std::max(0, c[1] - 1); b <= std::min(dims_[1] - 1, c[1] + 1); ++b)
+        for (int e = std::max(0, c[2] - 1); e <= std::min(dims_[2] - 1, c[2] + 1); ++e)
+        for (int f = std::max(0, c[3] - 1); f <= std::min(dims_[3] - 1, c[3] + 1); ++f) {
+            const std::size_t cell = a * stride_[0] + b * stride_[1] + e * stride_[2] + f * stride_[3];
+            if (cell != home && !scan(cell)) return;
         }
     }
-    return neighbors;
+
+private:
+    int coord(const std::array<double, 4>& p, int d) const {
+        return std::clamp(static_cast<int>((p[d] - lo_[d]) / cellSize_[d]), 0, dims_[d] - 1);
+    }
+    std::size_t cellIndex(const std::array<double, 4>& p) const {
+        std::size_t cell = 0;
+        for (int d = 0; d < 4; ++d) cell += static_cast<std::size_t>(coord(p, d)) * stride_[d];
+        return cell;
+    }
+
+    const std::vector<precision::BeliefVec>& points_;
+    std::array<double, 4> lo_{};
+    std::array<double, 4> cellSize_{};
+    std::array<int, 4> dims_{};
+    std::array<std::size_t, 4> stride_{};
+    std::vector<std::uint32_t> offsets_;            // Cell c holds [offsets_[c], offsets_[c + 1])
+    std::vector<std::uint32_t> slots_;              // Agent slot per grid position
+    std::vector<std::array<double, 4>> sorted_;     // Beliefs in grid order
+    std::vector<std::uint32_t> cellOf_;             // Cell per agent slot
+    std::vector<std::uint32_t> unclustered_;        // Points per cell not yet in a cluster
+};
+
+DBSCANClustering::DBSCANClustering(double eps, int minPts)
+    : eps_(std::max(1e-3, eps)), minPts_(std::max(2, minPts)) {}
+
+void DBSCANClustering::regionQuery(const BeliefGrid& grid,
+                                   std::uint32_t idx,
+                                   std::vector<std::uint32_t>& neighbors) const {
+    // Only used during expansion, where already-clustered neighbours are ignored
+    neighbors.clear();
+    const double eps2 = eps_ * eps_;  // Compare squared distances to avoid sqrt
+    grid.forEachCandidate(grid.point(idx), [&](std::uint32_t slot, double d2) {
+        if (d2 <= eps2) neighbors.push_back(slot);
+        return true;
+    }, true);
 }
 
-void DBSCANClustering::expandCluster(const std::vector<Agent>& agents,
+void DBSCANClustering::expandCluster(BeliefGrid& grid,
+                                     const std::vector<std::uint8_t>& core,
                                      std::uint32_t idx,
-                                     std::vector<std::uint32_t>& neighbors,
                                      std::vector<int>& labels,
                                      int clusterId) {
+    // Points are labelled when queued, so each enters the frontier once; only
+    // unvisited core points are expanded. Cluster membership is the same
+    // density-reachable closure as the queue-of-duplicates formulation.
+    std::vector<std::uint32_t> frontier{idx};
+    std::vector<std::uint32_t> neighbors;
     labels[idx] = clusterId;
-    std::size_t i = 0;
-    while (i < neighbors.size()) {
-        auto neighborIdx = neighbors[i];
-        if (labels[neighborIdx] == -1) {
-            labels[neighborIdx] = clusterId;
-        }
-        if (labels[neighborIdx] == 0) {
-            labels[neighborIdx] = clusterId;
-            auto neighborNeighbors = regionQuery(agents, neighborIdx);
-            if (static_cast<int>(neighborNeighbors.size()) >= minPts_) {
-                neighbors.insert(neighbors.end(), neighborNeighbors.begin(), neighborNeighbors.end());
+    grid.markClustered(idx);
+    while (!frontier.empty()) {
+        const std::uint32_t current = frontier.back();
+        frontier.pop_back();
+        regionQuery(grid, current, neighbors);
+        for (auto neighborIdx : neighbors) {
+            if (labels[neighborIdx] == -1) {
+                labels[neighborIdx] = clusterId;  // Border point, previously noise
+                grid.markClustered(neighborIdx);
+            } else if (labels[neighborIdx] == 0) {
+                labels[neighborIdx] = clusterId;
+                grid.markClustered(neighborIdx);
+                if (core[neighborIdx]) frontier.push_back(neighborIdx);
             }
         }
-        ++i;
     }
 }
 
 std::vector<Cluster> DBSCANClustering::run(const Kernel& kernel) {
     const auto& agents = kernel.agents();
-    std::vector<int> labels(agents.size(), 0);
+    const auto n = static_cast<std::uint32_t>(agents.size());
+    std::vector<int> labels(n, 0);
     int clusterId = 0;
     noisePoints_ = 0;
 
-    for (std::uint32_t i = 0; i < agents.size(); ++i) {
+    BeliefGrid grid(agents.B, eps_);
+
+    // Core test for every point up front (independent queries, stop at minPts)
+    std::vector<std::uint8_t> core(n, 0);
+    const double eps2 = eps_ * eps_;
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (std::uint32_t i = 0; i < n; ++i) {
+        int count = 0;
+        grid.forEachCandidate(grid.point(i), [&](std::uint32_t, double d2) {
+            if (d2 <= eps2) ++count;
+            return count < minPts_;
+        });
+        core[i] = count >= minPts_ ? 1 : 0;
+    }
+
+    for (std::uint32_t i = 0; i < n; ++i) {
         if (labels[i] != 0) continue;
-        auto neighbors = regionQuery(agents, i);
-        if (static_cast<int>(neighbors.size()) < minPts_) {
+        if (!core[i]) {
             labels[i] = -1;
             noisePoints_++;
         } else {
             ++clusterId;
-            expandCluster(agents, i, neighbors, labels, clusterId);
+            expandCluster(grid, core, i, labels, clusterId);
         }
     }
 
@@ -228,7 +558,7 @@ std::vector<Cluster> DBSCANClustering::run(const Kernel& kernel) {
             cluster.id = static_cast<std::uint32_t>(cid);
             cluster.birthTick = kernel.generation();
         }
-        cluster.members.push_back(agents[i].id);
+        cluster.members.push_back(i);
     }
 
     std::vector<Cluster> clusters;
@@ -259,8 +589,9 @@ void enrichClusters(std::vector<Cluster>& clusters, const Kernel& kernel) {
         for (auto aid : cluster.members) {
             const auto& agent = agents[aid];
             for (int d = 0; d < 4; ++d) {
-                sum[d] += agent.B[d];
-                sq[d] += agent.B[d] * agent.B[d];
+                const double b = agent.B[d];
+                sum[d] += b;
+                sq[d] += b * b;
             }
             langs[agent.primaryLang]++;
             regionCounts[agent.region]++;
@@ -1,6 +1,8 @@
 #include "modules/Economy.h"
 #include "modules/TradeNetwork.h"
-#include "kernel/Kernel.h"  // For Agent definition
+#include "kernel/Kernel.h"  // For AgentStore definition
+#include "utils/CounterRng.h"
+#include "utils/Profiler.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -86,6 +88,13 @@ constexpr double SPECIALIZATION_RATE = 0.001;  // per tick
 // Price adjustment rate
 constexpr double PRICE_ADJUSTMENT_RATE = 0.05;  // per tick based on supply/demand
 
+// Region-parallel stages: cheap per-region loops only fork a team at scale;
+// agent-heavy stages always do. Reductions use a fixed number of contiguous
+// region blocks (not one per thread) merged in block order, so the result is
+// the same for any thread count.
+constexpr std::size_t kMinParallelRegions = 1024;
+constexpr std::size_t kRegionBlocks = 16;
+
 // Transport cost (scales with distance)
 constexpr double BASE_TRANSPORT_COST = 0.02;  // 2% per hop
 
@@ -95,18 +104,17 @@ void Economy::init(std::uint32_t num_regions,
                    std::uint32_t num_agents,
                    std::mt19937_64& rng,
                    const std::string& start_condition) {
-    regions_.clear();
-    regions_.reserve(num_regions);
-    trade_links_.clear();
-    agents_.clear();
-    start_condition_name_ = start_condition;
-    start_profile_ = resolveStartCondition(start_condition);
-    
-    // Initialize trade network
-    trade_network_ = std::make_unique<TradeNetwork>();
-    trade_network_->configure(num_regions);
+    const EconomyGeography geography = buildGeography(num_regions, rng, start_condition);
+    init(geography, num_agents, rng);
+}
+
+EconomyGeography Economy::buildGeography(std::uint32_t num_regions, std::mt19937_64& rng,
+                                         const std::string& start_condition) {
+    Economy draft;  // No trade network yet: partners are only listed
+    draft.start_profile_ = draft.resolveStartCondition(start_condition);
+    draft.regions_.reserve(num_regions);
     
-    std::normal_distribution<double> devNoise(0.0, start_profile_.developmentJitter);
+    std::normal_distribution<double> devNoise(0.0, draft.start_profile_.developmentJitter);
     
     // Arrange regions in a grid for geographic calculations
     // e.g., 200 regions → 14x14 grid (196) + 4 extra
@@ -125,17 +133,67 @@ void Economy::init(std::uint32_t num_regions,
         region.x = std::clamp(region.x, 0.0, 1.0);
         region.y = std::clamp(region.y, 0.0, 1.0);
         
-        double devSample = start_profile_.baseDevelopment + devNoise(rng);
+        double devSample = draft.start_profile_.baseDevelopment + devNoise(rng);
         region.development = std::clamp(devSample, 0.02, 5.0);
-        region.economic_system = start_profile_.defaultSystem;  // Initial system
+        region.economic_system = draft.start_profile_.defaultSystem;  // Initial system
         region.system_stability = 1.0;
         
-        regions_.push_back(region);
+        draft.regions_.push_back(region);
     }
     
-    initializeEndowments(rng);
-    initializeTradeNetwork();
+    draft.initializeEndowments(rng);
+    draft.initializeTradeNetwork();
+    return EconomyGeography{start_condition, std::move(draft.regions_)};
+}
+
+void Economy::init(const EconomyGeography& geography, std::uint32_t num_agents, std::mt19937_64& rng) {
+    regions_ = geography.regions;
+    trade_links_.clear();
+    agents_.clear();
+    start_condition_name_ = geography.start_condition;
+    start_profile_ = resolveStartCondition(geography.start_condition);
+    
+    std::vector<std::vector<std::uint32_t>> trade_partners(regions_.size());
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        trade_partners[r] = regions_[r].trade_partners;
+    }
+    trade_network_ = std::make_unique<TradeNetwork>();
+    trade_network_->configure(static_cast<std::uint32_t>(regions_.size()));
+    trade_network_->buildTopology(trade_partners);
+    
     initializeAgents(num_agents, rng);
+    
+    // Seed the global distribution so wealth ranks are usable before the first update
+    wealth_global_.clear();
+    for (const auto& agent : agents_) {
+        wealth_global_.add(agent.wealth);
+    }
+}
+
+void Economy::restore(const std::string& start_condition, std::vector<RegionalEconomy> regions,
+                      std::vector<AgentEconomy> agents, EconomicSystem forced_model,
+                      double war_allocation) {
+    regions_ = std::move(regions);
+    agents_ = std::move(agents);
+    trade_links_.clear();
+    start_condition_name_ = start_condition;
+    start_profile_ = resolveStartCondition(start_condition);
+    forced_model_ = forced_model;
+    war_allocation_ = war_allocation;
+    
+    std::vector<std::vector<std::uint32_t>> trade_partners(regions_.size());
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        trade_partners[r] = regions_[r].trade_partners;
+    }
+    trade_network_ = std::make_unique<TradeNetwork>();
+    trade_network_->configure(static_cast<std::uint32_t>(regions_.size()));
+    trade_network_->buildTopology(trade_partners);
+    
+    // Ranks are usable before the first update, as after init()
+    wealth_global_.clear();
+    for (const auto& agent : agents_) {
+        wealth_global_.add(agent.wealth);
+    }
 }
 
 void Economy::update(const std::vector<std::uint32_t>& region_populations,
@@ -143,6 +201,14 @@ void Economy::update(const std::vector<std::uint32_t>& region_populations,
                     const std::vector<Agent>& agents,
                     std::uint64_t generation,
                     const std::vector<std::vector<std::uint32_t>>* region_index) {
+    update(region_populations, region_belief_centroids, AgentStore(agents), generation, region_index);
+}
+
+void Economy::update(const std::vector<std::uint32_t>& region_populations,
+                    const std::vector<std::array<double, 4>>& region_belief_centroids,
+                    const AgentStore& agents,
+                    std::uint64_t generation,
+                    const std::vector<std::vector<std::uint32_t>>* region_index) {
     // Update population counts
     for (std::size_t i = 0; i < regions_.size(); ++i) {
         regions_[i].population = region_populations[i];
@@ -150,6 +216,8 @@ void Economy::update(const std::vector<std::uint32_t>& region_populations,
     
     // Economic evolution happens gradually
     if (generation % 10 == 0) {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyEvolution);
+        CIV_PROFILE_TOUCH(agents.size());
         evolveSpecialization();
         evolveDevelopment();
         // Use dominant pole analysis when we have per-agent data
@@ -161,18 +229,46 @@ void Economy::update(const std::vector<std::uint32_t>& region_populations,
         }
     }
     
-    computeProduction();
-    computeTrade();
-    computeConsumption();
-    updatePrices();
-    distributeIncome(agents, region_index);
-    computeWelfare();
-    computeInequality(agents, region_index);
-    computeHardship();
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyProduction);
+        computeProduction();
+    }
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyTrade);
+        computeTrade();
+    }
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyConsumption);
+        computeConsumption();
+    }
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyPrices);
+        updatePrices();
+    }
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyIncome);
+        CIV_PROFILE_TOUCH(agents.size());
+        distributeIncome(agents, region_index);
+    }
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyWelfare);
+        computeWelfare();
+    }
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyInequality);
+        CIV_PROFILE_TOUCH(agents.size());
+        computeInequality(agents, region_index);
+    }
+    {
+        CIV_PROFILE_SCOPE(profiler::Phase::EconomyHardship);
+        computeHardship();
+    }
 }
 
 void Economy::computeProduction() {
-    for (auto& region : regions_) {
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        auto& region = regions_[r];
         for (int g = 0; g < kGoodTypes; ++g) {
             // production = endowment_per_capita × population × specialization × tech × efficiency × development × (1 - war)
             double spec_bonus = 1.0 + region.specialization[g];
@@ -190,7 +286,9 @@ void Economy::computeProduction() {
 }
 
 void Economy::computeWelfare() {
-    for (auto& region : regions_) {
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        auto& region = regions_[r];
         if (region.population == 0) {
             region.welfare = 1.0;
             continue;
@@ -213,59 +311,79 @@ void Economy::computeWelfare() {
     }
 }
 
-void Economy::computeInequality(const std::vector<Agent>& agents,
+void Economy::computeInequality(const AgentStore& agents,
                                 const std::vector<std::vector<std::uint32_t>>* region_index) {
-    // Compute Gini coefficient for each region based on agent wealth
-    // This is now FULLY EMERGENT - no overrides based on economic system labels
-    for (std::size_t i = 0; i < regions_.size(); ++i) {
-        if (regions_[i].population == 0) {
-            regions_[i].inequality = 0.0;
-            continue;
+    // One sketch pass per region yields the Gini coefficient and the top-10% /
+    // bottom-50% wealth shares together; regional sketches merge into their
+    // block's sketch and blocks merge, in order, into the global distribution.
+    // This is FULLY EMERGENT - no overrides based on economic system labels.
+    
+    // Slots of region r are slots[offsets[r] .. offsets[r + 1]); with an index
+    // the region lists are used directly
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> slots;
+    if (region_index == nullptr) {
+        // No index: bucket slots by region in one pass
+        offsets.assign(regions_.size() + 1, 0);
+        const std::size_t n = std::min(agents.size(), agents_.size());
+        for (std::size_t a = 0; a < n; ++a) {
+            if (agents.region[a] < regions_.size()) offsets[agents.region[a] + 1]++;
         }
-        
-        // Compute Gini from agent wealth distribution - this is the TRUE inequality
-        // Use region_index if available for faster lookup
-        double gini = 0.0;
-        if (region_index && i < region_index->size()) {
-            const auto& agent_ids = (*region_index)[i];
-            if (agent_ids.empty()) {
-                gini = 0.0;
-            } else {
-                // Fast Gini using pre-indexed agents
-                std::vector<double> wealths;
-                wealths.reserve(agent_ids.size());
-                for (auto aid : agent_ids) {
-                    if (aid < agents_.size()) {
-                        wealths.push_back(agents_[aid].wealth);
+        for (std::size_t r = 0; r < regions_.size(); ++r) offsets[r + 1] += offsets[r];
+        slots.resize(offsets.back());
+        std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (std::size_t a = 0; a < n; ++a) {
+            if (agents.region[a] < regions_.size()) slots[cursor[agents.region[a]]++] = static_cast<std::uint32_t>(a);
+        }
+    }
+    
+    const std::size_t num_regions = regions_.size();
+    const std::size_t blocks = std::min(kRegionBlocks, std::max<std::size_t>(num_regions, 1));
+    if (wealth_blocks_.size() < blocks) {
+        wealth_scratch_.resize(blocks);
+        wealth_blocks_.resize(blocks);
+    }
+    
+    #pragma omp parallel for schedule(dynamic) if(region_parallel_)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        auto& scratch = wealth_scratch_[b];
+        auto& block = wealth_blocks_[b];
+        block.clear();
+        for (std::size_t r = num_regions * b / blocks; r < num_regions * (b + 1) / blocks; ++r) {
+            scratch.clear();
+            if (region_index != nullptr) {
+                if (r < region_index->size()) {
+                    for (auto aid : (*region_index)[r]) {
+                        if (aid < agents_.size()) scratch.add(agents_[aid].wealth);
                     }
                 }
-                
-                if (wealths.size() < 2) {
-                    gini = 0.0;
-                } else {
-                    std::sort(wealths.begin(), wealths.end());
-                    double sum_of_differences = 0.0;
-                    double total = 0.0;
-                    std::size_t n = wealths.size();
-                    for (std::size_t j = 0; j < n; ++j) {
-                        total += wealths[j];
-                        sum_of_differences += wealths[j] * (2.0 * j - n + 1.0);
-                    }
-                    gini = (total > 0.0) ? sum_of_differences / (n * total) : 0.0;
+            } else {
+                for (std::uint32_t k = offsets[r]; k < offsets[r + 1]; ++k) {
+                    scratch.add(agents_[slots[k]].wealth);
                 }
             }
-        } else {
-            gini = computeRegionGini(static_cast<std::uint32_t>(i), agents);
+            
+            auto& region = regions_[r];
+            const auto stats = scratch.summary(0.1, 0.5);
+            region.inequality = (region.population == 0) ? 0.0 : stats.gini;
+            if (!scratch.empty()) {
+                region.wealth_top_10 = stats.topShare;
+                region.wealth_bottom_50 = stats.bottomShare;
+                block.merge(scratch);
+            }
         }
-        
-        // No more overrides! The economic system's inequality emerges from
-        // actual agent wealth distribution, not predetermined assumptions
-        regions_[i].inequality = gini;
+    }
+    
+    wealth_global_.clear();
+    for (std::size_t b = 0; b < blocks; ++b) {
+        wealth_global_.merge(wealth_blocks_[b]);
     }
 }
 
 void Economy::computeHardship() {
-    for (auto& region : regions_) {
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        auto& region = regions_[r];
         if (region.population == 0) {
             region.hardship = 0.0;
             continue;
@@ -422,32 +540,37 @@ void Economy::initializeTradeNetwork() {
 }
 
 void Economy::initializeAgents(std::uint32_t num_agents, std::mt19937_64& rng) {
-    agents_.clear();
-    agents_.reserve(num_agents);
-    
-    // Log-normal distribution for wealth
-    std::lognormal_distribution<double> wealth_dist(start_profile_.wealthLogMean,
-                                                   start_profile_.wealthLogStd);
-    std::uniform_int_distribution<int> sector_dist(0, kGoodTypes - 1);
-    // Individual productivity variance (skills, education, health)
-    std::normal_distribution<double> productivity_dist(start_profile_.productivityMean,
-                                                       start_profile_.productivityStd);
-    
-    for (std::uint32_t i = 0; i < num_agents; ++i) {
-        AgentEconomy agent;
-        agent.wealth = std::max(0.05, wealth_dist(rng));
+    // One draw keys every agent's Founding stream, so agents are filled in
+    // parallel and the result does not depend on thread count
+    const std::uint64_t seed = rng();
+    agents_.assign(num_agents, AgentEconomy{});
+    
+    #pragma omp parallel for schedule(static) if(region_parallel_)
+    for (std::int64_t s = 0; s < static_cast<std::int64_t>(num_agents); ++s) {
+        const auto i = static_cast<std::uint32_t>(s);
+        rng::CounterRng agentRng(seed, 0, i, rng::Stream::Founding);
+        // Log-normal distribution for wealth
+        std::lognormal_distribution<double> wealth_dist(start_profile_.wealthLogMean,
+                                                       start_profile_.wealthLogStd);
+        std::uniform_int_distribution<int> sector_dist(0, kGoodTypes - 1);
+        // Individual productivity variance (skills, education, health)
+        std::normal_distribution<double> productivity_dist(start_profile_.productivityMean,
+                                                           start_profile_.productivityStd);
+        
+        AgentEconomy& agent = agents_[i];
+        agent.wealth = std::max(0.05, wealth_dist(agentRng));
         agent.income = 1.0;
-        agent.productivity = std::clamp(productivity_dist(rng), 0.2, 3.0);
-        agent.sector = sector_dist(rng);
+        agent.productivity = std::clamp(productivity_dist(agentRng), 0.2, 3.0);
+        agent.sector = sector_dist(agentRng);
         agent.hardship = 0.0;
-        
-        agents_.push_back(agent);
     }
 }
 
 void Economy::evolveSpecialization() {
     // Regions gradually specialize based on comparative advantage
-    for (auto& region : regions_) {
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        auto& region = regions_[r];
         // Find resource with highest endowment
         int best_good = 0;
         double best_endowment = region.endowments[0];
@@ -497,6 +620,7 @@ void Economy::computeTrade() {
     std::vector<std::array<double, kGoodTypes>> demand(regions_.size());
     std::vector<std::uint32_t> population(regions_.size());
     
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
     for (std::size_t i = 0; i < regions_.size(); ++i) {
         production[i] = regions_[i].production;
         population[i] = regions_[i].population;
@@ -526,7 +650,9 @@ void Economy::computeTrade() {
 }
 
 void Economy::computeConsumption() {
-    for (auto& region : regions_) {
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        auto& region = regions_[r];
         for (int g = 0; g < kGoodTypes; ++g) {
             // Consumption = local production + net imports
             region.consumption[g] = region.production[g] + region.trade_balance[g];
@@ -537,7 +663,9 @@ void Economy::computeConsumption() {
 
 void Economy::updatePrices() {
     // Adjust prices based on supply/demand balance
-    for (auto& region : regions_) {
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        auto& region = regions_[r];
         if (region.population == 0) continue;
         
         // Get regional needs for price calculation
@@ -578,14 +706,17 @@ void Economy::updatePrices() {
     }
 }
 
-void Economy::distributeIncome(const std::vector<Agent>& agents,
+void Economy::distributeIncome(const AgentStore& agents,
                                const std::vector<std::vector<std::uint32_t>>* region_index) {
     // Distribute income to agents based on productivity and regional economy
     // This creates wealth inequality over time
     
     if (region_index != nullptr) {
-        // OPTIMIZED PATH: Use region_index for O(N) with locality
-        for (std::size_t i = 0; i < regions_.size() && i < region_index->size(); ++i) {
+        // OPTIMIZED PATH: Use region_index for O(N) with locality. The index
+        // partitions agents, so regions write disjoint slots and run in parallel
+        const std::size_t indexed = std::min(regions_.size(), region_index->size());
+        #pragma omp parallel for schedule(dynamic) if(region_parallel_)
+        for (std::size_t i = 0; i < indexed; ++i) {
             auto& region = regions_[i];
             const auto& agent_ids = (*region_index)[i];
             if (agent_ids.empty()) continue;
@@ -694,28 +825,6 @@ void Economy::distributeIncome(const std::vector<Agent>& agents,
                 agent.hardship = (consumption_capacity < 1.0) ? (1.0 - consumption_capacity) : 0.0;
                 agent.hardship = std::clamp(agent.hardship, 0.0, 1.0);
             }
-            
-            // Update regional wealth distribution metrics (one pass over region)
-            std::vector<double> wealths;
-            wealths.reserve(agent_ids.size());
-            for (auto agent_id : agent_ids) {
-                if (agent_id < agents_.size()) {
-                    wealths.push_back(agents_[agent_id].wealth);
-                }
-            }
-            
-            if (!wealths.empty()) {
-                std::sort(wealths.begin(), wealths.end());
-                
-                std::size_t top_10_start = wealths.size() * 9 / 10;
-                double top_10_wealth = std::accumulate(wealths.begin() + top_10_start, wealths.end(), 0.0);
-                double total_wealth = std::accumulate(wealths.begin(), wealths.end(), 0.0);
-                region.wealth_top_10 = (total_wealth > 0) ? (top_10_wealth / total_wealth) : 0.0;
-                
-                std::size_t bottom_50_end = wealths.size() / 2;
-                double bottom_50_wealth = std::accumulate(wealths.begin(), wealths.begin() + bottom_50_end, 0.0);
-                region.wealth_bottom_50 = (total_wealth > 0) ? (bottom_50_wealth / total_wealth) : 0.0;
-            }
         }
     } else {
         // FALLBACK PATH: Original O(N) implementation
@@ -819,36 +928,13 @@ void Economy::distributeIncome(const std::vector<Agent>& agents,
             agent.hardship = (consumption_capacity < 1.0) ? (1.0 - consumption_capacity) : 0.0;
             agent.hardship = std::clamp(agent.hardship, 0.0, 1.0);
         }
-        
-        // Third pass: Update regional wealth distribution metrics
-        for (std::size_t r = 0; r < regions_.size(); ++r) {
-            if (regions_[r].population == 0) continue;
-            
-            std::vector<double> wealths;
-            for (std::size_t i = 0; i < agents_.size(); ++i) {
-                if (agents[i].region == r) {
-                    wealths.push_back(agents_[i].wealth);
-                }
-            }
-            
-            if (wealths.empty()) continue;
-            
-            std::sort(wealths.begin(), wealths.end());
-            
-            std::size_t top_10_start = wealths.size() * 9 / 10;
-            double top_10_wealth = std::accumulate(wealths.begin() + top_10_start, wealths.end(), 0.0);
-            double total_wealth = std::accumulate(wealths.begin(), wealths.end(), 0.0);
-            regions_[r].wealth_top_10 = (total_wealth > 0) ? (top_10_wealth / total_wealth) : 0.0;
-            
-            std::size_t bottom_50_end = wealths.size() / 2;
-            double bottom_50_wealth = std::accumulate(wealths.begin(), wealths.begin() + bottom_50_end, 0.0);
-            regions_[r].wealth_bottom_50 = (total_wealth > 0) ? (bottom_50_wealth / total_wealth) : 0.0;
-        }
     }
 }
 
 void Economy::evolveDevelopment() {
-    for (auto& region : regions_) {
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
+    for (std::size_t r = 0; r < regions_.size(); ++r) {
+        auto& region = regions_[r];
         if (region.population == 0) continue;
         
         // Development grows with welfare surplus, decays with hardship
@@ -866,7 +952,7 @@ void Economy::evolveDevelopment() {
 
 RegionalBeliefProfile Economy::analyzeRegionalBeliefs(
     uint32_t region_id,
-    const std::vector<Agent>& agents,
+    const AgentStore& agents,
     const std::vector<std::vector<std::uint32_t>>& region_index) const {
     
     RegionalBeliefProfile profile;
@@ -946,7 +1032,7 @@ RegionalBeliefProfile Economy::analyzeRegionalBeliefs(
 }
 
 void Economy::evolveEconomicSystems(const std::vector<std::array<double, 4>>& region_belief_centroids) {
-    if (forced_model_ != "") {
+    if (forced_model_ != EconomicSystem::None) {
         // Global policy override
         for (auto& region : regions_) {
             region.economic_system = forced_model_;
@@ -956,6 +1042,7 @@ void Economy::evolveEconomicSystems(const std::vector<std::array<double, 4>>& re
     }
     
     // Economic systems emerge from beliefs + material conditions
+    #pragma omp parallel for schedule(static) if(region_parallel_ && regions_.size() >= kMinParallelRegions)
     for (std::size_t i = 0; i < regions_.size(); ++i) {
         auto& region = regions_[i];
         const auto& beliefs = region_belief_centroids[i];
@@ -969,8 +1056,8 @@ void Economy::evolveEconomicSystems(const std::vector<std::array<double, 4>>& re
         region.institutional_inertia = std::min(0.9, 
             region.institutional_inertia * 0.99 + time_lock);
         
-        std::string ideal_system = determineEconomicSystem(beliefs, region.development, 
-                                                           region.hardship, region.inequality);
+        EconomicSystem ideal_system = determineEconomicSystem(beliefs, region.development,
+                                                              region.hardship, region.inequality);
         
         // EMERGENT SYSTEM TRANSITION WITH HYSTERESIS AND PATH DEPENDENCE
         // Systems require sustained pressure over multiple ticks to change
@@ -1007,7 +1094,7 @@ void Economy::evolveEconomicSystems(const std::vector<std::array<double, 4>>& re
                 if (region.transition_pressure_ticks >= required_ticks) {
                     // Transition happens! This is a major disruption
                     region.economic_system = ideal_system;
-                    region.pending_system = "";
+                    region.pending_system = EconomicSystem::None;
                     region.transition_pressure_ticks = 0;
                     region.years_in_current_system = 0;  // Reset: new system
                     region.institutional_inertia *= 0.5;  // Disruption reduces inertia
@@ -1029,7 +1116,7 @@ void Economy::evolveEconomicSystems(const std::vector<std::array<double, 4>>& re
             }
         } else {
             // System matches ideal - no pressure, recover stability
-            region.pending_system = "";
+            region.pending_system = EconomicSystem::None;
             // Pressure decay is also affected by inertia (stable systems shed pressure slowly)
             region.transition_pressure_ticks = static_cast<int>(
                 region.transition_pressure_ticks * (0.8 + region.institutional_inertia * 0.15)
@@ -1067,10 +1154,10 @@ void Economy::evolveEconomicSystems(const std::vector<std::array<double, 4>>& re
 }
 
 void Economy::evolveEconomicSystems(
-    const std::vector<Agent>& agents,
+    const AgentStore& agents,
     const std::vector<std::vector<std::uint32_t>>& region_index) {
     
-    if (forced_model_ != "") {
+    if (forced_model_ != EconomicSystem::None) {
         // Global policy override
         for (auto& region : regions_) {
             region.economic_system = forced_model_;
@@ -1081,6 +1168,8 @@ void Economy::evolveEconomicSystems(
     
     // Economic systems emerge from beliefs + material conditions
     // Now using DOMINANT POLE analysis for differentiated outcomes
+    // (regions only read their own agents, so they run in parallel)
+    #pragma omp parallel for schedule(dynamic) if(region_parallel_)
     for (std::size_t i = 0; i < regions_.size(); ++i) {
         auto& region = regions_[i];
         
@@ -1097,8 +1186,8 @@ void Economy::evolveEconomicSystems(
             region.institutional_inertia * 0.99 + time_lock);
         
         // Use dominant pole for system determination - NOT mean!
-        std::string ideal_system = determineEconomicSystem(profile, region.development, 
-                                                           region.hardship, region.inequality);
+        EconomicSystem ideal_system = determineEconomicSystem(profile, region.development,
+                                                              region.hardship, region.inequality);
         
         // EMERGENT SYSTEM TRANSITION WITH HYSTERESIS AND PATH DEPENDENCE
         if (region.economic_system != ideal_system) {
@@ -1125,7 +1214,7 @@ void Economy::evolveEconomicSystems(
                 
                 if (region.transition_pressure_ticks >= required_ticks) {
                     region.economic_system = ideal_system;
-                    region.pending_system = "";
+                    region.pending_system = EconomicSystem::None;
                     region.transition_pressure_ticks = 0;
                     region.years_in_current_system = 0;
                     region.institutional_inertia *= 0.5;
@@ -1141,7 +1230,7 @@ void Economy::evolveEconomicSystems(
                 }
             }
         } else {
-            region.pending_system = "";
+            region.pending_system = EconomicSystem::None;
             region.transition_pressure_ticks = static_cast<int>(
                 region.transition_pressure_ticks * (0.8 + region.institutional_inertia * 0.15)
             );
@@ -1170,26 +1259,28 @@ void Economy::evolveEconomicSystems(
     }
 }
 
-Economy::StartConditionProfile Economy::resolveStartCondition(const std::string& name) const {
-    auto normalize = [](const std::string& raw) {
-        std::string normalized;
-        normalized.reserve(raw.size());
-        for (unsigned char ch : raw) {
-            if (std::isalnum(ch)) {
-                normalized.push_back(static_cast<char>(std::tolower(ch)));
-            }
+std::string Economy::canonicalStartCondition(const std::string& name) {
+    std::string normalized;
+    normalized.reserve(name.size());
+    for (unsigned char ch : name) {
+        if (std::isalnum(ch)) {
+            normalized.push_back(static_cast<char>(std::tolower(ch)));
         }
-        if (normalized.empty()) {
-            normalized = "baseline";
-        }
-        return normalized;
-    };
+    }
+    if (normalized.empty() || normalized == "baseline") return "baseline";
+    if (normalized == "postscarcity" || normalized == "abundance" || normalized == "utopia") return "postscarcity";
+    if (normalized == "feudal" || normalized == "agrarian" || normalized == "lowtech") return "feudal";
+    if (normalized == "industrial" || normalized == "industrializing" || normalized == "boom") return "industrial";
+    if (normalized == "crisis" || normalized == "collapse" || normalized == "depression") return "crisis";
+    return {};
+}
 
+Economy::StartConditionProfile Economy::resolveStartCondition(const std::string& name) const {
     auto make_profile = [](const std::string& canonical,
                            const std::array<double, kGoodTypes>& multipliers,
                            double base_dev,
                            double jitter,
-                           std::string default_system,
+                           EconomicSystem default_system,
                            double wealth_mean,
                            double wealth_std,
                            double prod_mean,
@@ -1199,7 +1290,7 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
         profile.endowmentMultipliers = multipliers;
         profile.baseDevelopment = base_dev;
         profile.developmentJitter = jitter;
-        profile.defaultSystem = std::move(default_system);
+        profile.defaultSystem = default_system;
         profile.wealthLogMean = wealth_mean;
         profile.wealthLogStd = wealth_std;
         profile.productivityMean = prod_mean;
@@ -1207,62 +1298,62 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
         return profile;
     };
 
-    const std::string normalized = normalize(name);
+    const std::string normalized = canonicalStartCondition(name);
 
     if (normalized == "baseline") {
         return make_profile("baseline",
                             {1.0, 1.0, 1.0, 0.85, 0.95},
                             0.8,
                             0.25,
-                            "mixed",
+                            EconomicSystem::Mixed,
                             0.1,
                             0.65,
                             1.0,
                             0.25);
     }
 
-    if (normalized == "postscarcity" || normalized == "abundance" || normalized == "utopia") {
+    if (normalized == "postscarcity") {
         return make_profile("postscarcity",
                             {1.2, 1.1, 1.05, 1.35, 1.45},
                             2.4,
                             0.15,
-                            "cooperative",
+                            EconomicSystem::Cooperative,
                             0.3,
                             0.35,
                             1.2,
                             0.2);
     }
 
-    if (normalized == "feudal" || normalized == "agrarian" || normalized == "lowtech") {
+    if (normalized == "feudal") {
         return make_profile("feudal",
                             {1.4, 0.6, 0.4, 0.2, 0.25},
                             0.35,
                             0.08,
-                            "feudal",
+                            EconomicSystem::Feudal,
                             -0.7,
                             1.05,
                             0.75,
                             0.35);
     }
 
-    if (normalized == "industrial" || normalized == "industrializing" || normalized == "boom") {
+    if (normalized == "industrial") {
         return make_profile("industrial",
                             {0.9, 1.25, 1.35, 0.9, 0.95},
                             1.4,
                             0.30,
-                            "market",
+                            EconomicSystem::Market,
                             0.15,
                             0.55,
                             1.1,
                             0.35);
     }
 
-    if (normalized == "crisis" || normalized == "collapse" || normalized == "depression") {
+    if (normalized == "crisis") {
         return make_profile("crisis",
                             {0.65, 0.7, 0.75, 0.55, 0.6},
                             0.6,
                             0.2,
-                            "mixed",
+                            EconomicSystem::Mixed,
                             -0.2,
                             0.9,
                             0.9,
@@ -1275,17 +1366,17 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
                         {1.0, 1.0, 1.0, 0.85, 0.95},
                         0.8,
                         0.25,
-                        "mixed",
+                        EconomicSystem::Mixed,
                         0.1,
                         0.65,
                         1.0,
                         0.25);
 }
 
-std::string Economy::determineEconomicSystem(const std::array<double, 4>& beliefs,
-                                             double development,
-                                             double hardship,
-                                             double inequality) const {
+EconomicSystem Economy::determineEconomicSystem(const std::array<double, 4>& beliefs,
+                                                double development,
+                                                double hardship,
+                                                double inequality) const {
     // Belief axes: [0]=Authority, [1]=Tradition, [2]=Hierarchy, [3]=Faith
     // Negative = (Liberty, Progress, Equality, Rationalism)
     
@@ -1296,49 +1387,49 @@ std::string Economy::determineEconomicSystem(const std::array<double, 4>& belief
     // Low development → feudal or cooperative (subsistence economies)
     if (development < 0.6) {
         if (hierarchy > 0.15 && authority > 0.1) {
-            return "feudal";  // traditional hierarchy
+            return EconomicSystem::Feudal;  // traditional hierarchy
         } else if (hierarchy < -0.1) {
-            return "cooperative";  // communal subsistence
+            return EconomicSystem::Cooperative;  // communal subsistence
         }
     }
     
     // Crisis conditions → revolutionary pressure
     if (hardship > 0.4 && inequality > 0.5) {
         if (hierarchy < -0.1) {  // egalitarian beliefs
-            return "planned";  // equality-seeking planned economy
+            return EconomicSystem::Planned;  // equality-seeking planned economy
         } else if (authority > 0.1) {
-            return "feudal";  // strongman restoration
+            return EconomicSystem::Feudal;  // strongman restoration
         }
     }
     
     // Developed + liberty + equality → cooperative/social democracy
     if (development > 1.2 && authority < -0.15 && hierarchy < -0.15) {
-        return "cooperative";
+        return EconomicSystem::Cooperative;
     }
     
     // Developed + liberty + accepts hierarchy → market capitalism
     if (development > 0.8 && authority < -0.1 && hierarchy > 0.05) {
-        return "market";
+        return EconomicSystem::Market;
     }
     
     // Developed + authority + equality-leaning → planned economy
     if (development > 0.8 && authority > 0.15 && hierarchy < 0.1) {
-        return "planned";
+        return EconomicSystem::Planned;
     }
     
     // Traditional + hierarchical but developed → feudal remnants
     if (tradition > 0.2 && hierarchy > 0.2 && development < 1.0) {
-        return "feudal";
+        return EconomicSystem::Feudal;
     }
     
     // Default: mixed economy (most common in moderate conditions)
-    return "mixed";
+    return EconomicSystem::Mixed;
 }
 
-std::string Economy::determineEconomicSystem(const RegionalBeliefProfile& profile,
-                                             double development,
-                                             double hardship,
-                                             double inequality) const {
+EconomicSystem Economy::determineEconomicSystem(const RegionalBeliefProfile& profile,
+                                                double development,
+                                                double hardship,
+                                                double inequality) const {
     // NEW: Use DOMINANT POLE instead of mean for system determination
     // This prevents averaging cancellation where opposing factions neutralize each other
     // Instead, the dominant faction's beliefs drive system selection
@@ -1356,18 +1447,18 @@ std::string Economy::determineEconomicSystem(const RegionalBeliefProfile& profil
     // Low development → feudal or cooperative (subsistence economies)
     if (development < 0.4) {
         if (hierarchy > 0.1 && authority > 0.05) {
-            return "feudal";  // traditional hierarchy
+            return EconomicSystem::Feudal;  // traditional hierarchy
         } else if (hierarchy < -0.05) {
-            return "cooperative";  // communal subsistence
+            return EconomicSystem::Cooperative;  // communal subsistence
         }
     }
     
     // Crisis conditions → revolutionary pressure
     if (hardship > 0.35 && inequality > 0.45) {
         if (hierarchy < -0.05) {  // egalitarian beliefs
-            return "planned";  // equality-seeking planned economy
+            return EconomicSystem::Planned;  // equality-seeking planned economy
         } else if (authority > 0.05) {
-            return "feudal";  // strongman restoration
+            return EconomicSystem::Feudal;  // strongman restoration
         }
     }
     
@@ -1376,46 +1467,46 @@ std::string Economy::determineEconomicSystem(const RegionalBeliefProfile& profil
     if (profile.polarization > 0.05) {
         // Polarized: use the dominant pole directly with LOWER thresholds
         if (development > 0.8 && authority < -0.1 && hierarchy < -0.1) {
-            return "cooperative";
+            return EconomicSystem::Cooperative;
         }
         if (development > 0.5 && authority < -0.05 && hierarchy > 0.02) {
-            return "market";
+            return EconomicSystem::Market;
         }
         if (development > 0.5 && authority > 0.1 && hierarchy < 0.05) {
-            return "planned";
+            return EconomicSystem::Planned;
         }
         if (hierarchy > 0.12 && authority > 0.08) {
-            return "feudal";
+            return EconomicSystem::Feudal;
         }
     }
     
     // Developed + liberty + equality → cooperative/social democracy
     if (development > 0.8 && authority < -0.1 && hierarchy < -0.1) {
-        return "cooperative";
+        return EconomicSystem::Cooperative;
     }
     
     // Developed + liberty + accepts hierarchy → market capitalism  
     if (development > 0.5 && authority < -0.05 && hierarchy > 0.02) {
-        return "market";
+        return EconomicSystem::Market;
     }
     
     // Developed + authority + equality-leaning → planned economy
     if (development > 0.5 && authority > 0.1 && hierarchy < 0.05) {
-        return "planned";
+        return EconomicSystem::Planned;
     }
     
     // Traditional + hierarchical → feudal remnants
     if (tradition > 0.1 && hierarchy > 0.12 && development < 0.7) {
-        return "feudal";
+        return EconomicSystem::Feudal;
     }
     
     // Default: mixed economy (only for truly contested regions with no dominant pole)
-    return "mixed";
+    return EconomicSystem::Mixed;
 }
 
 
-double Economy::computeRegionGini(std::uint32_t region_id, const std::vector<Agent>& agents) const {
-    // Compute Gini coefficient for wealth distribution in a region using O(N log N) algorithm
+double Economy::computeRegionGini(std::uint32_t region_id, const AgentStore& agents) const {
+    // Gini coefficient for wealth distribution in a region (sketch-based, no sort)
     // Gini = 0 (perfect equality) to 1 (total inequality)
     
     // Validate region_id
@@ -1427,34 +1518,14 @@ double Economy::computeRegionGini(std::uint32_t region_id, const std::vector<Age
     
     if (agents_.empty()) return 0.0;
     
-    // Collect agent wealths in this region using actual agent.region values
-    std::vector<double> wealths;
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        if (agents[i].region == region_id) {
-            wealths.push_back(agents_[i].wealth);
+    WealthDistribution distribution;
+    const std::size_t n = std::min(agents.size(), agents_.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (agents.region[i] == region_id) {
+            distribution.add(agents_[i].wealth);
         }
     }
-    
-    if (wealths.size() < 2) return 0.0;
-    
-    // Sort wealths O(N log N)
-    std::sort(wealths.begin(), wealths.end());
-    
-    // Compute Gini using efficient formula: Gini = (2 * weighted_sum) / (n * total_sum) - (n+1)/n
-    // where weighted_sum = sum of (i+1) * wealth[i]
-    double weighted_sum = 0.0;
-    double total_sum = 0.0;
-    
-    for (std::size_t i = 0; i < wealths.size(); ++i) {
-        weighted_sum += (i + 1) * wealths[i];
-        total_sum += wealths[i];
-    }
-    
-    if (total_sum == 0.0) return 0.0;
-    
-    std::size_t n = wealths.size();
-    double gini = (2.0 * weighted_sum) / (n * total_sum) - (n + 1.0) / n;
-    return gini;
+    return distribution.gini();
 }
 
 const RegionalEconomy& Economy::getRegion(std::uint32_t region_id) const {
@@ -1491,6 +1562,54 @@ void Economy::addAgent(std::uint32_t agent_id, std::uint32_t region_id, std::mt1
     agent.hardship = 0.0;
 }
 
+void Economy::addAgents(std::uint32_t first_id, const std::vector<std::uint32_t>& regions,
+                        std::mt19937_64& rng) {
+    const std::size_t end = static_cast<std::size_t>(first_id) + regions.size();
+    if (end > agents_.size()) {
+        agents_.resize(end);
+    }
+    for (std::size_t k = 0; k < regions.size(); ++k) {
+        addAgent(first_id + static_cast<std::uint32_t>(k), regions[k], rng);
+    }
+}
+
+void Economy::compactAgents(const std::vector<std::uint32_t>& remap) {
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < remap.size() && i < agents_.size(); ++i) {
+        if (remap[i] == AgentStore::kNoSlot) continue;
+        if (remap[i] != i) {
+            agents_[remap[i]] = agents_[i];
+        }
+        kept = static_cast<std::size_t>(remap[i]) + 1;
+    }
+    agents_.resize(kept);
+}
+
+void Economy::reorderAgents(const std::vector<std::uint32_t>& order) {
+    std::vector<AgentEconomy> next;
+    next.reserve(order.size());
+    for (const auto slot : order) next.push_back(slot < agents_.size() ? agents_[slot] : AgentEconomy{});
+    agents_ = std::move(next);
+}
+
+MemoryFootprint Economy::memoryUsage() const {
+    MemoryFootprint m;
+    m.add(regions_);
+    for (const auto& region : regions_) m.add(region.trade_partners);
+    m.add(trade_links_);
+    m.add(agents_);
+    m.add(wealth_scratch_);
+    m.add(wealth_blocks_);
+    for (const auto& w : wealth_scratch_) m.add(w.memoryUsage());
+    for (const auto& w : wealth_blocks_) m.add(w.memoryUsage());
+    m.add(wealth_global_.memoryUsage());
+    return m;
+}
+
+MemoryFootprint Economy::tradeMemoryUsage() const {
+    return trade_network_ ? trade_network_->memoryUsage() : MemoryFootprint{};
+}
+
 void Economy::migrateAgent(std::uint32_t agent_id, std::uint32_t from_region, std::uint32_t to_region) {
     // Update agent's economic sector when they migrate between regions
     // Migrants often shift to sectors that are in demand in their new region
@@ -1533,62 +1652,44 @@ void Economy::migrateAgent(std::uint32_t agent_id, std::uint32_t from_region, st
     agent.wealth *= 0.9;  // Flat 10% moving cost for now
 }
 
-double Economy::globalWelfare() const {
-    if (regions_.empty()) return 1.0;
+double Economy::populationWeightedMean(double RegionalEconomy::*field, double empty_value) const {
+    // Per-block partial sums folded in block order: deterministic for any thread count
+    const std::size_t num_regions = regions_.size();
+    std::array<double, kRegionBlocks> weighted{};
+    std::array<std::uint64_t, kRegionBlocks> population{};
+    
+    #pragma omp parallel for schedule(static) if(region_parallel_ && num_regions >= kMinParallelRegions)
+    for (std::size_t b = 0; b < kRegionBlocks; ++b) {
+        for (std::size_t r = num_regions * b / kRegionBlocks; r < num_regions * (b + 1) / kRegionBlocks; ++r) {
+            weighted[b] += regions_[r].*field * regions_[r].population;
+            population[b] += regions_[r].population;
+        }
+    }
     
-    double total_welfare = 0.0;
+    double total = 0.0;
     std::uint64_t total_population = 0;
-    
-    for (const auto& region : regions_) {
-        total_welfare += region.welfare * region.population;
-        total_population += region.population;
+    for (std::size_t b = 0; b < kRegionBlocks; ++b) {
+        total += weighted[b];
+        total_population += population[b];
     }
-    
-    return (total_population > 0) ? (total_welfare / total_population) : 1.0;
+    return (total_population > 0) ? (total / total_population) : empty_value;
+}
+
+double Economy::globalWelfare() const {
+    return populationWeightedMean(&RegionalEconomy::welfare, 1.0);
 }
 
 double Economy::globalInequality() const {
-    if (regions_.empty()) return 0.0;
-    
-    // Compute global Gini as population-weighted average of regional Ginis
-    double total_inequality = 0.0;
-    std::uint64_t total_population = 0;
-    
-    for (const auto& region : regions_) {
-        total_inequality += region.inequality * region.population;
-        total_population += region.population;
-    }
-    
-    return (total_population > 0) ? (total_inequality / total_population) : 0.0;
+    // Global Gini as population-weighted average of regional Ginis
+    return populationWeightedMean(&RegionalEconomy::inequality, 0.0);
 }
 
 double Economy::globalHardship() const {
-    if (regions_.empty()) return 0.0;
-    
-    // Compute global hardship as population-weighted average
-    double total_hardship = 0.0;
-    std::uint64_t total_population = 0;
-    
-    for (const auto& region : regions_) {
-        total_hardship += region.hardship * region.population;
-        total_population += region.population;
-    }
-    
-    return (total_population > 0) ? (total_hardship / total_population) : 0.0;
+    return populationWeightedMean(&RegionalEconomy::hardship, 0.0);
 }
 
 double Economy::globalDevelopment() const {
-    if (regions_.empty()) return 0.0;
-    
-    double total_development = 0.0;
-    std::uint64_t total_population = 0;
-    
-    for (const auto& region : regions_) {
-        total_development += region.development * region.population;
-        total_population += region.population;
-    }
-    
-    return (total_population > 0) ? (total_development / total_population) : 0.0;
+    return populationWeightedMean(&RegionalEconomy::development, 0.0);
 }
 
 double Economy::getTotalTrade() const {
@@ -1604,9 +1705,9 @@ double Economy::getTotalTrade() const {
 }
 
 void Economy::setEconomicModel(const std::string& model) {
-    if (model == "market" || model == "planned" || model == "mixed" || 
-        model == "feudal" || model == "cooperative" || model == "") {
-        forced_model_ = model;
+    EconomicSystem system;
+    if (parseEconomicSystem(model, system)) {
+        forced_model_ = system;
     }
 }
 
@@ -1,34 +1,44 @@
 #include "modules/Health.h"
 
 #include <algorithm>
+#include <cmath>
 #include <random>
 
+#include "kernel/ActivitySet.h"
 #include "kernel/Kernel.h"
+#include "kernel/TickScheduler.h"
 #include "modules/Economy.h"
+#include "utils/CounterRng.h"
 
 void HealthModule::configure(std::uint32_t regionCount, std::uint64_t seed) {
     regional_snapshots_.assign(regionCount, {});
-    rng_.seed(seed);
+    seed_ = seed;
 }
 
-void HealthModule::initializeAgents(std::vector<Agent>& agents) {
-    std::uniform_real_distribution<double> noise(-0.05, 0.05);
-    for (auto& agent : agents) {
+void HealthModule::initializeAgents(AgentStore& agents) {
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t s = 0; s < static_cast<std::int64_t>(agents.size()); ++s) {
+        auto agent = agents[static_cast<std::size_t>(s)];
+        rng::CounterRng rng(seed_, 0, agent.id, rng::Stream::Founding);
+        std::uniform_real_distribution<double> noise(-0.05, 0.05);
         auto& health = agent.health;
-        health.physical_health = clamp01(0.8 + 0.2 * agent.openness - 0.1 * agent.conformity + noise(rng_));
-        health.nutrition_level = clamp01(0.8 + noise(rng_));
-        health.age_factor = clamp01(0.2 + 0.6 * noise(rng_));
+        health.physical_health = clamp01(0.8 + 0.2 * agent.openness - 0.1 * agent.conformity + noise(rng));
+        health.nutrition_level = clamp01(0.8 + noise(rng));
+        health.age_factor = clamp01(0.2 + 0.6 * noise(rng));
         health.infected = false;
         health.current_disease = nullptr;
-        health.immunity = clamp01(0.1 + 0.2 * agent.sociality + noise(rng_));
+        health.immunity = clamp01(0.1 + 0.2 * agent.sociality + noise(rng));
     }
 }
 
-void HealthModule::updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t /*tick*/) {
-    if (regional_snapshots_.empty()) {
-        return;
-    }
+void HealthModule::updateAgents(AgentStore& agents, const Economy& economy, std::uint64_t tick) {
+    TickScheduler scheduler;
+    TickArena arena;
+    registerStages(scheduler, agents, economy, tick);
+    scheduler.run(agents.region, regional_snapshots_.size(), arena);
+}
 
+void HealthModule::updateRegionalSnapshots(const Economy& economy) {
     const std::uint32_t regionCount = static_cast<std::uint32_t>(regional_snapshots_.size());
     for (std::uint32_t r = 0; r < regionCount; ++r) {
         const auto& reg = economy.getRegion(r);
@@ -63,50 +73,83 @@ void HealthModule::updateAgents(std::vector<Agent>& agents, const Economy& econo
         );
         snapshot.avg_health = 0.0;
     }
+}
 
-    if (agents.empty()) {
+void HealthModule::registerStages(TickScheduler& scheduler, AgentStore& agents, const Economy& economy,
+                                  std::uint64_t tick, ActivitySet* activity) {
+    if (regional_snapshots_.empty()) {
         return;
     }
 
-    std::vector<std::uint32_t> regionCounts(regionCount, 0);
-    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    scheduler.addRegionStage("health.regions", [this, &economy] { updateRegionalSnapshots(economy); });
 
-    for (auto& agent : agents) {
-        auto& health = agent.health;
-        auto& snapshot = regional_snapshots_[agent.region];
-        regionCounts[agent.region]++;
+    TickScheduler::AgentStage stage;
+    stage.name = "health.agents";
+    stage.reduceWidth = 2;  // Sum of physical health, agent count
+    stage.update = [this, &agents, tick, activity](std::uint32_t slot, double* acc) {
+        auto& health = agents.health[slot];
+        if (activity && !activity->due(slot)) {  // Quiescent: averaged in as it is
+            acc[0] += health.physical_health;
+            acc[1] += 1.0;
+            return;
+        }
+        const std::uint32_t ticks = activity ? activity->elapsed(slot) : 1;
+        const double physicalBefore = health.physical_health;
+        const bool infectedBefore = health.infected;
+        const auto& snapshot = regional_snapshots_[agents.region[slot]];
 
-        health.nutrition_level = 0.7 * health.nutrition_level + 0.3 * snapshot.nutrition;
         const double ageDecay = computeAgeDecay(health.age_factor);
         const double diseaseMortality = (health.infected && health.current_disease) ? health.current_disease->mortality : 0.0;
         const double medicalIntervention = 0.02 + 0.1 * snapshot.healthcare;
-        health.physical_health = clamp01(health.physical_health * health.nutrition_level * (1.0 - ageDecay - diseaseMortality) + medicalIntervention);
+        if (ticks == 1) {
+            health.nutrition_level = 0.7 * health.nutrition_level + 0.3 * snapshot.nutrition;
+            health.physical_health = clamp01(health.physical_health * health.nutrition_level * (1.0 - ageDecay - diseaseMortality) + medicalIntervention);
+        } else {
+            // Catch-up: both rules are affine in their own state, with this
+            // tick's snapshot and the caught-up nutrition held over the gap
+            health.nutrition_level = ActivitySet::affine(health.nutrition_level, 0.7, 0.3 * snapshot.nutrition, ticks);
+            const double retained = health.nutrition_level * (1.0 - ageDecay - diseaseMortality);
+            health.physical_health = clamp01(ActivitySet::affine(health.physical_health, retained, medicalIntervention, ticks));
+        }
+        // Chance of at least one event in `ticks` draws
+        const auto overTicks = [ticks](double p) {
+            return ticks == 1 ? p : 1.0 - std::pow(1.0 - std::clamp(p, 0.0, 1.0), static_cast<double>(ticks));
+        };
 
-        // Disease dynamics
+        // Disease dynamics (counter-based draws keep the sweep thread-count independent)
+        rng::CounterRng rng(seed_, tick, agents.id[slot], rng::Stream::Health);
         if (!health.infected) {
             const double infectionProb = snapshot.infection_pressure * (1.0 - health.physical_health) * (1.0 - health.immunity);
-            if (uni(rng_) < infectionProb) {
+            if (rng.uniform() < overTicks(infectionProb)) {
                 health.infected = true;
                 health.current_disease = &baseline_disease_;
             }
         } else {
             const double recoveryProb = baseline_disease_.recovery * (health.physical_health + snapshot.healthcare);
-            if (uni(rng_) < recoveryProb) {
+            if (rng.uniform() < overTicks(recoveryProb)) {
                 health.infected = false;
                 health.immunity = clamp01(health.immunity + baseline_disease_.immunity_boost);
                 health.current_disease = nullptr;
             }
         }
 
-        health.immunity = clamp01(health.immunity * 0.995);
-        snapshot.avg_health += health.physical_health;
-    }
-
-    for (std::uint32_t r = 0; r < regionCount; ++r) {
-        if (regionCounts[r] > 0) {
-            regional_snapshots_[r].avg_health /= regionCounts[r];
+        health.immunity = clamp01(health.immunity * (ticks == 1 ? 0.995 : std::pow(0.995, static_cast<double>(ticks))));
+        if (activity) {
+            // An infection or recovery is a change whatever its size
+            activity->noteChange(slot, health.infected != infectedBefore
+                                           ? 1.0
+                                           : std::abs(health.physical_health - physicalBefore) / ticks);
         }
-    }
+        acc[0] += health.physical_health;
+        acc[1] += 1.0;
+    };
+    stage.finalize = [this](const TickScheduler::RegionSums& sums) {
+        for (std::size_t r = 0; r < regional_snapshots_.size(); ++r) {
+            const double count = sums(r, 1);
+            regional_snapshots_[r].avg_health = count > 0.0 ? sums(r, 0) / count : 0.0;
+        }
+    };
+    scheduler.addAgentStage(std::move(stage));
 }
 
 double HealthModule::computeAgeDecay(double ageFactor) const {
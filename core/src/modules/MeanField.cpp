@@ -10,7 +10,7 @@ void MeanFieldApproximation::configure(std::uint32_t num_regions) {
     region_populations_.assign(num_regions, 0);
 }
 
-void MeanFieldApproximation::computeFields(const std::vector<Agent>& agents,
+void MeanFieldApproximation::computeFields(const AgentStore& agents,
                                            const std::vector<std::vector<std::uint32_t>>& region_index) {
     // Reset fields
     for (auto& field : regional_fields_) {
@@ -24,18 +24,18 @@ void MeanFieldApproximation::computeFields(const std::vector<Agent>& agents,
         
         for (auto agent_id : agent_ids) {
             if (agent_id >= agents.size()) continue;
-            const auto& agent = agents[agent_id];
-            if (!agent.alive) continue;
+            if (!agents.alive[agent_id]) continue;
             
-            regional_fields_[r][0] += agent.B[0];
-            regional_fields_[r][1] += agent.B[1];
-            regional_fields_[r][2] += agent.B[2];
-            regional_fields_[r][3] += agent.B[3];
+            const auto& B = agents.B[agent_id];
+            regional_fields_[r][0] += B[0];
+            regional_fields_[r][1] += B[1];
+            regional_fields_[r][2] += B[2];
+            regional_fields_[r][3] += B[3];
             region_populations_[r]++;
         }
     }
     
-    // Compute averages and field strengths
+    // Compute averages
     for (std::uint32_t r = 0; r < num_regions_; ++r) {
         if (region_populations_[r] > 0) {
             const double inv_pop = 1.0 / region_populations_[r];
@@ -43,7 +43,32 @@ void MeanFieldApproximation::computeFields(const std::vector<Agent>& agents,
             regional_fields_[r][1] *= inv_pop;
             regional_fields_[r][2] *= inv_pop;
             regional_fields_[r][3] *= inv_pop;
-            
+        }
+    }
+    finalizeStrengths();
+}
+
+void MeanFieldApproximation::setFields(const std::vector<std::uint32_t>& populations,
+                                       const std::vector<std::array<double, 4>>& means) {
+    for (std::uint32_t r = 0; r < num_regions_; ++r) {
+        const bool known = r < populations.size() && r < means.size();
+        region_populations_[r] = known ? populations[r] : 0;
+        regional_fields_[r] = known ? means[r] : std::array<double, 4>{0.0, 0.0, 0.0, 0.0};
+    }
+    finalizeStrengths();
+}
+
+MemoryFootprint MeanFieldApproximation::memoryUsage() const {
+    MemoryFootprint m;
+    m.add(regional_fields_);
+    m.add(field_strengths_);
+    m.add(region_populations_);
+    return m;
+}
+
+void MeanFieldApproximation::finalizeStrengths() {
+    for (std::uint32_t r = 0; r < num_regions_; ++r) {
+        if (region_populations_[r] > 0) {
             // Field strength: logarithmic scaling with population
             // Small groups have high variance, large groups have stable fields
             double pop = static_cast<double>(region_populations_[r]);
@@ -5,13 +5,17 @@
 #include <limits>
 #include <random>
 
+namespace {
+constexpr std::size_t kFoldBlock = 4096;  // Slots per partial-sum block
+}
+
 OnlineClustering::OnlineClustering(int k, double learning_rate)
     : k_(std::max(2, k)), learning_rate_(learning_rate) {
     centroids_.resize(k_);
     cluster_sizes_.assign(k_, 0);
 }
 
-void OnlineClustering::initialize(const std::vector<Agent>& agents) {
+void OnlineClustering::initialize(const AgentStore& agents) {
     if (agents.empty()) return;
     
     // K-means++ initialization for good starting centroids
@@ -99,9 +103,7 @@ void OnlineClustering::updateAgent(std::uint32_t agent_id, const std::array<doub
     updateCentroid(new_cluster, new_beliefs);
 }
 
-void OnlineClustering::updateCentroid(int cluster_id, const std::array<double, 4>& agent_beliefs) {
-    if (cluster_id < 0 || cluster_id >= k_) return;
-    
+double OnlineClustering::adaptiveRate(int cluster_id) const {
     // Adaptive learning rate based on cluster size
     // Larger clusters → slower adaptation (more stable)
     // Smaller clusters → faster adaptation (more responsive)
@@ -111,7 +113,13 @@ void OnlineClustering::updateCentroid(int cluster_id, const std::array<double, 4
         double denom = std::max(1.0, std::log(static_cast<double>(cluster_sizes_[cluster_id]) + 1.0));
         adaptive_rate = learning_rate_ / denom;
     }
-    adaptive_rate = std::min(0.1, adaptive_rate);  // Cap at 10% per update
+    return std::min(0.1, adaptive_rate);  // Cap at 10% per update
+}
+
+void OnlineClustering::updateCentroid(int cluster_id, const std::array<double, 4>& agent_beliefs) {
+    if (cluster_id < 0 || cluster_id >= k_) return;
+    
+    const double adaptive_rate = adaptiveRate(cluster_id);
     
     // Incremental update
     for (int d = 0; d < 4; ++d) {
@@ -119,37 +127,79 @@ void OnlineClustering::updateCentroid(int cluster_id, const std::array<double, 4
     }
 }
 
-void OnlineClustering::fullReassignment(const std::vector<Agent>& agents) {
-    // Reset counts
-    cluster_sizes_.assign(k_, 0);
-    
-    // Ensure assignments is large enough
-    if (assignments_.size() < agents.size()) {
-        assignments_.resize(agents.size(), -1);
+void OnlineClustering::prepare(std::size_t n) {
+    if (assignments_.size() < n) {
+        assignments_.resize(n, -1);
     }
+}
+
+void OnlineClustering::fold(const AgentStore& agents,
+                            std::vector<std::array<double, 4>>& sums,
+                            std::vector<std::uint32_t>& counts) {
+    // Fixed slot blocks folded in order: the same sums for any thread count
+    const std::size_t n = std::min(agents.size(), assignments_.size());
+    const std::size_t blocks = (n + kFoldBlock - 1) / kFoldBlock;
+    std::vector<std::array<double, 4>> block_sums(blocks * k_, {0.0, 0.0, 0.0, 0.0});
+    std::vector<std::uint32_t> block_counts(blocks * k_, 0);
     
-    // Reassign all agents
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        if (!agents[i].alive) continue;
-        
-        int cluster = findNearestCentroid(agents[i].B);
-        assignments_[i] = cluster;
-        cluster_sizes_[cluster]++;
+    #pragma omp parallel for schedule(static)
+    for (std::size_t b = 0; b < blocks; ++b) {
+        for (std::size_t i = b * kFoldBlock; i < std::min(n, (b + 1) * kFoldBlock); ++i) {
+            if (!agents.alive[i]) {
+                assignments_[i] = -1;
+                continue;
+            }
+            const int cluster = assignments_[i];
+            if (cluster < 0 || cluster >= k_) continue;  // Born after the last sweep
+            for (int d = 0; d < 4; ++d) {
+                block_sums[b * k_ + cluster][d] += agents.B[i][d];
+            }
+            block_counts[b * k_ + cluster]++;
+        }
     }
     
-    // Recompute centroids from scratch (stabilization step)
-    std::vector<std::array<double, 4>> new_centroids(k_, {0.0, 0.0, 0.0, 0.0});
-    
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        if (!agents[i].alive) continue;
-        
-        int cluster = assignments_[i];
-        if (cluster >= 0 && cluster < k_) {
+    sums.assign(k_, {0.0, 0.0, 0.0, 0.0});
+    counts.assign(k_, 0);
+    for (std::size_t b = 0; b < blocks; ++b) {
+        for (int c = 0; c < k_; ++c) {
             for (int d = 0; d < 4; ++d) {
-                new_centroids[cluster][d] += agents[i].B[d];
+                sums[c][d] += block_sums[b * k_ + c][d];
             }
+            counts[c] += block_counts[b * k_ + c];
+        }
+    }
+}
+
+void OnlineClustering::commit(const AgentStore& agents) {
+    std::vector<std::array<double, 4>> sums;
+    std::vector<std::uint32_t> counts;
+    fold(agents, sums, counts);
+    cluster_sizes_ = counts;
+    
+    for (int c = 0; c < k_; ++c) {
+        if (counts[c] == 0) continue;
+        // m sequential updates at rate r towards members with mean x move the
+        // centroid 1 - (1 - r)^m of the way to x
+        const double rate = 1.0 - std::pow(1.0 - adaptiveRate(c), static_cast<double>(counts[c]));
+        for (int d = 0; d < 4; ++d) {
+            const double mean = sums[c][d] / counts[c];
+            centroids_[c][d] += rate * (mean - centroids_[c][d]);
         }
     }
+}
+
+void OnlineClustering::fullReassignment(const AgentStore& agents) {
+    // Reassign all live agents
+    prepare(agents.size());
+    #pragma omp parallel for schedule(static)
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        if (!agents.alive[i]) continue;
+        assignments_[i] = findNearestCentroid(agents.B[i]);
+    }
+    
+    // Recompute centroids from scratch (stabilization step)
+    std::vector<std::array<double, 4>> new_centroids;
+    fold(agents, new_centroids, cluster_sizes_);
     
     // Average and handle empty clusters
     std::mt19937_64 rng(agents.size() * 7919);
@@ -169,6 +219,50 @@ void OnlineClustering::fullReassignment(const std::vector<Agent>& agents) {
     centroids_ = std::move(new_centroids);
 }
 
+void OnlineClustering::compact(const std::vector<std::uint32_t>& remap) {
+    std::size_t kept = 0;
+    for (std::size_t slot = 0; slot < assignments_.size() && slot < remap.size(); ++slot) {
+        if (remap[slot] != AgentStore::kNoSlot) {
+            assignments_[remap[slot]] = assignments_[slot];  // remap is monotone: remap[slot] <= slot
+            ++kept;
+        }
+    }
+    assignments_.resize(kept);
+}
+
+void OnlineClustering::reorder(const std::vector<std::uint32_t>& order) {
+    std::vector<int> next;
+    next.reserve(order.size());
+    for (const auto slot : order) next.push_back(slot < assignments_.size() ? assignments_[slot] : -1);
+    assignments_ = std::move(next);
+}
+
+MemoryFootprint OnlineClustering::memoryUsage() const {
+    MemoryFootprint m;
+    m.add(centroids_);
+    m.add(cluster_sizes_);
+    m.add(assignments_);
+    return m;
+}
+
+std::vector<Cluster> OnlineClustering::snapshot(const AgentStore& agents, std::uint64_t generation) const {
+    std::vector<Cluster> clusters(k_);
+    for (int c = 0; c < k_; ++c) {
+        clusters[c].id = static_cast<std::uint32_t>(c);
+        clusters[c].centroid = centroids_[c];
+        clusters[c].birthTick = generation;
+        clusters[c].members.reserve(cluster_sizes_[c]);
+    }
+    // Agents that died since the last commit are dropped here
+    const std::size_t n = std::min(agents.size(), assignments_.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (assignments_[i] >= 0 && agents.alive[i]) {
+            clusters[assignments_[i]].members.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    return clusters;
+}
+
 int OnlineClustering::getCluster(std::uint32_t agent_id) const {
     if (agent_id >= assignments_.size()) return -1;
     return assignments_[agent_id];
@@ -186,7 +280,7 @@ std::vector<std::uint32_t> OnlineClustering::getClusterMembers(int cluster_id) c
     return members;
 }
 
-double OnlineClustering::getClusterCoherence(int cluster_id, const std::vector<Agent>& agents) const {
+double OnlineClustering::getClusterCoherence(int cluster_id, const AgentStore& agents) const {
     if (cluster_id < 0 || cluster_id >= k_) return 0.0;
     
     auto members = getClusterMembers(cluster_id);
@@ -211,7 +305,7 @@ std::vector<std::uint32_t> OnlineClustering::getClusterSizes() const {
     return cluster_sizes_;
 }
 
-double OnlineClustering::getTotalInertia(const std::vector<Agent>& agents) const {
+double OnlineClustering::getTotalInertia(const AgentStore& agents) const {
     double total = 0.0;
     
     for (std::size_t i = 0; i < agents.size(); ++i) {
@@ -4,8 +4,11 @@
 #include <cmath>
 #include <random>
 
+#include "kernel/ActivitySet.h"
 #include "kernel/Kernel.h"
+#include "kernel/TickScheduler.h"
 #include "modules/Economy.h"
+#include "utils/CounterRng.h"
 
 namespace {
 constexpr double kStressShockFloor = 0.05;
@@ -19,7 +22,7 @@ struct StressSensitivity {
     double disease;       // sensitivity to health threats
 };
 
-StressSensitivity computeStressSensitivity(const Agent& agent) {
+StressSensitivity computeStressSensitivity(ConstAgentRef agent) {
     StressSensitivity sens;
     
     // Economic sensitivity: high for materialistic (low openness), low for adaptable (high openness)
@@ -41,16 +44,19 @@ StressSensitivity computeStressSensitivity(const Agent& agent) {
 void PsychologyModule::configure(std::uint32_t regionCount, std::uint64_t seed) {
     regional_profiles_.assign(regionCount, {});
     regional_metrics_.assign(regionCount, {});
-    rng_.seed(seed);
+    seed_ = seed;
 }
 
-void PsychologyModule::initializeAgents(std::vector<Agent>& agents) {
-    std::uniform_real_distribution<double> noise(-0.05, 0.05);
-    for (auto& agent : agents) {
+void PsychologyModule::initializeAgents(AgentStore& agents) {
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t s = 0; s < static_cast<std::int64_t>(agents.size()); ++s) {
+        auto agent = agents[static_cast<std::size_t>(s)];
+        rng::CounterRng rng(seed_, 0, agent.id, rng::Stream::Founding);
+        std::uniform_real_distribution<double> noise(-0.05, 0.05);
         auto& psych = agent.psych;
-        psych.resilience = clamp01(0.35 + 0.25 * agent.conformity + 0.2 * agent.sociality + 0.1 * agent.openness + noise(rng_));
-        psych.mental_health = clamp01(psych.resilience + 0.2 * (agent.sociality - 0.5) + noise(rng_));
-        psych.stress_level = clamp01(0.2 + 0.1 * (1.0 - psych.resilience) + noise(rng_));
+        psych.resilience = clamp01(0.35 + 0.25 * agent.conformity + 0.2 * agent.sociality + 0.1 * agent.openness + noise(rng));
+        psych.mental_health = clamp01(psych.resilience + 0.2 * (agent.sociality - 0.5) + noise(rng));
+        psych.stress_level = clamp01(0.2 + 0.1 * (1.0 - psych.resilience) + noise(rng));
         psych.cognitive_bias = clamp01(1.0 + 0.2 * (agent.assertiveness - agent.conformity));
         psych.stressors.fill(0.0);
         psych.recovery_memory = 0.0;
@@ -58,11 +64,14 @@ void PsychologyModule::initializeAgents(std::vector<Agent>& agents) {
     }
 }
 
-void PsychologyModule::updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t tick) {
-    if (regional_profiles_.empty()) {
-        return;
-    }
+void PsychologyModule::updateAgents(AgentStore& agents, const Economy& economy, std::uint64_t tick) {
+    TickScheduler scheduler;
+    TickArena arena;
+    registerStages(scheduler, agents, economy, tick);
+    scheduler.run(agents.region, regional_profiles_.size(), arena);
+}
 
+void PsychologyModule::updateRegionalProfiles(const Economy& economy) {
     const std::uint32_t regionCount = static_cast<std::uint32_t>(regional_profiles_.size());
     for (std::uint32_t r = 0; r < regionCount; ++r) {
         const auto& reg = economy.getRegion(r);
@@ -77,16 +86,36 @@ void PsychologyModule::updateAgents(std::vector<Agent>& agents, const Economy& e
         regional_metrics_[r].avg_mental_health = 0.0;
         regional_metrics_[r].low_mental_health_share = 0.0;
     }
+}
 
-    if (agents.empty()) {
+void PsychologyModule::registerStages(TickScheduler& scheduler, AgentStore& agents, const Economy& economy,
+                                      std::uint64_t /*tick*/, ActivitySet* activity) {
+    if (regional_profiles_.empty()) {
         return;
     }
 
-    const auto& econAgents = economy.agents();
-    for (auto& agent : agents) {
+    scheduler.addRegionStage("psychology.regions", [this, &economy] { updateRegionalProfiles(economy); });
+
+    TickScheduler::AgentStage stage;
+    stage.name = "psychology.agents";
+    stage.reduceWidth = 4;  // Stress, mental health, low-mental-health count, agent count
+    stage.update = [this, &agents, &economy, activity](std::uint32_t slot, double* acc) {
+        auto agent = agents[slot];
         auto& psych = agent.psych;
+        if (activity && !activity->due(slot)) {  // Quiescent: averaged in as it is
+            acc[0] += psych.stress_level;
+            acc[1] += psych.mental_health;
+            if (psych.mental_health < 0.3) {
+                acc[2] += 1.0;
+            }
+            acc[3] += 1.0;
+            return;
+        }
+        const std::uint32_t ticks = activity ? activity->elapsed(slot) : 1;
+        const double stressBefore = psych.stress_level;
+        const double mentalBefore = psych.mental_health;
         const auto& econRegion = regional_profiles_[agent.region];
-        const auto& agentEcon = econAgents[agent.id];
+        const auto& agentEcon = economy.agents()[slot];
 
         // EMERGENT STRESS: Sensitivity varies by personality
         StressSensitivity sens = computeStressSensitivity(agent);
@@ -110,8 +139,20 @@ void PsychologyModule::updateAgents(std::vector<Agent>& agents, const Economy& e
         const double recoveryRate = 0.05 + 0.3 * econRegion.welfare + 0.2 * socialSupport;
         const double decay = psych.stress_level * psych.stress_level * (1.0 - socialSupport);
 
-        psych.stress_level = clamp01(psych.stress_level + totalShock - recoveryRate * (0.5 + psych.mental_health));
-        psych.mental_health = clamp01(psych.mental_health * (1.0 - decay) + psych.resilience * (econRegion.welfare + socialSupport) * 0.25);
+        const double restoration = psych.resilience * (econRegion.welfare + socialSupport) * 0.25;
+        if (ticks == 1) {
+            psych.stress_level = clamp01(psych.stress_level + totalShock - recoveryRate * (0.5 + psych.mental_health));
+            psych.mental_health = clamp01(psych.mental_health * (1.0 - decay) + restoration);
+        } else {
+            // Catch-up with this tick's shocks held over the gap: stress moves
+            // linearly, mental health follows its affine rule in closed form
+            psych.stress_level = clamp01(psych.stress_level + ticks * (totalShock - recoveryRate * (0.5 + psych.mental_health)));
+            psych.mental_health = clamp01(ActivitySet::affine(psych.mental_health, 1.0 - decay, restoration, ticks));
+        }
+        if (activity) {
+            activity->noteChange(slot, std::max(std::abs(psych.stress_level - stressBefore),
+                                                std::abs(psych.mental_health - mentalBefore)) / ticks);
+        }
         psych.cognitive_bias = std::clamp(1.0 + 0.5 * (psych.stress_level - 0.5) + 0.3 * (agent.assertiveness - agent.conformity), 0.25, 2.0);
 
         const double comm = clamp01(1.0 - 0.4 * psych.stress_level + 0.3 * psych.mental_health);
@@ -119,25 +160,24 @@ void PsychologyModule::updateAgents(std::vector<Agent>& agents, const Economy& e
         agent.m_comm = comm;
         agent.m_mobility = std::clamp(mobility, 0.1, 1.5);
 
-        auto& metrics = regional_metrics_[agent.region];
-        metrics.avg_stress += psych.stress_level;
-        metrics.avg_mental_health += psych.mental_health;
+        acc[0] += psych.stress_level;
+        acc[1] += psych.mental_health;
         if (psych.mental_health < 0.3) {
-            metrics.low_mental_health_share += 1.0;
+            acc[2] += 1.0;
         }
-    }
-
-    // Normalize metrics
-    std::vector<std::uint32_t> regionCounts(regional_profiles_.size(), 0);
-    for (const auto& agent : agents) {
-        regionCounts[agent.region]++;
-    }
-    for (std::uint32_t r = 0; r < regionCount; ++r) {
-        const double inv = regionCounts[r] > 0 ? 1.0 / regionCounts[r] : 0.0;
-        regional_metrics_[r].avg_stress *= inv;
-        regional_metrics_[r].avg_mental_health *= inv;
-        regional_metrics_[r].low_mental_health_share *= inv;
-    }
+        acc[3] += 1.0;
+    };
+    stage.finalize = [this](const TickScheduler::RegionSums& sums) {
+        // Normalize metrics
+        for (std::size_t r = 0; r < regional_metrics_.size(); ++r) {
+            const double count = sums(r, 3);
+            const double inv = count > 0.0 ? 1.0 / count : 0.0;
+            regional_metrics_[r].avg_stress = sums(r, 0) * inv;
+            regional_metrics_[r].avg_mental_health = sums(r, 1) * inv;
+            regional_metrics_[r].low_mental_health_share = sums(r, 2) * inv;
+        }
+    };
+    scheduler.addAgentStage(std::move(stage));
 }
 
 double PsychologyModule::clamp01(double value) const {
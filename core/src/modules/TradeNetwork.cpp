@@ -6,7 +6,9 @@
 
 void TradeNetwork::configure(std::uint32_t num_regions) {
     num_regions_ = num_regions;
-    laplacian_.assign(num_regions, std::vector<double>(num_regions, 0.0));
+    lap_row_offsets_.assign(num_regions + 1, 0);
+    lap_cols_.clear();
+    lap_values_.clear();
     adjacency_.assign(num_regions, std::vector<std::uint32_t>());
 }
 
@@ -23,34 +25,68 @@ void TradeNetwork::buildTopology(const std::vector<std::vector<std::uint32_t>>&
 }
 
 void TradeNetwork::computeLaplacian() {
-    // Reset Laplacian
-    for (auto& row : laplacian_) {
-        std::fill(row.begin(), row.end(), 0.0);
-    }
+    // Laplacian = Degree matrix - Adjacency matrix, one CSR row per region
+    lap_row_offsets_.assign(num_regions_ + 1, 0);
+    lap_cols_.clear();
+    lap_values_.clear();
     
-    // Laplacian = Degree matrix - Adjacency matrix
+    std::vector<std::uint32_t> cols;
     for (std::uint32_t i = 0; i < num_regions_; ++i) {
-        int degree = static_cast<int>(adjacency_[i].size());
-        laplacian_[i][i] = static_cast<double>(degree);
-        
-        // Off-diagonal: -1 for each edge
+        cols.clear();
+        cols.push_back(i);
         for (auto j : adjacency_[i]) {
-            if (j < num_regions_) {
-                laplacian_[i][j] = -1.0;
-            }
+            if (j < num_regions_) cols.push_back(j);
         }
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+        
+        // A listed self-partner overrides the degree, as the dense build did
+        const bool selfLoop = std::find(adjacency_[i].begin(), adjacency_[i].end(), i) != adjacency_[i].end();
+        const double degree = static_cast<double>(adjacency_[i].size());
+        for (auto j : cols) {
+            lap_cols_.push_back(j);
+            lap_values_.push_back(j == i && !selfLoop ? degree : -1.0);
+        }
+        lap_row_offsets_[i + 1] = static_cast<std::uint32_t>(lap_cols_.size());
     }
 }
 
-void TradeNetwork::matrixVectorMultiply(const std::vector<double>& vec, 
-                                         std::vector<double>& result) const {
-    // result = L · vec
-    result.assign(num_regions_, 0.0);
-    
+MemoryFootprint TradeNetwork::memoryUsage() const {
+    MemoryFootprint m;
+    m.add(lap_row_offsets_);
+    m.add(lap_cols_);
+    m.add(lap_values_);
+    m.add(adjacency_);
+    for (const auto& partners : adjacency_) m.add(partners);
+    return m;
+}
+
+std::vector<std::vector<double>> TradeNetwork::laplacian() const {
+    std::vector<std::vector<double>> dense(num_regions_, std::vector<double>(num_regions_, 0.0));
     for (std::uint32_t i = 0; i < num_regions_; ++i) {
-        double sum = 0.0;
-        for (std::uint32_t j = 0; j < num_regions_; ++j) {
-            sum += laplacian_[i][j] * vec[j];
+        for (std::uint32_t e = lap_row_offsets_[i]; e < lap_row_offsets_[i + 1]; ++e) {
+            dense[i][lap_cols_[e]] = lap_values_[e];
+        }
+    }
+    return dense;
+}
+
+void TradeNetwork::multiplyBlock(const std::vector<std::array<double, kGoodTypes>>& vec,
+                                 std::vector<std::array<double, kGoodTypes>>& result) const {
+    // result = L · vec for all goods in one pass: each row's neighbour block is
+    // loaded once instead of once per good. Rows are independent.
+    result.resize(num_regions_);
+    
+    #pragma omp parallel for schedule(static) if(num_regions_ >= 4096)
+    for (std::int64_t r = 0; r < static_cast<std::int64_t>(num_regions_); ++r) {
+        const auto i = static_cast<std::uint32_t>(r);
+        std::array<double, kGoodTypes> sum{};
+        for (std::uint32_t e = lap_row_offsets_[i]; e < lap_row_offsets_[i + 1]; ++e) {
+            const double w = lap_values_[e];
+            const auto& v = vec[lap_cols_[e]];
+            for (int g = 0; g < kGoodTypes; ++g) {
+                sum[g] += w * v[g];
+            }
         }
         result[i] = sum;
     }
@@ -64,37 +100,34 @@ std::vector<std::array<double, kGoodTypes>> TradeNetwork::computeFlows(
 ) {
     std::vector<std::array<double, kGoodTypes>> trade_balance(num_regions_);
     
-    // Initialize to zero
-    for (auto& bal : trade_balance) {
-        bal.fill(0.0);
+    // Surplus block: q[i][g] = production[i][g] - demand[i][g]
+    std::vector<std::array<double, kGoodTypes>> surplus(num_regions_);
+    for (std::uint32_t i = 0; i < num_regions_; ++i) {
+        for (int g = 0; g < kGoodTypes; ++g) {
+            surplus[i][g] = production[i][g] - demand[i][g];
+        }
     }
     
+    // Compute flow gradient for every good: Δq = -k(L · surplus)
+    std::vector<std::array<double, kGoodTypes>> gradient;
+    multiplyBlock(surplus, gradient);
+    
     // Process each good type independently
     for (int g = 0; g < kGoodTypes; ++g) {
-        // Build surplus vector: q[i] = production[i][g] - demand[i][g]
-        std::vector<double> surplus(num_regions_);
-        for (std::uint32_t i = 0; i < num_regions_; ++i) {
-            surplus[i] = production[i][g] - demand[i][g];
-        }
-        
-        // Compute flow gradient: Δq = -k(L · surplus)
-        std::vector<double> gradient;
-        matrixVectorMultiply(surplus, gradient);
-        
         // Apply diffusion: flow from high surplus to low surplus
         // Negative gradient means flow inward (imports)
         // Positive gradient means flow outward (exports)
         for (std::uint32_t i = 0; i < num_regions_; ++i) {
             // Flow = -k * gradient (negative sign makes flow go down gradient)
-            double flow = -diffusion_rate * gradient[i];
+            double flow = -diffusion_rate * gradient[i][g];
             
             // Constrain flow to available surplus (can't export more than you have)
             if (flow > 0.0) {  // Exporting
-                flow = std::min(flow, std::max(0.0, surplus[i]));
+                flow = std::min(flow, std::max(0.0, surplus[i][g]));
             } else {  // Importing
                 // Limit imports by available exports in network
                 // (This is implicitly handled by the flow conservation property of Laplacian)
-                flow = std::max(flow, surplus[i]);
+                flow = std::max(flow, surplus[i][g]);
             }
             
             trade_balance[i][g] = flow;
@@ -0,0 +1,233 @@
+#include "modules/WealthDistribution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+// Covered range [2^kMinExponent, 2^kMaxExponent); values outside clamp to the end buckets
+constexpr int kMinExponent = -10;
+constexpr int kMaxExponent = 40;
+
+inline unsigned lowestBit(std::uint64_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+// Wealth of the ranks [begin, end) that fall inside a bucket spanning [rank, rank + c)
+inline double rankOverlap(std::uint64_t rank, std::uint32_t c, double sum,
+                          std::uint64_t begin, std::uint64_t end) {
+    const std::uint64_t from = std::max(rank, begin);
+    const std::uint64_t to = std::min(rank + c, end);
+    return from < to ? sum * static_cast<double>(to - from) / c : 0.0;
+}
+}
+
+WealthDistribution::WealthDistribution(int precisionBits) : bits_(precisionBits) {
+    if (precisionBits < 1 || precisionBits > 16) {
+        throw std::invalid_argument("WealthDistribution precision must be in [1, 16] bits (got " +
+                                    std::to_string(precisionBits) + ")");
+    }
+    const std::size_t buckets = static_cast<std::size_t>(kMaxExponent - kMinExponent) << bits_;
+    counts_.assign(buckets, 0);
+    sums_.assign(buckets, 0.0);
+    occupied_.assign((buckets + 63) / 64, 0);
+    loWord_ = occupied_.size();
+}
+
+template <typename Fn>
+void WealthDistribution::forEachBucket(Fn&& fn) const {
+    for (std::size_t w = loWord_; w < hiWord_; ++w) {
+        std::uint64_t bits = occupied_[w];
+        while (bits) {
+            const std::size_t b = w * 64 + lowestBit(bits);
+            if (!fn(b)) return;
+            bits &= bits - 1;
+        }
+    }
+}
+
+void WealthDistribution::clear() {
+    for (std::size_t w = loWord_; w < hiWord_; ++w) {
+        std::uint64_t bits = occupied_[w];
+        while (bits) {
+            const std::size_t b = w * 64 + lowestBit(bits);
+            counts_[b] = 0;
+            sums_[b] = 0.0;
+            bits &= bits - 1;
+        }
+        occupied_[w] = 0;
+    }
+    loWord_ = occupied_.size();
+    hiWord_ = 0;
+    count_ = 0;
+    total_ = 0.0;
+}
+
+double WealthDistribution::relativeError() const {
+    return std::ldexp(1.0, -bits_);
+}
+
+MemoryFootprint WealthDistribution::memoryUsage() const {
+    MemoryFootprint m;
+    m.add(counts_);
+    m.add(sums_);
+    m.add(occupied_);
+    return m;
+}
+
+std::size_t WealthDistribution::bucketOf(double wealth) const {
+    if (!(wealth > 0.0)) return 0;  // Zero, negative and NaN share the bottom bucket
+    std::uint64_t raw;
+    std::memcpy(&raw, &wealth, sizeof(raw));
+    // Biased exponent and leading mantissa bits form a monotone log-scale key
+    const auto key = static_cast<std::int64_t>(raw >> (52 - bits_));
+    const auto base = static_cast<std::int64_t>(1023 + kMinExponent) << bits_;
+    const auto index = std::clamp<std::int64_t>(key - base, 0,
+                                                static_cast<std::int64_t>(counts_.size()) - 1);
+    return static_cast<std::size_t>(index);
+}
+
+double WealthDistribution::bucketFloor(std::size_t bucket) const {
+    if (bucket >= counts_.size()) return std::numeric_limits<double>::infinity();
+    // Inverse of bucketOf(): the key with all lower mantissa bits cleared
+    const auto base = static_cast<std::uint64_t>(1023 + kMinExponent) << bits_;
+    const std::uint64_t raw = (base + bucket) << (52 - bits_);
+    double wealth;
+    std::memcpy(&wealth, &raw, sizeof(wealth));
+    return wealth;
+}
+
+void WealthDistribution::add(double wealth) {
+    const std::size_t b = bucketOf(wealth);
+    const std::size_t w = b / 64;
+    counts_[b]++;
+    sums_[b] += wealth;
+    occupied_[w] |= std::uint64_t{1} << (b % 64);
+    loWord_ = std::min(loWord_, w);
+    hiWord_ = std::max(hiWord_, w + 1);
+    count_++;
+    total_ += wealth;
+}
+
+void WealthDistribution::merge(const WealthDistribution& other) {
+    if (other.bits_ != bits_) {
+        throw std::invalid_argument("Cannot merge WealthDistribution sketches of different precision");
+    }
+    other.forEachBucket([&](std::size_t b) {
+        counts_[b] += other.counts_[b];
+        sums_[b] += other.sums_[b];
+        return true;
+    });
+    for (std::size_t w = other.loWord_; w < other.hiWord_; ++w) {
+        occupied_[w] |= other.occupied_[w];
+    }
+    if (other.loWord_ < other.hiWord_) {
+        loWord_ = std::min(loWord_, other.loWord_);
+        hiWord_ = std::max(hiWord_, other.hiWord_);
+    }
+    count_ += other.count_;
+    total_ += other.total_;
+}
+
+WealthDistribution::Summary WealthDistribution::summary(double topFraction, double bottomFraction) const {
+    Summary out;
+    if (count_ == 0 || total_ <= 0.0) return out;
+
+    // Same cuts as the sorted form: top = ranks from floor(n * (1 - top)),
+    // bottom = ranks below floor(n * bottom)
+    const double n = static_cast<double>(count_);
+    const auto topStart = std::min(count_, static_cast<std::uint64_t>(n * (1.0 - topFraction)));
+    const auto bottomEnd = std::min(count_, static_cast<std::uint64_t>(n * bottomFraction));
+
+    // Gini in sorted-rank form sum_j w_j (2j - n + 1) / (n * total), each bucket's
+    // members taken at its mean: c holders starting at rank r contribute sum * (2r + c - n)
+    double weighted = 0.0;
+    double top = 0.0;
+    double bottom = 0.0;
+    std::uint64_t rank = 0;
+    forEachBucket([&](std::size_t b) {
+        const std::uint32_t c = counts_[b];
+        weighted += sums_[b] * (2.0 * static_cast<double>(rank) + c - n);
+        top += rankOverlap(rank, c, sums_[b], topStart, count_);
+        bottom += rankOverlap(rank, c, sums_[b], 0, bottomEnd);
+        rank += c;
+        return true;
+    });
+
+    out.gini = count_ < 2 ? 0.0 : std::clamp(weighted / (n * total_), 0.0, 1.0);
+    out.topShare = top / total_;
+    out.bottomShare = bottom / total_;
+    return out;
+}
+
+double WealthDistribution::gini() const {
+    return summary().gini;
+}
+
+double WealthDistribution::topShare(double fraction) const {
+    return summary(fraction, 0.0).topShare;
+}
+
+double WealthDistribution::bottomShare(double fraction) const {
+    return summary(0.0, fraction).bottomShare;
+}
+
+double WealthDistribution::quantile(double q) const {
+    if (count_ == 0) return 0.0;
+    const auto target = static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(count_ - 1));
+    double value = 0.0;
+    std::uint64_t rank = 0;
+    forEachBucket([&](std::size_t b) {
+        value = sums_[b] / counts_[b];
+        rank += counts_[b];
+        return target >= rank;  // Stop in the bucket holding the target rank
+    });
+    return value;
+}
+
+double WealthDistribution::rankOf(double wealth) const {
+    if (count_ == 0) return 0.0;
+    const std::size_t target = bucketOf(wealth);
+    std::uint64_t below = 0;
+    forEachBucket([&](std::size_t b) {
+        if (b >= target) return false;
+        below += counts_[b];
+        return true;
+    });
+    return static_cast<double>(below) / static_cast<double>(count_);
+}
+
+int WealthDistribution::decile(double wealth) const {
+    return std::min(9, static_cast<int>(rankOf(wealth) * 10.0));
+}
+
+std::array<double, 9> WealthDistribution::decileFloors() const {
+    std::array<double, 9> floors;
+    floors.fill(std::numeric_limits<double>::infinity());
+    if (count_ == 0) return floors;
+    // rankOf() only steps up just past an occupied bucket, so each decile
+    // starts at the bucket after the one that carries the rank across it
+    std::uint64_t below = 0;
+    int reached = 0;
+    forEachBucket([&](std::size_t b) {
+        below += counts_[b];
+        const int d = std::min(9, static_cast<int>(static_cast<double>(below) / static_cast<double>(count_) * 10.0));
+        for (; reached < d; ++reached) {
+            floors[reached] = bucketFloor(b + 1);
+        }
+        return reached < 9;
+    });
+    return floors;
+}
@@ -1,158 +1,498 @@
 #include "utils/EventLog.h"
-#include <sstream>
-#include <iomanip>
+#include "utils/Profiler.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+std::atomic<std::uint64_t> g_next_serial{1};
+
+std::size_t roundUpPow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+void appendInteger(std::string& out, long long v) {
+    char text[24];
+    out.append(text, std::to_chars(text, text + sizeof(text), v).ptr);
+}
+
+void appendFixed(std::string& out, double v, int precision) {
+    char text[384];
+    out.append(text, std::to_chars(text, text + sizeof(text), v, std::chars_format::fixed, precision).ptr);
+}
+
+void copyName(char (&dst)[16], const std::string& name) {
+    const std::size_t n = std::min(name.size(), sizeof(dst) - 1);
+    std::memcpy(dst, name.data(), n);
+    std::memset(dst + n, 0, sizeof(dst) - n);
+}
+
+std::string_view nameOf(const char (&name)[16]) {
+    return std::string_view(name, strnlen(name, sizeof(name)));
+}
+
+// One CSV row, same columns as exportCSV()
+void appendCsvRow(std::string& out, const Event& event) {
+    appendInteger(out, static_cast<long long>(event.tick));
+    out += ',';
+    out += EventLog::eventTypeToString(event.type);
+    out += ',';
+    appendInteger(out, event.agent_id);
+    out += ',';
+    appendInteger(out, event.region_id);
+    out += ',';
+    appendFixed(out, event.magnitude, 4);
+    out += ",\"";
+    out += event.details();
+    out += "\"\n";
+}
+
+constexpr char kCsvHeader[] = "tick,event_type,agent_id,region_id,magnitude,details\n";
+
+struct BinaryHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint32_t reserved;
+};
+
+}  // namespace
+
+std::string Event::details() const {
+    std::string out;
+    switch (type) {
+        case EventType::BIRTH:
+            out = "parent=";
+            appendInteger(out, payload.birth.parent_id);
+            break;
+        case EventType::DEATH:
+            out = "age=";
+            appendInteger(out, payload.death.age);
+            break;
+        case EventType::TRADE:
+            out = "to=";
+            appendInteger(out, payload.trade.to_region);
+            out += ";good=";
+            appendInteger(out, payload.trade.good);
+            out += ";volume=";
+            appendFixed(out, payload.trade.volume, 2);
+            out += ";price=";
+            appendFixed(out, payload.trade.price, 4);
+            break;
+        case EventType::MOVEMENT_FORMED:
+            out = "movement_id=";
+            appendInteger(out, payload.movement.movement_id);
+            out += ";members=";
+            appendInteger(out, static_cast<long long>(payload.movement.members));
+            break;
+        case EventType::SYSTEM_CHANGE:
+            out = "from=";
+            out += nameOf(payload.system.from);
+            out += ";to=";
+            out += nameOf(payload.system.to);
+            break;
+        case EventType::MIGRATION:
+            out = "from=";
+            appendInteger(out, payload.migration.from_region);
+            out += ";to=";
+            appendInteger(out, payload.migration.to_region);
+            break;
+        case EventType::HARDSHIP_CRISIS:
+            out = "hardship=";
+            appendFixed(out, payload.region.level, 3);
+            break;
+        case EventType::DEVELOPMENT_MILESTONE:
+            out = "development=";
+            appendFixed(out, payload.region.level, 2);
+            break;
+        default:
+            break;
+    }
+    return out;
+}
+
+// Single-producer, single-consumer ring: the owning thread advances head,
+// a drain (under drain_mutex_) advances tail
+struct EventLog::Ring {
+    explicit Ring(std::size_t capacity)
+        : slots(new Event[capacity]), mask(capacity - 1), owner(std::this_thread::get_id()) {}
+
+    bool push(const Event& event) {
+        const std::uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) > mask) return false;
+        slots[h & mask] = event;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Fn>
+    void popAll(Fn&& fn) {
+        const std::uint64_t t = tail.load(std::memory_order_relaxed);
+        const std::uint64_t h = head.load(std::memory_order_acquire);
+        for (std::uint64_t i = t; i < h; ++i) fn(slots[i & mask]);
+        tail.store(h, std::memory_order_release);
+    }
+
+    std::unique_ptr<Event[]> slots;
+    const std::uint64_t mask;
+    const std::thread::id owner;
+    alignas(64) std::atomic<std::uint64_t> head{0};
+    alignas(64) std::atomic<std::uint64_t> tail{0};
+};
+
+EventLog::EventLog() : EventLog(Config{}) {}
+
+EventLog::EventLog(const Config& config)
+    : config_(config), serial_(g_next_serial.fetch_add(1, std::memory_order_relaxed)) {
+    config_.ringCapacity = roundUpPow2(std::max<std::size_t>(2, config_.ringCapacity));
+    store_.setSpill(config_.spillDirectory, config_.residentSegments);
+}
+
+EventLog::~EventLog() {
+    stopWriter();
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
+    if (log_file_.is_open()) log_file_.flush();
+}
+
+void EventLog::configure(const Config& config) {
+    stopWriter();
+    {
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+        reconfigureLocked(config);
+    }
+    if (file_initialized_) startWriter();
+}
+
+void EventLog::reconfigureLocked(const Config& config) {
+    drainLocked();
+    config_ = config;
+    config_.ringCapacity = roundUpPow2(std::max<std::size_t>(2, config_.ringCapacity));
+    // Keep what the new limit allows
+    while (store_.size() > config_.retainLimit) {
+        if (config_.retention == Retention::KeepLatest) {
+            store_.popOldest();
+        } else {
+            store_.popNewest();
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    store_.setSpill(config_.spillDirectory, config_.residentSegments);
+    // Existing rings keep their size; threads registering later use the new one
+}
+
+void EventLog::init(const std::string& filepath, Format format) {
+    stopWriter();
+    std::unique_lock<std::mutex> lock(drain_mutex_);
+    drainLocked();  // Earlier events belong to the previous file
 
-void EventLog::init(const std::string& filepath) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     if (log_file_.is_open()) {
         log_file_.close();
     }
-    
-    log_file_.open(filepath, std::ios::out | std::ios::trunc);
+
+    log_file_.open(filepath, std::ios::out | std::ios::trunc | std::ios::binary);
     if (!log_file_.is_open()) {
+        file_initialized_ = false;
         throw std::runtime_error("Failed to open event log file: " + filepath);
     }
-    
-    // Write CSV header
-    log_file_ << "tick,event_type,agent_id,region_id,magnitude,details\n";
+    format_ = format;
+    if (format == Format::Binary) {
+        const BinaryHeader header{{'C', 'I', 'V', 'E'}, 1, sizeof(Event), 0};
+        log_file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    } else {
+        log_file_ << kCsvHeader;
+    }
     file_initialized_ = true;
+    lock.unlock();
+    startWriter();
+}
+
+void EventLog::startWriter() {
+    writer_stop_ = false;
+    writer_ = std::thread([this] {
+        std::unique_lock<std::mutex> lock(drain_mutex_);
+        while (!writer_stop_) {
+            writer_wake_.wait_for(lock, config_.flushInterval);
+            drainLocked();
+        }
+    });
+}
+
+void EventLog::stopWriter() {
+    if (!writer_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+        writer_stop_ = true;
+    }
+    writer_wake_.notify_all();
+    writer_.join();
+}
+
+EventLog::Ring& EventLog::ringForThread() const {
+    // One cached ring per thread; alternating between logs takes the locked lookup
+    thread_local std::uint64_t cached_serial = 0;
+    thread_local Ring* cached_ring = nullptr;
+    if (cached_serial == serial_) return *cached_ring;
+
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    const auto self = std::this_thread::get_id();
+    Ring* ring = nullptr;
+    for (const auto& r : rings_) {
+        if (r->owner == self) ring = r.get();
+    }
+    if (!ring) {
+        rings_.push_back(std::make_unique<Ring>(config_.ringCapacity));
+        ring = rings_.back().get();
+    }
+    cached_serial = serial_;
+    cached_ring = ring;
+    return *ring;
+}
+
+void EventLog::logEvent(const Event& event) {
+    Ring& ring = ringForThread();
+    profiler::Profiler::noteEvent();
+    if (ring.push(event)) return;
+
+    if (config_.overflow == Overflow::Drop) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
+    ring.push(event);  // Our ring is empty now and only we fill it
 }
 
 void EventLog::logEvent(std::uint64_t tick, EventType type, std::uint32_t agent_id,
-                        std::uint32_t region_id, const std::string& details, double magnitude) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    events_.emplace_back(tick, type, agent_id, region_id, details, magnitude);
-    
-    // Write to file immediately for real-time analysis
-    if (file_initialized_) {
-        log_file_ << tick << ","
-                  << eventTypeToString(type) << ","
-                  << agent_id << ","
-                  << region_id << ","
-                  << std::fixed << std::setprecision(4) << magnitude << ","
-                  << "\"" << details << "\"\n";
+                        std::uint32_t region_id, double magnitude) {
+    Event e;
+    e.tick = tick;
+    e.type = type;
+    e.agent_id = agent_id;
+    e.region_id = region_id;
+    e.magnitude = magnitude;
+    logEvent(e);
+}
+
+void EventLog::drainLocked() const {
+    std::vector<Event>& batch = batch_;
+    batch.clear();
+    for (const auto& ring : rings_) {
+        ring->popAll([&](const Event& e) { batch.push_back(e); });
+    }
+    if (batch.empty()) return;
+    const auto byTick = [](const Event& a, const Event& b) { return a.tick < b.tick; };
+    if (!std::is_sorted(batch.begin(), batch.end(), byTick)) {
+        std::stable_sort(batch.begin(), batch.end(), byTick);
+    }
+    for (const auto& e : batch) retainLocked(e);
+    writeLocked(batch);
+}
+
+void EventLog::retainLocked(const Event& event) const {
+    const std::size_t limit = config_.retainLimit;
+    if (store_.size() >= limit) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        if (limit == 0 || config_.retention == Retention::KeepEarliest) return;
+        store_.popOldest();
     }
+    store_.append(event);
+}
+
+void EventLog::writeLocked(const std::vector<Event>& batch) const {
+    if (!file_initialized_) return;
+    if (format_ == Format::Binary) {
+        log_file_.write(reinterpret_cast<const char*>(batch.data()),
+                        static_cast<std::streamsize>(batch.size() * sizeof(Event)));
+        return;
+    }
+    std::string text;
+    text.reserve(batch.size() * 48);
+    for (const auto& e : batch) appendCsvRow(text, e);
+    log_file_.write(text.data(), static_cast<std::streamsize>(text.size()));
 }
 
 void EventLog::logBirth(std::uint64_t tick, std::uint32_t agent_id, std::uint32_t region_id,
                         std::uint32_t parent_id) {
-    std::ostringstream details;
-    details << "parent=" << parent_id;
-    logEvent(tick, EventType::BIRTH, agent_id, region_id, details.str(), 1.0);
+    Event e;
+    e.tick = tick;
+    e.type = EventType::BIRTH;
+    e.agent_id = agent_id;
+    e.region_id = region_id;
+    e.magnitude = 1.0;
+    e.payload.birth.parent_id = parent_id;
+    logEvent(e);
 }
 
 void EventLog::logDeath(std::uint64_t tick, std::uint32_t agent_id, std::uint32_t region_id, int age) {
-    std::ostringstream details;
-    details << "age=" << age;
-    logEvent(tick, EventType::DEATH, agent_id, region_id, details.str(), 1.0);
+    Event e;
+    e.tick = tick;
+    e.type = EventType::DEATH;
+    e.agent_id = agent_id;
+    e.region_id = region_id;
+    e.magnitude = 1.0;
+    e.payload.death.age = age;
+    logEvent(e);
 }
 
 void EventLog::logTrade(std::uint64_t tick, std::uint32_t from_region, std::uint32_t to_region,
                         int good_type, double volume, double price) {
-    std::ostringstream details;
-    details << "to=" << to_region << ";good=" << good_type 
-            << ";volume=" << std::fixed << std::setprecision(2) << volume
-            << ";price=" << std::fixed << std::setprecision(4) << price;
-    logEvent(tick, EventType::TRADE, 0, from_region, details.str(), volume * price);
+    Event e;
+    e.tick = tick;
+    e.type = EventType::TRADE;
+    e.region_id = from_region;
+    e.magnitude = volume * price;
+    e.payload.trade = {to_region, good_type, volume, price};
+    logEvent(e);
 }
 
 void EventLog::logMovementFormed(std::uint64_t tick, std::uint32_t movement_id,
                                  std::uint32_t region_id, std::size_t member_count) {
-    std::ostringstream details;
-    details << "movement_id=" << movement_id << ";members=" << member_count;
-    logEvent(tick, EventType::MOVEMENT_FORMED, 0, region_id, details.str(), 
-             static_cast<double>(member_count));
+    Event e;
+    e.tick = tick;
+    e.type = EventType::MOVEMENT_FORMED;
+    e.region_id = region_id;
+    e.magnitude = static_cast<double>(member_count);
+    e.payload.movement = {movement_id, 0, member_count};
+    logEvent(e);
 }
 
 void EventLog::logSystemChange(std::uint64_t tick, std::uint32_t region_id,
                                const std::string& old_system, const std::string& new_system) {
-    std::ostringstream details;
-    details << "from=" << old_system << ";to=" << new_system;
-    logEvent(tick, EventType::SYSTEM_CHANGE, 0, region_id, details.str(), 1.0);
+    Event e;
+    e.tick = tick;
+    e.type = EventType::SYSTEM_CHANGE;
+    e.region_id = region_id;
+    e.magnitude = 1.0;
+    copyName(e.payload.system.from, old_system);
+    copyName(e.payload.system.to, new_system);
+    logEvent(e);
 }
 
 void EventLog::logMigration(std::uint64_t tick, std::uint32_t agent_id,
                            std::uint32_t from_region, std::uint32_t to_region) {
-    std::ostringstream details;
-    details << "from=" << from_region << ";to=" << to_region;
-    logEvent(tick, EventType::MIGRATION, agent_id, to_region, details.str(), 1.0);
+    Event e;
+    e.tick = tick;
+    e.type = EventType::MIGRATION;
+    e.agent_id = agent_id;
+    e.region_id = to_region;
+    e.magnitude = 1.0;
+    e.payload.migration = {from_region, to_region};
+    logEvent(e);
 }
 
 void EventLog::logHardshipCrisis(std::uint64_t tick, std::uint32_t region_id, double hardship_level) {
-    std::ostringstream details;
-    details << "hardship=" << std::fixed << std::setprecision(3) << hardship_level;
-    logEvent(tick, EventType::HARDSHIP_CRISIS, 0, region_id, details.str(), hardship_level);
+    Event e;
+    e.tick = tick;
+    e.type = EventType::HARDSHIP_CRISIS;
+    e.region_id = region_id;
+    e.magnitude = hardship_level;
+    e.payload.region.level = hardship_level;
+    logEvent(e);
 }
 
 void EventLog::logDevelopmentMilestone(std::uint64_t tick, std::uint32_t region_id, double development_level) {
-    std::ostringstream details;
-    details << "development=" << std::fixed << std::setprecision(2) << development_level;
-    logEvent(tick, EventType::DEVELOPMENT_MILESTONE, 0, region_id, details.str(), development_level);
+    Event e;
+    e.tick = tick;
+    e.type = EventType::DEVELOPMENT_MILESTONE;
+    e.region_id = region_id;
+    e.magnitude = development_level;
+    e.payload.region.level = development_level;
+    logEvent(e);
 }
 
 void EventLog::exportCSV(const std::string& filepath) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
+
     std::ofstream out(filepath);
     if (!out.is_open()) {
         throw std::runtime_error("Failed to open export file: " + filepath);
     }
-    
-    // Write header
-    out << "tick,event_type,agent_id,region_id,magnitude,details\n";
-    
-    // Write events
-    for (const auto& event : events_) {
-        out << event.tick << ","
-            << eventTypeToString(event.type) << ","
-            << event.agent_id << ","
-            << event.region_id << ","
-            << std::fixed << std::setprecision(4) << event.magnitude << ","
-            << "\"" << event.details << "\"\n";
-    }
+
+    out << kCsvHeader;
+    std::string text;
+    store_.forEachInTickOrder(0, std::numeric_limits<std::uint64_t>::max(), [&](const Event& e) {
+        appendCsvRow(text, e);
+        if (text.size() >= 1 << 16) {
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+            text.clear();
+        }
+    });
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
 }
 
 void EventLog::flush() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
     if (log_file_.is_open()) {
         log_file_.flush();
     }
 }
 
 void EventLog::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    events_.clear();
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();  // Pending events still reach the file
+    store_.clear();
+}
+
+std::size_t EventLog::size() const {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
+    return store_.size();
+}
+
+std::uint64_t EventLog::dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+MemoryFootprint EventLog::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(drain_mutex_);  // No drain: sizes only, never I/O
+    MemoryFootprint m = store_.memoryUsage();
+    for (const auto& ring : rings_) m.reserved += (ring->mask + 1) * sizeof(Event);
+    m.add(batch_);
+    return m;
+}
+
+std::size_t EventLog::spill() {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
+    return store_.spillResident();
 }
 
 std::vector<Event> EventLog::getEventsByType(EventType type) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
     std::vector<Event> result;
-    
-    for (const auto& event : events_) {
-        if (event.type == type) {
-            result.push_back(event);
-        }
-    }
-    
+    result.reserve(store_.size(type));
+    store_.visit(type, 0, std::numeric_limits<std::uint64_t>::max(),
+                 [&](EventSpan span) { result.insert(result.end(), span.begin(), span.end()); });
     return result;
 }
 
 std::vector<Event> EventLog::getEventsByTickRange(std::uint64_t start_tick, std::uint64_t end_tick) const {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
     std::vector<Event> result;
-    
-    for (const auto& event : events_) {
-        if (event.tick >= start_tick && event.tick <= end_tick) {
-            result.push_back(event);
-        }
-    }
-    
+    store_.forEachInTickOrder(start_tick, end_tick, [&](const Event& e) { result.push_back(e); });
     return result;
 }
 
-std::string EventLog::eventTypeToString(EventType type) const {
+std::size_t EventLog::count(EventType type, std::uint64_t start_tick, std::uint64_t end_tick) const {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drainLocked();
+    std::size_t n = 0;
+    store_.visit(type, start_tick, end_tick, [&](EventSpan span) { n += span.size(); });
+    return n;
+}
+
+const char* EventLog::eventTypeToString(EventType type) {
     switch (type) {
         case EventType::BIRTH: return "BIRTH";
         case EventType::DEATH: return "DEATH";
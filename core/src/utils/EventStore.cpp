@@ -0,0 +1,267 @@
+#include "utils/EventStore.h"
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+std::atomic<std::uint64_t> g_next_store{1};
+}
+
+EventStore::Segment::~Segment() {
+#ifndef _WIN32
+    if (mapping) munmap(mapping, mapping_bytes);
+#endif
+}
+
+EventStore::EventStore() : spill_serial_(g_next_store.fetch_add(1, std::memory_order_relaxed)) {}
+
+EventStore::~EventStore() = default;
+
+void EventStore::setSpill(const std::string& directory, std::size_t residentSegments) {
+    spill_dir_ = directory;
+    resident_segments_ = std::max<std::size_t>(1, residentSegments);
+}
+
+std::size_t EventStore::spilledSegments() const {
+    std::size_t total = 0;
+    for (const auto& column : columns_) total += column.spilled;
+    return total;
+}
+
+std::size_t EventStore::spillResident() {
+    spare_.reset();
+    std::size_t total = 0;
+    for (auto& column : columns_) {
+        // The last segment may still be filling
+        while (!spill_dir_.empty() && column.spilled + 1 < column.segments.size()) {
+            spill(column);
+            ++total;
+        }
+    }
+    return total;
+}
+
+MemoryFootprint EventStore::memoryUsage() const {
+    MemoryFootprint m;
+    for (const auto& column : columns_) {
+        for (const auto& s : column.segments) {
+            m.add(s->ticks);
+            if (!s->owned) continue;
+            m.used += s->live() * sizeof(Event);
+            m.reserved += kSegmentEvents * sizeof(Event);
+        }
+    }
+    if (spare_) m.reserved += kSegmentEvents * sizeof(Event) + spare_->ticks.capacity() * sizeof(std::uint64_t);
+    return m;
+}
+
+std::unique_ptr<EventStore::Segment> EventStore::newSegment() {
+    std::unique_ptr<Segment> segment = std::move(spare_);
+    if (segment) {
+        segment->ticks.clear();
+        segment->begin = 0;
+        segment->sorted = true;
+        return segment;
+    }
+    segment = std::make_unique<Segment>();
+    segment->owned.reset(new Event[kSegmentEvents]);
+    segment->events = segment->owned.get();
+    segment->ticks.reserve(kSegmentEvents);
+    return segment;
+}
+
+void EventStore::recycle(std::unique_ptr<Segment> segment) {
+    if (segment->owned) spare_ = std::move(segment);
+}
+
+void EventStore::append(const Event& event) {
+    Column& column = columns_[index(event.type)];
+    if (column.segments.empty() || column.segments.back()->ticks.size() == kSegmentEvents) {
+        auto segment = newSegment();
+        segment->reach = event.tick;
+        segment->floor = std::numeric_limits<std::uint64_t>::max();  // Lowered below
+        if (!column.segments.empty()) {
+            Segment& full = *column.segments.back();
+            sort(full);
+            segment->reach = std::max(full.reach, event.tick);
+        }
+        column.segments.push_back(std::move(segment));
+        while (!spill_dir_.empty() && column.segments.size() - column.spilled > resident_segments_) {
+            spill(column);
+        }
+    }
+    Segment& s = *column.segments.back();
+    if (!s.owned) {
+        unspill(s);
+        column.spilled = column.segments.size() - 1;
+    }
+    if (s.ticks.size() > s.begin && event.tick < s.ticks.back()) s.sorted = false;
+    s.owned[s.ticks.size()] = event;
+    s.ticks.push_back(event.tick);
+    s.reach = std::max(s.reach, event.tick);
+    // A late event lowers the floor of every segment from the back that was above it
+    for (auto it = column.segments.rbegin(); it != column.segments.rend() && (*it)->floor > event.tick; ++it) {
+        (*it)->floor = event.tick;
+    }
+    ++column.size;
+    ++size_;
+}
+
+void EventStore::sort(Segment& segment) {
+    if (segment.sorted) return;
+    Event* first = segment.owned.get() + segment.begin;
+    Event* last = segment.owned.get() + segment.ticks.size();
+    std::stable_sort(first, last, [](const Event& a, const Event& b) { return a.tick < b.tick; });
+    for (std::size_t i = segment.begin; i < segment.ticks.size(); ++i) {
+        segment.ticks[i] = segment.owned[i].tick;
+    }
+    segment.sorted = true;
+}
+
+void EventStore::settle(const Column& column) const {
+    if (!column.segments.empty()) sort(*column.segments.back());
+}
+
+void EventStore::dropFront(Column& column) {
+    Segment& s = *column.segments.front();
+    sort(s);
+    ++s.begin;
+    --column.size;
+    --size_;
+    if (s.live() == 0) {
+        if (s.mapping) --column.spilled;
+        recycle(std::move(column.segments.front()));
+        column.segments.pop_front();
+    }
+}
+
+void EventStore::popOldest() {
+    Column* oldest = nullptr;
+    std::uint64_t tick = 0;
+    for (auto& column : columns_) {
+        if (column.size == 0) continue;
+        Segment& s = *column.segments.front();
+        sort(s);
+        if (!oldest || s.ticks[s.begin] < tick) {
+            oldest = &column;
+            tick = s.ticks[s.begin];
+        }
+    }
+    if (oldest) dropFront(*oldest);
+}
+
+void EventStore::popNewest() {
+    Column* newest = nullptr;
+    std::uint64_t tick = 0;
+    for (auto& column : columns_) {
+        if (column.size == 0) continue;
+        settle(column);
+        const std::uint64_t t = column.segments.back()->ticks.back();
+        if (!newest || t >= tick) {
+            newest = &column;
+            tick = t;
+        }
+    }
+    if (!newest) return;
+    Segment& s = *newest->segments.back();
+    if (!s.owned) {
+        unspill(s);
+        newest->spilled = newest->segments.size() - 1;
+    }
+    s.ticks.pop_back();
+    --newest->size;
+    --size_;
+    if (s.live() == 0) {
+        recycle(std::move(newest->segments.back()));
+        newest->segments.pop_back();
+    }
+}
+
+void EventStore::clear() {
+    for (auto& column : columns_) {
+        column.segments.clear();
+        column.size = 0;
+        column.spilled = 0;
+    }
+    size_ = 0;
+}
+
+void EventStore::spill(Column& column) {
+#ifdef _WIN32
+    (void)column;
+    spill_dir_.clear();  // No mapping support: stay in memory
+#else
+    Segment& s = *column.segments[column.spilled];
+    const std::string path = spill_dir_ + "/civ_events_" + std::to_string(getpid()) + "_" +
+                             std::to_string(spill_serial_) + "_" + std::to_string(spill_count_++) + ".seg";
+    const std::size_t bytes = s.ticks.size() * sizeof(Event);
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    bool ok = fd >= 0;
+    const auto* src = reinterpret_cast<const char*>(s.events);
+    for (std::size_t done = 0; ok && done < bytes;) {
+        const ssize_t n = ::write(fd, src + done, bytes - done);
+        ok = n > 0;
+        if (ok) done += static_cast<std::size_t>(n);
+    }
+    void* mapping = ok ? ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (fd >= 0) {
+        ::close(fd);
+        ::unlink(path.c_str());  // The mapping keeps the data until unmapped
+    }
+    if (mapping == MAP_FAILED) {
+        std::cerr << "Event spill to " << spill_dir_ << " failed; keeping events in memory" << std::endl;
+        spill_dir_.clear();
+        return;
+    }
+    s.mapping = mapping;
+    s.mapping_bytes = bytes;
+    s.events = static_cast<const Event*>(mapping);
+    s.owned.reset();
+    ++column.spilled;
+#endif
+}
+
+void EventStore::unspill(Segment& segment) {
+    segment.owned.reset(new Event[kSegmentEvents]);
+    std::memcpy(segment.owned.get(), segment.events, segment.ticks.size() * sizeof(Event));
+#ifndef _WIN32
+    if (segment.mapping) munmap(segment.mapping, segment.mapping_bytes);
+#endif
+    segment.mapping = nullptr;
+    segment.mapping_bytes = 0;
+    segment.events = segment.owned.get();
+}
+
+void EventStore::forEachInTickOrder(std::uint64_t start, std::uint64_t end,
+                                    const std::function<void(const Event&)>& fn) const {
+    struct Cursor {
+        const Event* at;
+        const Event* last;
+        std::size_t order;  // Breaks tick ties by type, then segment
+    };
+    std::vector<Cursor> heap;
+    for (std::size_t t = 0; t < kTypeCount; ++t) {
+        visit(static_cast<EventType>(t), start, end,
+              [&](EventSpan s) { heap.push_back({s.first, s.last, heap.size()}); });
+    }
+    const auto later = [](const Cursor& a, const Cursor& b) {
+        return a.at->tick != b.at->tick ? a.at->tick > b.at->tick : a.order > b.order;
+    };
+    std::make_heap(heap.begin(), heap.end(), later);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        Cursor& c = heap.back();
+        fn(*c.at);
+        if (++c.at == c.last) {
+            heap.pop_back();
+        } else {
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#include "utils/Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace profiler {
+
+std::atomic<std::uint64_t> Profiler::events_{0};
+std::atomic<std::uint64_t> Profiler::allocations_{0};
+
+namespace {
+
+// Small stable number of the calling thread (Chrome trace "tid")
+std::uint32_t traceThread() {
+    static std::atomic<std::uint32_t> next{1};
+    thread_local const std::uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+}  // namespace
+
+const char* phaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Tick: return "tick";
+        case Phase::Beliefs: return "beliefs";
+        case Phase::Demography: return "demography";
+        case Phase::Migration: return "migration";
+        case Phase::Reconnect: return "reconnect";
+        case Phase::Language: return "language";
+        case Phase::Compaction: return "compaction";
+        case Phase::EconomyUpdate: return "economy";
+        case Phase::EconomyEvolution: return "economy.evolution";
+        case Phase::EconomyProduction: return "economy.production";
+        case Phase::EconomyTrade: return "economy.trade";
+        case Phase::EconomyConsumption: return "economy.consumption";
+        case Phase::EconomyPrices: return "economy.prices";
+        case Phase::EconomyIncome: return "economy.income";
+        case Phase::EconomyWelfare: return "economy.welfare";
+        case Phase::EconomyInequality: return "economy.inequality";
+        case Phase::EconomyHardship: return "economy.hardship";
+        case Phase::AgentSweep: return "agent_sweep";
+        case Phase::Cultures: return "cultures";
+        case Phase::Shards: return "shards";
+        case Phase::Reorder: return "reorder";
+        case Phase::COUNT: break;
+    }
+    return "unknown";
+}
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : epoch_(std::chrono::steady_clock::now()) {}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& s : series_) {
+        s = Series{};
+    }
+    trace_.clear();
+    epoch_ = std::chrono::steady_clock::now();
+}
+
+void Profiler::setTracing(bool tracing) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tracing_.store(tracing, std::memory_order_relaxed);
+    if (tracing) {
+        trace_.clear();
+    }
+}
+
+std::size_t Profiler::traceEvents() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return trace_.size();
+}
+
+Profiler::Scope::Scope(Phase phase)
+    : phase_(phase), active_(Profiler::instance().enabled()) {
+    if (!active_) return;
+    events0_ = events_.load(std::memory_order_relaxed);
+    allocations0_ = allocations_.load(std::memory_order_relaxed);
+    start_ = std::chrono::steady_clock::now();
+}
+
+Profiler::Scope::~Scope() {
+    if (!active_) return;
+    const auto end = std::chrono::steady_clock::now();
+    const auto ns = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count());
+    Profiler::instance().record(phase_, start_, ns, agents_,
+                                allocations_.load(std::memory_order_relaxed) - allocations0_,
+                                events_.load(std::memory_order_relaxed) - events0_);
+}
+
+void Profiler::record(Phase phase, std::chrono::steady_clock::time_point start, std::uint64_t ns,
+                      std::uint64_t agents, std::uint64_t allocations, std::uint64_t events) {
+    const std::uint32_t thread = tracing() ? traceThread() : 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& s = series_[static_cast<std::size_t>(phase)];
+    s.totals.calls++;
+    s.totals.totalNs += ns;
+    s.totals.agentsTouched += agents;
+    s.totals.allocations += allocations;
+    s.totals.eventsLogged += events;
+
+    s.windowNs[s.next] = static_cast<std::uint32_t>(std::min<std::uint64_t>(ns, UINT32_MAX));
+    s.next = (s.next + 1) % kWindow;
+    s.count = std::min(s.count + 1, kWindow);
+
+    if (thread != 0) {
+        const auto startUs = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(start - epoch_).count());
+        trace_.push_back({phase, startUs, ns / 1000, thread});
+    }
+}
+
+PhaseStats Profiler::stats(Phase phase) const {
+    std::vector<std::uint32_t> window;
+    PhaseStats out;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto& s = series_[static_cast<std::size_t>(phase)];
+        out = s.totals;
+        window.assign(s.windowNs.begin(), s.windowNs.begin() + static_cast<std::ptrdiff_t>(s.count));
+    }
+    if (window.empty()) return out;
+
+    double sum = 0.0;
+    for (auto v : window) sum += v;
+    out.meanUs = sum / static_cast<double>(window.size()) / 1000.0;
+
+    // Nearest-rank p99
+    const std::size_t rank = (window.size() * 99 + 99) / 100 - 1;
+    std::nth_element(window.begin(), window.begin() + static_cast<std::ptrdiff_t>(rank), window.end());
+    out.p99Us = window[rank] / 1000.0;
+    out.maxUs = *std::max_element(window.begin(), window.end()) / 1000.0;
+    return out;
+}
+
+void Profiler::writeCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot open profile CSV for writing: " + path);
+    }
+    out << "phase,calls,total_ms,mean_us,p99_us,max_us,agents_touched,allocations,events_logged\n";
+    for (std::size_t p = 0; p < static_cast<std::size_t>(Phase::COUNT); ++p) {
+        const auto phase = static_cast<Phase>(p);
+        const auto st = stats(phase);
+        if (st.calls == 0) continue;
+        out << phaseName(phase) << ',' << st.calls << ',' << st.totalNs / 1e6 << ','
+            << st.meanUs << ',' << st.p99Us << ',' << st.maxUs << ',' << st.agentsTouched << ','
+            << st.allocations << ',' << st.eventsLogged << '\n';
+    }
+}
+
+void Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot open trace file for writing: " + path);
+    }
+    std::vector<TraceEvent> trace;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        trace = trace_;
+    }
+    out << "{\"traceEvents\":[";
+    for (std::size_t i = 0; i < trace.size(); ++i) {
+        const auto& e = trace[i];
+        if (i) out << ',';
+        out << "{\"name\":\"" << phaseName(e.phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.thread << ","
+            << "\"ts\":" << e.startUs << ",\"dur\":" << e.durUs << '}';
+    }
+    out << "],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+}  // namespace profiler
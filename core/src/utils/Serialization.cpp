@@ -1,154 +1,1487 @@
 #include "utils/Serialization.h"
 #include "kernel/Kernel.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#ifdef CIV_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace serialization {
 
-// Serialize a single agent
-void writeAgent(std::ofstream& out, const Agent& agent) {
-    // Identity
-    writeBinary(out, agent.id);
-    writeBinary(out, agent.region);
-    writeBinary(out, agent.alive);
-    
-    // Demography
-    writeBinary(out, agent.age);
-    writeBinary(out, agent.female);
-    
-    // Lineage
-    writeBinary(out, agent.parent_a);
-    writeBinary(out, agent.parent_b);
-    writeBinary(out, agent.lineage_id);
-    
-    // Language
-    writeBinary(out, agent.primaryLang);
-    writeBinary(out, agent.dialect);
-    writeBinary(out, agent.fluency);
-    
-    // Personality
-    writeBinary(out, agent.openness);
-    writeBinary(out, agent.conformity);
-    writeBinary(out, agent.assertiveness);
-    writeBinary(out, agent.sociality);
-    
-    // Beliefs
-    writeBinaryArray(out, agent.x);
-    writeBinaryArray(out, agent.B);
-    writeBinary(out, agent.B_norm_sq);
-    
-    // Multipliers
-    writeBinary(out, agent.m_comm);
-    writeBinary(out, agent.m_susceptibility);
-    writeBinary(out, agent.m_mobility);
-    
-    // Neighbors
-    writeBinaryVector(out, agent.neighbors);
-}
-
-void readAgent(std::ifstream& in, Agent& agent) {
-    // Identity
-    readBinary(in, agent.id);
-    readBinary(in, agent.region);
-    readBinary(in, agent.alive);
-    
-    // Demography
-    readBinary(in, agent.age);
-    readBinary(in, agent.female);
-    
-    // Lineage
-    readBinary(in, agent.parent_a);
-    readBinary(in, agent.parent_b);
-    readBinary(in, agent.lineage_id);
-    
-    // Language
-    readBinary(in, agent.primaryLang);
-    readBinary(in, agent.dialect);
-    readBinary(in, agent.fluency);
-    
-    // Personality
-    readBinary(in, agent.openness);
-    readBinary(in, agent.conformity);
-    readBinary(in, agent.assertiveness);
-    readBinary(in, agent.sociality);
-    
-    // Beliefs
-    readBinaryArray(in, agent.x);
-    readBinaryArray(in, agent.B);
-    readBinary(in, agent.B_norm_sq);
-    
-    // Multipliers
-    readBinary(in, agent.m_comm);
-    readBinary(in, agent.m_susceptibility);
-    readBinary(in, agent.m_mobility);
-    
-    // Neighbors
-    readBinaryVector(in, agent.neighbors);
-}
-
-bool saveCheckpoint(const Kernel& kernel, const std::string& filepath) {
+namespace {
+
+// ---------- Section payloads ----------
+// Fixed-layout mirrors for state that is not trivially copyable as held
+// (pointers, vectors, private nested types). Explicit padding keeps every
+// byte of a record defined, so identical states produce identical files.
+
+struct HealthRecord {
+    double physical_health;
+    double nutrition_level;
+    double age_factor;
+    double immunity;
+    std::uint8_t infected;
+    std::uint8_t has_disease;  // current_disease == HealthModule::baselineDisease()
+    std::uint8_t pad[6];
+};
+
+struct RegionRecord {
+    double x;
+    double y;
+    std::array<double, kGoodTypes> endowments;
+    std::array<double, kGoodTypes> specialization;
+    std::array<double, kGoodTypes> production;
+    std::array<double, kGoodTypes> consumption;
+    std::array<double, kGoodTypes> prices;
+    std::array<double, kGoodTypes> trade_balance;
+    std::array<double, kGoodTypes> tech_multipliers;
+    std::array<double, 4> language_prestige;
+    double welfare;
+    double inequality;
+    double hardship;
+    double development;
+    double wealth_top_10;
+    double wealth_bottom_50;
+    double system_stability;
+    double institutional_inertia;
+    double linguistic_diversity;
+    double efficiency;
+    std::uint32_t region_id;
+    std::uint32_t population;
+    std::uint32_t years_in_current_system;
+    std::int32_t transition_pressure_ticks;
+    std::uint8_t economic_system;
+    std::uint8_t pending_system;
+    std::uint8_t dominant_language;
+    std::uint8_t pad[5];
+};
+
+struct AggregateRecord {
+    std::uint32_t population;
+    std::uint32_t dirty;
+    std::array<double, 4> belief_sum;
+};
+
+struct CohortRecord {
+    CohortKey key;
+    std::uint32_t count;
+    double avg_health;
+    double avg_nutrition;
+    double immunity_share;
+    double infected_share;
+    double mortality_rate;
+    double fertility_rate;
+};
+
+// ActivitySet::SlotState; empty section when the schedule is off
+struct ActivityRecord {
+    std::uint64_t last;
+    std::array<float, 4> target;
+    std::uint8_t quiet;
+    std::uint8_t pad[7];
+};
+
+static_assert(std::is_trivially_copyable_v<PsychologicalState>, "PSYC is copied as raw bytes");
+static_assert(std::is_trivially_copyable_v<AgentEconomy>, "AECO is copied as raw bytes");
+static_assert(std::is_trivially_copyable_v<CohortKey>, "COHT is copied as raw bytes");
+
+// ---------- Agent columns ----------
+// One section per AgentStore column; save and load walk the same list
+template <typename Store, typename Fn>
+void forEachColumn(Store& s, Fn&& fn) {
+    fn(sectionTag("XINT"), s.x);
+    fn(sectionTag("BELF"), s.B);
+    fn(sectionTag("BNRM"), s.B_norm_sq);
+    fn(sectionTag("REGN"), s.region);
+    fn(sectionTag("ALIV"), s.alive);
+    fn(sectionTag("LANG"), s.primaryLang);
+    fn(sectionTag("FLNC"), s.fluency);
+    fn(sectionTag("AGE_"), s.age);
+    fn(sectionTag("OPEN"), s.openness);
+    fn(sectionTag("CONF"), s.conformity);
+    fn(sectionTag("ASRT"), s.assertiveness);
+    fn(sectionTag("COMM"), s.m_comm);
+    fn(sectionTag("SUSC"), s.m_susceptibility);
+    fn(sectionTag("ID__"), s.id);
+    fn(sectionTag("FEML"), s.female);
+    fn(sectionTag("PARA"), s.parent_a);
+    fn(sectionTag("PARB"), s.parent_b);
+    fn(sectionTag("LINE"), s.lineage_id);
+    fn(sectionTag("DIAL"), s.dialect);
+    fn(sectionTag("SOCL"), s.sociality);
+    fn(sectionTag("MOBL"), s.m_mobility);
+    fn(sectionTag("PSYC"), s.psych);
+}
+
+constexpr std::uint32_t kMetaTag = sectionTag("META");
+constexpr std::uint32_t kHealthTag = sectionTag("HLTH");
+constexpr std::uint32_t kGraphDegreeTag = sectionTag("GDEG");
+constexpr std::uint32_t kGraphTargetTag = sectionTag("GTGT");
+constexpr std::uint32_t kIndexDegreeTag = sectionTag("RDEG");
+constexpr std::uint32_t kIndexTargetTag = sectionTag("RTGT");
+constexpr std::uint32_t kAgentEconomyTag = sectionTag("AECO");
+constexpr std::uint32_t kRegionEconomyTag = sectionTag("RECO");
+constexpr std::uint32_t kTradeDegreeTag = sectionTag("TDEG");
+constexpr std::uint32_t kTradeTargetTag = sectionTag("TTGT");
+constexpr std::uint32_t kAggregateTag = sectionTag("AGGR");
+constexpr std::uint32_t kAttractivenessTag = sectionTag("ATTR");
+constexpr std::uint32_t kAttractiveOrderTag = sectionTag("ATRK");
+constexpr std::uint32_t kCohortTag = sectionTag("COHT");
+constexpr std::uint32_t kActivityTag = sectionTag("ACTV");
+
+std::string tagName(std::uint32_t tag) {
+    std::string name(4, ' ');
+    for (int i = 0; i < 4; ++i) {
+        name[i] = static_cast<char>((tag >> (8 * i)) & 0xFF);
+    }
+    return name;
+}
+
+// Adjacency lists as CSR: per-row counts plus the rows back to back
+struct PackedRows {
+    std::vector<std::uint32_t> degrees;
+    std::vector<std::uint32_t> targets;
+};
+
+// Filled in place so reused staging keeps its capacity
+template <typename RowFn>
+void packRows(PackedRows& packed, std::size_t rows, RowFn&& row) {
+    packed.degrees.resize(rows);
+    std::size_t total = 0;
+    for (std::size_t u = 0; u < rows; ++u) {
+        packed.degrees[u] = static_cast<std::uint32_t>(row(u).second);
+        total += packed.degrees[u];
+    }
+    packed.targets.resize(total);
+    std::uint32_t* out = packed.targets.data();
+    for (std::size_t u = 0; u < rows; ++u) {
+        const auto [first, count] = row(u);
+        out = std::copy(first, first + count, out);
+    }
+}
+
+// ---------- Meta section ----------
+// key/value lines: config, scalar kernel state and generator states. Doubles
+// are written as hex floats so they round-trip exactly.
+std::string hexDouble(double value) {
+    std::ostringstream os;
+    os << std::hexfloat << value;
+    return os.str();
+}
+
+using MetaMap = std::map<std::string, std::string>;
+
+MetaMap parseMeta(const std::string& text) {
+    MetaMap meta;
+    std::istringstream in(text);
+    std::string line;
+    while (std::getline(in, line)) {
+        const auto space = line.find(' ');
+        if (space == std::string::npos) continue;
+        meta[line.substr(0, space)] = line.substr(space + 1);
+    }
+    return meta;
+}
+
+const std::string& metaValue(const MetaMap& meta, const std::string& key) {
+    const auto it = meta.find(key);
+    if (it == meta.end()) {
+        throw std::runtime_error("checkpoint meta is missing '" + key + "'");
+    }
+    return it->second;
+}
+
+std::uint64_t metaUnsigned(const MetaMap& meta, const std::string& key) {
+    return std::stoull(metaValue(meta, key));
+}
+
+double metaDouble(const MetaMap& meta, const std::string& key) {
+    return std::strtod(metaValue(meta, key).c_str(), nullptr);  // Parses hex floats
+}
+
+// ---------- Mapped input ----------
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in.is_open()) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        buffer_.resize(static_cast<std::size_t>(in.tellg()));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path);
+            }
+            ::madvise(map, size_, MADV_WILLNEED);
+            data_ = static_cast<const unsigned char*>(map);
+        }
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (data_) {
+            ::munmap(const_cast<unsigned char*>(data_), size_);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+#ifdef _WIN32
+    std::vector<unsigned char> buffer_;
+#endif
+};
+
+inline std::uint64_t rotl(std::uint64_t v, int r) {
+    return (v << r) | (v >> (64 - r));
+}
+
+}  // namespace
+
+bool compressionAvailable() {
+#ifdef CIV_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::uint64_t checksum(const void* data, std::size_t bytes) {
+    // Four independent multiply-rotate lanes over 32-byte stripes keep the
+    // loop throughput-bound; the tail and length fold in at the end
+    constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    const auto* p = static_cast<const unsigned char*>(data);
+    std::uint64_t lanes[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        for (int l = 0; l < 4; ++l) {
+            std::uint64_t word;
+            std::memcpy(&word, p + i + 8 * l, sizeof(word));
+            lanes[l] = rotl(lanes[l] + word * kPrime2, 31) * kPrime1;
+        }
+    }
+    std::uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    for (; i < bytes; ++i) {
+        h = rotl(h ^ (p[i] * kPrime1), 11) * kPrime2;
+    }
+    h ^= static_cast<std::uint64_t>(bytes);
+    h ^= h >> 33;
+    h *= kPrime2;
+    h ^= h >> 29;
+    h *= kPrime1;
+    h ^= h >> 32;
+    return h;
+}
+
+// Kernel-side gather and restore (friend of Kernel)
+struct CheckpointAccess {
+    struct OutSection {
+        std::uint32_t tag;
+        std::uint32_t elem_size;
+        const void* data;
+        std::size_t bytes;
+    };
+
+    // Derived payloads that have no contiguous home in the kernel
+    struct Staging {
+        std::string meta;
+        std::vector<HealthRecord> health;
+        PackedRows graph;
+        PackedRows index;
+        PackedRows trade;
+        std::vector<RegionRecord> regions;
+        std::vector<AggregateRecord> aggregates;
+        std::vector<CohortRecord> cohorts;
+        std::vector<ActivityRecord> activity;
+    };
+
+    template <typename T>
+    static void add(std::vector<OutSection>& out, std::uint32_t tag, const std::vector<T>& column) {
+        static_assert(std::is_trivially_copyable_v<T>, "sections are raw column bytes");
+        out.push_back({tag, static_cast<std::uint32_t>(sizeof(T)), column.data(), column.size() * sizeof(T)});
+    }
+
+    static std::vector<OutSection> gather(const Kernel& k, Staging& staging) {
+        std::vector<OutSection> out;
+        const AgentStore& agents = k.agents_;
+        const std::size_t n = agents.size();
+
+        staging.meta = encodeMeta(k);
+        out.push_back({kMetaTag, 1, staging.meta.data(), staging.meta.size()});
+
+        forEachColumn(agents, [&](std::uint32_t tag, const auto& column) { add(out, tag, column); });
+
+        staging.health.resize(n);
+        const Disease* baseline = k.health_.baselineDisease();
+        for (std::size_t i = 0; i < n; ++i) {
+            const HealthState& h = agents.health[i];
+            HealthRecord& rec = staging.health[i];
+            std::memset(&rec, 0, sizeof(rec));
+            rec.physical_health = h.physical_health;
+            rec.nutrition_level = h.nutrition_level;
+            rec.age_factor = h.age_factor;
+            rec.immunity = h.immunity;
+            rec.infected = h.infected ? 1 : 0;
+            rec.has_disease = h.current_disease == baseline ? 1 : 0;
+        }
+        add(out, kHealthTag, staging.health);
+
+        packRows(staging.graph, n, [&](std::size_t u) {
+            const auto row = agents.graph.row(static_cast<std::uint32_t>(u));
+            return std::make_pair(row.begin(), row.size());
+        });
+        add(out, kGraphDegreeTag, staging.graph.degrees);
+        add(out, kGraphTargetTag, staging.graph.targets);
+
+        packRows(staging.index, k.regionIndex_.size(), [&](std::size_t r) {
+            return std::make_pair(k.regionIndex_[r].data(), k.regionIndex_[r].size());
+        });
+        add(out, kIndexDegreeTag, staging.index.degrees);
+        add(out, kIndexTargetTag, staging.index.targets);
+
+        // Economy: agent rows as held, regional state through the record mirror
+        add(out, kAgentEconomyTag, k.economy_.agents());
+        const std::uint32_t regions = k.cfg_.regions;
+        staging.regions.resize(regions);
+        for (std::uint32_t r = 0; r < regions; ++r) {
+            staging.regions[r] = toRecord(k.economy_.getRegion(r));
+        }
+        add(out, kRegionEconomyTag, staging.regions);
+        packRows(staging.trade, regions, [&](std::size_t r) {
+            const auto& partners = k.economy_.getRegion(static_cast<std::uint32_t>(r)).trade_partners;
+            return std::make_pair(partners.data(), partners.size());
+        });
+        add(out, kTradeDegreeTag, staging.trade.degrees);
+        add(out, kTradeTargetTag, staging.trade.targets);
+
+        // Incremental aggregates carry round-off the next step depends on
+        staging.aggregates.resize(k.regional_aggregates_.size());
+        for (std::size_t r = 0; r < k.regional_aggregates_.size(); ++r) {
+            const auto& agg = k.regional_aggregates_[r];
+            staging.aggregates[r] = {agg.population, agg.dirty ? 1u : 0u, agg.belief_sum};
+        }
+        add(out, kAggregateTag, staging.aggregates);
+        add(out, kAttractivenessTag, k.region_attractiveness_);
+        add(out, kAttractiveOrderTag, k.sorted_attractive_regions_);
+
+        // Cohorts in key order, so a state always yields the same bytes
+        staging.cohorts.clear();
+        staging.cohorts.reserve(k.background_.cohorts().size());
+        for (const auto& [key, c] : k.background_.cohorts()) {
+            staging.cohorts.push_back({key, c.count, c.avg_health, c.avg_nutrition, c.immunity_share,
+                                       c.infected_share, c.mortality_rate, c.fertility_rate});
+        }
+        std::sort(staging.cohorts.begin(), staging.cohorts.end(), [](const CohortRecord& a, const CohortRecord& b) {
+            return std::make_tuple(a.key.region, a.key.age_group, a.key.female) <
+                   std::make_tuple(b.key.region, b.key.age_group, b.key.female);
+        });
+        add(out, kCohortTag, staging.cohorts);
+
+        // Activity schedule: which agents are quiescent and when they last updated
+        staging.activity.resize(k.activity_.enabled() ? k.activity_.size() : 0);
+        for (std::size_t i = 0; i < staging.activity.size(); ++i) {
+            const auto slot = k.activity_.slotState(static_cast<std::uint32_t>(i));
+            ActivityRecord& rec = staging.activity[i];
+            std::memset(&rec, 0, sizeof(rec));
+            rec.last = slot.last;
+            rec.target = slot.target;
+            rec.quiet = slot.quiet;
+        }
+        add(out, kActivityTag, staging.activity);
+        return out;
+    }
+
+    // Buffers gather() filled itself; every other section points into the kernel
+    static std::vector<const void*> stagedBuffers(const Staging& s) {
+        return {s.meta.data(), s.health.data(), s.graph.degrees.data(), s.graph.targets.data(),
+                s.index.degrees.data(), s.index.targets.data(), s.trade.degrees.data(),
+                s.trade.targets.data(), s.regions.data(), s.aggregates.data(), s.cohorts.data(),
+                s.activity.data()};
+    }
+
+    // One line per config field; also the identity of an init image
+    static std::string encodeConfig(const KernelConfig& c) {
+        std::ostringstream os;
+        os << "population " << c.population << '\n'
+           << "regions " << c.regions << '\n'
+           << "avgConnections " << c.avgConnections << '\n'
+           << "rewireProb " << hexDouble(c.rewireProb) << '\n'
+           << "stepSize " << hexDouble(c.stepSize) << '\n'
+           << "simFloor " << hexDouble(c.simFloor) << '\n'
+           << "useMeanField " << (c.useMeanField ? 1 : 0) << '\n'
+           << "seed " << c.seed << '\n'
+           << "geographySeed " << c.geographySeed << '\n'
+           << "startCondition " << c.startCondition << '\n'
+           << "ticksPerYear " << c.ticksPerYear << '\n'
+           << "maxAgeYears " << c.maxAgeYears << '\n'
+           << "regionCapacity " << hexDouble(c.regionCapacity) << '\n'
+           << "demographyEnabled " << (c.demographyEnabled ? 1 : 0) << '\n'
+           << "maxPopulation " << c.maxPopulation << '\n'
+           << "liveClusters " << c.liveClusters << '\n'
+           << "liveClusterReassignTicks " << c.liveClusterReassignTicks << '\n'
+           << "polarizationSampleRegions " << c.polarizationSampleRegions << '\n'
+           << "backgroundPopulation " << c.backgroundPopulation << '\n'
+           << "reorderTicks " << c.reorderTicks << '\n'
+           << "reorderByRegion " << (c.reorderByRegion ? 1 : 0) << '\n'
+           << "memoryBudget " << c.memoryBudget << '\n'
+           << "offloadBeliefs " << (c.offloadBeliefs ? 1 : 0) << '\n'
+           << "activityInterval " << c.activityInterval << '\n'
+           << "activityThreshold " << hexDouble(c.activityThreshold) << '\n';
+        return os.str();
+    }
+
+    static std::string encodeMeta(const Kernel& k) {
+        std::ostringstream os;
+        os << encodeConfig(k.cfg_)
+           << "generation " << k.generation_ << '\n'
+           << "nextAgentId " << k.nextAgentId_ << '\n'
+           << "backgroundScale " << hexDouble(k.background_scale_) << '\n'
+           << "attractivenessGen " << k.attractiveness_update_gen_ << '\n'
+           << "forcedModel " << economicSystemName(k.economy_.forcedModel()) << '\n'
+           << "warAllocation " << hexDouble(k.economy_.warAllocation()) << '\n'
+           << "cohortRng " << k.background_.rngState() << '\n'
+           << "rng " << k.rng_ << '\n'
+           << "precision " << precision::kName << '\n';
+        return os.str();
+    }
+
+    static KernelConfig decodeConfig(const MetaMap& meta) {
+        KernelConfig c;
+        c.population = static_cast<std::uint32_t>(metaUnsigned(meta, "population"));
+        c.regions = static_cast<std::uint32_t>(metaUnsigned(meta, "regions"));
+        c.avgConnections = static_cast<std::uint32_t>(metaUnsigned(meta, "avgConnections"));
+        c.rewireProb = metaDouble(meta, "rewireProb");
+        c.stepSize = metaDouble(meta, "stepSize");
+        c.simFloor = metaDouble(meta, "simFloor");
+        c.useMeanField = metaUnsigned(meta, "useMeanField") != 0;
+        c.seed = metaUnsigned(meta, "seed");
+        if (meta.count("geographySeed")) c.geographySeed = metaUnsigned(meta, "geographySeed");  // Absent before it existed
+        c.startCondition = metaValue(meta, "startCondition");
+        c.ticksPerYear = std::stoi(metaValue(meta, "ticksPerYear"));
+        c.maxAgeYears = std::stoi(metaValue(meta, "maxAgeYears"));
+        c.regionCapacity = metaDouble(meta, "regionCapacity");
+        c.demographyEnabled = metaUnsigned(meta, "demographyEnabled") != 0;
+        c.maxPopulation = static_cast<std::uint32_t>(metaUnsigned(meta, "maxPopulation"));
+        c.liveClusters = std::stoi(metaValue(meta, "liveClusters"));
+        c.liveClusterReassignTicks = static_cast<std::uint32_t>(metaUnsigned(meta, "liveClusterReassignTicks"));
+        c.polarizationSampleRegions = static_cast<std::uint32_t>(metaUnsigned(meta, "polarizationSampleRegions"));
+        c.backgroundPopulation = static_cast<std::uint32_t>(metaUnsigned(meta, "backgroundPopulation"));
+        if (meta.count("reorderTicks")) {  // Absent before it existed
+            c.reorderTicks = static_cast<std::uint32_t>(metaUnsigned(meta, "reorderTicks"));
+            c.reorderByRegion = metaUnsigned(meta, "reorderByRegion") != 0;
+        }
+        if (meta.count("memoryBudget")) c.memoryBudget = metaUnsigned(meta, "memoryBudget");  // Absent before it existed
+        if (meta.count("offloadBeliefs")) c.offloadBeliefs = metaUnsigned(meta, "offloadBeliefs") != 0;  // Absent before it existed
+        if (meta.count("activityInterval")) {  // Absent before it existed
+            c.activityInterval = static_cast<std::uint32_t>(metaUnsigned(meta, "activityInterval"));
+            c.activityThreshold = metaDouble(meta, "activityThreshold");
+        }
+        return c;
+    }
+
+    static RegionRecord toRecord(const RegionalEconomy& r) {
+        RegionRecord rec;
+        std::memset(&rec, 0, sizeof(rec));
+        rec.x = r.x;
+        rec.y = r.y;
+        rec.endowments = r.endowments;
+        rec.specialization = r.specialization;
+        rec.production = r.production;
+        rec.consumption = r.consumption;
+        rec.prices = r.prices;
+        rec.trade_balance = r.trade_balance;
+        rec.tech_multipliers = r.tech_multipliers;
+        rec.language_prestige = r.language_prestige;
+        rec.welfare = r.welfare;
+        rec.inequality = r.inequality;
+        rec.hardship = r.hardship;
+        rec.development = r.development;
+        rec.wealth_top_10 = r.wealth_top_10;
+        rec.wealth_bottom_50 = r.wealth_bottom_50;
+        rec.system_stability = r.system_stability;
+        rec.institutional_inertia = r.institutional_inertia;
+        rec.linguistic_diversity = r.linguistic_diversity;
+        rec.efficiency = r.efficiency;
+        rec.region_id = r.region_id;
+        rec.population = r.population;
+        rec.years_in_current_system = r.years_in_current_system;
+        rec.transition_pressure_ticks = r.transition_pressure_ticks;
+        rec.economic_system = static_cast<std::uint8_t>(r.economic_system);
+        rec.pending_system = static_cast<std::uint8_t>(r.pending_system);
+        rec.dominant_language = r.dominant_language;
+        return rec;
+    }
+
+    static RegionalEconomy fromRecord(const RegionRecord& rec) {
+        if (rec.economic_system > static_cast<std::uint8_t>(EconomicSystem::None) ||
+            rec.pending_system > static_cast<std::uint8_t>(EconomicSystem::None)) {
+            throw std::runtime_error("checkpoint region has an unknown economic system");
+        }
+        RegionalEconomy r;
+        r.x = rec.x;
+        r.y = rec.y;
+        r.endowments = rec.endowments;
+        r.specialization = rec.specialization;
+        r.production = rec.production;
+        r.consumption = rec.consumption;
+        r.prices = rec.prices;
+        r.trade_balance = rec.trade_balance;
+        r.tech_multipliers = rec.tech_multipliers;
+        r.language_prestige = rec.language_prestige;
+        r.welfare = rec.welfare;
+        r.inequality = rec.inequality;
+        r.hardship = rec.hardship;
+        r.development = rec.development;
+        r.wealth_top_10 = rec.wealth_top_10;
+        r.wealth_bottom_50 = rec.wealth_bottom_50;
+        r.system_stability = rec.system_stability;
+        r.institutional_inertia = rec.institutional_inertia;
+        r.linguistic_diversity = rec.linguistic_diversity;
+        r.efficiency = rec.efficiency;
+        r.region_id = rec.region_id;
+        r.population = rec.population;
+        r.years_in_current_system = rec.years_in_current_system;
+        r.transition_pressure_ticks = rec.transition_pressure_ticks;
+        r.economic_system = static_cast<EconomicSystem>(rec.economic_system);
+        r.pending_system = static_cast<EconomicSystem>(rec.pending_system);
+        r.dominant_language = rec.dominant_language;
+        return r;
+    }
+
+    // Everything decoded from a file, moved into the kernel on success
+    struct Restored {
+        KernelConfig cfg;
+        MetaMap meta;
+        AgentStore agents;
+        std::vector<HealthRecord> health;
+        std::vector<std::vector<std::uint32_t>> regionIndex;
+        std::vector<AgentEconomy> agentEconomy;
+        std::vector<RegionalEconomy> regions;
+        std::vector<AggregateRecord> aggregates;
+        std::vector<double> attractiveness;
+        std::vector<std::uint32_t> attractiveOrder;
+        std::vector<CohortRecord> cohorts;
+        std::vector<ActivityRecord> activity;
+    };
+
+    // Empty kernel for restore() to fill, skipping the world reset() would build
+    static std::unique_ptr<Kernel> unbuilt(const KernelConfig& cfg) {
+        return std::unique_ptr<Kernel>(new Kernel(cfg, Kernel::Unbuilt{}));
+    }
+
+    static void restore(Kernel& k, Restored& in) {
+        // Parse every scalar before touching the kernel, so a bad file leaves it intact
+        const std::uint64_t generation = metaUnsigned(in.meta, "generation");
+        const auto nextAgentId = static_cast<std::uint32_t>(metaUnsigned(in.meta, "nextAgentId"));
+        const std::uint64_t attractivenessGen = metaUnsigned(in.meta, "attractivenessGen");
+        const double backgroundScale = metaDouble(in.meta, "backgroundScale");
+        const double warAllocation = metaDouble(in.meta, "warAllocation");
+        const std::uint64_t cohortRng = metaUnsigned(in.meta, "cohortRng");
+        EconomicSystem forced = EconomicSystem::None;
+        if (!parseEconomicSystem(metaValue(in.meta, "forcedModel"), forced)) {
+            throw std::runtime_error("checkpoint has an unknown forced economic model");
+        }
+        std::mt19937_64 rng;
+        std::istringstream rngText(metaValue(in.meta, "rng"));
+        rngText >> rng;
+        if (!rngText) {
+            throw std::runtime_error("checkpoint has a malformed generator state");
+        }
+
+        k.cfg_ = in.cfg;
+        k.generation_ = generation;
+        k.nextAgentId_ = nextAgentId;
+        k.rng_ = rng;
+        ++k.state_version_;
+        k.configureModules();
+        k.economy_.restore(in.cfg.startCondition, std::move(in.regions), std::move(in.agentEconomy),
+                           forced, warAllocation);
+
+        const Disease* baseline = k.health_.baselineDisease();
+        for (std::size_t i = 0; i < in.health.size(); ++i) {
+            const HealthRecord& rec = in.health[i];
+            HealthState& h = in.agents.health[i];
+            h.physical_health = rec.physical_health;
+            h.nutrition_level = rec.nutrition_level;
+            h.age_factor = rec.age_factor;
+            h.immunity = rec.immunity;
+            h.infected = rec.infected != 0;
+            h.current_disease = rec.has_disease ? baseline : nullptr;
+        }
+        k.agents_ = std::move(in.agents);
+        k.agents_.reindex();  // Reordered stores hold ids out of order
+        k.regionIndex_ = std::move(in.regionIndex);
+
+        k.regional_aggregates_.assign(k.cfg_.regions, {});
+        for (std::size_t r = 0; r < in.aggregates.size(); ++r) {
+            auto& agg = k.regional_aggregates_[r];
+            agg.population = in.aggregates[r].population;
+            agg.dirty = in.aggregates[r].dirty != 0;
+            agg.belief_sum = in.aggregates[r].belief_sum;
+        }
+        k.aggregates_initialized_ = true;
+        k.region_attractiveness_ = std::move(in.attractiveness);
+        k.sorted_attractive_regions_ = std::move(in.attractiveOrder);
+        k.attractiveness_update_gen_ = attractivenessGen;
+
+        k.background_scale_ = backgroundScale;
+        std::vector<std::pair<CohortKey, Cohort>> cohorts;
+        cohorts.reserve(in.cohorts.size());
+        for (const auto& rec : in.cohorts) {
+            Cohort c;
+            c.count = rec.count;
+            c.avg_health = rec.avg_health;
+            c.avg_nutrition = rec.avg_nutrition;
+            c.immunity_share = rec.immunity_share;
+            c.infected_share = rec.infected_share;
+            c.mortality_rate = rec.mortality_rate;
+            c.fertility_rate = rec.fertility_rate;
+            cohorts.emplace_back(rec.key, c);
+        }
+        k.background_.restore(cohorts, cohortRng);
+        if (!cohorts.empty()) {
+            k.calibrateCohorts(k.background_, k.background_scale_);
+        }
+
+        k.event_log_.clear();  // History is not checkpointed
+        k.setLiveClustering(k.cfg_.liveClusters, k.cfg_.liveClusterReassignTicks);
+        k.setBeliefOffload(k.cfg_.offloadBeliefs);
+        k.setActivity(k.cfg_.activityInterval, k.cfg_.activityThreshold);
+        if (!in.activity.empty()) {  // Absent: schedule off, or written before it was saved
+            std::vector<ActivitySet::SlotState> slots(in.activity.size());
+            for (std::size_t i = 0; i < slots.size(); ++i) {
+                slots[i] = {in.activity[i].last, in.activity[i].target, in.activity[i].quiet};
+            }
+            k.activity_.restore(slots);
+        }
+    }
+};
+
+namespace {
+
+constexpr std::uint32_t kLinkTag = sectionTag("LINK");
+
+// Chain identity: every file names itself and, for deltas, the save it patches
+struct LinkRecord {
+    std::uint64_t id;
+    std::uint64_t parent;  // 0 for a base
+};
+
+std::uint64_t makeCheckpointId(std::uint64_t generation) {
+    static std::atomic<std::uint64_t> counter{0};
+    const std::uint64_t words[3] = {
+        generation,
+        static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()),
+        counter.fetch_add(1, std::memory_order_relaxed),
+    };
+    return checksum(words, sizeof(words)) | 1;  // Never 0, which marks "no parent"
+}
+
+// Verify a stored payload and decode it into dst (raw_size bytes)
+void decodePayload(const SectionEntry& e, const unsigned char* src, void* dst) {
+    if (checksum(src, e.stored_size) != e.checksum) {
+        throw std::runtime_error("checksum mismatch in section " + tagName(e.tag));
+    }
+    if (e.codec == SectionCodec::Raw) {
+        if (e.stored_size != e.raw_size) {
+            throw std::runtime_error("section " + tagName(e.tag) + " has inconsistent sizes");
+        }
+        if (e.raw_size > 0) {
+            std::memcpy(dst, src, e.raw_size);
+        }
+        return;
+    }
+    if (e.codec != SectionCodec::Zlib) {
+        throw std::runtime_error("section " + tagName(e.tag) + " uses an unknown codec");
+    }
+#ifdef CIV_HAVE_ZLIB
+    uLongf length = static_cast<uLongf>(e.raw_size);
+    if (uncompress(static_cast<Bytef*>(dst), &length, src, static_cast<uLong>(e.stored_size)) != Z_OK ||
+        length != e.raw_size) {
+        throw std::runtime_error("cannot inflate section " + tagName(e.tag));
+    }
+#else
+    throw std::runtime_error("section " + tagName(e.tag) +
+                             " is compressed but this build has no zlib (ENABLE_CHECKPOINT_COMPRESSION)");
+#endif
+}
+
+// Validated view of the sections in one mapped file
+class SectionReader {
+public:
+    explicit SectionReader(const MappedFile& file) : file_(file) {
+        if (file.size() < sizeof(std::uint32_t) * 2) {
+            throw std::runtime_error("not a checkpoint (too short)");
+        }
+        std::memcpy(&header_, file.data(), std::min(file.size(), sizeof(header_)));
+        if (header_.magic != CHECKPOINT_MAGIC) {
+            throw std::runtime_error("not a checkpoint (bad magic number)");
+        }
+        if (header_.version != CHECKPOINT_VERSION) {
+            throw std::runtime_error("version mismatch (expected " + std::to_string(CHECKPOINT_VERSION) +
+                                     ", got " + std::to_string(header_.version) + ")");
+        }
+        const std::size_t table = sizeof(CheckpointHeader) +
+                                  static_cast<std::size_t>(header_.section_count) * sizeof(SectionEntry);
+        if (file.size() < table) {
+            throw std::runtime_error("truncated section table");
+        }
+        for (std::uint32_t s = 0; s < header_.section_count; ++s) {
+            SectionEntry entry;
+            std::memcpy(&entry, file.data() + sizeof(CheckpointHeader) + s * sizeof(SectionEntry), sizeof(entry));
+            if (entry.offset > file.size() || entry.stored_size > file.size() - entry.offset) {
+                throw std::runtime_error("section " + tagName(entry.tag) + " runs past the end of the file");
+            }
+            entries_[entry.tag] = entry;
+        }
+    }
+
+    const CheckpointHeader& header() const { return header_; }
+    bool delta() const { return (header_.flags & kDeltaCheckpoint) != 0; }
+    const std::map<std::uint32_t, SectionEntry>& entries() const { return entries_; }
+    bool has(std::uint32_t tag) const { return entries_.count(tag) != 0; }
+
+    // Require `tag` to hold `count` elements of `elem_size` bytes
+    void expect(std::uint32_t tag, std::size_t count, std::size_t elem_size) const {
+        const SectionEntry& e = entry(tag);
+        if (e.elem_size != elem_size || e.raw_size != count * elem_size) {
+            throw std::runtime_error("section " + tagName(tag) + " has unexpected size");
+        }
+    }
+
+    std::size_t count(std::uint32_t tag, std::size_t elem_size) const {
+        const SectionEntry& e = entry(tag);
+        if (e.elem_size != elem_size || e.raw_size % elem_size != 0) {
+            throw std::runtime_error("section " + tagName(tag) + " has unexpected element size");
+        }
+        return static_cast<std::size_t>(e.raw_size / elem_size);
+    }
+
+    void decode(std::uint32_t tag, void* dst) const {
+        const SectionEntry& e = entry(tag);
+        decodePayload(e, file_.data() + e.offset, dst);
+    }
+
+    LinkRecord link() const {
+        LinkRecord link{0, 0};
+        if (has(kLinkTag)) {
+            expect(kLinkTag, 1, sizeof(LinkRecord));
+            decode(kLinkTag, &link);
+        }
+        return link;
+    }
+
+private:
+    const SectionEntry& entry(std::uint32_t tag) const {
+        const auto it = entries_.find(tag);
+        if (it == entries_.end()) {
+            throw std::runtime_error("missing section " + tagName(tag));
+        }
+        return it->second;
+    }
+
+    const MappedFile& file_;
+    CheckpointHeader header_;
+    std::map<std::uint32_t, SectionEntry> entries_;
+};
+
+// Decoded section bytes, patched in memory while a delta chain is applied
+struct SectionImage {
+    std::uint32_t elem_size = 0;
+    std::vector<unsigned char> bytes;
+};
+
+using ImageMap = std::map<std::uint32_t, SectionImage>;
+
+// SectionReader's interface over in-memory images
+class ImageSource {
+public:
+    explicit ImageSource(const ImageMap& images) : images_(images) {}
+
+    bool has(std::uint32_t tag) const { return images_.count(tag) != 0; }
+
+    void expect(std::uint32_t tag, std::size_t count, std::size_t elem_size) const {
+        const SectionImage& image = find(tag);
+        if (image.elem_size != elem_size || image.bytes.size() != count * elem_size) {
+            throw std::runtime_error("section " + tagName(tag) + " has unexpected size");
+        }
+    }
+
+    std::size_t count(std::uint32_t tag, std::size_t elem_size) const {
+        const SectionImage& image = find(tag);
+        if (image.elem_size != elem_size || image.bytes.size() % elem_size != 0) {
+            throw std::runtime_error("section " + tagName(tag) + " has unexpected element size");
+        }
+        return image.bytes.size() / elem_size;
+    }
+
+    void decode(std::uint32_t tag, void* dst) const {
+        const SectionImage& image = find(tag);
+        if (!image.bytes.empty()) {
+            std::memcpy(dst, image.bytes.data(), image.bytes.size());
+        }
+    }
+
+private:
+    const SectionImage& find(std::uint32_t tag) const {
+        const auto it = images_.find(tag);
+        if (it == images_.end()) {
+            throw std::runtime_error("missing section " + tagName(tag));
+        }
+        return it->second;
+    }
+
+    const ImageMap& images_;
+};
+
+struct DecodeJob {
+    std::uint32_t tag;
+    void* dst;
+};
+
+template <typename Source, typename T>
+void queue(std::vector<DecodeJob>& jobs, const Source& source, std::uint32_t tag,
+           std::vector<T>& dst, std::size_t count) {
+    source.expect(tag, count, sizeof(T));
+    dst.resize(count);
+    jobs.push_back({tag, dst.data()});
+}
+
+// Parallel loop whose body may throw; the first message is rethrown after the loop
+template <typename Fn>
+void parallelFor(std::size_t count, Fn&& fn) {
+    std::string error;
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (std::ptrdiff_t j = 0; j < static_cast<std::ptrdiff_t>(count); ++j) {
+        try {
+            fn(static_cast<std::size_t>(j));
+        } catch (const std::exception& e) {
+            #pragma omp critical(checkpoint_parallel_error)
+            if (error.empty()) error = e.what();
+        }
+    }
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+}
+
+// Decode jobs write disjoint buffers, so sections inflate in parallel
+template <typename Source>
+void runJobs(const Source& source, const std::vector<DecodeJob>& jobs) {
+    parallelFor(jobs.size(), [&](std::size_t j) { source.decode(jobs[j].tag, jobs[j].dst); });
+}
+
+std::vector<std::vector<std::uint32_t>> unpackRows(const std::vector<std::uint32_t>& degrees,
+                                                   const std::vector<std::uint32_t>& targets) {
+    std::vector<std::vector<std::uint32_t>> rows(degrees.size());
+    std::size_t at = 0;
+    for (std::size_t r = 0; r < degrees.size(); ++r) {
+        rows[r].assign(targets.begin() + static_cast<std::ptrdiff_t>(at),
+                       targets.begin() + static_cast<std::ptrdiff_t>(at + degrees[r]));
+        at += degrees[r];
+    }
+    return rows;
+}
+
+std::size_t totalDegree(const std::vector<std::uint32_t>& degrees) {
+    std::size_t total = 0;
+    for (auto d : degrees) total += d;
+    return total;
+}
+
+// Everything past the header: sections -> Restored, validated
+template <typename Source>
+void decodeState(const Source& source, std::size_t n, std::size_t regions, CheckpointAccess::Restored& in) {
+    std::string metaText(source.count(kMetaTag, 1), '\0');
+    source.decode(kMetaTag, metaText.data());
+    in.meta = parseMeta(metaText);
+    // Column sections hold raw stored values, so only a build with the same
+    // storage precision can read them (absent: written before floats existed)
+    const std::string stored = in.meta.count("precision") ? in.meta.at("precision") : "double";
+    if (stored != precision::kName) {
+        throw std::runtime_error("checkpoint stores " + stored + " agent state but this build uses " +
+                                 precision::kName);
+    }
+    in.cfg = CheckpointAccess::decodeConfig(in.meta);
+    if (in.cfg.regions != regions) {
+        throw std::runtime_error("region count in meta does not match the header");
+    }
+
+    // Row lengths first: they size the packed targets
+    PackedRows graph;
+    PackedRows index;
+    PackedRows trade;
+    std::vector<DecodeJob> jobs;
+    queue(jobs, source, kGraphDegreeTag, graph.degrees, n);
+    queue(jobs, source, kIndexDegreeTag, index.degrees, regions);
+    queue(jobs, source, kTradeDegreeTag, trade.degrees, regions);
+    runJobs(source, jobs);
+    jobs.clear();
+
+    // Columns decode straight into the store that replaces the kernel's
+    forEachColumn(in.agents, [&](std::uint32_t tag, auto& column) {
+        queue(jobs, source, tag, column, n);
+    });
+    in.agents.health.resize(n);
+    queue(jobs, source, kHealthTag, in.health, n);
+    queue(jobs, source, kGraphTargetTag, graph.targets, totalDegree(graph.degrees));
+    queue(jobs, source, kIndexTargetTag, index.targets, totalDegree(index.degrees));
+    queue(jobs, source, kTradeTargetTag, trade.targets, totalDegree(trade.degrees));
+    queue(jobs, source, kAgentEconomyTag, in.agentEconomy, n);
+    std::vector<RegionRecord> regionRecords;
+    queue(jobs, source, kRegionEconomyTag, regionRecords, regions);
+    queue(jobs, source, kAggregateTag, in.aggregates, regions);
+    queue(jobs, source, kAttractivenessTag, in.attractiveness, regions);
+    queue(jobs, source, kAttractiveOrderTag, in.attractiveOrder, regions);
+    queue(jobs, source, kCohortTag, in.cohorts, source.count(kCohortTag, sizeof(CohortRecord)));
+    if (source.has(kActivityTag)) {
+        const std::size_t slots = source.count(kActivityTag, sizeof(ActivityRecord));
+        if (slots > n) throw std::runtime_error("activity schedule has more slots than agents");
+        queue(jobs, source, kActivityTag, in.activity, slots);
+    }
+    runJobs(source, jobs);
+
+    for (auto t : graph.targets) {
+        if (t >= n) throw std::runtime_error("graph target out of range");
+    }
+    for (auto s : index.targets) {
+        if (s >= n) throw std::runtime_error("region index slot out of range");
+    }
+    for (auto p : trade.targets) {
+        if (p >= regions) throw std::runtime_error("trade partner out of range");
+    }
+    in.agents.graph.build(graph.degrees.data(), n, graph.targets.data());
+    in.regionIndex = unpackRows(index.degrees, index.targets);
+    auto partners = unpackRows(trade.degrees, trade.targets);
+    in.regions.reserve(regions);
+    for (std::size_t r = 0; r < regions; ++r) {
+        in.regions.push_back(CheckpointAccess::fromRecord(regionRecords[r]));
+        in.regions.back().trade_partners = std::move(partners[r]);
+    }
+}
+
+// Encode (deflate where it pays), checksum and write a container; returns bytes written
+std::uint64_t writeContainer(const std::string& filepath, const CheckpointHeader& header,
+                             const std::vector<CheckpointAccess::OutSection>& sections,
+                             const CheckpointOptions& options, bool parallel = true) {
     std::ofstream out(filepath, std::ios::binary);
     if (!out.is_open()) {
-        std::cerr << "Failed to open checkpoint file for writing: " << filepath << std::endl;
+        throw std::runtime_error("cannot open " + filepath + " for writing");
+    }
+
+    std::vector<SectionEntry> table(sections.size());
+    std::vector<std::vector<unsigned char>> packed(sections.size());
+    #pragma omp parallel for schedule(dynamic, 1) if(parallel)
+    for (std::ptrdiff_t s = 0; s < static_cast<std::ptrdiff_t>(sections.size()); ++s) {
+        const auto& section = sections[s];
+        SectionEntry& entry = table[s];
+        entry.tag = section.tag;
+        entry.elem_size = section.elem_size;
+        entry.raw_size = section.bytes;
+        entry.stored_size = section.bytes;
+#ifdef CIV_HAVE_ZLIB
+        if (options.compress && section.bytes > 0 &&
+            section.bytes <= std::numeric_limits<uLong>::max()) {
+            uLongf length = compressBound(static_cast<uLong>(section.bytes));
+            packed[s].resize(length);
+            if (compress2(packed[s].data(), &length, static_cast<const Bytef*>(section.data),
+                          static_cast<uLong>(section.bytes), options.level) == Z_OK &&
+                length < section.bytes) {
+                packed[s].resize(length);
+                entry.codec = SectionCodec::Zlib;
+                entry.stored_size = length;
+            } else {
+                packed[s].clear();
+            }
+        }
+#else
+        (void)options;
+#endif
+        const void* stored = entry.codec == SectionCodec::Raw ? section.data : packed[s].data();
+        entry.checksum = checksum(stored, static_cast<std::size_t>(entry.stored_size));
+    }
+
+    // Payloads follow the table, each on an aligned offset
+    std::uint64_t offset = sizeof(CheckpointHeader) + table.size() * sizeof(SectionEntry);
+    for (auto& entry : table) {
+        offset = (offset + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+        entry.offset = offset;
+        offset += entry.stored_size;
+    }
+
+    CheckpointHeader h = header;
+    h.section_count = static_cast<std::uint32_t>(table.size());
+    writeBinary(out, h);
+    out.write(reinterpret_cast<const char*>(table.data()),
+              static_cast<std::streamsize>(table.size() * sizeof(SectionEntry)));
+    std::uint64_t written = sizeof(CheckpointHeader) + table.size() * sizeof(SectionEntry);
+    const char zeros[kSectionAlignment] = {};
+    for (std::size_t s = 0; s < table.size(); ++s) {
+        out.write(zeros, static_cast<std::streamsize>(table[s].offset - written));
+        const void* stored = table[s].codec == SectionCodec::Raw ? sections[s].data : packed[s].data();
+        out.write(static_cast<const char*>(stored), static_cast<std::streamsize>(table[s].stored_size));
+        written = table[s].offset + table[s].stored_size;
+    }
+    out.close();
+    if (!out) {
+        throw std::runtime_error("write to " + filepath + " failed");
+    }
+    return written;
+}
+
+// Flush a closed file to stable storage
+void syncFile(const std::string& filepath) {
+#ifndef _WIN32
+    const int fd = ::open(filepath.c_str(), O_WRONLY);
+    if (fd < 0) {
+        throw std::runtime_error("cannot reopen " + filepath + " to sync");
+    }
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    if (!ok) {
+        throw std::runtime_error("fsync of " + filepath + " failed");
+    }
+#else
+    (void)filepath;
+#endif
+}
+
+CheckpointHeader makeHeader(const Kernel& kernel, std::uint32_t flags) {
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    CheckpointHeader header;
+    header.generation = kernel.generation();
+    header.num_agents = static_cast<std::uint32_t>(kernel.agents().size());
+    header.num_regions = kernel.config().regions;
+    header.seed = kernel.config().seed;
+    header.timestamp = static_cast<std::uint64_t>(timestamp);
+    header.flags = flags;
+    return header;
+}
+
+// ---------- Delta encoding ----------
+// Per-agent sections are diffed by agent rather than by slot: IDs are handed
+// out in increasing order and compaction keeps survivors in order, so merging
+// two saves' ID columns maps every slot to the same agent's old slot, and an
+// agent that only moved slots costs one bit. Writer and loader derive that
+// map from the same two ID columns.
+constexpr std::uint32_t kIdTag = sectionTag("ID__");
+constexpr std::uint32_t kNoSlot = ~std::uint32_t{0};
+
+enum class DeltaKind : std::uint32_t {
+    Whole = 0,     // Replacement bytes
+    Elements = 1,  // Changed-element bitmap, then the changed elements
+    Rows = 2,      // Changed-row bitmap, then the targets of changed rows
+    Ids = 3,       // Survivor bitmap over the parent's slots, then appended IDs
+};
+
+struct DeltaHeader {
+    std::uint32_t kind;
+    std::uint32_t elem_size;
+    std::uint64_t count;   // Elements or rows after the patch (Ids: parent slots)
+    std::uint64_t values;  // Elements after the bitmap (Whole: all of them)
+};
+
+bool agentKeyed(std::uint32_t tag) {
+    static const std::vector<std::uint32_t> tags = [] {
+        std::vector<std::uint32_t> t{kHealthTag, kAgentEconomyTag, kGraphDegreeTag, kActivityTag};
+        const AgentStore empty;
+        forEachColumn(empty, [&](std::uint32_t tag, const auto&) {
+            if (tag != kIdTag) t.push_back(tag);
+        });
+        return t;
+    }();
+    return std::find(tags.begin(), tags.end(), tag) != tags.end();
+}
+
+bool regionKeyed(std::uint32_t tag) {
+    return tag == kRegionEconomyTag || tag == kAggregateTag || tag == kAttractivenessTag ||
+           tag == kAttractiveOrderTag || tag == kTradeDegreeTag;
+}
+
+// Slot map between two saves: next slot -> parent slot of the same agent
+// (kNoSlot for agents born since), plus the inverse
+struct SlotMap {
+    std::vector<std::uint32_t> toParent;
+    std::vector<std::uint32_t> fromParent;
+    bool identity = true;
+};
+
+SlotMap matchSlots(const std::vector<unsigned char>& parentIds, const std::vector<unsigned char>& nextIds) {
+    const std::size_t pn = parentIds.size() / sizeof(std::uint32_t);
+    const std::size_t nn = nextIds.size() / sizeof(std::uint32_t);
+    std::vector<std::uint32_t> parent(pn), next(nn);
+    if (pn) std::memcpy(parent.data(), parentIds.data(), pn * sizeof(std::uint32_t));
+    if (nn) std::memcpy(next.data(), nextIds.data(), nn * sizeof(std::uint32_t));
+
+    SlotMap map;
+    map.toParent.assign(nn, kNoSlot);
+    map.fromParent.assign(pn, kNoSlot);
+    map.identity = pn == nn;
+    // IDs are unique, so an unsorted column only loses matches, never mismatches
+    for (std::size_t i = 0, j = 0; i < nn && j < pn;) {
+        if (next[i] == parent[j]) {
+            map.toParent[i] = static_cast<std::uint32_t>(j);
+            map.fromParent[j] = static_cast<std::uint32_t>(i);
+            ++i, ++j;
+        } else if (next[i] < parent[j]) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    for (std::size_t i = 0; i < nn && map.identity; ++i) {
+        map.identity = map.toParent[i] == i;
+    }
+    return map;
+}
+
+inline bool testBit(const std::uint64_t* bits, std::size_t i) {
+    return (bits[i / 64] >> (i % 64)) & 1u;
+}
+
+inline std::size_t bitmapWords(std::size_t n) { return (n + 63) / 64; }
+
+std::vector<unsigned char> makePatch(DeltaKind kind, std::uint32_t elemSize, std::uint64_t count,
+                                     const std::vector<std::uint64_t>& bitmap, std::uint64_t values) {
+    std::vector<unsigned char> patch(sizeof(DeltaHeader) + bitmap.size() * sizeof(std::uint64_t) +
+                                     static_cast<std::size_t>(values) * elemSize);
+    const DeltaHeader dh{static_cast<std::uint32_t>(kind), elemSize, count, values};
+    std::memcpy(patch.data(), &dh, sizeof(dh));
+    if (!bitmap.empty()) {
+        std::memcpy(patch.data() + sizeof(dh), bitmap.data(), bitmap.size() * sizeof(std::uint64_t));
+    }
+    return patch;
+}
+
+inline unsigned char* patchValues(std::vector<unsigned char>& patch, std::size_t bitmapWordCount) {
+    return patch.data() + sizeof(DeltaHeader) + bitmapWordCount * sizeof(std::uint64_t);
+}
+
+// Each encoder returns an empty vector when the section equals its parent
+
+std::vector<unsigned char> encodeWhole(const unsigned char* data, std::size_t bytes, std::uint32_t elemSize,
+                                       const std::vector<unsigned char>* parent) {
+    if (parent && parent->size() == bytes && (bytes == 0 || std::memcmp(parent->data(), data, bytes) == 0)) {
+        return {};
+    }
+    auto patch = makePatch(DeltaKind::Whole, elemSize, bytes / std::max<std::uint32_t>(1, elemSize), {},
+                           bytes / std::max<std::uint32_t>(1, elemSize));
+    if (bytes) std::memcpy(patchValues(patch, 0), data, bytes);
+    return patch;
+}
+
+// Element i pairs with parent element map[i] (agents) or i (regions)
+std::vector<unsigned char> encodeElements(const unsigned char* data, std::size_t n, std::uint32_t es,
+                                          const std::vector<unsigned char>& parent, const SlotMap* map) {
+    const std::size_t pn = parent.size() / es;
+    std::vector<std::uint64_t> dirty(bitmapWords(n), 0);
+    std::uint64_t changed = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::size_t j = map ? map->toParent[i] : (i < pn ? i : kNoSlot);
+        if (j == kNoSlot || std::memcmp(data + i * es, parent.data() + j * es, es) != 0) {
+            dirty[i / 64] |= std::uint64_t{1} << (i % 64);
+            ++changed;
+        }
+    }
+    if (changed == 0 && n == pn && (!map || map->identity)) return {};
+
+    auto patch = makePatch(DeltaKind::Elements, es, n, dirty, changed);
+    unsigned char* out = patchValues(patch, dirty.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (testBit(dirty.data(), i)) {
+            std::memcpy(out, data + i * es, es);
+            out += es;
+        }
+    }
+    return patch;
+}
+
+// Survivors keep their order and newborns follow, so the ID column is a
+// survivor bitmap plus the appended IDs; anything else goes out whole
+std::vector<unsigned char> encodeIds(const unsigned char* data, std::size_t bytes,
+                                     const std::vector<unsigned char>& parent, const SlotMap& map) {
+    const std::size_t n = bytes / sizeof(std::uint32_t);
+    const std::size_t pn = parent.size() / sizeof(std::uint32_t);
+    if (map.identity) return {};
+
+    std::size_t kept = 0;
+    while (kept < n && map.toParent[kept] != kNoSlot) ++kept;
+    bool ordered = true;
+    for (std::size_t i = kept; i < n && ordered; ++i) ordered = map.toParent[i] == kNoSlot;
+    if (!ordered) return encodeWhole(data, bytes, sizeof(std::uint32_t), nullptr);
+
+    std::vector<std::uint64_t> survivors(bitmapWords(pn), 0);
+    for (std::size_t j = 0; j < pn; ++j) {
+        if (map.fromParent[j] != kNoSlot) survivors[j / 64] |= std::uint64_t{1} << (j % 64);
+    }
+    auto patch = makePatch(DeltaKind::Ids, sizeof(std::uint32_t), pn, survivors, n - kept);
+    if (n > kept) {
+        std::memcpy(patchValues(patch, survivors.size()), data + kept * sizeof(std::uint32_t), (n - kept) * sizeof(std::uint32_t));
+    }
+    return patch;
+}
+
+std::vector<std::size_t> rowOffsets(const std::vector<std::uint32_t>& degrees) {
+    std::vector<std::size_t> offsets(degrees.size() + 1, 0);
+    for (std::size_t r = 0; r < degrees.size(); ++r) offsets[r + 1] = offsets[r] + degrees[r];
+    return offsets;
+}
+
+std::vector<std::uint32_t> asWords(const std::vector<unsigned char>& bytes) {
+    std::vector<std::uint32_t> words(bytes.size() / sizeof(std::uint32_t));
+    if (!words.empty()) std::memcpy(words.data(), bytes.data(), words.size() * sizeof(std::uint32_t));
+    return words;
+}
+
+// Social graph rows: a row is clean when the same agent's parent row names
+// the same neighbours once both are translated to the new slots
+std::vector<unsigned char> encodeRows(const std::vector<std::uint32_t>& degrees, const std::uint32_t* targets,
+                                      const std::vector<std::uint32_t>& parentDegrees,
+                                      const std::vector<std::uint32_t>& parentTargets, const SlotMap& map) {
+    const std::size_t n = degrees.size();
+    const auto offsets = rowOffsets(degrees);
+    const auto parentOffsets = rowOffsets(parentDegrees);
+    std::vector<std::uint64_t> dirty(bitmapWords(n), 0);
+    std::uint64_t changed = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const std::uint32_t j = map.toParent[i];
+        bool clean = j != kNoSlot && j < parentDegrees.size() && parentDegrees[j] == degrees[i];
+        for (std::uint32_t k = 0; clean && k < degrees[i]; ++k) {
+            const std::uint32_t t = parentTargets[parentOffsets[j] + k];
+            clean = t < map.fromParent.size() && map.fromParent[t] == targets[offsets[i] + k];
+        }
+        if (!clean) {
+            dirty[i / 64] |= std::uint64_t{1} << (i % 64);
+            changed += degrees[i];
+        }
+    }
+    const bool anyDirty = std::any_of(dirty.begin(), dirty.end(), [](std::uint64_t w) { return w != 0; });
+    if (!anyDirty && map.identity) return {};
+
+    auto patch = makePatch(DeltaKind::Rows, sizeof(std::uint32_t), n, dirty, changed);
+    unsigned char* out = patchValues(patch, dirty.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (testBit(dirty.data(), i) && degrees[i]) {
+            std::memcpy(out, targets + offsets[i], degrees[i] * sizeof(std::uint32_t));
+            out += degrees[i] * sizeof(std::uint32_t);
+        }
+    }
+    return patch;
+}
+
+// Decoders rebuild `image` from its parent contents; `map` is the slot map
+// from the parent's ID column to the patched one
+struct PatchView {
+    DeltaHeader header;
+    const std::uint64_t* bitmap;
+    const unsigned char* values;
+};
+
+PatchView viewPatch(const std::vector<unsigned char>& patch, std::uint32_t tag) {
+    const auto bad = [&] { return std::runtime_error("malformed delta for section " + tagName(tag)); };
+    PatchView view{};
+    if (patch.size() < sizeof(DeltaHeader)) throw bad();
+    std::memcpy(&view.header, patch.data(), sizeof(DeltaHeader));
+    const auto kind = static_cast<DeltaKind>(view.header.kind);
+    if (view.header.kind > static_cast<std::uint32_t>(DeltaKind::Ids) || view.header.elem_size == 0) throw bad();
+    const std::size_t words = kind == DeltaKind::Whole ? 0 : bitmapWords(static_cast<std::size_t>(view.header.count));
+    const std::size_t valuesAt = sizeof(DeltaHeader) + words * sizeof(std::uint64_t);
+    if (patch.size() < valuesAt || (patch.size() - valuesAt) / view.header.elem_size < view.header.values) {
+        throw bad();
+    }
+    // The bitmap is 8-byte aligned inside the payload buffer
+    view.bitmap = reinterpret_cast<const std::uint64_t*>(patch.data() + sizeof(DeltaHeader));
+    view.values = patch.data() + valuesAt;
+    return view;
+}
+
+std::runtime_error parentMismatch(std::uint32_t tag) {
+    return std::runtime_error("delta does not match its parent in section " + tagName(tag));
+}
+
+void applyDelta(SectionImage& image, const std::vector<unsigned char>& patch, std::uint32_t tag,
+                const SlotMap& map) {
+    const PatchView view = viewPatch(patch, tag);
+    const DeltaHeader& dh = view.header;
+    const std::uint32_t es = dh.elem_size;
+    const auto count = static_cast<std::size_t>(dh.count);
+    std::vector<unsigned char> next;
+
+    switch (static_cast<DeltaKind>(dh.kind)) {
+    case DeltaKind::Whole:
+        next.assign(view.values, view.values + static_cast<std::size_t>(dh.values) * es);
+        break;
+    case DeltaKind::Elements: {
+        const bool agents = agentKeyed(tag);
+        const std::size_t pn = image.bytes.size() / es;
+        if (image.elem_size != es || (agents && map.toParent.size() != count)) throw parentMismatch(tag);
+        next.resize(count * es);
+        const unsigned char* value = view.values;
+        std::uint64_t used = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (testBit(view.bitmap, i)) {
+                if (++used > dh.values) throw parentMismatch(tag);
+                std::memcpy(next.data() + i * es, value, es);
+                value += es;
+                continue;
+            }
+            const std::size_t j = agents ? map.toParent[i] : i;
+            if (j == kNoSlot || j >= pn) throw parentMismatch(tag);
+            std::memcpy(next.data() + i * es, image.bytes.data() + j * es, es);
+        }
+        break;
+    }
+    case DeltaKind::Ids: {
+        const std::size_t pn = image.bytes.size() / sizeof(std::uint32_t);
+        if (es != sizeof(std::uint32_t) || count != pn) throw parentMismatch(tag);
+        for (std::size_t j = 0; j < pn; ++j) {
+            if (testBit(view.bitmap, j)) {
+                next.insert(next.end(), image.bytes.data() + j * es, image.bytes.data() + (j + 1) * es);
+            }
+        }
+        next.insert(next.end(), view.values, view.values + static_cast<std::size_t>(dh.values) * es);
+        break;
+    }
+    case DeltaKind::Rows:
+        throw std::logic_error("graph rows are applied with applyRows");
+    }
+    image.elem_size = es;
+    image.bytes = std::move(next);
+}
+
+void applyRows(SectionImage& image, const std::vector<unsigned char>& patch, std::uint32_t tag,
+               const std::vector<std::uint32_t>& degrees, const std::vector<std::uint32_t>& parentDegrees,
+               const SlotMap& map) {
+    const PatchView view = viewPatch(patch, tag);
+    if (static_cast<DeltaKind>(view.header.kind) != DeltaKind::Rows) {
+        applyDelta(image, patch, tag, map);
+        return;
+    }
+    const std::size_t n = degrees.size();
+    if (view.header.count != n || map.toParent.size() != n) throw parentMismatch(tag);
+    const auto parentTargets = asWords(image.bytes);
+    const auto parentOffsets = rowOffsets(parentDegrees);
+    if (parentOffsets.back() != parentTargets.size()) throw parentMismatch(tag);
+
+    std::vector<std::uint32_t> next;
+    next.reserve(rowOffsets(degrees).back());
+    const unsigned char* value = view.values;
+    const unsigned char* valuesEnd = view.values + static_cast<std::size_t>(view.header.values) * sizeof(std::uint32_t);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (testBit(view.bitmap, i)) {
+            const std::size_t bytes = degrees[i] * sizeof(std::uint32_t);
+            if (static_cast<std::size_t>(valuesEnd - value) < bytes) throw parentMismatch(tag);
+            const std::size_t at = next.size();
+            next.resize(at + degrees[i]);
+            if (bytes) std::memcpy(next.data() + at, value, bytes);
+            value += bytes;
+            continue;
+        }
+        const std::uint32_t j = map.toParent[i];
+        if (j == kNoSlot || j >= parentDegrees.size() || parentDegrees[j] != degrees[i]) throw parentMismatch(tag);
+        for (std::size_t k = parentOffsets[j]; k < parentOffsets[j + 1]; ++k) {
+            const std::uint32_t t = parentTargets[k];
+            if (t >= map.fromParent.size() || map.fromParent[t] == kNoSlot) throw parentMismatch(tag);
+            next.push_back(map.fromParent[t]);
+        }
+    }
+    image.elem_size = sizeof(std::uint32_t);
+    image.bytes.resize(next.size() * sizeof(std::uint32_t));
+    if (!next.empty()) std::memcpy(image.bytes.data(), next.data(), image.bytes.size());
+}
+
+// Full save and load without the console report; both throw on failure
+CheckpointHeader writeCheckpoint(const Kernel& kernel, const std::string& filepath,
+                                 const CheckpointOptions& options) {
+    CheckpointAccess::Staging staging;
+    auto sections = CheckpointAccess::gather(kernel, staging);
+    const LinkRecord link{makeCheckpointId(kernel.generation()), 0};
+    sections.push_back({kLinkTag, sizeof(LinkRecord), &link, sizeof(link)});
+
+    const CheckpointHeader header = makeHeader(kernel, 0);
+    writeContainer(filepath, header, sections, options);
+    return header;
+}
+
+CheckpointHeader readCheckpoint(Kernel& kernel, const std::string& filepath) {
+    MappedFile file(filepath);
+    const SectionReader reader(file);
+    if (reader.delta()) {
+        throw std::runtime_error("delta checkpoint needs its base (use loadCheckpointChain)");
+    }
+    const CheckpointHeader header = reader.header();
+
+    CheckpointAccess::Restored in;
+    decodeState(reader, header.num_agents, header.num_regions, in);
+    CheckpointAccess::restore(kernel, in);
+    return header;
+}
+
+}  // namespace
+
+bool saveCheckpoint(const Kernel& kernel, const std::string& filepath, const CheckpointOptions& options) {
+    if (options.compress && !compressionAvailable()) {
+        std::cerr << "Checkpoint compression requested but this build has no zlib" << std::endl;
         return false;
     }
-    
+
     try {
-        // Get current timestamp
-        auto now = std::chrono::system_clock::now();
-        auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
-            now.time_since_epoch()).count();
-        
-        // Write header
-        CheckpointHeader header;
-        header.generation = kernel.generation();
-        header.num_agents = static_cast<std::uint32_t>(kernel.agents().size());
-        header.num_regions = static_cast<std::uint32_t>(kernel.regionIndex().size());
-        header.timestamp = static_cast<std::uint64_t>(timestamp);
-        
-        writeBinary(out, header);
-        
-        // Write agents
-        for (const auto& agent : kernel.agents()) {
-            writeAgent(out, agent);
-        }
-        
-        // Write region index
-        for (const auto& region : kernel.regionIndex()) {
-            writeBinaryVector(out, region);
-        }
-        
-        // Write economy state (simplified - just regional data)
-        const auto& economy = kernel.economy();
-        for (std::uint32_t r = 0; r < header.num_regions; ++r) {
-            const auto& region = economy.getRegion(r);
-            writeBinary(out, region.development);
-            writeBinary(out, region.welfare);
-            writeBinary(out, region.inequality);
-            writeBinary(out, region.hardship);
-            writeBinary(out, region.efficiency);
-            writeBinary(out, region.system_stability);
-            writeBinaryString(out, region.economic_system);
-            writeBinaryArray(out, region.production);
-            writeBinaryArray(out, region.prices);
-        }
-        
-        // Write agent economy data
-        for (std::uint32_t i = 0; i < header.num_agents; ++i) {
-            const auto& agent_econ = economy.getAgentEconomy(i);
-            writeBinary(out, agent_econ.wealth);
-            writeBinary(out, agent_econ.income);
-            writeBinary(out, agent_econ.productivity);
-            writeBinary(out, agent_econ.sector);
-            writeBinary(out, agent_econ.hardship);
-        }
-        
-        out.close();
-        std::cout << "Checkpoint saved: " << filepath 
-                  << " (gen " << header.generation 
+        const CheckpointHeader header = writeCheckpoint(kernel, filepath, options);
+        std::cout << "Checkpoint saved: " << filepath
+                  << " (gen " << header.generation
                   << ", " << header.num_agents << " agents)" << std::endl;
         return true;
-        
+
     } catch (const std::exception& e) {
         std::cerr << "Error saving checkpoint: " << e.what() << std::endl;
         return false;
@@ -156,59 +1489,473 @@ bool saveCheckpoint(const Kernel& kernel, const std::string& filepath) {
 }
 
 bool loadCheckpoint(Kernel& kernel, const std::string& filepath) {
-    std::ifstream in(filepath, std::ios::binary);
-    if (!in.is_open()) {
-        std::cerr << "Failed to open checkpoint file for reading: " << filepath << std::endl;
+    try {
+        const CheckpointHeader header = readCheckpoint(kernel, filepath);
+        std::cout << "Checkpoint loaded: " << filepath
+                  << " (gen " << header.generation
+                  << ", " << header.num_agents << " agents)" << std::endl;
+        return true;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading checkpoint " << filepath << ": " << e.what() << std::endl;
         return false;
     }
-    
+}
+
+// ---------- Delta checkpoints ----------
+
+// Section bytes of one save: the parent of the next delta
+struct DeltaCheckpointer::History {
+    ImageMap sections;
+};
+
+// A save copied out of the kernel; diffing and writing it needs no kernel
+struct DeltaCheckpointer::Capture {
+    std::unique_ptr<History> state;
+    std::vector<std::uint32_t> tags;  // In gather order
+    CheckpointHeader header;
+    LinkRecord link{};
+    std::uint32_t regions = 0;
+    bool base = false;
+};
+
+DeltaCheckpointer::DeltaCheckpointer(std::uint32_t baseInterval, const CheckpointOptions& options)
+    : base_interval_(std::max<std::uint32_t>(1, baseInterval)), options_(options),
+      history_(std::make_unique<History>()) {}
+
+DeltaCheckpointer::~DeltaCheckpointer() = default;
+
+std::unique_ptr<DeltaCheckpointer::Capture> DeltaCheckpointer::capture(const Kernel& kernel) {
+    CheckpointAccess::Staging staging;
+    const auto sections = CheckpointAccess::gather(kernel, staging);
+
+    auto c = std::make_unique<Capture>();
+    c->regions = kernel.config().regions;
+    c->base = parent_id_ == 0 || since_base_ + 1 >= base_interval_ || c->regions != regions_;
+    c->header = makeHeader(kernel, c->base ? 0 : kDeltaCheckpoint);
+    c->link = LinkRecord{makeCheckpointId(kernel.generation()), c->base ? 0 : parent_id_};
+
+    // Copy into the buffers of the save before last, so steady saves do not allocate
+    c->state = spare_ ? std::move(spare_) : std::make_unique<History>();
+    ImageMap& images = c->state->sections;
+    for (const auto& section : sections) {
+        const auto* bytes = static_cast<const unsigned char*>(section.data);
+        SectionImage& image = images[section.tag];
+        image.elem_size = section.elem_size;
+        image.bytes.assign(bytes, bytes + section.bytes);
+        c->tags.push_back(section.tag);
+    }
+    for (auto it = images.begin(); it != images.end();) {
+        const bool current = std::find(c->tags.begin(), c->tags.end(), it->first) != c->tags.end();
+        it = current ? std::next(it) : images.erase(it);
+    }
+    return c;
+}
+
+std::uint64_t DeltaCheckpointer::write(const Capture& c, const std::string& filepath, bool parallel) const {
+    const ImageMap& images = c.state->sections;
+    std::vector<CheckpointAccess::OutSection> sections;
+    for (const auto tag : c.tags) {
+        const SectionImage& image = images.at(tag);
+        sections.push_back({tag, image.elem_size, image.bytes.data(), image.bytes.size()});
+    }
+
+    std::vector<std::vector<unsigned char>> patches(sections.size());
+    if (!c.base) {
+        const ImageMap& prev = history_->sections;
+        const auto parentOf = [&](std::uint32_t tag) -> const SectionImage* {
+            const auto it = prev.find(tag);
+            return it == prev.end() ? nullptr : &it->second;
+        };
+        static const std::vector<unsigned char> none;
+        const SectionImage* prevIds = parentOf(kIdTag);
+        const SlotMap map = matchSlots(prevIds ? prevIds->bytes : none, images.at(kIdTag).bytes);
+        const SectionImage* prevDegrees = parentOf(kGraphDegreeTag);
+        const auto parentDegrees = asWords(prevDegrees ? prevDegrees->bytes : none);
+        const auto degrees = asWords(images.at(kGraphDegreeTag).bytes);
+        // One element per agent in both saves (the activity schedule may be off in either)
+        const auto perAgent = [&map](const CheckpointAccess::OutSection& section, const SectionImage& parent) {
+            return section.bytes / section.elem_size == map.toParent.size() &&
+                   parent.bytes.size() / section.elem_size == map.fromParent.size();
+        };
+
+        const auto encode = [&](std::size_t s) {
+            const auto& section = sections[s];
+            const auto* data = static_cast<const unsigned char*>(section.data);
+            const SectionImage* parent = parentOf(section.tag);
+            if (!parent || parent->elem_size != section.elem_size) {
+                patches[s] = encodeWhole(data, section.bytes, section.elem_size, nullptr);
+            } else if (section.tag == kIdTag) {
+                patches[s] = encodeIds(data, section.bytes, parent->bytes, map);
+            } else if (section.tag == kGraphTargetTag) {
+                patches[s] = encodeRows(degrees, static_cast<const std::uint32_t*>(section.data),
+                                        parentDegrees, asWords(parent->bytes), map);
+            } else if ((agentKeyed(section.tag) && perAgent(section, *parent)) || regionKeyed(section.tag)) {
+                patches[s] = encodeElements(data, section.bytes / section.elem_size, section.elem_size,
+                                            parent->bytes, agentKeyed(section.tag) ? &map : nullptr);
+            } else {
+                patches[s] = encodeWhole(data, section.bytes, section.elem_size, &parent->bytes);
+            }
+        };
+        if (parallel) {
+            parallelFor(sections.size(), encode);
+        } else {
+            for (std::size_t s = 0; s < sections.size(); ++s) encode(s);
+        }
+    }
+
+    std::vector<CheckpointAccess::OutSection> out;
+    if (c.base) {
+        out = sections;
+    } else {
+        for (std::size_t s = 0; s < sections.size(); ++s) {
+            if (!patches[s].empty()) {  // Sections identical to the parent are left out
+                out.push_back({sections[s].tag, 1, patches[s].data(), patches[s].size()});
+            }
+        }
+    }
+    out.push_back({kLinkTag, sizeof(LinkRecord), &c.link, sizeof(LinkRecord)});
+    return writeContainer(filepath, c.header, out, options_, parallel);
+}
+
+void DeltaCheckpointer::commit(std::unique_ptr<Capture> c, std::uint64_t bytes) {
+    // The new parent replaces the old one only once its file is safely written
+    spare_ = std::move(history_);
+    history_ = std::move(c->state);
+    parent_id_ = c->link.id;
+    regions_ = c->regions;
+    since_base_ = c->base ? 0 : since_base_ + 1;
+    last_was_base_ = c->base;
+    last_bytes_ = bytes;
+}
+
+bool DeltaCheckpointer::save(const Kernel& kernel, const std::string& filepath) {
+    if (options_.compress && !compressionAvailable()) {
+        std::cerr << "Checkpoint compression requested but this build has no zlib" << std::endl;
+        return false;
+    }
+
     try {
-        // Read and validate header
+        auto c = capture(kernel);
+        const std::uint64_t bytes = write(*c, filepath, true);
+        commit(std::move(c), bytes);
+        return true;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error saving checkpoint: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool loadCheckpointChain(Kernel& kernel, const std::vector<std::string>& filepaths) {
+    if (filepaths.empty()) {
+        std::cerr << "Error loading checkpoint chain: no files given" << std::endl;
+        return false;
+    }
+    std::string current = filepaths.front();
+    try {
+        ImageMap images;
         CheckpointHeader header;
-        readBinary(in, header);
-        
-        if (header.magic != CHECKPOINT_MAGIC) {
-            std::cerr << "Invalid checkpoint file (bad magic number)" << std::endl;
-            return false;
-        }
-        
-        if (header.version != CHECKPOINT_VERSION) {
-            std::cerr << "Checkpoint version mismatch (expected " << CHECKPOINT_VERSION 
-                      << ", got " << header.version << ")" << std::endl;
-            return false;
-        }
-        
-        // Read agents
-        std::vector<Agent> agents(header.num_agents);
-        for (auto& agent : agents) {
-            readAgent(in, agent);
-        }
-        
-        // Read region index
-        std::vector<std::vector<std::uint32_t>> regionIndex(header.num_regions);
-        for (auto& region : regionIndex) {
-            readBinaryVector(in, region);
-        }
-        
-        // For now, we only restore agent state - economy needs more work
-        // This is a partial restore that works for continued simulation
-        
-        // Note: Full restore would require Economy class to have load/save methods
-        // For now, log a warning
-        std::cout << "Checkpoint loaded: " << filepath 
-                  << " (gen " << header.generation 
+        std::uint64_t id = 0;
+        for (std::size_t f = 0; f < filepaths.size(); ++f) {
+            current = filepaths[f];
+            MappedFile file(current);
+            const SectionReader reader(file);
+            const LinkRecord link = reader.link();
+            if (f == 0 && reader.delta()) {
+                throw std::runtime_error("chain must start with a base checkpoint");
+            }
+            if (f > 0 && (!reader.delta() || id == 0 || link.parent != id)) {
+                throw std::runtime_error("not the next delta of this chain");
+            }
+            header = reader.header();
+            id = link.id;
+
+            std::vector<std::uint32_t> tags;
+            std::vector<SectionImage> decoded;
+            for (const auto& [tag, entry] : reader.entries()) {
+                if (tag == kLinkTag) continue;
+                tags.push_back(tag);
+                decoded.push_back(SectionImage{entry.elem_size, {}});
+                decoded.back().bytes.resize(static_cast<std::size_t>(entry.raw_size));
+            }
+            parallelFor(tags.size(), [&](std::size_t s) { reader.decode(tags[s], decoded[s].bytes.data()); });
+
+            if (f == 0) {
+                for (std::size_t s = 0; s < tags.size(); ++s) {
+                    images[tags[s]] = std::move(decoded[s]);
+                }
+                continue;
+            }
+
+            // IDs first: the slot map between the two saves follows from them
+            const std::vector<unsigned char> parentIds = images[kIdTag].bytes;
+            const auto parentDegrees = asWords(images[kGraphDegreeTag].bytes);
+            std::vector<std::size_t> rest;
+            std::size_t graphTargets = tags.size();
+            for (std::size_t s = 0; s < tags.size(); ++s) {
+                if (tags[s] == kIdTag) {
+                    applyDelta(images[kIdTag], decoded[s].bytes, kIdTag, SlotMap{});
+                } else if (tags[s] == kGraphTargetTag) {
+                    graphTargets = s;
+                } else {
+                    rest.push_back(s);
+                }
+            }
+            const SlotMap map = matchSlots(parentIds, images[kIdTag].bytes);
+
+            std::vector<SectionImage*> targets;
+            for (std::size_t s : rest) targets.push_back(&images[tags[s]]);
+            parallelFor(rest.size(), [&](std::size_t r) {
+                applyDelta(*targets[r], decoded[rest[r]].bytes, tags[rest[r]], map);
+            });
+            // Graph rows last: they need both saves' degrees
+            if (graphTargets < tags.size()) {
+                applyRows(images[kGraphTargetTag], decoded[graphTargets].bytes, kGraphTargetTag,
+                          asWords(images[kGraphDegreeTag].bytes), parentDegrees, map);
+            }
+        }
+
+        CheckpointAccess::Restored in;
+        decodeState(ImageSource(images), header.num_agents, header.num_regions, in);
+        CheckpointAccess::restore(kernel, in);
+        std::cout << "Checkpoint chain loaded: " << filepaths.size() << " files"
+                  << " (gen " << header.generation
                   << ", " << header.num_agents << " agents)" << std::endl;
-        std::cout << "Warning: Economy state restore not fully implemented" << std::endl;
-        
-        // TODO: Implement full restore via Kernel method
-        // kernel.restoreFromCheckpoint(header, agents, regionIndex, ...);
-        
         return true;
-        
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading checkpoint " << current << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+// ---------- Background checkpoints ----------
+
+// A consistent copy of one save, owned by the worker while it writes and
+// kept afterwards so the next capture reuses its buffers
+struct AsyncCheckpointer::Job {
+    CheckpointAccess::Staging staging;
+    std::unique_ptr<unsigned char[]> columns;  // Copies of the kernel-owned sections
+    std::size_t capacity = 0;
+    std::vector<CheckpointAccess::OutSection> sections;
+    LinkRecord link{};
+    CheckpointHeader header;
+};
+
+namespace {
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+AsyncCheckpointer::AsyncCheckpointer(const CheckpointOptions& options) : options_(options) {}
+
+AsyncCheckpointer::~AsyncCheckpointer() {
+    wait();
+}
+
+void AsyncCheckpointer::wait() {
+    if (worker_.joinable()) worker_.join();
+}
+
+namespace {
+
+// A save that failed before reaching the worker
+std::future<CheckpointResult> rejected(CheckpointResult result, const AsyncCheckpointer::Callback& onDone) {
+    std::cerr << "Checkpoint " << result.error << std::endl;
+    if (onDone) onDone(result);
+    std::promise<CheckpointResult> promise;
+    promise.set_value(result);
+    return promise.get_future();
+}
+
+}  // namespace
+
+template <typename Write, typename Finish>
+std::future<CheckpointResult> AsyncCheckpointer::launch(CheckpointResult result, Write write, Finish finish,
+                                                        Callback onDone) {
+    std::promise<CheckpointResult> promise;
+    auto future = promise.get_future();
+    in_flight_ = true;
+    worker_ = std::thread([result, write = std::move(write), finish = std::move(finish),
+                           onDone = std::move(onDone), promise = std::move(promise), this]() mutable {
+        const auto writeStart = std::chrono::steady_clock::now();
+        const std::string temp = result.path + ".tmp";
+        try {
+            result.bytes = write(temp);
+            syncFile(temp);
+            std::filesystem::rename(temp, result.path);
+            result.ok = true;
+        } catch (const std::exception& e) {
+            result.error = e.what();
+            std::remove(temp.c_str());
+            std::cerr << "Error saving checkpoint: " << e.what() << std::endl;
+        }
+        finish(result);
+        result.writeMs = msSince(writeStart);
+        if (onDone) onDone(result);
+        in_flight_ = false;
+        promise.set_value(result);
+    });
+    return future;
+}
+
+std::future<CheckpointResult> AsyncCheckpointer::save(const Kernel& kernel, const std::string& filepath,
+                                                      Callback onDone) {
+    wait();
+    CheckpointResult result;
+    result.path = filepath;
+    result.generation = kernel.generation();
+    if (options_.compress && !compressionAvailable()) {
+        result.error = "compression requested but this build has no zlib";
+        return rejected(result, onDone);
+    }
+
+    const auto captureStart = std::chrono::steady_clock::now();
+    auto job = spare_ ? std::move(spare_) : std::make_unique<Job>();
+    job->sections = CheckpointAccess::gather(kernel, job->staging);
+    job->link = LinkRecord{makeCheckpointId(kernel.generation()), 0};
+    job->sections.push_back({kLinkTag, sizeof(LinkRecord), &job->link, sizeof(LinkRecord)});
+    job->header = makeHeader(kernel, 0);
+
+    // Staged sections are already private; copy the rest out of the kernel
+    const auto staged = CheckpointAccess::stagedBuffers(job->staging);
+    const auto owned = [&](const CheckpointAccess::OutSection& section) {
+        return section.data == &job->link ||
+               std::find(staged.begin(), staged.end(), section.data) != staged.end();
+    };
+    const auto padded = [](std::size_t bytes) { return (bytes + 63) / 64 * 64; };
+    std::size_t total = 0;
+    for (const auto& section : job->sections) {
+        if (!owned(section)) total += padded(section.bytes);
+    }
+    if (job->capacity < total) {
+        job->columns.reset(new unsigned char[total]);
+        job->capacity = total;
+    }
+    std::size_t offset = 0;
+    for (auto& section : job->sections) {
+        if (owned(section)) continue;
+        if (section.bytes > 0) std::memcpy(job->columns.get() + offset, section.data, section.bytes);
+        section.data = job->columns.get() + offset;
+        offset += padded(section.bytes);
+    }
+    result.captureMs = msSince(captureStart);
+
+    const Job* copy = job.get();
+    return launch(
+        result,
+        [this, copy](const std::string& temp) {
+            return writeContainer(temp, copy->header, copy->sections, options_, false);
+        },
+        // save() joins the worker before touching spare_
+        [this, job = std::move(job)](const CheckpointResult&) mutable { spare_ = std::move(job); },
+        std::move(onDone));
+}
+
+std::future<CheckpointResult> AsyncCheckpointer::save(const Kernel& kernel, const std::string& filepath,
+                                                      DeltaCheckpointer& chain, Callback onDone) {
+    wait();
+    CheckpointResult result;
+    result.path = filepath;
+    result.generation = kernel.generation();
+    if (chain.options_.compress && !compressionAvailable()) {
+        result.error = "compression requested but this build has no zlib";
+        return rejected(result, onDone);
+    }
+
+    const auto captureStart = std::chrono::steady_clock::now();
+    std::unique_ptr<DeltaCheckpointer::Capture> capture;
+    try {
+        capture = chain.capture(kernel);
+    } catch (const std::exception& e) {
+        result.error = e.what();
+        return rejected(result, onDone);
+    }
+    result.captureMs = msSince(captureStart);
+
+    // The diff reads the chain's previous save, which stays put until commit()
+    const DeltaCheckpointer::Capture* copy = capture.get();
+    return launch(
+        result,
+        [&chain, copy](const std::string& temp) { return chain.write(*copy, temp, false); },
+        [&chain, capture = std::move(capture)](const CheckpointResult& done) mutable {
+            if (done.ok) chain.commit(std::move(capture), done.bytes);
+        },
+        std::move(onDone));
+}
+
+// ---------- Init images ----------
+
+std::uint64_t initImageKey(const KernelConfig& cfg) {
+    const std::string identity = CheckpointAccess::encodeConfig(cfg) +
+                                 "checkpointVersion " + std::to_string(CHECKPOINT_VERSION) + '\n' +
+                                 "initImageVersion " + std::to_string(kInitImageVersion) + '\n' +
+                                 "precision " + precision::kName + '\n';
+    return checksum(identity.data(), identity.size());
+}
+
+InitImageCache::InitImageCache(std::string directory) : directory_(std::move(directory)) {}
+
+std::string InitImageCache::pathFor(const KernelConfig& cfg) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "init-%016llx.ckpt", static_cast<unsigned long long>(initImageKey(cfg)));
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+std::unique_ptr<Kernel> InitImageCache::load(const KernelConfig& cfg) {
+    const std::string path = pathFor(cfg);
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        try {
+            auto kernel = CheckpointAccess::unbuilt(cfg);
+            const CheckpointHeader header = readCheckpoint(*kernel, path);
+            // The key is a hash: confirm the image really is this config's world
+            if (header.generation != 0 ||
+                CheckpointAccess::encodeConfig(kernel->config()) != CheckpointAccess::encodeConfig(cfg)) {
+                throw std::runtime_error("image belongs to another config");
+            }
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return kernel;
+        } catch (const std::exception& e) {
+            std::cerr << "Ignoring init image " << path << ": " << e.what() << std::endl;
+        }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+bool InitImageCache::store(const Kernel& kernel) {
+    if (kernel.generation() != 0) {
+        throw std::invalid_argument("init images hold generation 0 (got " +
+                                    std::to_string(kernel.generation()) + ")");
+    }
+    const std::string path = pathFor(kernel.config());
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%016llx.tmp",
+                  static_cast<unsigned long long>(makeCheckpointId(0)));
+    const std::string temp = path + suffix;
+    try {
+        std::filesystem::create_directories(directory_);
+        writeCheckpoint(kernel, temp, {});
+        std::filesystem::rename(temp, path);
+        return true;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading checkpoint: " << e.what() << std::endl;
+        std::remove(temp.c_str());
+        std::cerr << "Error saving init image " << path << ": " << e.what() << std::endl;
         return false;
     }
 }
 
+std::unique_ptr<Kernel> InitImageCache::make(const KernelConfig& cfg,
+                                             std::shared_ptr<const KernelGeography> geography) {
+    if (auto kernel = load(cfg)) return kernel;
+    auto kernel = std::make_unique<Kernel>(cfg, std::move(geography));
+    store(*kernel);
+    return kernel;
+}
+
 }  // namespace serialization
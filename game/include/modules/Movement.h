@@ -3,7 +3,7 @@
 
 #include <array>
 #include <vector>
-#include <map>
+#include <utility>
 #include <string>
 #include <cstdint>
 
@@ -31,12 +31,16 @@ struct Movement {
     // Platform (mean beliefs of members)
     std::array<double, 4> platform{0, 0, 0, 0};
     
-    // Membership
+    // Membership (stable agent IDs; resolve with AgentStore::slotOf)
     std::vector<std::uint32_t> members;
     std::vector<std::uint32_t> leaders;  // High-assertiveness agents
+    // Slot of each member at the last update (parallel to `members`); rechecked
+    // by ID and re-resolved only for agents compaction has moved
+    std::vector<std::uint32_t> memberSlots;
     
-    // Geographic presence
-    std::map<std::uint32_t, double> regionalStrength;  // region -> proportion
+    // Geographic presence: (region, proportion) sorted by region, occupied regions only
+    std::vector<std::pair<std::uint32_t, double>> regionalStrength;
+    double strengthIn(std::uint32_t region) const;
     
     // Power metrics
     double power = 0.0;              // Overall power (0-1)
@@ -45,7 +49,7 @@ struct Movement {
     double institutionalAccess = 0.0; // Future: captured institutions
     
     // Economic base
-    std::map<int, double> classComposition;  // wealth decile -> proportion
+    std::array<double, 10> classComposition{};  // wealth decile -> proportion
     
     // Dynamics
     double coherence = 0.0;          // Internal belief alignment
@@ -103,6 +107,20 @@ private:
     std::vector<Movement> movements_;
     std::uint32_t nextId_ = 0;
     
+    // Shared by every movement in one update(), built once per call
+    struct Analytics {
+        std::array<double, 9> decileFloors{};  // Global wealth decile cut points
+        std::uint32_t regions = 0;
+    };
+    Analytics analytics_;
+    void buildAnalytics(const Kernel& kernel);
+    
+    // Per-thread scratch: dense region histogram plus the regions it touched
+    struct Scratch {
+        std::vector<std::uint32_t> regionCounts;
+        std::vector<std::uint32_t> touched;
+    };
+    
     // Formation logic
     void detectFormations(Kernel& kernel, const std::vector<Cluster>& clusters, std::uint64_t tick);
     bool shouldFormMovement(const Cluster& cluster, const Kernel& kernel) const;
@@ -110,12 +128,13 @@ private:
     
     // Update logic
     void updateExistingMovements(Kernel& kernel, std::uint64_t tick);
-    void updateMembership(Movement& mov, const Kernel& kernel);
-    void updatePowerMetrics(Movement& mov, const Kernel& kernel);
-    void updateStage(Movement& mov);
+    void pruneDepartedMembers(Movement& mov, const Kernel& kernel) const;  // Drop dead/compacted agents
+    void updateMembership(Movement& mov, const Kernel& kernel, Scratch& scratch) const;
+    void updatePowerMetrics(Movement& mov, const Kernel& kernel) const;
+    void updateStage(Movement& mov) const;
     void pruneDeadMovements();
     
-    // Leaders
+    // Leaders (takes agent slots, returns stable IDs)
     std::vector<std::uint32_t> identifyLeaders(const std::vector<std::uint32_t>& members,
                                                 const Kernel& kernel,
                                                 std::uint32_t topN = 5) const;
@@ -4,17 +4,50 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
-#include <set>
+
+namespace {
+    // Resolve stable agent IDs to current slots, skipping agents that are gone
+    std::vector<std::uint32_t> resolveSlots(const std::vector<std::uint32_t>& ids,
+                                            const AgentStore& agents) {
+        std::vector<std::uint32_t> slots;
+        slots.reserve(ids.size());
+        for (auto agentId : ids) {
+            const std::uint32_t slot = agents.slotOf(agentId);
+            if (slot != AgentStore::kNoSlot) {
+                slots.push_back(slot);
+            }
+        }
+        return slots;
+    }
+    
+    // Wealth decile by comparison against the shared cut points
+    int decileOf(const std::array<double, 9>& floors, double wealth) {
+        return static_cast<int>(std::upper_bound(floors.begin(), floors.end(), wealth) - floors.begin());
+    }
+}
+
+double Movement::strengthIn(std::uint32_t region) const {
+    auto it = std::lower_bound(regionalStrength.begin(), regionalStrength.end(), region,
+                               [](const auto& entry, std::uint32_t r) { return entry.first < r; });
+    return (it != regionalStrength.end() && it->first == region) ? it->second : 0.0;
+}
 
 MovementModule::MovementModule(const MovementFormationConfig& cfg) : cfg_(cfg) {}
 
 // Main update: detect new formations, update existing movements
 void MovementModule::update(Kernel& kernel, const std::vector<Cluster>& clusters, std::uint64_t tick) {
+    buildAnalytics(kernel);
     detectFormations(kernel, clusters, tick);
     updateExistingMovements(kernel, tick);
     pruneDeadMovements();
 }
 
+void MovementModule::buildAnalytics(const Kernel& kernel) {
+    // One O(buckets) walk replaces a rank lookup per member per movement
+    analytics_.decileFloors = kernel.economy().wealthDistribution().decileFloors();
+    analytics_.regions = static_cast<std::uint32_t>(kernel.regionIndex().size());
+}
+
 // Formation detection from clusters
 void MovementModule::detectFormations(Kernel& kernel, const std::vector<Cluster>& clusters, std::uint64_t tick) {
     // Capacity check: prevent unbounded movement growth
@@ -83,8 +116,16 @@ Movement MovementModule::createMovement(const Cluster& cluster, const Kernel& ke
     // Platform = cluster centroid
     mov.platform = cluster.centroid;
     
-    // Members
-    mov.members = cluster.members;
+    // Members: cluster rosters are slots for this tick; movements persist, so keep stable IDs
+    const auto& agents = kernel.agents();
+    mov.members.reserve(cluster.members.size());
+    mov.memberSlots.reserve(cluster.members.size());
+    for (auto slot : cluster.members) {
+        if (slot < agents.size() && agents.alive[slot]) {
+            mov.members.push_back(agents.id[slot]);
+            mov.memberSlots.push_back(slot);
+        }
+    }
     
     // Identify leaders
     mov.leaders = identifyLeaders(cluster.members, kernel, 5);
@@ -93,125 +134,154 @@ Movement MovementModule::createMovement(const Cluster& cluster, const Kernel& ke
     mov.coherence = cluster.coherence;
     
     // Initial metrics
-    updateMembership(mov, kernel);
+    Scratch scratch;
+    updateMembership(mov, kernel, scratch);
     updatePowerMetrics(mov, kernel);
     
     return mov;
 }
 
-// Update existing movements
+// Update existing movements: each touches only its own record, so they run in parallel
 void MovementModule::updateExistingMovements(Kernel& kernel, std::uint64_t tick) {
-    for (auto& mov : movements_) {
-        if (mov.stage == MovementStage::Dead) continue;
-        
-        updateMembership(mov, kernel);
-        updatePowerMetrics(mov, kernel);
-        updateStage(mov);
-        
-        mov.lastUpdateTick = tick;
+    const Kernel& view = kernel;
+    #pragma omp parallel
+    {
+        Scratch scratch;
+        #pragma omp for schedule(dynamic)
+        for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(movements_.size()); ++i) {
+            auto& mov = movements_[i];
+            if (mov.stage == MovementStage::Dead) continue;
+            
+            pruneDepartedMembers(mov, view);
+            updateMembership(mov, view, scratch);
+            updatePowerMetrics(mov, view);
+            updateStage(mov);
+            
+            mov.lastUpdateTick = tick;
+        }
     }
 }
 
-void MovementModule::updateMembership(Movement& mov, const Kernel& kernel) {
+void MovementModule::pruneDepartedMembers(Movement& mov, const Kernel& kernel) const {
     const auto& agents = kernel.agents();
+    // Cached slots hold until compaction moves an agent; only those are looked up again
+    mov.memberSlots.resize(mov.members.size(), AgentStore::kNoSlot);
+    std::size_t kept = 0;
+    for (std::size_t m = 0; m < mov.members.size(); ++m) {
+        const std::uint32_t agentId = mov.members[m];
+        std::uint32_t slot = mov.memberSlots[m];
+        if (slot >= agents.size() || agents.id[slot] != agentId) {
+            slot = agents.slotOf(agentId);
+        }
+        if (slot == AgentStore::kNoSlot || !agents.alive[slot]) continue;
+        mov.members[kept] = agentId;
+        mov.memberSlots[kept] = slot;
+        ++kept;
+    }
+    mov.members.resize(kept);
+    mov.memberSlots.resize(kept);
+    
+    auto departed = [&agents](std::uint32_t agentId) {
+        const std::uint32_t slot = agents.slotOf(agentId);
+        return slot == AgentStore::kNoSlot || !agents.alive[slot];
+    };
+    mov.leaders.erase(std::remove_if(mov.leaders.begin(), mov.leaders.end(), departed),
+                      mov.leaders.end());
+}
+
+void MovementModule::updateMembership(Movement& mov, const Kernel& kernel, Scratch& scratch) const {
+    const auto& agents = kernel.agents();
+    const auto& slots = mov.memberSlots;
     
     // Recompute platform as mean of current members
     std::array<double, 4> newPlatform{0, 0, 0, 0};
-    for (auto agentId : mov.members) {
-        const auto& agent = agents[agentId];
+    for (auto slot : slots) {
+        const auto& B = agents.B[slot];
         for (int d = 0; d < 4; ++d) {
-            newPlatform[d] += agent.B[d];
+            newPlatform[d] += B[d];
         }
     }
-    if (!mov.members.empty()) {
+    if (!slots.empty()) {
         for (int d = 0; d < 4; ++d) {
-            newPlatform[d] /= mov.members.size();
+            newPlatform[d] /= slots.size();
         }
     }
     mov.platform = newPlatform;
     
     // Recompute coherence (variance in belief space)
     double variance = 0.0;
-    for (auto agentId : mov.members) {
-        const auto& agent = agents[agentId];
+    for (auto slot : slots) {
+        const auto& B = agents.B[slot];
         double dist = 0.0;
         for (int d = 0; d < 4; ++d) {
-            double diff = agent.B[d] - mov.platform[d];
+            double diff = B[d] - mov.platform[d];
             dist += diff * diff;
         }
         variance += std::sqrt(dist);
     }
-    if (!mov.members.empty()) {
-        variance /= mov.members.size();
+    if (!slots.empty()) {
+        variance /= slots.size();
     }
     mov.coherence = std::max(0.0, 1.0 - variance);
     
-    // Regional strength
-    mov.regionalStrength.clear();
-    const auto& regionIndex = kernel.regionIndex();
-    for (std::uint32_t r = 0; r < regionIndex.size(); ++r) {
-        int count = 0;
-        for (auto agentId : mov.members) {
-            if (agents[agentId].region == r) {
-                count++;
-            }
-        }
-        if (count > 0) {
-            mov.regionalStrength[r] = static_cast<double>(count) / mov.members.size();
+    // Regional strength: one pass into a dense histogram, then read back the
+    // touched regions (and clear only those)
+    scratch.regionCounts.resize(analytics_.regions, 0);
+    scratch.touched.clear();
+    for (auto slot : slots) {
+        const std::uint32_t r = agents.region[slot];
+        if (r >= analytics_.regions) continue;
+        if (scratch.regionCounts[r]++ == 0) {
+            scratch.touched.push_back(r);
         }
     }
-    
-    // Class composition (wealth deciles)
-    mov.classComposition.clear();
-    const auto& economy = kernel.economy();
-    const auto& ecoAgents = economy.agents();
-    
-    // Collect all agent wealths for proper decile calculation
-    std::vector<double> all_wealths;
-    all_wealths.reserve(ecoAgents.size());
-    for (const auto& ae : ecoAgents) {
-        all_wealths.push_back(ae.wealth);
+    std::sort(scratch.touched.begin(), scratch.touched.end());
+    mov.regionalStrength.clear();
+    mov.regionalStrength.reserve(scratch.touched.size());
+    for (auto r : scratch.touched) {
+        mov.regionalStrength.emplace_back(r, static_cast<double>(scratch.regionCounts[r]) / slots.size());
+        scratch.regionCounts[r] = 0;
     }
-    std::sort(all_wealths.begin(), all_wealths.end());
     
-    // Calculate deciles for movement members based on global wealth distribution
-    for (auto agentId : mov.members) {
-        if (agentId < ecoAgents.size()) {
-            double wealth = ecoAgents[agentId].wealth;
-            // Find position in sorted wealth distribution
-            auto it = std::lower_bound(all_wealths.begin(), all_wealths.end(), wealth);
-            int decile = std::distance(all_wealths.begin(), it) * 10 / all_wealths.size();
-            decile = std::min(9, decile);  // cap at 9
-            mov.classComposition[decile]++;
+    // Class composition (wealth deciles of the economy-wide distribution)
+    mov.classComposition.fill(0.0);
+    const auto& ecoAgents = kernel.economy().agents();
+    for (auto slot : slots) {
+        if (slot < ecoAgents.size()) {
+            mov.classComposition[decileOf(analytics_.decileFloors, ecoAgents[slot].wealth)]++;
         }
     }
     // Normalize
-    for (auto& [decile, count] : mov.classComposition) {
-        count /= mov.members.size();
+    if (!slots.empty()) {
+        for (auto& share : mov.classComposition) {
+            share /= slots.size();
+        }
     }
 }
 
-void MovementModule::updatePowerMetrics(Movement& mov, const Kernel& kernel) {
+void MovementModule::updatePowerMetrics(Movement& mov, const Kernel& kernel) const {
     const auto& agents = kernel.agents();
     const auto& economy = kernel.economy();
     const auto& ecoAgents = economy.agents();
     
     // Street capacity: sum of assertiveness * (1 + hardship)
+    const auto& slots = mov.memberSlots;
     double streetPower = 0.0;
-    for (auto agentId : mov.members) {
-        double assertiveness = agents[agentId].assertiveness;
-        double hardship = (agentId < ecoAgents.size()) ? ecoAgents[agentId].hardship : 0.0;
+    for (auto slot : slots) {
+        double assertiveness = agents.assertiveness[slot];
+        double hardship = (slot < ecoAgents.size()) ? ecoAgents[slot].hardship : 0.0;
         streetPower += assertiveness * (1.0 + hardship);
     }
     // Average street power per member (not n+1 which penalizes small movements)
-    mov.streetCapacity = mov.members.empty() ? 0.0 : streetPower / mov.members.size();
+    mov.streetCapacity = slots.empty() ? 0.0 : streetPower / slots.size();
     
     // Charisma score: average assertiveness of leaders
+    const auto leaderSlots = resolveSlots(mov.leaders, agents);
     double charismaSum = 0.0;
-    for (auto leaderId : mov.leaders) {
-        charismaSum += agents[leaderId].assertiveness;
+    for (auto slot : leaderSlots) {
+        charismaSum += agents.assertiveness[slot];
     }
-    mov.charismaScore = mov.leaders.empty() ? 0.0 : charismaSum / mov.leaders.size();
+    mov.charismaScore = leaderSlots.empty() ? 0.0 : charismaSum / leaderSlots.size();
     
     // Power: weighted sum of metrics
     mov.power = 0.5 * mov.streetCapacity +
@@ -220,7 +290,7 @@ void MovementModule::updatePowerMetrics(Movement& mov, const Kernel& kernel) {
     mov.power = std::clamp(mov.power, 0.0, 1.0);
 }
 
-void MovementModule::updateStage(Movement& mov) {
+void MovementModule::updateStage(Movement& mov) const {
     std::uint64_t age = mov.lastUpdateTick - mov.birthTick;
     
     // Simple stage progression based on size and coherence
@@ -260,8 +330,9 @@ std::vector<std::uint32_t> MovementModule::identifyLeaders(const std::vector<std
     std::vector<std::pair<std::uint32_t, double>> candidates;
     candidates.reserve(members.size());
     
-    for (auto agentId : members) {
-        candidates.emplace_back(agentId, agents[agentId].assertiveness);
+    for (auto slot : members) {
+        if (slot >= agents.size() || !agents.alive[slot]) continue;
+        candidates.emplace_back(agents.id[slot], agents.assertiveness[slot]);
     }
     
     // Sort by assertiveness descending
@@ -287,7 +358,7 @@ Movement* MovementModule::findMovement(std::uint32_t id) {
 std::vector<Movement*> MovementModule::movementsInRegion(std::uint32_t regionId) {
     std::vector<Movement*> result;
     for (auto& mov : movements_) {
-        if (mov.regionalStrength.count(regionId) > 0) {
+        if (mov.strengthIn(regionId) > 0.0) {
             result.push_back(&mov);
         }
     }
@@ -312,7 +383,7 @@ MovementModule::MovementStats MovementModule::computeStats() const {
     
     double totalPower = 0.0;
     double totalSize = 0.0;
-    std::set<std::uint32_t> allMembers;
+    std::vector<std::uint32_t> allMembers;
     
     for (const auto& mov : movements_) {
         switch (mov.stage) {
@@ -325,14 +396,15 @@ MovementModule::MovementStats MovementModule::computeStats() const {
         
         totalPower += mov.power;
         totalSize += mov.members.size();
-        allMembers.insert(mov.members.begin(), mov.members.end());
+        allMembers.insert(allMembers.end(), mov.members.begin(), mov.members.end());
     }
     
     if (stats.totalMovements > 0) {
         stats.avgPower = totalPower / stats.totalMovements;
         stats.avgSize = totalSize / stats.totalMovements;
     }
-    stats.totalMembership = allMembers.size();
+    std::sort(allMembers.begin(), allMembers.end());
+    stats.totalMembership = std::unique(allMembers.begin(), allMembers.end()) - allMembers.begin();
     
     return stats;
 }
@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "modules/Economy.h"
 #include "kernel/Kernel.h"  // For Agent struct
+#include "modules/TradeNetwork.h"
+#include "modules/WealthDistribution.h"
+#include <algorithm>
+#include <numeric>
 #include <random>
 
 // Basic economy initialization test
@@ -76,3 +80,158 @@ TEST(EconomyTest, WelfareComputation) {
     EXPECT_GE(globalInequality, 0.0);
     EXPECT_LE(globalInequality, 1.0);
 }
+
+// Sparse (CSR) Laplacian matches the dense definition and flows conserve goods
+TEST(EconomyTest, TradeNetworkSparseLaplacian) {
+    const std::uint32_t regions = 6;
+    std::vector<std::vector<std::uint32_t>> partners(regions);
+    for (std::uint32_t i = 0; i < regions; ++i) {
+        partners[i] = {(i + 1) % regions, (i + regions - 1) % regions};  // Ring
+    }
+    partners[0].push_back(3);  // One chord
+
+    TradeNetwork network;
+    network.configure(regions);
+    network.buildTopology(partners);
+    EXPECT_EQ(network.nonZeros(), regions + 2 * regions + 1);
+
+    const auto dense = network.laplacian();
+    ASSERT_EQ(dense.size(), regions);
+    for (std::uint32_t i = 0; i < regions; ++i) {
+        EXPECT_DOUBLE_EQ(dense[i][i], static_cast<double>(partners[i].size()));
+        double rowSum = 0.0;
+        for (std::uint32_t j = 0; j < regions; ++j) {
+            rowSum += dense[i][j];
+            if (i != j) {
+                const bool edge = std::find(partners[i].begin(), partners[i].end(), j) != partners[i].end();
+                EXPECT_DOUBLE_EQ(dense[i][j], edge ? -1.0 : 0.0);
+            }
+        }
+        EXPECT_DOUBLE_EQ(rowSum, 0.0);
+    }
+
+    std::vector<std::array<double, kGoodTypes>> production(regions), demand(regions);
+    for (std::uint32_t i = 0; i < regions; ++i) {
+        for (int g = 0; g < kGoodTypes; ++g) {
+            production[i][g] = 10.0 * ((i + g) % 3);
+            demand[i][g] = 5.0;
+        }
+    }
+    const auto flows = network.computeFlows(production, demand,
+                                            std::vector<std::uint32_t>(regions, 100));
+    ASSERT_EQ(flows.size(), regions);
+    for (int g = 0; g < kGoodTypes; ++g) {
+        double net = 0.0;
+        bool moved = false;
+        for (std::uint32_t i = 0; i < regions; ++i) {
+            net += flows[i][g];
+            moved = moved || flows[i][g] != 0.0;
+        }
+        EXPECT_TRUE(moved);
+        EXPECT_NEAR(net, 0.0, 1.0);  // Conserved up to transport losses
+    }
+}
+
+// Sketch statistics track the exact sorted-array values within the bucket error
+TEST(EconomyTest, WealthDistributionMatchesSorted) {
+    std::mt19937_64 rng(7);
+    std::lognormal_distribution<double> wealthDist(0.0, 1.2);
+    std::vector<double> wealths(20000);
+    for (auto& w : wealths) w = std::max(0.01, wealthDist(rng));
+
+    WealthDistribution left, right;
+    for (std::size_t i = 0; i < wealths.size(); ++i) {
+        (i % 2 ? left : right).add(wealths[i]);
+    }
+    WealthDistribution all;
+    all.merge(left);
+    all.merge(right);
+    ASSERT_EQ(all.count(), wealths.size());
+
+    std::sort(wealths.begin(), wealths.end());
+    const double n = static_cast<double>(wealths.size());
+    double total = 0.0, weighted = 0.0;
+    for (std::size_t j = 0; j < wealths.size(); ++j) {
+        total += wealths[j];
+        weighted += wealths[j] * (2.0 * j - n + 1.0);
+    }
+    const double gini = weighted / (n * total);
+    const double top10 = std::accumulate(wealths.begin() + wealths.size() * 9 / 10, wealths.end(), 0.0) / total;
+    const double bottom50 = std::accumulate(wealths.begin(), wealths.begin() + wealths.size() / 2, 0.0) / total;
+
+    EXPECT_NEAR(all.total(), total, 1e-6 * total);
+    EXPECT_NEAR(all.gini(), gini, 0.01);
+    EXPECT_NEAR(all.topShare(0.1), top10, 0.01);
+    EXPECT_NEAR(all.bottomShare(0.5), bottom50, 0.01);
+    EXPECT_NEAR(all.quantile(0.5), wealths[wealths.size() / 2], wealths[wealths.size() / 2] * 0.02);
+    EXPECT_EQ(all.decile(wealths.front()), 0);
+    EXPECT_EQ(all.decile(wealths.back()), 9);
+    const auto floors = all.decileFloors();
+    for (std::size_t j = 0; j < wealths.size(); j += 37) {
+        const auto binned = std::upper_bound(floors.begin(), floors.end(), wealths[j]) - floors.begin();
+        ASSERT_EQ(binned, all.decile(wealths[j])) << "wealth " << wealths[j];
+    }
+    EXPECT_THROW(all.merge(WealthDistribution(4)), std::invalid_argument);
+
+    all.clear();
+    EXPECT_TRUE(all.empty());
+    EXPECT_DOUBLE_EQ(all.gini(), 0.0);
+}
+
+// Region-parallel and serial updates agree exactly; systems round-trip through names
+TEST(EconomyTest, RegionParallelMatchesSerial) {
+    constexpr std::uint32_t kRegions = 40;
+    constexpr std::uint32_t kAgents = 4000;
+
+    std::vector<Agent> agents(kAgents);
+    std::vector<std::vector<std::uint32_t>> regionIndex(kRegions);
+    std::mt19937_64 beliefRng(7);
+    std::uniform_real_distribution<double> belief(-0.6, 0.6);
+    for (std::uint32_t i = 0; i < kAgents; ++i) {
+        agents[i].region = i % kRegions;
+        for (auto& b : agents[i].B) b = belief(beliefRng);
+        regionIndex[agents[i].region].push_back(i);
+    }
+    std::vector<std::uint32_t> regionPopulations(kRegions, kAgents / kRegions);
+    std::vector<std::array<double, 4>> regionBeliefs(kRegions, {0, 0, 0, 0});
+
+    Economy serial, parallel;
+    std::mt19937_64 rngA(42), rngB(42);
+    serial.init(kRegions, kAgents, rngA, "baseline");
+    parallel.init(kRegions, kAgents, rngB, "baseline");
+    serial.setRegionParallel(false);
+    ASSERT_TRUE(parallel.regionParallel());
+
+    for (std::uint64_t gen = 1; gen <= 60; ++gen) {
+        serial.update(regionPopulations, regionBeliefs, agents, gen, &regionIndex);
+        parallel.update(regionPopulations, regionBeliefs, agents, gen, &regionIndex);
+    }
+
+    for (std::uint32_t r = 0; r < kRegions; ++r) {
+        const auto& a = serial.getRegion(r);
+        const auto& b = parallel.getRegion(r);
+        EXPECT_EQ(a.welfare, b.welfare);
+        EXPECT_EQ(a.inequality, b.inequality);
+        EXPECT_EQ(a.hardship, b.hardship);
+        EXPECT_EQ(a.development, b.development);
+        EXPECT_EQ(a.economic_system, b.economic_system);
+        EXPECT_EQ(a.pending_system, b.pending_system);
+    }
+    EXPECT_EQ(serial.globalWelfare(), parallel.globalWelfare());
+    EXPECT_EQ(serial.globalInequality(), parallel.globalInequality());
+    EXPECT_EQ(serial.wealthDistribution().total(), parallel.wealthDistribution().total());
+
+    for (auto system : {EconomicSystem::Mixed, EconomicSystem::Market, EconomicSystem::Planned,
+                        EconomicSystem::Feudal, EconomicSystem::Cooperative, EconomicSystem::None}) {
+        EconomicSystem parsed = EconomicSystem::Mixed;
+        ASSERT_TRUE(parseEconomicSystem(economicSystemName(system), parsed));
+        EXPECT_EQ(parsed, system);
+    }
+    EconomicSystem unchanged = EconomicSystem::Market;
+    EXPECT_FALSE(parseEconomicSystem("anarchy", unchanged));
+    EXPECT_EQ(unchanged, EconomicSystem::Market);
+
+    parallel.setEconomicModel("planned");
+    parallel.update(regionPopulations, regionBeliefs, agents, 70, &regionIndex);
+    EXPECT_EQ(parallel.getRegion(0).economic_system, EconomicSystem::Planned);
+}
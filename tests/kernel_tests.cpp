@@ -1,5 +1,31 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 #include "kernel/Kernel.h"
+#include "kernel/BeliefKernels.h"
+#include "kernel/Ensemble.h"
+#include "kernel/ShardedKernel.h"
+#include "kernel/TickScheduler.h"
+#include "io/LiveSimulation.h"
+#include "io/MetricsRecorder.h"
+#include "io/Snapshot.h"
+#include "modules/Culture.h"
+#ifdef HAS_GAME_MODULES
+#include "modules/Movement.h"
+#endif
+#include "utils/CounterRng.h"
+#include "utils/EventLog.h"
+#include "utils/Profiler.h"
+#include "utils/Serialization.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // Basic kernel initialization test
 TEST(KernelTest, Initialization) {
@@ -70,3 +96,1801 @@ TEST(KernelTest, MetricsComputation) {
     EXPECT_GE(metrics.avgConformity, 0.0);
     EXPECT_LE(metrics.avgConformity, 1.0);
 }
+
+// Agent store round-trip: records pushed into the SoA columns come back intact,
+// and writes through the field proxy land in the underlying columns
+TEST(KernelTest, AgentStoreRoundTrip) {
+    Agent a;
+    a.id = 7;
+    a.region = 3;
+    a.age = 41;
+    a.female = true;
+    a.openness = 0.8;
+    a.B = {0.1, -0.2, 0.3, -0.4};
+    a.psych.stress_level = 0.25;
+    a.neighbors = {1, 2, 3};
+
+    AgentStore store;
+    std::uint32_t slot = store.push_back(a);
+    ASSERT_EQ(slot, 0u);
+    ASSERT_EQ(store.size(), 1u);
+
+    Agent back = store.record(slot);
+    EXPECT_EQ(back.id, a.id);
+    EXPECT_EQ(back.region, a.region);
+    EXPECT_EQ(back.age, a.age);
+    EXPECT_TRUE(back.female);
+    // Values come back at the build's storage precision (kernel/Precision.h)
+    EXPECT_DOUBLE_EQ(back.openness, precision::trait_t(a.openness));
+    const std::array<double, 4> storedB = precision::BeliefVec(a.B);
+    EXPECT_EQ(back.B, storedB);
+    EXPECT_DOUBLE_EQ(back.psych.stress_level, a.psych.stress_level);
+    EXPECT_EQ(back.neighbors, a.neighbors);
+
+    auto ref = store[slot];
+    ref.age = 42;
+    ref.B[2] = 0.9;
+    EXPECT_EQ(store.age[slot], 42);
+    EXPECT_DOUBLE_EQ(store.B[slot][2], static_cast<precision::belief_t>(0.9));
+}
+
+// CSR social graph: rows grow past their slack by relocating, and a batched
+// compaction drops dead targets while preserving per-row order
+TEST(KernelTest, SocialGraphGrowAndCompact) {
+    SocialGraph graph;
+    for (int i = 0; i < 4; ++i) graph.addRow(1);
+
+    for (std::uint32_t v = 1; v < 4; ++v) graph.connect(0, v);
+    ASSERT_EQ(graph.degree(0), 3u);
+    EXPECT_EQ(graph.row(0)[2], 3u);
+    EXPECT_EQ(graph.edgeCount(), 6u);
+
+    EXPECT_EQ(graph.erase(0, 2), 1u);
+    EXPECT_EQ(graph.degree(0), 2u);
+
+    graph.compact([](std::uint32_t u) { return u == 3; },
+                  [](std::uint32_t t) { return t == 3; });
+    auto row = graph.row(0);
+    ASSERT_EQ(row.size(), 1u);
+    EXPECT_EQ(row[0], 1u);
+    EXPECT_EQ(graph.degree(3), 0u);
+    EXPECT_EQ(graph.holeEntries(), 0u);
+
+    // assign() from the graph's own storage: another row, grown past the
+    // target row's capacity (relocation reallocates targets_), and row u
+    // shifted within itself
+    graph.clearRow(2);
+    for (std::uint32_t v = 0; v < 40; ++v) graph.push(2, v);
+    graph.assign(1, graph.data(2), graph.degree(2));
+    ASSERT_EQ(graph.degree(1), 40u);
+    for (std::uint32_t v = 0; v < 40; ++v) ASSERT_EQ(graph.row(1)[v], v);
+    graph.assign(1, graph.data(1) + 10, 30);
+    ASSERT_EQ(graph.degree(1), 30u);
+    for (std::uint32_t k = 0; k < 30; ++k) ASSERT_EQ(graph.row(1)[k], k + 10);
+}
+
+// Dead-slot reclamation: once enough agents die, compaction squeezes out
+// their slots, keeps stable IDs sorted and remaps every slot reference
+TEST(KernelTest, CompactionReclaimsDeadSlots) {
+    KernelConfig cfg;
+    cfg.population = 2000;
+    cfg.regions = 10;
+    cfg.seed = 7;
+
+    Kernel kernel(cfg);
+    auto& store = kernel.agentsMut();
+    for (std::size_t i = 0; i < store.size(); i += 2) {
+        store.alive[i] = 0;
+    }
+    const std::uint32_t survivorId = store.id[1];
+
+    kernel.stepN(5);
+
+    const auto& agents = kernel.agents();
+    ASSERT_LT(agents.size(), cfg.population);
+    EXPECT_TRUE(std::is_sorted(agents.id.begin(), agents.id.end()));
+
+    const std::uint32_t slot = agents.slotOf(survivorId);
+    if (slot != AgentStore::kNoSlot) {
+        EXPECT_EQ(agents.id[slot], survivorId);
+    }
+    EXPECT_EQ(agents.slotOf(0), AgentStore::kNoSlot);  // Killed above, compacted away
+
+    for (const auto& region : kernel.regionIndex()) {
+        for (auto s : region) {
+            ASSERT_LT(s, agents.size());
+        }
+    }
+    for (std::uint32_t u = 0; u < agents.size(); ++u) {
+        for (auto v : agents.graph.row(u)) {
+            ASSERT_LT(v, agents.size());
+        }
+    }
+    EXPECT_EQ(kernel.economy().agents().size(), agents.size());
+}
+
+// Vector belief kernels must agree with the scalar reference, including
+// dead/out-of-range neighbors and rows that do not fill a whole batch
+TEST(KernelTest, BeliefKernelsMatchScalar) {
+    using namespace belief_kernels;
+    const std::size_t n = 40;
+    std::vector<precision::BeliefVec> B(n);
+    std::vector<precision::belief_t> normSq(n);
+    std::vector<double> fluency(n), comm(n);
+    std::vector<std::uint8_t> alive(n, 1), lang(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int d = 0; d < 4; ++d) {
+            B[i][d] = std::sin(0.7 * static_cast<double>(i) + d) * 0.9;
+        }
+        normSq[i] = B[i][0] * B[i][0] + B[i][1] * B[i][1] + B[i][2] * B[i][2] + B[i][3] * B[i][3];
+        fluency[i] = 0.3 + 0.05 * static_cast<double>(i % 10);
+        comm[i] = 0.5 + 0.01 * static_cast<double>(i);
+        lang[i] = static_cast<std::uint8_t>(i % 3);
+    }
+    alive[5] = 0;
+    alive[17] = 0;
+
+    Columns cols{B.data(), normSq.data(), alive.data(), lang.data(),
+                 fluency.data(), comm.data(), n};
+    std::vector<std::uint32_t> row;
+    for (std::uint32_t k = 1; k < 24; ++k) row.push_back((k * 7) % n);
+    row.push_back(1000);  // Out of range
+    const HybridParams hp;
+    const PairwiseParams pp;
+
+    for (Isa isa : {Isa::AVX2, Isa::AVX512}) {
+        if (!supported(isa)) continue;
+        const Dispatch& vec = forIsa(isa);
+        for (std::uint32_t deg : {0u, 3u, 9u, static_cast<std::uint32_t>(row.size())}) {
+            NeighborInfluence ref, got;
+            hybridRowScalar(cols, 0, row.data(), deg, hp, ref);
+            vec.hybrid(cols, 0, row.data(), deg, hp, got);
+            EXPECT_EQ(got.neighbor_count, ref.neighbor_count) << vec.name;
+            EXPECT_NEAR(got.total_weight, ref.total_weight, 1e-9) << vec.name;
+
+            std::array<double, 4> accRef{}, accGot{};
+            pairwiseRowScalar(cols, 0, 0.8, row.data(), deg, pp, accRef);
+            vec.pairwise(cols, 0, 0.8, row.data(), deg, pp, accGot);
+            for (int d = 0; d < 4; ++d) {
+                EXPECT_NEAR(got.belief_sum[d], ref.belief_sum[d], 1e-9) << vec.name;
+                EXPECT_NEAR(accGot[d], accRef[d], 1e-9) << vec.name;
+            }
+        }
+    }
+}
+
+// Counter-based RNG: same seed gives the same run regardless of thread count
+TEST(KernelTest, SeedReproducibleAcrossThreadCounts) {
+    rng::CounterRng a(42, 7, 3, rng::Stream::Innovation);
+    rng::CounterRng b(42, 7, 3, rng::Stream::Innovation);
+    rng::CounterRng c(42, 7, 3, rng::Stream::Mortality);
+    const auto first = a();
+    EXPECT_EQ(first, b());
+    EXPECT_NE(first, c());
+
+    KernelConfig cfg;
+    cfg.population = 500;
+    cfg.regions = 10;
+    cfg.seed = 99;
+
+    auto run = [&](int threads) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+        Kernel kernel(cfg);
+        kernel.stepN(20);
+        return kernel.agents().B;
+    };
+    const auto serial = run(1);
+    const auto threaded = run(4);
+#ifdef _OPENMP
+    omp_set_num_threads(omp_get_num_procs());
+#endif
+
+    ASSERT_EQ(serial.size(), threaded.size());
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        for (int d = 0; d < 4; ++d) {
+            ASSERT_NEAR(serial[i][d], threaded[i][d], 1e-9) << "agent slot " << i;
+        }
+    }
+}
+
+// Parallel demography and migration: births, deaths, child IDs and moves do
+// not depend on thread count
+TEST(KernelTest, ParallelDemographyMatchesSerial) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 20;
+    cfg.seed = 2024;
+
+    struct Outcome {
+        std::vector<std::uint32_t> id;
+        std::vector<std::int32_t> parent_a;
+        std::vector<int> age;
+        std::vector<std::uint32_t> region;
+        std::size_t migrations;
+    };
+    auto run = [&](int threads) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+        Kernel kernel(cfg);
+        kernel.stepN(60);
+        const auto& store = kernel.agents();
+        return Outcome{store.id, store.parent_a, store.age, store.region,
+                       kernel.eventLog().getEventsByType(EventType::MIGRATION).size()};
+    };
+    const Outcome serial = run(1);
+    const Outcome threaded = run(3);
+#ifdef _OPENMP
+    omp_set_num_threads(omp_get_num_procs());
+#endif
+
+    EXPECT_GT(serial.id.back(), cfg.population - 1) << "expected some births";
+    EXPECT_EQ(serial.id, threaded.id);
+    EXPECT_EQ(serial.parent_a, threaded.parent_a);
+    EXPECT_EQ(serial.age, threaded.age);
+    EXPECT_EQ(serial.region, threaded.region);
+    EXPECT_GT(serial.migrations, 0u) << "expected some migration";
+    EXPECT_EQ(serial.migrations, threaded.migrations);
+}
+
+// Tick scheduler: consecutive agent stages fuse into one sweep, regional
+// reductions are exact, and arena buffers are reused across ticks
+TEST(KernelTest, TickSchedulerFusesStages) {
+    const std::size_t n = 5000;
+    const std::size_t regions = 7;
+    std::vector<std::uint32_t> regionOf(n);
+    std::vector<double> value(n, 0.0);
+    for (std::size_t i = 0; i < n; ++i) regionOf[i] = static_cast<std::uint32_t>(i % regions);
+
+    TickScheduler scheduler;
+    TickArena arena;
+    std::vector<double> totals(regions, 0.0);
+    std::vector<double> counts(regions, 0.0);
+    bool prepared = false;
+
+    scheduler.addRegionStage("prepare", [&] { prepared = true; });
+    TickScheduler::AgentStage write;
+    write.name = "write";
+    write.update = [&](std::uint32_t slot, double*) { value[slot] = static_cast<double>(slot); };
+    scheduler.addAgentStage(write);
+    TickScheduler::AgentStage sum;
+    sum.name = "sum";
+    sum.reduceWidth = 2;
+    sum.update = [&](std::uint32_t slot, double* acc) {
+        acc[0] += value[slot];  // Reads the earlier stage's result for the same slot
+        acc[1] += 1.0;
+    };
+    sum.finalize = [&](const TickScheduler::RegionSums& s) {
+        for (std::size_t r = 0; r < regions; ++r) {
+            totals[r] = s(r, 0);
+            counts[r] = s(r, 1);
+        }
+    };
+    scheduler.addAgentStage(sum);
+
+    scheduler.run(regionOf, regions, arena);
+    EXPECT_TRUE(prepared);
+    EXPECT_EQ(scheduler.lastSweepCount(), 1u);
+    for (std::size_t r = 0; r < regions; ++r) {
+        double expected = 0.0;
+        double count = 0.0;
+        for (std::size_t i = r; i < n; i += regions) {
+            expected += static_cast<double>(i);
+            count += 1.0;
+        }
+        EXPECT_DOUBLE_EQ(totals[r], expected);
+        EXPECT_DOUBLE_EQ(counts[r], count);
+    }
+
+    const std::size_t growths = arena.growths();
+    arena.reset();
+    scheduler.run(regionOf, regions, arena);
+    EXPECT_EQ(arena.growths(), growths);
+
+    // Region-sorted slots over many regions: each block touches a few regions,
+    // and rows a block touched last run do not leak into this one
+    const std::size_t many = 900;
+    std::vector<std::uint32_t> sorted(n);
+    for (std::size_t i = 0; i < n; ++i) sorted[i] = static_cast<std::uint32_t>(i * many / n);
+    totals.assign(many, -1.0);
+    counts.assign(many, -1.0);
+    TickScheduler wide;
+    wide.addAgentStage(write);
+    sum.finalize = [&](const TickScheduler::RegionSums& s) {
+        for (std::size_t r = 0; r < many; ++r) {
+            totals[r] = s(r, 0);
+            counts[r] = s(r, 1);
+        }
+    };
+    wide.addAgentStage(sum);
+    for (int pass = 0; pass < 2; ++pass) {
+        arena.reset();
+        wide.run(pass == 0 ? regionOf : sorted, many, arena);
+    }
+    std::vector<double> expected(many, 0.0), expectedCounts(many, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        expected[sorted[i]] += static_cast<double>(i);
+        expectedCounts[sorted[i]] += 1.0;
+    }
+    for (std::size_t r = 0; r < many; ++r) {
+        EXPECT_DOUBLE_EQ(totals[r], expected[r]) << "region " << r;
+        EXPECT_DOUBLE_EQ(counts[r], expectedCounts[r]) << "region " << r;
+    }
+}
+
+TEST(KernelTest, TickProfilerRecordsPhases) {
+    if (!profiler::Profiler::compiledIn()) {
+        GTEST_SKIP() << "Built with ENABLE_PROFILING=OFF";
+    }
+    KernelConfig cfg;
+    cfg.population = 2000;
+    cfg.regions = 10;
+    cfg.seed = 11;
+    cfg.demographyEnabled = true;
+    Kernel kernel(cfg);
+
+    auto& prof = profiler::Profiler::instance();
+    prof.reset();
+    prof.setTracing(true);
+    kernel.stepN(20);
+    prof.setTracing(false);
+
+    const auto tick = prof.stats(profiler::Phase::Tick);
+    EXPECT_EQ(tick.calls, 20u);
+    EXPECT_GE(tick.agentsTouched, 20u * cfg.population / 2);
+    EXPECT_GT(tick.meanUs, 0.0);
+    EXPECT_GE(tick.p99Us, tick.meanUs);
+    EXPECT_EQ(prof.stats(profiler::Phase::Beliefs).calls, 20u);
+    EXPECT_EQ(prof.stats(profiler::Phase::Migration).calls, 2u);
+    EXPECT_EQ(prof.stats(profiler::Phase::EconomyUpdate).calls, 2u);
+    EXPECT_GE(prof.stats(profiler::Phase::AgentSweep).calls, 20u);
+    EXPECT_GT(prof.traceEvents(), 0u);
+
+    // Parent scopes see the events their children logged
+    EXPECT_GE(tick.eventsLogged, prof.stats(profiler::Phase::Demography).eventsLogged);
+    prof.reset();
+    EXPECT_EQ(prof.stats(profiler::Phase::Tick).calls, 0u);
+
+    // Kernels stepping on several threads share the profiler without losing samples
+    prof.setTracing(true);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([cfg] {
+            KernelConfig own = cfg;
+            own.population = 300;
+            Kernel k(own);
+            k.stepN(10);
+        });
+    }
+    for (auto& w : workers) w.join();
+    prof.setTracing(false);
+    EXPECT_EQ(prof.stats(profiler::Phase::Tick).calls, 40u);
+    EXPECT_GT(prof.traceEvents(), 40u);
+    prof.reset();
+}
+
+// Grid-indexed DBSCAN reproduces the brute-force O(N^2) labelling
+TEST(KernelTest, DbscanGridMatchesBruteForce) {
+    KernelConfig cfg;
+    cfg.population = 2500;
+    cfg.regions = 20;
+    cfg.seed = 11;
+    Kernel kernel(cfg);
+    kernel.stepN(20);
+
+    const double eps = 0.25;
+    const int minPts = 15;
+    DBSCANClustering dbscan(eps, minPts);
+    const auto clusters = dbscan.run(kernel);
+
+    // Reference: scan every agent per query, expand with a duplicate-tolerant queue
+    const auto& B = kernel.agents().B;
+    const auto n = static_cast<std::uint32_t>(B.size());
+    auto query = [&](std::uint32_t idx) {
+        std::vector<std::uint32_t> out;
+        for (std::uint32_t i = 0; i < n; ++i) {
+            double d2 = 0.0;
+            for (int k = 0; k < 4; ++k) {
+                const double diff = B[idx][k] - B[i][k];
+                d2 += diff * diff;
+            }
+            if (d2 <= eps * eps) out.push_back(i);
+        }
+        return out;
+    };
+    std::vector<int> labels(n, 0);
+    int clusterId = 0, noise = 0;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (labels[i] != 0) continue;
+        auto queue = query(i);
+        if (static_cast<int>(queue.size()) < minPts) {
+            labels[i] = -1;
+            ++noise;
+            continue;
+        }
+        labels[i] = ++clusterId;
+        for (std::size_t q = 0; q < queue.size(); ++q) {
+            const auto j = queue[q];
+            if (labels[j] == -1) labels[j] = clusterId;
+            if (labels[j] != 0) continue;
+            labels[j] = clusterId;
+            const auto more = query(j);
+            if (static_cast<int>(more.size()) >= minPts) queue.insert(queue.end(), more.begin(), more.end());
+        }
+    }
+
+    ASSERT_GT(clusterId, 0) << "expected at least one cluster";
+    ASSERT_EQ(static_cast<int>(clusters.size()), clusterId);
+    EXPECT_EQ(dbscan.noisePoints(), noise);
+    std::size_t clustered = 0;
+    for (const auto& cluster : clusters) {
+        clustered += cluster.members.size();
+        for (auto member : cluster.members) {
+            EXPECT_EQ(labels[member], static_cast<int>(cluster.id) + 1);
+        }
+    }
+    EXPECT_EQ(clustered, static_cast<std::size_t>(std::count_if(labels.begin(), labels.end(),
+                                                               [](int l) { return l > 0; })));
+}
+
+// K-means: pruned sweeps still reach a Lloyd fixed point, results ignore the
+// thread count, warm starts converge at once and mini-batch lands close by
+TEST(KernelTest, KMeansWarmStartAndMiniBatch) {
+    KernelConfig cfg;
+    cfg.population = 6000;
+    cfg.regions = 20;
+    cfg.seed = 5;
+    Kernel kernel(cfg);
+    kernel.stepN(20);
+    const auto& B = kernel.agents().B;
+
+    auto sq = [](const std::array<double, 4>& a, const std::array<double, 4>& b) {
+        double d2 = 0.0;
+        for (int d = 0; d < 4; ++d) d2 += (a[d] - b[d]) * (a[d] - b[d]);
+        return d2;
+    };
+    auto inertia = [&](const std::vector<Cluster>& clusters) {
+        double total = 0.0;
+        for (const auto& c : clusters) {
+            for (auto m : c.members) total += sq(B[m], c.centroid);
+        }
+        return total;
+    };
+    auto run = [&](int threads) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+        KMeansClustering kmeans(6, 200);
+        auto clusters = kmeans.run(kernel);
+        EXPECT_TRUE(kmeans.converged());
+        return clusters;
+    };
+    const auto serial = run(1);
+    const auto threaded = run(3);
+#ifdef _OPENMP
+    omp_set_num_threads(omp_get_num_procs());
+#endif
+    ASSERT_EQ(serial.size(), threaded.size());
+    for (std::size_t k = 0; k < serial.size(); ++k) {
+        EXPECT_EQ(serial[k].centroid, threaded[k].centroid);
+        EXPECT_EQ(serial[k].members, threaded[k].members);
+    }
+
+    KMeansClustering kmeans(6);
+    const auto first = kmeans.run(kernel);
+    const int coldIterations = kmeans.iterationsUsed();
+    // Pruning never leaves an agent with a farther centroid than brute force would
+    const auto& centroids = kmeans.centroids();
+    ASSERT_EQ(centroids.size(), first.size());
+    for (const auto& c : first) {
+        for (auto m : c.members) {
+            for (const auto& other : centroids) {
+                EXPECT_LE(sq(B[m], centroids[c.id]), sq(B[m], other) + 1e-12);
+            }
+        }
+    }
+    kmeans.run(kernel);
+    EXPECT_TRUE(kmeans.converged());
+    EXPECT_LE(kmeans.iterationsUsed(), 3);
+    EXPECT_LT(kmeans.iterationsUsed(), coldIterations);
+
+    KMeansClustering batched(6);
+    batched.setMiniBatch(1000);
+    const auto approx = batched.run(kernel);
+    EXPECT_LT(inertia(approx), inertia(first) * 1.05);
+
+    EXPECT_THROW(kmeans.setInitialCentroids({{0, 0, 0, 0}}), std::invalid_argument);
+}
+
+// The live culture index tracks every living agent through births, deaths
+// and compaction, and folds the same centroids for any thread count
+TEST(KernelTest, LiveCultureIndexTracksPopulation) {
+    KernelConfig cfg;
+    cfg.population = 4000;
+    cfg.regions = 10;
+    cfg.seed = 11;
+    cfg.liveClusters = 5;
+    cfg.liveClusterReassignTicks = 7;
+
+    auto run = [&](int threads) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+        Kernel kernel(cfg);
+        auto& store = kernel.agentsMut();
+        for (std::size_t i = 0; i < store.size(); i += 3) {
+            store.alive[i] = 0;  // Enough deaths to force compaction
+        }
+        kernel.stepN(15);
+        const OnlineClustering* live = kernel.liveClusters();
+        EXPECT_NE(live, nullptr);
+        return live ? live->snapshot(kernel.agents(), kernel.generation()) : std::vector<Cluster>{};
+    };
+    const auto serial = run(1);
+    const auto threaded = run(3);
+#ifdef _OPENMP
+    omp_set_num_threads(omp_get_num_procs());
+#endif
+    ASSERT_EQ(serial.size(), 5u);
+    ASSERT_EQ(serial.size(), threaded.size());
+    for (std::size_t k = 0; k < serial.size(); ++k) {
+        EXPECT_EQ(serial[k].centroid, threaded[k].centroid);
+        EXPECT_EQ(serial[k].members, threaded[k].members);
+    }
+
+    Kernel kernel(cfg);
+    kernel.stepN(3);
+    const auto& agents = kernel.agents();
+    const auto clusters = kernel.liveClusters()->snapshot(agents, kernel.generation());
+    std::size_t assigned = 0;
+    for (const auto& c : clusters) {
+        for (auto m : c.members) {
+            ASSERT_LT(m, agents.size());
+            EXPECT_TRUE(agents.alive[m]);
+        }
+        assigned += c.members.size();
+    }
+    std::size_t alive = 0;
+    for (std::size_t i = 0; i < agents.size(); ++i) alive += agents.alive[i] ? 1 : 0;
+    // Children born this tick join at the next belief pass
+    EXPECT_LE(assigned, alive);
+    EXPECT_GE(assigned, alive * 9 / 10);
+
+    kernel.setLiveClustering(0);
+    EXPECT_EQ(kernel.liveClusters(), nullptr);
+}
+
+#ifdef HAS_GAME_MODULES
+// Movements update in parallel, each from its own cached member slots: the
+// result matches a single-threaded run, and the cache follows compaction
+TEST(KernelTest, MovementUpdatesMatchSerialAcrossCompaction) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 10;
+    cfg.seed = 13;
+
+    MovementFormationConfig formation;
+    formation.minSize = 10;
+    formation.minCoherence = 0.0;
+    formation.minCharismaDensity = 0.0;
+    formation.hardshipThreshold = -1.0;  // Every cluster forms a movement
+
+    auto run = [&](int threads) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        (void)threads;
+#endif
+        Kernel kernel(cfg);
+        MovementModule module(formation);
+        module.update(kernel, KMeansClustering(6).run(kernel), kernel.generation());
+        EXPECT_EQ(module.movements().size(), 6u);
+
+        auto& store = kernel.agentsMut();
+        for (std::size_t i = 0; i < store.size(); i += 3) {
+            store.alive[i] = 0;  // Enough deaths to force compaction
+        }
+        for (int t = 0; t < 8; ++t) {
+            kernel.step();
+            module.update(kernel, {}, kernel.generation());
+        }
+
+        const auto& agents = kernel.agents();
+        EXPECT_LT(agents.size(), cfg.population);
+        for (const auto& mov : module.movements()) {
+            EXPECT_FALSE(mov.members.empty());
+            EXPECT_EQ(mov.memberSlots.size(), mov.members.size());
+            for (std::size_t m = 0; m < mov.members.size(); ++m) {
+                const std::uint32_t slot = mov.memberSlots[m];
+                EXPECT_LT(slot, agents.size());
+                if (slot >= agents.size()) continue;
+                EXPECT_EQ(agents.id[slot], mov.members[m]);
+                EXPECT_TRUE(agents.alive[slot]);
+            }
+        }
+        return module.movements();
+    };
+    const auto serial = run(1);
+    const auto threaded = run(4);
+#ifdef _OPENMP
+    omp_set_num_threads(omp_get_num_procs());
+#endif
+    ASSERT_FALSE(serial.empty());
+    ASSERT_EQ(serial.size(), threaded.size());
+    for (std::size_t k = 0; k < serial.size(); ++k) {
+        EXPECT_EQ(serial[k].id, threaded[k].id);
+        EXPECT_EQ(serial[k].stage, threaded[k].stage);
+        EXPECT_EQ(serial[k].members, threaded[k].members);
+        EXPECT_EQ(serial[k].memberSlots, threaded[k].memberSlots);
+        EXPECT_EQ(serial[k].platform, threaded[k].platform);
+        EXPECT_EQ(serial[k].coherence, threaded[k].coherence);
+        EXPECT_EQ(serial[k].power, threaded[k].power);
+        EXPECT_EQ(serial[k].regionalStrength, threaded[k].regionalStrength);
+        EXPECT_EQ(serial[k].classComposition, threaded[k].classComposition);
+    }
+}
+#endif
+
+// Regional aggregates follow every belief update, birth, death and move, so
+// between drift rebuilds they match a full scan of the agents
+TEST(KernelTest, RegionalAggregatesTrackBeliefUpdates) {
+    for (bool meanField : {true, false}) {
+        KernelConfig cfg;
+        cfg.population = 3000;
+        cfg.regions = 12;
+        cfg.seed = 21;
+        cfg.useMeanField = meanField;
+        Kernel kernel(cfg);
+        kernel.stepN(35);  // Includes economy feedback and migration ticks, no rebuild
+
+        std::vector<std::uint32_t> populations;
+        std::vector<std::array<double, 4>> means;
+        kernel.regionalCentroids(populations, means);
+
+        const auto& agents = kernel.agents();
+        std::vector<std::uint32_t> expectedPop(cfg.regions, 0);
+        std::vector<std::array<double, 4>> expectedSum(cfg.regions, {0.0, 0.0, 0.0, 0.0});
+        for (std::size_t i = 0; i < agents.size(); ++i) {
+            if (!agents.alive[i]) continue;
+            expectedPop[agents.region[i]]++;
+            for (int d = 0; d < 4; ++d) expectedSum[agents.region[i]][d] += agents.B[i][d];
+        }
+        for (std::uint32_t r = 0; r < cfg.regions; ++r) {
+            ASSERT_EQ(populations[r], expectedPop[r]) << "region " << r;
+            for (int d = 0; d < 4; ++d) {
+                const double expected = expectedPop[r] ? expectedSum[r][d] / expectedPop[r] : 0.0;
+                EXPECT_NEAR(means[r][d], expected, 1e-9) << "region " << r << " dim " << d;
+            }
+        }
+    }
+}
+
+// Metrics are memoized until the state changes; sampled polarization on many
+// regions stays close to the exact all-pairs value
+TEST(KernelTest, MetricsMemoizedAndSampledPolarization) {
+    KernelConfig cfg;
+    cfg.population = 12000;
+    cfg.regions = 1500;
+    cfg.seed = 13;
+    cfg.polarizationSampleRegions = 0;  // Always exact
+    Kernel exactKernel(cfg);
+    cfg.polarizationSampleRegions = 200;
+    Kernel sampledKernel(cfg);
+
+    const auto exact = exactKernel.computeMetrics();
+    const auto sampled = sampledKernel.computeMetrics();
+    ASSERT_GT(exact.polarizationMean, 0.0);
+    EXPECT_NEAR(sampled.polarizationMean, exact.polarizationMean, 0.02 * exact.polarizationMean);
+    EXPECT_NEAR(sampled.polarizationStd, exact.polarizationStd, 0.05 * exact.polarizationStd);
+    EXPECT_EQ(sampledKernel.computeMetrics().polarizationMean, sampled.polarizationMean);
+
+    // Edits through agentsMut() invalidate the memo
+    auto& store = exactKernel.agentsMut();
+    for (std::size_t i = 0; i < store.size(); ++i) store.openness[i] = 0.25;
+    const double stored = store.openness[0];  // 0.25 at the build's trait precision
+    EXPECT_NEAR(exactKernel.computeMetrics().avgOpenness, stored, 1e-12);
+    const auto stats = exactKernel.getStatistics();
+    EXPECT_EQ(stats.aliveAgents, cfg.population);
+    EXPECT_EQ(stats.males + stats.females, stats.aliveAgents);
+    EXPECT_EQ(stats.children + stats.youngAdults + stats.middleAge + stats.mature + stats.elderly,
+              stats.aliveAgents);
+}
+
+TEST(KernelTest, CohortBackgroundAndFastForward) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 12;
+    cfg.seed = 17;
+    cfg.backgroundPopulation = 3000000;
+    Kernel kernel(cfg);
+    const std::uint64_t background = kernel.background().getTotalPopulation();
+    EXPECT_NEAR(static_cast<double>(background), 3e6, 3e4);
+    EXPECT_EQ(kernel.representedPopulation(), background + cfg.population);
+
+    // Moving people between cohorts and agents conserves the represented total
+    EXPECT_EQ(kernel.materialize(3, 250), 250u);
+    EXPECT_EQ(kernel.getStatistics().aliveAgents, cfg.population + 250);
+    EXPECT_EQ(kernel.dematerialize(3, 100), 100u);
+    EXPECT_EQ(kernel.representedPopulation(), background + cfg.population);
+    EXPECT_THROW(kernel.materialize(cfg.regions, 1), std::out_of_range);
+
+    // Fast-forward advances the clock and ages; aggregates stay in sync with the agents
+    const auto before = kernel.generation();
+    kernel.fastForward(30);
+    EXPECT_EQ(kernel.generation(), before + 30u * cfg.ticksPerYear);
+    const auto stats = kernel.getStatistics();
+    EXPECT_GT(stats.aliveAgents, cfg.population / 2);
+    EXPECT_LE(stats.maxAge, cfg.maxAgeYears);
+    std::vector<std::uint32_t> populations;
+    std::vector<std::array<double, 4>> centroids;
+    kernel.regionalCentroids(populations, centroids);
+    EXPECT_EQ(std::accumulate(populations.begin(), populations.end(), 0u), stats.aliveAgents);
+    kernel.stepN(3);
+    EXPECT_GT(kernel.background().getTotalPopulation(), 0u);
+}
+
+TEST(KernelTest, CheckpointRoundTripContinuesIdentically) {
+    KernelConfig cfg;
+    cfg.population = 4000;
+    cfg.regions = 16;
+    cfg.seed = 23;
+    Kernel original(cfg);
+    original.stepN(37);  // Mid-interval: economy, migration and language phases are pending
+    original.economyMut().setEconomicModel("market");
+
+    const std::string path = ::testing::TempDir() + "kernel_checkpoint_v2.bin";
+    serialization::CheckpointOptions options;
+    options.compress = serialization::compressionAvailable();
+    ASSERT_TRUE(serialization::saveCheckpoint(original, path, options));
+
+    KernelConfig other;
+    other.population = 500;
+    other.regions = 4;
+    Kernel restored(other);
+    ASSERT_TRUE(serialization::loadCheckpoint(restored, path));
+    EXPECT_EQ(restored.generation(), original.generation());
+    EXPECT_EQ(restored.config().regions, cfg.regions);
+    ASSERT_EQ(restored.agents().size(), original.agents().size());
+    EXPECT_EQ(restored.agents().psych[17].stress_level, original.agents().psych[17].stress_level);
+
+    // Both kernels step on bit-identically through economy, births and migration
+    original.stepN(25);
+    restored.stepN(25);
+    ASSERT_EQ(restored.agents().size(), original.agents().size());
+    EXPECT_EQ(restored.agents().id, original.agents().id);
+    EXPECT_EQ(restored.agents().B, original.agents().B);
+    EXPECT_EQ(restored.agents().region, original.agents().region);
+    for (std::uint32_t i = 0; i < original.agents().size(); i += 97) {
+        EXPECT_EQ(restored.agents().graph.row(i).size(), original.agents().graph.row(i).size());
+        EXPECT_EQ(restored.agents().health[i].physical_health, original.agents().health[i].physical_health);
+        EXPECT_EQ(restored.economy().getAgentEconomy(i).wealth, original.economy().getAgentEconomy(i).wealth);
+    }
+    EXPECT_EQ(restored.computeMetrics().globalWelfare, original.computeMetrics().globalWelfare);
+
+    // A corrupted payload is caught by its checksum and leaves the kernel untouched
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(0, std::ios::end);
+        const auto middle = file.tellg() / 2;
+        file.seekg(middle);
+        const char byte = static_cast<char>(file.get() ^ 0x5A);
+        file.seekp(middle);
+        file.put(byte);
+    }
+    EXPECT_FALSE(serialization::loadCheckpoint(restored, path));
+    EXPECT_EQ(restored.agents().size(), original.agents().size());
+    std::remove(path.c_str());
+}
+
+TEST(KernelTest, DeltaCheckpointChainRestores) {
+    KernelConfig cfg;
+    cfg.population = 4000;
+    cfg.regions = 16;
+    cfg.seed = 29;
+    Kernel kernel(cfg);
+    serialization::DeltaCheckpointer writer(3);  // base, delta, delta, base, ...
+
+    std::vector<std::string> chain;
+    std::vector<std::uint64_t> sizes;
+    for (int save = 0; save < 3; ++save) {
+        kernel.stepN(10);
+        chain.push_back(::testing::TempDir() + "kernel_delta_" + std::to_string(save) + ".bin");
+        ASSERT_TRUE(writer.save(kernel, chain.back()));
+        EXPECT_EQ(writer.lastWasBase(), save == 0);
+        sizes.push_back(writer.lastBytesWritten());
+    }
+    EXPECT_LT(sizes[1], sizes[0]);  // Lineage, traits and most graph rows are unchanged
+
+    Kernel restored(KernelConfig{});
+    EXPECT_FALSE(serialization::loadCheckpoint(restored, chain[2]));  // A delta alone is not loadable
+    EXPECT_FALSE(serialization::loadCheckpointChain(restored, {chain[0], chain[2]}));  // Broken link
+    ASSERT_TRUE(serialization::loadCheckpointChain(restored, chain));
+    EXPECT_EQ(restored.generation(), kernel.generation());
+    EXPECT_EQ(restored.agents().id, kernel.agents().id);
+    EXPECT_EQ(restored.agents().B, kernel.agents().B);
+
+    kernel.stepN(15);
+    restored.stepN(15);
+    EXPECT_EQ(restored.agents().B, kernel.agents().B);
+    EXPECT_EQ(restored.agents().graph.edgeCount(), kernel.agents().graph.edgeCount());
+
+    kernel.stepN(10);
+    chain.push_back(::testing::TempDir() + "kernel_delta_3.bin");
+    ASSERT_TRUE(writer.save(kernel, chain.back()));
+    EXPECT_TRUE(writer.lastWasBase());
+    for (const auto& path : chain) std::remove(path.c_str());
+}
+
+TEST(KernelTest, AsyncCheckpointCapturesWhileSteppingOn) {
+    KernelConfig cfg;
+    cfg.population = 4000;
+    cfg.regions = 16;
+    cfg.seed = 37;
+    Kernel kernel(cfg);
+    kernel.stepN(12);
+    const auto savedB = kernel.agents().B;
+    const auto savedGeneration = kernel.generation();
+
+    const std::string path = ::testing::TempDir() + "kernel_async.bin";
+    serialization::AsyncCheckpointer writer;
+    bool called = false;
+    auto done = writer.save(kernel, path, [&](const serialization::CheckpointResult& r) { called = r.ok; });
+    kernel.stepN(5);  // The save holds its own copy
+    const auto result = done.get();
+    ASSERT_TRUE(result.ok) << result.error;
+    EXPECT_TRUE(called);
+    EXPECT_FALSE(writer.busy());
+    EXPECT_EQ(result.generation, savedGeneration);
+    EXPECT_EQ(result.bytes, std::filesystem::file_size(path));
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+    Kernel restored(KernelConfig{});
+    ASSERT_TRUE(serialization::loadCheckpoint(restored, path));
+    EXPECT_EQ(restored.generation(), savedGeneration);
+    EXPECT_EQ(restored.agents().B, savedB);
+
+    // A failed write reports through the future and leaves nothing behind
+    const std::string bad = ::testing::TempDir() + "missing_dir/kernel_async.bin";
+    const auto failed = writer.save(kernel, bad).get();
+    EXPECT_FALSE(failed.ok);
+    EXPECT_FALSE(failed.error.empty());
+    std::remove(path.c_str());
+}
+
+TEST(KernelTest, AsyncDeltaCheckpointsDiffOnTheWorker) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 12;
+    cfg.seed = 41;
+    Kernel kernel(cfg);
+    serialization::DeltaCheckpointer chain(4);
+    serialization::AsyncCheckpointer writer;
+
+    std::vector<std::string> paths;
+    for (int save = 0; save < 3; ++save) {
+        kernel.stepN(8);
+        paths.push_back(::testing::TempDir() + "kernel_async_delta_" + std::to_string(save) + ".bin");
+        auto done = writer.save(kernel, paths.back(), chain);
+        kernel.stepN(3);  // The capture holds its own copy
+        const auto result = done.get();
+        ASSERT_TRUE(result.ok) << result.error;
+        EXPECT_EQ(chain.lastWasBase(), save == 0);
+        EXPECT_EQ(chain.lastBytesWritten(), result.bytes);
+    }
+
+    // A failed write leaves the chain on its last good save
+    const auto failed = writer.save(kernel, ::testing::TempDir() + "missing_dir/kernel_delta.bin", chain).get();
+    EXPECT_FALSE(failed.ok);
+
+    Kernel expected(cfg);
+    expected.stepN(30);
+    Kernel restored(KernelConfig{});
+    ASSERT_TRUE(serialization::loadCheckpointChain(restored, paths));
+    EXPECT_EQ(restored.generation(), expected.generation());
+    EXPECT_EQ(restored.agents().id, expected.agents().id);
+    EXPECT_EQ(restored.agents().B, expected.agents().B);
+
+    kernel.stepN(2);
+    paths.push_back(::testing::TempDir() + "kernel_async_delta_3.bin");
+    ASSERT_TRUE(writer.save(kernel, paths.back(), chain).get().ok);
+    EXPECT_FALSE(chain.lastWasBase());
+    ASSERT_TRUE(serialization::loadCheckpointChain(restored, paths));
+    EXPECT_EQ(restored.agents().B, kernel.agents().B);
+    for (const auto& path : paths) std::remove(path.c_str());
+}
+
+TEST(KernelTest, StreamingExportFiltersAndChunks) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 12;
+    cfg.seed = 31;
+    Kernel kernel(cfg);
+    kernel.stepN(5);
+    const auto& agents = kernel.agents();
+
+    std::string json;
+    std::size_t chunks = 0;
+    const auto collect = [&](const char* data, std::size_t size) {
+        EXPECT_LE(size, kExportChunkBytes);
+        json.append(data, size);
+        ++chunks;
+    };
+    ExportOptions options;
+    options.fields |= kExportTraits;
+    EXPECT_EQ(exportState(kernel, collect, options), agents.size());
+    EXPECT_GT(chunks, 1u);
+    EXPECT_EQ(json, kernelToJson(kernel, true));
+
+    // Region filter with stride: every other agent of region 3, slot order
+    options = ExportOptions{};
+    options.fields = kExportId | kExportRegion;
+    options.regions = {3};
+    options.stride = 2;
+    std::vector<std::uint32_t> expected;
+    std::size_t inRegion = 0;
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        if (agents.region[i] == 3 && inRegion++ % 2 == 0) expected.push_back(agents.id[i]);
+    }
+    options.format = ExportOptions::Format::Columnar;
+    std::string columnar;
+    const auto append = [&](const char* data, std::size_t size) { columnar.append(data, size); };
+    ASSERT_EQ(exportState(kernel, append, options), expected.size());
+    ASSERT_GE(columnar.size(), 32u);
+    EXPECT_EQ(columnar.substr(0, 4), "CIVX");
+    std::uint32_t count = 0;
+    std::memcpy(&count, columnar.data() + 16, sizeof(count));
+    ASSERT_EQ(count, expected.size());
+    const std::size_t idBytes = count * sizeof(std::uint32_t);
+    std::vector<std::uint32_t> ids(count), regions(count);
+    std::memcpy(ids.data(), columnar.data() + 32, idBytes);
+    std::memcpy(regions.data(), columnar.data() + 32 + (idBytes + 7) / 8 * 8, idBytes);
+    EXPECT_EQ(ids, expected);
+    EXPECT_TRUE(std::all_of(regions.begin(), regions.end(), [](std::uint32_t r) { return r == 3; }));
+
+    // ID-hash sampling keeps the same agents from one call to the next
+    options = ExportOptions{};
+    options.sampleFraction = 0.25;
+    std::string first, second;
+    const std::size_t sampled = exportState(kernel, [&](const char* d, std::size_t n) { first.append(d, n); }, options);
+    exportState(kernel, [&](const char* d, std::size_t n) { second.append(d, n); }, options);
+    EXPECT_EQ(first, second);
+    EXPECT_GT(sampled, agents.size() / 8);
+    EXPECT_LT(sampled, agents.size() / 2);
+
+    options.stride = 0;
+    EXPECT_THROW(exportState(kernel, collect, options), std::invalid_argument);
+}
+
+TEST(KernelTest, EventLogRingsDrainBoundAndWrite) {
+    // Small rings force producer-side drains; nothing is lost
+    EventLog::Config cfg;
+    cfg.ringCapacity = 64;
+    EventLog log(cfg);
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 5000;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&log, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                log.logDeath(static_cast<std::uint64_t>(i), static_cast<std::uint32_t>(t * kPerThread + i),
+                             static_cast<std::uint32_t>(t), 30 + t);
+            }
+        });
+    }
+    for (auto& p : producers) p.join();
+    EXPECT_EQ(log.size(), static_cast<std::size_t>(kThreads * kPerThread));
+    EXPECT_EQ(log.dropped(), 0u);
+    const auto deaths = log.getEventsByType(EventType::DEATH);
+    for (int t = 0; t < kThreads; ++t) {
+        EXPECT_EQ(std::count_if(deaths.begin(), deaths.end(), [t](const Event& e) {
+                      return e.region_id == static_cast<std::uint32_t>(t) && e.payload.death.age == 30 + t;
+                  }), kPerThread);
+    }
+    EXPECT_EQ(deaths.front().details(), "age=" + std::to_string(30 + static_cast<int>(deaths.front().region_id)));
+
+    // Bounded history keeps the latest events; the rest are counted
+    cfg.retainLimit = 100;
+    log.configure(cfg);
+    EXPECT_EQ(log.size(), 100u);
+    EXPECT_EQ(log.dropped(), static_cast<std::uint64_t>(kThreads * kPerThread - 100));
+    log.logMigration(kPerThread, 7, 1, 2);
+    const auto recent = log.getEventsByTickRange(kPerThread, kPerThread);
+    ASSERT_EQ(recent.size(), 1u);
+    EXPECT_EQ(recent[0].details(), "from=1;to=2");
+
+    // Binary output: 16-byte header, then one 64-byte record per event
+    const std::string path = ::testing::TempDir() + "kernel_events.bin";
+    log.init(path, EventLog::Format::Binary);
+    log.logBirth(1, 11, 3, 5);
+    log.logSystemChange(2, 3, "market", "a_very_long_system_name");
+    log.flush();
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_EQ(bytes.size(), 16 + 2 * sizeof(Event));
+    EXPECT_EQ(bytes.substr(0, 4), "CIVE");
+    Event change;
+    std::memcpy(&change, bytes.data() + 16 + sizeof(Event), sizeof(Event));
+    EXPECT_EQ(change.type, EventType::SYSTEM_CHANGE);
+    EXPECT_EQ(change.details(), "from=market;to=a_very_long_sys");
+    std::remove(path.c_str());
+}
+
+TEST(KernelTest, EventStoreIndexesTypeAndTickRanges) {
+    // Two segments resident per type; older ones are mapped from disk
+    EventLog::Config cfg;
+    cfg.spillDirectory = ::testing::TempDir();
+    cfg.residentSegments = 2;
+    EventLog log(cfg);
+    constexpr std::uint64_t kTicks = 6 * EventStore::kSegmentEvents;
+    for (std::uint64_t t = 0; t < kTicks; ++t) {
+        log.logDeath(t, static_cast<std::uint32_t>(t), 0, static_cast<int>(t % 90));
+        if (t % 4 == 0) log.logBirth(t, static_cast<std::uint32_t>(t), 1, 0);
+    }
+    log.logDeath(10, 999999, 0, 5);  // Late event lands in tick order
+    EXPECT_EQ(log.size(), kTicks + kTicks / 4 + 1);
+    EXPECT_EQ(log.count(EventType::DEATH, 0, kTicks), kTicks + 1);
+    EXPECT_EQ(log.count(EventType::DEATH, 10, 10), 2u);
+    EXPECT_EQ(log.count(EventType::BIRTH, 100, 199), 25u);
+    EXPECT_EQ(log.count(EventType::TRADE, 0, kTicks), 0u);
+
+    std::uint64_t expected = 4000, seen = 0;
+    std::size_t spans = 0;
+    log.forEachSpan(EventType::DEATH, 4000, 9000, [&](EventSpan span) {
+        ++spans;
+        for (const Event& e : span) {
+            EXPECT_EQ(e.tick, expected++);
+            ++seen;
+        }
+    });
+    EXPECT_EQ(seen, 5001u);
+    EXPECT_EQ(spans, 3u);  // Straddles two segment boundaries
+
+    const auto range = log.getEventsByTickRange(8, 12);
+    ASSERT_EQ(range.size(), 8u);  // Deaths 8..12, the late one, births at 8 and 12
+    EXPECT_TRUE(std::is_sorted(range.begin(), range.end(),
+                               [](const Event& a, const Event& b) { return a.tick < b.tick; }));
+
+    // KeepLatest trims the smallest ticks first
+    cfg.retainLimit = 1000;
+    log.configure(cfg);
+    EXPECT_EQ(log.size(), 1000u);
+    EXPECT_EQ(log.count(EventType::DEATH, 0, kTicks - 801), 0u);
+    EXPECT_EQ(log.getEventsByType(EventType::DEATH).back().tick, kTicks - 1);
+
+    // Spilled segments read back through their mapping
+    EventStore store;
+    store.setSpill(::testing::TempDir(), 1);
+    Event e;
+    e.type = EventType::MIGRATION;
+    for (std::uint64_t t = 0; t < 3 * EventStore::kSegmentEvents; ++t) {
+        e.tick = t;
+        e.agent_id = static_cast<std::uint32_t>(t);
+        store.append(e);
+    }
+#ifndef _WIN32
+    EXPECT_EQ(store.spilledSegments(), 2u);
+#endif
+    std::uint64_t ids = 0;
+    store.visit(EventType::MIGRATION, 0, 99, [&](EventSpan span) {
+        for (const Event& m : span) ids += m.agent_id;
+    });
+    EXPECT_EQ(ids, 99u * 100u / 2u);
+}
+
+TEST(KernelTest, LiveSimulationQueuesCommandsAndPublishes) {
+    KernelConfig cfg;
+    cfg.population = 500;
+    cfg.regions = 6;
+    cfg.seed = 11;
+    LiveSimulation::Options options;
+    options.publishInterval = 4;
+    LiveSimulation sim(cfg, options);
+    int hookCalls = 0;
+    sim.setPublishHook([&](Kernel&, const std::vector<Cluster>&, SimSnapshot& snap) {
+        ++hookCalls;
+        snap.movementsJson = "[1]";
+    });
+    sim.start();
+    const auto initial = sim.snapshot();
+    ASSERT_TRUE(initial);
+    EXPECT_EQ(initial->generation, 0u);
+    EXPECT_EQ(initial->regionJson.size(), 6u);
+
+    ASSERT_TRUE(sim.step(10));
+    auto snap = sim.waitIdle();
+    EXPECT_EQ(snap->generation, 10u);
+    EXPECT_GT(snap->epoch, initial->epoch);
+    EXPECT_EQ(snap->movementsJson, "[1]");
+    EXPECT_NE(snap->metricsJson.find("\"generation\":10"), std::string::npos);
+    EXPECT_EQ(initial->generation, 0u);  // Held snapshots never change
+
+    // Readers keep taking snapshots while the worker runs freely
+    ASSERT_TRUE(sim.run());
+    std::uint64_t last = 0;
+    for (int i = 0; i < 200; ++i) {
+        const auto s = sim.snapshot();
+        EXPECT_GE(s->generation, last);
+        last = s->generation;
+    }
+    ASSERT_TRUE(sim.pause());
+    snap = sim.waitIdle();
+    EXPECT_FALSE(sim.status().running);
+
+    cfg.regions = 3;
+    ASSERT_TRUE(sim.reset(cfg));
+    ASSERT_TRUE(sim.step(2));
+    snap = sim.waitIdle();
+    EXPECT_EQ(snap->generation, 2u);
+    EXPECT_EQ(snap->regionJson.size(), 3u);
+    EXPECT_GE(hookCalls, 3);
+    EXPECT_TRUE(sim.status().lastError.empty());
+    EXPECT_EQ(sim.config().regions, 3u);
+
+    // A config the kernel rejects keeps the current run
+    KernelConfig bad = cfg;
+    bad.regions = 0;
+    ASSERT_TRUE(sim.reset(bad));
+    ASSERT_TRUE(sim.step(1));
+    snap = sim.waitIdle();
+    EXPECT_EQ(snap->generation, 3u);
+    EXPECT_EQ(snap->regionJson.size(), 3u);
+    EXPECT_NE(sim.status().lastError.find("regions"), std::string::npos);
+    EXPECT_EQ(sim.config().regions, 3u);  // Still the config of the run in progress
+
+    sim.stop();
+    EXPECT_FALSE(sim.step(1));
+}
+
+// Ensemble runs match standalone kernels; a shared geography seed gives
+// every seed the same world and is built once per start condition
+TEST(KernelTest, EnsembleMatchesStandaloneRunsAndSharesGeography) {
+    KernelConfig base;
+    base.population = 400;
+    base.regions = 12;
+
+    Ensemble::Options options;
+    options.workers = 3;
+    Ensemble ensemble(options);
+    for (const char* start : {"baseline", "feudal"}) {
+        for (std::uint64_t seed : {5u, 6u, 7u}) {
+            EnsembleRun run;
+            run.config = base;
+            run.config.seed = seed;
+            run.config.startCondition = start;
+            run.config.geographySeed = 77;
+            run.ticks = 12;
+            run.sampleInterval = 5;
+            ensemble.add(run);
+        }
+    }
+    EnsembleRun own;  // World drawn from its seed, as before geographySeed
+    own.config = base;
+    own.config.seed = 5;
+    own.ticks = 7;
+    ensemble.add(own);
+
+    std::vector<EnsembleSample> samples;
+    const auto summary = ensemble.run([&](const EnsembleSample& s) { samples.push_back(s); });
+    ASSERT_EQ(summary.runs.size(), 7u);
+    EXPECT_EQ(summary.failed, 0u);
+    EXPECT_EQ(summary.geographies, 3u);
+    EXPECT_EQ(samples.size(), 6u * 3 + 1);  // Ticks 5, 10 and 12, or the final one only
+
+    for (std::size_t r = 0; r < ensemble.runs().size(); ++r) {
+        const auto& run = ensemble.runs()[r];
+        Kernel kernel(run.config);
+        kernel.stepN(static_cast<int>(run.ticks));
+        const auto expected = kernel.computeMetrics();
+        const auto last = std::find_if(samples.rbegin(), samples.rend(),
+                                       [&](const EnsembleSample& s) { return s.run == r; });
+        ASSERT_NE(last, samples.rend());
+        EXPECT_TRUE(summary.runs[r].ok);
+        EXPECT_EQ(last->generation, run.ticks);
+        EXPECT_EQ(summary.runs[r].generation, run.ticks);
+        EXPECT_NEAR(last->metrics.polarizationMean, expected.polarizationMean, 1e-9) << "run " << r;
+        EXPECT_NEAR(last->metrics.globalWelfare, expected.globalWelfare, 1e-9) << "run " << r;
+        EXPECT_NEAR(last->metrics.avgOpenness, expected.avgOpenness, 1e-9) << "run " << r;
+    }
+
+    // Same world across seeds, different people on it
+    KernelConfig a = ensemble.runs()[0].config;
+    KernelConfig b = ensemble.runs()[1].config;
+    Kernel ka(a), kb(b);
+    for (std::uint32_t r = 0; r < base.regions; ++r) {
+        EXPECT_EQ(ka.economy().getRegion(r).x, kb.economy().getRegion(r).x);
+        EXPECT_EQ(ka.economy().getRegion(r).endowments, kb.economy().getRegion(r).endowments);
+    }
+    EXPECT_NE(ka.agents().B, kb.agents().B);
+
+    // Unset, the geography follows the seed exactly as before
+    KernelConfig plain = own.config;
+    Kernel viaShared(plain, KernelGeography::build(plain));
+    Kernel direct(plain);
+    EXPECT_EQ(viaShared.agents().B, direct.agents().B);
+    EXPECT_EQ(viaShared.economy().getRegion(3).endowments, direct.economy().getRegion(3).endowments);
+}
+
+// One shard reproduces a plain kernel; three threaded shards keep their
+// agents in owned regions, agree on replicated state and repeat exactly
+TEST(KernelTest, ShardedKernelMatchesKernelAndStaysConsistent) {
+    KernelConfig cfg;
+    cfg.population = 900;
+    cfg.regions = 12;
+    cfg.seed = 9;
+    cfg.geographySeed = 31;
+
+    auto solo = LocalCommunicator::group(1);
+    ShardedKernel single(cfg, *solo[0]);
+    Kernel plain(cfg);
+    single.stepN(20);
+    plain.stepN(20);
+    EXPECT_EQ(single.local().agents().B, plain.agents().B);
+    EXPECT_EQ(single.population(), plain.agents().size() - std::count(plain.agents().alive.begin(),
+                                                                      plain.agents().alive.end(), 0));
+    const auto sm = single.computeMetrics();
+    const auto pm = plain.computeMetrics();
+    EXPECT_NEAR(sm.polarizationMean, pm.polarizationMean, 1e-12);
+    EXPECT_NEAR(sm.avgOpenness, pm.avgOpenness, 1e-12);
+    EXPECT_EQ(sm.globalWelfare, pm.globalWelfare);
+
+    struct Outcome {
+        std::vector<Kernel::Metrics> metrics;
+        std::vector<std::vector<double>> welfare;  // Every region, per shard
+        std::vector<std::vector<precision::BeliefVec>> beliefs;
+        std::uint64_t haloEdges = 0, immigrants = 0, population = 0;
+        bool inOwnedRegions = true;
+    };
+    const auto run = [&cfg] {
+        constexpr int kShards = 3;
+        Outcome out;
+        out.metrics.resize(kShards);
+        out.welfare.resize(kShards);
+        out.beliefs.resize(kShards);
+        std::vector<std::uint64_t> halo(kShards), immigrants(kShards), population(kShards);
+        std::vector<char> owned(kShards, 1);
+        auto group = LocalCommunicator::group(kShards);
+        std::vector<std::thread> threads;
+        for (int r = 0; r < kShards; ++r) {
+            threads.emplace_back([&, r] {
+                ShardedKernel shard(cfg, *group[r]);
+                shard.stepN(40);
+                population[r] = shard.population();
+                out.metrics[r] = shard.computeMetrics();
+                const auto& agents = shard.local().agents();
+                for (std::size_t i = 0; i < agents.size(); ++i) {
+                    if (agents.alive[i] && !shard.regions().contains(agents.region[i])) owned[r] = 0;
+                }
+                for (std::uint32_t g = 0; g < cfg.regions; ++g) {
+                    out.welfare[r].push_back(shard.local().economy().getRegion(g).welfare);
+                }
+                out.beliefs[r] = agents.B;
+                halo[r] = shard.traffic().haloEdges;
+                immigrants[r] = shard.traffic().immigrants;
+            });
+        }
+        for (auto& t : threads) t.join();
+        for (int r = 0; r < kShards; ++r) {
+            out.haloEdges += halo[r];
+            out.immigrants += immigrants[r];
+            out.inOwnedRegions = out.inOwnedRegions && owned[r];
+        }
+        out.population = population[0];
+        EXPECT_EQ(population[1], population[0]);
+        return out;
+    };
+
+    const Outcome first = run();
+    EXPECT_TRUE(first.inOwnedRegions);
+    EXPECT_GT(first.haloEdges, 0u);
+    EXPECT_GT(first.population, cfg.population / 2);
+    for (int r = 1; r < 3; ++r) {
+        EXPECT_EQ(first.welfare[r], first.welfare[0]) << "shard " << r;
+        EXPECT_EQ(first.metrics[r].polarizationMean, first.metrics[0].polarizationMean);
+        EXPECT_EQ(first.metrics[r].avgOpenness, first.metrics[0].avgOpenness);
+        EXPECT_EQ(first.metrics[r].globalInequality, first.metrics[0].globalInequality);
+    }
+
+    const Outcome second = run();
+    EXPECT_EQ(second.beliefs, first.beliefs);
+    EXPECT_EQ(second.immigrants, first.immigrants);
+    EXPECT_EQ(second.metrics[0].polarizationMean, first.metrics[0].polarizationMean);
+
+    KernelConfig tooFew = cfg;
+    tooFew.regions = 2;
+    auto three = LocalCommunicator::group(3);
+    EXPECT_THROW(ShardedKernel(tooFew, *three[0]), std::invalid_argument);
+}
+
+TEST(KernelTest, InitIsThreadIndependentAndInitImagesReproduceIt) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 16;
+    cfg.seed = 31;
+
+    // World construction draws per-agent streams: the team size does not matter
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    Kernel serial(cfg);
+    omp_set_num_threads(4);
+    Kernel wide(cfg);
+    omp_set_num_threads(threads);
+    EXPECT_EQ(serial.agents().B, wide.agents().B);
+    EXPECT_EQ(serial.agents().age, wide.agents().age);
+    EXPECT_EQ(serial.agents().dialect, wide.agents().dialect);
+    for (std::uint32_t i = 0; i < cfg.population; i += 37) {
+        EXPECT_EQ(serial.agents()[i].neighbors.toVector(), wide.agents()[i].neighbors.toVector());
+        EXPECT_EQ(serial.agents().psych[i].stress_level, wide.agents().psych[i].stress_level);
+        EXPECT_EQ(serial.economy().getAgentEconomy(i).wealth, wide.economy().getAgentEconomy(i).wealth);
+    }
+
+    const std::string dir = ::testing::TempDir() + "civ_init_images";
+    std::filesystem::remove_all(dir);
+    serialization::InitImageCache cache(dir);
+    EXPECT_EQ(cache.load(cfg), nullptr);
+    auto built = cache.make(cfg);
+    EXPECT_EQ(cache.misses(), 2u);
+    ASSERT_TRUE(std::filesystem::exists(cache.pathFor(cfg)));
+    auto loaded = cache.make(cfg);
+    EXPECT_EQ(cache.hits(), 1u);
+    KernelConfig other = cfg;
+    other.startCondition = "feudal";
+    EXPECT_NE(cache.pathFor(other), cache.pathFor(cfg));
+
+    // The image steps on exactly like a freshly built world
+    EXPECT_EQ(loaded->agents().B, serial.agents().B);
+    serial.stepN(20);
+    loaded->stepN(20);
+    EXPECT_EQ(loaded->agents().id, serial.agents().id);
+    EXPECT_EQ(loaded->agents().B, serial.agents().B);
+    EXPECT_EQ(loaded->computeMetrics().globalWelfare, serial.computeMetrics().globalWelfare);
+
+    // Ensembles pick the image up
+    Ensemble::Options options;
+    options.workers = 1;
+    options.initImageDir = dir;
+    Ensemble ensemble(options);
+    EnsembleRun run;
+    run.config = cfg;
+    run.ticks = 20;
+    ensemble.add(run);
+    double welfare = 0.0;
+    const auto summary = ensemble.run([&](const EnsembleSample& s) { welfare = s.metrics.globalWelfare; });
+    EXPECT_EQ(summary.initImageHits, 1u);
+    EXPECT_EQ(summary.geographies, 0u);
+    EXPECT_EQ(welfare, serial.computeMetrics().globalWelfare);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(KernelTest, MetricsRecorderDownsamplesAndRoundTrips) {
+    KernelConfig cfg;
+    cfg.population = 2000;
+    cfg.regions = 9;
+    cfg.seed = 17;
+    Kernel kernel(cfg);
+
+    RecorderOptions options;
+    options.series = kSeriesDefault | kSeriesRegionBeliefs;
+    options.strides = {1, 10};
+    options.regions = {0, 4, 8};
+    options.chunkRows = 8;  // Several blocks per level
+    const std::string path = ::testing::TempDir() + "civ_metrics.civm";
+    MetricsRecorder memory(options);
+    MetricsRecorder file(options, path);
+    std::vector<Kernel::Metrics> expected;
+    for (int t = 0; t < 35; ++t) {
+        kernel.step();
+        memory.record(kernel);
+        file.record(kernel);
+        expected.push_back(kernel.computeMetrics());
+    }
+    file.close();
+    EXPECT_FALSE(file.failed());
+    EXPECT_THROW(file.record(kernel), std::logic_error);
+
+    const auto h = memory.history();
+    const auto read = readMetricsFile(path);
+    EXPECT_EQ(read.regions, options.regions);
+    ASSERT_EQ(read.columns.size(), h.columns.size());
+    EXPECT_EQ(read.levels[0].generations, h.levels[0].generations);
+    EXPECT_EQ(read.levels[0].values, h.levels[0].values);
+    EXPECT_EQ(std::filesystem::file_size(path), file.bytesWritten());
+
+    // Ticks 1..35: every tick at full resolution; 10-tick windows close at
+    // 10, 20, 30 and close() adds the partial window 31..35
+    ASSERT_EQ(read.levels[0].generations.size(), 35u);
+    const auto welfare = read.column("welfare");
+    for (std::size_t t = 0; t < expected.size(); ++t) {
+        EXPECT_EQ(read.levels[0].values[welfare][t], expected[t].globalWelfare);
+    }
+    const auto& coarse = read.levels[1];
+    EXPECT_EQ(coarse.generations, (std::vector<std::uint64_t>{10, 20, 30, 35}));
+    const auto hardship = read.column("region_hardship");
+    const auto system = read.column("region_system");
+    EXPECT_FALSE(read.columns[hardship].last);
+    EXPECT_TRUE(read.columns[system].last);
+    const auto& fine = read.levels[0];
+    for (std::size_t row = 0; row < coarse.generations.size(); ++row) {
+        const std::size_t first = row * 10;
+        const std::size_t last = std::min<std::size_t>(first + 10, fine.generations.size());
+        for (std::size_t r = 0; r < read.regions.size(); ++r) {
+            double sum = 0.0;
+            for (auto t = first; t < last; ++t) sum += fine.values[hardship][t * 3 + r];
+            EXPECT_NEAR(coarse.values[hardship][row * 3 + r], sum / static_cast<double>(last - first), 1e-12);
+            EXPECT_EQ(coarse.values[system][row * 3 + r], fine.values[system][(last - 1) * 3 + r]);
+        }
+    }
+    EXPECT_THROW(read.column("missing"), std::invalid_argument);
+
+    options.regions = {cfg.regions};
+    MetricsRecorder bad(options);
+    EXPECT_THROW(bad.record(kernel), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+TEST(KernelTest, StoragePrecisionAndDriftReport) {
+    using Q16 = precision::UnitFixed<std::uint16_t>;
+    for (const double v : {0.0, 0.1, 0.25, 0.5, 0.999, 1.0}) {
+        EXPECT_NEAR(static_cast<double>(Q16(v)), v, Q16::kStep / 2);
+    }
+    EXPECT_EQ(Q16(-0.5).raw(), 0u);
+    EXPECT_EQ(Q16(2.0).raw(), 0xFFFFu);
+    const precision::BeliefVec row = std::array<double, 4>{0.5, -0.25, 0.125, 1.0};  // Exact in float too
+    EXPECT_EQ(precision::normSq(row), 0.25 + 0.0625 + 0.015625 + 1.0);
+
+    // Rows match by generation, columns by name; per-region columns element-wise
+    MetricsHistory ref;
+    ref.regions = {0, 1};
+    ref.columns = {{"welfare", false, false}, {"region_welfare", true, false}};
+    MetricsLevel level;
+    level.generations = {1, 2, 3};
+    level.values = {{1.0, 2.0, 4.0}, {1.0, 1.0, 2.0, 2.0, 3.0, 3.0}};
+    ref.levels = {level};
+    MetricsHistory other = ref;
+    other.columns.push_back({"population", false, false});
+    other.levels[0].generations = {2, 3, 4};
+    other.levels[0].values = {{2.5, 4.0, 9.0}, {2.0, 2.0, 3.0, 0.0, 5.0, 5.0}, {1.0, 1.0, 1.0}};
+
+    const auto drift = compareMetrics(ref, other);
+    ASSERT_EQ(drift.size(), 2u);
+    EXPECT_EQ(drift[0].name, "welfare");
+    EXPECT_EQ(drift[0].samples, 2u);
+    EXPECT_DOUBLE_EQ(drift[0].maxAbs, 0.5);
+    EXPECT_DOUBLE_EQ(drift[0].meanAbs, 0.25);
+    EXPECT_DOUBLE_EQ(drift[0].maxRel, 0.2);
+    EXPECT_EQ(drift[1].samples, 4u);
+    EXPECT_DOUBLE_EQ(drift[1].maxAbs, 3.0);
+    EXPECT_DOUBLE_EQ(drift[1].maxRel, 1.0);
+    other.regions = {0, 2};
+    EXPECT_THROW(compareMetrics(ref, other), std::invalid_argument);
+    EXPECT_THROW(compareMetrics(ref, ref, 1), std::invalid_argument);
+}
+
+TEST(KernelTest, DemographyRatesFollowEconomyEdits) {
+    KernelConfig cfg;
+    cfg.population = 20000;
+    cfg.regions = 20;
+    cfg.seed = 23;
+    Kernel harsh(cfg);
+    Kernel kind(cfg);
+    harsh.step();  // Builds the rate tables from the initial economy
+    kind.step();
+
+    // Edits through economyMut() must reach the cached region x age rates
+    for (std::uint32_t r = 0; r < cfg.regions; ++r) {
+        auto& poor = harsh.economyMut().getRegionMut(r);
+        poor.welfare = 0.5;
+        poor.development = 0.0;
+        auto& rich = kind.economyMut().getRegionMut(r);
+        rich.welfare = 50.0;
+        rich.development = 20.0;
+    }
+    for (int t = 0; t < 5; ++t) {
+        harsh.step();
+        kind.step();
+    }
+    const auto harshDeaths = harsh.eventLog().count(EventType::DEATH, 2, 6);
+    const auto kindDeaths = kind.eventLog().count(EventType::DEATH, 2, 6);
+    EXPECT_GT(harshDeaths, 20u);
+    EXPECT_LT(kindDeaths * 5, harshDeaths);
+}
+
+TEST(KernelTest, ReorderKeepsAgentsAndGathersRegions) {
+    KernelConfig cfg;
+    cfg.population = 5000;
+    cfg.regions = 20;
+    cfg.seed = 29;
+    cfg.liveClusters = 3;
+    Kernel kernel(cfg);
+    kernel.stepN(60);  // Births and migration scatter the slots
+
+    // Per stable ID: region, beliefs, wealth and the IDs of its neighbors
+    struct Snapshot {
+        std::uint32_t region;
+        std::array<double, 4> B;
+        double wealth;
+        std::vector<std::uint32_t> ties;
+    };
+    const auto capture = [](const Kernel& k) {
+        std::map<std::uint32_t, Snapshot> out;
+        const auto& a = k.agents();
+        for (std::uint32_t s = 0; s < a.size(); ++s) {
+            if (!a.alive[s]) continue;
+            Snapshot snap{a.region[s], a.B[s], k.economy().getAgentEconomy(s).wealth, {}};
+            for (const auto t : a.graph.row(s)) {
+                if (a.alive[t]) snap.ties.push_back(a.id[t]);
+            }
+            std::sort(snap.ties.begin(), snap.ties.end());
+            out[a.id[s]] = std::move(snap);
+        }
+        return out;
+    };
+    const auto before = capture(kernel);
+    kernel.reorderAgents();
+    const auto after = capture(kernel);
+    ASSERT_EQ(after.size(), before.size());
+    for (const auto& [id, snap] : before) {
+        const auto& moved = after.at(id);
+        EXPECT_EQ(moved.region, snap.region);
+        EXPECT_EQ(moved.B, snap.B);
+        EXPECT_EQ(moved.wealth, snap.wealth);
+        EXPECT_EQ(moved.ties, snap.ties);
+        const auto slot = kernel.agents().slotOf(id);
+        ASSERT_NE(slot, AgentStore::kNoSlot);
+        EXPECT_EQ(kernel.agents().id[slot], id);
+    }
+
+    EXPECT_EQ(kernel.agents().size(), before.size());  // Dead slots are dropped
+    EXPECT_EQ(kernel.locality().passes, 1u);
+    EXPECT_GT(kernel.locality().localEdgesAfter, kernel.locality().localEdgesBefore);
+
+    // Grouped by region, each region is one contiguous slot range, in region order
+    kernel.setReorder(0, true);
+    kernel.reorderAgents();
+    EXPECT_EQ(capture(kernel).size(), before.size());
+    const auto& agents = kernel.agents();
+    EXPECT_TRUE(std::is_sorted(agents.region.begin(), agents.region.end()));
+    std::uint32_t next = 0;
+    for (std::uint32_t r = 0; r < cfg.regions; ++r) {
+        for (const auto slot : kernel.regionIndex()[r]) EXPECT_EQ(slot, next++);
+    }
+
+    // Births after the pass still resolve, and a checkpoint restores the by-ID index
+    kernel.stepN(15);
+    const std::uint32_t newest = kernel.agents().id.back();
+    EXPECT_EQ(kernel.agents().slotOf(newest), kernel.agents().size() - 1);
+    const std::string path = ::testing::TempDir() + "kernel_reordered.ckpt";
+    ASSERT_TRUE(serialization::saveCheckpoint(kernel, path));
+    Kernel restored(cfg);
+    ASSERT_TRUE(serialization::loadCheckpoint(restored, path));
+    const auto firstId = before.begin()->first;
+    EXPECT_EQ(restored.agents().slotOf(firstId), kernel.agents().slotOf(firstId));
+    kernel.setReorder(5);
+    restored.setReorder(5);
+    kernel.stepN(10);
+    restored.stepN(10);
+    EXPECT_EQ(restored.agents().id, kernel.agents().id);
+    EXPECT_EQ(restored.agents().B, kernel.agents().B);
+    EXPECT_EQ(kernel.locality().passes, 4u);
+}
+
+TEST(KernelTest, MemoryUsageBreakdownAndBudget) {
+    KernelConfig cfg;
+    cfg.population = 4000;
+    cfg.regions = 20;
+    cfg.seed = 35;
+    cfg.liveClusters = 3;
+    Kernel kernel(cfg);
+    kernel.stepN(20);
+
+    const auto usage = kernel.memoryUsage();
+    ASSERT_EQ(usage.subsystems.size(), Kernel::kMemorySubsystemCount);
+    std::size_t used = 0, reserved = 0;
+    for (std::size_t i = 0; i < usage.subsystems.size(); ++i) {
+        const auto& s = usage.subsystems[i];
+        EXPECT_STREQ(s.name, Kernel::kMemorySubsystems[i]);
+        EXPECT_LE(s.used, s.reserved) << s.name;
+        EXPECT_LE(s.reserved, s.peak) << s.name;
+        used += s.used;
+        reserved += s.reserved;
+    }
+    EXPECT_EQ(usage.used, used);
+    EXPECT_EQ(usage.reserved, reserved);
+    EXPECT_GE(usage.peak, usage.reserved);
+    EXPECT_GE(usage.subsystems[0].used, kernel.agents().size() * sizeof(precision::BeliefVec) * 2);
+    EXPECT_GT(usage.subsystems[1].used, 0u);  // Graph
+    EXPECT_GT(usage.subsystems[6].used, 0u);  // Live clusters
+
+    // Trimming keeps 1/16 headroom, frees the scratch arena, and spills full
+    // event segments once the log has somewhere to put them
+    EventLog::Config events;
+    events.spillDirectory = ::testing::TempDir();
+    kernel.eventLog().configure(events);
+    for (std::uint64_t t = 0; t < 3 * EventStore::kSegmentEvents; ++t) {
+        kernel.eventLog().logMigration(kernel.generation(), static_cast<std::uint32_t>(t), 0, 1);
+    }
+    EXPECT_GE(kernel.eventLog().size(), 3 * EventStore::kSegmentEvents);  // memoryUsage() does not drain
+    const auto full = kernel.memoryUsage();
+    EXPECT_GT(kernel.trimMemory(), 0u);
+    const auto trimmed = kernel.memoryUsage();
+    const auto& agents = trimmed.subsystems[0];
+    EXPECT_LE(agents.reserved - agents.used, agents.used / 16);
+    EXPECT_EQ(trimmed.subsystems[8].reserved, 0u);                                   // Scratch
+    EXPECT_LE(trimmed.subsystems[5].reserved + 2 * EventStore::kSegmentEvents * sizeof(Event),
+              full.subsystems[5].reserved);                                          // Events
+    EXPECT_EQ(kernel.memoryBudgetStats().spilledSegments, 2u);
+    EXPECT_EQ(kernel.eventLog().count(EventType::MIGRATION, 0, kernel.generation()),
+              kernel.eventLog().getEventsByType(EventType::MIGRATION).size());
+    EXPECT_EQ(trimmed.peak, full.peak);  // High-water marks survive the trim
+
+    // A budget below live data acts once, then only counts the ticks over it
+    kernel.setMemoryBudget(1);
+    kernel.stepN(5);
+    const auto& stats = kernel.memoryBudgetStats();
+    EXPECT_EQ(stats.shrinks, 2u);
+    EXPECT_EQ(stats.overBudget, 5u);
+
+    // The recorder's memory series samples the same breakdown
+    RecorderOptions options;
+    options.series = kSeriesMemory;
+    options.strides = {1};
+    MetricsRecorder recorder(options);
+    recorder.record(kernel);
+    const auto history = recorder.history();
+    ASSERT_EQ(history.levels[0].generations.size(), 1u);
+    EXPECT_EQ(history.levels[0].values[history.column("memory_used")][0],
+              static_cast<double>(kernel.memoryUsage().used));
+    EXPECT_GT(history.levels[0].values[history.column("memory_graph")][0], 0.0);
+}
+
+TEST(KernelTest, OffloadedBeliefPassTracksCpuPass) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 20;
+    cfg.seed = 36;
+    Kernel cpu(cfg);
+    cfg.offloadBeliefs = true;
+    Kernel device(cfg);
+    Kernel again(cfg);
+    cpu.stepN(30);
+    device.stepN(30);
+    again.stepN(30);
+
+    EXPECT_EQ(cpu.beliefOffload(), nullptr);
+    ASSERT_NE(device.beliefOffload(), nullptr);
+    const auto& stats = device.beliefOffload()->stats();
+    EXPECT_EQ(stats.passes, 30u);
+    EXPECT_GE(stats.graphUploads, 1u);
+    EXPECT_LE(stats.graphUploads, stats.passes);
+    EXPECT_GT(stats.bytesFromDevice, 30 * device.agents().size() * sizeof(precision::BeliefVec));
+
+    // Same rule with its own noise draws: reproducible, and the world stays
+    // close to the CPU run
+    EXPECT_TRUE(device.agents().B == again.agents().B);
+    const auto a = cpu.computeMetrics();
+    const auto b = device.computeMetrics();
+    EXPECT_NEAR(a.polarizationMean, b.polarizationMean, 0.02);
+    EXPECT_NEAR(a.avgOpenness, b.avgOpenness, 0.01);
+    for (std::size_t i = 0; i < device.agents().size(); ++i) {
+        if (!device.agents().alive[i]) continue;
+        for (int d = 0; d < 4; ++d) ASSERT_LE(std::abs(static_cast<double>(device.agents().B[i][d])), 1.0);
+    }
+
+    // Without births the topology holds still, so the graph goes up once;
+    // traits follow the store's version, so only language shifts resend them
+    cfg.demographyEnabled = false;
+    Kernel still(cfg);
+    still.stepN(10);
+    EXPECT_EQ(still.beliefOffload()->stats().graphUploads, 1u);
+    EXPECT_LT(still.beliefOffload()->stats().traitUploads, 10u);
+    EXPECT_GE(stats.traitUploads, 1u);
+    EXPECT_LE(stats.traitUploads, stats.passes);
+    still.setBeliefOffload(false);
+    EXPECT_EQ(still.beliefOffload(), nullptr);
+}
+
+TEST(KernelTest, ActivitySchedulingSkipsQuiescentAgents) {
+    // Catch-up closed form matches stepping the affine rule
+    double x = 0.9;
+    for (int t = 0; t < 7; ++t) x = 0.8 * x + 0.05;
+    EXPECT_NEAR(ActivitySet::affine(0.9, 0.8, 0.05, 7), x, 1e-12);
+    EXPECT_DOUBLE_EQ(ActivitySet::affine(0.3, 1.0, 0.1, 4), 0.7);
+
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 20;
+    cfg.seed = 37;
+    Kernel exact(cfg);
+    EXPECT_EQ(exact.config().activityInterval, 0u);  // Exact is the default
+    cfg.activityInterval = 10;
+    Kernel active(cfg);
+    Kernel again(cfg);
+    exact.stepN(200);
+    active.stepN(200);
+    again.stepN(200);
+
+    EXPECT_EQ(exact.activity().ticks, 0u);
+    const auto& stats = active.activity();
+    EXPECT_EQ(stats.ticks, 200u);
+    EXPECT_GT(stats.skipped, 0u);
+    EXPECT_GT(stats.catchUps, 0u);
+    EXPECT_LT(stats.activeShare, 1.0);
+    EXPECT_GT(stats.neighborWakes, 0u);
+    EXPECT_GT(stats.demographicWakes, 0u);
+    EXPECT_GE(stats.maxSkippedDrift, stats.skippedDrift);
+
+    // Deterministic, and the world stays close to the exact run
+    EXPECT_TRUE(active.agents().B == again.agents().B);
+    const auto a = exact.computeMetrics();
+    const auto b = active.computeMetrics();
+    EXPECT_NEAR(a.polarizationMean, b.polarizationMean, 0.02);
+    EXPECT_NEAR(a.avgOpenness, b.avgOpenness, 0.01);
+    const auto& agents = active.agents();
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        if (!agents.alive[i]) continue;
+        ASSERT_GE(agents.health[i].physical_health, 0.0);
+        ASSERT_LE(agents.health[i].physical_health, 1.0);
+        ASSERT_GE(agents.psych[i].stress_level, 0.0);
+        ASSERT_LE(agents.psych[i].stress_level, 1.0);
+        for (int d = 0; d < 4; ++d) ASSERT_LE(std::abs(static_cast<double>(agents.B[i][d])), 1.0);
+    }
+
+    // Back to exact: every agent updates again
+    active.setActivity(0);
+    active.stepN(5);
+    EXPECT_EQ(active.activity().ticks, 0u);
+    EXPECT_THROW(active.setActivity(10, -1.0), std::invalid_argument);
+}
+
+// A checkpoint carries the activity schedule, so a restored run skips the
+// same agents as the original and stays bit-identical to it
+TEST(KernelTest, ActivityScheduleSurvivesCheckpoints) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 20;
+    cfg.seed = 41;
+    cfg.activityInterval = 10;
+    Kernel original(cfg);
+    serialization::DeltaCheckpointer writer(4);
+    const std::string full = ::testing::TempDir() + "kernel_activity.bin";
+    std::vector<std::string> chain;
+    for (int save = 0; save < 2; ++save) {
+        original.stepN(60);
+        chain.push_back(::testing::TempDir() + "kernel_activity_delta_" + std::to_string(save) + ".bin");
+        ASSERT_TRUE(writer.save(original, chain.back()));
+    }
+    ASSERT_GT(original.activity().skipped, 0u);
+    ASSERT_TRUE(serialization::saveCheckpoint(original, full));
+
+    Kernel restored(KernelConfig{});
+    Kernel chained(KernelConfig{});
+    ASSERT_TRUE(serialization::loadCheckpoint(restored, full));
+    ASSERT_TRUE(serialization::loadCheckpointChain(chained, chain));
+    EXPECT_EQ(restored.activity().ticks, 0u);  // Statistics restart
+
+    const std::uint64_t skippedBefore = original.activity().skipped;
+    original.stepN(40);
+    restored.stepN(40);
+    chained.stepN(40);
+    EXPECT_EQ(restored.activity().skipped, original.activity().skipped - skippedBefore);
+    EXPECT_EQ(chained.activity().skipped, restored.activity().skipped);
+    EXPECT_EQ(restored.agents().B, original.agents().B);
+    EXPECT_EQ(chained.agents().B, original.agents().B);
+    ASSERT_EQ(restored.agents().size(), original.agents().size());
+    for (std::size_t i = 0; i < original.agents().size(); ++i) {
+        ASSERT_EQ(restored.agents().health[i].physical_health, original.agents().health[i].physical_health);
+        ASSERT_EQ(restored.agents().psych[i].stress_level, original.agents().psych[i].stress_level);
+    }
+
+    std::remove(full.c_str());
+    for (const auto& path : chain) std::remove(path.c_str());
+}